@@ -414,10 +414,15 @@ public:
         const __m128 v = _mm256_extractf128_ps(m_col34, 1);
         return _mm_cvtss_f32(_mm_shuffle_ps(v, v, 0xff));
     }
-    Q_ALWAYS_INLINE QMatrix4x4 toQMatrix4x4() const { return QMatrix4x4(m11(), m12(), m13(), m14(),
-                                                                        m21(), m22(), m23(), m24(),
-                                                                        m31(), m32(), m33(), m34(),
-                                                                        m41(), m42(), m43(), m44()); }
+    Q_ALWAYS_INLINE QMatrix4x4 toQMatrix4x4() const
+    {
+        // QMatrix4x4::data() is column major like us and flags the matrix as General
+        QMatrix4x4 mat;
+        float *data = mat.data();
+        _mm256_storeu_ps(data, m_col12);
+        _mm256_storeu_ps(data + 8, m_col34);
+        return mat;
+    }
 
     Q_ALWAYS_INLINE Vector4D row(int index) const
     {
@@ -339,10 +339,17 @@ public:
         return c;
     }
 
-    Q_ALWAYS_INLINE QMatrix4x4 toQMatrix4x4() const { return QMatrix4x4(m11(), m12(), m13(), m14(),
-                                                                        m21(), m22(), m23(), m24(),
-                                                                        m31(), m32(), m33(), m34(),
-                                                                        m41(), m42(), m43(), m44()); }
+    Q_ALWAYS_INLINE QMatrix4x4 toQMatrix4x4() const
+    {
+        // QMatrix4x4::data() is column major like us and flags the matrix as General
+        QMatrix4x4 mat;
+        float *data = mat.data();
+        _mm_storeu_ps(data, m_col1);
+        _mm_storeu_ps(data + 4, m_col2);
+        _mm_storeu_ps(data + 8, m_col3);
+        _mm_storeu_ps(data + 12, m_col4);
+        return mat;
+    }
 
     Q_ALWAYS_INLINE Vector3D_SSE map(const Vector3D_SSE &point) const
     {
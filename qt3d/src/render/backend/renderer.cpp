@@ -1778,11 +1778,13 @@ bool Renderer::executeCommandsSubmission(const RenderView *rv)
     // Save the RenderView base stateset
     RenderStateSet *globalState = m_graphicsContext->currentStateSet();
     OpenGLVertexArrayObject *vao = nullptr;
+    OpenGLVertexArrayObject *boundVao = nullptr;
 
     for (RenderCommand *command : qAsConst(commands)) {
 
         if (command->m_type == RenderCommand::Compute) { // Compute Call
             performCompute(rv, command);
+            boundVao = nullptr;
         } else { // Draw Command
             // Check if we have a valid command that can be drawn
             if (!command->m_isValid) {
@@ -1807,10 +1809,13 @@ bool Renderer::executeCommandsSubmission(const RenderView *rv)
                 }
             }
 
-            {
+            // Commands sorted by material frequently share their geometry and
+            // therefore their VAO; only rebind when it actually changes
+            if (vao != boundVao) {
                 Profiling::GLTimeRecorder recorder(Profiling::VAOUpdate);
                 // Bind VAO
                 vao->bind();
+                boundVao = vao;
             }
 
             {
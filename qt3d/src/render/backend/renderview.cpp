@@ -96,6 +96,7 @@ const int MAX_LIGHTS = 8;
 #define LIGHT_INTENSITY_NAME QLatin1String(".intensity")
 
 int LIGHT_COUNT_NAME_ID = 0;
+int ENV_LIGHT_COUNT_NAME_ID = 0;
 int LIGHT_POSITION_NAMES[MAX_LIGHTS];
 int LIGHT_TYPE_NAMES[MAX_LIGHTS];
 int LIGHT_COLOR_NAMES[MAX_LIGHTS];
@@ -175,32 +176,23 @@ UniformValue RenderView::standardUniformValue(RenderView::StandardUniform standa
     case InverseModelMatrix:
         return UniformValue(model.inverted());
     case InverseViewMatrix:
-        return UniformValue(m_data.m_viewMatrix.inverted());
-    case InverseProjectionMatrix: {
-        return UniformValue(getProjectionMatrix(m_data.m_renderCameraLens).inverted());
-    }
+        return UniformValue(m_data.m_inverseViewMatrix);
+    case InverseProjectionMatrix:
+        return UniformValue(m_data.m_inverseProjectionMatrix);
     case InverseModelViewMatrix:
         return UniformValue((m_data.m_viewMatrix * model).inverted());
-    case InverseViewProjectionMatrix: {
-        const QMatrix4x4 viewProjectionMatrix = getProjectionMatrix(m_data.m_renderCameraLens) * m_data.m_viewMatrix;
-        return UniformValue(viewProjectionMatrix.inverted());
-    }
+    case InverseViewProjectionMatrix:
+        return UniformValue(m_data.m_inverseViewProjectionMatrix);
     case InverseModelViewProjectionMatrix:
         return UniformValue((m_data.m_viewProjectionMatrix * model).inverted(0));
     case ModelNormalMatrix:
         return UniformValue(model.normalMatrix());
     case ModelViewNormalMatrix:
         return UniformValue((m_data.m_viewMatrix * model).normalMatrix());
-    case ViewportMatrix: {
-        QMatrix4x4 viewportMatrix;
-        viewportMatrix.viewport(resolveViewport(m_viewport, m_surfaceSize));
-        return UniformValue(viewportMatrix);
-    }
-    case InverseViewportMatrix: {
-        QMatrix4x4 viewportMatrix;
-        viewportMatrix.viewport(resolveViewport(m_viewport, m_surfaceSize));
-        return UniformValue(viewportMatrix.inverted());
-    }
+    case ViewportMatrix:
+        return UniformValue(m_data.m_viewportMatrix);
+    case InverseViewportMatrix:
+        return UniformValue(m_data.m_inverseViewportMatrix);
     case AspectRatio:
         return float(m_surfaceSize.width()) / float(m_surfaceSize.height());
     case Exposure:
@@ -251,6 +243,7 @@ RenderView::RenderView()
         wasInitialized = true;
         RenderView::ms_standardUniformSetters = RenderView::initializeStandardUniformSetters();
         LIGHT_COUNT_NAME_ID = StringToInt::lookupId(QLatin1String("lightCount"));
+        ENV_LIGHT_COUNT_NAME_ID = StringToInt::lookupId(QLatin1String("envLightCount"));
         for (int i = 0; i < MAX_LIGHTS; ++i) {
             Q_STATIC_ASSERT_X(MAX_LIGHTS < 10, "can't use the QChar trick anymore");
             LIGHT_STRUCT_NAMES[i] = QLatin1String("lights[") + QLatin1Char(char('0' + i)) + QLatin1Char(']');
@@ -748,6 +741,16 @@ void RenderView::updateMatrices()
         // dir = normalize(QVector3D(0, 0, -1) * normalMat)
         setEyeViewDirection(QVector3D(-normalMat(2, 0), -normalMat(2, 1), -normalMat(2, 2)).normalized());
     }
+
+    // The remaining standard uniforms only depend on the view, so compute them
+    // once here instead of inverting matrices for every RenderCommand.
+    const QMatrix4x4 projectionMatrix = m_data.m_renderCameraLens ? m_data.m_renderCameraLens->projection() : QMatrix4x4();
+    m_data.m_inverseViewMatrix = m_data.m_viewMatrix.inverted();
+    m_data.m_inverseProjectionMatrix = projectionMatrix.inverted();
+    m_data.m_inverseViewProjectionMatrix = (projectionMatrix * m_data.m_viewMatrix).inverted();
+    m_data.m_viewportMatrix.setToIdentity();
+    m_data.m_viewportMatrix.viewport(resolveViewport(m_viewport, m_surfaceSize));
+    m_data.m_inverseViewportMatrix = m_data.m_viewportMatrix.inverted();
 }
 
 void RenderView::setUniformValue(ShaderParameterPack &uniformPack, int nameId, const UniformValue &value) const
@@ -1056,7 +1059,7 @@ void RenderView::setShaderAndUniforms(RenderCommand *command,
                         envLightCount = 1;
                     }
                 }
-                setUniformValue(command->m_parameterPack, StringToInt::lookupId(QStringLiteral("envLightCount")), envLightCount);
+                setUniformValue(command->m_parameterPack, ENV_LIGHT_COUNT_NAME_ID, envLightCount);
             }
             // Set frag outputs in the shaders if hash not empty
             if (!fragOutputs.isEmpty())
@@ -262,6 +262,11 @@ public:
         const RenderPassFilter *m_passFilter;
         QMatrix4x4 m_viewMatrix;
         QMatrix4x4 m_viewProjectionMatrix;
+        QMatrix4x4 m_inverseViewMatrix;
+        QMatrix4x4 m_inverseProjectionMatrix;
+        QMatrix4x4 m_inverseViewProjectionMatrix;
+        QMatrix4x4 m_viewportMatrix;
+        QMatrix4x4 m_inverseViewportMatrix;
         Qt3DCore::QNodeIdVector m_layerFilterIds;
         QVector<Qt3DRender::QSortPolicy::SortType> m_sortingTypes;
         QVector3D m_eyePos;
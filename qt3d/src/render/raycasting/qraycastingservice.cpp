@@ -86,7 +86,9 @@ Hit volumeRayIntersection(const QBoundingVolume *volume, const QRay3D &ray)
     return hit;
 }
 
-Hit reduceToFirstHit(Hit &result, const Hit &intermediate)
+// The reduce functions update the result in place; returning it would copy
+// the accumulated result for every volume tested.
+void reduceToFirstHit(Hit &result, const Hit &intermediate)
 {
     if (intermediate.intersects) {
         if (result.distance == -1.0f ||
@@ -94,15 +96,13 @@ Hit reduceToFirstHit(Hit &result, const Hit &intermediate)
                  intermediate.distance < result.distance))
             result = intermediate;
     }
-    return result;
 }
 
 // Unordered
-QVector<Hit> reduceToAllHits(QVector<Hit> &results, const Hit &intermediate)
+void reduceToAllHits(QVector<Hit> &results, const Hit &intermediate)
 {
     if (intermediate.intersects)
         results.push_back(intermediate);
-    return results;
 }
 
 struct CollisionGathererFunctor
@@ -138,6 +138,7 @@ struct QAxMetaObject : public QMetaObject
     QByteArray propertyType(const QByteArray &propertyName);
     void parsePrototype(const QByteArray &prototype);
     DISPID dispIDofName(const QByteArray &name, IDispatch *disp);
+    int indexOfMember(const QByteArray &name);
 
 private:
     friend class MetaObjectGenerator;
@@ -156,6 +157,8 @@ private:
 
     // DISPID cache
     QHash<QByteArray, DISPID> dispIDs;
+    // normalized slot signature or property name -> index cache
+    QHash<QByteArray, int> memberIndexes;
 };
 
 void QAxMetaObject::parsePrototype(const QByteArray &prototype)
@@ -225,6 +228,23 @@ inline DISPID QAxMetaObject::dispIDofName(const QByteArray &name, IDispatch *dis
     return dispid;
 }
 
+/*
+    Returns the index of the slot with the normalized signature \a name, or of
+    the property \a name if it does not contain a parameter list. dynamicCall()
+    resolves the member on every invocation, which would otherwise be a linear
+    scan over all members of possibly very large automation interfaces.
+*/
+inline int QAxMetaObject::indexOfMember(const QByteArray &name)
+{
+    int id = memberIndexes.value(name, -1);
+    if (id == -1) {
+        id = name.contains('(') ? indexOfSlot(name) : indexOfProperty(name);
+        // only cache hits, calls with literal arguments never match a member
+        if (id != -1)
+            memberIndexes.insert(name, id);
+    }
+    return id;
+}
 
 static QHash<QString, QAxMetaObject*> mo_cache;
 static QHash<QUuid, QMap<QByteArray, QList<QPair<QByteArray, int> > > > enum_cache;
@@ -3835,7 +3855,7 @@ bool QAxBase::dynamicCallHelper(const char *name, void *inout, QList<QVariant> &
         if (!(flags & NoPropertyGet))
             disptype |= DISPATCH_PROPERTYGET; // Support Excel/VB.
         if (d->useMetaObject)
-            id = mo->indexOfSlot(function);
+            id = mo == d->metaobj ? d->metaobj->indexOfMember(function) : mo->indexOfSlot(function);
         if (id >= 0) {
             const QMetaMethod slot = mo->method(id);
             Q_ASSERT(slot.methodType() == QMetaMethod::Slot);
@@ -3931,7 +3951,7 @@ bool QAxBase::dynamicCallHelper(const char *name, void *inout, QList<QVariant> &
         }
     } else {
         if (d->useMetaObject)
-            id = mo->indexOfProperty(normFunction);
+            id = mo == d->metaobj ? d->metaobj->indexOfMember(normFunction) : mo->indexOfProperty(normFunction);
 
         if (id >= 0) {
             const QMetaProperty prop =mo->property(id);
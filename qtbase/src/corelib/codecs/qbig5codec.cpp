@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qbig5codec_p.h"
+#include "qtextcodec_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -1724,11 +1725,16 @@ QString QBig5Codec::convertToUnicode(const char* chars, int len, ConverterState
 
     //qDebug("QBig5Codec::toUnicode(const char* chars = \"%s\", int len = %d)", chars, len);
     QString result;
+    result.reserve(len);
     for (int i=0; i<len; i++) {
         uchar ch = chars[i];
         switch (nbuf) {
         case 0:
-            if (IsLatin(ch)) {
+            if (const int run = qt_asciiRunLength(chars + i, len - i)) {
+                // ASCII, converted a whole run at a time
+                result += QLatin1String(chars + i, run);
+                i += run - 1;
+            } else if (IsLatin(ch)) {
                 // ASCII
                 result += QLatin1Char(ch);
             } else if (IsFirstByte(ch)) {
@@ -1844,11 +1850,16 @@ QString QBig5hkscsCodec::convertToUnicode(const char* chars, int len, ConverterS
 
     //qDebug("QBig5hkscsCodec::toUnicode(const char* chars = \"%s\", int len = %d)", chars, len);
     QString result;
+    result.reserve(len);
     for (int i=0; i<len; i++) {
         uchar ch = chars[i];
         switch (nbuf) {
         case 0:
-            if (IsLatin(ch)) {
+            if (const int run = qt_asciiRunLength(chars + i, len - i)) {
+                // ASCII, converted a whole run at a time
+                result += QLatin1String(chars + i, run);
+                i += run - 1;
+            } else if (IsLatin(ch)) {
                 // ASCII
                 result += QLatin1Char(ch);
             } else if (IsFirstByte(ch)) {
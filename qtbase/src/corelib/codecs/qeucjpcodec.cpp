@@ -73,6 +73,7 @@
  */
 
 #include "qeucjpcodec_p.h"
+#include "qtextcodec_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -169,11 +170,16 @@ QString QEucJpCodec::convertToUnicode(const char* chars, int len, ConverterState
     int invalid = 0;
 
     QString result;
+    result.reserve(len);
     for (int i=0; i<len; i++) {
         uchar ch = chars[i];
         switch (nbuf) {
         case 0:
-            if (ch < 0x80) {
+            if (const int run = qt_asciiRunLength(chars + i, len - i)) {
+                // ASCII, converted a whole run at a time
+                result += QLatin1String(chars + i, run);
+                i += run - 1;
+            } else if (ch < 0x80) {
                 // ASCII
                 result += QLatin1Char(ch);
             } else if (ch == Ss2 || ch == Ss3) {
@@ -67,6 +67,7 @@
 
 #include "qeuckrcodec_p.h"
 #include "cp949codetbl_p.h"
+#include "qtextcodec_p.h"
 
 #include <algorithm>
 
@@ -137,11 +138,16 @@ QString QEucKrCodec::convertToUnicode(const char* chars, int len, ConverterState
     int invalid = 0;
 
     QString result;
+    result.reserve(len);
     for (int i=0; i<len; i++) {
         uchar ch = chars[i];
         switch (nbuf) {
         case 0:
-            if (ch < 0x80) {
+            if (const int run = qt_asciiRunLength(chars + i, len - i)) {
+                // ASCII, converted a whole run at a time
+                result += QLatin1String(chars + i, run);
+                i += run - 1;
+            } else if (ch < 0x80) {
                 // ASCII
                 result += QLatin1Char(ch);
             } else if (IsEucChar(ch)) {
@@ -3453,11 +3459,16 @@ QString QCP949Codec::convertToUnicode(const char* chars, int len, ConverterState
     int invalid = 0;
 
     QString result;
+    result.reserve(len);
     for (int i=0; i<len; i++) {
         uchar ch = chars[i];
         switch (nbuf) {
         case 0:
-            if (ch < 0x80) {
+            if (const int run = qt_asciiRunLength(chars + i, len - i)) {
+                // ASCII, converted a whole run at a time
+                result += QLatin1String(chars + i, run);
+                i += run - 1;
+            } else if (ch < 0x80) {
                 // ASCII
                 result += QLatin1Char(ch);
             } else if (IsEucChar(ch)) {
@@ -44,6 +44,7 @@
 */
 
 #include "qgb18030codec_p.h"
+#include "qtextcodec_p.h"
 
 #ifndef QT_NO_BIG_CODECS
 
@@ -180,8 +181,13 @@ QString QGb18030Codec::convertToUnicode(const char* chars, int len, ConverterSta
         uchar ch = chars[i];
         switch (nbuf) {
         case 0:
-            if (IsLatin(ch)) {
-                // ASCII
+            if (const int run = qt_asciiRunLength(chars + i, len - i)) {
+                // ASCII, converted a whole run at a time
+                qt_from_latin1(resultData + unicodeLen, chars + i, run);
+                unicodeLen += run;
+                i += run - 1;
+            } else if (IsLatin(ch)) {
+                // ASCII NUL
                 resultData[unicodeLen] = ch;
                 ++unicodeLen;
             } else if (Is1stByte(ch)) {
@@ -339,8 +345,13 @@ QString QGbkCodec::convertToUnicode(const char* chars, int len, ConverterState *
         uchar ch = chars[i];
         switch (nbuf) {
         case 0:
-            if (IsLatin(ch)) {
-                // ASCII
+            if (const int run = qt_asciiRunLength(chars + i, len - i)) {
+                // ASCII, converted a whole run at a time
+                qt_from_latin1(resultData + unicodeLen, chars + i, run);
+                unicodeLen += run;
+                i += run - 1;
+            } else if (IsLatin(ch)) {
+                // ASCII NUL
                 resultData[unicodeLen] = ch;
                 ++unicodeLen;
             } else if (Is1stByte(ch)) {
@@ -488,8 +499,13 @@ QString QGb2312Codec::convertToUnicode(const char* chars, int len, ConverterStat
         uchar ch = chars[i];
         switch (nbuf) {
         case 0:
-            if (IsLatin(ch)) {
-                // ASCII
+            if (const int run = qt_asciiRunLength(chars + i, len - i)) {
+                // ASCII, converted a whole run at a time
+                qt_from_latin1(resultData + unicodeLen, chars + i, run);
+                unicodeLen += run;
+                i += run - 1;
+            } else if (IsLatin(ch)) {
+                // ASCII NUL
                 resultData[unicodeLen] = ch;
                 ++unicodeLen;
             } else if (IsByteInGb2312(ch)) {
@@ -48,6 +48,7 @@
 */
 
 #include "qsjiscodec_p.h"
+#include "qtextcodec_p.h"
 #include "qlist.h"
 
 QT_BEGIN_NAMESPACE
@@ -150,11 +151,16 @@ QString QSjisCodec::convertToUnicode(const char* chars, int len, ConverterState
     int invalid = 0;
     uint u= 0;
     QString result;
+    result.reserve(len);
     for (int i=0; i<len; i++) {
         uchar ch = chars[i];
         switch (nbuf) {
         case 0:
-            if (ch < 0x80) {
+            if (const int run = qt_asciiRunLength(chars + i, len - i)) {
+                // ASCII, converted a whole run at a time
+                result += QLatin1String(chars + i, run);
+                i += run - 1;
+            } else if (ch < 0x80) {
                 result += QValidChar(ch);
             } else if (IsKana(ch)) {
                 // JIS X 0201 Latin or JIS X 0201 Kana
@@ -109,6 +109,19 @@ public:
     };
 };
 
+// in qstring.cpp:
+void qt_from_latin1(ushort *dst, const char *str, size_t size) Q_DECL_NOTHROW;
+
+// Returns the length of the run of non-NUL 7-bit ASCII bytes at the start of
+// [chars, chars + len), which every multi-byte CJK encoding maps one-to-one.
+static inline int qt_asciiRunLength(const char *chars, int len)
+{
+    int i = 0;
+    while (i < len && uchar(chars[i] - 1) < 0x7f)
+        ++i;
+    return i;
+}
+
 #endif //QT_NO_TEXTCODEC
 
 QT_END_NAMESPACE
@@ -518,6 +518,36 @@ QString QUtf8::convertToUnicode(const char *chars, int len, QTextCodec::Converte
     return result;
 }
 
+// copies len UTF-16 code units from src to dst, swapping the bytes of each
+static void qt_utf16_swap(uchar *dst, const uchar *src, int len)
+{
+    const uchar *const end = src + 2 * len;
+#if defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)
+    // do eight characters at a time
+    for ( ; end - src >= 16; src += 16, dst += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        const __m128i swapped = _mm_or_si128(_mm_slli_epi16(data, 8), _mm_srli_epi16(data, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), swapped);
+    }
+#elif defined(__ARM_NEON__)
+    for ( ; end - src >= 16; src += 16, dst += 16)
+        vst1q_u8(dst, vrev16q_u8(vld1q_u8(src)));
+#endif
+    for ( ; src != end; src += 2, dst += 2) {
+        const uchar first = src[0];
+        dst[0] = src[1];
+        dst[1] = first;
+    }
+}
+
+static void qt_utf16_copy(uchar *dst, const uchar *src, int len, bool swap)
+{
+    if (swap)
+        qt_utf16_swap(dst, src, len);
+    else
+        memcpy(dst, src, 2 * len);
+}
+
 QByteArray QUtf16::convertFromUnicode(const QChar *uc, int len, QTextCodec::ConverterState *state, DataEndianness e)
 {
     DataEndianness endian = e;
@@ -543,17 +573,9 @@ QByteArray QUtf16::convertFromUnicode(const QChar *uc, int len, QTextCodec::Conv
         }
         data += 2;
     }
-    if (endian == BigEndianness) {
-        for (int i = 0; i < len; ++i) {
-            *(data++) = uc[i].row();
-            *(data++) = uc[i].cell();
-        }
-    } else {
-        for (int i = 0; i < len; ++i) {
-            *(data++) = uc[i].cell();
-            *(data++) = uc[i].row();
-        }
-    }
+    const bool hostIsBigEndian = QSysInfo::ByteOrder == QSysInfo::BigEndian;
+    qt_utf16_copy(reinterpret_cast<uchar *>(data), reinterpret_cast<const uchar *>(uc), len,
+                  (endian == BigEndianness) != hostIsBigEndian);
 
     if (state) {
         state->remainingChars = 0;
@@ -582,7 +604,21 @@ QString QUtf16::convertToUnicode(const char *chars, int len, QTextCodec::Convert
 
     QString result(len, Qt::Uninitialized); // worst case
     QChar *qch = (QChar *)result.data();
-    while (len--) {
+    while (len) {
+        if (headerdone && !half && len >= 2) {
+            // the byte order is known and we are at a character boundary:
+            // convert all the complete characters in one go
+            const int count = len / 2;
+            const bool hostIsBigEndian = QSysInfo::ByteOrder == QSysInfo::BigEndian;
+            qt_utf16_copy(reinterpret_cast<uchar *>(qch), reinterpret_cast<const uchar *>(chars), count,
+                          (endian == BigEndianness) != hostIsBigEndian);
+            qch += count;
+            chars += 2 * count;
+            len -= 2 * count;
+            continue;
+        }
+
+        --len;
         if (half) {
             QChar ch;
             if (endian == LittleEndianness) {
@@ -1625,7 +1625,12 @@ static void qDefaultMessageHandler(QtMsgType type, const QMessageLogContext &con
         return;
 #endif
     }
-    fprintf(stderr, "%s\n", logMessage.toLocal8Bit().constData());
+    // Append the newline before converting so the line goes out in a single
+    // stdio call; concurrent writers then cannot interleave between message
+    // and terminator, and stderr is locked once instead of twice.
+    logMessage.append(QLatin1Char('\n'));
+    const QByteArray local8Bit = logMessage.toLocal8Bit();
+    fwrite(local8Bit.constData(), 1, size_t(local8Bit.size()), stderr);
     fflush(stderr);
 }
 
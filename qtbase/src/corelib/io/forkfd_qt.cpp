@@ -40,7 +40,11 @@
 // these might be defined via precompiled headers
 #include <QtCore/qatomic.h>
 
-#define FORKFD_NO_SPAWNFD
+// spawnfd() is used by QProcess on Linux only, and it cannot be combined
+// with pdfork() on FreeBSD
+#if !defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+#  define FORKFD_NO_SPAWNFD
+#endif
 
 #if defined(QT_NO_DEBUG) && !defined(NDEBUG)
 #  define NDEBUG
@@ -14,6 +14,7 @@ HEADERS +=  \
         io/qfile.h \
         io/qfiledevice.h \
         io/qfiledevice_p.h \
+        io/qfilemapping.h \
         io/qfileinfo.h \
         io/qfileinfo_p.h \
         io/qipaddress_p.h \
@@ -65,6 +66,7 @@ SOURCES += \
         io/qdiriterator.cpp \
         io/qfile.cpp \
         io/qfiledevice.cpp \
+        io/qfilemapping.cpp \
         io/qfileinfo.cpp \
         io/qipaddress.cpp \
         io/qiodevice.cpp \
@@ -1394,6 +1394,134 @@ int QDataStream::skipRawData(int len)
     return skipResult;
 }
 
+
+namespace QtPrivate {
+
+/*!
+    \internal
+
+    Returns \c true if floats are streamed as 32-bit values by \a s.
+*/
+bool canStreamRawData(const QDataStream &s, const float *)
+{
+    return s.version() < QDataStream::Qt_4_6
+            || s.floatingPointPrecision() == QDataStream::SinglePrecision;
+}
+
+/*!
+    \internal
+
+    Returns \c true if doubles are streamed as 64-bit values by \a s.
+*/
+bool canStreamRawData(const QDataStream &s, const double *)
+{
+    return s.version() < QDataStream::Qt_4_6
+            || s.floatingPointPrecision() == QDataStream::DoublePrecision;
+}
+
+static inline bool needsByteSwap(const QDataStream &s, int elementSize)
+{
+    return elementSize > 1 && int(s.byteOrder()) != int(QSysInfo::ByteOrder);
+}
+
+// Plain loops over naturally aligned data, which the compiler vectorizes.
+static void byteSwapElements(char *data, qint64 count, int elementSize)
+{
+    switch (elementSize) {
+    case 2: {
+        quint16 *p = reinterpret_cast<quint16 *>(data);
+        for (qint64 i = 0; i < count; ++i)
+            p[i] = qbswap(p[i]);
+        break;
+    }
+    case 4: {
+        quint32 *p = reinterpret_cast<quint32 *>(data);
+        for (qint64 i = 0; i < count; ++i)
+            p[i] = qbswap(p[i]);
+        break;
+    }
+    case 8: {
+        quint64 *p = reinterpret_cast<quint64 *>(data);
+        for (qint64 i = 0; i < count; ++i)
+            p[i] = qbswap(p[i]);
+        break;
+    }
+    default:
+        Q_UNREACHABLE();
+    }
+}
+
+enum { MaximumRawBlockSize = 1 << 30 };
+
+/*!
+    \internal
+
+    Reads \a count primitives of \a elementSize bytes each into \a data with
+    as few reads from the device as possible, converting them from the byte
+    order of \a s. Returns \c false and sets the status of \a s if the data
+    could not be read completely.
+
+    This is what QDataStream's operator>>() for QVector uses for primitive
+    types, instead of one read per element.
+*/
+bool readRawElements(QDataStream &s, char *data, qint64 count, int elementSize)
+{
+    qint64 remaining = count * elementSize;
+    char *at = data;
+    while (remaining > 0) {
+        const int len = int(qMin<qint64>(remaining, MaximumRawBlockSize));
+        if (s.readRawData(at, len) != len) {
+            if (s.status() == QDataStream::Ok)
+                s.setStatus(QDataStream::ReadPastEnd);
+            return false;
+        }
+        at += len;
+        remaining -= len;
+    }
+
+    if (needsByteSwap(s, elementSize))
+        byteSwapElements(data, count, elementSize);
+    return true;
+}
+
+/*!
+    \internal
+
+    Writes \a count primitives of \a elementSize bytes each from \a data in
+    the byte order of \a s. If no byte swapping is needed, the data is
+    written in place; otherwise it is converted in blocks on the stack.
+    Returns \c false if writing failed.
+*/
+bool writeRawElements(QDataStream &s, const char *data, qint64 count, int elementSize)
+{
+    qint64 remaining = count * elementSize;
+
+    if (!needsByteSwap(s, elementSize)) {
+        while (remaining > 0) {
+            const int len = int(qMin<qint64>(remaining, MaximumRawBlockSize));
+            if (s.writeRawData(data, len) != len)
+                return false;
+            data += len;
+            remaining -= len;
+        }
+        return true;
+    }
+
+    quint64 buffer[2048];
+    while (remaining > 0) {
+        const int len = int(qMin<qint64>(remaining, sizeof(buffer)));
+        memcpy(buffer, data, len);
+        byteSwapElements(reinterpret_cast<char *>(buffer), len / elementSize, elementSize);
+        if (s.writeRawData(reinterpret_cast<const char *>(buffer), len) != len)
+            return false;
+        data += len;
+        remaining -= len;
+    }
+    return true;
+}
+
+} // namespace QtPrivate
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_DATASTREAM
@@ -53,6 +53,7 @@ QT_BEGIN_NAMESPACE
 class qfloat16;
 class QByteArray;
 class QIODevice;
+class QPointF;
 
 template <typename T> class QList;
 template <typename T> class QLinkedList;
@@ -250,6 +251,90 @@ QDataStream &readArrayBasedContainer(QDataStream &s, Container &c)
     return s;
 }
 
+// Maps a type to the primitive it is streamed as, if its stream format is
+// nothing but its memory image, possibly byte swapped. Containers of such
+// types are read and written in bulk; void means element by element.
+template <typename T> struct DataStreamRawElement { typedef void Type; };
+template <> struct DataStreamRawElement<qint8> { typedef qint8 Type; };
+template <> struct DataStreamRawElement<quint8> { typedef quint8 Type; };
+template <> struct DataStreamRawElement<qint16> { typedef qint16 Type; };
+template <> struct DataStreamRawElement<quint16> { typedef quint16 Type; };
+template <> struct DataStreamRawElement<qint32> { typedef qint32 Type; };
+template <> struct DataStreamRawElement<quint32> { typedef quint32 Type; };
+template <> struct DataStreamRawElement<qint64> { typedef qint64 Type; };
+template <> struct DataStreamRawElement<quint64> { typedef quint64 Type; };
+template <> struct DataStreamRawElement<float> { typedef float Type; };
+template <> struct DataStreamRawElement<double> { typedef double Type; };
+#ifndef QT_COORD_TYPE
+// QPointF is streamed as two doubles, which it is made of if qreal is double
+template <> struct DataStreamRawElement<QPointF> { typedef double Type; };
+#endif
+
+// floating point values are only streamed as they are in memory if the
+// precision of the stream matches
+inline bool canStreamRawData(const QDataStream &, const void *) { return true; }
+Q_CORE_EXPORT bool canStreamRawData(const QDataStream &s, const float *);
+Q_CORE_EXPORT bool canStreamRawData(const QDataStream &s, const double *);
+
+Q_CORE_EXPORT bool readRawElements(QDataStream &s, char *data, qint64 count, int elementSize);
+Q_CORE_EXPORT bool writeRawElements(QDataStream &s, const char *data, qint64 count, int elementSize);
+
+template <typename T>
+QDataStream &readVector(QDataStream &s, QVector<T> &v, void *)
+{
+    return readArrayBasedContainer(s, v);
+}
+
+template <typename T, typename Element>
+QDataStream &readVector(QDataStream &s, QVector<T> &v, Element *)
+{
+    Q_STATIC_ASSERT(sizeof(T) % sizeof(Element) == 0);
+    if (!canStreamRawData(s, static_cast<Element *>(nullptr)))
+        return readArrayBasedContainer(s, v);
+
+    StreamStateSaver stateSaver(&s);
+
+    v.clear();
+    quint32 n;
+    s >> n;
+    if (s.status() != QDataStream::Ok)
+        return s;
+
+    // grow in steps, so that a corrupt size does not allocate all at once
+    const quint32 step = qMax<quint32>(1, (1024 * 1024) / sizeof(T));
+    for (quint32 done = 0; done < n; ) {
+        const quint32 chunk = qMin(n - done, step);
+        v.resize(int(done + chunk));
+        if (!readRawElements(s, reinterpret_cast<char *>(v.data() + done),
+                             qint64(chunk) * (sizeof(T) / sizeof(Element)), int(sizeof(Element)))) {
+            v.clear();
+            break;
+        }
+        done += chunk;
+    }
+
+    return s;
+}
+
+template <typename T>
+QDataStream &writeVector(QDataStream &s, const QVector<T> &v, void *)
+{
+    return writeSequentialContainer(s, v);
+}
+
+template <typename T, typename Element>
+QDataStream &writeVector(QDataStream &s, const QVector<T> &v, Element *)
+{
+    Q_STATIC_ASSERT(sizeof(T) % sizeof(Element) == 0);
+    if (!canStreamRawData(s, static_cast<Element *>(nullptr)))
+        return writeSequentialContainer(s, v);
+
+    s << quint32(v.size());
+    writeRawElements(s, reinterpret_cast<const char *>(v.constData()),
+                     qint64(v.size()) * (sizeof(T) / sizeof(Element)), int(sizeof(Element)));
+    return s;
+}
+
 template <typename Container>
 QDataStream &readListBasedContainer(QDataStream &s, Container &c)
 {
@@ -397,13 +482,15 @@ inline QDataStream &operator<<(QDataStream &s, const QLinkedList<T> &l)
 template<typename T>
 inline QDataStream &operator>>(QDataStream &s, QVector<T> &v)
 {
-    return QtPrivate::readArrayBasedContainer(s, v);
+    typedef typename QtPrivate::DataStreamRawElement<T>::Type Element;
+    return QtPrivate::readVector(s, v, static_cast<Element *>(nullptr));
 }
 
 template<typename T>
 inline QDataStream &operator<<(QDataStream &s, const QVector<T> &v)
 {
-    return QtPrivate::writeSequentialContainer(s, v);
+    typedef typename QtPrivate::DataStreamRawElement<T>::Type Element;
+    return QtPrivate::writeVector(s, v, static_cast<Element *>(nullptr));
 }
 
 template <typename T>
@@ -96,6 +96,13 @@
 #include <QtCore/qset.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qvariant.h>
+#ifndef QT_NO_THREAD
+#include <QtCore/qmutex.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+#endif
 
 #include <QtCore/private/qfilesystemiterator_p.h>
 #include <QtCore/private/qfilesystementry_p.h>
@@ -115,7 +122,39 @@ public:
     }
 };
 
-class QDirIteratorPrivate
+class QDirIteratorFilter
+{
+public:
+    QDirIteratorFilter(const QStringList &nameFilters, QDir::Filters filters);
+
+    bool matchesFilters(const QString &fileName, const QFileInfo &fi) const;
+
+    const QStringList nameFilters;
+    const QDir::Filters filters;
+
+#ifndef QT_NO_REGEXP
+    QVector<QRegExp> nameRegExps;
+#endif
+};
+
+/*!
+    \internal
+*/
+QDirIteratorFilter::QDirIteratorFilter(const QStringList &nameFilters, QDir::Filters filters)
+    : nameFilters(nameFilters.contains(QLatin1String("*")) ? QStringList() : nameFilters)
+      , filters(QDir::NoFilter == filters ? QDir::AllEntries : filters)
+{
+#ifndef QT_NO_REGEXP
+    nameRegExps.reserve(nameFilters.size());
+    for (int i = 0; i < nameFilters.size(); ++i)
+        nameRegExps.append(
+            QRegExp(nameFilters.at(i),
+                    (filters & QDir::CaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive,
+                    QRegExp::Wildcard));
+#endif
+}
+
+class QDirIteratorPrivate : public QDirIteratorFilter
 {
 public:
     QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
@@ -126,19 +165,12 @@ public:
     bool entryMatches(const QString & fileName, const QFileInfo &fileInfo);
     void pushDirectory(const QFileInfo &fileInfo);
     void checkAndPushDirectory(const QFileInfo &);
-    bool matchesFilters(const QString &fileName, const QFileInfo &fi) const;
 
     QScopedPointer<QAbstractFileEngine> engine;
 
     QFileSystemEntry dirEntry;
-    const QStringList nameFilters;
-    const QDir::Filters filters;
     const QDirIterator::IteratorFlags iteratorFlags;
 
-#ifndef QT_NO_REGEXP
-    QVector<QRegExp> nameRegExps;
-#endif
-
     QDirIteratorPrivateIteratorStack<QAbstractFileEngineIterator> fileEngineIterators;
 #ifndef QT_NO_FILESYSTEMITERATOR
     QDirIteratorPrivateIteratorStack<QFileSystemIterator> nativeIterators;
@@ -156,19 +188,10 @@ public:
 */
 QDirIteratorPrivate::QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
                                          QDir::Filters filters, QDirIterator::IteratorFlags flags, bool resolveEngine)
-    : dirEntry(entry)
-      , nameFilters(nameFilters.contains(QLatin1String("*")) ? QStringList() : nameFilters)
-      , filters(QDir::NoFilter == filters ? QDir::AllEntries : filters)
+    : QDirIteratorFilter(nameFilters, filters)
+      , dirEntry(entry)
       , iteratorFlags(flags)
 {
-#ifndef QT_NO_REGEXP
-    nameRegExps.reserve(nameFilters.size());
-    for (int i = 0; i < nameFilters.size(); ++i)
-        nameRegExps.append(
-            QRegExp(nameFilters.at(i),
-                    (filters & QDir::CaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive,
-                    QRegExp::Wildcard));
-#endif
     QFileSystemMetaData metaData;
     if (resolveEngine)
         engine.reset(QFileSystemEngine::resolveEntryAndCreateLegacyEngine(dirEntry, metaData));
@@ -318,7 +341,7 @@ void QDirIteratorPrivate::checkAndPushDirectory(const QFileInfo &fileInfo)
     otherwise, false is returned.
 */
 
-bool QDirIteratorPrivate::matchesFilters(const QString &fileName, const QFileInfo &fi) const
+bool QDirIteratorFilter::matchesFilters(const QString &fileName, const QFileInfo &fi) const
 {
     Q_ASSERT(!fileName.isEmpty());
 
@@ -397,6 +420,169 @@ bool QDirIteratorPrivate::matchesFilters(const QString &fileName, const QFileInf
     return true;
 }
 
+#if !defined(QT_NO_THREAD) && !defined(QT_NO_FILESYSTEMITERATOR)
+/*!
+    \internal
+
+    Shared state of a QDirIterator::traverse() call. Directories still to be
+    read are kept in \c pending; the calling thread and any helpers started
+    on the thread pool take directories from there until it is empty and no
+    thread is reading a directory any more.
+*/
+class QDirTraversal : public QDirIteratorFilter
+{
+public:
+    QDirTraversal(const QStringList &nameFilters, QDir::Filters filters,
+                  QDirIterator::IteratorFlags flags, const QDirIterator::EntryFunction &function)
+        : QDirIteratorFilter(nameFilters, filters)
+        , iteratorFlags(flags)
+        , function(function)
+        , busy(0)
+    {
+    }
+
+    static void run(const QFileSystemEntry &root, const QStringList &nameFilters,
+                    QDir::Filters filters, QDirIterator::IteratorFlags flags,
+                    const QDirIterator::EntryFunction &function, QThreadPool *pool);
+
+private:
+    class Helper;
+
+    void work();
+    void readDirectory(const QFileSystemEntry &directory, QVector<QFileSystemEntry> *subdirectories);
+    bool shouldDescend(const QFileInfo &fileInfo);
+
+    const QDirIterator::IteratorFlags iteratorFlags;
+    const QDirIterator::EntryFunction function;
+
+    QMutex mutex;
+    QWaitCondition pendingChanged;
+    QVector<QFileSystemEntry> pending;
+    int busy;
+
+    // Loop protection
+    QSet<QString> visitedLinks;
+};
+
+class QDirTraversal::Helper : public QRunnable
+{
+public:
+    explicit Helper(const QSharedPointer<QDirTraversal> &traversal)
+        : traversal(traversal)
+    {
+    }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        traversal->work();
+    }
+
+private:
+    // keeps the state alive if the caller returns before this helper does
+    const QSharedPointer<QDirTraversal> traversal;
+};
+
+void QDirTraversal::run(const QFileSystemEntry &root, const QStringList &nameFilters,
+                        QDir::Filters filters, QDirIterator::IteratorFlags flags,
+                        const QDirIterator::EntryFunction &function, QThreadPool *pool)
+{
+    QSharedPointer<QDirTraversal> traversal(new QDirTraversal(nameFilters, filters, flags, function));
+    if (flags & QDirIterator::FollowSymlinks) {
+        QFileInfo rootInfo(new QFileInfoPrivate(root, QFileSystemMetaData()));
+        traversal->visitedLinks << rootInfo.canonicalFilePath();
+    }
+    traversal->pending.append(root);
+
+    if (flags & QDirIterator::Subdirectories) {
+        if (!pool)
+            pool = QThreadPool::globalInstance();
+
+        // Only take threads that are idle right now: waiting for a busy pool
+        // could deadlock if the caller itself runs on one of its threads.
+        for (int i = 1; i < pool->maxThreadCount(); ++i) {
+            Helper *helper = new Helper(traversal);
+            if (!pool->tryStart(helper)) {
+                delete helper;
+                break;
+            }
+        }
+    }
+
+    traversal->work();
+}
+
+void QDirTraversal::work()
+{
+    QMutexLocker locker(&mutex);
+    forever {
+        while (pending.isEmpty()) {
+            if (busy == 0)
+                return;
+            pendingChanged.wait(&mutex);
+        }
+
+        const QFileSystemEntry directory = pending.takeLast();
+        ++busy;
+        locker.unlock();
+
+        QVector<QFileSystemEntry> subdirectories;
+        readDirectory(directory, &subdirectories);
+
+        locker.relock();
+        --busy;
+        pending += subdirectories;
+        if (!subdirectories.isEmpty() || (busy == 0 && pending.isEmpty()))
+            pendingChanged.wakeAll();
+    }
+}
+
+void QDirTraversal::readDirectory(const QFileSystemEntry &directory,
+                                  QVector<QFileSystemEntry> *subdirectories)
+{
+    QFileSystemIterator it(directory, filters, nameFilters, iteratorFlags);
+    QFileSystemEntry entry;
+    QFileSystemMetaData metaData;
+    while (it.advance(entry, metaData)) {
+        QFileInfo info(new QFileInfoPrivate(entry, metaData));
+        if (shouldDescend(info))
+            subdirectories->append(entry);
+        if (matchesFilters(entry.fileName(), info))
+            function(info);
+        metaData = QFileSystemMetaData();
+    }
+}
+
+bool QDirTraversal::shouldDescend(const QFileInfo &fileInfo)
+{
+    // Same rules as QDirIteratorPrivate::checkAndPushDirectory()
+    if (!(iteratorFlags & QDirIterator::Subdirectories))
+        return false;
+
+    if (!fileInfo.isDir())
+        return false;
+
+    if (!(iteratorFlags & QDirIterator::FollowSymlinks) && fileInfo.isSymLink())
+        return false;
+
+    const QString fileName = fileInfo.fileName();
+    if (QLatin1String(".") == fileName || QLatin1String("..") == fileName)
+        return false;
+
+    if (!(filters & QDir::AllDirs) && !(filters & QDir::Hidden) && fileInfo.isHidden())
+        return false;
+
+    if (iteratorFlags & QDirIterator::FollowSymlinks) {
+        const QString canonicalPath = fileInfo.canonicalFilePath();
+        QMutexLocker locker(&mutex);
+        if (visitedLinks.contains(canonicalPath))
+            return false;
+        visitedLinks << canonicalPath;
+    }
+
+    return true;
+}
+#endif // !QT_NO_THREAD && !QT_NO_FILESYSTEMITERATOR
+
 /*!
     Constructs a QDirIterator that can iterate over \a dir's entrylist, using
     \a dir's name filters and regular filters. You can pass options via \a
@@ -556,4 +742,75 @@ QString QDirIterator::path() const
     return d->dirEntry.filePath();
 }
 
+#ifndef QT_NO_THREAD
+/*!
+    \typedef QDirIterator::EntryFunction
+    \since 5.11
+
+    Synonym for \c{std::function<void(const QFileInfo &)>}, the type of the
+    function passed to traverse().
+*/
+
+/*!
+    \since 5.11
+
+    Calls \a function for every entry below \a path that matches \a filters,
+    reading directories in parallel on \a pool. If \a pool is \c nullptr,
+    QThreadPool::globalInstance() is used.
+
+    \a flags work as for the QDirIterator constructors. Without
+    QDirIterator::Subdirectories only \a path itself is read, on the calling
+    thread.
+
+    The function blocks until the whole tree has been visited. \a function
+    is called from several threads at once and in no particular order, so it
+    must be thread-safe. The QFileInfo passed to it only carries what the
+    directory listing reported (usually the type of the entry); any other
+    attribute is fetched from the file system when it is first queried.
+
+    Only threads that are idle in \a pool are used, so it is safe to call
+    this function from a task running on \a pool itself.
+
+    \sa QDirIterator::IteratorFlags
+*/
+void QDirIterator::traverse(const QString &path, QDir::Filters filters, IteratorFlags flags,
+                            const EntryFunction &function, QThreadPool *pool)
+{
+    traverse(path, QStringList(), filters, flags, function, pool);
+}
+
+/*!
+    \since 5.11
+    \overload
+
+    Calls \a function for every entry below \a path that matches
+    \a nameFilters and \a filters, reading directories in parallel on
+    \a pool.
+*/
+void QDirIterator::traverse(const QString &path, const QStringList &nameFilters,
+                            QDir::Filters filters, IteratorFlags flags,
+                            const EntryFunction &function, QThreadPool *pool)
+{
+    QFileSystemEntry entry(path);
+#ifndef QT_NO_FILESYSTEMITERATOR
+    QFileSystemMetaData metaData;
+    QScopedPointer<QAbstractFileEngine> engine(
+        QFileSystemEngine::resolveEntryAndCreateLegacyEngine(entry, metaData));
+    if (!engine) {
+        QDirTraversal::run(entry, nameFilters, filters, flags, function, pool);
+        return;
+    }
+#else
+    Q_UNUSED(pool);
+#endif
+
+    // Resources and custom file engines are iterated sequentially
+    QDirIterator it(path, nameFilters, filters, flags);
+    while (it.hasNext()) {
+        it.next();
+        function(it.fileInfo());
+    }
+}
+#endif // QT_NO_THREAD
+
 QT_END_NAMESPACE
@@ -42,8 +42,11 @@
 
 #include <QtCore/qdir.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
+class QThreadPool;
 
 class QDirIteratorPrivate;
 class Q_CORE_EXPORT QDirIterator {
@@ -76,6 +79,16 @@ public:
     QFileInfo fileInfo() const;
     QString path() const;
 
+#ifndef QT_NO_THREAD
+    typedef std::function<void(const QFileInfo &)> EntryFunction;
+
+    static void traverse(const QString &path, QDir::Filters filters, IteratorFlags flags,
+                         const EntryFunction &function, QThreadPool *pool = Q_NULLPTR);
+    static void traverse(const QString &path, const QStringList &nameFilters,
+                         QDir::Filters filters, IteratorFlags flags,
+                         const EntryFunction &function, QThreadPool *pool = Q_NULLPTR);
+#endif
+
 private:
     Q_DISABLE_COPY(QDirIterator)
 
@@ -42,6 +42,20 @@
 #include "qfiledevice_p.h"
 #include "qfsfileengine_p.h"
 
+#if !defined(QT_NO_QFUTURE) && !defined(QT_NO_THREAD)
+#include "qthreadpool.h"
+#include "qfutureinterface.h"
+#include "private/qbytearray_p.h"
+#ifdef Q_OS_WIN
+#  include <qt_windows.h>
+#  include <io.h>
+#else
+#  include "private/qcore_unix_p.h"
+#endif
+
+#include <limits>
+#endif
+
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
 #endif
@@ -810,6 +824,303 @@ bool QFileDevice::setFileTime(const QDateTime &newDate, QFileDevice::FileTime fi
     return true;
 }
 
+#if !defined(QT_NO_QFUTURE) && !defined(QT_NO_THREAD)
+namespace {
+#if defined(Q_OS_WIN)
+typedef HANDLE NativeFileHandle;
+const NativeFileHandle InvalidNativeFileHandle = INVALID_HANDLE_VALUE;
+#else
+typedef int NativeFileHandle;
+const NativeFileHandle InvalidNativeFileHandle = -1;
+#endif
+
+/*
+    The asynchronous requests work on their own duplicate of the file
+    descriptor, so that the file can be closed (or even be destroyed) while
+    they are still running.
+*/
+NativeFileHandle duplicateNativeHandle(int fd)
+{
+    if (fd < 0)
+        return InvalidNativeFileHandle;
+#if defined(Q_OS_WINRT)
+    return InvalidNativeFileHandle;
+#elif defined(Q_OS_WIN)
+    HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+    HANDLE duplicate = INVALID_HANDLE_VALUE;
+    if (handle == INVALID_HANDLE_VALUE
+            || !DuplicateHandle(GetCurrentProcess(), handle, GetCurrentProcess(), &duplicate,
+                                0, FALSE, DUPLICATE_SAME_ACCESS)) {
+        return INVALID_HANDLE_VALUE;
+    }
+    return duplicate;
+#else
+    return qt_safe_dup(fd);
+#endif
+}
+
+void closeNativeHandle(NativeFileHandle handle)
+{
+    if (handle == InvalidNativeFileHandle)
+        return;
+#if defined(Q_OS_WIN)
+    CloseHandle(handle);
+#else
+    qt_safe_close(handle);
+#endif
+}
+
+// Reads or writes up to size bytes at offset, without using or moving the
+// file position. Returns the number of bytes transferred, or -1 on error.
+qint64 nativeTransferAt(NativeFileHandle handle, qint64 offset, char *data, qint64 size, bool write)
+{
+    qint64 done = 0;
+    while (done < size) {
+#if defined(Q_OS_WIN)
+        const DWORD chunk = DWORD(qMin(size - done, qint64(std::numeric_limits<DWORD>::max() / 2)));
+        OVERLAPPED overlapped;
+        memset(&overlapped, 0, sizeof(overlapped));
+        overlapped.Offset = DWORD(quint64(offset + done));
+        overlapped.OffsetHigh = DWORD(quint64(offset + done) >> 32);
+        DWORD transferred = 0;
+        const BOOL ok = write
+                ? WriteFile(handle, data + done, chunk, &transferred, &overlapped)
+                : ReadFile(handle, data + done, chunk, &transferred, &overlapped);
+        if (!ok) {
+            if (!write && GetLastError() == ERROR_HANDLE_EOF)
+                break;
+            return done ? done : -1;
+        }
+        const qint64 r = transferred;
+#else
+        const size_t chunk = size_t(qMin(size - done, qint64(std::numeric_limits<ssize_t>::max())));
+        qint64 r;
+        if (write)
+            EINTR_LOOP(r, ::pwrite(handle, data + done, chunk, QT_OFF_T(offset + done)));
+        else
+            EINTR_LOOP(r, ::pread(handle, data + done, chunk, QT_OFF_T(offset + done)));
+        if (r < 0)
+            return done ? done : -1;
+#endif
+        if (r == 0)
+            break;
+        done += r;
+    }
+    return done;
+}
+
+class AsyncReadTask : public QRunnable
+{
+public:
+    AsyncReadTask(NativeFileHandle handle, const QVector<QPair<qint64, qint64> > &requests)
+        : handle(handle), requests(requests)
+    {
+        promise.setProgressRange(0, requests.size());
+        promise.reportStarted();
+    }
+    ~AsyncReadTask()
+    {
+        closeNativeHandle(handle);
+    }
+
+    QFuture<QByteArray> future() { return promise.future(); }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        for (int i = 0; i < requests.size() && !promise.isCanceled(); ++i) {
+            const qint64 offset = requests.at(i).first;
+            const qint64 size = qMin(requests.at(i).second, qint64(MaxByteArraySize - 1));
+            QByteArray buffer;
+            if (offset >= 0 && size > 0) {
+                buffer.resize(int(size));
+                const qint64 r = nativeTransferAt(handle, offset, buffer.data(), size, false);
+                if (r < 0)
+                    buffer = QByteArray();
+                else
+                    buffer.resize(int(r));
+            }
+            promise.reportAndMoveResult(std::move(buffer), i);
+            promise.setProgressValue(i + 1);
+        }
+        promise.reportFinished();
+    }
+
+private:
+    QFutureInterface<QByteArray> promise;
+    NativeFileHandle handle;
+    QVector<QPair<qint64, qint64> > requests;
+};
+
+class AsyncWriteTask : public QRunnable
+{
+public:
+    AsyncWriteTask(NativeFileHandle handle, const QVector<QPair<qint64, QByteArray> > &requests)
+        : handle(handle), requests(requests)
+    {
+        promise.setProgressRange(0, requests.size());
+        promise.reportStarted();
+    }
+    ~AsyncWriteTask()
+    {
+        closeNativeHandle(handle);
+    }
+
+    QFuture<qint64> future() { return promise.future(); }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        for (int i = 0; i < requests.size() && !promise.isCanceled(); ++i) {
+            const qint64 offset = requests.at(i).first;
+            QByteArray &data = requests[i].second;
+            qint64 written = -1;
+            if (offset >= 0)
+                written = nativeTransferAt(handle, offset, data.data(), data.size(), true);
+            data.clear();
+            promise.reportResult(written, i);
+            promise.setProgressValue(i + 1);
+        }
+        promise.reportFinished();
+    }
+
+private:
+    QFutureInterface<qint64> promise;
+    NativeFileHandle handle;
+    QVector<QPair<qint64, QByteArray> > requests;
+};
+
+// the requests block on the disk, not on the CPU, so they get their own pool
+Q_GLOBAL_STATIC(QThreadPool, asyncIoThreadPool)
+} // unnamed namespace
+
+/*!
+    \since 5.11
+
+    Starts reading up to \a maxSize bytes from \a offset in the
+    background and returns a future for the data. The read is done on a
+    separate thread while the calling thread continues; the file position
+    of this device is neither used nor changed.
+
+    The result is empty if \a offset is at or beyond the end of the file,
+    and a null QByteArray if the read failed.
+
+    \sa writeAtAsync()
+*/
+QFuture<QByteArray> QFileDevice::readAtAsync(qint64 offset, qint64 maxSize)
+{
+    return readAtAsync(QVector<QPair<qint64, qint64> >() << qMakePair(offset, maxSize));
+}
+
+/*!
+    \since 5.11
+    \overload
+
+    Starts all \a requests, each a pair of offset and maximum size, with a
+    single submission. The returned future has one result per request, in the
+    order of \a requests, and reports each result as soon as it is available.
+
+    If the file is not backed by a native file descriptor, for instance when it
+    is a resource, the requests are executed synchronously and the returned
+    future has already finished.
+*/
+QFuture<QByteArray> QFileDevice::readAtAsync(const QVector<QPair<qint64, qint64> > &requests)
+{
+    if (!isOpen() || !(openMode() & ReadOnly)) {
+        qWarning("QFileDevice::readAtAsync: device not open for reading");
+        return QFuture<QByteArray>();
+    }
+
+    // make sure the data written through this device so far is visible
+    flush();
+
+    const NativeFileHandle handle = duplicateNativeHandle(this->handle());
+    if (handle != InvalidNativeFileHandle) {
+        AsyncReadTask *task = new AsyncReadTask(handle, requests);
+        QFuture<QByteArray> future = task->future();
+        asyncIoThreadPool()->start(task);
+        return future;
+    }
+
+    QFutureInterface<QByteArray> promise;
+    promise.reportStarted();
+    const qint64 oldPos = pos();
+    for (int i = 0; i < requests.size(); ++i) {
+        QByteArray result;
+        if (seek(requests.at(i).first))
+            result = read(requests.at(i).second);
+        promise.reportAndMoveResult(std::move(result), i);
+    }
+    seek(oldPos);
+    promise.reportFinished();
+    return promise.future();
+}
+
+/*!
+    \since 5.11
+
+    Starts writing \a data at \a offset in the background and returns a
+    future for the number of bytes written, or -1 if an error occurred. The
+    file position of this device is neither used nor changed.
+
+    Data written through the device before this call is flushed first. Data
+    written through the device while the request is running may end up in the
+    file in either order.
+
+    \note On Unix, if the file was opened with QIODevice::Append the data is
+    always appended, regardless of \a offset.
+
+    \sa readAtAsync()
+*/
+QFuture<qint64> QFileDevice::writeAtAsync(qint64 offset, const QByteArray &data)
+{
+    return writeAtAsync(QVector<QPair<qint64, QByteArray> >() << qMakePair(offset, data));
+}
+
+/*!
+    \since 5.11
+    \overload
+
+    Starts all \a requests, each a pair of offset and data, with a single
+    submission. The returned future has one result per request, in the order
+    of \a requests.
+
+    If the file is not backed by a native file descriptor the requests are
+    executed synchronously and the returned future has already finished.
+*/
+QFuture<qint64> QFileDevice::writeAtAsync(const QVector<QPair<qint64, QByteArray> > &requests)
+{
+    if (!isOpen() || !(openMode() & WriteOnly)) {
+        qWarning("QFileDevice::writeAtAsync: device not open for writing");
+        return QFuture<qint64>();
+    }
+
+    flush();
+
+    const NativeFileHandle handle = duplicateNativeHandle(this->handle());
+    if (handle != InvalidNativeFileHandle) {
+        AsyncWriteTask *task = new AsyncWriteTask(handle, requests);
+        QFuture<qint64> future = task->future();
+        asyncIoThreadPool()->start(task);
+        return future;
+    }
+
+    QFutureInterface<qint64> promise;
+    promise.reportStarted();
+    const qint64 oldPos = pos();
+    for (int i = 0; i < requests.size(); ++i) {
+        qint64 written = -1;
+        if (seek(requests.at(i).first)) {
+            written = write(requests.at(i).second);
+            if (!flush())
+                written = -1;
+        }
+        promise.reportResult(written, i);
+    }
+    seek(oldPos);
+    promise.reportFinished();
+    return promise.future();
+}
+#endif // !QT_NO_QFUTURE && !QT_NO_THREAD
+
 QT_END_NAMESPACE
 
 #ifndef QT_NO_QOBJECT
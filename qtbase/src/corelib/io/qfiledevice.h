@@ -42,6 +42,11 @@
 
 #include <QtCore/qiodevice.h>
 #include <QtCore/qstring.h>
+#if !defined(QT_NO_QFUTURE) && !defined(QT_NO_THREAD)
+#include <QtCore/qfuture.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qvector.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -130,6 +135,13 @@ public:
     QDateTime fileTime(QFileDevice::FileTime time) const;
     bool setFileTime(const QDateTime &newDate, QFileDevice::FileTime fileTime);
 
+#if !defined(QT_NO_QFUTURE) && !defined(QT_NO_THREAD)
+    QFuture<QByteArray> readAtAsync(qint64 offset, qint64 maxSize);
+    QFuture<QByteArray> readAtAsync(const QVector<QPair<qint64, qint64> > &requests);
+    QFuture<qint64> writeAtAsync(qint64 offset, const QByteArray &data);
+    QFuture<qint64> writeAtAsync(const QVector<QPair<qint64, QByteArray> > &requests);
+#endif
+
 protected:
     QFileDevice();
 #ifdef QT_NO_QOBJECT
@@ -0,0 +1,398 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qplatformdefs.h"
+#include "qfilemapping.h"
+#include "qcoreapplication.h"
+
+#if defined(Q_OS_WIN)
+#  include <qt_windows.h>
+#  include <io.h>
+#else
+#  include <sys/mman.h>
+#  include <errno.h>
+#  include <unistd.h>
+#endif
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QFileMapping
+    \inmodule QtCore
+    \since 5.11
+    \brief The QFileMapping class manages a memory-mapped region of a file.
+
+    \ingroup io
+    \ingroup shared
+    \reentrant
+
+    QFileMapping maps a region of a QFileDevice into memory, like
+    QFileDevice::map(). Unlike the raw pointer returned by that function, the
+    mapping is owned by the QFileMapping object and its copies rather than by
+    the device: it stays valid after the file has been closed or destroyed, and
+    is unmapped when the last QFileMapping referring to it is destroyed.
+
+    toByteArray() returns QByteArray objects that point directly into the
+    mapped memory, so that APIs taking a QByteArray, such as
+    QJsonDocument::fromJson() or QXmlStreamReader, can parse a mapped file
+    without copying it to the heap:
+
+    \code
+    QFile file("data.json");
+    file.open(QIODevice::ReadOnly);
+    QFileMapping mapping(&file);
+    QJsonDocument doc = QJsonDocument::fromJson(mapping.toByteArray());
+    \endcode
+
+    Like QByteArray::fromRawData(), the returned arrays do not own the memory.
+    They must not be used after the last copy of the QFileMapping has been
+    destroyed. Modifying such an array makes it detach from the mapping.
+
+    If the device has no native file handle (for instance a file in the
+    resource system), the mapping is obtained from QFileDevice::map() and
+    stays owned by the device.
+
+    \sa QFileDevice::map(), QByteArray::fromRawData()
+*/
+
+class QFileMappingPrivate : public QSharedData
+{
+public:
+    QFileMappingPrivate()
+        : address(nullptr), size(0), mapStart(nullptr), mapLength(0),
+          error(QFileDevice::NoError)
+    { }
+    ~QFileMappingPrivate();
+
+    bool mapNative(int fd, QIODevice::OpenMode openMode, qint64 offset, qint64 size,
+                   QFileDevice::MemoryMapFlags flags);
+    void setError(QFileDevice::FileError error, const QString &errorString);
+
+    uchar *address;
+    qint64 size;
+
+    // the region actually mapped, starting at a page boundary; null if the
+    // mapping belongs to the device
+    void *mapStart;
+    quint64 mapLength;
+
+    QFileDevice::FileError error;
+    QString errorString;
+};
+
+QFileMappingPrivate::~QFileMappingPrivate()
+{
+    if (!mapStart)
+        return;
+#if defined(Q_OS_WIN)
+    UnmapViewOfFile(mapStart);
+#else
+    munmap(mapStart, size_t(mapLength));
+#endif
+}
+
+void QFileMappingPrivate::setError(QFileDevice::FileError err, const QString &str)
+{
+    error = err;
+    errorString = str;
+}
+
+/*
+    Maps the region using the native handle \a fd, independently of the
+    device. Returns \c false if \a fd cannot be used for that, in which case
+    the caller falls back to QFileDevice::map(); otherwise returns \c true and
+    sets the error if mapping failed.
+*/
+bool QFileMappingPrivate::mapNative(int fd, QIODevice::OpenMode openMode, qint64 offset,
+                                    qint64 length, QFileDevice::MemoryMapFlags flags)
+{
+#if defined(Q_OS_WINRT)
+    Q_UNUSED(fd);
+    Q_UNUSED(openMode);
+    Q_UNUSED(offset);
+    Q_UNUSED(length);
+    Q_UNUSED(flags);
+    return false;
+#elif defined(Q_OS_WIN)
+    HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    const DWORD protection = (openMode & QIODevice::WriteOnly) ? PAGE_READWRITE : PAGE_READONLY;
+    HANDLE mapHandle = ::CreateFileMapping(handle, 0, protection, 0, 0, 0);
+    if (!mapHandle) {
+        setError(QFileDevice::PermissionsError, qt_error_string());
+        return true;
+    }
+
+    SYSTEM_INFO sysinfo;
+    ::GetSystemInfo(&sysinfo);
+    const quint64 extra = quint64(offset) % sysinfo.dwAllocationGranularity;
+    const quint64 realOffset = quint64(offset) - extra;
+    DWORD access = (openMode & QIODevice::WriteOnly) ? FILE_MAP_WRITE : FILE_MAP_READ;
+    if (flags & QFileDevice::MapPrivateOption)
+        access = FILE_MAP_COPY;
+
+    mapLength = quint64(length) + extra;
+    mapStart = ::MapViewOfFile(mapHandle, access, DWORD(realOffset >> 32),
+                               DWORD(realOffset & Q_UINT64_C(0xffffffff)), SIZE_T(mapLength));
+    // the view keeps the file mapping object alive
+    ::CloseHandle(mapHandle);
+    if (!mapStart) {
+        setError(QFileDevice::UnspecifiedError, qt_error_string());
+        return true;
+    }
+#else
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    const quint64 extra = quint64(offset) % quint64(pageSize);
+    if (quint64(length) + extra > quint64(size_t(-1))) {
+        setError(QFileDevice::UnspecifiedError, qt_error_string(int(EINVAL)));
+        return true;
+    }
+
+    int access = 0;
+    if (openMode & QIODevice::ReadOnly)
+        access |= PROT_READ;
+    if (openMode & QIODevice::WriteOnly)
+        access |= PROT_WRITE;
+    int sharemode = MAP_SHARED;
+    if (flags & QFileDevice::MapPrivateOption) {
+        sharemode = MAP_PRIVATE;
+        access |= PROT_WRITE;
+    }
+
+    mapLength = quint64(length) + extra;
+    void *ptr = QT_MMAP(nullptr, size_t(mapLength), access, sharemode, fd,
+                        QT_OFF_T(quint64(offset) - extra));
+    if (ptr == MAP_FAILED) {
+        const int err = errno;
+        mapLength = 0;
+        setError(err == EBADF || err == EACCES ? QFileDevice::PermissionsError
+                                               : QFileDevice::ResourceError,
+                 qt_error_string(err));
+        return true;
+    }
+    mapStart = ptr;
+#endif
+
+    address = static_cast<uchar *>(mapStart) + extra;
+    size = length;
+    return true;
+}
+
+/*!
+    Constructs a null mapping.
+
+    \sa isNull()
+*/
+QFileMapping::QFileMapping()
+{
+}
+
+/*!
+    Maps \a size bytes of \a device into memory, starting at \a offset. If
+    \a size is negative, the rest of the file from \a offset on is mapped.
+
+    The device must be open. The mapping has the same access as the device,
+    except when using QFileDevice::MapPrivateOption in \a flags, in which
+    case the mapped memory is always writable and changes are not written
+    back to the file.
+
+    If the file cannot be mapped, isNull() returns \c true and error() tells
+    why.
+*/
+QFileMapping::QFileMapping(QFileDevice *device, qint64 offset, qint64 size,
+                           QFileDevice::MemoryMapFlags flags)
+    : d(new QFileMappingPrivate)
+{
+    if (!device || !device->isOpen()) {
+        d->setError(QFileDevice::OpenError,
+                    QCoreApplication::translate("QFileMapping", "Device is not open"));
+        return;
+    }
+
+    if (size < 0)
+        size = device->size() - offset;
+    if (offset < 0 || size <= 0) {
+        d->setError(QFileDevice::UnspecifiedError,
+                    QCoreApplication::translate("QFileMapping", "Invalid region"));
+        return;
+    }
+
+    // make sure the data buffered in the device is part of the mapping
+    device->flush();
+
+    const int fd = device->handle();
+    if (fd >= 0 && d->mapNative(fd, device->openMode(), offset, size, flags))
+        return;
+
+    uchar *address = device->map(offset, size, flags);
+    if (!address) {
+        d->setError(device->error(), device->errorString());
+        return;
+    }
+    d->address = address;
+    d->size = size;
+}
+
+/*!
+    Constructs a copy of \a other. Both objects refer to the same mapping.
+*/
+QFileMapping::QFileMapping(const QFileMapping &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Destroys this object. The mapping is unmapped if this was the last
+    object referring to it.
+*/
+QFileMapping::~QFileMapping()
+{
+}
+
+/*!
+    Makes this object refer to the mapping of \a other and returns a
+    reference to it.
+*/
+QFileMapping &QFileMapping::operator=(const QFileMapping &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QFileMapping &QFileMapping::operator=(QFileMapping &&other)
+
+    Move-assigns \a other to this QFileMapping instance.
+*/
+
+/*!
+    \fn void QFileMapping::swap(QFileMapping &other)
+
+    Swaps this mapping with \a other. This function is very fast and
+    never fails.
+*/
+
+/*!
+    Returns \c true if this object does not refer to mapped memory.
+*/
+bool QFileMapping::isNull() const
+{
+    return !d || !d->address;
+}
+
+/*!
+    Returns the error that occurred while mapping the file, or
+    QFileDevice::NoError.
+
+    \sa errorString()
+*/
+QFileDevice::FileError QFileMapping::error() const
+{
+    return d ? d->error : QFileDevice::NoError;
+}
+
+/*!
+    Returns a human-readable description of the error that occurred while
+    mapping the file.
+
+    \sa error()
+*/
+QString QFileMapping::errorString() const
+{
+    return d ? d->errorString : QString();
+}
+
+/*!
+    Returns a pointer to the mapped memory, or \c nullptr if the mapping is
+    null.
+*/
+const uchar *QFileMapping::constData() const
+{
+    return d ? d->address : nullptr;
+}
+
+/*!
+    Returns a pointer to the mapped memory, or \c nullptr if the mapping is
+    null. Writing to it is only allowed if the device was open for writing
+    or the mapping was created with QFileDevice::MapPrivateOption.
+
+    All copies of this object share the same memory.
+*/
+uchar *QFileMapping::data() const
+{
+    return d ? d->address : nullptr;
+}
+
+/*!
+    Returns the size of the mapped region in bytes.
+*/
+qint64 QFileMapping::size() const
+{
+    return d ? d->size : 0;
+}
+
+/*!
+    Returns a QByteArray referring to \a length bytes of the mapped memory,
+    starting at \a offset relative to the start of the mapping. If \a length
+    is negative, the array extends to the end of the mapping. The data is not
+    copied; see QByteArray::fromRawData().
+
+    The array is only valid as long as this mapping (or a copy of it)
+    exists. A QByteArray can hold at most 2 GB; use several views to access
+    bigger mappings.
+*/
+QByteArray QFileMapping::toByteArray(qint64 offset, qint64 length) const
+{
+    if (isNull() || offset < 0 || offset > d->size)
+        return QByteArray();
+    if (length < 0 || length > d->size - offset)
+        length = d->size - offset;
+    if (length > std::numeric_limits<int>::max()) {
+        qWarning("QFileMapping::toByteArray: region too large for a QByteArray");
+        return QByteArray();
+    }
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(d->address + offset), int(length));
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,86 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QFILEMAPPING_H
+#define QFILEMAPPING_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qfiledevice.h>
+#include <QtCore/qshareddata.h>
+
+QT_BEGIN_NAMESPACE
+
+class QFileMappingPrivate;
+class Q_CORE_EXPORT QFileMapping
+{
+public:
+    QFileMapping();
+    explicit QFileMapping(QFileDevice *device, qint64 offset = 0, qint64 size = -1,
+                          QFileDevice::MemoryMapFlags flags = QFileDevice::NoOptions);
+    QFileMapping(const QFileMapping &other);
+    ~QFileMapping();
+
+    QFileMapping &operator=(const QFileMapping &other);
+#ifdef Q_COMPILER_RVALUE_REFS
+    QFileMapping &operator=(QFileMapping &&other) Q_DECL_NOTHROW { swap(other); return *this; }
+#endif
+
+    inline void swap(QFileMapping &other) Q_DECL_NOTHROW
+    { qSwap(d, other.d); }
+
+    bool isNull() const;
+    QFileDevice::FileError error() const;
+    QString errorString() const;
+
+    const uchar *constData() const;
+    uchar *data() const;
+    qint64 size() const;
+
+    QByteArray toByteArray(qint64 offset = 0, qint64 length = -1) const;
+
+private:
+    QExplicitlySharedDataPointer<QFileMappingPrivate> d;
+};
+
+Q_DECLARE_SHARED(QFileMapping)
+
+QT_END_NAMESPACE
+
+#endif // QFILEMAPPING_H
@@ -91,6 +91,8 @@ private:
     int uncShareIndex;
     bool onlyDirs;
 #else
+    void fillMetaDataAt(const QT_DIRENT &entry, QFileSystemMetaData &metaData);
+
     QT_DIR *dir;
     QT_DIRENT *dirEntry;
     int lastError;
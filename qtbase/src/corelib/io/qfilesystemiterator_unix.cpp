@@ -44,6 +44,8 @@
 
 #include <stdlib.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -82,6 +84,10 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
     if (dirEntry) {
         fileEntry = QFileSystemEntry(nativePath + QByteArray(dirEntry->d_name), QFileSystemEntry::FromNativePath());
         metaData.fillFromDirEnt(*dirEntry);
+#ifdef AT_SYMLINK_NOFOLLOW
+        if (!metaData.hasFlags(QFileSystemMetaData::LinkType))
+            fillMetaDataAt(*dirEntry, metaData);
+#endif
         return true;
     }
 
@@ -89,6 +95,40 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
     return false;
 }
 
+#ifdef AT_SYMLINK_NOFOLLOW
+/*!
+    \internal
+
+    The file system did not report the type of \a entry in readdir(), so
+    ask for it with an lstat relative to the directory being iterated.
+    That avoids resolving the full path of every entry again, which is
+    what a later QFileSystemEngine::fillMetaData() would do.
+*/
+void QFileSystemIterator::fillMetaDataAt(const QT_DIRENT &entry, QFileSystemMetaData &metaData)
+{
+#if defined(QT_USE_XOPEN_LFS_EXTENSIONS) && defined(QT_LARGEFILE_SUPPORT)
+    struct stat64 statBuffer;
+    if (::fstatat64(dirfd(dir), entry.d_name, &statBuffer, AT_SYMLINK_NOFOLLOW) != 0)
+        return;
+#else
+    QT_STATBUF statBuffer;
+    if (::fstatat(dirfd(dir), entry.d_name, &statBuffer, AT_SYMLINK_NOFOLLOW) != 0)
+        return;
+#endif
+
+    metaData.knownFlagsMask |= QFileSystemMetaData::LinkType;
+    if (S_ISLNK(statBuffer.st_mode)) {
+        // the target still needs a stat(2), which is done lazily
+        metaData.entryFlags |= QFileSystemMetaData::LinkType;
+        return;
+    }
+
+    metaData.fillFromStatBuf(statBuffer);
+    metaData.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags
+            | QFileSystemMetaData::ExistsAttribute;
+}
+#endif
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_FILESYSTEMITERATOR
@@ -88,7 +88,7 @@ QFileSystemWatcherEngine *QFileSystemWatcherPrivate::createNativeEngine(QObject
 }
 
 QFileSystemWatcherPrivate::QFileSystemWatcherPrivate()
-    : native(0), poller(0)
+    : native(0), poller(0), coalescingInterval(-1), coalescingTimer(0)
 {
 }
 
@@ -145,7 +145,10 @@ void QFileSystemWatcherPrivate::_q_fileChanged(const QString &path, bool removed
     }
     if (removed)
         files.removeAll(path);
-    emit q->fileChanged(path, QFileSystemWatcher::QPrivateSignal());
+    if (coalescingInterval >= 0)
+        queueChange(&pendingFiles, path);
+    else
+        emit q->fileChanged(path, QFileSystemWatcher::QPrivateSignal());
 }
 
 void QFileSystemWatcherPrivate::_q_directoryChanged(const QString &path, bool removed)
@@ -157,7 +160,41 @@ void QFileSystemWatcherPrivate::_q_directoryChanged(const QString &path, bool re
     }
     if (removed)
         directories.removeAll(path);
-    emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
+    if (coalescingInterval >= 0)
+        queueChange(&pendingDirectories, path);
+    else
+        emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
+}
+
+void QFileSystemWatcherPrivate::queueChange(QSet<QString> *pending, const QString &path)
+{
+    Q_Q(QFileSystemWatcher);
+    pending->insert(path);
+    if (!coalescingTimer) {
+        coalescingTimer = new QTimer(q);
+        coalescingTimer->setSingleShot(true);
+        QObject::connect(coalescingTimer, &QTimer::timeout,
+                         q, [this] () { deliverPendingChanges(); });
+    }
+    // the interval starts with the first change of a batch, so a steady
+    // stream of changes still gets delivered every coalescingInterval
+    if (!coalescingTimer->isActive())
+        coalescingTimer->start(coalescingInterval);
+}
+
+void QFileSystemWatcherPrivate::deliverPendingChanges()
+{
+    Q_Q(QFileSystemWatcher);
+    if (coalescingTimer)
+        coalescingTimer->stop();
+    if (pendingFiles.isEmpty() && pendingDirectories.isEmpty())
+        return;
+
+    const QStringList changedFiles = pendingFiles.toList();
+    const QStringList changedDirectories = pendingDirectories.toList();
+    pendingFiles.clear();
+    pendingDirectories.clear();
+    emit q->pathsChanged(changedFiles, changedDirectories, QFileSystemWatcher::QPrivateSignal());
 }
 
 #if defined(Q_OS_WIN) && !defined(Q_OS_WINRT)
@@ -227,6 +264,12 @@ void  QFileSystemWatcherPrivate::_q_winDriveRemoved(const QString &path)
     they have been renamed or removed from disk, and directories once
     they have been removed from disk.
 
+    When many paths change at once, for instance while a large tree is
+    checked out or rebuilt, delivering one signal per path can flood the
+    event loop. Setting a coalescingInterval() makes QFileSystemWatcher
+    collect the changes instead and report them together in a single
+    pathsChanged() signal.
+
     \list
     \li \b Notes:
     \list
@@ -441,6 +484,16 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     if (d->poller)
         p = d->poller->removePaths(p, &d->files, &d->directories);
 
+    if (!d->pendingFiles.isEmpty() || !d->pendingDirectories.isEmpty()) {
+        const QSet<QString> notRemoved = p.toSet();
+        for (const QString &path : paths) {
+            if (!notRemoved.contains(path)) {
+                d->pendingFiles.remove(path);
+                d->pendingDirectories.remove(path);
+            }
+        }
+    }
+
     return p;
 }
 
@@ -466,6 +519,18 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     \sa fileChanged()
 */
 
+/*!
+    \fn void QFileSystemWatcher::pathsChanged(const QStringList &files, const QStringList &directories)
+    \since 5.11
+
+    This signal is emitted instead of fileChanged() and directoryChanged()
+    when a coalescingInterval() is set. \a files and \a directories hold
+    every watched path that was modified, renamed or removed since the
+    previous emission, each path at most once and in no particular order.
+
+    \sa setCoalescingInterval()
+*/
+
 /*!
     \fn QStringList QFileSystemWatcher::directories() const
 
@@ -494,6 +559,46 @@ QStringList QFileSystemWatcher::files() const
     return d->files;
 }
 
+/*!
+    \property QFileSystemWatcher::coalescingInterval
+    \brief the time in milliseconds over which changes are collected
+    \since 5.11
+
+    By default this property is -1, and fileChanged() or directoryChanged()
+    is emitted for every change as soon as it is detected.
+
+    If it is 0 or more, changes are collected instead and delivered in one
+    pathsChanged() signal, at most coalescingInterval milliseconds after
+    the first change of a batch. A path that changes several times within
+    that time is reported once. An interval of 0 delivers the changes once
+    control returns to the event loop.
+
+    Changes that are pending when the interval is set back to -1 are
+    delivered immediately.
+
+    \sa pathsChanged()
+*/
+int QFileSystemWatcher::coalescingInterval() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->coalescingInterval;
+}
+
+void QFileSystemWatcher::setCoalescingInterval(int msecs)
+{
+    Q_D(QFileSystemWatcher);
+    if (msecs < -1) {
+        qWarning("QFileSystemWatcher::setCoalescingInterval: invalid interval %d", msecs);
+        return;
+    }
+
+    d->coalescingInterval = msecs;
+    if (msecs < 0)
+        d->deliverPendingChanges();
+    else if (d->coalescingTimer && d->coalescingTimer->isActive())
+        d->coalescingTimer->start(msecs);
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qfilesystemwatcher.cpp"
@@ -53,6 +53,7 @@ class Q_CORE_EXPORT QFileSystemWatcher : public QObject
 {
     Q_OBJECT
     Q_DECLARE_PRIVATE(QFileSystemWatcher)
+    Q_PROPERTY(int coalescingInterval READ coalescingInterval WRITE setCoalescingInterval)
 
 public:
     QFileSystemWatcher(QObject *parent = Q_NULLPTR);
@@ -67,9 +68,13 @@ public:
     QStringList files() const;
     QStringList directories() const;
 
+    int coalescingInterval() const;
+    void setCoalescingInterval(int msecs);
+
 Q_SIGNALS:
     void fileChanged(const QString &path, QPrivateSignal);
     void directoryChanged(const QString &path, QPrivateSignal);
+    void pathsChanged(const QStringList &files, const QStringList &directories, QPrivateSignal);
 
 private:
     Q_PRIVATE_SLOT(d_func(), void _q_fileChanged(const QString &path, bool removed))
@@ -59,9 +59,12 @@
 
 #include <QtCore/qstringlist.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qset.h>
 
 QT_BEGIN_NAMESPACE
 
+class QTimer;
+
 class QFileSystemWatcherEngine : public QObject
 {
     Q_OBJECT
@@ -104,6 +107,14 @@ public:
     QFileSystemWatcherEngine *native, *poller;
     QStringList files, directories;
 
+    // change coalescing, see QFileSystemWatcher::setCoalescingInterval()
+    void queueChange(QSet<QString> *pending, const QString &path);
+    void deliverPendingChanges();
+
+    int coalescingInterval;
+    QTimer *coalescingTimer;
+    QSet<QString> pendingFiles, pendingDirectories;
+
     // private slots
     void _q_fileChanged(const QString &path, bool removed);
     void _q_directoryChanged(const QString &path, bool removed);
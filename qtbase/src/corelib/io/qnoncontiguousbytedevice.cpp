@@ -74,6 +74,16 @@ QT_BEGIN_NAMESPACE
 
     \internal
 */
+/*!
+    \fn virtual bool QNonContiguousByteDevice::readPointerStaysValid() const
+
+    Returns \c true if the memory returned by readPointer() stays valid and
+    unchanged after advanceReadPointer() and until a later readPointer() has
+    moved on by another window (or the device is destroyed), so that it can be
+    passed to another thread without copying it first.
+
+    \internal
+*/
 /*!
     \fn virtual bool QNonContiguousByteDevice::advanceReadPointer(qint64 amount)
 
@@ -405,6 +415,127 @@ qint64 QNonContiguousByteDeviceIoDeviceImpl::pos() const
     return device->pos();
 }
 
+// Map big files piecewise, so that huge uploads fit into the address space
+// of 32-bit processes as well.
+static const qint64 fileMapWindowSize = 8 * 1024 * 1024;
+
+QNonContiguousByteDeviceFileImpl::QNonContiguousByteDeviceFileImpl(QFile *f)
+    : QNonContiguousByteDevice(),
+    file(f), window(0), previousWindow(0), windowPosition(0), windowSize(0),
+    currentPosition(0)
+{
+    initialPosition = f->pos();
+    fileSize = f->size() - initialPosition;
+}
+
+QNonContiguousByteDeviceFileImpl::~QNonContiguousByteDeviceFileImpl()
+{
+    unmap(previousWindow);
+    unmap(window);
+}
+
+void QNonContiguousByteDeviceFileImpl::unmap(uchar *&address)
+{
+    // the file may be gone already, its maps went away with it
+    if (address && file)
+        file->unmap(address);
+    address = 0;
+}
+
+/*!
+    Maps the part of the file starting at \a position (relative to where the
+    upload starts) and keeps the previous part mapped, as the data returned
+    by readPointer() is required to stay valid for a while after it has been
+    consumed. Returns \c false if the file cannot be mapped.
+
+    \internal
+*/
+bool QNonContiguousByteDeviceFileImpl::mapWindow(qint64 position)
+{
+    const qint64 length = qMin(fileMapWindowSize, fileSize - position);
+    if (length <= 0)
+        return false;
+
+    uchar *address = file->map(initialPosition + position, length);
+    if (!address)
+        return false;
+
+    unmap(previousWindow);
+    previousWindow = window;
+    window = address;
+    windowPosition = position;
+    windowSize = length;
+    return true;
+}
+
+const char* QNonContiguousByteDeviceFileImpl::readPointer(qint64 maximumLength, qint64 &len)
+{
+    if (atEnd()) {
+        len = -1;
+        return 0;
+    }
+
+    if (!window || currentPosition < windowPosition
+        || currentPosition >= windowPosition + windowSize) {
+        if (!mapWindow(currentPosition)) {
+            len = -1;
+            return 0;
+        }
+    }
+
+    const qint64 offset = currentPosition - windowPosition;
+    len = windowSize - offset;
+    if (maximumLength != -1)
+        len = qMin(len, maximumLength);
+
+    return reinterpret_cast<const char *>(window) + offset;
+}
+
+bool QNonContiguousByteDeviceFileImpl::advanceReadPointer(qint64 amount)
+{
+    currentPosition += amount;
+    emit readProgress(currentPosition, size());
+    return currentPosition <= fileSize;
+}
+
+bool QNonContiguousByteDeviceFileImpl::atEnd() const
+{
+    return currentPosition >= fileSize;
+}
+
+bool QNonContiguousByteDeviceFileImpl::reset()
+{
+    currentPosition = 0;
+    return true;
+}
+
+qint64 QNonContiguousByteDeviceFileImpl::size() const
+{
+    return fileSize;
+}
+
+qint64 QNonContiguousByteDeviceFileImpl::pos() const
+{
+    // the file's own position is never touched
+    return initialPosition + currentPosition;
+}
+
+// Uploading from a QFile that can be mapped avoids copying it into
+// our read buffer first; returns 0 if that's not possible.
+static QNonContiguousByteDeviceFileImpl *createFileImpl(QIODevice *device)
+{
+    QFile *file = qobject_cast<QFile *>(device);
+    if (!file || !file->isReadable() || file->isTextModeEnabled() || file->isSequential())
+        return 0;
+
+    QNonContiguousByteDeviceFileImpl *impl = new QNonContiguousByteDeviceFileImpl(file);
+    if (!impl->mapWindow(0)) {
+        delete impl;
+        return 0;
+    }
+    return impl;
+}
+
 QByteDeviceWrappingIoDevice::QByteDeviceWrappingIoDevice(QNonContiguousByteDevice *bd) : QIODevice((QObject*)0)
 {
     byteDevice = bd;
@@ -489,8 +620,9 @@ QNonContiguousByteDevice* QNonContiguousByteDeviceFactory::create(QIODevice *dev
         return new QNonContiguousByteDeviceBufferImpl(buffer);
     }
 
-    // ### FIXME special case if device is a QFile that supports map()
-    // then we can actually deal with the file without using read/peek
+    // a QFile that supports map() is read without using read/peek
+    if (QNonContiguousByteDeviceFileImpl *fileImpl = createFileImpl(device))
+        return fileImpl;
 
     // generic QIODevice
     return new QNonContiguousByteDeviceIoDeviceImpl(device); // FIXME
@@ -508,8 +640,9 @@ QSharedPointer<QNonContiguousByteDevice> QNonContiguousByteDeviceFactory::create
     if (QBuffer *buffer = qobject_cast<QBuffer*>(device))
         return QSharedPointer<QNonContiguousByteDeviceBufferImpl>::create(buffer);
 
-    // ### FIXME special case if device is a QFile that supports map()
-    // then we can actually deal with the file without using read/peek
+    // a QFile that supports map() is read without using read/peek
+    if (QNonContiguousByteDeviceFileImpl *fileImpl = createFileImpl(device))
+        return QSharedPointer<QNonContiguousByteDevice>(fileImpl);
 
     // generic QIODevice
     return QSharedPointer<QNonContiguousByteDeviceIoDeviceImpl>::create(device); // FIXME
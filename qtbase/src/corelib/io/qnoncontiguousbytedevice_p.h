@@ -55,6 +55,8 @@
 #include <QtCore/qbytearray.h>
 #include <QtCore/qbuffer.h>
 #include <QtCore/qiodevice.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qpointer.h>
 #include <QtCore/QSharedPointer>
 #include "private/qringbuffer_p.h"
 
@@ -70,6 +72,7 @@ public:
     virtual qint64 pos() const { return -1; }
     virtual bool reset() = 0;
     virtual qint64 size() const = 0;
+    virtual bool readPointerStaysValid() const { return false; }
 
     virtual ~QNonContiguousByteDevice();
 
@@ -156,6 +159,34 @@ protected:
     qint64 initialPosition;
 };
 
+class QNonContiguousByteDeviceFileImpl : public QNonContiguousByteDevice
+{
+    Q_OBJECT
+public:
+    QNonContiguousByteDeviceFileImpl(QFile *f);
+    ~QNonContiguousByteDeviceFileImpl();
+    const char* readPointer(qint64 maximumLength, qint64 &len) Q_DECL_OVERRIDE;
+    bool advanceReadPointer(qint64 amount) Q_DECL_OVERRIDE;
+    bool atEnd() const Q_DECL_OVERRIDE;
+    bool reset() Q_DECL_OVERRIDE;
+    qint64 size() const Q_DECL_OVERRIDE;
+    qint64 pos() const Q_DECL_OVERRIDE;
+    bool readPointerStaysValid() const Q_DECL_OVERRIDE { return true; }
+
+    bool mapWindow(qint64 position);
+protected:
+    void unmap(uchar *&address);
+
+    QPointer<QFile> file;
+    uchar *window;
+    uchar *previousWindow;
+    qint64 windowPosition;
+    qint64 windowSize;
+    qint64 currentPosition;
+    qint64 initialPosition;
+    qint64 fileSize;
+};
+
 class QNonContiguousByteDeviceBufferImpl : public QNonContiguousByteDevice
 {
     Q_OBJECT
@@ -351,6 +351,8 @@ public:
     void startProcess();
 #if defined(Q_OS_UNIX)
     void execChild(const char *workingDirectory, char **argv, char **envp);
+    bool canSpawnChild(const char *workingDirectory) const;
+    int spawnChild(const char *workingDirectory, char **argv, char **envp, pid_t *childPid);
 #endif
     bool processStarted(QString *errorMessage = Q_NULLPTR);
     void terminateProcess();
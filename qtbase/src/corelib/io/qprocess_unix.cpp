@@ -118,6 +118,17 @@ QT_END_NAMESPACE
 #include <forkfd.h>
 #endif
 
+// glibc implements posix_spawn() with clone(CLONE_VM | CLONE_VFORK) since
+// 2.24, which does not copy the page tables of the parent like fork() does
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID) && _POSIX_SPAWN > 0 && QT_CONFIG(process)
+#  define QPROCESS_USE_SPAWN
+#  include <spawn.h>
+#  include <typeinfo>
+#  if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#    define QPROCESS_SPAWN_HAS_CHDIR
+#  endif
+#endif
+
 QT_BEGIN_NAMESPACE
 
 #if !defined(Q_OS_DARWIN)
@@ -360,6 +371,12 @@ static char **_q_dupEnvironment(const QProcessEnvironmentPrivate::Map &environme
     return envp;
 }
 
+struct ChildError
+{
+    int code;
+    char function[8];
+};
+
 void QProcessPrivate::startProcess()
 {
     Q_Q(QProcess);
@@ -452,9 +469,17 @@ void QProcessPrivate::startProcess()
         workingDirPtr = encodedWorkingDirectory.constData();
     }
 
-    // Start the process manager, and fork off the child process.
+    // Start the process manager, and fork off the child process. If nothing
+    // needs to run in the child before exec, spawn it directly instead.
     pid_t childPid;
-    forkfd = ::forkfd(FFD_CLOEXEC, &childPid);
+#ifdef QPROCESS_USE_SPAWN
+    const bool hasEnvironment = envp != 0;
+    const bool spawned = canSpawnChild(workingDirPtr);
+    if (spawned)
+        forkfd = spawnChild(workingDirPtr, argv, envp, &childPid);
+    else
+#endif
+        forkfd = ::forkfd(FFD_CLOEXEC, &childPid);
     int lastForkErrno = errno;
     if (forkfd != FFD_CHILD_PROCESS) {
         // Parent process.
@@ -467,6 +492,17 @@ void QProcessPrivate::startProcess()
         delete [] envp;
     }
 
+#ifdef QPROCESS_USE_SPAWN
+    if (spawned && forkfd == -1) {
+        // posix_spawn() also fails if the program could not be executed.
+        // Pass that on the way execChild() does, so that processStarted()
+        // reports it like any other failure to start.
+        ChildError error = { lastForkErrno, {} };
+        strcpy(error.function, hasEnvironment ? "execve" : "execvp");
+        qt_safe_write(childStartedPipe[1], &error, sizeof(error));
+        childPid = 0;
+    } else
+#endif
     // On QNX, if spawnChild failed, childPid will be -1 but forkfd is still 0.
     // This is intentional because we only want to handle failure to fork()
     // here, which is a rare occurrence. Handling of the failure to start is
@@ -519,19 +555,13 @@ void QProcessPrivate::startProcess()
     if (stderrChannel.pipe[0] != -1)
         ::fcntl(stderrChannel.pipe[0], F_SETFL, ::fcntl(stderrChannel.pipe[0], F_GETFL) | O_NONBLOCK);
 
-    if (threadData->eventDispatcher) {
+    if (threadData->eventDispatcher && forkfd != -1) {
         deathNotifier = new QSocketNotifier(forkfd, QSocketNotifier::Read, q);
         QObject::connect(deathNotifier, SIGNAL(activated(int)),
                          q, SLOT(_q_processDied()));
     }
 }
 
-struct ChildError
-{
-    int code;
-    char function[8];
-};
-
 void QProcessPrivate::execChild(const char *workingDir, char **argv, char **envp)
 {
     ::signal(SIGPIPE, SIG_DFL);         // reset the signal that we ignored
@@ -590,6 +620,110 @@ report_errno:
     childStartedPipe[1] = -1;
 }
 
+/*!
+    \internal
+
+    Returns \c true if the child can be started with posix_spawn() instead
+    of fork() and execChild(). That is only possible when nothing has to run
+    in the child between the two: setupChildProcess() must not have been
+    reimplemented, which is certain only for objects of type QProcess
+    itself.
+*/
+bool QProcessPrivate::canSpawnChild(const char *workingDir) const
+{
+#if defined(QPROCESS_USE_SPAWN) && (defined(__cpp_rtti) || defined(__GXX_RTTI))
+    Q_Q(const QProcess);
+    if (typeid(*q) != typeid(QProcess))
+        return false;
+#  ifndef QPROCESS_SPAWN_HAS_CHDIR
+    if (workingDir)
+        return false;
+#  endif
+    return true;
+#else
+    Q_UNUSED(workingDir);
+    return false;
+#endif
+}
+
+/*!
+    \internal
+
+    Starts the child with posix_spawn(), applying the same redirections and
+    signal setup as execChild(). Returns the forkfd of the child, or -1 with
+    errno set if it could not be started.
+*/
+int QProcessPrivate::spawnChild(const char *workingDir, char **argv, char **envp, pid_t *childPid)
+{
+#ifdef QPROCESS_USE_SPAWN
+    posix_spawn_file_actions_t fileActions;
+    posix_spawnattr_t attributes;
+    int ret = posix_spawn_file_actions_init(&fileActions);
+    if (ret != 0) {
+        errno = ret;
+        return -1;
+    }
+    ret = posix_spawnattr_init(&attributes);
+    if (ret != 0) {
+        posix_spawn_file_actions_destroy(&fileActions);
+        errno = ret;
+        return -1;
+    }
+
+    // copy the stdin socket if asked to (without closing on exec)
+    if (inputChannelMode != QProcess::ForwardedInputChannel)
+        ret = posix_spawn_file_actions_adddup2(&fileActions, stdinChannel.pipe[0], STDIN_FILENO);
+
+    // copy the stdout and stderr if asked to
+    if (ret == 0 && processChannelMode != QProcess::ForwardedChannels) {
+        if (processChannelMode != QProcess::ForwardedOutputChannel)
+            ret = posix_spawn_file_actions_adddup2(&fileActions, stdoutChannel.pipe[1], STDOUT_FILENO);
+
+        // merge stdout and stderr if asked to
+        if (ret == 0 && processChannelMode == QProcess::MergedChannels)
+            ret = posix_spawn_file_actions_adddup2(&fileActions, STDOUT_FILENO, STDERR_FILENO);
+        else if (ret == 0 && processChannelMode != QProcess::ForwardedErrorChannel)
+            ret = posix_spawn_file_actions_adddup2(&fileActions, stderrChannel.pipe[1], STDERR_FILENO);
+    }
+
+#ifdef QPROCESS_SPAWN_HAS_CHDIR
+    if (ret == 0 && workingDir)
+        ret = posix_spawn_file_actions_addchdir_np(&fileActions, workingDir);
+#else
+    Q_UNUSED(workingDir);
+#endif
+
+    // reset the signal that we ignored
+    if (ret == 0) {
+        sigset_t defaultSignals;
+        sigemptyset(&defaultSignals);
+        sigaddset(&defaultSignals, SIGPIPE);
+        ret = posix_spawnattr_setsigdefault(&attributes, &defaultSignals);
+        if (ret == 0)
+            ret = posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGDEF);
+    }
+
+    int ffd = -1;
+    if (ret == 0) {
+        ffd = ::spawnfd(FFD_CLOEXEC, childPid, argv[0], &fileActions, &attributes,
+                        argv, envp ? envp : environ);
+        ret = ffd == -1 ? errno : 0;
+    }
+
+    posix_spawnattr_destroy(&attributes);
+    posix_spawn_file_actions_destroy(&fileActions);
+    errno = ret;
+    return ffd;
+#else
+    Q_UNUSED(workingDir);
+    Q_UNUSED(argv);
+    Q_UNUSED(envp);
+    Q_UNUSED(childPid);
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
 bool QProcessPrivate::processStarted(QString *errorMessage)
 {
     ChildError buf;
@@ -631,6 +765,17 @@ qint64 QProcessPrivate::readFromChannel(const Channel *channel, char *data, qint
 {
     Q_ASSERT(channel->pipe[0] != INVALID_Q_PIPE);
     qint64 bytesRead = qt_safe_read(channel->pipe[0], data, maxlen);
+#if defined(F_GETPIPE_SZ) && defined(F_SETPIPE_SZ)
+    // A read of at least the default pipe capacity probably means the child
+    // filled the pipe and had to wait for us. Give a child that writes that
+    // much a bigger pipe, so that both sides wake up less often.
+    enum { DefaultPipeSize = 64 * 1024, MaximumPipeSize = 1024 * 1024 };
+    if (bytesRead >= DefaultPipeSize) {
+        const int pipeSize = ::fcntl(channel->pipe[0], F_GETPIPE_SZ);
+        if (pipeSize > 0 && bytesRead >= pipeSize && pipeSize < MaximumPipeSize)
+            ::fcntl(channel->pipe[0], F_SETPIPE_SZ, pipeSize * 2);
+    }
+#endif
 #if defined QPROCESS_DEBUG
     int save_errno = errno;
     qDebug("QProcessPrivate::readFromChannel(%d, %p \"%s\", %lld) == %lld",
@@ -101,15 +101,20 @@ class QResourceRoot
         Directory = 0x02
     };
     const uchar *tree, *names, *payloads;
+    const uchar *parents, *pathIndex; // version 3 and later
     int version;
+    int nodeCount;
     inline int findOffset(int node) const { return node * (14 + (version >= 0x02 ? 8 : 0)); } //sizeof each tree element
     uint hash(int node) const;
     QString name(int node) const;
+    bool nameEquals(int node, QStringView str) const;
     short flags(int node) const;
+    int findNodeInIndex(QStringView path, const QLocale &locale) const;
+    bool pathMatches(int node, QStringView path) const;
 public:
     mutable QAtomicInt ref;
 
-    inline QResourceRoot(): tree(0), names(0), payloads(0), version(0) {}
+    inline QResourceRoot(): tree(0), names(0), payloads(0), parents(0), pathIndex(0), version(0), nodeCount(0) {}
     inline QResourceRoot(int version, const uchar *t, const uchar *n, const uchar *d) { setSource(version, t, n, d); }
     virtual ~QResourceRoot() { }
     int findNode(const QString &path, const QLocale &locale=QLocale()) const;
@@ -133,6 +138,18 @@ protected:
         names = n;
         payloads = d;
         version = v;
+        parents = 0;
+        pathIndex = 0;
+        nodeCount = 0;
+        if (version >= 0x03) {
+            // the name offset of the root node holds the number of nodes,
+            // the parent table and the path index follow the last node
+            nodeCount = qFromBigEndian<qint32>(tree);
+            if (nodeCount > 0) {
+                parents = tree + findOffset(nodeCount);
+                pathIndex = parents + nodeCount * 4;
+            }
+        }
     }
 };
 
@@ -643,6 +660,102 @@ inline QString QResourceRoot::name(int node) const
     return ret;
 }
 
+inline bool QResourceRoot::nameEquals(int node, QStringView str) const
+{
+    if (!node) // root
+        return str.isEmpty();
+    const int offset = findOffset(node);
+
+    qint32 name_offset = qFromBigEndian<qint32>(tree + offset);
+    const qint16 name_length = qFromBigEndian<qint16>(names + name_offset);
+    if (name_length != str.size())
+        return false;
+    name_offset += 2;
+    name_offset += 4; //jump past hash
+
+    const uchar *p = names + name_offset;
+    for (int i = 0; i < name_length; ++i, p += 2) {
+        if (qFromBigEndian<quint16>(p) != str.at(i).unicode())
+            return false;
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Returns \c true if \a node is reached from the root by following the
+    segments of \a path, which has no leading slash. The path is walked
+    backwards using the parent table, comparing one name per level.
+*/
+bool QResourceRoot::pathMatches(int node, QStringView path) const
+{
+    const QChar *segments = path.data();
+    int end = int(path.size());
+    forever {
+        int start = end;
+        while (start > 0 && segments[start - 1] != QLatin1Char('/'))
+            --start;
+        if (!nameEquals(node, QStringView(segments + start, end - start)))
+            return false;
+
+        node = qFromBigEndian<qint32>(parents + node * 4);
+        if (start == 0)
+            return node == 0;
+        if (node == 0)
+            return false;
+        end = start - 1;
+    }
+}
+
+/*!
+    \internal
+
+    Looks \a path up in the index of full path hashes that rcc writes from
+    format version 3 on. This replaces one binary search and name
+    comparison per path segment with a single binary search.
+*/
+int QResourceRoot::findNodeInIndex(QStringView path, const QLocale &locale) const
+{
+    const uint h = qt_hash(path);
+    const int count = nodeCount - 1; // every node but the root
+
+    // find the first entry with this hash
+    int l = 0, r = count;
+    while (l < r) {
+        const int m = (l + r) / 2;
+        if (qFromBigEndian<quint32>(pathIndex + m * 8) < h)
+            l = m + 1;
+        else
+            r = m;
+    }
+
+    int node = -1;
+    for (int i = l; i < count && qFromBigEndian<quint32>(pathIndex + i * 8) == h; ++i) {
+        const int candidate = qFromBigEndian<qint32>(pathIndex + i * 8 + 4);
+        if (!pathMatches(candidate, path))
+            continue;
+
+        int offset = findOffset(candidate) + 4; //jump past name
+        const qint16 flags = qFromBigEndian<qint16>(tree + offset);
+        offset += 2;
+        if (flags & Directory)
+            return candidate;
+
+        // same locale matching as the tree walk in findNode()
+        const qint16 country = qFromBigEndian<qint16>(tree + offset);
+        offset += 2;
+        const qint16 language = qFromBigEndian<qint16>(tree + offset);
+        if (country == locale.country() && language == locale.language())
+            return candidate;
+        if ((country == QLocale::AnyCountry && language == locale.language()) ||
+            (country == QLocale::AnyCountry && language == QLocale::C && node == -1)) {
+            node = candidate;
+        }
+    }
+    return node;
+}
+
 int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
 {
     QString path = _path;
@@ -668,6 +781,12 @@ int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
     if(path == QLatin1String("/"))
         return 0;
 
+    // the index knows clean paths only, anything else takes the tree walk
+    if (pathIndex && path.startsWith(QLatin1Char('/')) && !path.endsWith(QLatin1Char('/'))
+            && !path.contains(QLatin1String("//"))) {
+        return findNodeInIndex(QStringView(path.constData() + 1, path.size() - 1), locale);
+    }
+
     //the root node is always first
     qint32 child_count = qFromBigEndian<qint32>(tree + 6);
     qint32 child       = qFromBigEndian<qint32>(tree + 10);
@@ -708,7 +827,7 @@ int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
             while(sub_node > child && hash(sub_node-1) == h) //backup for collisions
                 --sub_node;
             for(; sub_node < child+child_count && hash(sub_node) == h; ++sub_node) { //here we go...
-                if(name(sub_node) == segment) {
+                if(nameEquals(sub_node, segment)) {
                     found = true;
                     int offset = findOffset(sub_node);
 #ifdef DEBUG_RESOURCE_MATCH
@@ -858,7 +977,7 @@ Q_CORE_EXPORT bool qRegisterResourceData(int version, const unsigned char *tree,
                                          const unsigned char *name, const unsigned char *data)
 {
     QMutexLocker lock(resourceMutex());
-    if ((version == 0x01 || version == 0x2) && resourceList()) {
+    if (version >= 0x01 && version <= 0x03 && resourceList()) {
         bool found = false;
         QResourceRoot res(version, tree, name, data);
         for(int i = 0; i < resourceList()->size(); ++i) {
@@ -884,7 +1003,7 @@ Q_CORE_EXPORT bool qUnregisterResourceData(int version, const unsigned char *tre
         return false;
 
     QMutexLocker lock(resourceMutex());
-    if ((version == 0x01 || version == 0x02) && resourceList()) {
+    if (version >= 0x01 && version <= 0x03 && resourceList()) {
         QResourceRoot res(version, tree, name, data);
         for(int i = 0; i < resourceList()->size(); ) {
             if(*resourceList()->at(i) == res) {
@@ -947,7 +1066,7 @@ public:
         if (size >= 0 && (tree_offset >= size || data_offset >= size || name_offset >= size))
             return false;
 
-        if (version == 0x01 || version == 0x02) {
+        if (version >= 0x01 && version <= 0x03) {
             buffer = b;
             setSource(version, b+tree_offset, b+name_offset, b+data_offset);
             return true;
@@ -1391,6 +1391,28 @@ bool QConfFileSettingsPrivate::isWritable() const
     return confFiles.at(0)->isWritable();
 }
 
+/*
+    Returns \c true if writing \a map2 would produce the same file as
+    writing \a map1. QVariant::operator==() converts between types, so
+    compare the types and the original key case explicitly.
+*/
+static bool settingsMapsIdentical(const ParsedSettingsMap &map1, const ParsedSettingsMap &map2)
+{
+    if (map1.size() != map2.size())
+        return false;
+
+    ParsedSettingsMap::const_iterator i = map1.constBegin();
+    ParsedSettingsMap::const_iterator j = map2.constBegin();
+    for (; i != map1.constEnd(); ++i, ++j) {
+        if (i.key() != j.key()
+                || i.key().originalCaseKey() != j.key().originalCaseKey()
+                || i.value().userType() != j.value().userType()
+                || i.value() != j.value())
+            return false;
+    }
+    return true;
+}
+
 void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 {
     bool readOnly = confFile->addedKeys.isEmpty() && confFile->removedKeys.isEmpty();
@@ -1439,6 +1461,7 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 
     if (mustReadFile) {
         confFile->unparsedIniSections.clear();
+        confFile->unparsedIniData.clear();
         confFile->originalKeys.clear();
 
         QFile file(confFile->name);
@@ -1460,8 +1483,15 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
             } else
 #endif
             if (format <= QSettings::IniFormat) {
-                QByteArray data = file.readAll();
-                ok = readIniFile(data, &confFile->unparsedIniSections);
+                /*
+                    The unparsed sections refer to the file contents rather
+                    than copying them, so keep the data alive until the last
+                    section has been parsed.
+                */
+                confFile->unparsedIniData = file.readAll();
+                ok = readIniFile(confFile->unparsedIniData, &confFile->unparsedIniSections);
+                if (confFile->unparsedIniSections.isEmpty())
+                    confFile->unparsedIniData.clear();
             } else if (readFunc) {
                 QSettings::SettingsMap tempNewKeys;
                 ok = readFunc(file, tempNewKeys);
@@ -1493,6 +1523,17 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
         ensureAllSectionsParsed(confFile);
         ParsedSettingsMap mergedKeys = confFile->mergedKeyMap();
 
+        /*
+            If the changes turned out not to change anything (for example,
+            a value was set to what it already was), there is no need to
+            rewrite the whole file.
+        */
+        if (!createFile && settingsMapsIdentical(mergedKeys, confFile->originalKeys)) {
+            confFile->addedKeys.clear();
+            confFile->removedKeys.clear();
+            return;
+        }
+
 #if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(temporaryfile)
         QSaveFile sf(confFile->name);
         sf.setDirectWriteFallback(!atomicSyncOnly);
@@ -1529,6 +1570,7 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 
         if (ok) {
             confFile->unparsedIniSections.clear();
+            confFile->unparsedIniData.clear();
             confFile->originalKeys = mergedKeys;
             confFile->addedKeys.clear();
             confFile->removedKeys.clear();
@@ -1652,9 +1694,14 @@ bool QConfFileSettingsPrivate::readIniFile(const QByteArray &data,
         QByteArray &sectionData = (*unparsedIniSections)[QSettingsKey(currentSection, \
                                                                       IniCaseSensitivity, \
                                                                       sectionPosition)]; \
-        if (!sectionData.isEmpty()) \
+        if (sectionData.isEmpty()) { \
+            sectionData = QByteArray::fromRawData(data.constData() + currentSectionStart, \
+                                                  lineStart - currentSectionStart); \
+        } else { \
             sectionData.append('\n'); \
-        sectionData += data.mid(currentSectionStart, lineStart - currentSectionStart); \
+            sectionData.append(data.constData() + currentSectionStart, \
+                               lineStart - currentSectionStart); \
+        } \
         sectionPosition = ++position; \
     }
 
@@ -1909,6 +1956,7 @@ void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) cons
             setStatus(QSettings::FormatError);
     }
     confFile->unparsedIniSections.clear();
+    confFile->unparsedIniData.clear();
 }
 
 void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
@@ -1936,6 +1984,8 @@ void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
     if (!QConfFileSettingsPrivate::readIniSection(i.key(), i.value(), &confFile->originalKeys, iniCodec))
         setStatus(QSettings::FormatError);
     confFile->unparsedIniSections.erase(i);
+    if (confFile->unparsedIniSections.isEmpty())
+        confFile->unparsedIniData.clear();
 }
 
 /*!
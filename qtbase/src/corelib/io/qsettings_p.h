@@ -163,6 +163,7 @@ public:
     QDateTime timeStamp;
     qint64 size;
     UnparsedSettingsMap unparsedIniSections;
+    QByteArray unparsedIniData;
     ParsedSettingsMap originalKeys;
     ParsedSettingsMap addedKeys;
     ParsedSettingsMap removedKeys;
@@ -241,6 +241,7 @@ static const int QTEXTSTREAM_BUFFERSIZE = 16384;
 #if defined QTEXTSTREAM_DEBUG
 #include <ctype.h>
 #include "private/qtools_p.h"
+#include "private/qsimd_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -638,6 +639,36 @@ QString QTextStreamPrivate::read(int maxlen)
     return ret;
 }
 
+/*
+    Returns a pointer to the first '\n' in [\a ptr, \a end), or \a end if
+    there is none.
+*/
+static inline const QChar *findLineFeed(const QChar *ptr, const QChar *end)
+{
+#if defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)
+    // do eight characters at a time
+    const __m128i lineFeed = _mm_set1_epi16('\n');
+    for ( ; end - ptr >= 8; ptr += 8) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        uint mask = _mm_movemask_epi8(_mm_cmpeq_epi16(data, lineFeed));
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask) / 2;
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vmaxvq is only available on Aarch64
+    const uint16x8_t lineFeed = vdupq_n_u16('\n');
+    for ( ; end - ptr >= 8; ptr += 8) {
+        uint16x8_t data = vld1q_u16(reinterpret_cast<const uint16_t *>(ptr));
+        if (vmaxvq_u16(vceqq_u16(data, lineFeed)))
+            break; // the tail loop finds the exact position
+    }
+#endif
+    for ( ; ptr != end; ++ptr) {
+        if (*ptr == QLatin1Char('\n'))
+            return ptr;
+    }
+    return end;
+}
+
 /*!
     \internal
 
@@ -667,6 +698,30 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
         }
         chPtr += startOffset;
 
+        if (delimiter == EndOfLine) {
+            // lines are usually long compared to the delimiter, so look
+            // for the line feed in bulk instead of character by character
+            const QChar *endPtr = chPtr + (endOffset - startOffset);
+            if (maxlen && maxlen - totalSize < endPtr - chPtr)
+                endPtr = chPtr + (maxlen - totalSize);
+
+            const QChar *lineFeed = findLineFeed(chPtr, endPtr);
+            const QChar *stopPtr = endPtr;
+            if (lineFeed != endPtr) {
+                foundToken = true;
+                delimSize = ((lineFeed != chPtr ? lineFeed[-1] : lastChar) == QLatin1Char('\r')) ? 2 : 1;
+                consumeDelimiter = true;
+                stopPtr = lineFeed + 1;
+            }
+            if (stopPtr != chPtr)
+                lastChar = stopPtr[-1];
+
+            const int scanned = int(stopPtr - chPtr);
+            totalSize += scanned;
+            startOffset += scanned;
+            continue;
+        }
+
         for (; !foundToken && startOffset < endOffset && (!maxlen || totalSize < maxlen); ++startOffset) {
             const QChar ch = *chPtr++;
             ++totalSize;
@@ -685,12 +740,7 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
                 }
                 break;
             case EndOfLine:
-                if (ch == QLatin1Char('\n')) {
-                    foundToken = true;
-                    delimSize = (lastChar == QLatin1Char('\r')) ? 2 : 1;
-                    consumeDelimiter = true;
-                }
-                lastChar = ch;
+                Q_UNREACHABLE();
                 break;
             }
         }
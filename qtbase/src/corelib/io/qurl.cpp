@@ -457,6 +457,16 @@ static inline QString ftpScheme()
     return QStringLiteral("ftp");
 }
 
+static inline QString httpScheme()
+{
+    return QStringLiteral("http");
+}
+
+static inline QString httpsScheme()
+{
+    return QStringLiteral("https");
+}
+
 static inline QString fileScheme()
 {
     return QStringLiteral("file");
@@ -1034,7 +1044,16 @@ inline bool QUrlPrivate::setScheme(const QString &value, int len, bool doSetErro
         return false;
     }
 
-    scheme = value.left(len);
+    // share the common schemes instead of allocating a copy for each URL
+    const QStringRef schemeRef = value.leftRef(len);
+    if (needsLowercasing == -1 && schemeRef == httpScheme())
+        scheme = httpScheme();
+    else if (needsLowercasing == -1 && schemeRef == httpsScheme())
+        scheme = httpsScheme();
+    else if (needsLowercasing == -1 && schemeRef == fileScheme())
+        scheme = fileScheme();
+    else
+        scheme = value.left(len);
 
     if (needsLowercasing != -1) {
         // schemes are ASCII only, so we don't need the full Unicode toLower
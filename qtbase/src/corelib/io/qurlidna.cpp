@@ -2495,7 +2495,10 @@ QString qt_ACE_do(const QString &domain, AceOperation op, AceLeadingDot dot)
     QString result;
     result.reserve(domain.length());
 
-    const bool isIdnEnabled = op == NormalizeAce ? qt_is_idn_enabled(domain) : false;
+    // whether the TLD allows Unicode display is only needed for labels that
+    // are not plain ASCII, so don't look it up until we find one of those
+    enum { IdnUnknown = -1, IdnDisabled, IdnEnabled };
+    int isIdnEnabled = op == NormalizeAce ? IdnUnknown : IdnDisabled;
     int lastIdx = 0;
     QString aceForm; // this variable is here for caching
 
@@ -2568,7 +2571,9 @@ QString qt_ACE_do(const QString &domain, AceOperation op, AceLeadingDot dot)
 
             // We use resize()+memcpy() here because we're overwriting the data we've copied
             bool appended = false;
-            if (isIdnEnabled) {
+            if (isIdnEnabled == IdnUnknown)
+                isIdnEnabled = qt_is_idn_enabled(domain) ? IdnEnabled : IdnDisabled;
+            if (isIdnEnabled == IdnEnabled) {
                 QString tmp = qt_punycodeDecoder(aceForm);
                 if (tmp.isEmpty())
                     return QString(); // shouldn't happen, since we've just punycode-encoded it
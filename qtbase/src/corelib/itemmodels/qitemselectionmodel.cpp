@@ -654,6 +654,14 @@ void QItemSelectionModelPrivate::initModel(QAbstractItemModel *m)
           SLOT(_q_layoutChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)) },
         { SIGNAL(modelReset()),
           SLOT(reset()) },
+        { SIGNAL(rowsInserted(QModelIndex,int,int)),
+          SLOT(_q_invalidateLookup()) },
+        { SIGNAL(rowsRemoved(QModelIndex,int,int)),
+          SLOT(_q_invalidateLookup()) },
+        { SIGNAL(columnsInserted(QModelIndex,int,int)),
+          SLOT(_q_invalidateLookup()) },
+        { SIGNAL(columnsRemoved(QModelIndex,int,int)),
+          SLOT(_q_invalidateLookup()) },
         { 0, 0 }
     };
 
@@ -778,6 +786,7 @@ void QItemSelectionModelPrivate::_q_rowsAboutToBeRemoved(const QModelIndex &pare
             ++it;
     }
     ranges.append(newParts);
+    invalidateLookup();
 
     if (!deselected.isEmpty())
         emit q->selectionChanged(QItemSelection(), deselected);
@@ -841,6 +850,7 @@ void QItemSelectionModelPrivate::_q_columnsAboutToBeInserted(const QModelIndex &
         }
     }
     ranges += split;
+    invalidateLookup();
 }
 
 /*!
@@ -870,6 +880,7 @@ void QItemSelectionModelPrivate::_q_rowsAboutToBeInserted(const QModelIndex &par
         }
     }
     ranges += split;
+    invalidateLookup();
 }
 
 /*!
@@ -881,6 +892,8 @@ void QItemSelectionModelPrivate::_q_rowsAboutToBeInserted(const QModelIndex &par
 */
 void QItemSelectionModelPrivate::_q_layoutAboutToBeChanged(const QList<QPersistentModelIndex> &, QAbstractItemModel::LayoutChangeHint hint)
 {
+    invalidateLookup();
+
     savedPersistentIndexes.clear();
     savedPersistentCurrentIndexes.clear();
     savedPersistentRowLengths.clear();
@@ -1046,6 +1059,8 @@ static bool qt_PersistentModelIndexLessThan(const QPersistentModelIndex &i1, con
 */
 void QItemSelectionModelPrivate::_q_layoutChanged(const QList<QPersistentModelIndex> &, QAbstractItemModel::LayoutChangeHint hint)
 {
+    invalidateLookup();
+
     // special case for when all indexes are selected
     if (tableSelected && tableColCount == model->columnCount(tableParent)
         && tableRowCount == model->rowCount(tableParent)) {
@@ -1101,6 +1116,89 @@ void QItemSelectionModelPrivate::_q_layoutChanged(const QList<QPersistentModelIn
     }
 }
 
+typedef QItemSelectionModelPrivate::LookupRange LookupRange;
+
+static int buildLookupTree(const LookupRange *ranges, int *maxBottom, int low, int high)
+{
+    if (low >= high)
+        return -1;
+    const int middle = low + (high - low) / 2;
+    maxBottom[middle] = qMax(ranges[middle].bottom,
+                             qMax(buildLookupTree(ranges, maxBottom, low, middle),
+                                  buildLookupTree(ranges, maxBottom, middle + 1, high)));
+    return maxBottom[middle];
+}
+
+static bool lookupTreeContains(const LookupRange *ranges, const int *maxBottom,
+                               int low, int high, int row, int column)
+{
+    while (low < high) {
+        const int middle = low + (high - low) / 2;
+        if (maxBottom[middle] < row)
+            return false; // the whole subtree ends above row
+        if (lookupTreeContains(ranges, maxBottom, low, middle, row, column))
+            return true;
+        const LookupRange &range = ranges[middle];
+        if (range.top > row)
+            return false; // this range and all to its right start below row
+        if (range.bottom >= row && range.left <= column && column <= range.right)
+            return true;
+        low = middle + 1;
+    }
+    return false;
+}
+
+/*!
+    \internal
+
+    Builds the isSelected() lookup from the valid ranges.
+*/
+void QItemSelectionModelPrivate::buildLookup() const
+{
+    lookup.clear();
+    for (const QItemSelectionRange &range : ranges) {
+        if (!range.isValid())
+            continue;
+        const LookupRange entry = { range.top(), range.bottom(), range.left(), range.right() };
+        lookup[range.parent()].ranges.append(entry);
+    }
+    for (QHash<QModelIndex, ParentLookup>::iterator it = lookup.begin(); it != lookup.end(); ++it) {
+        QVector<LookupRange> &parentRanges = it->ranges;
+        std::sort(parentRanges.begin(), parentRanges.end(),
+                  [](const LookupRange &r1, const LookupRange &r2) { return r1.top < r2.top; });
+        it->maxBottom.resize(parentRanges.size());
+        buildLookupTree(parentRanges.constData(), it->maxBottom.data(), 0, parentRanges.size());
+    }
+    lookupValid = true;
+}
+
+/*!
+    \internal
+
+    Returns \c true if \a index is inside one of the committed ranges.
+    Small selections are scanned; larger ones are looked up in logarithmic
+    time in a structure built on first use after the selection or the
+    model changed.
+*/
+bool QItemSelectionModelPrivate::rangesContain(const QModelIndex &index) const
+{
+    if (ranges.count() < 16) {
+        for (const QItemSelectionRange &range : ranges) {
+            if (range.isValid() && range.contains(index))
+                return true;
+        }
+        return false;
+    }
+
+    if (!lookupValid)
+        buildLookup();
+    const QHash<QModelIndex, ParentLookup>::const_iterator it = lookup.constFind(index.parent());
+    if (it == lookup.constEnd())
+        return false;
+    return lookupTreeContains(it->ranges.constData(), it->maxBottom.constData(),
+                              0, it->ranges.size(), index.row(), index.column());
+}
+
 /*!
     \class QItemSelectionModel
     \inmodule QtCore
@@ -1296,6 +1394,8 @@ void QItemSelectionModel::select(const QItemSelection &selection, QItemSelection
     if (command == NoUpdate)
         return;
 
+    d->invalidateLookup();
+
     // store old selection
     QItemSelection sel = selection;
     // If d->ranges is non-empty when the source model is reset the persistent indexes
@@ -1336,6 +1436,51 @@ void QItemSelectionModel::select(const QItemSelection &selection, QItemSelection
     emitSelectionChanged(newSelection, old);
 }
 
+/*!
+    \since 5.11
+
+    Selects the \a rows under \a parent using the specified \a command,
+    and emits selectionChanged() once.
+
+    Runs of consecutive rows become a single selection range spanning all
+    columns, so selecting many rows takes one select() call, with as few
+    ranges as possible. \a rows should be sorted in ascending order; an
+    unsorted list is sorted first. Rows outside the model are ignored.
+
+    \sa select(), QItemSelectionModel::SelectionFlag
+*/
+void QItemSelectionModel::selectRows(const QVector<int> &rows, const QModelIndex &parent,
+                                     QItemSelectionModel::SelectionFlags command)
+{
+    Q_D(QItemSelectionModel);
+    if (!d->model) {
+        qWarning("QItemSelectionModel: Selecting when no model has been set will result in a no-op.");
+        return;
+    }
+
+    QVector<int> sortedRows = rows;
+    if (!std::is_sorted(sortedRows.constBegin(), sortedRows.constEnd()))
+        std::sort(sortedRows.begin(), sortedRows.end());
+
+    const int rowCount = d->model->rowCount(parent);
+    const int columnCount = d->model->columnCount(parent);
+    const int count = sortedRows.size();
+    QItemSelection selection;
+    for (int i = 0; columnCount > 0 && i < count;) {
+        const int top = sortedRows.at(i++);
+        if (top < 0)
+            continue;
+        if (top >= rowCount)
+            break;
+        int bottom = top;
+        while (i < count && sortedRows.at(i) <= bottom + 1 && sortedRows.at(i) < rowCount)
+            bottom = sortedRows.at(i++);
+        selection.append(QItemSelectionRange(d->model->index(top, 0, parent),
+                                             d->model->index(bottom, columnCount - 1, parent)));
+    }
+    select(selection, command);
+}
+
 /*!
     Clears the selection model. Emits selectionChanged() and currentChanged().
 */
@@ -1436,15 +1581,8 @@ bool QItemSelectionModel::isSelected(const QModelIndex &index) const
     if (d->model != index.model() || !index.isValid())
         return false;
 
-    bool selected = false;
     //  search model ranges
-    QList<QItemSelectionRange>::const_iterator it = d->ranges.begin();
-    for (; it != d->ranges.end(); ++it) {
-        if ((*it).isValid() && (*it).contains(index)) {
-            selected = true;
-            break;
-        }
-    }
+    bool selected = d->rangesContain(index);
 
     // check  currentSelection
     if (d->currentSelection.count()) {
@@ -190,6 +190,9 @@ public:
 
     void setModel(QAbstractItemModel *model);
 
+    void selectRows(const QVector<int> &rows, const QModelIndex &parent,
+                    QItemSelectionModel::SelectionFlags command);
+
 public Q_SLOTS:
     virtual void setCurrentIndex(const QModelIndex &index, QItemSelectionModel::SelectionFlags command);
     virtual void select(const QModelIndex &index, QItemSelectionModel::SelectionFlags command);
@@ -219,6 +222,7 @@ private:
     Q_PRIVATE_SLOT(d_func(), void _q_rowsAboutToBeInserted(const QModelIndex&, int, int))
     Q_PRIVATE_SLOT(d_func(), void _q_layoutAboutToBeChanged(const QList<QPersistentModelIndex> &parents = QList<QPersistentModelIndex>(), QAbstractItemModel::LayoutChangeHint hint = QAbstractItemModel::NoHint))
     Q_PRIVATE_SLOT(d_func(), void _q_layoutChanged(const QList<QPersistentModelIndex> &parents = QList<QPersistentModelIndex>(), QAbstractItemModel::LayoutChangeHint hint = QAbstractItemModel::NoHint))
+    Q_PRIVATE_SLOT(d_func(), void _q_invalidateLookup())
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QItemSelectionModel::SelectionFlags)
@@ -62,7 +62,8 @@ public:
     QItemSelectionModelPrivate()
       : model(0),
         currentCommand(QItemSelectionModel::NoUpdate),
-        tableSelected(false), tableColCount(0), tableRowCount(0) {}
+        tableSelected(false), tableColCount(0), tableRowCount(0),
+        lookupValid(false) {}
 
     QItemSelection expandSelection(const QItemSelection &selection,
                                    QItemSelectionModel::SelectionFlags command) const;
@@ -75,9 +76,22 @@ public:
     void _q_columnsAboutToBeInserted(const QModelIndex &parent, int start, int end);
     void _q_layoutAboutToBeChanged(const QList<QPersistentModelIndex> &parents = QList<QPersistentModelIndex>(), QAbstractItemModel::LayoutChangeHint hint = QAbstractItemModel::NoLayoutChangeHint);
     void _q_layoutChanged(const QList<QPersistentModelIndex> &parents = QList<QPersistentModelIndex>(), QAbstractItemModel::LayoutChangeHint hint = QAbstractItemModel::NoLayoutChangeHint);
+    void _q_invalidateLookup() { invalidateLookup(); }
+
+    bool rangesContain(const QModelIndex &index) const;
+    void buildLookup() const;
+
+    inline void invalidateLookup()
+    {
+        if (lookupValid) {
+            lookup.clear();
+            lookupValid = false;
+        }
+    }
 
     inline void remove(QList<QItemSelectionRange> &r)
     {
+        invalidateLookup();
         QList<QItemSelectionRange>::const_iterator it = r.constBegin();
         for (; it != r.constEnd(); ++it)
             ranges.removeAll(*it);
@@ -85,6 +99,7 @@ public:
 
     inline void finalize()
     {
+        invalidateLookup();
         ranges.merge(currentSelection, currentCommand);
         if (!currentSelection.isEmpty())  // ### perhaps this should be in QList
             currentSelection.clear();
@@ -103,8 +118,24 @@ public:
     bool tableSelected;
     QPersistentModelIndex tableParent;
     int tableColCount, tableRowCount;
+
+    // isSelected() lookup for large selections, built from ranges on demand.
+    // Per parent, the ranges in model coordinates sorted by top row, with
+    // maxBottom forming an implicit interval tree over them: the entry in
+    // the middle of any subrange holds the largest bottom in that subrange.
+    struct LookupRange {
+        int top, bottom, left, right;
+    };
+    struct ParentLookup {
+        QVector<LookupRange> ranges;
+        QVector<int> maxBottom;
+    };
+    mutable QHash<QModelIndex, ParentLookup> lookup;
+    mutable bool lookupValid;
 };
 
+Q_DECLARE_TYPEINFO(QItemSelectionModelPrivate::LookupRange, Q_PRIMITIVE_TYPE);
+
 QT_END_NAMESPACE
 
 #endif // QITEMSELECTIONMODEL_P_H
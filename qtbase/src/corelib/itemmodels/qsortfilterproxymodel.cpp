@@ -49,8 +49,15 @@
 #include <qstringlist.h>
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
+#ifndef QT_NO_THREAD
+#include <qatomic.h>
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#endif
 
 #include <algorithm>
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
@@ -77,48 +84,146 @@ static inline QSet<int> qVectorToSet(const QVector<int> &vector)
 class QSortFilterProxyModelLessThan
 {
 public:
-    inline QSortFilterProxyModelLessThan(int column, const QModelIndex &parent,
-                                       const QAbstractItemModel *source,
+    inline QSortFilterProxyModelLessThan(const QModelIndex *indexes,
                                        const QSortFilterProxyModel *proxy)
-        : sort_column(column), source_parent(parent), source_model(source), proxy_model(proxy) {}
+        : indexes(indexes), proxy_model(proxy) {}
 
     inline bool operator()(int r1, int r2) const
     {
-        QModelIndex i1 = source_model->index(r1, sort_column, source_parent);
-        QModelIndex i2 = source_model->index(r2, sort_column, source_parent);
-        return proxy_model->lessThan(i1, i2);
+        return proxy_model->lessThan(indexes[r1], indexes[r2]);
     }
 
 private:
-    int sort_column;
-    QModelIndex source_parent;
-    const QAbstractItemModel *source_model;
+    const QModelIndex *indexes;
     const QSortFilterProxyModel *proxy_model;
 };
 
 class QSortFilterProxyModelGreaterThan
 {
 public:
-    inline QSortFilterProxyModelGreaterThan(int column, const QModelIndex &parent,
-                                          const QAbstractItemModel *source,
+    inline QSortFilterProxyModelGreaterThan(const QModelIndex *indexes,
                                           const QSortFilterProxyModel *proxy)
-        : sort_column(column), source_parent(parent),
-          source_model(source), proxy_model(proxy) {}
+        : indexes(indexes), proxy_model(proxy) {}
 
     inline bool operator()(int r1, int r2) const
     {
-        QModelIndex i1 = source_model->index(r1, sort_column, source_parent);
-        QModelIndex i2 = source_model->index(r2, sort_column, source_parent);
-        return proxy_model->lessThan(i2, i1);
+        return proxy_model->lessThan(indexes[r2], indexes[r1]);
     }
 
 private:
-    int sort_column;
-    QModelIndex source_parent;
-    const QAbstractItemModel *source_model;
+    const QModelIndex *indexes;
     const QSortFilterProxyModel *proxy_model;
 };
 
+// Below this many rows, handing work to other threads costs more than it saves
+static const int ParallelSortFilterThreshold = 10000;
+
+#ifndef QT_NO_THREAD
+class QSortFilterProxyModelParallelRun
+{
+public:
+    QSortFilterProxyModelParallelRun(int chunkCount, const std::function<void(int)> &function)
+        : chunkCount(chunkCount), function(function), nextChunk(0)
+    {
+    }
+
+    void work()
+    {
+        for (;;) {
+            const int chunk = nextChunk.fetchAndAddRelaxed(1);
+            if (chunk >= chunkCount)
+                return;
+            function(chunk);
+        }
+    }
+
+    QSemaphore helpersDone;
+
+private:
+    const int chunkCount;
+    const std::function<void(int)> &function;
+    QAtomicInt nextChunk;
+};
+
+class QSortFilterProxyModelParallelHelper : public QRunnable
+{
+public:
+    explicit QSortFilterProxyModelParallelHelper(QSortFilterProxyModelParallelRun *parallelRun)
+        : parallelRun(parallelRun)
+    {
+    }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        parallelRun->work();
+        parallelRun->helpersDone.release();
+    }
+
+private:
+    QSortFilterProxyModelParallelRun *const parallelRun;
+};
+#endif
+
+/*
+    Calls \a function once for each chunk in [0, \a chunkCount). When there
+    is more than one chunk, idle threads of the global thread pool work on
+    them together with the calling thread. Returns once all chunks are done.
+*/
+static void qt_sfpm_for_each_chunk(int chunkCount, const std::function<void(int)> &function)
+{
+#ifndef QT_NO_THREAD
+    if (chunkCount > 1) {
+        QSortFilterProxyModelParallelRun parallelRun(chunkCount, function);
+        QThreadPool *pool = QThreadPool::globalInstance();
+
+        // Only take threads that are idle right now: waiting for a busy pool
+        // could deadlock if the caller itself runs on one of its threads.
+        int helpers = 0;
+        while (helpers < chunkCount - 1 && helpers < pool->maxThreadCount()) {
+            QSortFilterProxyModelParallelHelper *helper = new QSortFilterProxyModelParallelHelper(&parallelRun);
+            if (!pool->tryStart(helper)) {
+                delete helper;
+                break;
+            }
+            ++helpers;
+        }
+
+        parallelRun.work();
+        parallelRun.helpersDone.acquire(helpers);
+        return;
+    }
+#endif
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+        function(chunk);
+}
+
+/*
+    Stable sort of [\a begin, \a end) in \a chunkCount pieces, which are
+    sorted and then merged pairwise through qt_sfpm_for_each_chunk().
+*/
+template <typename LessThan>
+static void qt_sfpm_stable_sort(int *begin, int *end, int chunkCount, LessThan lessThan)
+{
+    const qint64 count = end - begin;
+    QVector<int *> bounds(chunkCount + 1);
+    for (int i = 0; i <= chunkCount; ++i)
+        bounds[i] = begin + count * i / chunkCount;
+    int * const *bound = bounds.constData();
+
+    qt_sfpm_for_each_chunk(chunkCount, [&](int chunk) {
+        std::stable_sort(bound[chunk], bound[chunk + 1], lessThan);
+    });
+    for (int width = 1; width < chunkCount; width *= 2) {
+        qt_sfpm_for_each_chunk((chunkCount + 2 * width - 1) / (2 * width), [&](int merge) {
+            const int first = merge * 2 * width;
+            const int middle = qMin(first + width, chunkCount);
+            const int last = qMin(first + 2 * width, chunkCount);
+            if (middle < last)
+                std::inplace_merge(bound[first], bound[middle], bound[last], lessThan);
+        });
+    }
+}
+
 
 //this struct is used to store what are the rows that are removed
 //between a call to rowsAboutToBeRemoved and rowsRemoved
@@ -178,6 +283,7 @@ public:
     QModelIndex last_top_source;
 
     bool filter_recursive;
+    bool parallel_sortfilter;
     bool complete_insert;
     bool dynamic_sortfilter;
     QRowsRemoval itemsBeingRemoved;
@@ -257,8 +363,11 @@ public:
 
     void sort();
     bool update_source_sort_column();
+    int chunk_count(int item_count) const;
     void sort_source_rows(QVector<int> &source_rows,
                           const QModelIndex &source_parent) const;
+    QVector<int> filter_source_rows(int start, int end,
+                                    const QModelIndex &source_parent) const;
     QVector<QPair<int, QVector<int > > > proxy_intervals_for_source_items_to_add(
         const QVector<int> &proxy_to_source, const QVector<int> &source_items,
         const QModelIndex &source_parent, Qt::Orientation orient) const;
@@ -381,11 +490,7 @@ IndexMap::const_iterator QSortFilterProxyModelPrivate::create_mapping(
     Mapping *m = new Mapping;
 
     int source_rows = model->rowCount(source_parent);
-    m->source_rows.reserve(source_rows);
-    for (int i = 0; i < source_rows; ++i) {
-        if (filterAcceptsRowInternal(i, source_parent))
-            m->source_rows.append(i);
-    }
+    m->source_rows = filter_source_rows(0, source_rows - 1, source_parent);
     int source_cols = model->columnCount(source_parent);
     m->source_columns.reserve(source_cols);
     for (int i = 0; i < source_cols; ++i) {
@@ -531,18 +636,85 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
 {
     Q_Q(const QSortFilterProxyModel);
     if (source_sort_column >= 0) {
-        if (sort_order == Qt::AscendingOrder) {
-            QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q);
-            std::stable_sort(source_rows.begin(), source_rows.end(), lt);
-        } else {
-            QSortFilterProxyModelGreaterThan gt(source_sort_column, source_parent, model, q);
-            std::stable_sort(source_rows.begin(), source_rows.end(), gt);
-        }
+        if (source_rows.size() < 2)
+            return;
+        const int chunks = chunk_count(source_rows.size());
+        int *begin = source_rows.data();
+        int *end = begin + source_rows.size();
+
+        // Look up the index of each row once, rather than twice per comparison
+        QVector<QModelIndex> indexes(*std::max_element(begin, end) + 1);
+        QModelIndex *index = indexes.data();
+        qt_sfpm_for_each_chunk(chunks, [&](int chunk) {
+            const int *first = begin + qint64(end - begin) * chunk / chunks;
+            const int *last = begin + qint64(end - begin) * (chunk + 1) / chunks;
+            for (; first != last; ++first)
+                index[*first] = model->index(*first, source_sort_column, source_parent);
+        });
+
+        if (sort_order == Qt::AscendingOrder)
+            qt_sfpm_stable_sort(begin, end, chunks, QSortFilterProxyModelLessThan(index, q));
+        else
+            qt_sfpm_stable_sort(begin, end, chunks, QSortFilterProxyModelGreaterThan(index, q));
     } else { // restore the source model order
         std::stable_sort(source_rows.begin(), source_rows.end());
     }
 }
 
+/*!
+  \internal
+
+  Returns the number of pieces to split work on \a item_count items into.
+  This is one unless parallel sorting and filtering is enabled and there
+  are enough items to make it worthwhile.
+*/
+int QSortFilterProxyModelPrivate::chunk_count(int item_count) const
+{
+#ifndef QT_NO_THREAD
+    if (parallel_sortfilter && item_count >= ParallelSortFilterThreshold) {
+        return qMin(item_count / (ParallelSortFilterThreshold / 2),
+                    qMax(QThread::idealThreadCount(), 1) * 4);
+    }
+#else
+    Q_UNUSED(item_count);
+#endif
+    return 1;
+}
+
+/*!
+  \internal
+
+  Returns the source rows from \a start to \a end (inclusive) under
+  \a source_parent that are accepted by the filter, in ascending order.
+*/
+QVector<int> QSortFilterProxyModelPrivate::filter_source_rows(
+    int start, int end, const QModelIndex &source_parent) const
+{
+    const int count = end - start + 1;
+    const int chunks = chunk_count(count);
+    QVector<QVector<int> > accepted(chunks);
+    QVector<int> *rows = accepted.data();
+    qt_sfpm_for_each_chunk(chunks, [&](int chunk) {
+        const int first = start + int(qint64(count) * chunk / chunks);
+        const int last = start + int(qint64(count) * (chunk + 1) / chunks);
+        for (int row = first; row < last; ++row) {
+            if (filterAcceptsRowInternal(row, source_parent))
+                rows[chunk].append(row);
+        }
+    });
+    if (chunks == 1)
+        return accepted.first();
+
+    int total = 0;
+    for (const QVector<int> &chunk : qAsConst(accepted))
+        total += chunk.size();
+    QVector<int> result;
+    result.reserve(total);
+    for (const QVector<int> &chunk : qAsConst(accepted))
+        result += chunk;
+    return result;
+}
+
 /*!
   \internal
 
@@ -755,10 +927,14 @@ void QSortFilterProxyModelPrivate::insert_source_items(
                 q->beginInsertColumns(proxy_parent, proxy_start, proxy_end);
         }
 
-        for (int i = 0; i < source_items.size(); ++i)
-            proxy_to_source.insert(proxy_start + i, source_items.at(i));
+        proxy_to_source.insert(proxy_start, source_items.size(), 0);
+        std::copy(source_items.constBegin(), source_items.constEnd(),
+                  proxy_to_source.begin() + proxy_start);
 
-        build_source_to_proxy_mapping(proxy_to_source, source_to_proxy);
+        // Only the items from proxy_start on have moved
+        const int proxy_count = proxy_to_source.size();
+        for (int i = proxy_start; i < proxy_count; ++i)
+            source_to_proxy[proxy_to_source.at(i)] = i;
 
         if (emit_signal) {
             if (orient == Qt::Vertical)
@@ -835,11 +1011,12 @@ void QSortFilterProxyModelPrivate::source_items_inserted(
 
     // Figure out which items to add to mapping based on filter
     QVector<int> source_items;
-    for (int i = start; i <= end; ++i) {
-        if ((orient == Qt::Vertical)
-            ? filterAcceptsRowInternal(i, source_parent)
-            : q->filterAcceptsColumn(i, source_parent)) {
-            source_items.append(i);
+    if (orient == Qt::Vertical) {
+        source_items = filter_source_rows(start, end, source_parent);
+    } else {
+        for (int i = start; i <= end; ++i) {
+            if (q->filterAcceptsColumn(i, source_parent))
+                source_items.append(i);
         }
     }
 
@@ -1158,28 +1335,33 @@ QSet<int> QSortFilterProxyModelPrivate::handle_filter_changed(
     const QModelIndex &source_parent, Qt::Orientation orient)
 {
     Q_Q(QSortFilterProxyModel);
+    // Evaluate the filter once for every source item, mapped or not
+    const int source_count = source_to_proxy.size();
+    QVector<bool> accepted(source_count, false);
+    if (orient == Qt::Vertical) {
+        const QVector<int> accepted_rows = filter_source_rows(0, source_count - 1, source_parent);
+        for (int row : accepted_rows)
+            accepted[row] = true;
+    } else {
+        for (int column = 0; column < source_count; ++column)
+            accepted[column] = q->filterAcceptsColumn(column, source_parent);
+    }
+
     // Figure out which mapped items to remove
     QVector<int> source_items_remove;
     for (int i = 0; i < proxy_to_source.count(); ++i) {
         const int source_item = proxy_to_source.at(i);
-        if ((orient == Qt::Vertical)
-            ? !filterAcceptsRowInternal(source_item, source_parent)
-            : !q->filterAcceptsColumn(source_item, source_parent)) {
+        if (!accepted.at(source_item)) {
             // This source item does not satisfy the filter, so it must be removed
             source_items_remove.append(source_item);
         }
     }
     // Figure out which non-mapped items to insert
     QVector<int> source_items_insert;
-    int source_count = source_to_proxy.size();
     for (int source_item = 0; source_item < source_count; ++source_item) {
-        if (source_to_proxy.at(source_item) == -1) {
-            if ((orient == Qt::Vertical)
-                ? filterAcceptsRowInternal(source_item, source_parent)
-                : q->filterAcceptsColumn(source_item, source_parent)) {
-                // This source item satisfies the filter, so it must be added
-                source_items_insert.append(source_item);
-            }
+        if (source_to_proxy.at(source_item) == -1 && accepted.at(source_item)) {
+            // This source item satisfies the filter, so it must be added
+            source_items_insert.append(source_item);
         }
     }
     if (!source_items_remove.isEmpty() || !source_items_insert.isEmpty()) {
@@ -1835,6 +2017,7 @@ QSortFilterProxyModel::QSortFilterProxyModel(QObject *parent)
     d->filter_column = 0;
     d->filter_role = Qt::DisplayRole;
     d->filter_recursive = false;
+    d->parallel_sortfilter = false;
     d->dynamic_sortfilter = true;
     d->complete_insert = false;
     connect(this, SIGNAL(modelReset()), this, SLOT(_q_clearMapping()));
@@ -2682,6 +2865,40 @@ void QSortFilterProxyModel::setRecursiveFilteringEnabled(bool recursive)
     d->filter_changed();
 }
 
+/*!
+    \since 5.11
+    \property QSortFilterProxyModel::parallelSortFilterEnabled
+    \brief whether sorting and filtering of large models is spread over
+    threads of the global QThreadPool.
+
+    When enabled, filterAcceptsRow() and lessThan() are called for rows of
+    the same parent from several threads at once whenever there are enough
+    rows for this to pay off. Filtering rows and sorting them by the sort
+    column then takes several times less on multi-core machines. Each model
+    index is looked up once per sort, and the proxy is still updated with a
+    single layoutChanged() signal as before.
+
+    Only enable this if filterAcceptsRow(), lessThan() and the data(),
+    index() and rowCount() functions of the source model may safely be
+    called concurrently from several threads while the model is not
+    modified. This is not the case for arbitrary models.
+
+    The default value is false.
+
+    \sa filterAcceptsRow(), lessThan(), QThreadPool::globalInstance()
+*/
+bool QSortFilterProxyModel::isParallelSortFilterEnabled() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->parallel_sortfilter;
+}
+
+void QSortFilterProxyModel::setParallelSortFilterEnabled(bool enabled)
+{
+    Q_D(QSortFilterProxyModel);
+    d->parallel_sortfilter = enabled;
+}
+
 /*!
     \obsolete
 
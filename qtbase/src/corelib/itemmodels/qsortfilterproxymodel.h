@@ -68,6 +68,7 @@ class Q_CORE_EXPORT QSortFilterProxyModel : public QAbstractProxyModel
     Q_PROPERTY(int sortRole READ sortRole WRITE setSortRole)
     Q_PROPERTY(int filterRole READ filterRole WRITE setFilterRole)
     Q_PROPERTY(bool recursiveFilteringEnabled READ isRecursiveFilteringEnabled WRITE setRecursiveFilteringEnabled)
+    Q_PROPERTY(bool parallelSortFilterEnabled READ isParallelSortFilterEnabled WRITE setParallelSortFilterEnabled)
 
 public:
     explicit QSortFilterProxyModel(QObject *parent = Q_NULLPTR);
@@ -111,6 +112,9 @@ public:
     bool isRecursiveFilteringEnabled() const;
     void setRecursiveFilteringEnabled(bool recursive);
 
+    bool isParallelSortFilterEnabled() const;
+    void setParallelSortFilterEnabled(bool enabled);
+
 public Q_SLOTS:
     void setFilterRegExp(const QString &pattern);
     void setFilterWildcard(const QString &pattern);
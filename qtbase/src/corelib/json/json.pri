@@ -4,6 +4,7 @@ HEADERS += \
     json/qjsonobject.h \
     json/qjsonvalue.h \
     json/qjsonarray.h \
+    json/qjsonstream.h \
     json/qjsonwriter_p.h \
     json/qjsonparser_p.h
 
@@ -12,6 +13,7 @@ SOURCES += \
     json/qjsondocument.cpp \
     json/qjsonobject.cpp \
     json/qjsonarray.cpp \
+    json/qjsonstream.cpp \
     json/qjsonvalue.cpp \
     json/qjsonwriter.cpp \
     json/qjsonparser.cpp
@@ -306,12 +306,13 @@ QVariantMap QJsonObject::toVariantMap() const
  */
 QJsonObject QJsonObject::fromVariantHash(const QVariantHash &hash)
 {
-    // ### this is implemented the trivial way, not the most efficient way
-
-    QJsonObject object;
+    // inserting into a QJsonObject in hash order would shift the offset
+    // table on every insertion; sort the keys first instead, so the object
+    // can be written out in one go
+    QVariantMap map;
     for (QVariantHash::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it)
-        object.insert(it.key(), QJsonValue::fromVariant(it.value()));
-    return object;
+        map.insert(it.key(), it.value());
+    return fromVariantMap(map);
 }
 
 /*!
@@ -45,6 +45,9 @@
 #include "qjsonparser_p.h"
 #include "qjson_p.h"
 #include "private/qutfcodec_p.h"
+#include "private/qsimd_p.h"
+
+#include <algorithm>
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -358,23 +361,41 @@ error:
 
 void Parser::ParsedObject::insert(uint offset) {
     const QJsonPrivate::Entry *newEntry = reinterpret_cast<const QJsonPrivate::Entry *>(parser->data + objectPosition + offset);
-    int min = 0;
-    int n = offsets.size();
-    while (n > 0) {
-        int half = n >> 1;
-        int middle = min + half;
-        if (*entryAt(middle) >= *newEntry) {
-            n = half;
-        } else {
-            min = middle + 1;
-            n -= half + 1;
+    if (!offsets.isEmpty()) {
+        const QJsonPrivate::Entry *lastEntry = entryAt(offsets.size() - 1);
+        if (*lastEntry == *newEntry) {
+            offsets.last() = offset;
+            return;
         }
+        // keys that arrive out of order are sorted once, in finalize(),
+        // rather than by shifting the table on every insertion
+        if (*lastEntry >= *newEntry)
+            sorted = false;
     }
-    if (min < offsets.size() && *entryAt(min) == *newEntry) {
-        offsets[min] = offset;
-    } else {
-        offsets.insert(min, offset);
+    offsets.append(offset);
+}
+
+void Parser::ParsedObject::finalize()
+{
+    if (sorted)
+        return;
+
+    // stable, so that of several entries with the same key the last one wins
+    const char *base = parser->data + objectPosition;
+    std::stable_sort(offsets.begin(), offsets.end(), [base](uint lhs, uint rhs) {
+        return !(*reinterpret_cast<const QJsonPrivate::Entry *>(base + lhs)
+                 >= *reinterpret_cast<const QJsonPrivate::Entry *>(base + rhs));
+    });
+
+    int out = 0;
+    for (int i = 1; i < offsets.size(); ++i) {
+        if (*entryAt(i) == *entryAt(out))
+            offsets[out] = offsets.at(i);
+        else
+            offsets[++out] = offsets.at(i);
     }
+    offsets.resize(out + 1);
+    sorted = true;
 }
 
 /*
@@ -418,6 +439,8 @@ bool Parser::parseObject()
         return false;
     }
 
+    parsedObject.finalize();
+
     DEBUG << "numEntries" << parsedObject.offsets.size();
     int table = objectOffset;
     // finalize the object
@@ -912,6 +935,45 @@ static inline bool scanUtf8Char(const char *&json, const char *end, uint *result
     return true;
 }
 
+/*
+    Returns a pointer to the first byte in [\a json, \a end) that is a
+    quotation mark, a backslash or not ASCII, or \a end if there is none.
+    All bytes before it can be copied to a Latin-1 string verbatim.
+*/
+static inline const char *scanPlainAscii(const char *json, const char *end)
+{
+#if defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)
+    // do sixteen characters at a time
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    for ( ; end - json >= 16; json += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote), _mm_cmpeq_epi8(data, backslash));
+        // the sign bit of each byte flags the non-ASCII ones
+        const uint mask = _mm_movemask_epi8(_mm_or_si128(special, data));
+        if (mask)
+            return json + qCountTrailingZeroBits(mask);
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vmaxvq is only available on Aarch64
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t highBit = vdupq_n_u8(0x80);
+    for ( ; end - json >= 16; json += 16) {
+        const uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(json));
+        const uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(data, quote), vceqq_u8(data, backslash)),
+                                            vtstq_u8(data, highBit));
+        if (vmaxvq_u8(special))
+            break; // the tail loop finds the exact position
+    }
+#endif
+    for ( ; json < end; ++json) {
+        const uchar c = *json;
+        if (c == '"' || c == '\\' || c >= 0x80)
+            break;
+    }
+    return json;
+}
+
 bool Parser::parseString(bool *latin1)
 {
     *latin1 = true;
@@ -927,6 +989,23 @@ bool Parser::parseString(bool *latin1)
 
     BEGIN << "parse string stringPos=" << stringPos << json;
     while (json < end) {
+        // copy runs of plain ASCII in bulk
+        const char *run = json;
+        json = scanPlainAscii(json, end);
+        if (json != run) {
+            if (json - start >= 0x8000) {
+                *latin1 = false;
+                break;
+            }
+            const int runLength = json - run;
+            int pos = reserveSpace(runLength);
+            if (pos < 0)
+                return false;
+            memcpy(data + pos, run, runLength);
+            if (json >= end)
+                break;
+        }
+
         uint ch = 0;
         if (*json == '"')
             break;
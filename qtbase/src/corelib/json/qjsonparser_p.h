@@ -69,14 +69,16 @@ public:
     class ParsedObject
     {
     public:
-        ParsedObject(Parser *p, int pos) : parser(p), objectPosition(pos) {
+        ParsedObject(Parser *p, int pos) : parser(p), objectPosition(pos), sorted(true) {
             offsets.reserve(64);
         }
         void insert(uint offset);
+        void finalize();
 
         Parser *parser;
         int objectPosition;
         QVector<uint> offsets;
+        bool sorted;
 
         inline QJsonPrivate::Entry *entryAt(int i) const {
             return reinterpret_cast<QJsonPrivate::Entry *>(parser->data + objectPosition + offsets[i]);
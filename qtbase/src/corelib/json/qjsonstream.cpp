@@ -0,0 +1,1179 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qjsonstream.h"
+
+#include <qcoreapplication.h>
+#include <qiodevice.h>
+#include <qjsondocument.h>
+#include "qjsonwriter_p.h"
+
+QT_BEGIN_NAMESPACE
+
+static const int nestingLimit = 1024;
+static const int readChunkSize = 16384;
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \since 5.11
+    \ingroup json
+    \reentrant
+
+    \brief The QJsonStreamReader class provides a fast parser for reading
+    JSON text via a simple streaming API.
+
+    QJsonStreamReader is an alternative to QJsonDocument::fromJson() for
+    documents that are too large to be held in memory in their entirety,
+    or for streams of documents such as newline-delimited JSON. Like
+    QXmlStreamReader, it is a pull parser: the application calls
+    readNext() to advance to the next token and then inspects it with
+    tokenType(), name(), text() or value(). No tree is built, so the
+    memory used does not depend on the size of the input, only on the
+    nesting depth and on the size of the largest single token.
+
+    The input is UTF-8 encoded JSON text. Several top-level values may
+    follow each other, separated by whitespace; each one is reported as
+    a complete sequence of tokens.
+
+    \code
+    QJsonStreamReader reader(&file);
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartObject() && reader.depth() == 1)
+            ++records;
+    }
+    if (reader.hasError())
+        qWarning() << reader.errorString();
+    \endcode
+
+    Data can be supplied incrementally with addData(). If the reader runs
+    out of data in the middle of the input, readNext() returns Invalid and
+    error() returns PrematureEndOfDocumentError. Once more data has been
+    added, the next call to readNext() resumes from where parsing stopped.
+
+    \sa QJsonStreamWriter, QJsonDocument, QXmlStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of token the reader just read.
+
+    \value NoToken The reader has not yet read anything.
+    \value Invalid An error has occurred, reported in error() and
+    errorString().
+    \value StartArray The reader reports the start of an array. If the
+    array is a member of an object, name() returns its key.
+    \value EndArray The reader reports the end of an array.
+    \value StartObject The reader reports the start of an object. If the
+    object is a member of an object, name() returns its key.
+    \value EndObject The reader reports the end of an object.
+    \value String The reader reports a string value in text().
+    \value Double The reader reports a number in toDouble().
+    \value Bool The reader reports a boolean value in toBool().
+    \value Null The reader reports a null value.
+    \value EndDocument The reader has reached the end of the input.
+*/
+
+/*!
+    \enum QJsonStreamReader::Error
+
+    This enum specifies the different error cases.
+
+    \value NoError No error has occurred.
+    \value NotWellFormedError The input is not valid JSON. errorString()
+    describes the problem in the same terms as QJsonParseError.
+    \value PrematureEndOfDocumentError The input ended in the middle of a
+    value. If more data is added with addData() or becomes available on
+    the device, reading can continue.
+*/
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum State {
+        ExpectValue,
+        ExpectValueOrEnd,
+        ExpectKey,
+        ExpectKeyOrEnd,
+        ExpectNameSeparator,
+        ExpectSeparatorOrEnd
+    };
+
+    QJsonStreamReaderPrivate()
+        : device(0), pos(0), bufferOffset(0), dataComplete(false), deviceAtEnd(false),
+          state(ExpectValue), type(QJsonStreamReader::NoToken),
+          error(QJsonStreamReader::NoError), parseError(QJsonParseError::NoError),
+          number(0), boolean(false)
+    {}
+
+    bool fetchMore();
+    bool inputFinished() const;
+    bool ensureAvailable(int count);
+    void skipWhitespace();
+    void compact();
+
+    QJsonStreamReader::TokenType readNext();
+    QJsonStreamReader::TokenType beginValue();
+    QJsonStreamReader::TokenType endContainer(char closing);
+    QJsonStreamReader::TokenType raiseError(QJsonParseError::ParseError code);
+    QJsonStreamReader::TokenType raisePrematureEnd();
+
+    int scanString(int from);
+    bool decodeString(int from, int to, QString *out);
+    int scanNumber(int from);
+
+    QIODevice *device;
+    QByteArray buffer;
+    int pos;
+    qint64 bufferOffset;
+    bool dataComplete;
+    bool deviceAtEnd;
+
+    QByteArray containers;
+    State state;
+
+    QJsonStreamReader::TokenType type;
+    QJsonStreamReader::Error error;
+    QJsonParseError::ParseError parseError;
+
+    QString pendingName;
+    QString name;
+    QString text;
+    double number;
+    bool boolean;
+};
+
+bool QJsonStreamReaderPrivate::fetchMore()
+{
+    if (!device || deviceAtEnd)
+        return false;
+
+    // grow the reads geometrically so that a single token much larger
+    // than the chunk size is not rescanned once per chunk
+    const int oldSize = buffer.size();
+    const int chunk = qMax(readChunkSize, oldSize - pos);
+    buffer.resize(oldSize + chunk);
+    const qint64 bytesRead = device->read(buffer.data() + oldSize, chunk);
+    buffer.resize(oldSize + int(qMax<qint64>(bytesRead, 0)));
+    if (bytesRead < 0 || (bytesRead == 0 && !device->isSequential()))
+        deviceAtEnd = true;
+    return bytesRead > 0;
+}
+
+bool QJsonStreamReaderPrivate::inputFinished() const
+{
+    return device ? deviceAtEnd : dataComplete;
+}
+
+bool QJsonStreamReaderPrivate::ensureAvailable(int count)
+{
+    while (buffer.size() - pos < count) {
+        if (!fetchMore())
+            return false;
+    }
+    return true;
+}
+
+void QJsonStreamReaderPrivate::skipWhitespace()
+{
+    for (;;) {
+        const char *data = buffer.constData();
+        const int size = buffer.size();
+        while (pos < size) {
+            const char c = data[pos];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+                return;
+            ++pos;
+        }
+        if (!fetchMore())
+            return;
+    }
+}
+
+void QJsonStreamReaderPrivate::compact()
+{
+    // drop what has been consumed, but only once it is worth the copy
+    if (pos >= readChunkSize && pos >= buffer.size() / 2) {
+        buffer.remove(0, pos);
+        bufferOffset += pos;
+        pos = 0;
+    }
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::raiseError(QJsonParseError::ParseError code)
+{
+    error = QJsonStreamReader::NotWellFormedError;
+    parseError = code;
+    return type = QJsonStreamReader::Invalid;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::raisePrematureEnd()
+{
+    error = QJsonStreamReader::PrematureEndOfDocumentError;
+    return type = QJsonStreamReader::Invalid;
+}
+
+/*
+    Returns the index of the closing quotation mark of the string that
+    starts at \a from, or -1 if it is not in the buffer yet.
+*/
+int QJsonStreamReaderPrivate::scanString(int from)
+{
+    int i = from + 1;
+    for (;;) {
+        const char *data = buffer.constData();
+        const int size = buffer.size();
+        while (i < size) {
+            const char c = data[i];
+            if (c == '"')
+                return i;
+            i += (c == '\\') ? 2 : 1;
+        }
+        if (!fetchMore())
+            return -1;
+    }
+}
+
+static inline int hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+bool QJsonStreamReaderPrivate::decodeString(int from, int to, QString *out)
+{
+    const char *data = buffer.constData();
+
+    // fast path: plain ASCII without escape sequences
+    int i = from;
+    while (i < to && uchar(data[i]) < 0x80 && data[i] != '\\')
+        ++i;
+    if (i == to) {
+        *out = QString::fromLatin1(data + from, to - from);
+        return true;
+    }
+
+    out->clear();
+    out->reserve(to - from);
+    i = from;
+    while (i < to) {
+        int runEnd = i;
+        while (runEnd < to && data[runEnd] != '\\')
+            ++runEnd;
+        if (runEnd != i)
+            out->append(QString::fromUtf8(data + i, runEnd - i));
+        if (runEnd == to)
+            break;
+
+        // an escape sequence; scanString() made sure it is complete
+        i = runEnd + 1;
+        switch (data[i++]) {
+        case '"':  out->append(QLatin1Char('"')); break;
+        case '\\': out->append(QLatin1Char('\\')); break;
+        case '/':  out->append(QLatin1Char('/')); break;
+        case 'b':  out->append(QLatin1Char('\b')); break;
+        case 'f':  out->append(QLatin1Char('\f')); break;
+        case 'n':  out->append(QLatin1Char('\n')); break;
+        case 'r':  out->append(QLatin1Char('\r')); break;
+        case 't':  out->append(QLatin1Char('\t')); break;
+        case 'u': {
+            if (to - i < 4)
+                return false;
+            ushort ch = 0;
+            for (int n = 0; n < 4; ++n) {
+                const int digit = hexValue(data[i++]);
+                if (digit < 0)
+                    return false;
+                ch = (ch << 4) | digit;
+            }
+            out->append(QChar(ch));
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+    Returns the index one past the end of the number that starts at
+    \a from, or -1 if it may continue past the end of the buffer.
+*/
+int QJsonStreamReaderPrivate::scanNumber(int from)
+{
+    int i = from;
+    for (;;) {
+        const char *data = buffer.constData();
+        const int size = buffer.size();
+        while (i < size) {
+            const char c = data[i];
+            if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'))
+                return i;
+            ++i;
+        }
+        if (!fetchMore())
+            return inputFinished() ? i : -1;
+    }
+}
+
+// number = [ minus ] int [ frac ] [ exp ], as in RFC 4627
+static bool isValidNumber(const char *begin, const char *end)
+{
+    const char *p = begin;
+    if (p < end && *p == '-')
+        ++p;
+    if (p < end && *p == '0') {
+        ++p;
+    } else {
+        const char *digits = p;
+        while (p < end && *p >= '0' && *p <= '9')
+            ++p;
+        if (p == digits)
+            return false;
+    }
+    if (p < end && *p == '.') {
+        const char *digits = ++p;
+        while (p < end && *p >= '0' && *p <= '9')
+            ++p;
+        if (p == digits)
+            return false;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        if (p < end && (*p == '-' || *p == '+'))
+            ++p;
+        const char *digits = p;
+        while (p < end && *p >= '0' && *p <= '9')
+            ++p;
+        if (p == digits)
+            return false;
+    }
+    return p == end;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::endContainer(char closing)
+{
+    const char opening = closing == ']' ? '[' : '{';
+    if (containers.isEmpty() || containers.at(containers.size() - 1) != opening)
+        return raiseError(closing == ']' ? QJsonParseError::UnterminatedObject
+                                         : QJsonParseError::UnterminatedArray);
+    ++pos;
+    containers.chop(1);
+    state = containers.isEmpty() ? ExpectValue : ExpectSeparatorOrEnd;
+    name.clear();
+    return type = (closing == ']' ? QJsonStreamReader::EndArray : QJsonStreamReader::EndObject);
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::beginValue()
+{
+    // the key, if any, belongs to the value we are about to report
+    name = pendingName;
+    pendingName.clear();
+
+    const char c = buffer.at(pos);
+    QJsonStreamReader::TokenType result;
+    switch (c) {
+    case '[':
+    case '{':
+        if (containers.size() >= nestingLimit)
+            return raiseError(QJsonParseError::DeepNesting);
+        ++pos;
+        containers.append(c);
+        state = (c == '[') ? ExpectValueOrEnd : ExpectKeyOrEnd;
+        return type = (c == '[') ? QJsonStreamReader::StartArray : QJsonStreamReader::StartObject;
+
+    case '"': {
+        const int end = scanString(pos);
+        if (end < 0)
+            return inputFinished() ? raiseError(QJsonParseError::UnterminatedString) : raisePrematureEnd();
+        if (!decodeString(pos + 1, end, &text))
+            return raiseError(QJsonParseError::IllegalEscapeSequence);
+        pos = end + 1;
+        result = QJsonStreamReader::String;
+        break;
+    }
+
+    case 't':
+    case 'f':
+    case 'n': {
+        const char *literal = (c == 't') ? "true" : (c == 'f') ? "false" : "null";
+        const int length = int(qstrlen(literal));
+        if (!ensureAvailable(length))
+            return inputFinished() ? raiseError(QJsonParseError::IllegalValue) : raisePrematureEnd();
+        if (memcmp(buffer.constData() + pos, literal, length) != 0)
+            return raiseError(QJsonParseError::IllegalValue);
+        pos += length;
+        boolean = (c == 't');
+        result = (c == 'n') ? QJsonStreamReader::Null : QJsonStreamReader::Bool;
+        break;
+    }
+
+    default: {
+        if (c != '-' && (c < '0' || c > '9'))
+            return raiseError(QJsonParseError::IllegalValue);
+        const int end = scanNumber(pos);
+        if (end < 0)
+            return raisePrematureEnd();
+        const char *begin = buffer.constData() + pos;
+        if (!isValidNumber(begin, buffer.constData() + end))
+            return raiseError(QJsonParseError::IllegalNumber);
+        bool ok;
+        number = QByteArray::fromRawData(begin, end - pos).toDouble(&ok);
+        if (!ok)
+            return raiseError(QJsonParseError::IllegalNumber);
+        pos = end;
+        result = QJsonStreamReader::Double;
+        break;
+    }
+    }
+
+    state = containers.isEmpty() ? ExpectValue : ExpectSeparatorOrEnd;
+    return type = result;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readNext()
+{
+    if (error == QJsonStreamReader::PrematureEndOfDocumentError) {
+        // resume with whatever has been added since
+        error = QJsonStreamReader::NoError;
+    } else if (error != QJsonStreamReader::NoError || type == QJsonStreamReader::EndDocument) {
+        return type;
+    }
+
+    compact();
+
+    for (;;) {
+        skipWhitespace();
+        if (pos == buffer.size()) {
+            if (!inputFinished())
+                return raisePrematureEnd();
+            if (!containers.isEmpty())
+                return raiseError(containers.at(containers.size() - 1) == '[' ? QJsonParseError::UnterminatedArray
+                                                                            : QJsonParseError::UnterminatedObject);
+            name.clear();
+            return type = QJsonStreamReader::EndDocument;
+        }
+
+        const char c = buffer.at(pos);
+        switch (state) {
+        case ExpectValueOrEnd:
+            if (c == ']')
+                return endContainer(c);
+            Q_FALLTHROUGH();
+        case ExpectValue:
+            return beginValue();
+
+        case ExpectKeyOrEnd:
+            if (c == '}')
+                return endContainer(c);
+            Q_FALLTHROUGH();
+        case ExpectKey: {
+            if (c != '"')
+                return raiseError(QJsonParseError::IllegalValue);
+            const int end = scanString(pos);
+            if (end < 0)
+                return inputFinished() ? raiseError(QJsonParseError::UnterminatedString) : raisePrematureEnd();
+            if (!decodeString(pos + 1, end, &pendingName))
+                return raiseError(QJsonParseError::IllegalEscapeSequence);
+            pos = end + 1;
+            state = ExpectNameSeparator;
+            break;
+        }
+
+        case ExpectNameSeparator:
+            if (c != ':')
+                return raiseError(QJsonParseError::MissingNameSeparator);
+            ++pos;
+            state = ExpectValue;
+            break;
+
+        case ExpectSeparatorOrEnd: {
+            const bool inArray = containers.at(containers.size() - 1) == '[';
+            if (c == ',') {
+                ++pos;
+                state = inArray ? ExpectValue : ExpectKey;
+                break;
+            }
+            if (c == ']' || c == '}')
+                return endContainer(c);
+            return raiseError(inArray ? QJsonParseError::MissingValueSeparator
+                                      : QJsonParseError::UnterminatedObject);
+        }
+        }
+    }
+}
+
+/*!
+    Constructs a stream reader.
+
+    \sa setDevice(), addData()
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d_ptr(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Creates a new stream reader that reads from \a device.
+
+    \sa setDevice(), clear()
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : d_ptr(new QJsonStreamReaderPrivate)
+{
+    setDevice(device);
+}
+
+/*!
+    Creates a new stream reader that reads from \a data. The data is
+    treated as the complete input, unless more is added with addData().
+
+    \sa addData(), clear()
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : d_ptr(new QJsonStreamReaderPrivate)
+{
+    Q_D(QJsonStreamReader);
+    d->buffer = data;
+    d->dataComplete = true;
+}
+
+/*!
+    Destructs the reader.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the current device to \a device. Setting the device resets the
+    stream to its initial state.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    clear();
+    d_func()->device = device;
+}
+
+/*!
+    Returns the current device associated with the QJsonStreamReader, or
+    0 if no device has been assigned.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d_func()->device;
+}
+
+/*!
+    Adds more \a data for the reader to read. This function does nothing
+    if the reader has a device().
+
+    After a call to addData(), the reader no longer considers the end of
+    its data to be the end of the input; it reports
+    PrematureEndOfDocumentError instead of EndDocument when it runs out.
+
+    \sa readNext(), clear()
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    Q_D(QJsonStreamReader);
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    d->buffer += data;
+    d->dataComplete = false;
+}
+
+/*!
+    Removes any device() or data from the reader and resets its internal
+    state to the initial state.
+
+    \sa addData()
+*/
+void QJsonStreamReader::clear()
+{
+    d_ptr.reset(new QJsonStreamReaderPrivate);
+}
+
+/*!
+    Returns \c true if the reader has read until the end of the input, or
+    if an error() has occurred and reading has been aborted. Otherwise,
+    it returns \c false.
+
+    When atEnd() and hasError() return true and error() returns
+    PrematureEndOfDocumentError, it means the input so far is valid JSON
+    but incomplete; reading continues after more data has been added.
+
+    \sa hasError(), error(), device(), QIODevice::atEnd()
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type == EndDocument || d->error != NoError;
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    If an error() occurs, reading is aborted: error() and errorString()
+    describe the problem and all further calls return Invalid. The
+    exception is PrematureEndOfDocumentError, after which reading
+    resumes once more data is available.
+
+    \sa tokenType(), tokenString()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    return d_func()->readNext();
+}
+
+/*!
+    If the current token is StartArray or StartObject, reads until the
+    matching EndArray or EndObject; otherwise does nothing. This is
+    useful for skipping values the application is not interested in.
+
+    If an error occurs before the end of the value is reached, this
+    function returns with the reader in the error state.
+*/
+void QJsonStreamReader::skipCurrentValue()
+{
+    Q_D(QJsonStreamReader);
+    if (d->type != StartArray && d->type != StartObject)
+        return;
+
+    const int targetDepth = depth() - 1;
+    while (readNext() != Invalid) {
+        if ((d->type == EndArray || d->type == EndObject) && depth() == targetDepth)
+            return;
+    }
+}
+
+/*!
+    Returns the type of the current token.
+
+    \sa tokenString()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    return d_func()->type;
+}
+
+/*!
+    Returns the reader's current token as string.
+
+    \sa tokenType()
+*/
+QString QJsonStreamReader::tokenString() const
+{
+    switch (d_func()->type) {
+    case NoToken:
+        return QStringLiteral("NoToken");
+    case Invalid:
+        return QStringLiteral("Invalid");
+    case StartArray:
+        return QStringLiteral("StartArray");
+    case EndArray:
+        return QStringLiteral("EndArray");
+    case StartObject:
+        return QStringLiteral("StartObject");
+    case EndObject:
+        return QStringLiteral("EndObject");
+    case String:
+        return QStringLiteral("String");
+    case Double:
+        return QStringLiteral("Double");
+    case Bool:
+        return QStringLiteral("Bool");
+    case Null:
+        return QStringLiteral("Null");
+    case EndDocument:
+        return QStringLiteral("EndDocument");
+    }
+    return QString();
+}
+
+/*!
+    Returns the number of arrays and objects that enclose the current
+    token. For StartArray and StartObject, this includes the array or
+    object that just started; for EndArray and EndObject, it no longer
+    includes the one that just ended.
+*/
+int QJsonStreamReader::depth() const
+{
+    return d_func()->containers.size();
+}
+
+/*!
+    Returns the key of the current value if it is a member of an object,
+    otherwise returns an empty string.
+*/
+QString QJsonStreamReader::name() const
+{
+    return d_func()->name;
+}
+
+/*!
+    Returns the string value of a String token, otherwise returns an
+    empty string.
+
+    \sa value()
+*/
+QString QJsonStreamReader::text() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type == String ? d->text : QString();
+}
+
+/*!
+    Returns the value of a Double token, otherwise returns 0.
+
+    \sa value()
+*/
+double QJsonStreamReader::toDouble() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type == Double ? d->number : 0;
+}
+
+/*!
+    Returns the value of a Bool token, otherwise returns \c false.
+
+    \sa value()
+*/
+bool QJsonStreamReader::toBool() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type == Bool && d->boolean;
+}
+
+/*!
+    Returns the current String, Double, Bool or Null token as a
+    QJsonValue. For all other tokens, returns an undefined QJsonValue.
+*/
+QJsonValue QJsonStreamReader::value() const
+{
+    Q_D(const QJsonStreamReader);
+    switch (d->type) {
+    case String:
+        return QJsonValue(d->text);
+    case Double:
+        return QJsonValue(d->number);
+    case Bool:
+        return QJsonValue(d->boolean);
+    case Null:
+        return QJsonValue(QJsonValue::Null);
+    default:
+        return QJsonValue(QJsonValue::Undefined);
+    }
+}
+
+/*!
+    Returns the offset, in bytes from the start of the input, of the
+    first byte that has not been consumed yet. When an error has
+    occurred, this is where the offending token starts.
+*/
+qint64 QJsonStreamReader::characterOffset() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->bufferOffset + d->pos;
+}
+
+/*!
+    Returns the type of the current error, or NoError if no error
+    occurred.
+
+    \sa errorString(), hasError()
+*/
+QJsonStreamReader::Error QJsonStreamReader::error() const
+{
+    return d_func()->error;
+}
+
+/*!
+    Returns the error message that was set with the current error().
+
+    \sa error()
+*/
+QString QJsonStreamReader::errorString() const
+{
+    Q_D(const QJsonStreamReader);
+    switch (d->error) {
+    case NoError:
+        break;
+    case NotWellFormedError: {
+        QJsonParseError parseError;
+        parseError.offset = int(characterOffset());
+        parseError.error = d->parseError;
+        return parseError.errorString();
+    }
+    case PrematureEndOfDocumentError:
+        return QCoreApplication::translate("QJsonStreamReader", "premature end of document");
+    }
+    return QString();
+}
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \since 5.11
+    \ingroup json
+    \reentrant
+
+    \brief The QJsonStreamWriter class provides a JSON writer with a
+    simple streaming API.
+
+    QJsonStreamWriter is the counterpart to QJsonStreamReader. It writes
+    JSON text incrementally, so that large documents or streams of
+    documents can be produced without first building a QJsonDocument.
+
+    Arrays and objects are opened with writeStartArray() and
+    writeStartObject() and closed with writeEndArray() and
+    writeEndObject(). Inside an object, every value is written with the
+    overloads that take a key. Values can be any QJsonValue, including
+    complete arrays and objects.
+
+    Top-level values are separated by a newline, so writing several of
+    them produces newline-delimited JSON.
+
+    \code
+    QJsonStreamWriter writer(&file);
+    writer.writeStartObject();
+    writer.writeValue(QStringLiteral("id"), 42);
+    writer.writeStartArray(QStringLiteral("tags"));
+    writer.writeValue(QStringLiteral("json"));
+    writer.writeEndArray();
+    writer.writeEndObject();
+    writer.writeEndDocument();
+    \endcode
+
+    \sa QJsonStreamReader, QJsonDocument::toJson(), QXmlStreamWriter
+*/
+
+class QJsonStreamWriterPrivate
+{
+public:
+    QJsonStreamWriterPrivate()
+        : device(0), array(0), autoFormatting(false), hasError(false), needSeparator(false),
+          wroteTopLevel(false)
+    {}
+
+    void writePrefix(const QString *name);
+    void writeEnd(char closing);
+    void flush();
+    QByteArray &output() { return array ? *array : buffer; }
+
+    QIODevice *device;
+    QByteArray *array;
+    QByteArray buffer;
+    QByteArray containers;
+    bool autoFormatting;
+    bool hasError;
+    bool needSeparator;
+    bool wroteTopLevel;
+};
+
+void QJsonStreamWriterPrivate::writePrefix(const QString *name)
+{
+    QByteArray &json = output();
+    if (containers.isEmpty()) {
+        if (wroteTopLevel)
+            json += '\n';
+        wroteTopLevel = true;
+    } else {
+        if (needSeparator)
+            json += ',';
+        if (autoFormatting) {
+            json += '\n';
+            json += QByteArray(4 * containers.size(), ' ');
+        }
+    }
+    needSeparator = true;
+
+    const bool inObject = !containers.isEmpty() && containers.at(containers.size() - 1) == '{';
+    if (inObject != (name != 0))
+        qWarning(inObject ? "QJsonStreamWriter: writing a value without a key inside an object"
+                          : "QJsonStreamWriter: writing a value with a key outside of an object");
+    if (name) {
+        QJsonPrivate::Writer::stringToJson(*name, json);
+        json += autoFormatting ? ": " : ":";
+    }
+}
+
+void QJsonStreamWriterPrivate::writeEnd(char closing)
+{
+    const char opening = closing == ']' ? '[' : '{';
+    if (containers.isEmpty() || containers.at(containers.size() - 1) != opening) {
+        qWarning("QJsonStreamWriter: unbalanced %s", closing == ']' ? "writeEndArray()" : "writeEndObject()");
+        return;
+    }
+    containers.chop(1);
+
+    QByteArray &json = output();
+    if (autoFormatting && needSeparator) {
+        json += '\n';
+        json += QByteArray(4 * containers.size(), ' ');
+    }
+    json += closing;
+    needSeparator = true;
+
+    if (device && (containers.isEmpty() || buffer.size() >= readChunkSize))
+        flush();
+}
+
+void QJsonStreamWriterPrivate::flush()
+{
+    if (!device || buffer.isEmpty())
+        return;
+    if (device->write(buffer) != buffer.size())
+        hasError = true;
+    buffer.clear();
+}
+
+/*!
+    Constructs a stream writer.
+
+    \sa setDevice()
+*/
+QJsonStreamWriter::QJsonStreamWriter()
+    : d_ptr(new QJsonStreamWriterPrivate)
+{
+}
+
+/*!
+    Constructs a stream writer that writes into \a device.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : d_ptr(new QJsonStreamWriterPrivate)
+{
+    d_func()->device = device;
+}
+
+/*!
+    Constructs a stream writer that appends to \a array.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *array)
+    : d_ptr(new QJsonStreamWriterPrivate)
+{
+    d_func()->array = array;
+}
+
+/*!
+    Destructor. Writes any output that is still buffered to the device.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    d_func()->flush();
+}
+
+/*!
+    Sets the current device to \a device. Output still buffered for the
+    previous device is written to it first.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    Q_D(QJsonStreamWriter);
+    d->flush();
+    d->device = device;
+    d->array = 0;
+}
+
+/*!
+    Returns the device associated with the QJsonStreamWriter, or 0 if no
+    device has been assigned.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d_func()->device;
+}
+
+/*!
+    Enables auto formatting if \a enable is \c true, otherwise disables
+    it. Auto-formatted output is indented like QJsonDocument::Indented.
+
+    The default value is \c false.
+*/
+void QJsonStreamWriter::setAutoFormatting(bool enable)
+{
+    d_func()->autoFormatting = enable;
+}
+
+/*!
+    Returns \c true if auto formatting is enabled, otherwise \c false.
+*/
+bool QJsonStreamWriter::autoFormatting() const
+{
+    return d_func()->autoFormatting;
+}
+
+/*!
+    Opens a new array at the top level or inside an array.
+
+    \sa writeEndArray()
+*/
+void QJsonStreamWriter::writeStartArray()
+{
+    Q_D(QJsonStreamWriter);
+    d->writePrefix(0);
+    d->output() += '[';
+    d->containers.append('[');
+    d->needSeparator = false;
+}
+
+/*!
+    Opens a new array as the member \a name of the current object.
+
+    \sa writeEndArray()
+*/
+void QJsonStreamWriter::writeStartArray(const QString &name)
+{
+    Q_D(QJsonStreamWriter);
+    d->writePrefix(&name);
+    d->output() += '[';
+    d->containers.append('[');
+    d->needSeparator = false;
+}
+
+/*!
+    Closes the array opened last.
+*/
+void QJsonStreamWriter::writeEndArray()
+{
+    d_func()->writeEnd(']');
+}
+
+/*!
+    Opens a new object at the top level or inside an array.
+
+    \sa writeEndObject()
+*/
+void QJsonStreamWriter::writeStartObject()
+{
+    Q_D(QJsonStreamWriter);
+    d->writePrefix(0);
+    d->output() += '{';
+    d->containers.append('{');
+    d->needSeparator = false;
+}
+
+/*!
+    Opens a new object as the member \a name of the current object.
+
+    \sa writeEndObject()
+*/
+void QJsonStreamWriter::writeStartObject(const QString &name)
+{
+    Q_D(QJsonStreamWriter);
+    d->writePrefix(&name);
+    d->output() += '{';
+    d->containers.append('{');
+    d->needSeparator = false;
+}
+
+/*!
+    Closes the object opened last.
+*/
+void QJsonStreamWriter::writeEndObject()
+{
+    d_func()->writeEnd('}');
+}
+
+/*!
+    Writes \a value at the top level or as the next element of the
+    current array. Undefined values are written as null.
+*/
+void QJsonStreamWriter::writeValue(const QJsonValue &value)
+{
+    Q_D(QJsonStreamWriter);
+    d->writePrefix(0);
+    QJsonPrivate::Writer::valueToJson(value, d->output(), d->containers.size(), !d->autoFormatting);
+    if (d->device && (d->containers.isEmpty() || d->buffer.size() >= readChunkSize))
+        d->flush();
+}
+
+/*!
+    Writes \a value as the member \a name of the current object.
+    Undefined values are written as null.
+*/
+void QJsonStreamWriter::writeValue(const QString &name, const QJsonValue &value)
+{
+    Q_D(QJsonStreamWriter);
+    d->writePrefix(&name);
+    QJsonPrivate::Writer::valueToJson(value, d->output(), d->containers.size(), !d->autoFormatting);
+    if (d->device && d->buffer.size() >= readChunkSize)
+        d->flush();
+}
+
+/*!
+    Closes all arrays and objects that are still open and writes all
+    buffered output to the device.
+*/
+void QJsonStreamWriter::writeEndDocument()
+{
+    Q_D(QJsonStreamWriter);
+    while (!d->containers.isEmpty())
+        d->writeEnd(d->containers.at(d->containers.size() - 1) == '[' ? ']' : '}');
+    d->flush();
+}
+
+/*!
+    Returns \c true if writing to the device failed, otherwise \c false.
+*/
+bool QJsonStreamWriter::hasError() const
+{
+    return d_func()->hasError;
+}
+
+QT_END_NAMESPACE
@@ -40,6 +40,9 @@
 
 #include <cmath>
 #include <qlocale.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
 #include "qjsonwriter_p.h"
 #include "qjson_p.h"
 #include "private/qutfcodec_p.h"
@@ -121,6 +124,16 @@ static QByteArray escapedString(const QString &s)
     return ba;
 }
 
+static void doubleToJson(double d, QByteArray &json)
+{
+    if (qIsFinite(d)) { // +2 to format to ensure the expected precision
+        const double abs = std::abs(d);
+        json += QByteArray::number(d, abs == static_cast<quint64>(abs) ? 'f' : 'g', QLocale::FloatingPointShortest);
+    } else {
+        json += "null"; // +INF || -INF || NaN (see RFC4627#section2.4)
+    }
+}
+
 static void valueToJson(const QJsonPrivate::Base *b, const QJsonPrivate::Value &v, QByteArray &json, int indent, bool compact)
 {
     QJsonValue::Type type = (QJsonValue::Type)(uint)v.type;
@@ -128,16 +141,9 @@ static void valueToJson(const QJsonPrivate::Base *b, const QJsonPrivate::Value &
     case QJsonValue::Bool:
         json += v.toBoolean() ? "true" : "false";
         break;
-    case QJsonValue::Double: {
-        const double d = v.toDouble(b);
-        if (qIsFinite(d)) { // +2 to format to ensure the expected precision
-            const double abs = std::abs(d);
-            json += QByteArray::number(d, abs == static_cast<quint64>(abs) ? 'f' : 'g', QLocale::FloatingPointShortest);
-        } else {
-            json += "null"; // +INF || -INF || NaN (see RFC4627#section2.4)
-        }
+    case QJsonValue::Double:
+        doubleToJson(v.toDouble(b), json);
         break;
-    }
     case QJsonValue::String:
         json += '"';
         json += escapedString(v.toString(b));
@@ -228,4 +234,41 @@ void Writer::arrayToJson(const QJsonPrivate::Array *a, QByteArray &json, int ind
     json += compact ? "]" : "]\n";
 }
 
+void Writer::stringToJson(const QString &s, QByteArray &json)
+{
+    json += '"';
+    json += escapedString(s);
+    json += '"';
+}
+
+void Writer::valueToJson(const QJsonValue &v, QByteArray &json, int indent, bool compact)
+{
+    switch (v.type()) {
+    case QJsonValue::Bool:
+        json += v.toBool() ? "true" : "false";
+        break;
+    case QJsonValue::Double:
+        doubleToJson(v.toDouble(), json);
+        break;
+    case QJsonValue::String:
+        stringToJson(v.toString(), json);
+        break;
+    case QJsonValue::Array:
+    case QJsonValue::Object: {
+        const QJsonDocument doc = v.isArray() ? QJsonDocument(v.toArray()) : QJsonDocument(v.toObject());
+        QByteArray nested = doc.toJson(compact ? QJsonDocument::Compact : QJsonDocument::Indented);
+        if (!compact) {
+            nested.chop(1); // the newline after the closing bracket
+            if (indent)
+                nested.replace('\n', '\n' + QByteArray(4*indent, ' '));
+        }
+        json += nested;
+        break;
+    }
+    case QJsonValue::Null:
+    default:
+        json += "null";
+    }
+}
+
 QT_END_NAMESPACE
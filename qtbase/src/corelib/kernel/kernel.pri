@@ -21,6 +21,7 @@ HEADERS += \
         kernel/qobjectdefs_impl.h \
         kernel/qsignalmapper.h \
         kernel/qsocketnotifier.h \
+        kernel/qstartuptrace_p.h \
         kernel/qtimer.h \
         kernel/qtranslator.h \
         kernel/qtranslator_p.h \
@@ -33,6 +34,7 @@ HEADERS += \
         kernel/qmetaobject_moc_p.h \
         kernel/qmetaobjectbuilder_p.h \
         kernel/qobject_p.h \
+        kernel/qobjectarena_p.h \
         kernel/qcoreglobaldata_p.h \
         kernel/qsharedmemory.h \
         kernel/qsharedmemory_p.h \
@@ -58,9 +60,11 @@ SOURCES += \
         kernel/qmetaobjectbuilder.cpp \
         kernel/qmimedata.cpp \
         kernel/qobject.cpp \
+        kernel/qobjectarena.cpp \
         kernel/qobjectcleanuphandler.cpp \
         kernel/qsignalmapper.cpp \
         kernel/qsocketnotifier.cpp \
+        kernel/qstartuptrace.cpp \
         kernel/qtimer.cpp \
         kernel/qtranslator.cpp \
         kernel/qvariant.cpp \
@@ -155,6 +159,11 @@ unix|integrity {
 
     qtConfig(poll_select): SOURCES += kernel/qpoll.cpp
 
+    linux {
+        SOURCES += kernel/qeventdispatcher_epoll.cpp
+        HEADERS += kernel/qeventdispatcher_epoll_p.h
+    }
+
     qtConfig(glib) {
         SOURCES += \
             kernel/qeventdispatcher_glib.cpp
@@ -294,6 +294,29 @@ int QAbstractEventDispatcher::registerTimer(int interval, Qt::TimerType timerTyp
     \sa Qt::TimerType
 */
 
+/*!
+    \since 5.11
+
+    Returns statistics about the timers handled by this event dispatcher,
+    for example to check how well timer coalescing works for the
+    application's mix of Qt::TimerType values.
+
+    Event dispatchers that do not collect statistics return a
+    TimerStatistics with all members set to zero.
+
+    \sa TimerStatistics
+*/
+QAbstractEventDispatcher::TimerStatistics QAbstractEventDispatcher::timerStatistics() const
+{
+    Q_D(const QAbstractEventDispatcher);
+    return d->timerStatistics();
+}
+
+QAbstractEventDispatcher::TimerStatistics QAbstractEventDispatcherPrivate::timerStatistics() const
+{
+    return QAbstractEventDispatcher::TimerStatistics();
+}
+
 /*!
     \fn int QAbstractEventDispatcher::remainingTime(int timerId)
 
@@ -374,6 +397,49 @@ void QAbstractEventDispatcher::closingDown()
     \sa Qt::TimerType
 */
 
+/*!
+    \class QAbstractEventDispatcher::TimerStatistics
+    \inmodule QtCore
+    \since 5.11
+
+    This struct is returned by QAbstractEventDispatcher::timerStatistics().
+    The counters accumulate over the lifetime of the event dispatcher.
+*/
+
+/*!
+    \variable QAbstractEventDispatcher::TimerStatistics::registeredTimers
+
+    The number of timers currently registered.
+*/
+
+/*!
+    \variable QAbstractEventDispatcher::TimerStatistics::activations
+
+    The number of timer events delivered.
+*/
+
+/*!
+    \variable QAbstractEventDispatcher::TimerStatistics::wakeUps
+
+    The number of times the event loop woke up and delivered at least one
+    timer event. Dividing activations by this number gives the average
+    number of timers that fired together.
+*/
+
+/*!
+    \variable QAbstractEventDispatcher::TimerStatistics::totalSlack
+
+    The sum, in microseconds, of the delays between the time timers were
+    scheduled to fire and the time they fired.
+*/
+
+/*!
+    \variable QAbstractEventDispatcher::TimerStatistics::maximumSlack
+
+    The longest delay, in microseconds, between the time a timer was
+    scheduled to fire and the time it fired.
+*/
+
 /*!
     Installs an event filter \a filterObj for all native events received by the application.
 
@@ -70,6 +70,19 @@ public:
         { }
     };
 
+    struct TimerStatistics
+    {
+        int registeredTimers;
+        qint64 activations;
+        qint64 wakeUps;
+        qint64 totalSlack;
+        qint64 maximumSlack;
+
+        inline TimerStatistics()
+            : registeredTimers(0), activations(0), wakeUps(0), totalSlack(0), maximumSlack(0)
+        { }
+    };
+
     explicit QAbstractEventDispatcher(QObject *parent = Q_NULLPTR);
     ~QAbstractEventDispatcher();
 
@@ -94,6 +107,7 @@ public:
     virtual QList<TimerInfo> registeredTimers(QObject *object) const = 0;
 
     virtual int remainingTime(int timerId) = 0;
+    TimerStatistics timerStatistics() const;
 
 #if defined(Q_OS_WIN) || defined(Q_QDOC)
     virtual bool registerEventNotifier(QWinEventNotifier *notifier) = 0;
@@ -125,6 +139,7 @@ protected:
 };
 
 Q_DECLARE_TYPEINFO(QAbstractEventDispatcher::TimerInfo, (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0) ? Q_PRIMITIVE_TYPE : Q_RELOCATABLE_TYPE));
+Q_DECLARE_TYPEINFO(QAbstractEventDispatcher::TimerStatistics, Q_MOVABLE_TYPE);
 
 QT_END_NAMESPACE
 
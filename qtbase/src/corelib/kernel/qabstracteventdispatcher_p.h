@@ -67,6 +67,8 @@ public:
 
     QList<QAbstractNativeEventFilter *> eventFilters;
 
+    virtual QAbstractEventDispatcher::TimerStatistics timerStatistics() const;
+
     static int allocateTimerId();
     static void releaseTimerId(int id);
 };
@@ -69,6 +69,9 @@
 #include <private/qfunctions_p.h>
 #include <private/qlocale_p.h>
 #include <private/qhooks_p.h>
+#ifndef QT_BOOTSTRAPPED
+#include <private/qstartuptrace_p.h>
+#endif
 
 #ifndef QT_NO_QOBJECT
 #if defined(Q_OS_UNIX)
@@ -78,6 +81,9 @@
 #  if !defined(QT_NO_GLIB)
 #   include "qeventdispatcher_glib_p.h"
 #  endif
+#  if defined(Q_OS_LINUX)
+#   include "qeventdispatcher_epoll_p.h"
+#  endif
 # endif
 # include "qeventdispatcher_unix_p.h"
 #endif
@@ -540,12 +546,17 @@ void QCoreApplicationPrivate::createEventDispatcher()
         eventDispatcher = new QEventDispatcherCoreFoundation(q);
     else
         eventDispatcher = new QEventDispatcherUNIX(q);
-#  elif !defined(QT_NO_GLIB)
+#  else
+#    if defined(Q_OS_LINUX)
+    if (QEventDispatcherEpoll::isRequested())
+        eventDispatcher = new QEventDispatcherEpoll(q);
+    else
+#    endif
+#    if !defined(QT_NO_GLIB)
     if (qEnvironmentVariableIsEmpty("QT_NO_GLIB") && QEventDispatcherGlib::versionSupported())
         eventDispatcher = new QEventDispatcherGlib(q);
     else
-        eventDispatcher = new QEventDispatcherUNIX(q);
-#  else
+#    endif
         eventDispatcher = new QEventDispatcherUNIX(q);
 #  endif
 #elif defined(Q_OS_WINRT)
@@ -787,6 +798,9 @@ void QCoreApplicationPrivate::init()
 #if defined(Q_OS_MACOS)
     QMacAutoReleasePool pool;
 #endif
+#ifndef QT_BOOTSTRAPPED
+    QStartupTraceScope trace("QCoreApplicationPrivate::init");
+#endif
 
     Q_Q(QCoreApplication);
 
@@ -1442,14 +1456,99 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
-    QThreadData * volatile * pdata = &receiver->d_func()->threadData;
-    QThreadData *data = *pdata;
+    QThreadData *data = QCoreApplicationPrivate::lockPostEventList(receiver);
     if (!data) {
         // posting during destruction? just delete the event to prevent a leak
         delete event;
         return;
     }
 
+    QMutexUnlocker locker(&data->postEventList.mutex);
+    if (!QCoreApplicationPrivate::addPostedEvent(data, receiver, event, priority))
+        return;
+    locker.unlock();
+
+    QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+    if (dispatcher)
+        dispatcher->wakeUp();
+}
+
+/*!
+    \since 5.11
+
+    Adds all \a events, with the object \a receiver as their receiver, to
+    the event queue of the receiver's thread and returns immediately.
+
+    This has the same effect as calling postEvent() once for each of the
+    \a events, in order, with the same \a priority. However, the event queue
+    is locked only once and the receiver's thread is woken up only once,
+    which makes a difference when posting many events to an object living
+    in another thread.
+
+    The queue takes ownership of all \a events.
+
+    \threadsafe
+
+    \sa postEvent(), sendPostedEvents()
+*/
+void QCoreApplication::postEvents(QObject *receiver, const QList<QEvent *> &events, int priority)
+{
+    if (events.isEmpty())
+        return;
+
+    if (receiver == 0) {
+        qWarning("QCoreApplication::postEvents: Unexpected null receiver");
+        qDeleteAll(events);
+        return;
+    }
+
+    QThreadData *data = QCoreApplicationPrivate::lockPostEventList(receiver);
+    if (!data) {
+        // posting during destruction? just delete the events to prevent a leak
+        qDeleteAll(events);
+        return;
+    }
+
+    QMutexUnlocker locker(&data->postEventList.mutex);
+    bool added = false;
+    for (int i = 0; i < events.size(); ++i) {
+#ifndef QT_NO_EXCEPTIONS
+        try {
+#endif
+            added |= QCoreApplicationPrivate::addPostedEvent(data, receiver, events.at(i), priority);
+#ifndef QT_NO_EXCEPTIONS
+        } catch (...) {
+            // addPostedEvent() deleted the failing event already
+            for (int j = i + 1; j < events.size(); ++j)
+                delete events.at(j);
+            throw;
+        }
+#endif
+    }
+    locker.unlock();
+
+    if (!added)
+        return;
+
+    QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+    if (dispatcher)
+        dispatcher->wakeUp();
+}
+
+/*!
+  \internal
+  Locks the post event list of the thread \a receiver lives in and returns
+  that thread's data. If the object moves to another thread meanwhile, the
+  lock follows it. Returns \c nullptr, without locking anything, if the
+  receiver is being destroyed.
+*/
+QThreadData *QCoreApplicationPrivate::lockPostEventList(QObject *receiver)
+{
+    QThreadData * volatile * pdata = &receiver->d_func()->threadData;
+    QThreadData *data = *pdata;
+    if (!data)
+        return nullptr;
+
     // lock the post event mutex
     data->postEventList.mutex.lock();
 
@@ -1458,21 +1557,29 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         data->postEventList.mutex.unlock();
 
         data = *pdata;
-        if (!data) {
-            // posting during destruction? just delete the event to prevent a leak
-            delete event;
-            return;
-        }
+        if (!data)
+            return nullptr;
 
         data->postEventList.mutex.lock();
     }
 
-    QMutexUnlocker locker(&data->postEventList.mutex);
+    return data;
+}
 
+/*!
+  \internal
+  Adds \a event for \a receiver to the post event list of \a data, which
+  must be locked, unless the event can be compressed away. Takes ownership
+  of \a event. Returns \c true if the list grew and the receiver's thread
+  needs to be woken up.
+*/
+bool QCoreApplicationPrivate::addPostedEvent(QThreadData *data, QObject *receiver, QEvent *event, int priority)
+{
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
-        && self && self->compressEvent(event, receiver, &data->postEventList)) {
-        return;
+        && QCoreApplication::self
+        && QCoreApplication::self->compressEvent(event, receiver, &data->postEventList)) {
+        return false;
     }
 
     if (event->type() == QEvent::DeferredDelete)
@@ -1508,11 +1615,7 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     event->posted = true;
     ++receiver->d_func()->postedEvents;
     data->canWait = false;
-    locker.unlock();
-
-    QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
-    if (dispatcher)
-        dispatcher->wakeUp();
+    return true;
 }
 
 /*!
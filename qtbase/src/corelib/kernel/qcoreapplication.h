@@ -123,6 +123,7 @@ public:
 
     static bool sendEvent(QObject *receiver, QEvent *event);
     static void postEvent(QObject *receiver, QEvent *event, int priority = Qt::NormalEventPriority);
+    static void postEvents(QObject *receiver, const QList<QEvent *> &events, int priority = Qt::NormalEventPriority);
     static void sendPostedEvents(QObject *receiver = Q_NULLPTR, int event_type = 0);
     static void removePostedEvents(QObject *receiver, int eventType = 0);
 #if QT_DEPRECATED_SINCE(5, 3)
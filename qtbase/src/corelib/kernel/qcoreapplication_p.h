@@ -106,6 +106,8 @@ public:
     virtual void createEventDispatcher();
     virtual void eventDispatcherReady();
     static void removePostedEvent(QEvent *);
+    static QThreadData *lockPostEventList(QObject *receiver);
+    static bool addPostedEvent(QThreadData *data, QObject *receiver, QEvent *event, int priority);
 #ifdef Q_OS_WIN
     static void removePostedTimerEvent(QObject *object, int timerId);
 #endif
@@ -0,0 +1,509 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qplatformdefs.h"
+
+#include "qcoreapplication.h"
+#include "qsocketnotifier.h"
+#include "qthread.h"
+
+#include "qeventdispatcher_epoll_p.h"
+#include <private/qthread_p.h>
+#include <private/qcoreapplication_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    \internal
+    \class QEventDispatcherEpoll
+
+    An event dispatcher for Linux that keeps the socket notifiers registered
+    in an epoll(7) set instead of building a pollfd array on every iteration
+    of the event loop. Registering, unregistering and waiting are therefore
+    independent of the number of socket notifiers, which matters for
+    processes having thousands of them.
+
+    Timers are handled by QTimerInfoList and wake-ups by QThreadPipe, exactly
+    as in QEventDispatcherUNIX. It is used instead of the default dispatcher
+    when the QT_EVENT_DISPATCHER environment variable is set to "epoll".
+*/
+
+static const char *socketType(QSocketNotifier::Type type)
+{
+    switch (type) {
+    case QSocketNotifier::Read:
+        return "Read";
+    case QSocketNotifier::Write:
+        return "Write";
+    case QSocketNotifier::Exception:
+        return "Exception";
+    }
+
+    Q_UNREACHABLE();
+}
+
+static quint32 epollEvents(const QSocketNotifierSetUNIX &sn_set)
+{
+    quint32 result = 0;
+
+    if (sn_set.notifiers[QSocketNotifier::Read])
+        result |= EPOLLIN;
+
+    if (sn_set.notifiers[QSocketNotifier::Write])
+        result |= EPOLLOUT;
+
+    if (sn_set.notifiers[QSocketNotifier::Exception])
+        result |= EPOLLPRI;
+
+    return result;
+}
+
+static int timespecToTimeout(const timespec &ts)
+{
+    // round up, a timer must never fire early
+    const qint64 msecs = qint64(ts.tv_sec) * 1000 + (ts.tv_nsec + 999999) / 1000000;
+    return int(qMin<qint64>(msecs, INT_MAX));
+}
+
+QEventDispatcherEpollPrivate::QEventDispatcherEpollPrivate()
+    : epollFd(-1)
+{
+    if (Q_UNLIKELY(threadPipe.init() == false))
+        qFatal("QEventDispatcherEpollPrivate(): Can not continue without a thread pipe");
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (Q_UNLIKELY(epollFd == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Can not continue without an epoll instance: %s",
+               qPrintable(qt_error_string(errno)));
+
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (Q_UNLIKELY(epoll_ctl(epollFd, EPOLL_CTL_ADD, threadPipe.fds[0], &ev) == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Can not watch the thread pipe: %s",
+               qPrintable(qt_error_string(errno)));
+
+    events.resize(16);
+}
+
+QEventDispatcherEpollPrivate::~QEventDispatcherEpollPrivate()
+{
+    qt_safe_close(epollFd);
+
+    // cleanup timers
+    qDeleteAll(timerList);
+}
+
+/*
+    \internal
+    Brings the registration of \a sockfd in the epoll set in line with \a sn_set.
+    \a isNew tells if \a sockfd was registered before.
+*/
+void QEventDispatcherEpollPrivate::updateSocketNotifiers(int sockfd, const QSocketNotifierSetUNIX &sn_set, bool isNew)
+{
+    const int alwaysReady = alwaysReadySockets.indexOf(sockfd);
+    if (alwaysReady != -1) {
+        if (sn_set.isEmpty())
+            alwaysReadySockets.remove(alwaysReady);
+        return;
+    }
+
+    epoll_event ev;
+    ev.events = epollEvents(sn_set);
+    ev.data.fd = sockfd;
+
+    if (sn_set.isEmpty()) {
+        // the descriptor may already have been closed, which removed it from the set
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, sockfd, &ev);
+        return;
+    }
+
+    int op = isNew ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+    int ret = epoll_ctl(epollFd, op, sockfd, &ev);
+    if (ret == -1 && (errno == EEXIST || errno == ENOENT)) {
+        // The descriptor was closed and reused behind our back (ENOENT), or is
+        // still in the set from before it was closed (EEXIST).
+        op = (errno == EEXIST) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+        ret = epoll_ctl(epollFd, op, sockfd, &ev);
+    }
+
+    if (ret == -1) {
+        if (errno == EPERM) {
+            // epoll does not support regular files and directories; poll()
+            // reports them as always readable and writable, so do the same
+            alwaysReadySockets.append(sockfd);
+        } else {
+            qWarning("QSocketNotifier: Cannot watch socket %d: %s",
+                     sockfd, qPrintable(qt_error_string(errno)));
+        }
+    }
+}
+
+void QEventDispatcherEpollPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+
+    if (pendingNotifiers.contains(notifier))
+        return;
+
+    pendingNotifiers << notifier;
+}
+
+void QEventDispatcherEpollPrivate::markPendingSocketNotifiers(int sockfd, quint32 revents)
+{
+    auto it = socketNotifiers.constFind(sockfd);
+    if (it == socketNotifiers.constEnd())
+        return;
+
+    const QSocketNotifierSetUNIX &sn_set = it.value();
+
+    static const struct {
+        QSocketNotifier::Type type;
+        quint32 flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      EPOLLIN  | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Write,     EPOLLOUT | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Exception, EPOLLPRI | EPOLLHUP | EPOLLERR }
+    };
+
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = sn_set.notifiers[n.type];
+
+        if (notifier && (revents & n.flags))
+            setSocketNotifierPending(notifier);
+    }
+}
+
+QAbstractEventDispatcher::TimerStatistics QEventDispatcherEpollPrivate::timerStatistics() const
+{
+    return timerList.timerStatistics();
+}
+
+int QEventDispatcherEpollPrivate::activateSocketNotifiers()
+{
+    if (pendingNotifiers.isEmpty())
+        return 0;
+
+    int n_activated = 0;
+    QEvent event(QEvent::SockAct);
+
+    while (!pendingNotifiers.isEmpty()) {
+        QSocketNotifier *notifier = pendingNotifiers.takeFirst();
+        QCoreApplication::sendEvent(notifier, &event);
+        ++n_activated;
+    }
+
+    return n_activated;
+}
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QObject *parent)
+    : QAbstractEventDispatcher(*new QEventDispatcherEpollPrivate, parent)
+{ }
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent)
+    : QAbstractEventDispatcher(dd, parent)
+{ }
+
+QEventDispatcherEpoll::~QEventDispatcherEpoll()
+{ }
+
+/*!
+    \internal
+    Returns \c true if the QT_EVENT_DISPATCHER environment variable selects
+    this dispatcher.
+*/
+bool QEventDispatcherEpoll::isRequested()
+{
+    return qgetenv("QT_EVENT_DISPATCHER") == "epoll";
+}
+
+/*!
+    \internal
+*/
+void QEventDispatcherEpoll::registerTimer(int timerId, int interval, Qt::TimerType timerType, QObject *obj)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1 || interval < 0 || !obj) {
+        qWarning("QEventDispatcherEpoll::registerTimer: invalid arguments");
+        return;
+    } else if (obj->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::registerTimer: timers cannot be started from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    d->timerList.registerTimer(timerId, interval, timerType, obj);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimer(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: invalid argument");
+        return false;
+    } else if (thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimer(timerId);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimers(QObject *object)
+{
+#ifndef QT_NO_DEBUG
+    if (!object) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: invalid argument");
+        return false;
+    } else if (object->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimers(object);
+}
+
+QList<QEventDispatcherEpoll::TimerInfo>
+QEventDispatcherEpoll::registeredTimers(QObject *object) const
+{
+    if (!object) {
+        qWarning("QEventDispatcherEpoll:registeredTimers: invalid argument");
+        return QList<TimerInfo>();
+    }
+
+    Q_D(const QEventDispatcherEpoll);
+    return d->timerList.registeredTimers(object);
+}
+
+void QEventDispatcherEpoll::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    QSocketNotifier::Type type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (notifier->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifiers cannot be enabled from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    const bool isNew = !d->socketNotifiers.contains(sockfd);
+    QSocketNotifierSetUNIX &sn_set = d->socketNotifiers[sockfd];
+
+    if (sn_set.notifiers[type] && sn_set.notifiers[type] != notifier)
+        qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
+                 Q_FUNC_INFO, sockfd, socketType(type));
+
+    sn_set.notifiers[type] = notifier;
+    d->updateSocketNotifiers(sockfd, sn_set, isNew);
+}
+
+void QEventDispatcherEpoll::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    QSocketNotifier::Type type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (notifier->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifier (fd %d) cannot be disabled from another thread.",
+                 sockfd);
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+
+    d->pendingNotifiers.removeOne(notifier);
+
+    auto i = d->socketNotifiers.find(sockfd);
+    if (i == d->socketNotifiers.end())
+        return;
+
+    QSocketNotifierSetUNIX &sn_set = i.value();
+
+    if (sn_set.notifiers[type] == nullptr)
+        return;
+
+    if (sn_set.notifiers[type] != notifier) {
+        qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
+                 Q_FUNC_INFO, sockfd, socketType(type));
+        return;
+    }
+
+    sn_set.notifiers[type] = nullptr;
+    d->updateSocketNotifiers(sockfd, sn_set, false);
+
+    if (sn_set.isEmpty())
+        d->socketNotifiers.erase(i);
+}
+
+bool QEventDispatcherEpoll::processEvents(QEventLoop::ProcessEventsFlags flags)
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.store(0);
+
+    // we are awake, broadcast it
+    emit awake();
+    QCoreApplicationPrivate::sendPostedEvents(0, 0, d->threadData);
+
+    const bool include_timers = (flags & QEventLoop::X11ExcludeTimers) == 0;
+    const bool include_notifiers = (flags & QEventLoop::ExcludeSocketNotifiers) == 0;
+    const bool wait_for_events = flags & QEventLoop::WaitForMoreEvents;
+
+    const bool canWait = (d->threadData->canWaitLocked()
+                          && !d->interrupt.load()
+                          && wait_for_events);
+
+    if (canWait)
+        emit aboutToBlock();
+
+    if (d->interrupt.load())
+        return false;
+
+    int timeout = -1;
+    timespec wait_tm = { 0, 0 };
+
+    if (!canWait || (include_notifiers && !d->alwaysReadySockets.isEmpty()))
+        timeout = 0;
+    else if (include_timers && d->timerList.timerWait(wait_tm))
+        timeout = timespecToTimeout(wait_tm);
+
+    int nevents = 0;
+
+    if (include_notifiers) {
+        // Level-triggered, so anything that does not fit into the buffer is
+        // reported again on the next iteration.
+        const int maxEvents = qBound(16, d->socketNotifiers.size() + 1, 1024);
+        if (d->events.size() < maxEvents)
+            d->events.resize(maxEvents);
+
+        int count;
+        EINTR_LOOP(count, epoll_wait(d->epollFd, d->events.data(), d->events.size(), timeout));
+        if (count == -1)
+            perror("epoll_wait");
+
+        for (int i = 0; i < count; ++i) {
+            const epoll_event &ev = d->events.at(i);
+            if (ev.data.fd == d->threadPipe.fds[0]) {
+                pollfd pfd = d->threadPipe.prepare();
+                pfd.revents = (ev.events & EPOLLIN) ? POLLIN : 0;
+                nevents += d->threadPipe.check(pfd);
+            } else {
+                d->markPendingSocketNotifiers(ev.data.fd, ev.events);
+            }
+        }
+
+        for (int sockfd : qAsConst(d->alwaysReadySockets))
+            d->markPendingSocketNotifiers(sockfd, EPOLLIN | EPOLLOUT);
+
+        nevents += d->activateSocketNotifiers();
+    } else {
+        // The epoll set cannot leave the socket notifiers out, so only wait
+        // for the thread pipe.
+        pollfd pfd = d->threadPipe.prepare();
+        timespec *tm = nullptr;
+        if (timeout >= 0)
+            tm = &wait_tm;
+        if (qt_safe_poll(&pfd, 1, tm) > 0)
+            nevents += d->threadPipe.check(pfd);
+    }
+
+    if (include_timers)
+        nevents += d->timerList.activateTimers();
+
+    // return true if we handled events, false otherwise
+    return (nevents > 0);
+}
+
+bool QEventDispatcherEpoll::hasPendingEvents()
+{
+    extern uint qGlobalPostedEventsCount(); // from qapplication.cpp
+    return qGlobalPostedEventsCount();
+}
+
+int QEventDispatcherEpoll::remainingTime(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::remainingTime: invalid argument");
+        return -1;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.timerRemainingTime(timerId);
+}
+
+void QEventDispatcherEpoll::wakeUp()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->threadPipe.wakeUp();
+}
+
+void QEventDispatcherEpoll::interrupt()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.store(1);
+    wakeUp();
+}
+
+void QEventDispatcherEpoll::flush()
+{ }
+
+QT_END_NAMESPACE
+
+#include "moc_qeventdispatcher_epoll_p.cpp"
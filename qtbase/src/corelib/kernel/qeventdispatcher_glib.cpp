@@ -354,6 +354,11 @@ void QEventDispatcherGlibPrivate::runTimersOnceWithNormalPriority()
     timerSource->runWithIdlePriority = false;
 }
 
+QAbstractEventDispatcher::TimerStatistics QEventDispatcherGlibPrivate::timerStatistics() const
+{
+    return timerSource->timerList.timerStatistics();
+}
+
 QEventDispatcherGlib::QEventDispatcherGlib(QObject *parent)
     : QAbstractEventDispatcher(*(new QEventDispatcherGlibPrivate), parent)
 {
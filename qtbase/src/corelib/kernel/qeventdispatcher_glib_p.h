@@ -110,6 +110,8 @@ public:
     GIdleTimerSource *idleTimerSource;
 
     void runTimersOnceWithNormalPriority();
+
+    QAbstractEventDispatcher::TimerStatistics timerStatistics() const Q_DECL_OVERRIDE;
 };
 
 QT_END_NAMESPACE
@@ -289,6 +289,11 @@ void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
     pollfds.clear();
 }
 
+QAbstractEventDispatcher::TimerStatistics QEventDispatcherUNIXPrivate::timerStatistics() const
+{
+    return timerList.timerStatistics();
+}
+
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
 {
     markPendingSocketNotifiers();
@@ -140,6 +140,8 @@ public:
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+    QAbstractEventDispatcher::TimerStatistics timerStatistics() const Q_DECL_OVERRIDE;
+
     QThreadPipe threadPipe;
     QVector<pollfd> pollfds;
 
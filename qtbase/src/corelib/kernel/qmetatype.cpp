@@ -42,6 +42,7 @@
 #include "qobjectdefs.h"
 #include "qdatetime.h"
 #include "qbytearray.h"
+#include "qhash.h"
 #include "qreadwritelock.h"
 #include "qstring.h"
 #include "qstringlist.h"
@@ -571,9 +572,65 @@ union CheckThatItIsPod
 };
 }
 
+namespace {
+// Maps a type name to the type id (static types) or to the index in
+// customTypes() (custom types). The keys of the static types are raw data
+// pointing into the types[] array.
+typedef QHash<QByteArray, int> QMetaTypeNameHash;
+
+struct QStaticTypeNames : QMetaTypeNameHash
+{
+    QStaticTypeNames()
+    {
+        reserve(int(sizeof(types) / sizeof(types[0])));
+        for (int i = 0; types[i].typeName; ++i) {
+            const QByteArray name = QByteArray::fromRawData(types[i].typeName, types[i].typeNameLength);
+            // first entry wins, like in the linear search
+            if (!contains(name))
+                insert(name, types[i].type);
+        }
+    }
+};
+
+struct QMetaTypeStatistics
+{
+    QMetaTypeStatistics()
+        : enabled(qEnvironmentVariableIsSet("QT_METATYPE_STATISTICS"))
+    { }
+    ~QMetaTypeStatistics()
+    {
+        if (!enabled)
+            return;
+        qDebug("QMetaType statistics: %d types and %d typedefs registered; "
+               "%d name lookups (%d static, %d custom, %d normalized, %d unknown)",
+               registeredTypes.load(), registeredTypedefs.load(), lookups.load(),
+               staticHits.load(), customHits.load(), normalizedLookups.load(), misses.load());
+    }
+
+    const bool enabled;
+    QAtomicInt registeredTypes;
+    QAtomicInt registeredTypedefs;
+    QAtomicInt lookups;
+    QAtomicInt staticHits;
+    QAtomicInt customHits;
+    QAtomicInt normalizedLookups;
+    QAtomicInt misses;
+};
+} // namespace
+
 Q_DECLARE_TYPEINFO(QCustomTypeInfo, Q_MOVABLE_TYPE);
 Q_GLOBAL_STATIC(QVector<QCustomTypeInfo>, customTypes)
+Q_GLOBAL_STATIC(QMetaTypeNameHash, customTypeNames)
 Q_GLOBAL_STATIC(QReadWriteLock, customTypesLock)
+Q_GLOBAL_STATIC(QStaticTypeNames, staticTypeNames)
+Q_GLOBAL_STATIC(QMetaTypeStatistics, metaTypeStatistics)
+
+#define QT_METATYPE_COUNT(counter) \
+    do { \
+        QMetaTypeStatistics *statistics = metaTypeStatistics(); \
+        if (Q_UNLIKELY(statistics && statistics->enabled)) \
+            statistics->counter.ref(); \
+    } while (false)
 Q_GLOBAL_STATIC(QMetaTypeConverterRegistry, customTypesConversionRegistry)
 Q_GLOBAL_STATIC(QMetaTypeComparatorRegistry, customTypesComparatorRegistry)
 Q_GLOBAL_STATIC(QMetaTypeDebugStreamRegistry, customTypesDebugStreamRegistry)
@@ -949,6 +1006,10 @@ const char *QMetaType::typeName(int typeId)
 */
 static inline int qMetaTypeStaticType(const char *typeName, int length)
 {
+    if (const QStaticTypeNames *names = staticTypeNames())
+        return names->value(QByteArray::fromRawData(typeName, length), QMetaType::UnknownType);
+
+    // the hash is already destroyed, fall back to a linear search
     int i = 0;
     while (types[i].typeName && ((length != types[i].typeNameLength)
                                  || memcmp(typeName, types[i].typeName, length))) {
@@ -966,23 +1027,31 @@ static inline int qMetaTypeStaticType(const char *typeName, int length)
 static int qMetaTypeCustomType_unlocked(const char *typeName, int length, int *firstInvalidIndex = 0)
 {
     const QVector<QCustomTypeInfo> * const ct = customTypes();
-    if (!ct)
+    const QMetaTypeNameHash * const names = customTypeNames();
+    if (!ct || !names)
         return QMetaType::UnknownType;
 
-    if (firstInvalidIndex)
+    if (firstInvalidIndex) {
         *firstInvalidIndex = -1;
-    for (int v = 0; v < ct->count(); ++v) {
-        const QCustomTypeInfo &customInfo = ct->at(v);
-        if ((length == customInfo.typeName.size())
-            && !memcmp(typeName, customInfo.typeName.constData(), length)) {
-            if (customInfo.alias >= 0)
-                return customInfo.alias;
-            return v + QMetaType::User;
+        // every valid entry has a unique name, so there are only invalidated
+        // entries to reuse if the hash is smaller than the vector
+        if (names->size() < ct->count()) {
+            for (int v = 0; v < ct->count(); ++v) {
+                if (ct->at(v).typeName.isEmpty()) {
+                    *firstInvalidIndex = v;
+                    break;
+                }
+            }
         }
-        if (firstInvalidIndex && (*firstInvalidIndex < 0) && customInfo.typeName.isEmpty())
-            *firstInvalidIndex = v;
     }
-    return QMetaType::UnknownType;
+
+    const QMetaTypeNameHash::const_iterator it = names->constFind(QByteArray::fromRawData(typeName, length));
+    if (it == names->constEnd())
+        return QMetaType::UnknownType;
+    const QCustomTypeInfo &customInfo = ct->at(it.value());
+    if (customInfo.alias >= 0)
+        return customInfo.alias;
+    return it.value() + QMetaType::User;
 }
 
 /*!
@@ -1024,9 +1093,12 @@ bool QMetaType::unregisterType(int type)
         return false;
 
     // invalidate type and all its alias entries
+    QMetaTypeNameHash *names = customTypeNames();
     for (int v = 0; v < ct->count(); ++v) {
-        if (((v + User) == type) || (ct->at(v).alias == type))
+        if (((v + User) == type) || (ct->at(v).alias == type)) {
+            names->remove(ct->at(v).typeName);
             ct->data()[v].typeName.clear();
+        }
     }
     return true;
 }
@@ -1128,6 +1200,8 @@ int QMetaType::registerNormalizedType(const NS(QByteArray) &normalizedTypeName,
                 idx = posInVector + User;
                 ct->data()[posInVector] = inf;
             }
+            customTypeNames()->insert(inf.typeName, idx - User);
+            QT_METATYPE_COUNT(registeredTypes);
             return idx;
         }
 
@@ -1219,10 +1293,14 @@ int QMetaType::registerNormalizedTypedef(const NS(QByteArray) &normalizedTypeNam
             QCustomTypeInfo inf;
             inf.typeName = normalizedTypeName;
             inf.alias = aliasId;
-            if (posInVector == -1)
+            if (posInVector == -1) {
+                posInVector = ct->size();
                 ct->append(inf);
-            else
+            } else {
                 ct->data()[posInVector] = inf;
+            }
+            customTypeNames()->insert(inf.typeName, posInVector);
+            QT_METATYPE_COUNT(registeredTypedefs);
             return aliasId;
         }
     }
@@ -1262,12 +1340,18 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
 {
     if (!length)
         return QMetaType::UnknownType;
+    QT_METATYPE_COUNT(lookups);
     int type = qMetaTypeStaticType(typeName, length);
-    if (type == QMetaType::UnknownType) {
+    if (type != QMetaType::UnknownType) {
+        QT_METATYPE_COUNT(staticHits);
+    } else {
         QReadLocker locker(customTypesLock());
         type = qMetaTypeCustomType_unlocked(typeName, length);
+        if (type != QMetaType::UnknownType)
+            QT_METATYPE_COUNT(customHits);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
+            QT_METATYPE_COUNT(normalizedLookups);
             const NS(QByteArray) normalizedTypeName = QMetaObject::normalizedType(typeName);
             type = qMetaTypeStaticType(normalizedTypeName.constData(),
                                        normalizedTypeName.size());
@@ -1277,6 +1361,8 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
             }
         }
 #endif
+        if (type == QMetaType::UnknownType)
+            QT_METATYPE_COUNT(misses);
     }
     return type;
 }
@@ -62,6 +62,7 @@
 
 #include <private/qorderedmutexlocker_p.h>
 #include <private/qhooks_p.h>
+#include <private/qobjectarena_p.h>
 
 #include <new>
 
@@ -233,6 +234,19 @@ QObjectPrivate::QObjectPrivate(int version)
     deleteLaterCalled = false;
 }
 
+void *QObjectPrivate::operator new(size_t size)
+{
+    if (QObjectArena *arena = QObjectArena::current())
+        return arena->allocate(size);
+    return ::operator new(size);
+}
+
+void QObjectPrivate::operator delete(void *ptr)
+{
+    if (!QObjectArena::deallocate(ptr))
+        ::operator delete(ptr);
+}
+
 QObjectPrivate::~QObjectPrivate()
 {
     if (extraData && !extraData->runningTimers.isEmpty()) {
@@ -3653,10 +3667,9 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
     }
 
     void *empty_argv[] = { 0 };
-    if (qt_signal_spy_callback_set.signal_begin_callback != 0) {
-        qt_signal_spy_callback_set.signal_begin_callback(sender, signal_index,
-                                                         argv ? argv : empty_argv);
-    }
+    void ** const args = argv ? argv : empty_argv;
+    if (qt_signal_spy_callback_set.signal_begin_callback != 0)
+        qt_signal_spy_callback_set.signal_begin_callback(sender, signal_index, args);
 
     {
     QMutexLocker locker(signalSlotLock(sender));
@@ -3667,7 +3680,10 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
             if (connectionLists)
                 ++connectionLists->inUse;
         }
-        ~ConnectionListsRef()
+        ~ConnectionListsRef() { release(); }
+
+        // must be called with the signalSlotLock held
+        void release()
         {
             if (!connectionLists)
                 return;
@@ -3678,6 +3694,7 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
                 if (!connectionLists->inUse)
                     delete connectionLists;
             }
+            connectionLists = 0;
         }
 
         QObjectConnectionListVector *operator->() const { return connectionLists; }
@@ -3710,13 +3727,17 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
                 continue;
 
             QObject * const receiver = c->receiver;
+            // When this is the last connection to be activated, the connection lists can be
+            // released before calling the slot, which saves relocking the mutex afterwards.
+            const bool lastConnection = c == last
+                    && (list == &connectionLists->allsignals || !connectionLists->allsignals.first);
             const bool receiverInSameThread = currentThreadId == receiver->d_func()->threadData->threadId.load();
 
             // determine if this connection should be sent immediately or
             // put into the event queue
             if ((c->connectionType == Qt::AutoConnection && !receiverInSameThread)
                 || (c->connectionType == Qt::QueuedConnection)) {
-                queued_activate(sender, signal_index, c, argv ? argv : empty_argv, locker);
+                queued_activate(sender, signal_index, c, args, locker);
                 continue;
 #ifndef QT_NO_THREAD
             } else if (c->connectionType == Qt::BlockingQueuedConnection) {
@@ -3728,8 +3749,8 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
                 }
                 QSemaphore semaphore;
                 QMetaCallEvent *ev = c->isSlotObject ?
-                    new QMetaCallEvent(c->slotObj, sender, signal_index, 0, 0, argv ? argv : empty_argv, &semaphore) :
-                    new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal_index, 0, 0, argv ? argv : empty_argv, &semaphore);
+                    new QMetaCallEvent(c->slotObj, sender, signal_index, 0, 0, args, &semaphore) :
+                    new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal_index, 0, 0, args, &semaphore);
                 QCoreApplication::postEvent(receiver, ev);
                 locker.unlock();
                 semaphore.acquire();
@@ -3746,52 +3767,54 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
             if (c->isSlotObject) {
                 c->slotObj->ref();
                 QScopedPointer<QtPrivate::QSlotObjectBase, QSlotObjectBaseDeleter> obj(c->slotObj);
+                if (lastConnection)
+                    connectionLists.release();
                 locker.unlock();
-                obj->call(receiver, argv ? argv : empty_argv);
+                obj->call(receiver, args);
 
                 // Make sure the slot object gets destroyed before the mutex is locked again, as the
                 // destructor of the slot object might also lock a mutex from the signalSlotLock() mutex pool,
                 // and that would deadlock if the pool happens to return the same mutex.
                 obj.reset();
-
-                locker.relock();
             } else if (c->callFunction && c->method_offset <= receiver->metaObject()->methodOffset()) {
                 //we compare the vtable to make sure we are not in the destructor of the object.
                 const int methodIndex = c->method();
                 const int method_relative = c->method_relative;
                 const auto callFunction = c->callFunction;
+                if (lastConnection)
+                    connectionLists.release();
                 locker.unlock();
                 if (qt_signal_spy_callback_set.slot_begin_callback != 0)
-                    qt_signal_spy_callback_set.slot_begin_callback(receiver, methodIndex, argv ? argv : empty_argv);
+                    qt_signal_spy_callback_set.slot_begin_callback(receiver, methodIndex, args);
 
-                callFunction(receiver, QMetaObject::InvokeMetaMethod, method_relative, argv ? argv : empty_argv);
+                callFunction(receiver, QMetaObject::InvokeMetaMethod, method_relative, args);
 
                 if (qt_signal_spy_callback_set.slot_end_callback != 0)
                     qt_signal_spy_callback_set.slot_end_callback(receiver, methodIndex);
-                locker.relock();
             } else {
                 const int method = c->method_relative + c->method_offset;
+                if (lastConnection)
+                    connectionLists.release();
                 locker.unlock();
 
-                if (qt_signal_spy_callback_set.slot_begin_callback != 0) {
-                    qt_signal_spy_callback_set.slot_begin_callback(receiver,
-                                                                method,
-                                                                argv ? argv : empty_argv);
-                }
+                if (qt_signal_spy_callback_set.slot_begin_callback != 0)
+                    qt_signal_spy_callback_set.slot_begin_callback(receiver, method, args);
 
-                metacall(receiver, QMetaObject::InvokeMetaMethod, method, argv ? argv : empty_argv);
+                metacall(receiver, QMetaObject::InvokeMetaMethod, method, args);
 
                 if (qt_signal_spy_callback_set.slot_end_callback != 0)
                     qt_signal_spy_callback_set.slot_end_callback(receiver, method);
-
-                locker.relock();
             }
 
+            if (lastConnection)
+                break;
+
+            locker.relock();
             if (connectionLists->orphaned)
                 break;
         } while (c != last && (c = c->nextConnectionList) != 0);
 
-        if (connectionLists->orphaned)
+        if (!connectionLists.connectionLists || connectionLists->orphaned)
             break;
     } while (list != &connectionLists->allsignals &&
         //start over for all signals;
@@ -175,6 +175,12 @@ public:
 
     QObjectPrivate(int version = QObjectPrivateVersion);
     virtual ~QObjectPrivate();
+
+    // d-pointers are placed into the current QObjectArena, if any
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
+    static void *operator new(size_t, void *ptr) Q_DECL_NOTHROW { return ptr; }
+    static void operator delete(void *, void *) Q_DECL_NOTHROW { }
     void deleteChildren();
 
     void setParent_helper(QObject *);
@@ -0,0 +1,258 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Copyright (C) 2018 The Qt Company Ltd.
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+
+#include "qobjectarena_p.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+#include <private/qthread_p.h>
+
+#include <algorithm>
+#include <new>
+#include <stdlib.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QObjectArena
+    \inmodule QtCore
+    \internal
+
+    \brief The QObjectArena class places the private data of QObjects
+    created on the current thread into contiguous memory blocks.
+
+    While a QObjectArena exists, the d-pointers (QObjectPrivate and its
+    subclasses) of all QObjects created on the thread that created the arena
+    are allocated from blocks owned by the arena instead of the global heap.
+    This is meant for code that creates large object trees in one go, such as
+    the QML object creator:
+
+    \code
+    {
+        QObjectArena arena;
+        createObjectTree();
+    }
+    \endcode
+
+    Arenas nest; the innermost one is used. Objects may outlive the arena and
+    may be destroyed from any thread. A block is returned to the heap once the
+    arena has moved on to the next block (or was destroyed) and all objects
+    placed in it have been deleted, so destroying a tree releases its memory
+    in a few large chunks.
+*/
+
+namespace {
+enum {
+    Alignment = 16,
+    // allocations bigger than this go to the heap to avoid wasting blocks
+    MaximumAllocationFraction = 4
+};
+
+inline size_t alignedSize(size_t size)
+{
+    return (size + Alignment - 1) & ~size_t(Alignment - 1);
+}
+}
+
+struct QObjectArena::Block
+{
+    QAtomicInt ref;     // one for the arena using it, plus one per allocation
+    char *end;
+
+    enum { HeaderSize = (sizeof(QAtomicInt) + sizeof(char *) + Alignment - 1) & ~(Alignment - 1) };
+    char *begin() { return reinterpret_cast<char *>(this) + HeaderSize; }
+};
+
+namespace {
+typedef QObjectArena::Block Block;
+
+/*
+    The sorted list of all blocks that are alive, used to find out whether a
+    pointer passed to QObjectPrivate::operator delete comes from an arena.
+    It is plain old data so that it is usable until the very end of the
+    process, and liveBlocks allows deallocate() to skip the lookup entirely
+    in processes not using arenas.
+*/
+struct BlockRegistry
+{
+    Block **blocks;
+    int count;
+    int capacity;
+};
+BlockRegistry registry = { nullptr, 0, 0 };
+QBasicMutex registryMutex;
+QBasicAtomicInt liveBlocks = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+bool blockLessThan(const Block *block, const void *ptr)
+{
+    return reinterpret_cast<const void *>(block) < ptr;
+}
+
+void registerBlock(Block *block)
+{
+    QMutexLocker locker(&registryMutex);
+    if (registry.count == registry.capacity) {
+        const int capacity = registry.capacity ? registry.capacity * 2 : 16;
+        Block **blocks = static_cast<Block **>(realloc(registry.blocks, capacity * sizeof(Block *)));
+        Q_CHECK_PTR(blocks);
+        registry.blocks = blocks;
+        registry.capacity = capacity;
+    }
+    Block **end = registry.blocks + registry.count;
+    Block **pos = std::lower_bound(registry.blocks, end, block, blockLessThan);
+    std::copy_backward(pos, end, end + 1);
+    *pos = block;
+    ++registry.count;
+    liveBlocks.ref();
+}
+
+void unregisterBlock(Block *block)
+{
+    QMutexLocker locker(&registryMutex);
+    Block **end = registry.blocks + registry.count;
+    Block **pos = std::lower_bound(registry.blocks, end, block, blockLessThan);
+    Q_ASSERT(pos != end && *pos == block);
+    std::copy(pos + 1, end, pos);
+    --registry.count;
+    liveBlocks.deref();
+}
+
+Block *findBlock(void *ptr)
+{
+    QMutexLocker locker(&registryMutex);
+    Block **end = registry.blocks + registry.count;
+    // the last block starting before ptr is the only candidate
+    Block **pos = std::lower_bound(registry.blocks, end, ptr, blockLessThan);
+    if (pos == registry.blocks)
+        return nullptr;
+    Block *block = *(pos - 1);
+    return ptr < reinterpret_cast<void *>(block->end) ? block : nullptr;
+}
+
+void releaseBlock(Block *block)
+{
+    if (block && !block->ref.deref()) {
+        unregisterBlock(block);
+        block->~Block();
+        ::operator delete(block);
+    }
+}
+} // unnamed namespace
+
+/*!
+    Constructs an arena which allocates memory in blocks of \a blockSize
+    bytes, and makes it the current arena of the calling thread.
+*/
+QObjectArena::QObjectArena(int blockSize)
+    : m_threadData(QThreadData::current()),
+      m_previous(m_threadData->objectArena),
+      m_block(nullptr),
+      m_next(nullptr),
+      m_blockSize(alignedSize(qMax(blockSize, int(Block::HeaderSize) + 1024)))
+{
+    m_threadData->objectArena = this;
+}
+
+/*!
+    Restores the previous arena of the thread. Memory still used by objects
+    created while this arena was current is released when they are deleted.
+*/
+QObjectArena::~QObjectArena()
+{
+    Q_ASSERT_X(m_threadData->objectArena == this, "QObjectArena",
+               "arenas must be destroyed in reverse order of creation");
+    m_threadData->objectArena = m_previous;
+    releaseBlock(m_block);
+}
+
+/*!
+    Returns the current arena of the calling thread, or \c nullptr if there
+    is none.
+*/
+QObjectArena *QObjectArena::current()
+{
+    QThreadData *data = QThreadData::current(false);
+    return data ? data->objectArena : nullptr;
+}
+
+/*!
+    Returns \a size bytes of memory, aligned for any type. Big allocations
+    are served from the heap.
+*/
+void *QObjectArena::allocate(size_t size)
+{
+    size = alignedSize(size);
+    if (size > (m_blockSize - Block::HeaderSize) / MaximumAllocationFraction)
+        return ::operator new(size);
+
+    if (!m_block || m_next + size > m_block->end) {
+        releaseBlock(m_block);
+        void *memory = ::operator new(m_blockSize);
+        m_block = new (memory) Block;
+        m_block->ref.store(1);
+        m_block->end = static_cast<char *>(memory) + m_blockSize;
+        m_next = m_block->begin();
+        registerBlock(m_block);
+    }
+
+    m_block->ref.ref();
+    void *ptr = m_next;
+    m_next += size;
+    return ptr;
+}
+
+/*!
+    Releases \a ptr if it was allocated from an arena and returns \c true;
+    otherwise returns \c false and the caller must free \a ptr itself. This
+    function can be called from any thread.
+*/
+bool QObjectArena::deallocate(void *ptr)
+{
+    if (!ptr || !liveBlocks.loadAcquire())
+        return false;
+
+    Block *block = findBlock(ptr);
+    if (!block)
+        return false;
+    releaseBlock(block);
+    return true;
+}
+
+QT_END_NAMESPACE
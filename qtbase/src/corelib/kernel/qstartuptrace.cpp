@@ -0,0 +1,150 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qstartuptrace_p.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+
+#include <stdio.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QStartupTrace
+    \inmodule QtCore
+    \internal
+
+    \brief Records the timing of application startup phases.
+
+    If the environment variable \c QT_STARTUP_TRACE names a file, the begin
+    and end of selected startup phases are written to it in the Chrome trace
+    event format. The file can be loaded into chrome://tracing or similar
+    viewers; the closing bracket of the event array is left out, which those
+    viewers accept, so that the file stays usable if the application crashes.
+
+    If the variable is not set, all functions return after checking a single
+    flag.
+*/
+
+namespace {
+struct QStartupTracePrivate
+{
+    QStartupTracePrivate()
+        : file(nullptr)
+    {
+        const QByteArray fileName = qgetenv("QT_STARTUP_TRACE");
+        if (fileName.isEmpty())
+            return;
+        file = fopen(fileName.constData(), "w");
+        if (!file) {
+            qWarning("QStartupTrace: Cannot open %s for writing", fileName.constData());
+            return;
+        }
+        fputs("[\n", file);
+        timer.start();
+    }
+
+    ~QStartupTracePrivate()
+    {
+        if (file)
+            fclose(file);
+    }
+
+    void write(const char *phase, char type)
+    {
+        const qint64 ts = timer.nsecsElapsed() / 1000;
+        QMutexLocker locker(&mutex);
+        fprintf(file, "{\"name\":\"%s\",\"cat\":\"qt\",\"ph\":\"%c\",\"ts\":%lld,\"pid\":%lld,\"tid\":%llu%s},\n",
+                phase, type, ts, QCoreApplication::applicationPid(),
+                quint64(quintptr(QThread::currentThreadId())),
+                type == 'i' ? ",\"s\":\"p\"" : "");
+        fflush(file);
+    }
+
+    FILE *file;
+    QElapsedTimer timer;
+    QBasicMutex mutex;
+};
+}
+
+Q_GLOBAL_STATIC(QStartupTracePrivate, startupTrace)
+
+/*!
+    Returns \c true if startup tracing was requested with \c QT_STARTUP_TRACE.
+*/
+bool QStartupTrace::isEnabled()
+{
+    QStartupTracePrivate *d = startupTrace();
+    return d && d->file;
+}
+
+/*!
+    Records the begin of \a phase. Every begin() must be matched by an end()
+    for the same \a phase on the same thread.
+
+    \sa QStartupTraceScope
+*/
+void QStartupTrace::begin(const char *phase)
+{
+    if (isEnabled())
+        startupTrace()->write(phase, 'B');
+}
+
+/*!
+    Records the end of \a phase.
+*/
+void QStartupTrace::end(const char *phase)
+{
+    if (isEnabled())
+        startupTrace()->write(phase, 'E');
+}
+
+/*!
+    Records that the point \a phase has been reached.
+*/
+void QStartupTrace::mark(const char *phase)
+{
+    if (isEnabled())
+        startupTrace()->write(phase, 'i');
+}
+
+QT_END_NAMESPACE
@@ -53,6 +53,8 @@
 
 #include <sys/times.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
@@ -174,18 +176,47 @@ void QTimerInfoList::repairTimersIfNeeded()
 
 #endif
 
+static inline bool timeoutLessThan(const QTimerInfo *t1, const QTimerInfo *t2)
+{
+    return t1->timeout < t2->timeout;
+}
+
 /*
-  insert timer info into list
+  insert timer info into list, after all timers with the same timeout
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
-            break;
+    const_iterator it = std::upper_bound(constBegin(), constEnd(), ti, timeoutLessThan);
+    insert(int(it - constBegin()), ti);
+}
+
+/*
+  find the position of a timer in the list, or -1
+*/
+int QTimerInfoList::timerIndex(const QTimerInfo *t) const
+{
+    const_iterator it = std::lower_bound(constBegin(), constEnd(), t, timeoutLessThan);
+    for ( ; it != constEnd() && !(t->timeout < (*it)->timeout); ++it) {
+        if (*it == t)
+            return int(it - constBegin());
     }
-    insert(index+1, ti);
+    return -1;
+}
+
+/*
+  remove timer info from the list and delete it
+*/
+void QTimerInfoList::timerRemove(QTimerInfo *t)
+{
+    const int index = timerIndex(t);
+    Q_ASSERT(index != -1);
+    removeAt(index);
+    timersById.remove(t->id);
+    if (t == firstTimerInfo)
+        firstTimerInfo = 0;
+    if (t->activateRef)
+        *(t->activateRef) = 0;
+    delete t;
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -423,16 +454,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timersById.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -494,6 +522,7 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
     }
 
     timerInsert(t);
+    timersById.insert(timerId, t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -507,22 +536,15 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
-    // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t->activateRef)
-                *(t->activateRef) = 0;
-            delete t;
-            return true;
-        }
+    QTimerInfo *t = timersById.value(timerId);
+    if (!t) {
+        // id not found
+        return false;
     }
-    // id not found
-    return false;
+
+    // set timer inactive
+    timerRemove(t);
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
@@ -534,6 +556,7 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
         if (t->obj == object) {
             // object found
             removeAt(i);
+            timersById.remove(t->id);
             if (t == firstTimerInfo)
                 firstTimerInfo = 0;
             if (t->activateRef)
@@ -571,6 +594,7 @@ int QTimerInfoList::activateTimers()
         return 0; // nothing to do
 
     int n_act = 0, maxCount = 0;
+    bool firedAny = false;
     firstTimerInfo = 0;
 
     timespec currentTime = updateCurrentTime();
@@ -607,6 +631,16 @@ int QTimerInfoList::activateTimers()
         // remove from list
         removeFirst();
 
+        const qint64 slack = qint64(currentTime.tv_sec - currentTimerInfo->timeout.tv_sec) * 1000000
+                + (currentTime.tv_nsec - currentTimerInfo->timeout.tv_nsec) / 1000;
+        statistics.totalSlack += slack;
+        statistics.maximumSlack = qMax(statistics.maximumSlack, slack);
+        ++statistics.activations;
+        if (!firedAny) {
+            firedAny = true;
+            ++statistics.wakeUps;
+        }
+
 #ifdef QTIMERINFO_DEBUG
         float diff;
         if (currentTime < currentTimerInfo->expected) {
@@ -652,4 +686,11 @@ int QTimerInfoList::activateTimers()
     return n_act;
 }
 
+QAbstractEventDispatcher::TimerStatistics QTimerInfoList::timerStatistics() const
+{
+    QAbstractEventDispatcher::TimerStatistics result = statistics;
+    result.registeredTimers = size();
+    return result;
+}
+
 QT_END_NAMESPACE
@@ -56,6 +56,7 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -92,6 +93,13 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
+    // all registered timers by id; the list itself is sorted by timeout
+    QHash<int, QTimerInfo *> timersById;
+    QAbstractEventDispatcher::TimerStatistics statistics;
+
+    int timerIndex(const QTimerInfo *t) const;
+    void timerRemove(QTimerInfo *t);
+
 public:
     QTimerInfoList();
 
@@ -112,6 +120,8 @@ public:
     QList<QAbstractEventDispatcher::TimerInfo> registeredTimers(QObject *object) const;
 
     int activateTimers();
+
+    QAbstractEventDispatcher::TimerStatistics timerStatistics() const;
 };
 
 QT_END_NAMESPACE
@@ -56,6 +56,7 @@
 #include "qlocale.h"
 #include "qendian.h"
 #include "qresource.h"
+#include "qvector.h"
 
 #if defined(Q_OS_UNIX) && !defined(Q_OS_INTEGRITY)
 #define QT_USE_MMAP
@@ -295,7 +296,8 @@ public:
 #endif
           unmapPointer(0), unmapLength(0), resource(0),
           messageArray(0), offsetArray(0), contextArray(0), numerusRulesArray(0),
-          messageLength(0), offsetLength(0), contextLength(0), numerusRulesLength(0) {}
+          messageLength(0), offsetLength(0), contextLength(0), numerusRulesLength(0),
+          hashBucketShift(32) {}
 
 #if defined(QT_USE_MMAP)
     bool used_mmap : 1;
@@ -320,6 +322,14 @@ public:
     uint contextLength;
     uint numerusRulesLength;
 
+    // hashBuckets[b] is the index of the first entry in offsetArray whose hash
+    // has b as its top (32 - hashBucketShift) bits; empty for small catalogs.
+    QVector<quint32> hashBuckets;
+    int hashBucketShift;
+
+    void buildHashBuckets();
+    const uchar *findHash(quint32 h) const;
+
     bool do_load(const QString &filename, const QString &directory);
     bool do_load(const uchar *data, int len, const QString &directory);
     QString do_translate(const char *context, const char *sourceText, const char *comment,
@@ -888,11 +898,106 @@ bool QTranslatorPrivate::do_load(const uchar *data, int len, const QString &dire
         contextLength = 0;
         offsetLength = 0;
         numerusRulesLength = 0;
+    } else {
+        buildHashBuckets();
     }
 
     return ok;
 }
 
+/*
+    The hash table of a .qm file is sorted by hash. Instead of doing a
+    binary search over it for every translate() call, split the hash range
+    into buckets of about two entries each and remember where each bucket
+    starts. A lookup then only needs to compare the few entries of one bucket.
+    The offsets are the only data copied out of the (usually memory-mapped)
+    file.
+*/
+void QTranslatorPrivate::buildHashBuckets()
+{
+    enum { MinimumBucketedItems = 64, MaximumBucketBits = 16 };
+
+    hashBuckets.clear();
+    hashBucketShift = 32;
+
+    const quint32 numItems = offsetLength / (2 * sizeof(quint32));
+    if (numItems < MinimumBucketedItems)
+        return;
+
+    int bits = 1;
+    while (bits < MaximumBucketBits && (quint32(2) << bits) <= numItems)
+        ++bits;
+    hashBucketShift = 32 - bits;
+
+    const quint32 bucketCount = quint32(1) << bits;
+    hashBuckets.resize(bucketCount + 1);
+    quint32 *buckets = hashBuckets.data();
+    quint32 item = 0;
+    quint32 previousHash = 0;
+    for (quint32 b = 0; b < bucketCount; ++b) {
+        while (item < numItems) {
+            const quint32 hash = read32(offsetArray + (item << 3));
+            if (Q_UNLIKELY(hash < previousHash)) {
+                // not sorted, keep using the binary search
+                hashBuckets.clear();
+                hashBucketShift = 32;
+                return;
+            }
+            previousHash = hash;
+            if ((hash >> hashBucketShift) >= b)
+                break;
+            ++item;
+        }
+        buckets[b] = item;
+    }
+    buckets[bucketCount] = numItems;
+}
+
+/*
+    Returns a pointer to the first entry of offsetArray with the hash \a h,
+    or null if there is none.
+*/
+const uchar *QTranslatorPrivate::findHash(quint32 h) const
+{
+    if (!hashBuckets.isEmpty()) {
+        const quint32 b = h >> hashBucketShift;
+        const uchar *entry = offsetArray + (hashBuckets.at(b) << 3);
+        const uchar *bucketEnd = offsetArray + (hashBuckets.at(b + 1) << 3);
+        for (; entry < bucketEnd; entry += 8) {
+            const quint32 hash = read32(entry);
+            if (hash == h)
+                return entry;
+            if (hash > h)
+                break;
+        }
+        return 0;
+    }
+
+    const size_t numItems = offsetLength / (2 * sizeof(quint32));
+    const uchar *start = offsetArray;
+    const uchar *end = start + ((numItems-1) << 3);
+    while (start <= end) {
+        const uchar *middle = start + (((end - start) >> 4) << 3);
+        uint hash = read32(middle);
+        if (h == hash) {
+            start = middle;
+            break;
+        } else if (hash < h) {
+            start = middle + 8;
+        } else {
+            end = middle - 8;
+        }
+    }
+
+    if (start > end)
+        return 0;
+
+    // go back on equal key
+    while (start != offsetArray && read32(start) == read32(start-8))
+        start -= 8;
+    return start;
+}
+
 static QString getMessage(const uchar *m, const uchar *end, const char *context,
                           const char *sourceText, const char *comment, uint numerus)
 {
@@ -1017,26 +1122,7 @@ QString QTranslatorPrivate::do_translate(const char *context, const char *source
         elfHash_continue(comment, h);
         elfHash_finish(h);
 
-        const uchar *start = offsetArray;
-        const uchar *end = start + ((numItems-1) << 3);
-        while (start <= end) {
-            const uchar *middle = start + (((end - start) >> 4) << 3);
-            uint hash = read32(middle);
-            if (h == hash) {
-                start = middle;
-                break;
-            } else if (hash < h) {
-                start = middle + 8;
-            } else {
-                end = middle - 8;
-            }
-        }
-
-        if (start <= end) {
-            // go back on equal key
-            while (start != offsetArray && read32(start) == read32(start-8))
-                start -= 8;
-
+        if (const uchar *start = findHash(h)) {
             while (start < offsetArray + offsetLength) {
                 quint32 rh = read32(start);
                 start += 4;
@@ -1096,6 +1182,8 @@ void QTranslatorPrivate::clear()
     contextLength = 0;
     offsetLength = 0;
     numerusRulesLength = 0;
+    hashBuckets.clear();
+    hashBucketShift = 32;
 
     qDeleteAll(subTranslators);
     subTranslators.clear();
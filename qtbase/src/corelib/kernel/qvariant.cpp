@@ -1149,6 +1149,14 @@ const QVariant::Handler qt_dummy_variant_handler = {
 #endif
 };
 
+// Custom types that do not fit into QVariant::Private::Data are stored right
+// behind their QVariant::PrivateShared, in a single allocation.
+union CustomDataAlignment { long double ld; double d; qint64 i; void *p; };
+enum {
+    CustomDataOffset = (sizeof(QVariant::PrivateShared) + Q_ALIGNOF(CustomDataAlignment) - 1)
+                       & ~(Q_ALIGNOF(CustomDataAlignment) - 1)
+};
+
 static void customConstruct(QVariant::Private *d, const void *copy)
 {
     const QMetaType type(d->type);
@@ -1165,9 +1173,11 @@ static void customConstruct(QVariant::Private *d, const void *copy)
         type.construct(&d->data.ptr, copy);
         d->is_shared = false;
     } else {
-        void *ptr = type.create(copy);
+        void *block = operator new(CustomDataOffset + size);
+        void *ptr = static_cast<char *>(block) + CustomDataOffset;
+        type.construct(ptr, copy);
         d->is_shared = true;
-        d->data.shared = new QVariant::PrivateShared(ptr);
+        d->data.shared = new (block) QVariant::PrivateShared(ptr);
     }
 }
 
@@ -1176,8 +1186,9 @@ static void customClear(QVariant::Private *d)
     if (!d->is_shared) {
         QMetaType::destruct(d->type, &d->data.ptr);
     } else {
-        QMetaType::destroy(d->type, d->data.shared->ptr);
-        delete d->data.shared;
+        // allocated by customConstruct(), PrivateShared is trivially destructible
+        QMetaType::destruct(d->type, d->data.shared->ptr);
+        operator delete(d->data.shared);
     }
 }
 
@@ -49,6 +49,7 @@
 #include "qpluginloader.h"
 #include "private/qobject_p.h"
 #include "private/qcoreapplication_p.h"
+#include "private/qstartuptrace_p.h"
 #include "qjsondocument.h"
 #include "qjsonvalue.h"
 #include "qjsonobject.h"
@@ -91,6 +92,7 @@ QFactoryLoaderPrivate::~QFactoryLoaderPrivate()
 void QFactoryLoader::update()
 {
 #ifdef QT_SHARED
+    QStartupTraceScope trace("QFactoryLoader::update");
     Q_D(QFactoryLoader);
     QStringList paths = QCoreApplication::libraryPaths();
     for (int i = 0; i < paths.count(); ++i) {
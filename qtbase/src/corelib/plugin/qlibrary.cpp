@@ -63,6 +63,7 @@
 #include <qjsonvalue.h>
 #include "qelfparser_p.h"
 #include "qmachparser_p.h"
+#include "qpluginmetadatacache_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -729,8 +730,10 @@ void QLibraryPrivate::updatePluginState()
 #endif
 
     if (!pHnd) {
+        // use the directory's metadata cache if it is up to date, otherwise
         // scan for the plugin metadata without loading
-        success = findPatternUnloaded(fileName, this);
+        success = QPluginMetaDataCache::lookup(fileName, &metaData)
+                || findPatternUnloaded(fileName, this);
     } else {
         // library is already loaded (probably via QLibrary)
         // simply get the target function and call it.
@@ -0,0 +1,249 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qpluginmetadatacache_p.h"
+
+#include "qlibrary_p.h"
+#include <qdatetime.h>
+#include <qdebug.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qhash.h>
+#include <qjsondocument.h>
+#include <qmutex.h>
+#ifndef QT_NO_TEMPORARYFILE
+#include <qsavefile.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The cache is a binary JSON document stored in each plugin directory:
+
+    {
+        "version": 1,
+        "plugins": {
+            "<file name>": {
+                "size": <file size in bytes>,
+                "lastModified": <modification time, ms since epoch>,
+                "metaData": <the plugin's meta data object>
+            }, ...
+        }
+    }
+
+    An entry is only used while the plugin's size and modification time
+    still match, so a stale cache costs a scan of the changed plugins, not
+    wrong meta data.
+*/
+static const int CacheVersion = 1;
+
+namespace {
+class QPluginMetaDataCacheStore
+{
+public:
+    QJsonObject plugins(const QString &directory);
+    void invalidate(const QString &directory);
+
+private:
+    QMutex mutex;
+    // plugin entries of every directory looked at, empty if it has no cache
+    QHash<QString, QJsonObject> directories;
+};
+}
+
+Q_GLOBAL_STATIC(QPluginMetaDataCacheStore, qt_plugin_metadata_cache)
+
+static QJsonObject readCacheFile(const QString &directory)
+{
+    QFile file(QPluginMetaDataCache::cacheFilePath(directory));
+    if (!file.open(QIODevice::ReadOnly))
+        return QJsonObject();
+
+    // fromBinaryData() copies, so the mapping is not needed afterwards
+    QJsonDocument doc;
+    const qint64 size = file.size();
+    if (uchar *data = file.map(0, size)) {
+        doc = QJsonDocument::fromBinaryData(QByteArray::fromRawData(reinterpret_cast<const char *>(data), int(size)));
+        file.unmap(data);
+    } else {
+        doc = QJsonDocument::fromBinaryData(file.readAll());
+    }
+
+    const QJsonObject root = doc.object();
+    if (root.value(QLatin1String("version")).toInt() != CacheVersion) {
+        if (qt_debug_component())
+            qWarning("QPluginMetaDataCache: ignoring invalid cache file %s", qPrintable(file.fileName()));
+        return QJsonObject();
+    }
+    return root.value(QLatin1String("plugins")).toObject();
+}
+
+QJsonObject QPluginMetaDataCacheStore::plugins(const QString &directory)
+{
+    QMutexLocker locker(&mutex);
+    QHash<QString, QJsonObject>::const_iterator it = directories.constFind(directory);
+    if (it == directories.constEnd())
+        it = directories.insert(directory, readCacheFile(directory));
+    return it.value();
+}
+
+void QPluginMetaDataCacheStore::invalidate(const QString &directory)
+{
+    QMutexLocker locker(&mutex);
+    directories.remove(directory);
+}
+
+static QJsonObject cacheEntry(const QFileInfo &info, const QJsonObject &metaData)
+{
+    QJsonObject entry;
+    entry.insert(QLatin1String("size"), double(info.size()));
+    entry.insert(QLatin1String("lastModified"), double(info.lastModified().toMSecsSinceEpoch()));
+    entry.insert(QLatin1String("metaData"), metaData);
+    return entry;
+}
+
+/*!
+    \internal
+
+    Returns the path of the meta data cache file for the plugins in \a directory.
+*/
+QString QPluginMetaDataCache::cacheFilePath(const QString &directory)
+{
+    return directory + QLatin1String("/.qtplugincache");
+}
+
+/*!
+    \internal
+
+    Looks up the meta data of the plugin \a fileName in the cache of its
+    directory. Returns \c true and sets \a metaData if the cache has an
+    entry for the file that is still up to date; otherwise returns \c false
+    and the plugin has to be scanned.
+*/
+bool QPluginMetaDataCache::lookup(const QString &fileName, QJsonObject *metaData)
+{
+    const QFileInfo info(fileName);
+    const QJsonObject plugins = qt_plugin_metadata_cache()->plugins(info.absolutePath());
+    if (plugins.isEmpty())
+        return false;
+
+    const QJsonObject entry = plugins.value(info.fileName()).toObject();
+    if (entry.isEmpty()
+        || qint64(entry.value(QLatin1String("size")).toDouble()) != info.size()
+        || qint64(entry.value(QLatin1String("lastModified")).toDouble()) != info.lastModified().toMSecsSinceEpoch()) {
+        if (qt_debug_component())
+            qDebug() << "QPluginMetaDataCache: no up-to-date cache entry for" << fileName;
+        return false;
+    }
+
+    const QJsonObject cached = entry.value(QLatin1String("metaData")).toObject();
+    if (cached.isEmpty())
+        return false;
+    *metaData = cached;
+    return true;
+}
+
+/*!
+    \internal
+
+    Scans all plugins in \a directory and writes their meta data to the
+    directory's cache file, replacing an existing one. Files that are not
+    plugins are left out. Returns \c false and sets \a errorString if the
+    cache could not be written.
+
+    Plugins are keyed by file name, so a plugin whose canonical path lies
+    in another directory (through a symbolic link) is still scanned at run
+    time.
+*/
+bool QPluginMetaDataCache::generate(const QString &directory, QString *errorString)
+{
+    const QDir dir(directory);
+    if (!dir.exists()) {
+        *errorString = QLibrary::tr("The directory '%1' does not exist.").arg(directory);
+        return false;
+    }
+    const QString path = dir.absolutePath();
+
+    QJsonObject plugins;
+    const QStringList files = dir.entryList(
+#ifdef Q_OS_WIN
+                QStringList(QStringLiteral("*.dll")),
+#endif
+                QDir::Files);
+    for (const QString &file : files) {
+        const QFileInfo info(dir.absoluteFilePath(file));
+        QLibraryPrivate *library = QLibraryPrivate::findOrCreate(info.canonicalFilePath());
+        // Also keep plugins built for another Qt version: the version
+        // check is done on the meta data, cached or not
+        library->isPlugin();
+        if (!library->metaData.isEmpty())
+            plugins.insert(file, cacheEntry(info, library->metaData));
+        library->release();
+    }
+
+    QJsonObject root;
+    root.insert(QLatin1String("version"), CacheVersion);
+    root.insert(QLatin1String("plugins"), plugins);
+    const QByteArray data = QJsonDocument(root).toBinaryData();
+
+#ifndef QT_NO_TEMPORARYFILE
+    QSaveFile file(cacheFilePath(path));
+#else
+    QFile file(cacheFilePath(path));
+#endif
+    bool ok = file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+#ifndef QT_NO_TEMPORARYFILE
+    ok = ok && file.commit();
+#else
+    file.close();
+    ok = ok && file.error() == QFile::NoError;
+#endif
+    if (!ok) {
+        *errorString = QLibrary::tr("Cannot write plugin cache '%1': %2")
+                .arg(file.fileName(), file.errorString());
+        return false;
+    }
+
+    qt_plugin_metadata_cache()->invalidate(dir.canonicalPath());
+    return true;
+}
+
+QT_END_NAMESPACE
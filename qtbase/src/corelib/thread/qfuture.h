@@ -47,6 +47,9 @@
 #include <QtCore/qfutureinterface.h>
 #include <QtCore/qstring.h>
 
+#include <type_traits>
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -55,6 +58,92 @@ class QFutureWatcher;
 template <>
 class QFutureWatcher<void>;
 
+namespace QtPrivate {
+
+template <typename Function, typename T>
+struct ContinuationResult
+{
+    typedef typename std::decay<decltype(std::declval<Function>()(std::declval<const T &>()))>::type Type;
+};
+
+template <typename Function>
+struct ContinuationResult<Function, void>
+{
+    typedef typename std::decay<decltype(std::declval<Function>()())>::type Type;
+};
+
+template <typename ResultType, typename T>
+struct ContinuationInvoker
+{
+    template <typename Function>
+    static void invoke(Function &function, QFutureInterface<T> &parent,
+                       QFutureInterface<ResultType> &child)
+    {
+        ResultType result = function(parent.resultReference(0));
+        child.reportAndMoveResult(std::move(result));
+    }
+};
+
+template <typename T>
+struct ContinuationInvoker<void, T>
+{
+    template <typename Function>
+    static void invoke(Function &function, QFutureInterface<T> &parent,
+                       QFutureInterface<void> &)
+    { function(parent.resultReference(0)); }
+};
+
+template <typename ResultType>
+struct ContinuationInvoker<ResultType, void>
+{
+    template <typename Function>
+    static void invoke(Function &function, QFutureInterfaceBase &,
+                       QFutureInterface<ResultType> &child)
+    {
+        ResultType result = function();
+        child.reportAndMoveResult(std::move(result));
+    }
+};
+
+template <>
+struct ContinuationInvoker<void, void>
+{
+    template <typename Function>
+    static void invoke(Function &function, QFutureInterfaceBase &, QFutureInterface<void> &)
+    { function(); }
+};
+
+template <typename ResultType, typename T, typename Function, typename ParentInterface>
+void runContinuation(Function &function, ParentInterface &parent,
+                     QFutureInterface<ResultType> &child)
+{
+    if (parent.isCanceled() || (!std::is_void<T>::value && !parent.isResultReadyAt(0))) {
+#ifndef QT_NO_EXCEPTIONS
+        if (parent.exceptionStore().hasException())
+            child.reportException(*parent.exceptionStore().exception().exception());
+        else
+#endif
+            child.reportCanceled();
+        child.reportFinished();
+        return;
+    }
+
+#ifndef QT_NO_EXCEPTIONS
+    try {
+#endif
+        ContinuationInvoker<ResultType, T>::invoke(function, parent, child);
+#ifndef QT_NO_EXCEPTIONS
+    } catch (QException &e) {
+        child.reportException(e);
+    } catch (...) {
+        child.reportException(QUnhandledException());
+    }
+#endif
+    child.reportFinished();
+}
+
+} // namespace QtPrivate
+
 template <typename T>
 class QFuture
 {
@@ -96,6 +185,12 @@ public:
     operator T() const { return result(); }
     QList<T> results() const { return d.results(); }
 
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResult<Function, T>::Type> then(Function &&function)
+    { return then(Q_NULLPTR, std::forward<Function>(function)); }
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResult<Function, T>::Type> then(QThreadPool *pool, Function &&function);
+
     class const_iterator
     {
     public:
@@ -170,6 +265,22 @@ inline QFuture<T> QFutureInterface<T>::future()
     return QFuture<T>(this);
 }
 
+template <typename T>
+template <typename Function>
+QFuture<typename QtPrivate::ContinuationResult<Function, T>::Type>
+QFuture<T>::then(QThreadPool *pool, Function &&function)
+{
+    typedef typename QtPrivate::ContinuationResult<Function, T>::Type ResultType;
+    typename std::decay<Function>::type continuation(std::forward<Function>(function));
+    QFutureInterface<T> parent(d);
+    QFutureInterface<ResultType> child;
+    child.reportStarted();
+    d.setContinuation([continuation, parent, child]() mutable {
+        QtPrivate::runContinuation<ResultType, T>(continuation, parent, child);
+    }, pool);
+    return child.future();
+}
+
 Q_DECLARE_SEQUENTIAL_ITERATOR(Future)
 
 template <>
@@ -220,6 +331,12 @@ public:
     QString progressText() const { return d.progressText(); }
     void waitForFinished() { d.waitForFinished(); }
 
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResult<Function, void>::Type> then(Function &&function)
+    { return then(Q_NULLPTR, std::forward<Function>(function)); }
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResult<Function, void>::Type> then(QThreadPool *pool, Function &&function);
+
 private:
     friend class QFutureWatcher<void>;
 
@@ -234,6 +351,21 @@ inline QFuture<void> QFutureInterface<void>::future()
     return QFuture<void>(this);
 }
 
+template <typename Function>
+QFuture<typename QtPrivate::ContinuationResult<Function, void>::Type>
+QFuture<void>::then(QThreadPool *pool, Function &&function)
+{
+    typedef typename QtPrivate::ContinuationResult<Function, void>::Type ResultType;
+    typename std::decay<Function>::type continuation(std::forward<Function>(function));
+    QFutureInterfaceBase parent(d);
+    QFutureInterface<ResultType> child;
+    child.reportStarted();
+    d.setContinuation([continuation, parent, child]() mutable {
+        QtPrivate::runContinuation<ResultType, void>(continuation, parent, child);
+    }, pool);
+    return child.future();
+}
+
 template <typename T>
 QFuture<void> qToVoidFuture(const QFuture<T> &future)
 {
@@ -293,6 +293,15 @@ void QFutureInterfaceBase::reportFinished()
         switch_from_to(d->state, Running, Finished);
         d->waitCondition.wakeAll();
         d->sendCallOut(QFutureCallOutEvent(QFutureCallOutEvent::Finished));
+
+        if (d->continuation) {
+            std::function<void()> continuation;
+            continuation.swap(d->continuation);
+            QThreadPool *pool = d->continuationPool;
+            d->continuationPool = 0;
+            locker.unlock();
+            QFutureInterfaceBasePrivate::runContinuation(std::move(continuation), pool);
+        }
     }
 }
 
@@ -389,6 +398,29 @@ void QFutureInterfaceBase::setThreadPool(QThreadPool *pool)
     d->m_pool = pool;
 }
 
+/*!
+    \internal
+
+    Sets \a func to be called once the future has finished. If \a pool is
+    null, \a func is called directly from the thread calling reportFinished(),
+    otherwise it is started on \a pool. If the future has already finished,
+    \a func is called (or started) immediately.
+
+    Only one continuation can be attached; setting a new one replaces any
+    continuation that has not run yet.
+*/
+void QFutureInterfaceBase::setContinuation(std::function<void()> func, QThreadPool *pool)
+{
+    QMutexLocker locker(&d->m_mutex);
+    if (!isFinished()) {
+        d->continuation = std::move(func);
+        d->continuationPool = pool;
+        return;
+    }
+    locker.unlock();
+    QFutureInterfaceBasePrivate::runContinuation(std::move(func), pool);
+}
+
 void QFutureInterfaceBase::setFilterMode(bool enable)
 {
     QMutexLocker locker(&d->m_mutex);
@@ -469,11 +501,35 @@ bool QFutureInterfaceBase::derefT() const
 QFutureInterfaceBasePrivate::QFutureInterfaceBasePrivate(QFutureInterfaceBase::State initialState)
     : refCount(1), m_progressValue(0), m_progressMinimum(0), m_progressMaximum(0),
       state(initialState),
-      manualProgress(false), m_expectedResultCount(0), runnable(0), m_pool(0)
+      manualProgress(false), m_expectedResultCount(0), runnable(0), m_pool(0),
+      continuationPool(0)
 {
     progressTime.invalidate();
 }
 
+namespace {
+class QFutureContinuationRunnable : public QRunnable
+{
+public:
+    explicit QFutureContinuationRunnable(std::function<void()> &&func)
+        : func(std::move(func))
+    { }
+
+    void run() Q_DECL_OVERRIDE { func(); }
+
+private:
+    std::function<void()> func;
+};
+} // unnamed namespace
+
+void QFutureInterfaceBasePrivate::runContinuation(std::function<void()> &&func, QThreadPool *pool)
+{
+    if (pool)
+        pool->start(new QFutureContinuationRunnable(std::move(func)));
+    else
+        func();
+}
+
 int QFutureInterfaceBasePrivate::internal_resultCount() const
 {
     return m_results.count(); // ### subtract canceled results.
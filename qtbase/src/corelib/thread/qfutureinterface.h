@@ -48,6 +48,8 @@
 #include <QtCore/qexception.h>
 #include <QtCore/qresultstore.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -86,6 +88,7 @@ public:
     void setRunnable(QRunnable *runnable);
     void setThreadPool(QThreadPool *pool);
     void setFilterMode(bool enable);
+    void setContinuation(std::function<void()> func, QThreadPool *pool = Q_NULLPTR);
     void setProgressRange(int minimum, int maximum);
     int progressMinimum() const;
     int progressMaximum() const;
@@ -178,6 +181,7 @@ public:
 
     inline void reportResult(const T *result, int index = -1);
     inline void reportResult(const T &result, int index = -1);
+    inline void reportAndMoveResult(T &&result, int index = -1);
     inline void reportResults(const QVector<T> &results, int beginIndex = -1, int count = -1);
     inline void reportFinished(const T *result = 0);
 
@@ -212,6 +216,24 @@ inline void QFutureInterface<T>::reportResult(const T &result, int index)
     reportResult(&result, index);
 }
 
+template <typename T>
+inline void QFutureInterface<T>::reportAndMoveResult(T &&result, int index)
+{
+    QMutexLocker locker(mutex());
+    if (this->queryState(Canceled) || this->queryState(Finished)) {
+        return;
+    }
+
+    QtPrivate::ResultStoreBase &store = resultStoreBase();
+
+    const int resultCountBefore = store.count();
+    const int insertIndex = store.template moveResult<T>(index, std::move(result));
+    if (store.filterMode())
+        this->reportResultsReady(resultCountBefore, resultCountBefore + store.count());
+    else
+        this->reportResultsReady(insertIndex, insertIndex + 1);
+}
+
 template <typename T>
 inline void QFutureInterface<T>::reportResults(const QVector<T> &_results, int beginIndex, int count)
 {
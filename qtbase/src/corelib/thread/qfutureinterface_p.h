@@ -172,10 +172,14 @@ public:
     QString m_progressText;
     QRunnable *runnable;
     QThreadPool *m_pool;
+    std::function<void()> continuation;
+    QThreadPool *continuationPool;
 
     inline QThreadPool *pool() const
     { return m_pool ? m_pool : QThreadPool::globalInstance(); }
 
+    static void runContinuation(std::function<void()> &&func, QThreadPool *pool);
+
     // Internal functions that does not change the mutex state.
     // The mutex must be locked when calling these.
     int internal_resultCount() const;
@@ -50,6 +50,10 @@
 #include "qelapsedtimer.h"
 #include "private/qfreelist_p.h"
 
+#if defined(Q_CC_MSVC) && (defined(Q_PROCESSOR_X86) || defined(Q_PROCESSOR_ARM))
+#  include <intrin.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 /*
@@ -62,6 +66,12 @@ QT_BEGIN_NAMESPACE
  *    are waiting, and the lock is not recursive.
  *  - when d_ptr == 0x2: We are locked for write and nobody is waiting. (no contention)
  *  - In any other case, d_ptr points to an actual QReadWriteLockPrivate.
+ *
+ * Before a thread that could not get the lock on the fast path allocates a
+ * QReadWriteLockPrivate (and possibly goes to sleep), it spins for a short while
+ * waiting for the lock word to change. Critical sections protected by a
+ * QReadWriteLock are usually short, so this keeps the lock in the uncontended
+ * states, where readers never touch a mutex.
  */
 
 namespace {
@@ -74,6 +84,57 @@ const auto dummyLockedForRead = reinterpret_cast<QReadWriteLockPrivate *>(quintp
 const auto dummyLockedForWrite = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForWrite));
 inline bool isUncontendedLocked(const QReadWriteLockPrivate *d)
 { return quintptr(d) & StateMask; }
+
+enum {
+    // Total number of polls of d_ptr a thread does per lock attempt before
+    // going through the QReadWriteLockPrivate.
+    MaximumSpinCount = 256
+};
+
+inline void cpuRelax()
+{
+#if defined(Q_CC_MSVC) && defined(Q_PROCESSOR_X86)
+    _mm_pause();
+#elif defined(Q_CC_MSVC) && defined(Q_PROCESSOR_ARM)
+    __yield();
+#elif defined(Q_CC_GNU) && defined(Q_PROCESSOR_X86)
+    __builtin_ia32_pause();
+#elif defined(Q_CC_GNU) && (defined(Q_PROCESSOR_ARM_V7) || defined(Q_PROCESSOR_ARM_V8))
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+int spinCount()
+{
+    // spinning only makes sense if the lock holder can run at the same time
+    static const int count = QThread::idealThreadCount() > 1 ? int(MaximumSpinCount) : 0;
+    return count;
+}
+
+/*
+ * Spins until d_ptr no longer holds d or the budget is exhausted. The wait
+ * between two polls doubles every time, so that the spinning threads do not
+ * hammer the cache line holding the lock. Returns true if the value changed,
+ * in which case d holds the new value.
+ */
+bool spinWhileUnchanged(QAtomicPointer<QReadWriteLockPrivate> &d_ptr, QReadWriteLockPrivate *&d,
+                        int &budget)
+{
+    int pauses = 1;
+    while (budget > 0) {
+        for (int i = 0; i < pauses; ++i)
+            cpuRelax();
+        --budget;
+        QReadWriteLockPrivate *current = d_ptr.loadAcquire();
+        if (current != d) {
+            d = current;
+            return true;
+        }
+        if (pauses < 16)
+            pauses *= 2;
+    }
+    return false;
+}
 }
 
 /*! \class QReadWriteLock
@@ -226,6 +287,7 @@ bool QReadWriteLock::tryLockForRead(int timeout)
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
         return true;
 
+    int spinBudget = timeout ? spinCount() : 0;
     while (true) {
         if (d == 0) {
             if (!d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
@@ -247,7 +309,11 @@ bool QReadWriteLock::tryLockForRead(int timeout)
             if (!timeout)
                 return false;
 
-            // locked for write, assign a d_ptr and wait.
+            // locked for write, give the writer a chance to finish
+            if (spinWhileUnchanged(d_ptr, d, spinBudget))
+                continue;
+
+            // still locked for write, assign a d_ptr and wait.
             auto val = QReadWriteLockPrivate::allocate();
             val->writerCount = 1;
             if (!d_ptr.testAndSetOrdered(d, val, d)) {
@@ -340,6 +406,7 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForWrite, d))
         return true;
 
+    int spinBudget = timeout ? spinCount() : 0;
     while (true) {
         if (d == 0) {
             if (!d_ptr.testAndSetAcquire(d, dummyLockedForWrite, d))
@@ -351,7 +418,11 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
             if (!timeout)
                 return false;
 
-            // locked for either read or write, assign a d_ptr and wait.
+            // locked for either read or write, give the holders a chance to finish
+            if (spinWhileUnchanged(d_ptr, d, spinBudget))
+                continue;
+
+            // still locked, assign a d_ptr and wait.
             auto val = QReadWriteLockPrivate::allocate();
             if (d == dummyLockedForWrite)
                 val->writerCount = 1;
@@ -151,6 +151,12 @@ public:
             return addResult(index, static_cast<void *>(new T(*result)));
     }
 
+    template <typename T>
+    int moveResult(int index, T &&result)
+    {
+        return addResult(index, static_cast<void *>(new T(std::move(result))));
+    }
+
     template <typename T>
     int addResults(int index, const QVector<T> *results)
     {
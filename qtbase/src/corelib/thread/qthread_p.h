@@ -78,6 +78,7 @@ QT_BEGIN_NAMESPACE
 
 class QAbstractEventDispatcher;
 class QEventLoop;
+class QObjectArena;
 
 class QPostEvent
 {
@@ -288,6 +289,7 @@ public:
     QAtomicPointer<QAbstractEventDispatcher> eventDispatcher;
     QVector<void *> tls;
     FlaggedDebugSignatures flaggedSignatures;
+    QObjectArena *objectArena;
 
     bool quitNow;
     bool canWait;
@@ -51,6 +51,9 @@
 #  if !defined(QT_NO_GLIB)
 #    include "../kernel/qeventdispatcher_glib_p.h"
 #  endif
+#  if defined(Q_OS_LINUX)
+#    include <private/qeventdispatcher_epoll_p.h>
+#  endif
 #endif
 
 #include <private/qeventdispatcher_unix_p.h>
@@ -290,15 +293,20 @@ void QThreadPrivate::createEventDispatcher(QThreadData *data)
         data->eventDispatcher.storeRelease(new QEventDispatcherCoreFoundation);
     else
         data->eventDispatcher.storeRelease(new QEventDispatcherUNIX);
-#elif !defined(QT_NO_GLIB)
+#else
+#  if defined(Q_OS_LINUX)
+    if (QEventDispatcherEpoll::isRequested())
+        data->eventDispatcher.storeRelease(new QEventDispatcherEpoll);
+    else
+#  endif
+#  if !defined(QT_NO_GLIB)
     if (qEnvironmentVariableIsEmpty("QT_NO_GLIB")
         && qEnvironmentVariableIsEmpty("QT_NO_THREADED_GLIB")
         && QEventDispatcherGlib::versionSupported())
         data->eventDispatcher.storeRelease(new QEventDispatcherGlib);
     else
+#  endif
         data->eventDispatcher.storeRelease(new QEventDispatcherUNIX);
-#else
-    data->eventDispatcher.storeRelease(new QEventDispatcherUNIX);
 #endif
 
     data->eventDispatcher.load()->startingUp();
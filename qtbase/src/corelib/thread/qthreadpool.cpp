@@ -55,15 +55,48 @@ Q_GLOBAL_STATIC(QThreadPool, theInstance)
 class QThreadPoolThread : public QThread
 {
 public:
+    enum {
+        MaxFinishedTasks = 32
+    };
+
+    struct LocalTask {
+        QRunnable *runnable;
+        int priority;
+    };
+
     QThreadPoolThread(QThreadPoolPrivate *manager);
     void run() Q_DECL_OVERRIDE;
     void registerThreadInactive();
 
+    void pushLocalTask(QRunnable *runnable, int priority);
+    QRunnable *takeLocalTask();
+    QRunnable *takeLastLocalTask();
+    bool tryTakeLocalTask(QRunnable *runnable);
+    void clearLocalTasks();
+    void releaseFinishedTasks();
+
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // Tasks started from this thread while in WorkStealing mode. Only this
+    // thread adds to the queue, other threads of the pool may steal from it.
+    // Sorted by priority, highest first. Guarded by localMutex; when both
+    // locks are needed manager->mutex must be locked first.
+    QMutex localMutex;
+    QVector<LocalTask> localQueue;
+
+    // Auto-deleting tasks that were run without holding manager->mutex.
+    // Their reference count is only ever touched under manager->mutex, so
+    // releasing them is deferred until this thread takes that lock again.
+    QRunnable *finishedTasks[MaxFinishedTasks];
+    int finishedTaskCount;
 };
 
+#ifdef Q_COMPILER_THREAD_LOCAL
+static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+#endif
+
 /*
     QThreadPool private class.
 */
@@ -73,7 +106,7 @@ public:
     \internal
 */
 QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
-    :manager(manager), runnable(nullptr)
+    :manager(manager), runnable(nullptr), finishedTaskCount(0)
 {
     setStackSize(manager->stackSize);
 }
@@ -84,42 +117,56 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 void QThreadPoolThread::run()
 {
     QMutexLocker locker(&manager->mutex);
+#ifdef Q_COMPILER_THREAD_LOCAL
+    currentPoolThread = this;
+#endif
     for(;;) {
         QRunnable *r = runnable;
         runnable = nullptr;
 
         do {
             if (r) {
-                const bool autoDelete = r->autoDelete();
-
-
-                // run the task
+                // run the task, followed by the tasks it queued on this
+                // thread, without holding the pool's lock
                 locker.unlock();
+                do {
+                    const bool autoDelete = r->autoDelete();
+
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
+
+                    if (autoDelete)
+                        finishedTasks[finishedTaskCount++] = r;
+                } while (finishedTaskCount < MaxFinishedTasks && (r = takeLocalTask()));
                 locker.relock();
 
-                if (autoDelete && !--r->ref)
-                    delete r;
+                releaseFinishedTasks();
             }
 
+            // tasks queued on this thread must run before it may expire
+            r = takeLocalTask();
+            if (r)
+                continue;
+
             // if too many threads are active, expire this thread
             if (manager->tooManyThreadsActive())
                 break;
 
             if (manager->queue.isEmpty()) {
-                r = nullptr;
+                r = manager->stealTask(this);
+                if (r)
+                    continue;
                 break;
             }
 
@@ -162,6 +209,98 @@ void QThreadPoolThread::registerThreadInactive()
         manager->noActiveThreads.wakeAll();
 }
 
+inline bool compareLocalTaskPriority(int priority, const QThreadPoolThread::LocalTask &task)
+{
+    return task.priority < priority;
+}
+
+/*
+    \internal
+    Queues \a runnable on this thread. Must be called from this thread.
+*/
+void QThreadPoolThread::pushLocalTask(QRunnable *runnable, int priority)
+{
+    QMutexLocker locker(&localMutex);
+    if (runnable->autoDelete())
+        ++runnable->ref;
+
+    const LocalTask task = { runnable, priority };
+    auto it = std::upper_bound(localQueue.constBegin(), localQueue.constEnd(), priority,
+                               compareLocalTaskPriority);
+    localQueue.insert(std::distance(localQueue.constBegin(), it), task);
+    manager->localTaskCount.ref();
+}
+
+/*
+    \internal
+    Removes the highest priority task from the local queue and returns it.
+*/
+QRunnable *QThreadPoolThread::takeLocalTask()
+{
+    QMutexLocker locker(&localMutex);
+    if (localQueue.isEmpty())
+        return nullptr;
+    manager->localTaskCount.deref();
+    return localQueue.takeFirst().runnable;
+}
+
+/*
+    \internal
+    Removes the lowest priority, most recently queued task from the local
+    queue and returns it. This is the end other threads steal from.
+*/
+QRunnable *QThreadPoolThread::takeLastLocalTask()
+{
+    QMutexLocker locker(&localMutex);
+    if (localQueue.isEmpty())
+        return nullptr;
+    manager->localTaskCount.deref();
+    return localQueue.takeLast().runnable;
+}
+
+bool QThreadPoolThread::tryTakeLocalTask(QRunnable *runnable)
+{
+    QMutexLocker locker(&localMutex);
+    for (int i = 0; i < localQueue.size(); ++i) {
+        if (localQueue.at(i).runnable == runnable) {
+            localQueue.remove(i);
+            manager->localTaskCount.deref();
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+    \internal
+    Drops all tasks from the local queue. Must be called with manager->mutex locked.
+*/
+void QThreadPoolThread::clearLocalTasks()
+{
+    QMutexLocker locker(&localMutex);
+    for (const LocalTask &task : qAsConst(localQueue)) {
+        QRunnable *r = task.runnable;
+        if (r->autoDelete() && !--r->ref)
+            delete r;
+        manager->localTaskCount.deref();
+    }
+    localQueue.clear();
+}
+
+/*
+    \internal
+    Must be called with manager->mutex locked.
+*/
+void QThreadPoolThread::releaseFinishedTasks()
+{
+    for (int i = 0; i < finishedTaskCount; ++i) {
+        QRunnable *r = finishedTasks[i];
+        if (!--r->ref)
+            delete r;
+    }
+    finishedTaskCount = 0;
+}
+
 
 /*
     \internal
@@ -229,6 +368,66 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
 }
 
+/*
+    \internal
+    Queues \a runnable on the calling thread if it is one of this pool's
+    threads. Returns \c false if the task must go through the shared queue.
+*/
+bool QThreadPoolPrivate::enqueueLocalTask(QRunnable *runnable, int priority)
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    QThreadPoolThread *thread = currentPoolThread;
+    if (!thread || thread->manager != this)
+        return false;
+
+    thread->pushLocalTask(runnable, priority);
+
+    // Give an idle thread, or one that has not been started yet, a chance to
+    // take the task. Never block on the pool lock for it though: whichever
+    // thread holds it will look at the local queues before going idle.
+    if (mutex.tryLock()) {
+        if (!waitingThreads.isEmpty()) {
+            waitingThreads.takeFirst()->runnableReady.wakeOne();
+        } else if (activeThreadCount() < maxThreadCount) {
+            if (QRunnable *r = thread->takeLastLocalTask()) {
+                if (r->autoDelete())
+                    --r->ref; // undo ++ref in pushLocalTask(), tryStart() takes its own
+                tryStart(r);
+            }
+        }
+        mutex.unlock();
+    }
+    return true;
+#else
+    Q_UNUSED(runnable);
+    Q_UNUSED(priority);
+    return false;
+#endif
+}
+
+/*
+    \internal
+    Takes a task from the local queue of another thread of the pool.
+    Must be called with the pool's mutex locked.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    if (localTaskCount.load() == 0)
+        return nullptr;
+
+    // start looking after the thief, so that not every thread robs the same victim
+    const int count = allThreads.count();
+    const int start = allThreads.indexOf(thief) + 1;
+    for (int i = 0; i < count; ++i) {
+        QThreadPoolThread *victim = allThreads.at((start + i) % count);
+        if (victim == thief)
+            continue;
+        if (QRunnable *r = victim->takeLastLocalTask())
+            return r;
+    }
+    return nullptr;
+}
+
 int QThreadPoolPrivate::activeThreadCount() const
 {
     return (allThreads.count()
@@ -338,6 +537,9 @@ void QThreadPoolPrivate::clear()
     }
     qDeleteAll(queue);
     queue.clear();
+
+    for (QThreadPoolThread *thread : qAsConst(allThreads))
+        thread->clearLocalTasks();
 }
 
 /*!
@@ -377,6 +579,14 @@ bool QThreadPool::tryTake(QRunnable *runnable)
                 return true;
             }
         }
+
+        for (QThreadPoolThread *thread : qAsConst(d->allThreads)) {
+            if (thread->tryTakeLocalTask(runnable)) {
+                if (runnable->autoDelete())
+                    --runnable->ref; // undo ++ref in start()
+                return true;
+            }
+        }
     }
 
     return false;
@@ -493,6 +703,11 @@ QThreadPool *QThreadPool::globalInstance()
     ownership of \a runnable remains with the caller. Note that
     changing the auto-deletion on \a runnable after calling this
     functions results in undefined behavior.
+
+    If the schedulingPolicy() is WorkStealing and this function is called
+    from one of the pool's threads, \a runnable is queued on the calling
+    thread instead, and \a priority only orders it relative to the other
+    runnables queued on that thread.
 */
 void QThreadPool::start(QRunnable *runnable, int priority)
 {
@@ -500,6 +715,9 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (d->schedulingPolicy == WorkStealing && d->enqueueLocalTask(runnable, priority))
+        return;
+
     QMutexLocker locker(&d->mutex);
     if (!d->tryStart(runnable)) {
         d->enqueueTask(runnable, priority);
@@ -659,6 +877,48 @@ uint QThreadPool::stackSize() const
     return d->stackSize;
 }
 
+/*!
+    \enum QThreadPool::SchedulingPolicy
+    \since 5.11
+
+    This enum describes how runnables started from within the pool's own
+    threads are queued.
+
+    \value SharedQueue All runnables go through a single queue shared by all
+    threads of the pool. This is the default.
+
+    \value WorkStealing A runnable started from one of the pool's threads is
+    queued on that thread and runs there after the current runnable returns,
+    without taking the pool's shared lock. Idle threads steal queued runnables
+    from busy threads. Priorities only order runnables queued on the same thread.
+    Runnables started from other threads still go through the shared queue.
+*/
+
+/*! \property QThreadPool::schedulingPolicy
+    \brief the policy used to queue runnables started from the pool's threads
+    \since 5.11
+
+    WorkStealing scales better when many short runnables are started from
+    within other runnables, for example by QtConcurrent algorithms, because
+    the pool's threads then do not contend for a single lock.
+
+    The default is SharedQueue.
+
+    \sa start()
+*/
+void QThreadPool::setSchedulingPolicy(SchedulingPolicy policy)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->schedulingPolicy = policy;
+}
+
+QThreadPool::SchedulingPolicy QThreadPool::schedulingPolicy() const
+{
+    Q_D(const QThreadPool);
+    return d->schedulingPolicy;
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
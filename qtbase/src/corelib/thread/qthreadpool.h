@@ -59,9 +59,16 @@ class Q_CORE_EXPORT QThreadPool : public QObject
     Q_PROPERTY(int maxThreadCount READ maxThreadCount WRITE setMaxThreadCount)
     Q_PROPERTY(int activeThreadCount READ activeThreadCount)
     Q_PROPERTY(uint stackSize READ stackSize WRITE setStackSize)
+    Q_PROPERTY(SchedulingPolicy schedulingPolicy READ schedulingPolicy WRITE setSchedulingPolicy)
     friend class QFutureInterfaceBase;
 
 public:
+    enum SchedulingPolicy {
+        SharedQueue,
+        WorkStealing
+    };
+    Q_ENUM(SchedulingPolicy)
+
     QThreadPool(QObject *parent = Q_NULLPTR);
     ~QThreadPool();
 
@@ -81,6 +88,9 @@ public:
     void setStackSize(uint stackSize);
     uint stackSize() const;
 
+    void setSchedulingPolicy(SchedulingPolicy policy);
+    SchedulingPolicy schedulingPolicy() const;
+
     void reserveThread();
     void releaseThread();
 
@@ -52,6 +52,8 @@
 //
 //
 
+#include "QtCore/qthreadpool.h"
+#include "QtCore/qatomic.h"
 #include "QtCore/qmutex.h"
 #include "QtCore/qthread.h"
 #include "QtCore/qwaitcondition.h"
@@ -155,6 +157,8 @@ public:
 
     bool tryStart(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
+    bool enqueueLocalTask(QRunnable *task, int priority);
+    QRunnable *stealTask(QThreadPoolThread *thief);
     int activeThreadCount() const;
 
     void tryToStartMoreThreads();
@@ -180,6 +184,9 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     bool isExiting = false;
+    QThreadPool::SchedulingPolicy schedulingPolicy = QThreadPool::SharedQueue;
+    QAtomicInt localTaskCount; // number of tasks in all QThreadPoolThread::localQueue
+
 };
 
 QT_END_NAMESPACE
@@ -569,7 +569,7 @@ bool QXmlStreamReader::atEnd() const
         if (d->device)
             return d->device->atEnd();
         else
-            return !d->dataBuffer.size();
+            return d->dataBufferPos == d->dataBuffer.size();
     }
     return (d->atEnd || d->type == QXmlStreamReader::Invalid);
 }
@@ -853,6 +853,7 @@ void QXmlStreamReaderPrivate::init()
     namespaceProcessing = true;
     rawReadBuffer.clear();
     dataBuffer.clear();
+    dataBufferPos = 0;
     readBuffer.clear();
     tagStackStringStorageSize = initialTagStackStringStorageSize;
 
@@ -1474,6 +1475,7 @@ void QXmlStreamReaderPrivate::putReplacementInAttributeValue(const QString &s)
 uint QXmlStreamReaderPrivate::getChar_helper()
 {
     const int BUFFER_SIZE = 8192;
+    const int DATA_CHUNK_SIZE = 65536;
     characterOffset += readBufferPos;
     readBufferPos = 0;
     readBuffer.resize(0);
@@ -1486,12 +1488,21 @@ uint QXmlStreamReaderPrivate::getChar_helper()
         int nbytesreadOrMinus1 = device->read(rawReadBuffer.data() + nbytesread, BUFFER_SIZE - nbytesread);
         nbytesread += qMax(nbytesreadOrMinus1, 0);
     } else {
+        // decode the data in chunks, so that readBuffer never holds more
+        // than a chunk's worth of UTF-16 however much data has been added
+        const int chunk = qMin(dataBuffer.size() - dataBufferPos, DATA_CHUNK_SIZE);
         if (nbytesread)
-            rawReadBuffer += dataBuffer;
-        else
+            rawReadBuffer.append(dataBuffer.constData() + dataBufferPos, chunk);
+        else if (chunk == dataBuffer.size())
             rawReadBuffer = dataBuffer;
+        else
+            rawReadBuffer = QByteArray(dataBuffer.constData() + dataBufferPos, chunk);
         nbytesread = rawReadBuffer.size();
-        dataBuffer.clear();
+        dataBufferPos += chunk;
+        if (dataBufferPos == dataBuffer.size()) {
+            dataBuffer.clear();
+            dataBufferPos = 0;
+        }
     }
     if (!nbytesread) {
         atEnd = true;
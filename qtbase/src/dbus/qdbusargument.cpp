@@ -131,6 +131,33 @@ bool QDBusArgumentPrivate::checkWrite(QDBusArgumentPrivate *&d)
     return false;
 }
 
+// Returns the D-Bus type used for arrays of the fixed-size type \a id that
+// can be transferred as one block of memory, or DBUS_TYPE_INVALID
+int QDBusArgumentPrivate::fixedArrayType(int id)
+{
+    switch (id) {
+    case QMetaType::UChar:
+        return DBUS_TYPE_BYTE;
+    case QMetaType::Short:
+        return DBUS_TYPE_INT16;
+    case QMetaType::UShort:
+        return DBUS_TYPE_UINT16;
+    case QMetaType::Int:
+        return DBUS_TYPE_INT32;
+    case QMetaType::UInt:
+        return DBUS_TYPE_UINT32;
+    case QMetaType::LongLong:
+        return DBUS_TYPE_INT64;
+    case QMetaType::ULongLong:
+        return DBUS_TYPE_UINT64;
+    case QMetaType::Double:
+        return DBUS_TYPE_DOUBLE;
+    default:
+        // bool is not fixed-size compatible: dbus_bool_t has 32 bits
+        return DBUS_TYPE_INVALID;
+    }
+}
+
 bool QDBusArgumentPrivate::checkRead(QDBusArgumentPrivate *d)
 {
     if (!d)
@@ -158,6 +185,7 @@ bool QDBusArgumentPrivate::checkReadAndDetach(QDBusArgumentPrivate *&d)
     QDBusDemarshaller *dd = new QDBusDemarshaller(d->capabilities);
     dd->message = q_dbus_message_ref(d->message);
     dd->iterator = static_cast<QDBusDemarshaller*>(d)->iterator;
+    dd->byteArrayViews = static_cast<QDBusDemarshaller*>(d)->byteArrayViews;
 
     if (!d->ref.deref())
         delete d;
@@ -548,6 +576,87 @@ QDBusArgument &QDBusArgument::operator<<(const QByteArray &arg)
     return *this;
 }
 
+/*!
+    \internal
+    \since 5.11
+
+    Appends the \a count elements of type \a elementMetaTypeId stored
+    contiguously at \a data as one array. Only fixed-size types, that is
+    integers except bool and double, can be appended this way.
+
+    This is used by the QList and QVector streaming operators to
+    transfer arrays with a single copy.
+*/
+void QDBusArgument::appendFixedArray(int elementMetaTypeId, const void *data, int count)
+{
+    if (!QDBusArgumentPrivate::checkWrite(d))
+        return;
+    const int type = QDBusArgumentPrivate::fixedArrayType(elementMetaTypeId);
+    if (type == DBUS_TYPE_INVALID) {
+        d->marshaller()->error(QString::fromLatin1("Type %1 is not a fixed-size D-Bus type")
+                               .arg(QLatin1String(QMetaType::typeName(elementMetaTypeId))));
+        return;
+    }
+    d->marshaller()->appendFixedArray(type, data, count);
+}
+
+/*!
+    \internal
+    \since 5.11
+
+    If the current argument is an array of the fixed-size type \a
+    elementMetaTypeId, sets \a data to point to its elements inside the
+    message, sets \a count to their number, advances to the next
+    argument and returns \c true. Otherwise, returns \c false without
+    extracting anything.
+
+    \a data remains valid as long as the message is alive.
+
+    \sa appendFixedArray()
+*/
+bool QDBusArgument::extractFixedArray(int elementMetaTypeId, const void **data, int *count) const
+{
+    const int type = QDBusArgumentPrivate::fixedArrayType(elementMetaTypeId);
+    if (type == DBUS_TYPE_INVALID || !QDBusArgumentPrivate::checkReadAndDetach(d))
+        return false;
+    return d->demarshaller()->toFixedArray(type, data, count);
+}
+
+/*!
+    \since 5.11
+
+    If \a enabled is true, QByteArray values extracted from this argument
+    and from arrays, structures and maps inside it reference the data in
+    the D-Bus message instead of copying it. This avoids copying large
+    binary payloads, but the byte arrays must not be used after the
+    message has been destroyed, unless they have been copied first, for
+    example with QByteArray::detach().
+
+    The message stays alive at least as long as this QDBusArgument or the
+    QDBusMessage it was taken from.
+
+    \sa byteArrayViewsEnabled(), QByteArray::fromRawData()
+*/
+void QDBusArgument::setByteArrayViewsEnabled(bool enabled) const
+{
+    if (QDBusArgumentPrivate::checkReadAndDetach(d))
+        d->demarshaller()->byteArrayViews = enabled;
+}
+
+/*!
+    \since 5.11
+
+    Returns \c true if extracted byte arrays reference the message data.
+
+    \sa setByteArrayViewsEnabled()
+*/
+bool QDBusArgument::byteArrayViewsEnabled() const
+{
+    if (QDBusArgumentPrivate::checkRead(d))
+        return d->demarshaller()->byteArrayViews;
+    return false;
+}
+
 /*!
     \internal
     \since 4.5
@@ -49,6 +49,7 @@
 #include <QtCore/qstring.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
 #include <QtDBus/qdbusextratypes.h>
 
 #ifndef QT_NO_DBUS
@@ -113,6 +114,7 @@ public:
     void endMapEntry();
 
     void appendVariant(const QVariant &v);
+    void appendFixedArray(int elementMetaTypeId, const void *data, int count);
 
     // used for de-marshalling (D-BUS -> Qt)
     QString currentSignature() const;
@@ -147,6 +149,10 @@ public:
 
     QVariant asVariant() const;
 
+    bool extractFixedArray(int elementMetaTypeId, const void **data, int *count) const;
+    void setByteArrayViewsEnabled(bool enabled) const;
+    bool byteArrayViewsEnabled() const;
+
 protected:
     QDBusArgument(QDBusArgumentPrivate *d);
     friend class QDBusArgumentPrivate;
@@ -233,6 +239,19 @@ Q_DBUS_EXPORT const QDBusArgument &operator>>(const QDBusArgument &a, QLineF &li
 Q_DBUS_EXPORT QDBusArgument &operator<<(QDBusArgument &a, const QLineF &line);
 #endif
 
+namespace QtPrivate {
+// element types whose arrays libdbus transfers as one block of memory
+template <typename T> struct IsDBusFixedType { enum { Value = false }; };
+template <> struct IsDBusFixedType<uchar> { enum { Value = true }; };
+template <> struct IsDBusFixedType<short> { enum { Value = true }; };
+template <> struct IsDBusFixedType<ushort> { enum { Value = true }; };
+template <> struct IsDBusFixedType<int> { enum { Value = true }; };
+template <> struct IsDBusFixedType<uint> { enum { Value = true }; };
+template <> struct IsDBusFixedType<qlonglong> { enum { Value = true }; };
+template <> struct IsDBusFixedType<qulonglong> { enum { Value = true }; };
+template <> struct IsDBusFixedType<double> { enum { Value = true }; };
+}
+
 template<template <typename> class Container, typename T>
 inline QDBusArgument &operator<<(QDBusArgument &arg, const Container<T> &list)
 {
@@ -261,11 +280,59 @@ inline const QDBusArgument &operator>>(const QDBusArgument &arg, Container<T> &l
     return arg;
 }
 
+// QVector specializations
+template<typename T>
+inline QDBusArgument &operator<<(QDBusArgument &arg, const QVector<T> &vector)
+{
+    int id = qMetaTypeId<T>();
+    if (QtPrivate::IsDBusFixedType<T>::Value) {
+        arg.appendFixedArray(id, vector.constData(), vector.size());
+        return arg;
+    }
+    arg.beginArray(id);
+    typename QVector<T>::ConstIterator it = vector.constBegin();
+    typename QVector<T>::ConstIterator end = vector.constEnd();
+    for ( ; it != end; ++it)
+        arg << *it;
+    arg.endArray();
+    return arg;
+}
+
+template<typename T>
+inline const QDBusArgument &operator>>(const QDBusArgument &arg, QVector<T> &vector)
+{
+    const void *data;
+    int count;
+    if (QtPrivate::IsDBusFixedType<T>::Value
+            && arg.extractFixedArray(qMetaTypeId<T>(), &data, &count)) {
+        vector.resize(count);
+        if (count)
+            memcpy(static_cast<void *>(vector.data()), data, count * sizeof(T));
+        return arg;
+    }
+
+    arg.beginArray();
+    vector.clear();
+    while (!arg.atEnd()) {
+        T item;
+        arg >> item;
+        vector.push_back(item);
+    }
+    arg.endArray();
+    return arg;
+}
+
 // QList specializations
 template<typename T>
 inline QDBusArgument &operator<<(QDBusArgument &arg, const QList<T> &list)
 {
     int id = qMetaTypeId<T>();
+    if (QtPrivate::IsDBusFixedType<T>::Value) {
+        // QList does not store the elements contiguously
+        const QVector<T> vector = list.toVector();
+        arg.appendFixedArray(id, vector.constData(), vector.size());
+        return arg;
+    }
     arg.beginArray(id);
     typename QList<T>::ConstIterator it = list.constBegin();
     typename QList<T>::ConstIterator end = list.constEnd();
@@ -278,6 +345,18 @@ inline QDBusArgument &operator<<(QDBusArgument &arg, const QList<T> &list)
 template<typename T>
 inline const QDBusArgument &operator>>(const QDBusArgument &arg, QList<T> &list)
 {
+    const void *data;
+    int count;
+    if (QtPrivate::IsDBusFixedType<T>::Value
+            && arg.extractFixedArray(qMetaTypeId<T>(), &data, &count)) {
+        const T *items = static_cast<const T *>(data);
+        list.clear();
+        list.reserve(count);
+        for (int i = 0; i < count; ++i)
+            list.append(items[i]);
+        return arg;
+    }
+
     arg.beginArray();
     list.clear();
     while (!arg.atEnd()) {
@@ -83,6 +83,7 @@ public:
     QDBusDemarshaller *demarshaller();
 
     static QByteArray createSignature(int id);
+    static int fixedArrayType(int id);
     static inline QDBusArgument create(QDBusArgumentPrivate *d)
     {
         QDBusArgument q(d);
@@ -126,6 +127,7 @@ public:
     void append(const QStringList &arg);
     void append(const QByteArray &arg);
     bool append(const QDBusVariant &arg); // this one can fail
+    void appendFixedArray(int type, const void *data, int count);
 
     QDBusMarshaller *beginStructure();
     QDBusMarshaller *endStructure();
@@ -161,7 +163,7 @@ private:
 class QDBusDemarshaller: public QDBusArgumentPrivate
 {
 public:
-    inline QDBusDemarshaller(int flags) : QDBusArgumentPrivate(flags), parent(0)
+    inline QDBusDemarshaller(int flags) : QDBusArgumentPrivate(flags), parent(0), byteArrayViews(false)
     { direction = Demarshalling; }
     ~QDBusDemarshaller();
 
@@ -183,6 +185,7 @@ public:
     QDBusVariant toVariant();
     QStringList toStringList();
     QByteArray toByteArray();
+    bool toFixedArray(int type, const void **data, int *count);
 
     QDBusDemarshaller *beginStructure();
     QDBusDemarshaller *endStructure();
@@ -206,6 +209,8 @@ public:
 public:
     DBusMessageIter iterator;
     QDBusDemarshaller *parent;
+    // byte arrays point into the message instead of copying it
+    bool byteArrayViews;
 
 private:
     Q_DISABLE_COPY(QDBusDemarshaller)
@@ -379,6 +379,15 @@ void QDBusConnectionManager::createServer(const QString &address, void *server)
     \value ExportAllInvokables                  export all of this object's invokables
     \value ExportAllContents                    export all of this object's contents
     \value ExportChildObjects                   export this object's child objects
+    \value ThreadSafeObject                     the object's exported slots and invokables
+                                                are thread-safe (since Qt 5.11). Incoming
+                                                calls are then delivered concurrently from a
+                                                pool of dispatch threads instead of the
+                                                object's thread. Its QDBusContext is not set
+                                                by these calls; slots that need the message
+                                                should take a QDBusMessage argument. The
+                                                environment variable QDBUS_DISPATCH_THREADS
+                                                sets the number of dispatch threads.
 
     \sa registerObject(), QDBusAbstractAdaptor, {usingadaptors.html}{Using adaptors}
 */
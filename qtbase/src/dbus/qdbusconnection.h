@@ -105,7 +105,8 @@ public:
         // Qt 4.2 had a misspelling here
         ExportAllSignal = ExportAllSignals,
 #endif
-        ExportChildObjects = 0x1000
+        ExportChildObjects = 0x1000,
+        ThreadSafeObject = 0x2000
         // Reserved = 0xff000000
     };
     Q_DECLARE_FLAGS(RegisterOptions, RegisterOption)
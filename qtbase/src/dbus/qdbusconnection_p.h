@@ -63,6 +63,7 @@
 #include <QtCore/qobject.h>
 #include <QtCore/qpointer.h>
 #include <QtCore/qreadwritelock.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qvarlengtharray.h>
 #include <QtCore/qvector.h>
@@ -70,6 +71,7 @@
 #include "qdbus_symbols_p.h"
 
 #include <qdbusmessage.h>
+#include <qdbuspendingcall.h>
 #include <qdbusservicewatcher.h>    // for the WatchMode enum
 
 #ifndef QT_NO_DBUS
@@ -82,6 +84,7 @@ class QTimerEvent;
 class QDBusObjectPrivate;
 class QDBusCallDeliveryEvent;
 class QDBusActivateObjectEvent;
+class QThreadPool;
 class QMetaMethod;
 class QDBusInterfacePrivate;
 struct QDBusMetaObject;
@@ -238,6 +241,8 @@ public:
 
     QDBusMetaObject *findMetaObject(const QString &service, const QString &path,
                                     const QString &interface, QDBusError &error);
+    QDBusPendingCall prefetchMetaObject(const QString &service, const QString &path,
+                                        const QString &interface);
 
     void postEventToThread(int action, QObject *target, QEvent *event);
 
@@ -248,6 +253,8 @@ private:
     void handleSignal(const QString &key, const QDBusMessage &msg);
     void handleSignal(const QDBusMessage &msg);
     void handleObjectCall(const QDBusMessage &message);
+    void handleObjectCalls(const PendingMessageList &calls);
+    QThreadPool *dispatchThreadPool();
 
     void activateSignal(const SignalHook& hook, const QDBusMessage &msg);
     void activateObject(ObjectTreeNode &node, const QDBusMessage &msg, int pathStartPos);
@@ -288,6 +295,7 @@ private slots:
     void registerServiceNoLock(const QString &serviceName);
     void unregisterServiceNoLock(const QString &serviceName);
     void handleDBusDisconnection();
+    void invalidateMetaObjects(const QString &name, const QString &oldOwner, const QString &newOwner);
 
 signals:
     void dispatchStatusChanged();
@@ -322,6 +330,11 @@ public:
     WatcherHash watchers;
     TimeoutHash timeouts;
     PendingMessageList pendingMessages;
+    // method calls read by one doDispatch(), activated together afterwards
+    PendingMessageList batchedObjectCalls;
+    bool batchingObjectCalls;
+    // runs calls to objects registered with ThreadSafeObject
+    QThreadPool *dispatchPool;
 
     // the master lock protects our own internal state
     QReadWriteLock lock;
@@ -333,6 +346,14 @@ public:
     MatchRefCountHash matchRefCounts;
     ObjectTreeNode rootNode;
     MetaObjectHash cachedMetaObjects;
+    // metaobjects of proxies for all interfaces of an object, by "service path"
+    MetaObjectHash cachedObjectMetaObjects;
+    // the service each interface in cachedMetaObjects was introspected from
+    QHash<QString, QString> metaObjectServices;
+    // cached metaobjects of services that changed owner; proxies may still use them
+    QVector<QDBusMetaObject *> retiredMetaObjects;
+    QSet<QString> introspectedServices;
+    QHash<QString, QDBusPendingCall> pendingIntrospections;
     PendingCallList pendingCalls;
 
     bool anonymousAuthenticationAllowed;
@@ -357,6 +378,7 @@ public:
     static QDBusConnection q(QDBusConnectionPrivate *connection) { return QDBusConnection(connection); }
 
     friend class QDBusActivateObjectEvent;
+    friend class QDBusObjectCallRunnable;
     friend class QDBusCallDeliveryEvent;
     friend class QDBusServer;
 };
@@ -347,6 +347,8 @@ QByteArray QDBusDemarshaller::toByteArrayUnchecked()
     int len;
     char* data;
     q_dbus_message_iter_get_fixed_array(&sub,&data,&len);
+    if (byteArrayViews)
+        return QByteArray::fromRawData(data, len);
     return QByteArray(data,len);
 }
 
@@ -359,6 +361,19 @@ QByteArray QDBusDemarshaller::toByteArray()
     return QByteArray();
 }
 
+bool QDBusDemarshaller::toFixedArray(int type, const void **data, int *count)
+{
+    if (q_dbus_message_iter_get_arg_type(&iterator) != DBUS_TYPE_ARRAY
+            || q_dbus_message_iter_get_element_type(&iterator) != type)
+        return false;
+
+    DBusMessageIter sub;
+    q_dbus_message_iter_recurse(&iterator, &sub);
+    q_dbus_message_iter_next(&iterator);
+    q_dbus_message_iter_get_fixed_array(&sub, data, count);
+    return true;
+}
+
 bool QDBusDemarshaller::atEnd()
 {
     // dbus_message_iter_has_next is broken if the list has one single element
@@ -390,6 +405,7 @@ QDBusDemarshaller *QDBusDemarshaller::beginCommon()
     QDBusDemarshaller *d = new QDBusDemarshaller(capabilities);
     d->parent = this;
     d->message = q_dbus_message_ref(message);
+    d->byteArrayViews = byteArrayViews;
 
     // recurse
     q_dbus_message_iter_recurse(&iterator, &d->iterator);
@@ -429,6 +445,7 @@ QDBusArgument QDBusDemarshaller::duplicate()
     QScopedPointer<QDBusDemarshaller> d(new QDBusDemarshaller(capabilities));
     d->iterator = iterator;
     d->message = q_dbus_message_ref(message);
+    d->byteArrayViews = byteArrayViews;
 
     q_dbus_message_iter_next(&iterator);
     return QDBusArgumentPrivate::create(d.take());
@@ -49,6 +49,7 @@
 #include <qstringlist.h>
 #include <qtimer.h>
 #include <qthread.h>
+#include <qthreadpool.h>
 
 #include "qdbusargument.h"
 #include "qdbusconnection_p.h"
@@ -132,6 +133,9 @@ qdbusThreadDebugFunc qdbusThreadDebug = 0;
 typedef QVarLengthArray<QDBusSpyCallEvent::Hook, 4> QDBusSpyHookList;
 Q_GLOBAL_STATIC(QDBusSpyHookList, qDBusSpyHookList)
 
+// protects the slot caches of objects registered with ThreadSafeObject
+Q_GLOBAL_STATIC(QMutex, qDBusSlotCacheMutex)
+
 extern "C" {
 
     // libdbus-1 callbacks
@@ -850,10 +854,13 @@ bool QDBusConnectionPrivate::activateCall(QObject* object, int flags, const QDBu
     if (!object)
         return false;
 
-    Q_ASSERT_X(QThread::currentThread() == object->thread(),
+    Q_ASSERT_X(QThread::currentThread() == object->thread()
+               || (flags & QDBusConnection::ThreadSafeObject),
                "QDBusConnection: internal threading error",
                "function called for an object that is in another thread!!");
 
+    // thread-safe objects can be called by several dispatch threads at once
+    QMutexLocker locker(flags & QDBusConnection::ThreadSafeObject ? qDBusSlotCacheMutex() : Q_NULLPTR);
     QDBusSlotCache slotCache =
         qvariant_cast<QDBusSlotCache>(object->property(cachePropertyName));
     QString cacheKey = msg.member(), signature = msg.signature();
@@ -896,6 +903,7 @@ bool QDBusConnectionPrivate::activateCall(QObject* object, int flags, const QDBu
         // save to the cache
         slotCache.hash.insert(cacheKey, slotData);
         object->setProperty(cachePropertyName, QVariant::fromValue(slotCache));
+        locker.unlock();
 
         // found the slot to be called
         deliverCall(object, flags, msg, slotData.metaTypes, slotData.slotIdx);
@@ -905,16 +913,18 @@ bool QDBusConnectionPrivate::activateCall(QObject* object, int flags, const QDBu
         return false;
     } else {
         // use the cache
+        locker.unlock();
         deliverCall(object, flags, msg, cacheIt->metaTypes, cacheIt->slotIdx);
         return true;
     }
     return false;
 }
 
-void QDBusConnectionPrivate::deliverCall(QObject *object, int /*flags*/, const QDBusMessage &msg,
+void QDBusConnectionPrivate::deliverCall(QObject *object, int flags, const QDBusMessage &msg,
                                          const QVector<int> &metaTypes, int slotIdx)
 {
-    Q_ASSERT_X(!object || QThread::currentThread() == object->thread(),
+    Q_ASSERT_X(!object || QThread::currentThread() == object->thread()
+               || (flags & QDBusConnection::ThreadSafeObject),
                "QDBusConnection: internal threading error",
                "function called for an object that is in another thread!!");
 
@@ -989,6 +999,10 @@ void QDBusConnectionPrivate::deliverCall(QObject *object, int /*flags*/, const Q
     bool fail;
     if (!object) {
         fail = true;
+    } else if (flags & QDBusConnection::ThreadSafeObject) {
+        // concurrent calls cannot share the object's QDBusContext
+        fail = object->qt_metacall(QMetaObject::InvokeMetaMethod,
+                                   slotIdx, params.data()) >= 0;
     } else {
         // FIXME: save the old sender!
         QDBusContextPrivate context(QDBusConnection(this), msg);
@@ -1026,6 +1040,7 @@ QDBusConnectionPrivate::QDBusConnectionPrivate(QObject *p)
     : QObject(p), ref(1), capabilities(0), mode(InvalidMode), busService(0),
       dispatchLock(QMutex::Recursive), connection(0),
       rootNode(QString(QLatin1Char('/'))),
+      batchingObjectCalls(false), dispatchPool(0),
       anonymousAuthenticationAllowed(false),
       dispatchEnabled(true)
 {
@@ -1071,6 +1086,8 @@ QDBusConnectionPrivate::~QDBusConnectionPrivate()
 
     closeConnection();
     qDeleteAll(cachedMetaObjects);
+    qDeleteAll(cachedObjectMetaObjects);
+    qDeleteAll(retiredMetaObjects);
 
     if (mode == ClientMode || mode == PeerMode) {
         // the bus service object holds a reference back to us;
@@ -1189,6 +1206,10 @@ void QDBusConnectionPrivate::doDispatch()
 {
     QDBusDispatchLocker locker(DoDispatchAction, this);
     if (mode == ClientMode || mode == PeerMode) {
+        // collect the method calls of all messages read so far and look up
+        // their objects under a single lock afterwards
+        const bool wasBatching = batchingObjectCalls;
+        batchingObjectCalls = true;
         while (q_dbus_connection_dispatch(connection) == DBUS_DISPATCH_DATA_REMAINS) ;
         if (dispatchEnabled && !pendingMessages.isEmpty()) {
             // dispatch previously queued messages
@@ -1200,6 +1221,12 @@ void QDBusConnectionPrivate::doDispatch()
             }
             pendingMessages.clear();
         }
+        batchingObjectCalls = wasBatching;
+        if (!wasBatching && !batchedObjectCalls.isEmpty()) {
+            PendingMessageList calls;
+            calls.swap(batchedObjectCalls);
+            handleObjectCalls(calls);
+        }
     }
 }
 
@@ -1534,6 +1561,15 @@ void QDBusConnectionPrivate::handleObjectCall(const QDBusMessage &msg)
     // however, if the message is internal, handleMessage was called directly
     // (user's thread) and no lock is in place. We can therefore call out to
     // user code, if necessary.
+    if (!QDBusMessagePrivate::isLocal(msg)) {
+        // external incoming message
+        if (batchingObjectCalls)
+            batchedObjectCalls.append(msg);
+        else
+            handleObjectCalls(PendingMessageList() << msg);
+        return;
+    }
+
     ObjectTreeNode result;
     int usedLength;
     QThread *objThread = 0;
@@ -1564,14 +1600,7 @@ void QDBusConnectionPrivate::handleObjectCall(const QDBusMessage &msg)
             return;
         }
 
-        if (!QDBusMessagePrivate::isLocal(msg)) {
-            // external incoming message
-            // post it and forget
-            postEventToThread(HandleObjectCallPostEventAction, result.obj,
-                              new QDBusActivateObjectEvent(QDBusConnection(this), this, result,
-                                                           usedLength, msg));
-            return;
-        } else if (objThread != QThread::currentThread()) {
+        if (objThread != QThread::currentThread()) {
             // looped-back message, targeting another thread:
             // synchronize with it
             postEventToThread(HandleObjectCallPostEventAction, result.obj,
@@ -1590,29 +1619,108 @@ void QDBusConnectionPrivate::handleObjectCall(const QDBusMessage &msg)
         activateObject(result, msg, usedLength);
 }
 
+// Activates the external method calls \a calls, in order. Consecutive calls
+// to the same object are posted to its thread as one event; calls to
+// objects registered with ThreadSafeObject run in the dispatch thread pool.
+void QDBusConnectionPrivate::handleObjectCalls(const PendingMessageList &calls)
+{
+    typedef QPair<QObject *, QDBusActivateObjectEvent *> PostedEvent;
+    QVarLengthArray<PostedEvent, 16> events;
+
+    QDBusReadLocker locker(HandleObjectCallAction, this);
+    for (const QDBusMessage &msg : calls) {
+        ObjectTreeNode result;
+        int usedLength;
+        if (!findObject(&rootNode, msg.path(), usedLength, result)) {
+            // qDebug("Call failed: no object found at %s", qPrintable(msg.path()));
+            sendError(msg, QDBusError::UnknownObject);
+            continue;
+        }
+
+        if (!result.obj) {
+            // no object -> no threading issues
+            // it's either going to be an error, or an internal filter
+            activateObject(result, msg, usedLength);
+            continue;
+        }
+
+        if (!result.obj->thread()) {
+            send(msg.createErrorReply(QDBusError::InternalError,
+                                      QString::fromLatin1("Object '%1' (at path '%2')"
+                                                          " has no thread. Cannot deliver message.")
+                                      .arg(result.obj->objectName(), msg.path())));
+            continue;
+        }
+
+        if (result.flags & QDBusConnection::ThreadSafeObject) {
+            dispatchThreadPool()->start(new QDBusObjectCallRunnable(QDBusConnection(this), result,
+                                                                    usedLength, msg));
+        } else if (!events.isEmpty() && events.last().first == result.obj) {
+            events.last().second->append(result, usedLength, msg);
+        } else {
+            events.append(qMakePair(result.obj,
+                                    new QDBusActivateObjectEvent(QDBusConnection(this), this, result,
+                                                                 usedLength, msg)));
+        }
+    }
+
+    // post them and forget; still under the lock so that the objects stay alive
+    for (const PostedEvent &event : qAsConst(events))
+        postEventToThread(HandleObjectCallPostEventAction, event.first, event.second);
+}
+
+QThreadPool *QDBusConnectionPrivate::dispatchThreadPool()
+{
+    if (!dispatchPool) {
+        dispatchPool = new QThreadPool(this);
+        const int threads = qEnvironmentVariableIntValue("QDBUS_DISPATCH_THREADS");
+        if (threads > 0)
+            dispatchPool->setMaxThreadCount(threads);
+    }
+    return dispatchPool;
+}
+
 QDBusActivateObjectEvent::~QDBusActivateObjectEvent()
 {
+    QDBusConnectionPrivate *that = QDBusConnectionPrivate::d(connection);
     if (!handled) {
         // we're being destroyed without delivering
         // it means the object was deleted between posting and delivering
-        QDBusConnectionPrivate *that = QDBusConnectionPrivate::d(connection);
         that->sendError(message, QDBusError::UnknownObject);
     }
+    for (int i = delivered; i < batched.size(); ++i)
+        that->sendError(batched.at(i).message, QDBusError::UnknownObject);
 
     // semaphore releasing happens in ~QMetaCallEvent
 }
 
-void QDBusActivateObjectEvent::placeMetaCall(QObject *)
+void QDBusActivateObjectEvent::placeMetaCall(QObject *object)
 {
     QDBusConnectionPrivate *that = QDBusConnectionPrivate::d(connection);
+    // any of the calls may delete the object
+    QPointer<QObject> guard = object;
 
     QDBusLockerBase::reportThreadAction(HandleObjectCallPostEventAction,
                                         QDBusLockerBase::BeforeDeliver, that);
     that->activateObject(node, message, pathStartPos);
+    handled = true;
+    for ( ; delivered < batched.size() && !guard.isNull(); ++delivered) {
+        Call &call = batched[delivered];
+        that->activateObject(call.node, call.message, call.pathStartPos);
+    }
     QDBusLockerBase::reportThreadAction(HandleObjectCallPostEventAction,
                                         QDBusLockerBase::AfterDeliver, that);
+}
 
-    handled = true;
+void QDBusObjectCallRunnable::run()
+{
+    QDBusConnectionPrivate *that = QDBusConnectionPrivate::d(connection);
+    if (object.isNull()) {
+        // the object was deleted while the call was queued
+        that->sendError(message, QDBusError::UnknownObject);
+        return;
+    }
+    that->activateObject(node, message, pathStartPos);
 }
 
 void QDBusConnectionPrivate::handleSignal(const QString &key, const QDBusMessage& msg)
@@ -2530,48 +2638,145 @@ QDBusMetaObject *
 QDBusConnectionPrivate::findMetaObject(const QString &service, const QString &path,
                                        const QString &interface, QDBusError &error)
 {
-    // service must be a unique connection name
-    if (!interface.isEmpty()) {
+    const QString objectKey = service + QLatin1Char(' ') + path;
+    {
         QDBusReadLocker locker(FindMetaObject1Action, this);
-        QDBusMetaObject *mo = cachedMetaObjects.value(interface, 0);
+        QDBusMetaObject *mo = interface.isEmpty() ? cachedObjectMetaObjects.value(objectKey, 0)
+                                                  : cachedMetaObjects.value(interface, 0);
+        if (mo)
+            return mo;
+    }
+
+    // use the reply of an introspection started by prefetchMetaObject(), if any
+    QDBusPendingCall pending = QDBusPendingCall::fromCompletedCall(QDBusMessage());
+    bool prefetched = false;
+    {
+        QDBusWriteLocker locker(FindMetaObject2Action, this);
+        QHash<QString, QDBusPendingCall>::Iterator it = pendingIntrospections.find(objectKey);
+        if (it != pendingIntrospections.end()) {
+            pending = *it;
+            pendingIntrospections.erase(it);
+            prefetched = true;
+        }
+    }
+
+    QDBusMessage reply;
+    if (prefetched) {
+        pending.waitForFinished();
+        reply = pending.reply();
+    } else {
+        // introspect the target object
+        QDBusMessage msg = QDBusMessage::createMethodCall(service, path,
+                                                    QDBusUtil::dbusInterfaceIntrospectable(),
+                                                    QStringLiteral("Introspect"));
+        QDBusMessagePrivate::setParametersValidated(msg, true);
+
+        reply = sendWithReply(msg, QDBus::Block);
+    }
+
+    QDBusMetaObject *result;
+    bool watch = false;
+    {
+        // it doesn't exist yet, we have to create it
+        QDBusWriteLocker locker(FindMetaObject2Action, this);
+        QDBusMetaObject *mo = interface.isEmpty() ? cachedObjectMetaObjects.value(objectKey, 0)
+                                                  : cachedMetaObjects.value(interface, 0);
         if (mo)
+            // maybe it got created when we switched from read to write lock
             return mo;
+
+        QString xml;
+        if (reply.type() == QDBusMessage::ReplyMessage) {
+            if (reply.signature() == QLatin1String("s"))
+                // fetch the XML description
+                xml = reply.arguments().at(0).toString();
+        } else {
+            error = QDBusError(reply);
+            lastError = error;
+            if (reply.type() != QDBusMessage::ErrorMessage || error.type() != QDBusError::UnknownMethod)
+                return 0; // error
+        }
+
+        QStringList created;
+        result = QDBusMetaObject::createMetaObject(interface, xml, cachedMetaObjects,
+                                                   error, &created);
+        lastError = error;
+        if (result && interface.isEmpty()) {
+            result->cached = true;
+            cachedObjectMetaObjects.insert(objectKey, result);
+        }
+        for (const QString &name : qAsConst(created))
+            metaObjectServices.insert(name, service);
+
+        // forget what was cached for a well-known name when its owner changes
+        if (!QDBusUtil::isValidUniqueConnectionName(service) && !introspectedServices.contains(service)) {
+            introspectedServices.insert(service);
+            watch = true;
+        }
     }
 
-    // introspect the target object
+    // release the lock and return
+    if (watch)
+        watchService(service, QDBusServiceWatcher::WatchForOwnerChange, this,
+                     SLOT(invalidateMetaObjects(QString,QString,QString)));
+    return result;
+}
+
+// Starts introspecting the object at \a path of \a service asynchronously.
+// A later findMetaObject() for the same object uses the reply instead of
+// making a blocking call.
+QDBusPendingCall QDBusConnectionPrivate::prefetchMetaObject(const QString &service,
+                                                            const QString &path,
+                                                            const QString &interface)
+{
+    const QString objectKey = service + QLatin1Char(' ') + path;
     QDBusMessage msg = QDBusMessage::createMethodCall(service, path,
                                                 QDBusUtil::dbusInterfaceIntrospectable(),
                                                 QStringLiteral("Introspect"));
-    QDBusMessagePrivate::setParametersValidated(msg, true);
+    {
+        QDBusReadLocker locker(FindMetaObject1Action, this);
+        const bool cached = interface.isEmpty() ? cachedObjectMetaObjects.contains(objectKey)
+                                                : cachedMetaObjects.contains(interface);
+        if (cached)
+            return QDBusPendingCall::fromCompletedCall(msg.createReply());
+        QHash<QString, QDBusPendingCall>::ConstIterator it = pendingIntrospections.constFind(objectKey);
+        if (it != pendingIntrospections.constEnd())
+            return *it;
+    }
+
+    QDBusPendingCall call = q(this).asyncCall(msg);
+    QDBusWriteLocker locker(FindMetaObject2Action, this);
+    pendingIntrospections.insert(objectKey, call);
+    return call;
+}
 
-    QDBusMessage reply = sendWithReply(msg, QDBus::Block);
+void QDBusConnectionPrivate::invalidateMetaObjects(const QString &name, const QString &oldOwner,
+                                                   const QString &newOwner)
+{
+    Q_UNUSED(oldOwner);
+    Q_UNUSED(newOwner);
 
-    // it doesn't exist yet, we have to create it
     QDBusWriteLocker locker(FindMetaObject2Action, this);
-    QDBusMetaObject *mo = 0;
-    if (!interface.isEmpty())
-        mo = cachedMetaObjects.value(interface, 0);
-    if (mo)
-        // maybe it got created when we switched from read to write lock
-        return mo;
-
-    QString xml;
-    if (reply.type() == QDBusMessage::ReplyMessage) {
-        if (reply.signature() == QLatin1String("s"))
-            // fetch the XML description
-            xml = reply.arguments().at(0).toString();
-    } else {
-        error = QDBusError(reply);
-        lastError = error;
-        if (reply.type() != QDBusMessage::ErrorMessage || error.type() != QDBusError::UnknownMethod)
-            return 0; // error
+    QHash<QString, QString>::Iterator it = metaObjectServices.begin();
+    while (it != metaObjectServices.end()) {
+        if (it.value() == name) {
+            retiredMetaObjects.append(cachedMetaObjects.take(it.key()));
+            it = metaObjectServices.erase(it);
+        } else {
+            ++it;
+        }
     }
 
-    // release the lock and return
-    QDBusMetaObject *result = QDBusMetaObject::createMetaObject(interface, xml,
-                                                                cachedMetaObjects, error);
-    lastError = error;
-    return result;
+    const QString prefix = name + QLatin1Char(' ');
+    MetaObjectHash::Iterator mo = cachedObjectMetaObjects.begin();
+    while (mo != cachedObjectMetaObjects.end()) {
+        if (mo.key().startsWith(prefix)) {
+            retiredMetaObjects.append(mo.value());
+            mo = cachedObjectMetaObjects.erase(mo);
+        } else {
+            ++mo;
+        }
+    }
 }
 
 void QDBusConnectionPrivate::registerService(const QString &serviceName)
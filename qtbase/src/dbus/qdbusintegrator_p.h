@@ -62,6 +62,7 @@
 #include "private/qobject_p.h"
 #include "qlist.h"
 #include "qpointer.h"
+#include "qrunnable.h"
 #include "qsemaphore.h"
 
 #include "qdbusconnection.h"
@@ -128,20 +129,55 @@ public:
                              const QDBusConnectionPrivate::ObjectTreeNode &n,
                              int p, const QDBusMessage &m, QSemaphore *s = 0)
         : QMetaCallEvent(0, ushort(-1), 0, sender, -1, 0, 0, 0, s), connection(c), node(n),
-          pathStartPos(p), message(m), handled(false)
+          pathStartPos(p), message(m), delivered(0), handled(false)
         { }
     ~QDBusActivateObjectEvent();
 
+    // delivers another call to the same object with this event
+    void append(const QDBusConnectionPrivate::ObjectTreeNode &n, int p, const QDBusMessage &m)
+    { batched.append(Call(n, p, m)); }
+
     void placeMetaCall(QObject *) Q_DECL_OVERRIDE;
 
 private:
+    struct Call
+    {
+        Call() : pathStartPos(0) { }
+        Call(const QDBusConnectionPrivate::ObjectTreeNode &n, int p, const QDBusMessage &m)
+            : node(n), pathStartPos(p), message(m) { }
+
+        QDBusConnectionPrivate::ObjectTreeNode node;
+        int pathStartPos;
+        QDBusMessage message;
+    };
+
     QDBusConnection connection; // just for refcounting
     QDBusConnectionPrivate::ObjectTreeNode node;
     int pathStartPos;
     QDBusMessage message;
+    QVector<Call> batched;
+    int delivered;
     bool handled;
 };
 
+class QDBusObjectCallRunnable : public QRunnable
+{
+public:
+    QDBusObjectCallRunnable(const QDBusConnection &c, const QDBusConnectionPrivate::ObjectTreeNode &n,
+                            int p, const QDBusMessage &m)
+        : connection(c), node(n), object(n.obj), pathStartPos(p), message(m)
+        { }
+
+    void run() Q_DECL_OVERRIDE;
+
+private:
+    QDBusConnection connection; // just for refcounting
+    QDBusConnectionPrivate::ObjectTreeNode node;
+    QPointer<QObject> object;
+    int pathStartPos;
+    QDBusMessage message;
+};
+
 class QDBusSpyCallEvent : public QMetaCallEvent
 {
 public:
@@ -46,6 +46,7 @@
 
 #include "qdbusmetatype_p.h"
 #include "qdbusconnection_p.h"
+#include "qdbusutil_p.h"
 
 #ifndef QT_NO_DBUS
 
@@ -196,6 +197,14 @@ QDBusInterfacePrivate::~QDBusInterfacePrivate()
 
     \snippet code/src_qdbus_qdbusinterface.cpp 0
 
+    Creating a QDBusInterface requires the description of the remote
+    interface, which is obtained with a blocking introspection call.
+    Descriptions are cached per connection, so only the first object
+    created for an interface introspects it. The cache is cleared for a
+    service when its owner changes. To create many objects without
+    blocking, call prefetch() for each of them first and create them once
+    the returned calls have finished.
+
     \sa {Qt D-Bus XML compiler (qdbusxml2cpp)}
 */
 
@@ -220,6 +229,29 @@ QDBusInterface::QDBusInterface(const QString &service, const QString &path, cons
 {
 }
 
+/*!
+    \since 5.11
+
+    Starts introspecting the object at path \a path on service \a service
+    asynchronously, using the given \a connection, and returns the pending
+    call. Once it has finished, a QDBusInterface for \a interface on that
+    object can be created without blocking. Use a QDBusPendingCallWatcher
+    to be notified when the call finishes.
+
+    If the description of \a interface is already cached, the returned call
+    has already finished and no message is sent.
+*/
+QDBusPendingCall QDBusInterface::prefetch(const QString &service, const QString &path,
+                                          const QString &interface,
+                                          const QDBusConnection &connection)
+{
+    QDBusConnectionPrivate *d = QDBusConnectionPrivate::d(connection);
+    if (!d || !connection.isConnected())
+        return QDBusPendingCall::fromError(QDBusError(QDBusError::Disconnected,
+                                                      QDBusUtil::disconnectedErrorMessage()));
+    return d->prefetchMetaObject(service, path, interface);
+}
+
 /*!
     Destroy the object interface and frees up any resource used.
 */
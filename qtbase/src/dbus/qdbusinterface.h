@@ -43,6 +43,7 @@
 #include <QtDBus/qtdbusglobal.h>
 #include <QtDBus/qdbusabstractinterface.h>
 #include <QtDBus/qdbusconnection.h>
+#include <QtDBus/qdbuspendingcall.h>
 
 #ifndef QT_NO_DBUS
 
@@ -62,6 +63,10 @@ public:
                    QObject *parent = Q_NULLPTR);
     ~QDBusInterface();
 
+    static QDBusPendingCall prefetch(const QString &service, const QString &path,
+                                     const QString &interface = QString(),
+                                     const QDBusConnection &connection = QDBusConnection::sessionBus());
+
     virtual const QMetaObject *metaObject() const Q_DECL_OVERRIDE;
     virtual void *qt_metacast(const char *) Q_DECL_OVERRIDE;
     virtual int qt_metacall(QMetaObject::Call, int, void **) Q_DECL_OVERRIDE;
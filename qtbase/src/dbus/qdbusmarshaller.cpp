@@ -180,6 +180,24 @@ inline void QDBusMarshaller::append(const QByteArray &arg)
     q_dbus_message_iter_close_container(&iterator, &subiterator);
 }
 
+void QDBusMarshaller::appendFixedArray(int type, const void *data, int count)
+{
+    const char signature[2] = { char(type), '\0' };
+    if (ba) {
+        if (!skipSignature) {
+            *ba += DBUS_TYPE_ARRAY_AS_STRING;
+            *ba += signature;
+        }
+        return;
+    }
+
+    // libdbus copies the whole block at once
+    DBusMessageIter subiterator;
+    q_dbus_message_iter_open_container(&iterator, DBUS_TYPE_ARRAY, signature, &subiterator);
+    q_dbus_message_iter_append_fixed_array(&subiterator, type, &data, count);
+    q_dbus_message_iter_close_container(&iterator, &subiterator);
+}
+
 inline bool QDBusMarshaller::append(const QDBusVariant &arg)
 {
     if (ba) {
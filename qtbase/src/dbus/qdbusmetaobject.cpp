@@ -582,7 +582,7 @@ void QDBusMetaObjectGenerator::writeWithoutXml(const QString &interface)
 
 QDBusMetaObject *QDBusMetaObject::createMetaObject(const QString &interface, const QString &xml,
                                                    QHash<QString, QDBusMetaObject *> &cache,
-                                                   QDBusError &error)
+                                                   QDBusError &error, QStringList *created)
 {
     error = QDBusError();
     QDBusIntrospection::Interfaces parsed = QDBusIntrospection::parseInterfaces(xml);
@@ -601,10 +601,12 @@ QDBusMetaObject *QDBusMetaObject::createMetaObject(const QString &interface, con
             QDBusMetaObjectGenerator generator(it.key(), it.value().constData());
             generator.write(obj);
 
-            if ( (obj->cached = !it.key().startsWith( QLatin1String("local.") )) )
+            if ( (obj->cached = !it.key().startsWith( QLatin1String("local.") )) ) {
                 // cache it
                 cache.insert(it.key(), obj);
-            else if (!us)
+                if (created)
+                    created->append(it.key());
+            } else if (!us)
                 delete obj;
 
         }
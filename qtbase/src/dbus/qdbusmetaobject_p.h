@@ -64,6 +64,7 @@
 QT_BEGIN_NAMESPACE
 
 class QDBusError;
+class QStringList;
 
 struct QDBusMetaObjectPrivate;
 struct Q_DBUS_EXPORT QDBusMetaObject: public QMetaObject
@@ -72,7 +73,7 @@ struct Q_DBUS_EXPORT QDBusMetaObject: public QMetaObject
 
     static QDBusMetaObject *createMetaObject(const QString &interface, const QString &xml,
                                              QHash<QString, QDBusMetaObject *> &map,
-                                             QDBusError &error);
+                                             QDBusError &error, QStringList *created = Q_NULLPTR);
     ~QDBusMetaObject()
     {
         delete [] reinterpret_cast<const char *>(d.stringdata);
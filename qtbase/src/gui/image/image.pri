@@ -8,6 +8,7 @@ HEADERS += \
         image/qimage.h \
         image/qimage_p.h \
         image/qimageiohandler.h \
+        image/qimageiohandler_p.h \
         image/qimagereader.h \
         image/qimagewriter.h \
         image/qpaintengine_pic_p.h \
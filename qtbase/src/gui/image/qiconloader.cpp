@@ -168,8 +168,20 @@ QStringList QIconLoader::themeSearchPaths() const
 class QIconCacheGtkReader
 {
 public:
+    // Flags recorded by gtk-update-icon-cache for every image of an icon
+    enum ImageFlag {
+        HasSuffixXpm = 0x1,
+        HasSuffixSvg = 0x2,
+        HasSuffixPng = 0x4
+    };
+    struct Image
+    {
+        const char *dir;
+        quint16 flags;
+    };
+
     explicit QIconCacheGtkReader(const QString &themeDir);
-    QVector<const char *> lookup(const QStringRef &);
+    QVector<Image> lookup(const QStringRef &);
     bool isValid() const { return m_isValid; }
 private:
     QFile m_file;
@@ -239,12 +251,13 @@ static quint32 icon_name_hash(const char *p)
 
 /*! \internal
     lookup the icon name and return the list of subdirectories in which an icon
-    with this name is present. The char* are pointers to the mapped data.
+    with this name is present, together with the file suffixes available there.
+    The char* are pointers to the mapped data.
     For example, this would return { "32x32/apps", "24x24/apps" , ... }
  */
-QVector<const char *> QIconCacheGtkReader::lookup(const QStringRef &name)
+QVector<QIconCacheGtkReader::Image> QIconCacheGtkReader::lookup(const QStringRef &name)
 {
-    QVector<const char *> ret;
+    QVector<Image> ret;
     if (!isValid())
         return ret;
 
@@ -278,12 +291,14 @@ QVector<const char *> QIconCacheGtkReader::lookup(const QStringRef &name)
             ret.reserve(listLen);
             for (uint j = 0; j < listLen && m_isValid; ++j) {
                 quint32 dirIndex = read16(listOffset + 4 + 8 * j);
+                quint16 flags = read16(listOffset + 4 + 8 * j + 2);
                 quint32 o = read32(dirListOffset + 4 + dirIndex*4);
                 if (!m_isValid || dirIndex >= dirListLen || o >= m_size) {
                     m_isValid = false;
                     return ret;
                 }
-                ret.append(reinterpret_cast<const char*>(m_data) + o);
+                Image image = { reinterpret_cast<const char*>(m_data) + o, flags };
+                ret.append(image);
             }
             return ret;
         }
@@ -407,7 +422,9 @@ QThemeIconInfo QIconLoader::findIconHelper(const QString &themeName,
             QVector<QIconDirInfo> subDirs = theme.keyList();
 
             // Try to reduce the amount of subDirs by looking in the GTK+ cache in order to save
-            // a massive amount of file stat (especially if the icon is not there)
+            // a massive amount of file stat (especially if the icon is not there). The cache
+            // also records which suffixes exist, so the files need not be stat'ed at all.
+            QVector<quint16> cachedFlags;
             auto cache = theme.m_gtkCaches.at(i);
             if (cache->isValid()) {
                 const auto result = cache->lookup(iconNameFallback);
@@ -415,24 +432,30 @@ QThemeIconInfo QIconLoader::findIconHelper(const QString &themeName,
                     const QVector<QIconDirInfo> subDirsCopy = subDirs;
                     subDirs.clear();
                     subDirs.reserve(result.count());
-                    for (const char *s : result) {
-                        QString path = QString::fromUtf8(s);
+                    cachedFlags.reserve(result.count());
+                    for (const QIconCacheGtkReader::Image &image : result) {
+                        QString path = QString::fromUtf8(image.dir);
                         auto it = std::find_if(subDirsCopy.cbegin(), subDirsCopy.cend(),
                                                [&](const QIconDirInfo &info) {
                                                    return info.path == path; } );
                         if (it != subDirsCopy.cend()) {
                             subDirs.append(*it);
+                            cachedFlags.append(image.flags);
                         }
                     }
                 }
             }
+            const bool useCachedFlags = !cachedFlags.isEmpty();
 
             QString contentDir = contentDirs.at(i) + QLatin1Char('/');
             for (int j = 0; j < subDirs.size() ; ++j) {
                 const QIconDirInfo &dirInfo = subDirs.at(j);
                 const QString subDir = contentDir + dirInfo.path + QLatin1Char('/');
                 const QString pngPath = subDir + pngIconName;
-                if (QFile::exists(pngPath)) {
+                const bool hasPng = useCachedFlags
+                        ? (cachedFlags.at(j) & QIconCacheGtkReader::HasSuffixPng)
+                        : QFile::exists(pngPath);
+                if (hasPng) {
                     PixmapEntry *iconEntry = new PixmapEntry;
                     iconEntry->dir = dirInfo;
                     iconEntry->filename = pngPath;
@@ -441,7 +464,10 @@ QThemeIconInfo QIconLoader::findIconHelper(const QString &themeName,
                     info.entries.prepend(iconEntry);
                 } else if (m_supportsSvg) {
                     const QString svgPath = subDir + svgIconName;
-                    if (QFile::exists(svgPath)) {
+                    const bool hasSvg = useCachedFlags
+                            ? (cachedFlags.at(j) & QIconCacheGtkReader::HasSuffixSvg)
+                            : QFile::exists(svgPath);
+                    if (hasSvg) {
                         ScalableEntry *iconEntry = new ScalableEntry;
                         iconEntry->dir = dirInfo;
                         iconEntry->filename = svgPath;
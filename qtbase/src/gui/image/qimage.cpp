@@ -60,6 +60,10 @@
 #include <private/qsimd_p.h>
 
 #include <qhash.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qthreadpool.h>
 
 #include <private/qpaintengine_raster_p.h>
 
@@ -4478,6 +4482,94 @@ int QImage::bitPlaneCount() const
     return bpc;
 }
 
+/*
+    Large smooth scales and transformations can be split into bands of
+    destination rows that are processed on QThreadPool::globalInstance().
+    The number of bands is opt-in through QT_IMAGE_TRANSFORM_THREADS; a value
+    of -1 uses one band per ideal thread. Images with fewer than
+    qt_imageBandMinimumPixels destination pixels are always processed in the
+    calling thread.
+*/
+enum { qt_imageBandMinimumPixels = 512 * 512, qt_imageBandMinimumRows = 16 };
+
+static int qt_imageBandCount(qint64 pixels, int rows)
+{
+    static const int configured = qEnvironmentVariableIntValue("QT_IMAGE_TRANSFORM_THREADS");
+    if (configured == 0 || configured == 1 || pixels < qt_imageBandMinimumPixels)
+        return 1;
+    const int threads = configured < 0 ? QThread::idealThreadCount() : configured;
+    return qBound(1, threads, rows / qt_imageBandMinimumRows);
+}
+
+template <typename Function>
+class QImageBandRunnable : public QRunnable
+{
+public:
+    QImageBandRunnable(const Function &function, int y1, int y2, QSemaphore *semaphore)
+        : m_function(function), m_y1(y1), m_y2(y2), m_semaphore(semaphore)
+    { }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        m_function(m_y1, m_y2);
+        m_semaphore->release();
+    }
+
+private:
+    const Function &m_function;
+    int m_y1;
+    int m_y2;
+    QSemaphore *m_semaphore;
+};
+
+/*
+    Calls \a function(y1, y2) for \a bands consecutive ranges covering the
+    \a rows rows, with each range starting at a multiple of \a alignment.
+    All but the last range are offered to the global thread pool; ranges no
+    thread is free for, and the last one, run in the calling thread, so this
+    never waits on a pool that is busy with our own callers.
+*/
+template <typename Function>
+static void qt_processImageBands(int rows, int bands, int alignment, const Function &function)
+{
+    const int units = (rows + alignment - 1) / alignment;
+    bands = qMin(bands, units);
+    if (bands <= 1) {
+        function(0, rows);
+        return;
+    }
+
+    QSemaphore semaphore;
+    QThreadPool *pool = QThreadPool::globalInstance();
+    int started = 0;
+    int unit = 0;
+    for (int i = 0; i < bands - 1; ++i) {
+        const int count = (units - unit) / (bands - i);
+        const int y1 = unit * alignment;
+        const int y2 = (unit + count) * alignment;
+        unit += count;
+        QRunnable *runnable = new QImageBandRunnable<Function>(function, y1, y2, &semaphore);
+        if (pool->tryStart(runnable)) {
+            ++started;
+        } else {
+            delete runnable;
+            function(y1, y2);
+        }
+    }
+    function(unit * alignment, rows);
+    semaphore.acquire(started);
+}
+
+static int qt_gcd(int a, int b)
+{
+    while (b) {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
 /*!
    Returns a smoothly scaled copy of the image. The returned image has a size
    of width \a w by height \a h pixels.
@@ -4498,7 +4590,39 @@ QImage QImage::smoothScaled(int w, int h) const {
         else
             src = src.convertToFormat(QImage::Format_RGB32);
     }
-    src = qSmoothScaleImage(src, w, h);
+
+    // When downscaling, destination rows map onto disjoint source rows, so the
+    // image can be split into bands whose boundaries fall on whole rows of
+    // both the source and the destination; each band then sees exactly the
+    // same scale factor as the full image.
+    const int sh = src.height();
+    const int bands = (h > 0 && h < sh) ? qt_imageBandCount(qint64(w) * h, h) : 1;
+    const int g = bands > 1 ? qt_gcd(sh, h) : 1;
+    const int alignment = h / g;
+    if (bands > 1 && alignment * qt_imageBandMinimumRows <= h) {
+        QImage dst(w, h, src.format());
+        QIMAGE_SANITYCHECK_MEMORY(dst);
+        const uchar *sbits = src.constBits();
+        uchar *dbits = dst.bits();
+        const int sbpl = src.bytesPerLine();
+        const int dbpl = dst.bytesPerLine();
+        const int sw = src.width();
+        const QImage::Format format = src.format();
+        const int sunit = sh / g;
+        auto scaleBand = [=](int y1, int y2) {
+            const int sy1 = y1 / alignment * sunit;
+            const int sy2 = y2 / alignment * sunit;
+            const QImage band(sbits + qsizetype(sy1) * sbpl, sw, sy2 - sy1, sbpl, format);
+            const QImage scaled = qSmoothScaleImage(band, w, y2 - y1);
+            const int bpl = qMin(dbpl, scaled.bytesPerLine());
+            for (int y = y1; y < y2; ++y)
+                memcpy(dbits + qsizetype(y) * dbpl, scaled.constScanLine(y - y1), bpl);
+        };
+        qt_processImageBands(h, bands, alignment, scaleBand);
+        src = dst;
+    } else {
+        src = qSmoothScaleImage(src, w, h);
+    }
     if (!src.isNull())
         copyMetadata(src.d, d);
     return src;
@@ -4693,13 +4817,23 @@ QImage QImage::transformed(const QTransform &matrix, Qt::TransformationMode mode
         Q_ASSERT(sImage.devicePixelRatio() == 1);
         Q_ASSERT(sImage.devicePixelRatio() == dImage.devicePixelRatio());
 
-        QPainter p(&dImage);
-        if (mode == Qt::SmoothTransformation) {
-            p.setRenderHint(QPainter::Antialiasing);
-            p.setRenderHint(QPainter::SmoothPixmapTransform);
-        }
-        p.setTransform(mat);
-        p.drawImage(QPoint(0, 0), sImage);
+        // Each band of destination rows gets its own painter on a QImage
+        // sharing dImage's memory, translated so it renders exactly the
+        // pixels the full image would have in those rows.
+        uchar *dbits = dImage.bits();
+        const int dbpl = dImage.bytesPerLine();
+        auto paintBand = [&](int y1, int y2) {
+            const QImage source = sImage;
+            QImage band(dbits + qsizetype(y1) * dbpl, wd, y2 - y1, dbpl, target_format);
+            QPainter p(&band);
+            if (mode == Qt::SmoothTransformation) {
+                p.setRenderHint(QPainter::Antialiasing);
+                p.setRenderHint(QPainter::SmoothPixmapTransform);
+            }
+            p.setTransform(mat * QTransform::fromTranslate(0, -y1));
+            p.drawImage(QPoint(0, 0), source);
+        };
+        qt_processImageBands(hd, qt_imageBandCount(qint64(wd) * hd, hd), 1, paintBand);
     } else {
         bool invertible;
         mat = mat.inverted(&invertible);                // invert matrix
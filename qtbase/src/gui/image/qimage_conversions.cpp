@@ -211,17 +211,23 @@ void convert_generic(QImageData *dest, const QImageData *src, Qt::ImageConversio
 
 bool convert_generic_inplace(QImageData *data, QImage::Format dst_format, Qt::ImageConversionFlags flags)
 {
-    // Cannot be used with indexed formats or between formats with different pixel depths.
+    // Cannot be used with indexed formats or to formats with a larger pixel depth.
     Q_ASSERT(dst_format > QImage::Format_Indexed8);
     Q_ASSERT(data->format > QImage::Format_Indexed8);
-    if (data->depth != qt_depthForFormat(dst_format))
+    const int destDepth = qt_depthForFormat(dst_format);
+    if (destDepth > data->depth)
         return false;
+    // When the depth shrinks, every pixel and every line is written at an offset at or before
+    // the one it was read from, and each chunk is fetched before it is stored, so converting
+    // front to back never overwrites pixels that still have to be read.
+    const int destBytesPerLine = destDepth == data->depth ? data->bytes_per_line : ((data->width * destDepth + 31) >> 5) << 2;
 
     const int buffer_size = 2048;
     uint buffer[buffer_size];
     const QPixelLayout *srcLayout = &qPixelLayouts[data->format];
     const QPixelLayout *destLayout = &qPixelLayouts[dst_format];
     uchar *srcData = data->data;
+    uchar *destData = data->data;
 
     const FetchPixelsFunc fetch = qFetchPixels[srcLayout->bpp];
     const StorePixelsFunc store = qStorePixels[destLayout->bpp];
@@ -266,13 +272,23 @@ bool convert_generic_inplace(QImageData *data, QImage::Format dst_format, Qt::Im
             ptr = convertToARGB32PM(buffer, ptr, l, 0, ditherPtr);
             ptr = convertFromARGB32PM(buffer, ptr, l, 0, ditherPtr);
             // The conversions might be passthrough and not use the buffer, in that case we are already done.
-            if (srcData != (const uchar*)ptr)
-                store(srcData, ptr, x, l);
+            if (destData != (const uchar*)ptr)
+                store(destData, ptr, x, l);
             x += l;
         }
         srcData += data->bytes_per_line;
+        destData += destBytesPerLine;
     }
     data->format = dst_format;
+    if (destDepth != data->depth) {
+        data->depth = destDepth;
+        data->bytes_per_line = destBytesPerLine;
+        data->nbytes = qsizetype(destBytesPerLine) * data->height;
+        // Release the memory the image no longer needs; shrinking cannot fail in practice,
+        // and the old block is still valid if it does.
+        if (uchar *shrunk = (uchar *)realloc(data->data, data->nbytes))
+            data->data = shrunk;
+    }
     return true;
 }
 
@@ -431,6 +447,89 @@ static void convert_RGB888_to_RGB(QImageData *dest, const QImageData *src, Qt::I
     }
 }
 
+// Convert a scanline of RGB32 or RGBX8888 (src) to RGB888 (dest), ignoring the alpha channel.
+template <bool rgbx>
+static void QT_FASTCALL qt_convert_rgb32_to_rgb888(uchar *dest_data, const quint32 *src_data, int len)
+{
+    int pixel = 0;
+    // prolog: align output to 32bit
+    while ((quintptr(dest_data) & 0x3) && pixel < len) {
+        const QRgb p = rgbx ? RGBA2ARGB(*src_data) : *src_data;
+        dest_data[0] = qRed(p);
+        dest_data[1] = qGreen(p);
+        dest_data[2] = qBlue(p);
+        dest_data += 3;
+        ++src_data;
+        ++pixel;
+    }
+
+    // Handle 4 pixels at a time 16 bytes input to 12 bytes output.
+    for (; pixel + 3 < len; pixel += 4) {
+        const quint32 p0 = rgbx ? RGBA2ARGB(src_data[0]) : src_data[0];
+        const quint32 p1 = rgbx ? RGBA2ARGB(src_data[1]) : src_data[1];
+        const quint32 p2 = rgbx ? RGBA2ARGB(src_data[2]) : src_data[2];
+        const quint32 p3 = rgbx ? RGBA2ARGB(src_data[3]) : src_data[3];
+
+        quint32_be *dest_packed = reinterpret_cast<quint32_be *>(dest_data);
+        dest_packed[0] = (p0 << 8) | ((p1 >> 16) & 0xff);
+        dest_packed[1] = (p1 << 16) | ((p2 >> 8) & 0xffff);
+        dest_packed[2] = (p2 << 24) | (p3 & 0xffffff);
+
+        src_data += 4;
+        dest_data += 12;
+    }
+
+    // epilog: handle left over pixels
+    for (; pixel < len; ++pixel) {
+        const QRgb p = rgbx ? RGBA2ARGB(*src_data) : *src_data;
+        dest_data[0] = qRed(p);
+        dest_data[1] = qGreen(p);
+        dest_data[2] = qBlue(p);
+        dest_data += 3;
+        ++src_data;
+    }
+}
+
+typedef void (QT_FASTCALL *RgbToUcharConverter)(uchar *dst, const quint32 *src, int len);
+
+#if defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSSE3)
+extern void QT_FASTCALL qt_convert_rgb32_to_rgb888_ssse3(uchar *dst, const quint32 *src, int len);
+extern void QT_FASTCALL qt_convert_rgbx8888_to_rgb888_ssse3(uchar *dst, const quint32 *src, int len);
+#endif
+#if defined(__ARM_NEON__)
+extern void QT_FASTCALL qt_convert_rgb32_to_rgb888_neon(uchar *dst, const quint32 *src, int len);
+extern void QT_FASTCALL qt_convert_rgbx8888_to_rgb888_neon(uchar *dst, const quint32 *src, int len);
+#endif
+
+template <bool rgbx>
+static void convert_RGB_to_RGB888(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
+{
+    if (rgbx)
+        Q_ASSERT(src->format == QImage::Format_RGBX8888 || src->format == QImage::Format_RGBA8888);
+    else
+        Q_ASSERT(src->format == QImage::Format_RGB32 || src->format == QImage::Format_ARGB32);
+    Q_ASSERT(dest->format == QImage::Format_RGB888);
+    Q_ASSERT(src->width == dest->width);
+    Q_ASSERT(src->height == dest->height);
+
+    const quint32 *src_data = (quint32 *) src->data;
+    uchar *dest_data = dest->data;
+
+    RgbToUcharConverter line_converter = qt_convert_rgb32_to_rgb888<rgbx>;
+#if defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSSE3)
+    if (qCpuHasFeature(SSSE3))
+        line_converter = rgbx ? qt_convert_rgbx8888_to_rgb888_ssse3 : qt_convert_rgb32_to_rgb888_ssse3;
+#elif defined(__ARM_NEON__)
+    line_converter = rgbx ? qt_convert_rgbx8888_to_rgb888_neon : qt_convert_rgb32_to_rgb888_neon;
+#endif
+
+    for (int i = 0; i < src->height; ++i) {
+        line_converter(dest_data, src_data, src->width);
+        src_data = (const quint32 *)((const uchar*)src_data + src->bytes_per_line);
+        dest_data += dest->bytes_per_line;
+    }
+}
+
 #ifdef __SSE2__
 extern bool convert_ARGB_to_ARGB_PM_inplace_sse2(QImageData *data, Qt::ImageConversionFlags);
 #else
@@ -1919,6 +2018,87 @@ static void convert_Indexed8_to_Alpha8(QImageData *dest, const QImageData *src,
     }
 }
 
+// Convert a scanline of RGB32 or RGBX8888 (src) to Grayscale8 (dest) using qGray(), ignoring alpha.
+template <bool rgbx>
+static void QT_FASTCALL qt_convert_rgb32_to_grayscale8(uchar *dest_data, const quint32 *src_data, int len)
+{
+    for (int i = 0; i < len; ++i)
+        dest_data[i] = qGray(rgbx ? RGBA2ARGB(src_data[i]) : src_data[i]);
+}
+
+// Convert a scanline of Grayscale8 (src) to opaque RGB32 or RGBX8888 (dest).
+template <bool rgbx>
+static void QT_FASTCALL qt_convert_grayscale8_to_rgb32(quint32 *dest_data, const uchar *src_data, int len)
+{
+    for (int i = 0; i < len; ++i) {
+        const QRgb p = 0xff000000 | (src_data[i] * 0x010101);
+        dest_data[i] = rgbx ? ARGB2RGBA(p) : p;
+    }
+}
+
+typedef void (QT_FASTCALL *GrayscaleToRgbConverter)(quint32 *dst, const uchar *src, int len);
+
+#ifdef __SSE2__
+extern void QT_FASTCALL qt_convert_rgb32_to_grayscale8_sse2(uchar *dst, const quint32 *src, int len);
+extern void QT_FASTCALL qt_convert_rgbx8888_to_grayscale8_sse2(uchar *dst, const quint32 *src, int len);
+extern void QT_FASTCALL qt_convert_grayscale8_to_rgb32_sse2(quint32 *dst, const uchar *src, int len);
+#endif
+
+template <bool rgbx>
+static void convert_RGB_to_Grayscale8(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
+{
+    if (rgbx)
+        Q_ASSERT(src->format == QImage::Format_RGBX8888 || src->format == QImage::Format_RGBA8888);
+    else
+        Q_ASSERT(src->format == QImage::Format_RGB32 || src->format == QImage::Format_ARGB32);
+    Q_ASSERT(dest->format == QImage::Format_Grayscale8);
+    Q_ASSERT(src->width == dest->width);
+    Q_ASSERT(src->height == dest->height);
+
+    const quint32 *src_data = (quint32 *) src->data;
+    uchar *dest_data = dest->data;
+
+#ifdef __SSE2__
+    RgbToUcharConverter line_converter = rgbx ? qt_convert_rgbx8888_to_grayscale8_sse2 : qt_convert_rgb32_to_grayscale8_sse2;
+#else
+    RgbToUcharConverter line_converter = qt_convert_rgb32_to_grayscale8<rgbx>;
+#endif
+
+    for (int i = 0; i < src->height; ++i) {
+        line_converter(dest_data, src_data, src->width);
+        src_data = (const quint32 *)((const uchar*)src_data + src->bytes_per_line);
+        dest_data += dest->bytes_per_line;
+    }
+}
+
+template <bool rgbx>
+static void convert_Grayscale8_to_RGB(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
+{
+    Q_ASSERT(src->format == QImage::Format_Grayscale8);
+    if (rgbx)
+        Q_ASSERT(dest->format == QImage::Format_RGBX8888 || dest->format == QImage::Format_RGBA8888 || dest->format == QImage::Format_RGBA8888_Premultiplied);
+    else
+        Q_ASSERT(dest->format == QImage::Format_RGB32 || dest->format == QImage::Format_ARGB32 || dest->format == QImage::Format_ARGB32_Premultiplied);
+    Q_ASSERT(src->width == dest->width);
+    Q_ASSERT(src->height == dest->height);
+
+    const uchar *src_data = src->data;
+    quint32 *dest_data = (quint32 *) dest->data;
+
+    // An opaque gray RGBX8888 pixel has the same value as the RGB32 one on little endian.
+#if defined(__SSE2__) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    GrayscaleToRgbConverter line_converter = qt_convert_grayscale8_to_rgb32_sse2;
+#else
+    GrayscaleToRgbConverter line_converter = qt_convert_grayscale8_to_rgb32<rgbx>;
+#endif
+
+    for (int i = 0; i < src->height; ++i) {
+        line_converter(dest_data, src_data, src->width);
+        src_data += src->bytes_per_line;
+        dest_data = (quint32 *)((uchar*)dest_data + dest->bytes_per_line);
+    }
+}
+
 static void convert_Indexed8_to_Grayscale8(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
 {
     Q_ASSERT(src->format == QImage::Format_Indexed8);
@@ -2111,7 +2291,7 @@ Image_Converter qimage_converter_map[QImage::NImageFormats][QImage::NImageFormat
         0,
         0,
         0,
-        0,
+        convert_RGB_to_RGB888<false>,
         0,
         0,
         0,
@@ -2121,7 +2301,7 @@ Image_Converter qimage_converter_map[QImage::NImageFormats][QImage::NImageFormat
         0,
         convert_RGB_to_RGB30<PixelOrderRGB>,
         0,
-        0, 0
+        0, convert_RGB_to_Grayscale8<false>
     }, // Format_RGB32
 
     {
@@ -2138,7 +2318,7 @@ Image_Converter qimage_converter_map[QImage::NImageFormats][QImage::NImageFormat
         0,
         0,
         0,
-        0,
+        convert_RGB_to_RGB888<false>,
         0,
         0,
         convert_ARGB_to_RGBx,
@@ -2148,7 +2328,7 @@ Image_Converter qimage_converter_map[QImage::NImageFormats][QImage::NImageFormat
         0,
         convert_RGB_to_RGB30<PixelOrderRGB>,
         0,
-        0, 0
+        0, convert_RGB_to_Grayscale8<false>
     }, // Format_ARGB32
 
     {
@@ -2389,13 +2569,13 @@ Image_Converter qimage_converter_map[QImage::NImageFormats][QImage::NImageFormat
         0,
         0,
         0,
-        0,
+        convert_RGB_to_RGB888<true>,
         0,
         0,
         0,
         mask_alpha_converter_RGBx,
         mask_alpha_converter_RGBx,
-        0, 0, 0, 0, 0, 0
+        0, 0, 0, 0, 0, convert_RGB_to_Grayscale8<true>
     }, // Format_RGBX8888
     {
         0,
@@ -2411,7 +2591,7 @@ Image_Converter qimage_converter_map[QImage::NImageFormats][QImage::NImageFormat
         0,
         0,
         0,
-        0,
+        convert_RGB_to_RGB888<true>,
         0,
         0,
         mask_alpha_converter_RGBx,
@@ -2422,7 +2602,7 @@ Image_Converter qimage_converter_map[QImage::NImageFormats][QImage::NImageFormat
         0,
         0,
 #endif
-        0, 0, 0, 0, 0, 0
+        0, 0, 0, 0, 0, convert_RGB_to_Grayscale8<true>
     }, // Format_RGBA8888
 
     {
@@ -2576,6 +2756,9 @@ Image_Converter qimage_converter_map[QImage::NImageFormats][QImage::NImageFormat
         0,
         0,
         convert_Grayscale8_to_Indexed8,
+        convert_Grayscale8_to_RGB<false>,
+        convert_Grayscale8_to_RGB<false>,
+        convert_Grayscale8_to_RGB<false>,
         0,
         0,
         0,
@@ -2585,11 +2768,8 @@ Image_Converter qimage_converter_map[QImage::NImageFormats][QImage::NImageFormat
         0,
         0,
         0,
-        0,
-        0,
-        0,
-        0,
-        0, 0, 0, 0, 0, 0, 0
+        convert_Grayscale8_to_RGB<true>,
+        convert_Grayscale8_to_RGB<true>, convert_Grayscale8_to_RGB<true>, 0, 0, 0, 0, 0
     } // Format_Grayscale8
 };
 
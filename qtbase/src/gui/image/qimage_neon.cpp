@@ -40,6 +40,7 @@
 #include <qimage.h>
 #include <private/qimage_p.h>
 #include <private/qsimd_p.h>
+#include <private/qdrawhelper_p.h>
 
 #if defined(__ARM_NEON__)
 
@@ -133,6 +134,55 @@ void convert_RGB888_to_RGB32_neon(QImageData *dest, const QImageData *src, Qt::I
     }
 }
 
+// Convert a scanline of RGB32 or RGBX8888 (src) to RGB888 (dst)
+template <bool rgbx>
+static inline void qt_convert_to_rgb888_neon(uchar *dst, const quint32 *src, int len)
+{
+    int i = 0;
+
+    const uchar *src8 = reinterpret_cast<const uchar *>(src);
+    for (; i < (len - 15); i += 16) {
+        // vld4 deinterleaves the four bytes of 16 pixels, vst3 interleaves three of them again
+        const uint8x16x4_t srcVector = vld4q_u8(src8 + i * 4);
+        uint8x16x3_t dstVector;
+        if (rgbx) {
+            dstVector.val[0] = srcVector.val[0];
+            dstVector.val[1] = srcVector.val[1];
+            dstVector.val[2] = srcVector.val[2];
+        } else {
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+            dstVector.val[0] = srcVector.val[2];
+            dstVector.val[1] = srcVector.val[1];
+            dstVector.val[2] = srcVector.val[0];
+#else
+            dstVector.val[0] = srcVector.val[1];
+            dstVector.val[1] = srcVector.val[2];
+            dstVector.val[2] = srcVector.val[3];
+#endif
+        }
+        vst3q_u8(dst, dstVector);
+        dst += 48;
+    }
+
+    for (; i < len; ++i) {
+        const QRgb p = rgbx ? RGBA2ARGB(src[i]) : src[i];
+        dst[0] = qRed(p);
+        dst[1] = qGreen(p);
+        dst[2] = qBlue(p);
+        dst += 3;
+    }
+}
+
+Q_GUI_EXPORT void QT_FASTCALL qt_convert_rgb32_to_rgb888_neon(uchar *dst, const quint32 *src, int len)
+{
+    qt_convert_to_rgb888_neon<false>(dst, src, len);
+}
+
+Q_GUI_EXPORT void QT_FASTCALL qt_convert_rgbx8888_to_rgb888_neon(uchar *dst, const quint32 *src, int len)
+{
+    qt_convert_to_rgb888_neon<true>(dst, src, len);
+}
+
 QT_END_NAMESPACE
 
 #endif // defined(__ARM_NEON__)
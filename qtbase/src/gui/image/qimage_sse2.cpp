@@ -120,6 +120,70 @@ bool convert_ARGB_to_ARGB_PM_inplace_sse2(QImageData *data, Qt::ImageConversionF
     return true;
 }
 
+// Convert a scanline of RGB32 or RGBX8888 (src) to Grayscale8 (dst) with the
+// same weights as qGray(): (11 * red + 16 * green + 5 * blue) / 32.
+template <bool rgbx>
+static inline void qt_convert_to_grayscale8_sse2(uchar *dst, const quint32 *src, int len)
+{
+    int i = 0;
+
+    const __m128i colorMask = _mm_set1_epi32(0x00ff00ff);
+    // weights of the even bytes (blue and red for RGB32, red and blue for RGBX8888)
+    const __m128i evenWeights = rgbx ? _mm_set1_epi32(0x0005000b) : _mm_set1_epi32(0x000b0005);
+    // weight of green, alpha is ignored
+    const __m128i oddWeights = _mm_set1_epi32(0x00000010);
+
+    for (; i < (len - 15); i += 16) {
+        const __m128i *srcVectorPtr = reinterpret_cast<const __m128i *>(src + i);
+        __m128i gray[4];
+        for (int j = 0; j < 4; ++j) {
+            const __m128i srcVector = _mm_loadu_si128(srcVectorPtr + j);
+            const __m128i even = _mm_and_si128(srcVector, colorMask);
+            const __m128i odd = _mm_and_si128(_mm_srli_epi16(srcVector, 8), colorMask);
+            const __m128i sum = _mm_add_epi32(_mm_madd_epi16(even, evenWeights), _mm_madd_epi16(odd, oddWeights));
+            gray[j] = _mm_srli_epi32(sum, 5);
+        }
+        const __m128i low = _mm_packs_epi32(gray[0], gray[1]);
+        const __m128i high = _mm_packs_epi32(gray[2], gray[3]);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(low, high));
+    }
+
+    SIMD_EPILOGUE(i, len, 15)
+        dst[i] = qGray(rgbx ? RGBA2ARGB(src[i]) : src[i]);
+}
+
+void QT_FASTCALL qt_convert_rgb32_to_grayscale8_sse2(uchar *dst, const quint32 *src, int len)
+{
+    qt_convert_to_grayscale8_sse2<false>(dst, src, len);
+}
+
+void QT_FASTCALL qt_convert_rgbx8888_to_grayscale8_sse2(uchar *dst, const quint32 *src, int len)
+{
+    qt_convert_to_grayscale8_sse2<true>(dst, src, len);
+}
+
+// Convert a scanline of Grayscale8 (src) to opaque RGB32 (dst)
+void QT_FASTCALL qt_convert_grayscale8_to_rgb32_sse2(quint32 *dst, const uchar *src, int len)
+{
+    int i = 0;
+
+    const __m128i alphaMask = _mm_set1_epi32(0xff000000);
+
+    for (; i < (len - 15); i += 16) {
+        const __m128i srcVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i low = _mm_unpacklo_epi8(srcVector, srcVector);
+        const __m128i high = _mm_unpackhi_epi8(srcVector, srcVector);
+        __m128i *dstVectorPtr = reinterpret_cast<__m128i *>(dst + i);
+        _mm_storeu_si128(dstVectorPtr, _mm_or_si128(_mm_unpacklo_epi16(low, low), alphaMask));
+        _mm_storeu_si128(dstVectorPtr + 1, _mm_or_si128(_mm_unpackhi_epi16(low, low), alphaMask));
+        _mm_storeu_si128(dstVectorPtr + 2, _mm_or_si128(_mm_unpacklo_epi16(high, high), alphaMask));
+        _mm_storeu_si128(dstVectorPtr + 3, _mm_or_si128(_mm_unpackhi_epi16(high, high), alphaMask));
+    }
+
+    SIMD_EPILOGUE(i, len, 15)
+        dst[i] = 0xff000000 | (src[i] * 0x010101);
+}
+
 QT_END_NAMESPACE
 
 #endif // QT_COMPILER_SUPPORTS_SSE2
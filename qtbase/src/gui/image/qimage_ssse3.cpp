@@ -40,6 +40,7 @@
 #include <qimage.h>
 #include <private/qimage_p.h>
 #include <private/qsimd_p.h>
+#include <private/qdrawhelper_p.h>
 
 #ifdef QT_COMPILER_SUPPORTS_SSSE3
 
@@ -136,6 +137,57 @@ void convert_RGB888_to_RGB32_ssse3(QImageData *dest, const QImageData *src, Qt::
     }
 }
 
+// Convert a scanline of RGB32 or RGBX8888 (src) to RGB888 (dst)
+template <bool rgbx>
+static inline void qt_convert_to_rgb888_ssse3(uchar *dst, const quint32 *src, int len)
+{
+    int i = 0;
+
+    // Pack the color bytes of 4 pixels into the lower 12 bytes of a vector
+    const __m128i shuffleMask = rgbx
+            ? _mm_set_epi8(char(0xff), char(0xff), char(0xff), char(0xff), 14, 13, 12, 10, 9, 8, 6, 5, 4, 2, 1, 0)
+            : _mm_set_epi8(char(0xff), char(0xff), char(0xff), char(0xff), 12, 13, 14, 8, 9, 10, 4, 5, 6, 0, 1, 2);
+
+    for (; i < (len - 15); i += 16) { // one iteration in the loop converts 16 pixels
+        /*
+         Each 4 pixel input vector is packed into the lower 12 bytes of a vector
+         with pshufb, and three output vectors are then assembled from four
+         packed vectors with byte shifts.
+         */
+        const __m128i *inVectorPtr = reinterpret_cast<const __m128i *>(src + i);
+        const __m128i v0 = _mm_shuffle_epi8(_mm_loadu_si128(inVectorPtr), shuffleMask);
+        const __m128i v1 = _mm_shuffle_epi8(_mm_loadu_si128(inVectorPtr + 1), shuffleMask);
+        const __m128i v2 = _mm_shuffle_epi8(_mm_loadu_si128(inVectorPtr + 2), shuffleMask);
+        const __m128i v3 = _mm_shuffle_epi8(_mm_loadu_si128(inVectorPtr + 3), shuffleMask);
+
+        __m128i *dstVectorPtr = reinterpret_cast<__m128i *>(dst);
+        _mm_storeu_si128(dstVectorPtr, _mm_or_si128(v0, _mm_slli_si128(v1, 12)));
+        _mm_storeu_si128(dstVectorPtr + 1, _mm_or_si128(_mm_srli_si128(v1, 4), _mm_slli_si128(v2, 8)));
+        _mm_storeu_si128(dstVectorPtr + 2, _mm_or_si128(_mm_srli_si128(v2, 8), _mm_slli_si128(v3, 4)));
+        dst += 48;
+    }
+
+    SIMD_EPILOGUE(i, len, 15) {
+        const QRgb p = rgbx ? RGBA2ARGB(src[i]) : src[i];
+        dst[0] = qRed(p);
+        dst[1] = qGreen(p);
+        dst[2] = qBlue(p);
+        dst += 3;
+    }
+}
+
+// Convert a scanline of RGB32 (src) to RGB888 (dst)
+Q_GUI_EXPORT void QT_FASTCALL qt_convert_rgb32_to_rgb888_ssse3(uchar *dst, const quint32 *src, int len)
+{
+    qt_convert_to_rgb888_ssse3<false>(dst, src, len);
+}
+
+// Convert a scanline of RGBX8888 (src) to RGB888 (dst)
+Q_GUI_EXPORT void QT_FASTCALL qt_convert_rgbx8888_to_rgb888_ssse3(uchar *dst, const quint32 *src, int len)
+{
+    qt_convert_to_rgb888_ssse3<true>(dst, src, len);
+}
+
 QT_END_NAMESPACE
 
 #endif // QT_COMPILER_SUPPORTS_SSSE3
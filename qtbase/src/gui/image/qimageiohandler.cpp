@@ -264,6 +264,7 @@
 */
 
 #include "qimageiohandler.h"
+#include "qimageiohandler_p.h"
 
 #include <qbytearray.h>
 #include <qimage.h>
@@ -273,22 +274,11 @@ QT_BEGIN_NAMESPACE
 
 class QIODevice;
 
-class QImageIOHandlerPrivate
-{
-    Q_DECLARE_PUBLIC(QImageIOHandler)
-public:
-    QImageIOHandlerPrivate(QImageIOHandler *q);
-    virtual ~QImageIOHandlerPrivate();
-
-    QIODevice *device;
-    mutable QByteArray format;
-
-    QImageIOHandler *q_ptr;
-};
-
 QImageIOHandlerPrivate::QImageIOHandlerPrivate(QImageIOHandler *q)
 {
     device = 0;
+    rowsDecoded = 0;
+    rowsDecodedData = 0;
     q_ptr = q;
 }
 
@@ -154,6 +154,7 @@
 
 // for qt_getImageText
 #include <private/qimage_p.h>
+#include <private/qimageiohandler_p.h>
 
 // image handlers
 #include <private/qbmphandler_p.h>
@@ -517,6 +518,8 @@ public:
     int quality;
     QMap<QString, QString> text;
     void getText();
+    QImageReader::RowsDecodedFunction rowsDecoded;
+    void *rowsDecodedData;
     enum {
         UsePluginDefault,
         ApplyTransform,
@@ -540,6 +543,8 @@ QImageReaderPrivate::QImageReaderPrivate(QImageReader *qq)
     deleteDevice = false;
     handler = 0;
     quality = -1;
+    rowsDecoded = 0;
+    rowsDecodedData = 0;
     imageReaderError = QImageReader::UnknownError;
     autoTransform = UsePluginDefault;
 
@@ -1200,6 +1205,55 @@ void QImageReader::setGamma(float gamma)
         d->handler->setOption(QImageIOHandler::Gamma, gamma);
 }
 
+/*!
+    \typedef QImageReader::RowsDecodedFunction
+    \since 5.11
+
+    A function with the following signature that can be passed to
+    setRowsDecodedFunction():
+
+    \code
+    void myRowsDecoded(const QImage &image, int y, int rowCount, void *userData);
+    \endcode
+*/
+
+/*!
+    \since 5.11
+
+    Sets \a function to be called while read() decodes an image, each time
+    another \a rowCount rows starting at row \a y of the image are
+    available. \a userData is passed on to every call. Pass a null
+    \a function to stop being notified.
+
+    The image passed to the function is the one being decoded, before any
+    clipping, scaling or transformation read() applies afterwards. Rows
+    that have not been reported yet have undefined contents. Interlaced
+    images report the whole image after each pass, so a coarse version
+    can be shown before the full resolution is available. The function is
+    called from the thread calling read() and must not modify the image.
+
+    Only image formats that decode incrementally call the function; the
+    PNG reader does so when no scaled size is set.
+
+    \sa rowsDecodedFunction(), read()
+*/
+void QImageReader::setRowsDecodedFunction(RowsDecodedFunction function, void *userData)
+{
+    d->rowsDecoded = function;
+    d->rowsDecodedData = userData;
+}
+
+/*!
+    \since 5.11
+
+    Returns the function set with setRowsDecodedFunction(), or a null
+    pointer if none is set.
+*/
+QImageReader::RowsDecodedFunction QImageReader::rowsDecodedFunction() const
+{
+    return d->rowsDecoded;
+}
+
 /*!
     \since 5.6
 
@@ -1308,6 +1362,9 @@ bool QImageReader::read(QImage *image)
         d->handler->setOption(QImageIOHandler::ScaledClipRect, d->scaledClipRect);
     if (d->handler->supportsOption(QImageIOHandler::Quality))
         d->handler->setOption(QImageIOHandler::Quality, d->quality);
+    QImageIOHandlerPrivate *handlerPrivate = QImageIOHandlerPrivate::get(d->handler);
+    handlerPrivate->rowsDecoded = d->rowsDecoded;
+    handlerPrivate->rowsDecodedData = d->rowsDecodedData;
 
     // read the image
     if (!d->handler->read(image)) {
@@ -68,6 +68,8 @@ public:
         InvalidDataError
     };
 
+    typedef void (*RowsDecodedFunction)(const QImage &image, int y, int rowCount, void *userData);
+
     QImageReader();
     explicit QImageReader(QIODevice *device, const QByteArray &format = QByteArray());
     explicit QImageReader(const QString &fileName, const QByteArray &format = QByteArray());
@@ -120,6 +122,9 @@ public:
     void setGamma(float gamma);
     float gamma() const;
 
+    void setRowsDecodedFunction(RowsDecodedFunction function, void *userData = Q_NULLPTR);
+    RowsDecodedFunction rowsDecodedFunction() const;
+
     QByteArray subType() const;
     QList<QByteArray> supportedSubTypes() const;
 
@@ -192,6 +192,10 @@
 
 QT_BEGIN_NAMESPACE
 
+// In CacheNone mode, animations whose decoded frames fit into this many
+// bytes are kept in memory after the first iteration.
+static const qint64 MaxLoopCacheBytes = 8 * 1024 * 1024;
+
 class QFrameInfo
 {
 public:
@@ -262,6 +266,7 @@ public:
     bool haveReadAll;
     bool isFirstIteration;
     QMap<int, QFrameInfo> frameMap;
+    qint64 frameMapBytes;
     QString absoluteFilePath;
 
     QTimer nextImageTimer;
@@ -273,7 +278,8 @@ QMoviePrivate::QMoviePrivate(QMovie *qq)
     : reader(0), speed(100), movieState(QMovie::NotRunning),
       currentFrameNumber(-1), nextFrameNumber(0), greatestFrameNumber(-1),
       nextDelay(0), playCounter(-1),
-      cacheMode(QMovie::CacheNone), haveReadAll(false), isFirstIteration(true)
+      cacheMode(QMovie::CacheNone), haveReadAll(false), isFirstIteration(true),
+      frameMapBytes(0)
 {
     q_ptr = qq;
     nextImageTimer.setSingleShot(true);
@@ -294,6 +300,7 @@ void QMoviePrivate::reset()
     haveReadAll = false;
     isFirstIteration = true;
     frameMap.clear();
+    frameMapBytes = 0;
 }
 
 /*! \internal
@@ -342,6 +349,10 @@ QFrameInfo QMoviePrivate::infoForFrame(int frameNumber)
     }
 
     if (cacheMode == QMovie::CacheNone) {
+        // Short animations are kept from their first iteration on, so that
+        // looping neither decodes them again nor recreates the reader.
+        if (haveReadAll && frameMap.size() == greatestFrameNumber + 1)
+            return frameMap.value(frameNumber);
         if (frameNumber != currentFrameNumber+1) {
             // Non-sequential frame access
             if (!reader->jumpToImage(frameNumber)) {
@@ -381,7 +392,21 @@ QFrameInfo QMoviePrivate::infoForFrame(int frameNumber)
                 greatestFrameNumber = frameNumber;
             QPixmap aPixmap = QPixmap::fromImage(anImage);
             int aDelay = reader->nextImageDelay();
-            return QFrameInfo(aPixmap, aDelay);
+            QFrameInfo info(aPixmap, aDelay);
+            if (frameMapBytes >= 0) {
+                // Only cache an uninterrupted run of frames from the start
+                if (frameNumber == frameMap.size())
+                    frameMapBytes += qint64(anImage.sizeInBytes());
+                else
+                    frameMapBytes = -1;
+                if (frameMapBytes >= 0 && frameMapBytes <= MaxLoopCacheBytes) {
+                    frameMap.insert(frameNumber, info);
+                } else {
+                    frameMap.clear();
+                    frameMapBytes = -1;
+                }
+            }
+            return info;
         } else if (frameNumber != 0) {
             // We've read all frames now. Return an end marker
             haveReadAll = true;
@@ -1046,6 +1071,10 @@ QList<QByteArray> QMovie::supportedFormats()
     frames, at the added memory cost of keeping the frames in memory for the
     lifetime of the object.
 
+    With \l CacheNone, QMovie still keeps the frames of a short animation
+    once it has been played through, as long as they take up only a few
+    megabytes. Looping such an animation then does not decode it again.
+
     By default, this property is set to \l CacheNone.
 
     \sa QMovie::CacheMode
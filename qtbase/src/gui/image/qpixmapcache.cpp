@@ -43,6 +43,12 @@
 #include "qdebug.h"
 #include "qpixmapcache_p.h"
 
+#if QT_CONFIG(sharedmemory)
+#include <private/qsharedmemory_p.h>
+#include <qvarlengtharray.h>
+#include <algorithm>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -83,6 +89,14 @@ QT_BEGIN_NAMESPACE
     with QPixmapCache} explains how to use QPixmapCache to speed up
     applications by caching the results of painting.
 
+    Since Qt 5.11, pixmaps inserted with a string key can also be shared
+    between processes with attachSharedCache(). Every process attached to
+    the same key stores its string-keyed pixmaps in a shared memory segment
+    as well, and a lookup that misses the process-local cache is served from
+    that segment before it is reported as a miss. This avoids decoding the
+    same icons and theme images in every process of a multi-process
+    application. statistics() reports how well the cache is doing.
+
     \sa QCache, QPixmap
 */
 
@@ -186,6 +200,240 @@ QPixmapCache::Key &QPixmapCache::Key::operator =(const Key &other)
     return *this;
 }
 
+#if QT_CONFIG(sharedmemory)
+/*
+  A QSharedMemory segment holding images shared by all processes attached to
+  the same key. It is laid out as a header, a fixed table of entry slots and
+  a data area, and every access is serialized with QSharedMemory::lock().
+  The data of an entry is the UTF-16 key followed by the image bits. Space is
+  allocated first-fit between the live entries; when nothing fits, the least
+  recently used entry according to a clock shared by all processes is evicted.
+*/
+class QSharedPixmapArena
+{
+public:
+    explicit QSharedPixmapArena(const QString &key) : memory(key) {}
+
+    bool attach(int size);
+    bool isAttached() const { return memory.isAttached(); }
+
+    bool insert(const QString &key, const QImage &image);
+    QImage find(const QString &key);
+    void remove(const QString &key);
+    void usage(qint64 *bytes, int *count);
+
+private:
+    enum { Magic = 0x51504d43, Version = 1, SlotCount = 512, Alignment = 16 };
+
+    struct Header
+    {
+        quint32 magic;
+        quint32 version;
+        quint32 size;
+        quint32 dataOffset;
+        quint64 clock;
+    };
+
+    struct Entry
+    {
+        quint64 lastUsed;
+        double devicePixelRatio;
+        uint hash;
+        quint32 offset;
+        quint32 length;
+        quint32 keyLength;
+        qint32 width;
+        qint32 height;
+        qint32 bytesPerLine;
+        qint32 format;
+    };
+
+    static quint32 align(qint64 n) { return quint32((n + Alignment - 1) & ~qint64(Alignment - 1)); }
+
+    Header *header() { return static_cast<Header *>(memory.data()); }
+    Entry *entries() { return reinterpret_cast<Entry *>(header() + 1); }
+    uchar *data() { return static_cast<uchar *>(memory.data()); }
+
+    int indexOf(const QString &key, uint hash);
+    int evictLeastRecentlyUsed();
+    quint32 allocate(quint32 length);
+
+    QSharedMemory memory;
+};
+
+bool QSharedPixmapArena::attach(int size)
+{
+    if (!memory.create(size) && (memory.error() != QSharedMemory::AlreadyExists || !memory.attach())) {
+        qWarning("QPixmapCache: Unable to attach the shared cache: %s", qPrintable(memory.errorString()));
+        return false;
+    }
+
+    const quint32 dataOffset = align(sizeof(Header) + SlotCount * sizeof(Entry));
+    if (memory.size() <= int(dataOffset)) {
+        qWarning("QPixmapCache: The shared cache is too small");
+        memory.detach();
+        return false;
+    }
+
+    // The segment may have been created by another process that did not get
+    // to initialize it yet, so whoever locks it first sets it up
+    QSharedMemoryLocker locker(&memory);
+    if (!locker.lock())
+        return false;
+    Header *h = header();
+    if (h->magic != Magic || h->version != Version) {
+        memset(memory.data(), 0, dataOffset);
+        h->magic = Magic;
+        h->version = Version;
+        h->size = memory.size();
+        h->dataOffset = dataOffset;
+    }
+    return true;
+}
+
+int QSharedPixmapArena::indexOf(const QString &key, uint hash)
+{
+    Entry *e = entries();
+    for (int i = 0; i < SlotCount; ++i) {
+        if (e[i].length && e[i].hash == hash && e[i].keyLength == uint(key.size())
+            && memcmp(data() + e[i].offset, key.constData(), key.size() * sizeof(QChar)) == 0)
+            return i;
+    }
+    return -1;
+}
+
+int QSharedPixmapArena::evictLeastRecentlyUsed()
+{
+    Entry *e = entries();
+    int lru = -1;
+    for (int i = 0; i < SlotCount; ++i) {
+        if (e[i].length && (lru < 0 || e[i].lastUsed < e[lru].lastUsed))
+            lru = i;
+    }
+    if (lru >= 0)
+        e[lru].length = 0;
+    return lru;
+}
+
+quint32 QSharedPixmapArena::allocate(quint32 length)
+{
+    Entry *e = entries();
+    QVarLengthArray<QPair<quint32, quint32>, SlotCount> used;
+    for (int i = 0; i < SlotCount; ++i) {
+        if (e[i].length)
+            used.append(qMakePair(e[i].offset, e[i].length));
+    }
+    std::sort(used.begin(), used.end());
+
+    const Header *h = header();
+    quint32 offset = h->dataOffset;
+    for (int i = 0; i < used.size(); ++i) {
+        if (used.at(i).first - offset >= length)
+            return offset;
+        offset = used.at(i).first + used.at(i).second;
+    }
+    return h->size - offset >= length ? offset : 0;
+}
+
+bool QSharedPixmapArena::insert(const QString &key, const QImage &image)
+{
+    if (image.isNull())
+        return false;
+
+    const quint32 imageOffset = align(key.size() * sizeof(QChar));
+    const qint64 length = qint64(imageOffset) + image.sizeInBytes();
+    const uint hash = qHash(key);
+
+    QSharedMemoryLocker locker(&memory);
+    if (!locker.lock())
+        return false;
+    Header *h = header();
+    if (length > h->size - h->dataOffset)
+        return false;
+
+    Entry *e = entries();
+    int slot = indexOf(key, hash);
+    if (slot >= 0)
+        e[slot].length = 0;
+    for (int i = 0; slot < 0 && i < SlotCount; ++i) {
+        if (!e[i].length)
+            slot = i;
+    }
+    if (slot < 0)
+        slot = evictLeastRecentlyUsed();
+
+    quint32 offset;
+    while (!(offset = allocate(align(length)))) {
+        if (evictLeastRecentlyUsed() < 0)
+            return false;
+    }
+
+    memcpy(data() + offset, key.constData(), key.size() * sizeof(QChar));
+    memcpy(data() + offset + imageOffset, image.constBits(), image.sizeInBytes());
+
+    Entry &entry = e[slot];
+    entry.lastUsed = ++h->clock;
+    entry.devicePixelRatio = image.devicePixelRatio();
+    entry.hash = hash;
+    entry.offset = offset;
+    entry.length = align(length);
+    entry.keyLength = key.size();
+    entry.width = image.width();
+    entry.height = image.height();
+    entry.bytesPerLine = image.bytesPerLine();
+    entry.format = image.format();
+    return true;
+}
+
+QImage QSharedPixmapArena::find(const QString &key)
+{
+    QSharedMemoryLocker locker(&memory);
+    if (!locker.lock())
+        return QImage();
+
+    const int slot = indexOf(key, qHash(key));
+    if (slot < 0)
+        return QImage();
+
+    // The entry may be evicted by any process as soon as we unlock, so copy it out
+    Entry &entry = entries()[slot];
+    entry.lastUsed = ++header()->clock;
+    const uchar *bits = data() + entry.offset + align(entry.keyLength * sizeof(QChar));
+    QImage image = QImage(bits, entry.width, entry.height, entry.bytesPerLine,
+                          QImage::Format(entry.format)).copy();
+    image.setDevicePixelRatio(entry.devicePixelRatio);
+    return image;
+}
+
+void QSharedPixmapArena::remove(const QString &key)
+{
+    QSharedMemoryLocker locker(&memory);
+    if (!locker.lock())
+        return;
+
+    const int slot = indexOf(key, qHash(key));
+    if (slot >= 0)
+        entries()[slot].length = 0;
+}
+
+void QSharedPixmapArena::usage(qint64 *bytes, int *count)
+{
+    *bytes = 0;
+    *count = 0;
+    QSharedMemoryLocker locker(&memory);
+    if (!locker.lock())
+        return;
+
+    const Entry *e = entries();
+    for (int i = 0; i < SlotCount; ++i) {
+        if (e[i].length) {
+            *bytes += e[i].length;
+            ++*count;
+        }
+    }
+}
+#endif // QT_CONFIG(sharedmemory)
+
 class QPMCache : public QObject, public QCache<QPixmapCache::Key, QPixmapCacheEntry>
 {
     Q_OBJECT
@@ -215,6 +463,13 @@ public:
 
     bool flushDetachedPixmaps(bool nt);
 
+    qint64 hits;
+    qint64 misses;
+    qint64 sharedHits;
+#if QT_CONFIG(sharedmemory)
+    QScopedPointer<QSharedPixmapArena> sharedArena;
+#endif
+
 private:
     enum { soon_time = 10000, flush_time = 30000 };
     int *keyArray;
@@ -238,6 +493,7 @@ uint qHash(const QPixmapCache::Key &k)
 QPMCache::QPMCache()
     : QObject(0),
       QCache<QPixmapCache::Key, QPixmapCacheEntry>(cache_limit * 1024),
+      hits(0), misses(0), sharedHits(0),
       keyArray(0), theid(0), ps(0), keyArraySize(0), freeKey(0), t(false)
 {
 }
@@ -459,6 +715,34 @@ QPixmapCacheEntry::~QPixmapCacheEntry()
     pm_cache()->releaseKey(key);
 }
 
+static inline int qt_pixmap_cost(const QPixmap &pixmap)
+{
+    return pixmap.width() * pixmap.height() * pixmap.depth() / 8;
+}
+
+static QPixmap *qt_find_pixmap(const QString &key)
+{
+    QPMCache *cache = pm_cache();
+    QPixmap *ptr = cache->object(key);
+#if QT_CONFIG(sharedmemory)
+    if (!ptr && cache->sharedArena) {
+        const QImage image = cache->sharedArena->find(key);
+        if (!image.isNull()) {
+            const QPixmap pixmap = QPixmap::fromImage(image);
+            if (cache->insert(key, pixmap, qt_pixmap_cost(pixmap))) {
+                ptr = cache->object(key);
+                ++cache->sharedHits;
+            }
+        }
+    }
+#endif
+    if (ptr)
+        ++cache->hits;
+    else
+        ++cache->misses;
+    return ptr;
+}
+
 /*!
     \obsolete
     \overload
@@ -477,7 +761,7 @@ QPixmapCacheEntry::~QPixmapCacheEntry()
 
 QPixmap *QPixmapCache::find(const QString &key)
 {
-    return pm_cache()->object(key);
+    return qt_find_pixmap(key);
 }
 
 
@@ -505,7 +789,7 @@ bool QPixmapCache::find(const QString &key, QPixmap& pixmap)
 
 bool QPixmapCache::find(const QString &key, QPixmap* pixmap)
 {
-    QPixmap *ptr = pm_cache()->object(key);
+    QPixmap *ptr = qt_find_pixmap(key);
     if (ptr && pixmap)
         *pixmap = *ptr;
     return ptr != 0;
@@ -523,9 +807,15 @@ bool QPixmapCache::find(const QString &key, QPixmap* pixmap)
 bool QPixmapCache::find(const Key &key, QPixmap* pixmap)
 {
     //The key is not valid anymore, a flush happened before probably
-    if (!key.d || !key.d->isValid)
+    if (!key.d || !key.d->isValid) {
+        ++pm_cache()->misses;
         return false;
+    }
     QPixmap *ptr = pm_cache()->object(key);
+    if (ptr)
+        ++pm_cache()->hits;
+    else
+        ++pm_cache()->misses;
     if (ptr && pixmap)
         *pixmap = *ptr;
     return ptr != 0;
@@ -548,12 +838,20 @@ bool QPixmapCache::find(const Key &key, QPixmap* pixmap)
     The function returns \c true if the object was inserted into the
     cache; otherwise it returns \c false.
 
-    \sa setCacheLimit()
+    If a shared cache is attached, the pixmap is also made available to
+    the other processes attached to it.
+
+    \sa setCacheLimit(), attachSharedCache()
 */
 
 bool QPixmapCache::insert(const QString &key, const QPixmap &pixmap)
 {
-    return pm_cache()->insert(key, pixmap, pixmap.width() * pixmap.height() * pixmap.depth() / 8);
+    QPMCache *cache = pm_cache();
+#if QT_CONFIG(sharedmemory)
+    if (cache->sharedArena)
+        cache->sharedArena->insert(key, pixmap.toImage());
+#endif
+    return cache->insert(key, pixmap, qt_pixmap_cost(pixmap));
 }
 
 /*!
@@ -573,7 +871,7 @@ bool QPixmapCache::insert(const QString &key, const QPixmap &pixmap)
 */
 QPixmapCache::Key QPixmapCache::insert(const QPixmap &pixmap)
 {
-    return pm_cache()->insert(pixmap, pixmap.width() * pixmap.height() * pixmap.depth() / 8);
+    return pm_cache()->insert(pixmap, qt_pixmap_cost(pixmap));
 }
 
 /*!
@@ -590,7 +888,7 @@ bool QPixmapCache::replace(const Key &key, const QPixmap &pixmap)
     //The key is not valid anymore, a flush happened before probably
     if (!key.d || !key.d->isValid)
         return false;
-    return pm_cache()->replace(key, pixmap, pixmap.width() * pixmap.height() * pixmap.depth() / 8);
+    return pm_cache()->replace(key, pixmap, qt_pixmap_cost(pixmap));
 }
 
 /*!
@@ -622,10 +920,17 @@ void QPixmapCache::setCacheLimit(int n)
 
 /*!
   Removes the pixmap associated with \a key from the cache.
+
+  If a shared cache is attached, the pixmap is removed from it as well.
 */
 void QPixmapCache::remove(const QString &key)
 {
-    pm_cache()->remove(key);
+    QPMCache *cache = pm_cache();
+#if QT_CONFIG(sharedmemory)
+    if (cache->sharedArena)
+        cache->sharedArena->remove(key);
+#endif
+    cache->remove(key);
 }
 
 /*!
@@ -644,6 +949,9 @@ void QPixmapCache::remove(const Key &key)
 
 /*!
     Removes all pixmaps from the cache.
+
+    Pixmaps stored in an attached shared cache are left alone, since other
+    processes may still be using them.
 */
 
 void QPixmapCache::clear()
@@ -657,6 +965,169 @@ void QPixmapCache::clear()
     }
 }
 
+/*!
+    \class QPixmapCache::Statistics
+    \inmodule QtGui
+    \since 5.11
+
+    \brief The QPixmapCache::Statistics struct describes the usage of the
+    pixmap cache.
+
+    \sa QPixmapCache::statistics()
+*/
+
+/*!
+    \variable QPixmapCache::Statistics::hits
+    \brief the number of lookups that found a pixmap, including those
+    served from the shared cache
+*/
+
+/*!
+    \variable QPixmapCache::Statistics::misses
+    \brief the number of lookups that did not find a pixmap
+*/
+
+/*!
+    \variable QPixmapCache::Statistics::sharedHits
+    \brief the number of lookups that missed the process-local cache but
+    were served from the shared cache
+*/
+
+/*!
+    \variable QPixmapCache::Statistics::bytes
+    \brief the approximate number of bytes used by the pixmaps in the
+    process-local cache
+*/
+
+/*!
+    \variable QPixmapCache::Statistics::sharedBytes
+    \brief the number of bytes used in the shared cache by all attached
+    processes, or 0 if no shared cache is attached
+*/
+
+/*!
+    \variable QPixmapCache::Statistics::count
+    \brief the number of pixmaps in the process-local cache
+*/
+
+/*!
+    \variable QPixmapCache::Statistics::sharedCount
+    \brief the number of images in the shared cache
+*/
+
+/*!
+    \since 5.11
+
+    Returns the hit and miss counts of this process since the cache was
+    created or resetStatistics() was last called, together with the current
+    size of the cache.
+
+    \sa resetStatistics()
+*/
+QPixmapCache::Statistics QPixmapCache::statistics()
+{
+    QPMCache *cache = pm_cache();
+    Statistics stats;
+    stats.hits = cache->hits;
+    stats.misses = cache->misses;
+    stats.sharedHits = cache->sharedHits;
+    stats.bytes = cache->totalCost();
+    stats.count = cache->size();
+    stats.sharedBytes = 0;
+    stats.sharedCount = 0;
+#if QT_CONFIG(sharedmemory)
+    if (cache->sharedArena)
+        cache->sharedArena->usage(&stats.sharedBytes, &stats.sharedCount);
+#endif
+    return stats;
+}
+
+/*!
+    \since 5.11
+
+    Resets the hit and miss counts returned by statistics() to zero.
+*/
+void QPixmapCache::resetStatistics()
+{
+    QPMCache *cache = pm_cache();
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->sharedHits = 0;
+}
+
+/*!
+    \since 5.11
+
+    Attaches the pixmap cache to the shared memory segment identified by
+    \a key, creating it with a size of \a sizeInKilobytes if no other
+    process did so yet. Returns \c true on success; otherwise prints a
+    warning and returns \c false.
+
+    While attached, pixmaps inserted with a string key are also stored in the
+    shared segment, and lookups by string key that miss the process-local
+    cache are served from it. When the segment is full, the least recently
+    used images of all attached processes are evicted. Pixmaps inserted with
+    a QPixmapCache::Key stay local to the process.
+
+    The size limit of the shared segment is independent of cacheLimit().
+    Pixmaps are converted to QImage to be shared, so a shared lookup costs a
+    copy of the image data, but no decoding.
+
+    \note This function is not available on platforms without shared memory
+    support, where it always returns \c false.
+
+    \sa detachSharedCache(), QSharedMemory
+*/
+bool QPixmapCache::attachSharedCache(const QString &key, int sizeInKilobytes)
+{
+#if QT_CONFIG(sharedmemory)
+    QPMCache *cache = pm_cache();
+    QScopedPointer<QSharedPixmapArena> arena(new QSharedPixmapArena(key));
+    if (!arena->attach(sizeInKilobytes * 1024))
+        return false;
+    cache->sharedArena.swap(arena);
+    return true;
+#else
+    Q_UNUSED(key);
+    Q_UNUSED(sizeInKilobytes);
+    return false;
+#endif
+}
+
+/*!
+    \since 5.11
+
+    Detaches the pixmap cache from the shared memory segment. Pixmaps that
+    were already found in it remain in the process-local cache. The segment
+    is destroyed when the last process detaches from it.
+
+    \sa attachSharedCache()
+*/
+void QPixmapCache::detachSharedCache()
+{
+#if QT_CONFIG(sharedmemory)
+    if (pm_cache.exists())
+        pm_cache->sharedArena.reset();
+#endif
+}
+
+/*!
+    \since 5.11
+
+    Returns \c true if the pixmap cache is attached to a shared memory
+    segment; otherwise returns \c false.
+
+    \sa attachSharedCache()
+*/
+bool QPixmapCache::isSharedCacheAttached()
+{
+#if QT_CONFIG(sharedmemory)
+    return pm_cache.exists() && pm_cache->sharedArena;
+#else
+    return false;
+#endif
+}
+
 void QPixmapCache::flushDetachedPixmaps()
 {
     pm_cache()->flushDetachedPixmaps(true);
@@ -74,6 +74,17 @@ public:
         friend class QPixmapCache;
     };
 
+    struct Statistics
+    {
+        qint64 hits;
+        qint64 misses;
+        qint64 sharedHits;
+        qint64 bytes;
+        qint64 sharedBytes;
+        int count;
+        int sharedCount;
+    };
+
     static int cacheLimit();
     static void setCacheLimit(int);
     static QPixmap *find(const QString &key);
@@ -87,6 +98,13 @@ public:
     static void remove(const Key &key);
     static void clear();
 
+    static Statistics statistics();
+    static void resetStatistics();
+
+    static bool attachSharedCache(const QString &key, int sizeInKilobytes);
+    static void detachSharedCache();
+    static bool isSharedCacheAttached();
+
 #ifdef Q_TEST_QPIXMAPCACHE
     static void flushDetachedPixmaps();
     static int totalUsed();
@@ -50,6 +50,7 @@
 #include <qvector.h>
 
 #include <private/qimage_p.h> // for qt_getImageText
+#include <private/qimageiohandler_p.h>
 
 #include <png.h>
 #include <pngconf.h>
@@ -611,7 +612,26 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
         for (uint y = 0; y < height; y++)
             amp.row_pointers[y] = data + y * bpl;
 
-        png_read_image(png_ptr, amp.row_pointers);
+        const QImageIOHandlerPrivate *handlerPrivate = QImageIOHandlerPrivate::get(q);
+        if (!handlerPrivate->reportsRowsDecoded()) {
+            png_read_image(png_ptr, amp.row_pointers);
+        } else if (png_get_interlace_type(png_ptr, info_ptr) != PNG_INTERLACE_NONE) {
+            // Report the whole image after every pass. Passing the rows as the
+            // display rows makes libpng fill in the pixels not decoded yet.
+            const int passes = png_set_interlace_handling(png_ptr);
+            for (int pass = 0; pass < passes; ++pass) {
+                png_read_rows(png_ptr, 0, amp.row_pointers, height);
+                handlerPrivate->reportRowsDecoded(*outImage, 0, height);
+            }
+        } else {
+            // Report rows in small batches as they are decoded.
+            const png_uint_32 batchSize = 16;
+            for (png_uint_32 y = 0; y < height; y += batchSize) {
+                const png_uint_32 count = qMin(batchSize, height - y);
+                png_read_rows(png_ptr, amp.row_pointers + y, 0, count);
+                handlerPrivate->reportRowsDecoded(*outImage, y, count);
+            }
+        }
         amp.deallocate();
 
         outImage->setDotsPerMeterX(png_get_x_pixels_per_meter(png_ptr,info_ptr));
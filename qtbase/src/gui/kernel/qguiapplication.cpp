@@ -55,6 +55,7 @@
 #include <QtCore/QAbstractEventDispatcher>
 #include <QtCore/QVariant>
 #include <QtCore/private/qcoreapplication_p.h>
+#include <QtCore/private/qstartuptrace_p.h>
 #include <QtCore/private/qabstracteventdispatcher_p.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/private/qthread_p.h>
@@ -1237,6 +1238,8 @@ static void init_plugins(const QList<QByteArray> &pluginList)
 
 void QGuiApplicationPrivate::createPlatformIntegration()
 {
+    QStartupTraceScope trace("QGuiApplicationPrivate::createPlatformIntegration");
+
     QHighDpiScaling::initHighDpiScaling();
 
     // Load the platform integration
@@ -1798,6 +1801,10 @@ void QGuiApplicationPrivate::processWindowSystemEvent(QWindowSystemInterfacePriv
         QGuiApplicationPrivate::reportRefreshRateChange(
                 static_cast<QWindowSystemInterfacePrivate::ScreenRefreshRateEvent *>(e));
         break;
+    case QWindowSystemInterfacePrivate::ScreenVSync:
+        QGuiApplicationPrivate::processScreenVSync(
+                static_cast<QWindowSystemInterfacePrivate::ScreenVSyncEvent *>(e));
+        break;
     case QWindowSystemInterfacePrivate::ThemeChange:
         QGuiApplicationPrivate::processThemeChanged(
                     static_cast<QWindowSystemInterfacePrivate::ThemeChangeEvent *>(e));
@@ -2865,6 +2872,38 @@ void QGuiApplicationPrivate::reportRefreshRateChange(QWindowSystemInterfacePriva
     }
 }
 
+void QGuiApplicationPrivate::processScreenVSync(QWindowSystemInterfacePrivate::ScreenVSyncEvent *e)
+{
+    // This operation only makes sense after the QGuiApplication constructor runs
+    if (QCoreApplication::startingUp())
+        return;
+
+    if (!e->screen)
+        return;
+
+    QScreen *s = e->screen.data();
+    QScreenPrivate *sp = s->d_func();
+    sp->lastVSyncTimestamp = e->timestamp;
+    sp->vsyncTimer.start();
+
+    // Deliver the update requests that were waiting for this frame. Requests
+    // whose fallback timer already fired have a zero updateTimer by now.
+    const QVector<QPointer<QWindow> > windows = sp->pendingUpdateRequests;
+    sp->pendingUpdateRequests.clear();
+    for (const QPointer<QWindow> &window : windows) {
+        if (!window)
+            continue;
+        QWindowPrivate *wp = qt_window_private(window.data());
+        if (!wp->updateTimer)
+            continue;
+        window->killTimer(wp->updateTimer);
+        wp->updateTimer = 0;
+        wp->deliverUpdateRequest();
+    }
+
+    emit s->vsync(e->timestamp);
+}
+
 void QGuiApplicationPrivate::processExposeEvent(QWindowSystemInterfacePrivate::ExposeEvent *e)
 {
     if (!e->window)
@@ -2886,6 +2925,7 @@ void QGuiApplicationPrivate::processExposeEvent(QWindowSystemInterfacePrivate::E
         }
 
         p->receivedExpose = true;
+        QStartupTrace::mark("QWindow first expose");
     }
 
     p->exposed = e->isExposed && window->screen();
@@ -47,6 +47,9 @@
 #include <QtGui/qscreen.h>
 #include <private/qhighdpiscaling_p.h>
 #include <private/qwindow_p.h>
+#include <private/qscreen_p.h>
+
+#include <QtCore/qmath.h>
 
 
 QT_BEGIN_NAMESPACE
@@ -696,7 +699,10 @@ QRect QPlatformWindow::initialGeometry(const QWindow *w,
 
     The default implementation posts an UpdateRequest event to the
     window after 5 ms. The additional time is there to give the event
-    loop a bit of idle time to gather system events.
+    loop a bit of idle time to gather system events. When the screen
+    reports vertical blanks through QWindowSystemInterface::handleScreenVSync(),
+    the event is instead delivered at the next vsync, with the timer only
+    acting as a fallback in case no frame arrives.
 
 */
 void QPlatformWindow::requestUpdate()
@@ -712,7 +718,17 @@ void QPlatformWindow::requestUpdate()
     QWindow *w = window();
     QWindowPrivate *wp = (QWindowPrivate *) QObjectPrivate::get(w);
     Q_ASSERT(wp->updateTimer == 0);
-    wp->updateTimer = w->startTimer(timeout, Qt::PreciseTimer);
+
+    int interval = timeout;
+    if (QScreen *s = w->screen()) {
+        QScreenPrivate *sp = QScreenPrivate::get(s);
+        if (sp->hasVSyncClock()) {
+            sp->pendingUpdateRequests.append(w);
+            // Don't stall if nothing gets rendered and thus no frame is reported
+            interval = qMax(timeout, qCeil(2000 / s->refreshRate()));
+        }
+    }
+    wp->updateTimer = w->startTimer(interval, Qt::PreciseTimer);
 }
 
 /*!
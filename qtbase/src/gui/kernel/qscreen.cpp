@@ -545,6 +545,20 @@ qreal QScreen::refreshRate() const
     return d->refreshRate;
 }
 
+/*!
+    \fn void QScreen::vsync(qint64 timestamp)
+    \since 5.11
+
+    This signal is emitted once per frame on platforms that report the
+    vertical blanking of the screen, such as eglfs with the KMS backend.
+    \a timestamp is the time the frame started scanning out, in milliseconds
+    on the same clock as QElapsedTimer::msecsSinceReference().
+
+    On such platforms QWindow::requestUpdate() is also paced by this signal.
+
+    \sa refreshRate, QWindow::requestUpdate()
+*/
+
 /*!
     \property QScreen::primaryOrientation
     \brief the primary screen orientation
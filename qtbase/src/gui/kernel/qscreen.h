@@ -160,6 +160,7 @@ Q_SIGNALS:
     void primaryOrientationChanged(Qt::ScreenOrientation orientation);
     void orientationChanged(Qt::ScreenOrientation orientation);
     void refreshRateChanged(qreal refreshRate);
+    void vsync(qint64 timestamp);
 
 private:
     explicit QScreen(QPlatformScreen *screen);
@@ -169,6 +170,7 @@ private:
     friend class QPlatformIntegration;
     friend class QPlatformScreen;
     friend class QHighDpiScaling;
+    friend class QScreenPrivate;
 };
 
 #ifndef QT_NO_DEBUG_STREAM
@@ -56,6 +56,9 @@
 #include <qpa/qplatformscreen.h>
 #include "qhighdpiscaling_p.h"
 
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qvector.h>
 #include <QtCore/private/qobject_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -67,9 +70,16 @@ public:
     QScreenPrivate()
         : platformScreen(0)
         , orientationUpdateMask(0)
+        , lastVSyncTimestamp(0)
     {
     }
 
+    static QScreenPrivate *get(QScreen *screen) { return screen->d_func(); }
+
+    // The platform counts as providing a vsync clock for as long as it keeps
+    // reporting frames; an idle screen falls back to timer based updates.
+    bool hasVSyncClock() const { return vsyncTimer.isValid() && !vsyncTimer.hasExpired(250); }
+
     void setPlatformScreen(QPlatformScreen *screen);
     void updateHighDpi()
     {
@@ -89,6 +99,10 @@ public:
     QRect availableGeometry;
     QDpi logicalDpi;
     qreal refreshRate;
+
+    qint64 lastVSyncTimestamp;
+    QElapsedTimer vsyncTimer;
+    QVector<QPointer<QWindow> > pendingUpdateRequests;
 };
 
 QT_END_NAMESPACE
@@ -136,6 +136,100 @@ bool QWindowSystemInterfacePrivate::handleWindowSystemEvent<QWindowSystemInterfa
         return handleWindowSystemEvent<QWindowSystemInterface::AsynchronousDelivery>(ev);
 }
 
+/*
+    Appends \a e to the queue, unless it can be folded into the event at the
+    tail of the queue. Only the tail is considered, so coalescing never
+    reorders events: bursts of expose and geometry changes for the same
+    window collapse into one, as do consecutive mouse moves when
+    Qt::AA_CompressHighFrequencyEvents is set.
+*/
+void QWindowSystemInterfacePrivate::WindowSystemEventList::append(WindowSystemEvent *e)
+{
+    const QMutexLocker locker(&mutex);
+    ++stats.queued;
+
+    if (coalesce(e)) {
+        ++stats.coalesced;
+        delete e;
+        return;
+    }
+
+    mouseMoveTail = 0;
+    if (e->type == Mouse) {
+        const MouseEvent *me = static_cast<const MouseEvent *>(e);
+        if (me->buttons == lastMouseButtons)
+            mouseMoveTail = e;
+        lastMouseButtons = me->buttons;
+    }
+
+    impl.append(e);
+    stats.peakLength = qMax(stats.peakLength, impl.size());
+}
+
+bool QWindowSystemInterfacePrivate::WindowSystemEventList::coalesce(WindowSystemEvent *e)
+{
+    if (impl.isEmpty())
+        return false;
+
+    WindowSystemEvent *tail = impl.last();
+    if (tail->type != e->type || tail->flags != e->flags)
+        return false;
+
+    switch (e->type) {
+    case Expose: {
+        ExposeEvent *last = static_cast<ExposeEvent *>(tail);
+        const ExposeEvent *next = static_cast<const ExposeEvent *>(e);
+        if (!next->window || last->window != next->window)
+            return false;
+        // Keep exposure transitions and empty regions, which request a flush
+        if (last->isExposed != next->isExposed || last->region.isEmpty() || next->region.isEmpty())
+            return false;
+        last->region += next->region;
+        return true;
+    }
+    case GeometryChange: {
+        GeometryChangeEvent *last = static_cast<GeometryChangeEvent *>(tail);
+        const GeometryChangeEvent *next = static_cast<const GeometryChangeEvent *>(e);
+        if (!next->window || last->window != next->window)
+            return false;
+        last->requestedGeometry = next->requestedGeometry;
+        last->newGeometry = next->newGeometry;
+        return true;
+    }
+    case Mouse: {
+        if (tail != mouseMoveTail || !QCoreApplication::testAttribute(Qt::AA_CompressHighFrequencyEvents))
+            return false;
+        MouseEvent *last = static_cast<MouseEvent *>(tail);
+        const MouseEvent *next = static_cast<const MouseEvent *>(e);
+        if (last->window != next->window || last->buttons != next->buttons
+            || last->modifiers != next->modifiers || last->source != next->source) {
+            return false;
+        }
+        last->timestamp = next->timestamp;
+        last->localPos = next->localPos;
+        last->globalPos = next->globalPos;
+        return true;
+    }
+    default:
+        break;
+    }
+    return false;
+}
+
+/*
+    Returns the counters of the window system event queue, which tests can
+    use to verify how many events were merged before delivery.
+*/
+QWindowSystemInterfacePrivate::EventQueueStatistics QWindowSystemInterfacePrivate::eventQueueStatistics()
+{
+    return windowSystemEventQueue.statistics();
+}
+
+void QWindowSystemInterfacePrivate::resetEventQueueStatistics()
+{
+    windowSystemEventQueue.resetStatistics();
+}
+
 int QWindowSystemInterfacePrivate::windowSystemEventsQueued()
 {
     return windowSystemEventQueue.count();
@@ -740,6 +834,25 @@ void QWindowSystemInterface::handleScreenRefreshRateChange(QScreen *screen, qrea
     QWindowSystemInterfacePrivate::handleWindowSystemEvent(e);
 }
 
+/*!
+    \since 5.11
+
+    Reports that \a screen started scanning out a new frame, at \a timestamp
+    milliseconds on the monotonic clock used by QElapsedTimer.
+
+    Platforms that learn about vertical blanks, for example through page flip
+    completion events, should call this for every frame. Pending calls to
+    QWindow::requestUpdate() for windows on the screen are then delivered in
+    phase with the display instead of after a fixed idle time. This function
+    may be called from any thread.
+*/
+void QWindowSystemInterface::handleScreenVSync(QScreen *screen, qint64 timestamp)
+{
+    QWindowSystemInterfacePrivate::ScreenVSyncEvent *e =
+            new QWindowSystemInterfacePrivate::ScreenVSyncEvent(screen, timestamp);
+    QWindowSystemInterfacePrivate::handleWindowSystemEvent<QWindowSystemInterface::AsynchronousDelivery>(e);
+}
+
 void QWindowSystemInterface::handleThemeChange(QWindow *window)
 {
     QWindowSystemInterfacePrivate::ThemeChangeEvent *e = new QWindowSystemInterfacePrivate::ThemeChangeEvent(window);
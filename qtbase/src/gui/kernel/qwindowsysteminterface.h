@@ -199,6 +199,7 @@ public:
     static void handleScreenGeometryChange(QScreen *screen, const QRect &newGeometry, const QRect &newAvailableGeometry);
     static void handleScreenLogicalDotsPerInchChange(QScreen *screen, qreal newDpiX, qreal newDpiY);
     static void handleScreenRefreshRateChange(QScreen *screen, qreal newRefreshRate);
+    static void handleScreenVSync(QScreen *screen, qint64 timestamp);
 
     static void handleThemeChange(QWindow *window);
 
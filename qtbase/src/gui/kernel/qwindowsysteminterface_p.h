@@ -99,7 +99,8 @@ public:
         ApplicationStateChanged = 0x19,
         FlushEvents = 0x20,
         WindowScreenChanged = 0x21,
-        SafeAreaMarginsChanged = 0x22
+        SafeAreaMarginsChanged = 0x22,
+        ScreenVSync = 0x23
     };
 
     class WindowSystemEvent {
@@ -330,6 +331,14 @@ public:
         qreal rate;
     };
 
+    class ScreenVSyncEvent : public WindowSystemEvent {
+    public:
+        ScreenVSyncEvent(QScreen *s, qint64 t)
+            : WindowSystemEvent(ScreenVSync), screen(s), timestamp(t) { }
+        QPointer<QScreen> screen;
+        qint64 timestamp;
+    };
+
     class ThemeChangeEvent : public WindowSystemEvent {
     public:
         explicit ThemeChangeEvent(QWindow * w)
@@ -446,11 +455,25 @@ public:
     };
 #endif
 
+    struct EventQueueStatistics {
+        EventQueueStatistics() : queued(0), coalesced(0), peakLength(0) {}
+        quint64 queued;     // events handed to the queue
+        quint64 coalesced;  // events merged into an already queued one
+        int peakLength;
+    };
+
     class WindowSystemEventList {
         QList<WindowSystemEvent *> impl;
         mutable QMutex mutex;
+        // The queued mouse event that only moved the pointer, if it is the
+        // last one in the queue; only compared against, never dereferenced.
+        const WindowSystemEvent *mouseMoveTail;
+        Qt::MouseButtons lastMouseButtons;
+        EventQueueStatistics stats;
+
+        bool coalesce(WindowSystemEvent *e);
     public:
-        WindowSystemEventList() : impl(), mutex() {}
+        WindowSystemEventList() : impl(), mutex(), mouseMoveTail(0), lastMouseButtons(Qt::NoButton) {}
         ~WindowSystemEventList() { clear(); }
 
         void clear()
@@ -475,8 +498,7 @@ public:
                     return true;
             return false;
         }
-        void append(WindowSystemEvent *e)
-        { const QMutexLocker locker(&mutex); impl.append(e); }
+        void append(WindowSystemEvent *e);
         int count() const
         { const QMutexLocker locker(&mutex); return impl.count(); }
         WindowSystemEvent *peekAtFirstOfType(EventType t) const
@@ -498,12 +520,19 @@ public:
                 }
             }
         }
+        EventQueueStatistics statistics() const
+        { const QMutexLocker locker(&mutex); return stats; }
+        void resetStatistics()
+        { const QMutexLocker locker(&mutex); stats = EventQueueStatistics(); }
     private:
         Q_DISABLE_COPY(WindowSystemEventList)
     };
 
     static WindowSystemEventList windowSystemEventQueue;
 
+    static EventQueueStatistics eventQueueStatistics();
+    static void resetEventQueueStatistics();
+
     static int windowSystemEventsQueued();
     static bool nonUserInputEventsQueued();
     static WindowSystemEvent *getWindowSystemEvent();
@@ -1788,6 +1788,18 @@ quint64 Selector::pseudoClass(quint64 *negated) const
 
 ///////////////////////////////////////////////////////////////////////////////
 // StyleSheet
+// Returns the first ".name" (or [class~="name"]) selector of \a sel, if any
+static const AttributeSelector *classSelector(const BasicSelector &sel)
+{
+    for (const AttributeSelector &a : sel.attributeSelectors) {
+        if (a.valueMatchCriterium == AttributeSelector::MatchIncludes
+            && a.name == QLatin1String("class") && !a.value.contains(QLatin1Char(' '))) {
+            return &a;
+        }
+    }
+    return Q_NULLPTR;
+}
+
 void StyleSheet::buildIndexes(Qt::CaseSensitivity nameCaseSensitivity)
 {
     QVector<StyleRule> universals;
@@ -1824,6 +1836,12 @@ void StyleSheet::buildIndexes(Qt::CaseSensitivity nameCaseSensitivity)
                 if (nameCaseSensitivity == Qt::CaseInsensitive)
                     name = std::move(name).toLower();
                 nameIndex.insert(name, nr);
+            } else if (const AttributeSelector *a = classSelector(sel)) {
+                StyleRule nr;
+                nr.selectors += selector;
+                nr.declarations = rule.declarations;
+                nr.order = i;
+                classIndex.insert(a->value, nr);
             } else {
                 universalsSelectors += selector;
             }
@@ -2035,6 +2053,18 @@ QVector<StyleRule> StyleSelector::styleRulesForNode(NodePtr node)
                 }
             }
         }
+        if (!styleSheet.classIndex.isEmpty()) {
+            const QString classes = attribute(node, QLatin1String("class"));
+            const auto classNames = classes.splitRef(QLatin1Char(' '), QString::SkipEmptyParts);
+            for (const QStringRef &className : classNames) {
+                const QString key = className.toString();
+                QMultiHash<QString, StyleRule>::const_iterator it = styleSheet.classIndex.constFind(key);
+                while (it != styleSheet.classIndex.constEnd() && it.key() == key) {
+                    matchRule(node, it.value(), styleSheet.origin, styleSheet.depth, &weightedRules);
+                    ++it;
+                }
+            }
+        }
         if (!medium.isEmpty()) {
             for (int i = 0; i < styleSheet.mediaRules.count(); ++i) {
                 if (styleSheet.mediaRules.at(i).media.contains(medium, Qt::CaseInsensitive)) {
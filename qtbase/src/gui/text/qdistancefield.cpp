@@ -42,6 +42,15 @@
 #include <private/qdatabuffer_p.h>
 #include <private/qimage_p.h>
 #include <private/qpathsimplifier_p.h>
+#include <qcryptographichash.h>
+#include <qdatastream.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qhash.h>
+#include <qrunnable.h>
+#include <qsavefile.h>
+#include <qsemaphore.h>
+#include <qthreadpool.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -1075,6 +1084,201 @@ const uchar *QDistanceField::constScanLine(int i) const
     return d->data + i * d->width;
 }
 
+namespace {
+class QDistanceFieldRunnable : public QRunnable
+{
+public:
+    QDistanceFieldRunnable(const QPainterPath *paths, QDistanceField *fields,
+                           const int *indices, int begin, int end,
+                           bool doubleResolution, QSemaphore *done)
+        : m_paths(paths), m_fields(fields), m_indices(indices), m_begin(begin), m_end(end),
+          m_doubleResolution(doubleResolution), m_done(done)
+    {
+    }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        // Only reads the paths and writes distinct fields, no locking needed
+        for (int i = m_begin; i < m_end; ++i) {
+            const int index = m_indices[i];
+            m_fields[index] = QDistanceField(m_paths[index], m_fields[index].glyph(),
+                                             m_doubleResolution);
+        }
+        if (m_done)
+            m_done->release();
+    }
+
+private:
+    const QPainterPath *m_paths;
+    QDistanceField *m_fields;
+    const int *m_indices;
+    int m_begin;
+    int m_end;
+    bool m_doubleResolution;
+    QSemaphore *m_done;
+};
+} // unnamed namespace
+
+/*
+  Distance fields of a font, stored in QT_DISTANCEFIELD_CACHE_DIR when that
+  is set. The file name is a hash of the font's 'head' table, which holds
+  the checksum of the whole font file and its modification time, of its
+  names and of the distance field parameters, so any change to the font or
+  the parameters results in a different file.
+*/
+class QDistanceFieldDiskCache
+{
+public:
+    enum { Magic = 0x51444643, Version = 1 };
+
+    QDistanceFieldDiskCache(const QRawFont &font, bool doubleResolution)
+    {
+        const QString dir = qEnvironmentVariable("QT_DISTANCEFIELD_CACHE_DIR");
+        const QByteArray head = font.fontTable("head");
+        if (dir.isEmpty() || head.isEmpty())
+            return;
+
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(head);
+        hash.addData(font.familyName().toUtf8());
+        hash.addData(font.styleName().toUtf8());
+        const int parameters[] = { QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution),
+                                   QT_DISTANCEFIELD_SCALE(doubleResolution),
+                                   QT_DISTANCEFIELD_RADIUS(doubleResolution) };
+        hash.addData(reinterpret_cast<const char *>(parameters), sizeof(parameters));
+        m_fileName = dir + QLatin1Char('/') + QLatin1String(hash.result().toHex()) + QLatin1String(".qdf");
+    }
+
+    bool isEnabled() const { return !m_fileName.isEmpty(); }
+
+    QHash<glyph_t, QDistanceField> load() const
+    {
+        QHash<glyph_t, QDistanceField> fields;
+        QFile file(m_fileName);
+        if (!file.open(QIODevice::ReadOnly))
+            return fields;
+
+        QDataStream stream(&file);
+        quint32 magic, version, count;
+        stream >> magic >> version >> count;
+        if (magic != Magic || version != Version)
+            return fields;
+        for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+            quint32 glyph;
+            qint32 width, height;
+            stream >> glyph >> width >> height;
+            if (stream.status() != QDataStream::Ok || width < 0 || height < 0
+                || qint64(width) * height > file.size()) {
+                break;
+            }
+            QDistanceField field(width, height);
+            if (width * height && stream.readRawData(reinterpret_cast<char *>(field.bits()), width * height) != width * height)
+                break;
+            field.d->glyph = glyph;
+            fields.insert(glyph, field);
+        }
+        return fields;
+    }
+
+    void save(const QHash<glyph_t, QDistanceField> &fields) const
+    {
+        if (!QDir().mkpath(QFileInfo(m_fileName).absolutePath()))
+            return;
+        QSaveFile file(m_fileName);
+        if (!file.open(QIODevice::WriteOnly))
+            return;
+
+        QDataStream stream(&file);
+        stream << quint32(Magic) << quint32(Version) << quint32(fields.size());
+        for (auto it = fields.cbegin(), end = fields.cend(); it != end; ++it) {
+            const QDistanceField &field = it.value();
+            stream << quint32(it.key()) << qint32(field.width()) << qint32(field.height());
+            if (!field.isNull())
+                stream.writeRawData(reinterpret_cast<const char *>(field.constBits()), field.width() * field.height());
+        }
+        file.commit();
+    }
+
+private:
+    QString m_fileName;
+};
+
+/*!
+    \internal
+
+    Returns the distance fields of \a glyphs in \a font, in the same order as
+    the glyphs. This is equivalent to constructing a QDistanceField for each
+    glyph, but the outlines are only extracted on the calling thread, as font
+    engines are not thread-safe, while the fields themselves are computed
+    in parallel on the global thread pool.
+
+    If the QT_DISTANCEFIELD_CACHE_DIR environment variable is set, fields
+    are also looked up in and added to a persistent cache in that directory,
+    so that they need not be computed again in the next run.
+*/
+QVector<QDistanceField> QDistanceField::create(const QRawFont &font, const QVector<glyph_t> &glyphs,
+                                               bool doubleResolution)
+{
+    enum { GlyphsPerTask = 8 };
+
+    QVector<QDistanceField> fields(glyphs.size());
+    if (glyphs.isEmpty())
+        return fields;
+
+    QDistanceFieldDiskCache diskCache(font, doubleResolution);
+    QHash<glyph_t, QDistanceField> cachedFields;
+    if (diskCache.isEnabled())
+        cachedFields = diskCache.load();
+
+    QRawFont renderFont = font;
+    renderFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution) * QT_DISTANCEFIELD_SCALE(doubleResolution));
+
+    QVector<QPainterPath> paths(glyphs.size());
+    QVector<int> pending;
+    pending.reserve(glyphs.size());
+    for (int i = 0; i < glyphs.size(); ++i) {
+        const auto cached = cachedFields.constFind(glyphs.at(i));
+        if (cached != cachedFields.cend()) {
+            fields[i] = cached.value();
+            continue;
+        }
+        QPainterPath path = renderFont.pathForGlyph(glyphs.at(i));
+        path.translate(-path.boundingRect().topLeft());
+        path.setFillRule(Qt::WindingFill);
+        paths[i] = path;
+        fields[i].d->glyph = glyphs.at(i);
+        pending.append(i);
+    }
+    if (pending.isEmpty())
+        return fields;
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    QSemaphore done;
+    int started = 0;
+    for (int begin = 0; begin < pending.size(); begin += GlyphsPerTask) {
+        const int end = qMin<int>(begin + GlyphsPerTask, pending.size());
+        QDistanceFieldRunnable *task = new QDistanceFieldRunnable(paths.constData(), fields.data(),
+                                                                  pending.constData(), begin, end,
+                                                                  doubleResolution, &done);
+        if (end < pending.size() && pool->tryStart(task)) {
+            ++started;
+        } else {
+            // no thread available, or the last batch: do it on this thread
+            task->run();
+            done.acquire();
+            delete task;
+        }
+    }
+    done.acquire(started);
+
+    if (diskCache.isEnabled()) {
+        for (int index : qAsConst(pending))
+            cachedFields.insert(glyphs.at(index), fields.at(index));
+        diskCache.save(cachedFields);
+    }
+    return fields;
+}
+
 QImage QDistanceField::toImage(QImage::Format format) const
 {
     if (isNull())
@@ -56,6 +56,7 @@
 #include <private/qfontengine_p.h>
 #include <QtCore/qshareddata.h>
 #include <QtCore/qglobal.h>
+#include <QtCore/qvector.h>
 #include <QLoggingCategory>
 
 QT_BEGIN_NAMESPACE
@@ -119,11 +120,15 @@ public:
 
     QImage toImage(QImage::Format format = QImage::Format_ARGB32_Premultiplied) const;
 
+    static QVector<QDistanceField> create(const QRawFont &font, const QVector<glyph_t> &glyphs,
+                                          bool doubleResolution = false);
+
 private:
     QDistanceField(QDistanceFieldData *data);
     QSharedDataPointer<QDistanceFieldData> d;
 
     friend class QDistanceFieldData;
+    friend class QDistanceFieldDiskCache;
 };
 
 QT_END_NAMESPACE
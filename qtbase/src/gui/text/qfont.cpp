@@ -2754,6 +2754,9 @@ QFontCache::~QFontCache()
 
 void QFontCache::clear()
 {
+    // Shaped text holds references to font engines of this thread
+    QTextEngine::clearShapingCache();
+
     {
         EngineDataCache::Iterator it = engineDataCache.begin(),
                                  end = engineDataCache.end();
@@ -50,6 +50,7 @@
 #include <qpa/qplatformintegration.h>
 
 #include <QtGui/private/qguiapplication_p.h>
+#include <QtCore/private/qstartuptrace_p.h>
 #include <qpa/qplatformfontdatabase.h>
 #include <qpa/qplatformtheme.h>
 
@@ -894,8 +895,10 @@ static void initializeDb()
     QFontDatabasePrivate *db = privateDb();
 
     // init by asking for the platformfontdb for the first time or after invalidation
-    if (!db->count)
+    if (!db->count) {
+        QStartupTraceScope trace("QPlatformFontDatabase::populateFontDatabase");
         QGuiApplicationPrivate::platformIntegration()->fontDatabase()->populateFontDatabase();
+    }
 
     if (db->reregisterAppFonts) {
         for (int i = 0; i < db->applicationFonts.count(); i++) {
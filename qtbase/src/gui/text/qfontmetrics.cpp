@@ -510,6 +510,41 @@ int QFontMetrics::rightBearing(QChar ch) const
     return qRound(rb);
 }
 
+/*
+    Returns \c true if the width of \a text is just the sum of its glyph
+    advances. That is what shaping reduces to when the font prefers no
+    shaping, as long as the text is plain printable ASCII, which needs
+    neither OpenType, tab stops nor bidi, and no spacing or capitalization
+    changes the advances.
+*/
+static bool qt_canBypassShaping(const QFontPrivate *d, const QChar *text, int len)
+{
+    if (!(d->request.styleStrategy & QFont::PreferNoShaping)
+        || d->letterSpacing != 0 || d->wordSpacing != 0 || d->capital != QFont::MixedCase) {
+        return false;
+    }
+    for (int i = 0; i < len; ++i) {
+        const ushort uc = text[i].unicode();
+        if (uc < 0x20 || uc >= 0x7f)
+            return false;
+    }
+    return true;
+}
+
+static QFixed qt_advanceWidth(QFontPrivate *d, const QChar *text, int len)
+{
+    int numGlyphs = len;
+    QVarLengthGlyphLayoutArray glyphs(numGlyphs);
+    QFontEngine *engine = d->engineForScript(QChar::Script_Common);
+    if (!engine->stringToCMap(text, len, &glyphs, &numGlyphs, 0))
+        Q_UNREACHABLE();
+
+    QFixed width;
+    for (int i = 0; i < numGlyphs; ++i)
+        width += glyphs.advances[i];
+    return width;
+}
+
 /*!
     Returns the width in pixels of the first \a len characters of \a
     text. If \a len is negative (the default), the entire string is
@@ -544,23 +579,47 @@ int QFontMetrics::width(const QString &text, int len, int flags) const
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
     if (flags & Qt::TextBypassShaping) {
         // Skip complex shaping, only use advances
-        int numGlyphs = len;
-        QVarLengthGlyphLayoutArray glyphs(numGlyphs);
-        QFontEngine *engine = d->engineForScript(QChar::Script_Common);
-        if (!engine->stringToCMap(text.data(), len, &glyphs, &numGlyphs, 0))
-            Q_UNREACHABLE();
-
-        QFixed width;
-        for (int i = 0; i < numGlyphs; ++i)
-            width += glyphs.advances[i];
-        return qRound(width);
+        return qRound(qt_advanceWidth(d.data(), text.constData(), len));
     }
 #endif
+    if (qt_canBypassShaping(d.data(), text.constData(), len))
+        return qRound(qt_advanceWidth(d.data(), text.constData(), len));
 
     QStackTextEngine layout(text, QFont(d.data()));
     return qRound(layout.width(0, len));
 }
 
+/*!
+    \since 5.11
+
+    Returns the widths in pixels of the given \a texts, in the same order.
+
+    This is equivalent to calling width() for each string, but cheaper
+    when measuring many strings, for example all the cells of a view.
+
+    \sa width()
+*/
+QVector<int> QFontMetrics::widths(const QStringList &texts) const
+{
+    QVector<int> result;
+    result.reserve(texts.size());
+    const QFont font(d.data());
+    for (const QString &text : texts) {
+        int len = text.indexOf(QLatin1Char('\x9c'));
+        if (len == -1)
+            len = text.length();
+        if (len == 0) {
+            result.append(0);
+        } else if (qt_canBypassShaping(d.data(), text.constData(), len)) {
+            result.append(qRound(qt_advanceWidth(d.data(), text.constData(), len)));
+        } else {
+            QStackTextEngine layout(text, font);
+            result.append(qRound(layout.width(0, len)));
+        }
+    }
+    return result;
+}
+
 /*!
     \overload
 
@@ -1411,11 +1470,44 @@ qreal QFontMetricsF::width(const QString &text) const
     int pos = text.indexOf(QLatin1Char('\x9c'));
     int len = (pos != -1) ? pos : text.length();
 
+    if (len && qt_canBypassShaping(d.data(), text.constData(), len))
+        return qt_advanceWidth(d.data(), text.constData(), len).toReal();
+
     QStackTextEngine layout(text, QFont(d.data()));
     layout.itemize();
     return layout.width(0, len).toReal();
 }
 
+/*!
+    \since 5.11
+
+    Returns the widths in pixels of the given \a texts, in the same order.
+
+    This is equivalent to calling width() for each string, but cheaper
+    when measuring many strings, for example all the cells of a view.
+
+    \sa width()
+*/
+QVector<qreal> QFontMetricsF::widths(const QStringList &texts) const
+{
+    QVector<qreal> result;
+    result.reserve(texts.size());
+    const QFont font(d.data());
+    for (const QString &text : texts) {
+        int len = text.indexOf(QLatin1Char('\x9c'));
+        if (len == -1)
+            len = text.length();
+        if (len && qt_canBypassShaping(d.data(), text.constData(), len)) {
+            result.append(qt_advanceWidth(d.data(), text.constData(), len).toReal());
+        } else {
+            QStackTextEngine layout(text, font);
+            layout.itemize();
+            result.append(layout.width(0, len).toReal());
+        }
+    }
+    return result;
+}
+
 /*!
     \overload
 
@@ -43,6 +43,8 @@
 #include <QtGui/qtguiglobal.h>
 #include <QtGui/qfont.h>
 #include <QtCore/qsharedpointer.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qvector.h>
 #ifndef QT_INCLUDE_COMPAT
 #include <QtCore/qrect.h>
 #endif
@@ -92,6 +94,7 @@ public:
     int rightBearing(QChar) const;
     int width(const QString &, int len = -1) const;
     int width(const QString &, int len, int flags) const;
+    QVector<int> widths(const QStringList &texts) const;
 
     int width(QChar) const;
 #if QT_VERSION < QT_VERSION_CHECK(6,0,0)
@@ -165,6 +168,7 @@ public:
     qreal leftBearing(QChar) const;
     qreal rightBearing(QChar) const;
     qreal width(const QString &string) const;
+    QVector<qreal> widths(const QStringList &texts) const;
 
     qreal width(QChar) const;
 
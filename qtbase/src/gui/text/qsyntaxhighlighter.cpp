@@ -66,7 +66,7 @@ public:
 
     void _q_reformatBlocks(int from, int charsRemoved, int charsAdded);
     void reformatBlocks(int from, int charsRemoved, int charsAdded);
-    void reformatBlock(const QTextBlock &block);
+    bool reformatBlock(const QTextBlock &block);
 
     inline void rehighlight(QTextCursor &cursor, QTextCursor::MoveOperation operation) {
         inReformatBlocks = true;
@@ -85,14 +85,14 @@ public:
         q_func()->rehighlight();
     }
 
-    void applyFormatChanges();
+    bool applyFormatChanges();
     QVector<QTextCharFormat> formatChanges;
     QTextBlock currentBlock;
     bool rehighlightPending;
     bool inReformatBlocks;
 };
 
-void QSyntaxHighlighterPrivate::applyFormatChanges()
+bool QSyntaxHighlighterPrivate::applyFormatChanges()
 {
     bool formatsChanged = false;
 
@@ -149,10 +149,10 @@ void QSyntaxHighlighterPrivate::applyFormatChanges()
         formatsChanged = true;
     }
 
-    if (formatsChanged) {
+    if (formatsChanged)
         layout->setFormats(ranges);
-        doc->markContentsDirty(currentBlock.position(), currentBlock.length());
-    }
+
+    return formatsChanged;
 }
 
 void QSyntaxHighlighterPrivate::_q_reformatBlocks(int from, int charsRemoved, int charsAdded)
@@ -178,10 +178,21 @@ void QSyntaxHighlighterPrivate::reformatBlocks(int from, int charsRemoved, int c
 
     bool forceHighlightOfNextBlock = false;
 
+    // Collect the changed blocks into one range and mark it dirty once at the
+    // end. Outside of a contentsChange() emission every markContentsDirty()
+    // call goes straight to the document layout, which made rehighlight()
+    // relayout the document once per block.
+    int dirtyFrom = -1;
+    int dirtyEnd = -1;
+
     while (block.isValid() && (block.position() < endPosition || forceHighlightOfNextBlock)) {
         const int stateBeforeHighlight = block.userState();
 
-        reformatBlock(block);
+        if (reformatBlock(block)) {
+            if (dirtyFrom < 0)
+                dirtyFrom = block.position();
+            dirtyEnd = block.position() + block.length();
+        }
 
         forceHighlightOfNextBlock = (block.userState() != stateBeforeHighlight);
 
@@ -189,9 +200,12 @@ void QSyntaxHighlighterPrivate::reformatBlocks(int from, int charsRemoved, int c
     }
 
     formatChanges.clear();
+
+    if (dirtyFrom >= 0)
+        doc->markContentsDirty(dirtyFrom, dirtyEnd - dirtyFrom);
 }
 
-void QSyntaxHighlighterPrivate::reformatBlock(const QTextBlock &block)
+bool QSyntaxHighlighterPrivate::reformatBlock(const QTextBlock &block)
 {
     Q_Q(QSyntaxHighlighter);
 
@@ -201,9 +215,11 @@ void QSyntaxHighlighterPrivate::reformatBlock(const QTextBlock &block)
 
     formatChanges.fill(QTextCharFormat(), block.length() - 1);
     q->highlightBlock(block.text());
-    applyFormatChanges();
+    const bool formatsChanged = applyFormatChanges();
 
     currentBlock = QTextBlock();
+
+    return formatsChanged;
 }
 
 /*!
@@ -1659,7 +1659,11 @@ void QTextDocumentPrivate::compressPieceTable()
     if (undoEnabled)
         return;
 
-    const uint garbageCollectionThreshold = 96 * 1024; // bytes
+    // Compacting copies all of the text, so for large documents only do it
+    // once a good part of the buffer is garbage; otherwise a document that
+    // keeps dropping blocks (see maximumBlockCount) would be copied over and
+    // over again, making every edit O(document size)
+    const uint garbageCollectionThreshold = qMax<uint>(96 * 1024, uint(text.size()) * sizeof(QChar) / 2); // bytes
 
     //qDebug() << "unreachable bytes:" << unreachableCharacterCount * sizeof(QChar) << " -- limit" << garbageCollectionThreshold << "text size =" << text.size() << "capacity:" << text.capacity();
 
@@ -451,6 +451,11 @@ void QTextHtmlImporter::import()
 {
     cursor.beginEditBlock();
     hasBlock = true;
+    if (importMode == AppendToDocument) {
+        // start a new block after the existing content instead of merging into it
+        cursor.movePosition(QTextCursor::End);
+        hasBlock = false;
+    }
     forceBlockMerging = false;
     compressNextWhitespace = RemoveWhiteSpace;
     blockTagClosed = false;
@@ -738,7 +743,7 @@ QTextHtmlImporter::ProcessNodeResult QTextHtmlImporter::processSpecialNodes()
             blockFormat.setTopMargin(topMargin(currentNodeIdx));
             blockFormat.setBottomMargin(bottomMargin(currentNodeIdx));
             blockFormat.setProperty(QTextFormat::BlockTrailingHorizontalRulerWidth, currentNode->width);
-            if (hasBlock && importMode == ImportToDocument)
+            if (hasBlock && importMode != ImportToFragment)
                 cursor.mergeBlockFormat(blockFormat);
             else
                 appendBlock(blockFormat);
@@ -1180,6 +1185,255 @@ void QTextHtmlImporter::appendBlock(const QTextBlockFormat &format, QTextCharFor
         compressNextWhitespace = RemoveWhiteSpace;
 }
 
+/*!
+    \internal
+    \class QTextHtmlIncrementalImporter
+
+    Imports a large piece of HTML into a QTextDocument in several steps.
+
+    The input is split into chunks at the end of top-level block elements
+    (paragraphs, tables, lists, ...), and each chunk is parsed and inserted on
+    its own. Only the node tree of the current chunk is kept in memory, and the
+    caller can return to the event loop between calls to importChunk().
+
+    Everything up to and including the \c{<body>} tag is prepended to every
+    chunk, so style sheets and body attributes apply to the whole document.
+    Margins are not collapsed across chunk boundaries. HTML that uses
+    \c{<!--StartFragment-->} markers is always imported in one go.
+
+    Like QTextDocument::setHtml(), the first call replaces the contents of the
+    document, and the import is not recorded on the undo stack.
+*/
+
+QTextHtmlIncrementalImporter::QTextHtmlIncrementalImporter(QTextDocument *_doc, const QString &_html,
+                                                           const QTextDocument *_resourceProvider)
+    : doc(_doc), resourceProvider(_resourceProvider), html(_html), position(0), first(true),
+      splittable(!_html.contains(QLatin1String("<!--StartFragment-->")))
+{
+    if (!splittable)
+        return;
+
+    int bodyStart = html.indexOf(QLatin1String("<body"), 0, Qt::CaseInsensitive);
+    if (bodyStart != -1) {
+        bodyStart = html.indexOf(QLatin1Char('>'), bodyStart);
+        if (bodyStart != -1)
+            ++bodyStart;
+    } else {
+        bodyStart = html.indexOf(QLatin1String("</head>"), 0, Qt::CaseInsensitive);
+        if (bodyStart != -1)
+            bodyStart += 7;
+    }
+    if (bodyStart > 0) {
+        prefix = html.left(bodyStart);
+        position = bodyStart;
+    }
+}
+
+static bool isVoidHtmlElement(const QString &name)
+{
+    static const char voidElements[][7] = {
+        "area", "base", "br", "col", "embed", "hr", "img", "input",
+        "link", "meta", "param", "source", "wbr"
+    };
+    for (const char *element : voidElements) {
+        if (name == QLatin1String(element))
+            return true;
+    }
+    return false;
+}
+
+static bool isSplittableHtmlElement(int id)
+{
+    switch (id) {
+    case Html_p:
+    case Html_div:
+    case Html_table:
+    case Html_ul:
+    case Html_ol:
+    case Html_dl:
+    case Html_h1:
+    case Html_h2:
+    case Html_h3:
+    case Html_h4:
+    case Html_h5:
+    case Html_h6:
+    case Html_pre:
+    case Html_blockquote:
+    case Html_center:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Scans the tag starting at html[pos] == '<'. Returns the position after the
+// tag, or -1 if the tag is not terminated.
+static int scanHtmlTag(const QString &html, int pos, QString *name, bool *closing, bool *selfClosing)
+{
+    const QChar *s = html.constData();
+    const int n = html.size();
+    int i = pos + 1;
+    *closing = i < n && s[i] == QLatin1Char('/');
+    if (*closing)
+        ++i;
+    const int nameStart = i;
+    while (i < n && s[i].isLetterOrNumber())
+        ++i;
+    *name = html.mid(nameStart, i - nameStart).toLower();
+
+    QChar quote;
+    for (; i < n; ++i) {
+        const QChar c = s[i];
+        if (!quote.isNull()) {
+            if (c == quote)
+                quote = QChar();
+        } else if (c == QLatin1Char('"') || c == QLatin1Char('\'')) {
+            quote = c;
+        } else if (c == QLatin1Char('>')) {
+            *selfClosing = s[i - 1] == QLatin1Char('/');
+            return i + 1;
+        }
+    }
+    return -1;
+}
+
+static bool onlyClosingTagsFollow(const QString &html, int pos)
+{
+    const QChar *s = html.constData();
+    const int n = html.size();
+    while (pos < n) {
+        if (s[pos].isSpace()) {
+            ++pos;
+        } else if (html.midRef(pos, 4) == QLatin1String("<!--")) {
+            pos = html.indexOf(QLatin1String("-->"), pos + 4);
+            if (pos == -1)
+                return true;
+            pos += 3;
+        } else if (html.midRef(pos, 2) == QLatin1String("</")) {
+            pos = html.indexOf(QLatin1Char('>'), pos);
+            if (pos == -1)
+                return true;
+            ++pos;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+int QTextHtmlIncrementalImporter::nextSplitPosition(int from, int minimumLength) const
+{
+    const QChar *s = html.constData();
+    const int n = html.size();
+    QVector<QString> openElements;
+    QString name;
+    bool closing = false;
+    bool selfClosing = false;
+
+    int i = from;
+    while (i < n) {
+        if (s[i] != QLatin1Char('<')) {
+            ++i;
+            continue;
+        }
+        if (html.midRef(i, 4) == QLatin1String("<!--")) {
+            i = html.indexOf(QLatin1String("-->"), i + 4);
+            if (i == -1)
+                return n;
+            i += 3;
+            continue;
+        }
+
+        const int tagStart = i;
+        selfClosing = false;
+        const int tagEnd = scanHtmlTag(html, i, &name, &closing, &selfClosing);
+        if (tagEnd == -1)
+            return n;
+        if (name.isEmpty()) {
+            // <!DOCTYPE ...>, <?xml ...?> or a stray '<' in the text
+            const QChar next = tagStart + 1 < n ? s[tagStart + 1] : QChar();
+            i = (next == QLatin1Char('!') || next == QLatin1Char('?')) ? tagEnd : tagStart + 1;
+            continue;
+        }
+        i = tagEnd;
+
+        const int id = QTextHtmlParser::lookupElement(name);
+        if (closing) {
+            const int idx = openElements.lastIndexOf(name);
+            if (idx == -1)
+                continue;
+            // closing an element implicitly closes everything opened inside it
+            openElements.resize(idx);
+            if (openElements.isEmpty() && isSplittableHtmlElement(id)
+                && i - from >= minimumLength && !onlyClosingTagsFollow(html, i))
+                return i;
+        } else {
+            if (isSplittableHtmlElement(id) && !openElements.isEmpty()
+                && openElements.constLast() == QLatin1String("p")) {
+                // a block element implicitly closes an open paragraph
+                openElements.removeLast();
+                if (openElements.isEmpty() && tagStart - from >= minimumLength)
+                    return tagStart;
+            }
+            if (name == QLatin1String("style") || name == QLatin1String("script")) {
+                i = html.indexOf(QLatin1String("</") + name, i, Qt::CaseInsensitive);
+                if (i == -1)
+                    return n;
+                continue;
+            }
+            if (!selfClosing && !isVoidHtmlElement(name))
+                openElements.append(name);
+        }
+    }
+    return n;
+}
+
+/*!
+    \internal
+
+    Parses and inserts the next part of the HTML, roughly \a chunkSize
+    characters long. The chunk is extended to the end of the enclosing
+    top-level block, so a single chunk may be considerably larger.
+*/
+void QTextHtmlIncrementalImporter::importChunk(int chunkSize)
+{
+    if (atEnd())
+        return;
+    if (!doc) {
+        position = html.size();
+        return;
+    }
+
+    const int end = splittable ? nextSplitPosition(position, qMax(1, chunkSize)) : html.size();
+    QString chunk = prefix;
+    chunk += html.midRef(position, end - position);
+    position = end;
+
+    QTextDocumentPrivate *d = doc->docHandle();
+    const bool previousState = d->isUndoRedoEnabled();
+    d->enableUndoRedo(false);
+    d->beginEditBlock();
+    if (first)
+        d->clear();
+    QTextHtmlImporter(doc, chunk,
+                      first ? QTextHtmlImporter::ImportToDocument : QTextHtmlImporter::AppendToDocument,
+                      resourceProvider).import();
+    d->endEditBlock();
+    d->enableUndoRedo(previousState);
+    first = false;
+}
+
+/*!
+    \internal
+
+    Imports the remaining HTML chunk by chunk.
+*/
+void QTextHtmlIncrementalImporter::importAll()
+{
+    while (!atEnd())
+        importChunk();
+}
+
 #endif // QT_NO_TEXTHTMLPARSER
 
 /*!
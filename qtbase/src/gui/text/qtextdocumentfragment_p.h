@@ -120,7 +120,8 @@ class QTextHtmlImporter : public QTextHtmlParser
 public:
     enum ImportMode {
         ImportToFragment,
-        ImportToDocument
+        ImportToDocument,
+        AppendToDocument
     };
 
     QTextHtmlImporter(QTextDocument *_doc, const QString &html,
@@ -237,6 +238,34 @@ Q_DECLARE_TYPEINFO(QTextHtmlImporter::TableCellIterator, Q_PRIMITIVE_TYPE);
 Q_DECLARE_TYPEINFO(QTextHtmlImporter::Table, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QTextHtmlImporter::RowColSpanInfo, Q_PRIMITIVE_TYPE);
 
+class Q_GUI_EXPORT QTextHtmlIncrementalImporter
+{
+public:
+    enum { DefaultChunkSize = 64 * 1024 };
+
+    QTextHtmlIncrementalImporter(QTextDocument *doc, const QString &html,
+                                 const QTextDocument *resourceProvider = Q_NULLPTR);
+
+    bool atEnd() const { return position >= html.size(); }
+    int progress() const { return html.isEmpty() ? 100 : int(qint64(position) * 100 / html.size()); }
+
+    void importChunk(int chunkSize = DefaultChunkSize);
+    void importAll();
+
+private:
+    int nextSplitPosition(int from, int minimumLength) const;
+
+    QPointer<QTextDocument> doc;
+    QPointer<const QTextDocument> resourceProvider;
+    QString html;
+    QString prefix;
+    int position;
+    bool first;
+    bool splittable;
+
+    Q_DISABLE_COPY(QTextHtmlIncrementalImporter)
+};
+
 QT_END_NAMESPACE
 #endif // QT_NO_TEXTHTMLPARSER
 
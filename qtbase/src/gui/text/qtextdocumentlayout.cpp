@@ -57,6 +57,7 @@
 #include <qvarlengtharray.h>
 #include <limits.h>
 #include <qbasictimer.h>
+#include <qelapsedtimer.h>
 #include "private/qfunctions_p.h"
 
 #include <algorithm>
@@ -461,6 +462,7 @@ public:
     mutable QBasicTimer sizeChangedTimer;
     uint showLayoutProgress : 1;
     uint insideDocumentChange : 1;
+    uint backgroundLayout : 1;
 
     int lastPageCount;
     qreal idealWidth;
@@ -524,6 +526,7 @@ public:
     inline void ensureLayoutFinished() const
     { ensureLayoutedByPosition(INT_MAX); }
     void layoutStep() const;
+    void backgroundLayoutStep() const;
 
     QRectF frameBoundingRectInternal(QTextFrame *frame) const;
 
@@ -540,6 +543,7 @@ QTextDocumentLayoutPrivate::QTextDocumentLayoutPrivate()
 {
     showLayoutProgress = true;
     insideDocumentChange = false;
+    backgroundLayout = qEnvironmentVariableIntValue("QT_TEXT_BACKGROUND_LAYOUT") > 0;
     idealWidth = 0;
     contentHasAlignment = false;
 }
@@ -3129,7 +3133,15 @@ int QTextDocumentLayout::dynamicPageCount() const
 QSizeF QTextDocumentLayout::dynamicDocumentSize() const
 {
     Q_D(const QTextDocumentLayout);
-    return data(d->docPrivate->rootFrame())->size.toSizeF();
+    QSizeF size = data(d->docPrivate->rootFrame())->size.toSizeF();
+    if (d->backgroundLayout && d->currentLazyLayoutPosition > 0) {
+        // extrapolate the height of what was laid out so far, so that the
+        // scroll bars of a large document do not keep growing
+        const int length = d->docPrivate->length();
+        if (d->currentLazyLayoutPosition < length)
+            size.setHeight(size.height() * length / d->currentLazyLayoutPosition);
+    }
+    return size;
 }
 
 int QTextDocumentLayout::pageCount() const
@@ -3180,6 +3192,31 @@ void QTextDocumentLayoutPrivate::layoutStep() const
     lazyLayoutStepSize = qMin(200000, lazyLayoutStepSize * 2);
 }
 
+/*
+  Lays out as much of the document as fits in a few milliseconds, adapting
+  the step size to how long the previous steps took, so that the event loop
+  stays responsive while a large document is laid out from the layout timer.
+  Parts that are needed earlier, like the viewport, are still laid out on
+  demand through ensureLayouted().
+*/
+void QTextDocumentLayoutPrivate::backgroundLayoutStep() const
+{
+    enum { TimeBudget = 8, MinStepSize = 1000, MaxStepSize = 200000 };
+
+    QElapsedTimer timer;
+    timer.start();
+    do {
+        QElapsedTimer stepTimer;
+        stepTimer.start();
+        ensureLayoutedByPosition(currentLazyLayoutPosition + lazyLayoutStepSize);
+        const qint64 elapsed = stepTimer.elapsed();
+        if (elapsed < TimeBudget / 4)
+            lazyLayoutStepSize = qMin<int>(MaxStepSize, lazyLayoutStepSize * 2);
+        else if (elapsed > TimeBudget)
+            lazyLayoutStepSize = qMax<int>(MinStepSize, lazyLayoutStepSize / 2);
+    } while (currentLazyLayoutPosition != -1 && timer.elapsed() < TimeBudget);
+}
+
 void QTextDocumentLayout::setCursorWidth(int width)
 {
     Q_D(QTextDocumentLayout);
@@ -3296,6 +3333,27 @@ QRectF QTextDocumentLayout::blockBoundingRect(const QTextBlock &block) const
     return rect;
 }
 
+/*!
+    \internal
+
+    Enables or disables background layout. In this mode the layout timer
+    lays out the document in steps of a few milliseconds each instead of
+    steps of a growing number of characters, and dynamicDocumentSize()
+    estimates the height of the document from the part that was laid out
+    so far. It is also enabled by setting QT_TEXT_BACKGROUND_LAYOUT.
+*/
+void QTextDocumentLayout::setBackgroundLayoutEnabled(bool enable)
+{
+    Q_D(QTextDocumentLayout);
+    d->backgroundLayout = enable;
+}
+
+bool QTextDocumentLayout::isBackgroundLayoutEnabled() const
+{
+    Q_D(const QTextDocumentLayout);
+    return d->backgroundLayout;
+}
+
 int QTextDocumentLayout::layoutStatus() const
 {
     Q_D(const QTextDocumentLayout);
@@ -3309,8 +3367,12 @@ void QTextDocumentLayout::timerEvent(QTimerEvent *e)
 {
     Q_D(QTextDocumentLayout);
     if (e->timerId() == d->layoutTimer.timerId()) {
-        if (d->currentLazyLayoutPosition != -1)
-            d->layoutStep();
+        if (d->currentLazyLayoutPosition != -1) {
+            if (d->backgroundLayout)
+                d->backgroundLayoutStep();
+            else
+                d->layoutStep();
+        }
     } else if (e->timerId() == d->sizeChangedTimer.timerId()) {
         d->lastReportedSize = dynamicDocumentSize();
         emit documentSizeChanged(d->lastReportedSize);
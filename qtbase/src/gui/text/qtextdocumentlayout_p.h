@@ -88,6 +88,11 @@ public:
     // internal for QTextEdit's NoWrap mode
     void setViewport(const QRectF &viewport);
 
+    // internal, lay out large documents in time-bounded steps and estimate
+    // the height of the part that was not laid out yet
+    void setBackgroundLayoutEnabled(bool enable);
+    bool isBackgroundLayoutEnabled() const;
+
     virtual QRectF frameBoundingRect(QTextFrame *frame) const Q_DECL_OVERRIDE;
     virtual QRectF blockBoundingRect(const QTextBlock &block) const Q_DECL_OVERRIDE;
     QRectF tableBoundingRect(QTextTable *table) const;
@@ -55,6 +55,8 @@
 #include "qrawfont_p.h"
 #include <qguiapplication.h>
 #include <qinputmethod.h>
+#include <qcache.h>
+#include <qthreadstorage.h>
 #include <algorithm>
 #include <stdlib.h>
 
@@ -960,6 +962,150 @@ void QTextEngine::shapeLine(const QScriptLine &line)
 extern bool qt_useHarfbuzzNG(); // defined in qfontengine.cpp
 #endif
 
+namespace {
+/*
+  Results of QTextEngine::shapeText(), reused when the same text is shaped
+  again with the same font engine and parameters, for instance when a
+  QTextLayout or QStaticText is rebuilt for a string that was laid out
+  before. The cache holds a reference to the font engines of its entries,
+  so an engine pointer in a key can not be reused by another engine while
+  the entry exists. Like QFontCache, there is one cache per thread, as font
+  engines are not shared between threads.
+*/
+struct ShapingCacheKey
+{
+    QString text;
+    QFontEngine *fontEngine;
+    QFixed letterSpacing;
+    QFixed wordSpacing;
+    ushort script;
+    uchar bidiLevel;
+    uchar flags;
+    uchar options;
+
+    bool operator==(const ShapingCacheKey &other) const
+    {
+        return fontEngine == other.fontEngine && script == other.script
+                && bidiLevel == other.bidiLevel && flags == other.flags
+                && options == other.options && letterSpacing == other.letterSpacing
+                && wordSpacing == other.wordSpacing && text == other.text;
+    }
+};
+
+inline uint qHash(const ShapingCacheKey &key, uint seed = 0)
+{
+    return qHash(key.text, seed) ^ qHash(key.fontEngine) ^ (key.script << 16)
+            ^ (key.bidiLevel << 8) ^ (key.flags << 4) ^ key.options;
+}
+
+struct ShapingCacheEntry
+{
+    ShapingCacheEntry(QFontEngine *engine, int numGlyphs, int numChars)
+        : fontEngine(engine),
+          glyphData(numGlyphs * QGlyphLayout::SpaceNeeded, Qt::Uninitialized),
+          logClusters(numChars)
+    {
+        fontEngine->ref.ref();
+    }
+    ~ShapingCacheEntry()
+    {
+        if (!fontEngine->ref.deref())
+            delete fontEngine;
+    }
+
+    QGlyphLayout glyphs() { return QGlyphLayout(glyphData.data(), numGlyphs()); }
+    int numGlyphs() const { return glyphData.size() / QGlyphLayout::SpaceNeeded; }
+
+    QFontEngine *fontEngine;
+    QByteArray glyphData;
+    QVector<ushort> logClusters;
+    QFixed width;
+    QFixed ascent;
+    QFixed descent;
+    QFixed leading;
+};
+
+class ShapingCache : public QCache<ShapingCacheKey, ShapingCacheEntry>
+{
+public:
+    ShapingCache() : hits(0), misses(0)
+    {
+        bool ok = false;
+        const int limit = qEnvironmentVariableIntValue("QT_TEXT_SHAPING_CACHE_SIZE", &ok);
+        setMaxCost((ok ? limit : 4096) * 1024);
+    }
+
+    qint64 hits;
+    qint64 misses;
+};
+
+static inline void copyGlyphs(const QGlyphLayout &to, const QGlyphLayout &from, int numGlyphs)
+{
+    memcpy(static_cast<void *>(to.offsets), from.offsets, numGlyphs * sizeof(QFixedPoint));
+    memcpy(to.glyphs, from.glyphs, numGlyphs * sizeof(glyph_t));
+    memcpy(static_cast<void *>(to.advances), from.advances, numGlyphs * sizeof(QFixed));
+    memcpy(static_cast<void *>(to.justifications), from.justifications, numGlyphs * sizeof(QGlyphJustification));
+    memcpy(static_cast<void *>(to.attributes), from.attributes, numGlyphs * sizeof(QGlyphAttributes));
+}
+} // unnamed namespace
+
+#ifdef QT_NO_THREAD
+Q_GLOBAL_STATIC(ShapingCache, theShapingCache)
+
+static ShapingCache *shapingCache()
+{
+    return theShapingCache();
+}
+#else
+Q_GLOBAL_STATIC(QThreadStorage<ShapingCache *>, theShapingCache)
+
+static ShapingCache *shapingCache()
+{
+    ShapingCache *&cache = theShapingCache()->localData();
+    if (!cache)
+        cache = new ShapingCache;
+    return cache;
+}
+#endif
+
+/*!
+    \internal
+
+    Removes all entries from the shaping cache of the current thread and
+    releases the font engines they reference.
+*/
+void QTextEngine::clearShapingCache()
+{
+#ifdef QT_NO_THREAD
+    if (theShapingCache.exists())
+        theShapingCache()->clear();
+#else
+    QThreadStorage<ShapingCache *> *storage = Q_NULLPTR;
+    QT_TRY {
+        storage = theShapingCache();
+    } QT_CATCH (const std::bad_alloc &) {
+        // no cache - just ignore
+    }
+    if (storage && storage->hasLocalData())
+        storage->localData()->clear();
+#endif
+}
+
+/*!
+    \internal
+
+    Returns the number of lookups in the shaping cache of the current thread
+    that were found in \a hits and those that were not in \a misses.
+*/
+void QTextEngine::shapingCacheStatistics(qint64 *hits, qint64 *misses)
+{
+    const ShapingCache *cache = shapingCache();
+    if (hits)
+        *hits = cache->hits;
+    if (misses)
+        *misses = cache->misses;
+}
+
 void QTextEngine::shapeText(int item) const
 {
     Q_ASSERT(item < layoutData->items.size());
@@ -1033,6 +1179,40 @@ void QTextEngine::shapeText(int item) const
             letterSpacing *= font.d->dpi / qt_defaultDpiY();
     }
 
+    ShapingCache *cache = shapingCache();
+    ShapingCacheKey cacheKey;
+    cacheKey.text = QString::fromRawData(reinterpret_cast<const QChar *>(string), itemLength);
+    cacheKey.fontEngine = fontEngine;
+    cacheKey.letterSpacing = letterSpacing;
+    cacheKey.wordSpacing = wordSpacing;
+    cacheKey.script = si.analysis.script;
+    cacheKey.bidiLevel = si.analysis.bidiLevel;
+    cacheKey.flags = si.analysis.flags;
+    cacheKey.options = uint(kerningEnabled) | uint(letterSpacingIsAbsolute) << 1
+            | uint(shapingEnabled) << 2 | uint(option.useDesignMetrics()) << 3;
+    const bool cacheEnabled = cache->maxCost() > 0;
+
+    if (cacheEnabled) {
+        if (ShapingCacheEntry *entry = cache->object(cacheKey)) {
+            const int numGlyphs = entry->numGlyphs();
+            if (Q_UNLIKELY(!ensureSpace(numGlyphs))) {
+                Q_UNREACHABLE(); // ### report OOM error somehow
+                return;
+            }
+            copyGlyphs(availableGlyphs(&si), entry->glyphs(), numGlyphs);
+            memcpy(logClusters(&si), entry->logClusters.constData(), itemLength * sizeof(ushort));
+            si.num_glyphs = numGlyphs;
+            si.width = entry->width;
+            si.ascent = entry->ascent;
+            si.descent = entry->descent;
+            si.leading = entry->leading;
+            layoutData->used += numGlyphs;
+            ++cache->hits;
+            return;
+        }
+        ++cache->misses;
+    }
+
     // split up the item into parts that come from different font engines
     // k * 3 entries, array[k] == index in string, array[k + 1] == index in glyphs, array[k + 2] == engine index
     QVector<uint> itemBoundaries;
@@ -1150,6 +1330,19 @@ void QTextEngine::shapeText(int item) const
 
     for (int i = 0; i < si.num_glyphs; ++i)
         si.width += glyphs.advances[i] * !glyphs.attributes[i].dontPrint;
+
+    if (cacheEnabled) {
+        ShapingCacheEntry *entry = new ShapingCacheEntry(fontEngine, si.num_glyphs, itemLength);
+        copyGlyphs(entry->glyphs(), glyphs, si.num_glyphs);
+        memcpy(entry->logClusters.data(), logClusters(&si), itemLength * sizeof(ushort));
+        entry->width = si.width;
+        entry->ascent = si.ascent;
+        entry->descent = si.descent;
+        entry->leading = si.leading;
+        // The key refers to the layout's string, make it own a copy
+        cacheKey.text = QString(cacheKey.text.constData(), itemLength);
+        cache->insert(cacheKey, entry, entry->glyphData.size() + itemLength * (sizeof(ushort) + sizeof(QChar)));
+    }
 }
 
 #if QT_CONFIG(harfbuzz)
@@ -452,6 +452,9 @@ public:
 
     void shape(int item) const;
 
+    static void clearShapingCache();
+    static void shapingCacheStatistics(qint64 *hits, qint64 *misses);
+
     void justify(const QScriptLine &si);
     QFixed alignLine(const QScriptLine &line);
 
@@ -47,12 +47,20 @@
 #include <qendian.h>
 #include <qdebug.h>
 #include <qdir.h>
+#include <qpointer.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qthreadpool.h>
 
 #include <zlib.h>
 
+#include <limits>
+
 // Zip standard version for archives handled by this API
 // (actually, the only basic support of this version is implemented but it is enough for now)
 #define ZIP_VERSION 20
+// Version needed to extract entries that use the zip64 extensions
+#define ZIP64_VERSION 45
 
 #if 0
 #define ZDEBUG qDebug
@@ -72,6 +80,11 @@ static inline ushort readUShort(const uchar *data)
     return (data[0]) + (data[1]<<8);
 }
 
+static inline quint64 readULongLong(const uchar *data)
+{
+    return quint64(readUInt(data)) | (quint64(readUInt(data + 4)) << 32);
+}
+
 static inline void writeUInt(uchar *data, uint i)
 {
     data[0] = i & 0xff;
@@ -86,6 +99,12 @@ static inline void writeUShort(uchar *data, ushort i)
     data[1] = (i>>8) & 0xff;
 }
 
+static inline void writeULongLong(uchar *data, quint64 i)
+{
+    writeUInt(data, uint(i & 0xffffffff));
+    writeUInt(data + 4, uint(i >> 32));
+}
+
 static inline void copyUInt(uchar *dest, const uchar *src)
 {
     dest[0] = src[0];
@@ -408,15 +427,85 @@ struct EndOfDirectory
 };
 Q_DECLARE_TYPEINFO(EndOfDirectory, Q_PRIMITIVE_TYPE);
 
+struct Zip64EndOfDirectory
+{
+    uchar signature[4]; // 0x06064b50
+    uchar record_size[8];
+    uchar version_made[2];
+    uchar version_needed[2];
+    uchar this_disk[4];
+    uchar start_of_directory_disk[4];
+    uchar num_dir_entries_this_disk[8];
+    uchar num_dir_entries[8];
+    uchar directory_size[8];
+    uchar dir_start_offset[8];
+};
+Q_DECLARE_TYPEINFO(Zip64EndOfDirectory, Q_PRIMITIVE_TYPE);
+
+struct Zip64EndOfDirectoryLocator
+{
+    uchar signature[4]; // 0x07064b50
+    uchar start_of_directory_disk[4];
+    uchar eod_offset[8];
+    uchar num_disks[4];
+};
+Q_DECLARE_TYPEINFO(Zip64EndOfDirectoryLocator, Q_PRIMITIVE_TYPE);
+
+enum { Zip64ExtraFieldId = 0x0001 };
+
 struct FileHeader
 {
+    FileHeader()
+        : compressedSize(0), uncompressedSize(0), localHeaderOffset(0)
+    {}
+
+    void readZip64ExtraField();
+
     CentralFileHeader h;
     QByteArray file_name;
     QByteArray extra_field;
     QByteArray file_comment;
+    // the 32 bit fields of the header, or their zip64 replacements
+    qint64 compressedSize;
+    qint64 uncompressedSize;
+    qint64 localHeaderOffset;
 };
 Q_DECLARE_TYPEINFO(FileHeader, Q_MOVABLE_TYPE);
 
+void FileHeader::readZip64ExtraField()
+{
+    compressedSize = readUInt(h.compressed_size);
+    uncompressedSize = readUInt(h.uncompressed_size);
+    localHeaderOffset = readUInt(h.offset_local_header);
+
+    const uchar *data = reinterpret_cast<const uchar *>(extra_field.constData());
+    int pos = 0;
+    while (pos + 4 <= extra_field.size()) {
+        const ushort id = readUShort(data + pos);
+        const int size = readUShort(data + pos + 2);
+        pos += 4;
+        if (pos + size > extra_field.size())
+            break;
+        if (id == Zip64ExtraFieldId) {
+            // only the values whose 32 bit field is saturated are present, in this order
+            const uchar *field = data + pos;
+            const uchar *end = field + size;
+            if (uncompressedSize == 0xffffffff && field + 8 <= end) {
+                uncompressedSize = readULongLong(field);
+                field += 8;
+            }
+            if (compressedSize == 0xffffffff && field + 8 <= end) {
+                compressedSize = readULongLong(field);
+                field += 8;
+            }
+            if (localHeaderOffset == 0xffffffff && field + 8 <= end)
+                localHeaderOffset = readULongLong(field);
+            break;
+        }
+        pos += size;
+    }
+}
+
 class QZipPrivate
 {
 public:
@@ -438,13 +527,13 @@ public:
     bool dirtyFileTree;
     QVector<FileHeader> fileHeaders;
     QByteArray comment;
-    uint start_of_directory;
+    qint64 start_of_directory;
 };
 
 QZipReader::FileInfo QZipPrivate::fillFileInfo(int index) const
 {
     QZipReader::FileInfo fileInfo;
-    FileHeader header = fileHeaders.at(index);
+    const FileHeader &header = fileHeaders.at(index);
     quint32 mode = readUInt(header.h.external_file_attributes);
     const HostOS hostOS = HostOS(readUShort(header.h.version_made) >> 8);
     switch (hostOS) {
@@ -493,7 +582,7 @@ QZipReader::FileInfo QZipPrivate::fillFileInfo(int index) const
     const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
     fileInfo.filePath = inUtf8 ? QString::fromUtf8(header.file_name) : QString::fromLocal8Bit(header.file_name);
     fileInfo.crc = readUInt(header.h.crc_32);
-    fileInfo.size = readUInt(header.h.uncompressed_size);
+    fileInfo.size = header.uncompressedSize;
     fileInfo.lastModified = readMSDosDate(header.h.last_mod_file);
 
     // fix the file path, if broken (convert separators, eat leading and trailing ones)
@@ -517,10 +606,36 @@ public:
     }
 
     void scanFiles();
+    int indexOf(const QString &fileName) const;
+    qint64 seekToEntryData(const FileHeader &header, int *compressionMethod);
 
     QZipReader::Status status;
 };
 
+class QZipWriterEntry
+{
+public:
+    QZipWriterEntry() : compress(false) {}
+
+    void deflateContents();
+
+    FileHeader header;
+    QByteArray contents;
+    QByteArray data;
+    bool compress;
+    QSemaphore done;
+};
+
+class QZipDeflateTask : public QRunnable
+{
+public:
+    explicit QZipDeflateTask(QZipWriterEntry *entry) : entry(entry) {}
+    void run() Q_DECL_OVERRIDE { entry->deflateContents(); }
+
+private:
+    QZipWriterEntry *entry;
+};
+
 class QZipWriterPrivate : public QZipPrivate
 {
 public:
@@ -532,13 +647,28 @@ public:
     {
     }
 
+    ~QZipWriterPrivate()
+    {
+        writePendingEntries(/*wait=*/true);
+    }
+
     QZipWriter::Status status;
     QFile::Permissions permissions;
     QZipWriter::CompressionPolicy compressionPolicy;
 
     enum EntryType { Directory, File, Symlink };
 
+    // files at least this large are compressed on the global thread pool
+    enum { ParallelCompressionThreshold = 16 * 1024 };
+
+    void initHeader(FileHeader *header, EntryType type, const QString &fileName) const;
     void addEntry(EntryType type, const QString &fileName, const QByteArray &contents);
+    void addEntry(const QString &fileName, QIODevice *source);
+    void writeEntry(FileHeader &header, const QByteArray &data);
+    void writePendingEntries(bool wait);
+
+    // entries are written in the order they were added, once compressed
+    QVector<QZipWriterEntry *> pendingEntries;
 };
 
 LocalFileHeader CentralFileHeader::toLocalHeader() const
@@ -580,106 +710,287 @@ void QZipReaderPrivate::scanFiles()
         return;
     }
 
-    // find EndOfDirectory header
-    int i = 0;
-    int start_of_directory = -1;
-    int num_dir_entries = 0;
-    EndOfDirectory eod;
-    while (start_of_directory == -1) {
-        const int pos = device->size() - int(sizeof(EndOfDirectory)) - i;
-        if (pos < 0 || i > 65535) {
-            qWarning("QZip: EndOfDirectory not found");
-            return;
-        }
-
-        device->seek(pos);
-        device->read((char *)&eod, sizeof(EndOfDirectory));
-        if (readUInt(eod.signature) == 0x06054b50)
-            break;
-        ++i;
+    // find EndOfDirectory header. It is followed by a comment of at most 64 KB,
+    // so read the tail of the file in one go and search it backwards.
+    const qint64 fileSize = device->size();
+    const qint64 tailSize = qMin<qint64>(fileSize, sizeof(Zip64EndOfDirectoryLocator)
+                                                   + sizeof(EndOfDirectory) + 0xffff);
+    device->seek(fileSize - tailSize);
+    const QByteArray tail = device->read(tailSize);
+    const uchar *tailData = reinterpret_cast<const uchar *>(tail.constData());
+    int eodPos = tail.size() - int(sizeof(EndOfDirectory));
+    while (eodPos >= 0 && readUInt(tailData + eodPos) != 0x06054b50)
+        --eodPos;
+    if (eodPos < 0) {
+        qWarning("QZip: EndOfDirectory not found");
+        return;
     }
 
     // have the eod
-    start_of_directory = readUInt(eod.dir_start_offset);
-    num_dir_entries = readUShort(eod.num_dir_entries);
-    ZDEBUG("start_of_directory at %d, num_dir_entries=%d", start_of_directory, num_dir_entries);
+    EndOfDirectory eod;
+    memcpy(&eod, tailData + eodPos, sizeof(EndOfDirectory));
+    qint64 start_of_directory = readUInt(eod.dir_start_offset);
+    qint64 directory_size = readUInt(eod.directory_size);
+    qint64 num_dir_entries = readUShort(eod.num_dir_entries);
+    const int trailing = tail.size() - eodPos - int(sizeof(EndOfDirectory));
     int comment_length = readUShort(eod.comment_length);
-    if (comment_length != i)
+    if (comment_length != trailing)
         qWarning("QZip: failed to parse zip file.");
-    comment = device->read(qMin(comment_length, i));
+    comment = tail.mid(eodPos + int(sizeof(EndOfDirectory)), qMin(comment_length, trailing));
+
+    // a zip64 end of directory record replaces the values of the eod
+    if (eodPos >= int(sizeof(Zip64EndOfDirectoryLocator))) {
+        Zip64EndOfDirectoryLocator locator;
+        memcpy(&locator, tailData + eodPos - sizeof(Zip64EndOfDirectoryLocator), sizeof(Zip64EndOfDirectoryLocator));
+        if (readUInt(locator.signature) == 0x07064b50) {
+            Zip64EndOfDirectory eod64;
+            device->seek(readULongLong(locator.eod_offset));
+            if (device->read((char *)&eod64, sizeof(Zip64EndOfDirectory)) == qint64(sizeof(Zip64EndOfDirectory))
+                && readUInt(eod64.signature) == 0x06064b50) {
+                start_of_directory = readULongLong(eod64.dir_start_offset);
+                directory_size = readULongLong(eod64.directory_size);
+                num_dir_entries = readULongLong(eod64.num_dir_entries);
+            } else {
+                qWarning("QZip: invalid zip64 end of directory record");
+            }
+        }
+    }
+    ZDEBUG("start_of_directory at %lld, num_dir_entries=%lld", start_of_directory, num_dir_entries);
 
+    if (start_of_directory < 0 || directory_size < 0 || start_of_directory + directory_size > fileSize
+        || directory_size > std::numeric_limits<int>::max()) {
+        qWarning("QZip: invalid central directory");
+        return;
+    }
 
-    device->seek(start_of_directory);
-    for (i = 0; i < num_dir_entries; ++i) {
+    // map the directory if we can, instead of reading it entry by entry
+    QFileDevice *file = qobject_cast<QFileDevice *>(device);
+    uchar *mapped = (file && directory_size > 0) ? file->map(start_of_directory, directory_size) : 0;
+    QByteArray buffer;
+    const uchar *p = mapped;
+    if (!mapped) {
+        device->seek(start_of_directory);
+        buffer = device->read(directory_size);
+        p = reinterpret_cast<const uchar *>(buffer.constData());
+        directory_size = buffer.size();
+    }
+    const uchar *end = p + directory_size;
+
+    fileHeaders.reserve(int(qMin<qint64>(num_dir_entries, directory_size / qint64(sizeof(CentralFileHeader)))));
+    for (qint64 i = 0; i < num_dir_entries; ++i) {
         FileHeader header;
-        int read = device->read((char *) &header.h, sizeof(CentralFileHeader));
-        if (read < (int)sizeof(CentralFileHeader)) {
+        if (end - p < qptrdiff(sizeof(CentralFileHeader))) {
             qWarning("QZip: Failed to read complete header, index may be incomplete");
             break;
         }
+        memcpy(&header.h, p, sizeof(CentralFileHeader));
+        p += sizeof(CentralFileHeader);
         if (readUInt(header.h.signature) != 0x02014b50) {
             qWarning("QZip: invalid header signature, index may be incomplete");
             break;
         }
 
         int l = readUShort(header.h.file_name_length);
-        header.file_name = device->read(l);
-        if (header.file_name.length() != l) {
+        if (end - p < l) {
             qWarning("QZip: Failed to read filename from zip index, index may be incomplete");
             break;
         }
+        header.file_name = QByteArray(reinterpret_cast<const char *>(p), l);
+        p += l;
         l = readUShort(header.h.extra_field_length);
-        header.extra_field = device->read(l);
-        if (header.extra_field.length() != l) {
+        if (end - p < l) {
             qWarning("QZip: Failed to read extra field in zip file, skipping file, index may be incomplete");
             break;
         }
+        header.extra_field = QByteArray(reinterpret_cast<const char *>(p), l);
+        p += l;
         l = readUShort(header.h.file_comment_length);
-        header.file_comment = device->read(l);
-        if (header.file_comment.length() != l) {
+        if (end - p < l) {
             qWarning("QZip: Failed to read read file comment, index may be incomplete");
             break;
         }
+        header.file_comment = QByteArray(reinterpret_cast<const char *>(p), l);
+        p += l;
+        header.readZip64ExtraField();
 
         ZDEBUG("found file '%s'", header.file_name.data());
         fileHeaders.append(header);
     }
+
+    if (mapped)
+        file->unmap(mapped);
+}
+
+int QZipReaderPrivate::indexOf(const QString &fileName) const
+{
+    for (int i = 0; i < fileHeaders.size(); ++i) {
+        if (QString::fromLocal8Bit(fileHeaders.at(i).file_name) == fileName)
+            return i;
+    }
+    return -1;
 }
 
-void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
+// Positions the device at the (compressed) data of the entry described by
+// \a header. Returns the offset of the data, or -1 if it can't be extracted.
+qint64 QZipReaderPrivate::seekToEntryData(const FileHeader &header, int *compressionMethod)
 {
-#ifndef NDEBUG
-    static const char *const entryTypes[] = {
-        "directory",
-        "file     ",
-        "symlink  " };
-    ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
-#endif
+    ushort version_needed = readUShort(header.h.version_needed);
+    if (version_needed > ZIP64_VERSION) {
+        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+        return -1;
+    }
 
-    if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
-        status = QZipWriter::FileOpenError;
-        return;
+    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
+    if ((general_purpose_bits & Encrypted) != 0) {
+        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return -1;
     }
-    device->seek(start_of_directory);
 
-    // don't compress small files
-    QZipWriter::CompressionPolicy compression = compressionPolicy;
-    if (compressionPolicy == QZipWriter::AutoCompress) {
-        if (contents.length() < 64)
-            compression = QZipWriter::NeverCompress;
-        else
-            compression = QZipWriter::AlwaysCompress;
+    device->seek(header.localHeaderOffset);
+    LocalFileHeader lh;
+    if (device->read((char *)&lh, sizeof(LocalFileHeader)) != qint64(sizeof(LocalFileHeader))) {
+        qWarning("QZip: Failed to read local file header");
+        return -1;
     }
+    const qint64 offset = device->pos() + readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+    device->seek(offset);
 
-    FileHeader header;
-    memset(&header.h, 0, sizeof(CentralFileHeader));
-    writeUInt(header.h.signature, 0x02014b50);
+    *compressionMethod = readUShort(lh.compression_method);
+    return offset;
+}
+
+/*
+    A sequential device that reads one entry of an archive, decompressing it
+    on the fly. The archive device is shared with the reader; every read
+    seeks it to the current position of the entry.
+*/
+class QZipEntryDevice : public QIODevice
+{
+public:
+    QZipEntryDevice(QIODevice *archive, qint64 dataOffset, const FileHeader &header, int compressionMethod)
+        : archive(archive), dataOffset(dataOffset),
+          compressedSize(header.compressedSize), uncompressedSize(header.uncompressedSize),
+          compressionMethod(compressionMethod), expectedCrc(readUInt(header.h.crc_32)),
+          crc(::crc32(0, 0, 0)), consumed(0), produced(0), finished(false)
+    {
+        memset(&stream, 0, sizeof(stream));
+        if (compressionMethod == CompressionMethodDeflated) {
+            inflateInit2(&stream, -MAX_WBITS);
+            inputBuffer.resize(int(qMin<qint64>(compressedSize, 64 * 1024)));
+        }
+    }
+
+    ~QZipEntryDevice()
+    {
+        if (compressionMethod == CompressionMethodDeflated)
+            inflateEnd(&stream);
+    }
+
+    bool isSequential() const Q_DECL_OVERRIDE { return true; }
+    qint64 size() const Q_DECL_OVERRIDE { return uncompressedSize; }
+    qint64 bytesAvailable() const Q_DECL_OVERRIDE
+    { return uncompressedSize - produced + QIODevice::bytesAvailable(); }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) Q_DECL_OVERRIDE;
+    qint64 writeData(const char *, qint64) Q_DECL_OVERRIDE { return -1; }
+
+private:
+    qint64 readCompressed(char *data, qint64 maxlen);
+    bool finish();
+
+    QPointer<QIODevice> archive;
+    const qint64 dataOffset;
+    const qint64 compressedSize;
+    const qint64 uncompressedSize;
+    const int compressionMethod;
+    const uint expectedCrc;
+    uint crc;
+    qint64 consumed;
+    qint64 produced;
+    bool finished;
+    z_stream stream;
+    QByteArray inputBuffer;
+};
+
+qint64 QZipEntryDevice::readCompressed(char *data, qint64 maxlen)
+{
+    maxlen = qMin(maxlen, compressedSize - consumed);
+    if (maxlen <= 0)
+        return 0;
+    if (!archive || !archive->seek(dataOffset + consumed))
+        return -1;
+    const qint64 read = archive->read(data, maxlen);
+    if (read > 0)
+        consumed += read;
+    return read;
+}
+
+bool QZipEntryDevice::finish()
+{
+    finished = true;
+    if (produced != uncompressedSize || crc != expectedCrc) {
+        qWarning("QZip: Checksum mismatch, the entry is corrupted");
+        setErrorString(QStringLiteral("Checksum mismatch"));
+        return false;
+    }
+    return true;
+}
+
+qint64 QZipEntryDevice::readData(char *data, qint64 maxlen)
+{
+    if (finished)
+        return 0;
+
+    if (compressionMethod == CompressionMethodStored) {
+        const qint64 read = readCompressed(data, maxlen);
+        if (read <= 0) {
+            setErrorString(QStringLiteral("Unexpected end of archive"));
+            return -1;
+        }
+        produced += read;
+        crc = ::crc32(crc, reinterpret_cast<const uchar *>(data), uInt(read));
+        if (consumed == compressedSize && !finish())
+            return -1;
+        return read;
+    }
+
+    stream.next_out = reinterpret_cast<Bytef *>(data);
+    stream.avail_out = uInt(qMin<qint64>(maxlen, 1 << 30));
+    bool streamEnd = false;
+    while (stream.avail_out > 0 && !streamEnd) {
+        if (stream.avail_in == 0) {
+            const qint64 read = readCompressed(inputBuffer.data(), inputBuffer.size());
+            if (read <= 0) {
+                setErrorString(QStringLiteral("Unexpected end of archive"));
+                return -1;
+            }
+            stream.next_in = reinterpret_cast<Bytef *>(inputBuffer.data());
+            stream.avail_in = uInt(read);
+        }
+        const int res = inflate(&stream, Z_NO_FLUSH);
+        if (res == Z_STREAM_END) {
+            streamEnd = true;
+        } else if (res != Z_OK) {
+            qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+            setErrorString(QStringLiteral("Input data is corrupted"));
+            return -1;
+        }
+    }
+
+    const qint64 read = reinterpret_cast<char *>(stream.next_out) - data;
+    produced += read;
+    crc = ::crc32(crc, reinterpret_cast<const uchar *>(data), uInt(read));
+    if (streamEnd && !finish())
+        return -1;
+    return read;
+}
 
-    writeUShort(header.h.version_needed, ZIP_VERSION);
+void QZipWriterEntry::deflateContents()
+{
     writeUInt(header.h.uncompressed_size, contents.length());
-    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
-    QByteArray data = contents;
-    if (compression == QZipWriter::AlwaysCompress) {
+    data = contents;
+    if (compress) {
         writeUShort(header.h.compression_method, CompressionMethodDeflated);
 
        ulong len = contents.length();
@@ -709,25 +1020,39 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
     uint crc_32 = ::crc32(0, 0, 0);
     crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.length());
     writeUInt(header.h.crc_32, crc_32);
+    header.compressedSize = data.length();
+    header.uncompressedSize = contents.length();
+
+    contents.clear();
+    done.release();
+}
+
+void QZipWriterPrivate::initHeader(FileHeader *header, EntryType type, const QString &fileName) const
+{
+    memset(&header->h, 0, sizeof(CentralFileHeader));
+    writeUInt(header->h.signature, 0x02014b50);
+
+    writeUShort(header->h.version_needed, ZIP_VERSION);
+    writeMSDosDate(header->h.last_mod_file, QDateTime::currentDateTime());
 
     // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
     ushort general_purpose_bits = Utf8Names; // always use utf-8
-    writeUShort(header.h.general_purpose_bits, general_purpose_bits);
+    writeUShort(header->h.general_purpose_bits, general_purpose_bits);
 
     const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
-    header.file_name = inUtf8 ? fileName.toUtf8() : fileName.toLocal8Bit();
-    if (header.file_name.size() > 0xffff) {
+    header->file_name = inUtf8 ? fileName.toUtf8() : fileName.toLocal8Bit();
+    if (header->file_name.size() > 0xffff) {
         qWarning("QZip: Filename is too long, chopping it to 65535 bytes");
-        header.file_name = header.file_name.left(0xffff); // ### don't break the utf-8 sequence, if any
+        header->file_name = header->file_name.left(0xffff); // ### don't break the utf-8 sequence, if any
     }
-    if (header.file_comment.size() + header.file_name.size() > 0xffff) {
+    if (header->file_comment.size() + header->file_name.size() > 0xffff) {
         qWarning("QZip: File comment is too long, chopping it to 65535 bytes");
-        header.file_comment.truncate(0xffff - header.file_name.size()); // ### don't break the utf-8 sequence, if any
+        header->file_comment.truncate(0xffff - header->file_name.size()); // ### don't break the utf-8 sequence, if any
     }
-    writeUShort(header.h.file_name_length, header.file_name.length());
+    writeUShort(header->h.file_name_length, header->file_name.length());
     //h.extra_field_length[2];
 
-    writeUShort(header.h.version_made, HostUnix << 8);
+    writeUShort(header->h.version_made, HostUnix << 8);
     //uchar internal_file_attributes[2];
     //uchar external_file_attributes[4];
     quint32 mode = permissionsToMode(permissions);
@@ -745,10 +1070,71 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
         Q_UNREACHABLE();
         break;
     }
-    writeUInt(header.h.external_file_attributes, mode << 16);
-    writeUInt(header.h.offset_local_header, start_of_directory);
+    writeUInt(header->h.external_file_attributes, mode << 16);
+}
+
+void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
+{
+#ifndef NDEBUG
+    static const char *const entryTypes[] = {
+        "directory",
+        "file     ",
+        "symlink  " };
+    ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
+#endif
+
+    if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
+        status = QZipWriter::FileOpenError;
+        return;
+    }
+
+    // don't compress small files
+    QZipWriter::CompressionPolicy compression = compressionPolicy;
+    if (compressionPolicy == QZipWriter::AutoCompress) {
+        if (contents.length() < 64)
+            compression = QZipWriter::NeverCompress;
+        else
+            compression = QZipWriter::AlwaysCompress;
+    }
+
+    QZipWriterEntry *entry = new QZipWriterEntry;
+    initHeader(&entry->header, type, fileName);
+    entry->contents = contents;
+    entry->compress = compression == QZipWriter::AlwaysCompress;
+    pendingEntries.append(entry);
+
+    // Compress large files on the thread pool, so that several entries are
+    // deflated in parallel. If the pool is busy, compress in this thread.
+    QThreadPool *pool = QThreadPool::globalInstance();
+    if (!entry->compress || contents.length() < ParallelCompressionThreshold
+        || !pool->tryStart(new QZipDeflateTask(entry))) {
+        entry->deflateContents();
+    }
 
+    // bound the amount of memory held by entries waiting to be written
+    writePendingEntries(/*wait=*/pendingEntries.size() > qMax(1, pool->maxThreadCount()));
+}
+
+void QZipWriterPrivate::writePendingEntries(bool wait)
+{
+    while (!pendingEntries.isEmpty()) {
+        QZipWriterEntry *entry = pendingEntries.first();
+        if (wait)
+            entry->done.acquire();
+        else if (!entry->done.tryAcquire())
+            break;
+        pendingEntries.removeFirst();
+        writeEntry(entry->header, entry->data);
+        delete entry;
+    }
+}
+
+void QZipWriterPrivate::writeEntry(FileHeader &header, const QByteArray &data)
+{
+    device->seek(start_of_directory);
 
+    header.localHeaderOffset = start_of_directory;
+    writeUInt(header.h.offset_local_header, uint(qMin<qint64>(start_of_directory, 0xffffffff)));
     fileHeaders.append(header);
 
     LocalFileHeader h = header.h.toLocalHeader();
@@ -759,6 +1145,99 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
     dirtyFileTree = true;
 }
 
+void QZipWriterPrivate::addEntry(const QString &fileName, QIODevice *source)
+{
+    ZDEBUG() << "adding file      :" << fileName.toUtf8().data();
+
+    writePendingEntries(/*wait=*/true);
+
+    if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
+        status = QZipWriter::FileOpenError;
+        return;
+    }
+
+    // don't compress small files
+    QZipWriter::CompressionPolicy compression = compressionPolicy;
+    if (compressionPolicy == QZipWriter::AutoCompress) {
+        if (!source->isSequential() && source->size() < 64)
+            compression = QZipWriter::NeverCompress;
+        else
+            compression = QZipWriter::AlwaysCompress;
+    }
+    const bool compress = compression == QZipWriter::AlwaysCompress;
+
+    FileHeader header;
+    initHeader(&header, File, fileName);
+    if (compress)
+        writeUShort(header.h.compression_method, CompressionMethodDeflated);
+
+    // write the local header now, and patch in the sizes and the crc afterwards
+    header.localHeaderOffset = start_of_directory;
+    writeUInt(header.h.offset_local_header, uint(qMin<qint64>(start_of_directory, 0xffffffff)));
+    device->seek(start_of_directory);
+    LocalFileHeader h = header.h.toLocalHeader();
+    device->write((const char *)&h, sizeof(LocalFileHeader));
+    device->write(header.file_name);
+    const qint64 dataStart = device->pos();
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (compress && deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
+        status = QZipWriter::FileError;
+        return;
+    }
+
+    QByteArray input(64 * 1024, Qt::Uninitialized);
+    QByteArray output(compress ? 64 * 1024 : 0, Qt::Uninitialized);
+    uint crc_32 = ::crc32(0, 0, 0);
+    qint64 uncompressed_size = 0;
+    for (;;) {
+        const qint64 read = source->read(input.data(), input.size());
+        if (read > 0) {
+            crc_32 = ::crc32(crc_32, (const uchar *)input.constData(), uInt(read));
+            uncompressed_size += read;
+        }
+        if (!compress) {
+            if (read <= 0)
+                break;
+            device->write(input.constData(), read);
+            continue;
+        }
+
+        const int flush = read > 0 ? Z_NO_FLUSH : Z_FINISH;
+        stream.next_in = reinterpret_cast<Bytef *>(input.data());
+        stream.avail_in = uInt(qMax<qint64>(read, 0));
+        do {
+            stream.next_out = reinterpret_cast<Bytef *>(output.data());
+            stream.avail_out = uInt(output.size());
+            deflate(&stream, flush);
+            device->write(output.constData(), output.size() - stream.avail_out);
+        } while (stream.avail_out == 0);
+        if (flush == Z_FINISH)
+            break;
+    }
+    if (compress)
+        deflateEnd(&stream);
+
+    const qint64 dataEnd = device->pos();
+    if (uncompressed_size > 0xffffffff || dataEnd - dataStart > 0xffffffff)
+        qWarning("QZip: Entries larger than 4 GB are not supported, '%s' will be truncated", header.file_name.constData());
+    header.compressedSize = dataEnd - dataStart;
+    header.uncompressedSize = uncompressed_size;
+    writeUInt(header.h.compressed_size, uint(header.compressedSize));
+    writeUInt(header.h.uncompressed_size, uint(header.uncompressedSize));
+    writeUInt(header.h.crc_32, crc_32);
+    fileHeaders.append(header);
+
+    h = header.h.toLocalHeader();
+    device->seek(header.localHeaderOffset);
+    device->write((const char *)&h, sizeof(LocalFileHeader));
+    device->seek(dataEnd);
+    start_of_directory = dataEnd;
+    dirtyFileTree = true;
+}
+
 //////////////////////////////  Reader
 
 /*!
@@ -937,41 +1416,23 @@ QZipReader::FileInfo QZipReader::entryInfoAt(int index) const
 QByteArray QZipReader::fileData(const QString &fileName) const
 {
     d->scanFiles();
-    int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromLocal8Bit(d->fileHeaders.at(i).file_name) == fileName)
-            break;
-    }
-    if (i == d->fileHeaders.size())
+    const int i = d->indexOf(fileName);
+    if (i == -1)
         return QByteArray();
 
-    FileHeader header = d->fileHeaders.at(i);
-
-    ushort version_needed = readUShort(header.h.version_needed);
-    if (version_needed > ZIP_VERSION) {
-        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+    const FileHeader &header = d->fileHeaders.at(i);
+    if (header.compressedSize > std::numeric_limits<int>::max()
+        || header.uncompressedSize > std::numeric_limits<int>::max()) {
+        qWarning("QZip: Entry is too large to be extracted into memory, use openEntry() instead.");
         return QByteArray();
     }
+    int compressed_size = int(header.compressedSize);
+    int uncompressed_size = int(header.uncompressedSize);
 
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-    //qDebug("uncompressing file %d: local header at %d", i, start);
-
-    d->device->seek(start);
-    LocalFileHeader lh;
-    d->device->read((char *)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
-    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
-
-    if ((general_purpose_bits & Encrypted) != 0) {
-        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+    int compression_method;
+    if (d->seekToEntryData(header, &compression_method) == -1)
         return QByteArray();
-    }
+    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
 
     //qDebug("file at %lld", d->device->pos());
     QByteArray compressed = d->device->read(compressed_size);
@@ -1014,6 +1475,40 @@ QByteArray QZipReader::fileData(const QString &fileName) const
     return QByteArray();
 }
 
+/*!
+    \since 5.11
+
+    Returns a sequential device that decompresses the entry \a fileName while
+    it is read, or \c nullptr if there is no such entry or it can't be
+    extracted. Unlike fileData(), this does not hold the whole entry in
+    memory, and works for entries larger than 2 GB.
+
+    The caller takes ownership of the device. It reads from device(), so
+    only one entry should be read at a time, and the device becomes
+    unusable once the reader is destroyed.
+*/
+QIODevice *QZipReader::openEntry(const QString &fileName) const
+{
+    d->scanFiles();
+    const int i = d->indexOf(fileName);
+    if (i == -1)
+        return Q_NULLPTR;
+
+    const FileHeader &header = d->fileHeaders.at(i);
+    int compression_method;
+    const qint64 offset = d->seekToEntryData(header, &compression_method);
+    if (offset == -1)
+        return Q_NULLPTR;
+    if (compression_method != CompressionMethodStored && compression_method != CompressionMethodDeflated) {
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
+        return Q_NULLPTR;
+    }
+
+    QZipEntryDevice *entry = new QZipEntryDevice(d->device, offset, header, compression_method);
+    entry->open(QIODevice::ReadOnly);
+    return entry;
+}
+
 /*!
     Extracts the full contents of the zip file into \a destinationDir on
     the local filesystem.
@@ -1060,7 +1555,13 @@ bool QZipReader::extractAll(const QString &destinationDir) const
             QFile f(absPath);
             if (!f.open(QIODevice::WriteOnly))
                 return false;
-            f.write(fileData(fi.filePath));
+            QScopedPointer<QIODevice> entry(openEntry(fi.filePath));
+            if (entry) {
+                char buffer[16 * 1024];
+                qint64 read;
+                while ((read = entry->read(buffer, sizeof(buffer))) > 0)
+                    f.write(buffer, read);
+            }
             f.setPermissions(fi.permissions);
             f.close();
         }
@@ -1279,8 +1780,8 @@ void QZipWriter::addFile(const QString &fileName, const QByteArray &data)
 
 /*!
     Add a file to the archive with \a device as the source of the contents.
-    The contents returned from QIODevice::readAll() will be used as the
-    filedata.
+    The device is read and compressed in chunks until it returns no more
+    data, so the contents are never held in memory as a whole.
     The file will be stored in the archive using the \a fileName which
     includes the full path in the archive.
 */
@@ -1296,7 +1797,7 @@ void QZipWriter::addFile(const QString &fileName, QIODevice *device)
             return;
         }
     }
-    d->addEntry(QZipWriterPrivate::File, QDir::fromNativeSeparators(fileName), device->readAll());
+    d->addEntry(QDir::fromNativeSeparators(fileName), device);
     if (opened)
         device->close();
 }
@@ -1329,6 +1830,8 @@ void QZipWriter::addSymLink(const QString &fileName, const QString &destination)
 */
 void QZipWriter::close()
 {
+    d->writePendingEntries(/*wait=*/true);
+
     if (!(d->device->openMode() & QIODevice::WriteOnly)) {
         d->device->close();
         return;
@@ -1339,22 +1842,64 @@ void QZipWriter::close()
     // write new directory
     for (int i = 0; i < d->fileHeaders.size(); ++i) {
         const FileHeader &header = d->fileHeaders.at(i);
+        if (header.localHeaderOffset > 0xffffffff) {
+            // the entry starts beyond 4 GB, store its offset in a zip64 extra field
+            FileHeader zip64Header = header;
+            uchar extra[12];
+            writeUShort(extra, Zip64ExtraFieldId);
+            writeUShort(extra + 2, 8);
+            writeULongLong(extra + 4, header.localHeaderOffset);
+            zip64Header.extra_field.append((const char *)extra, sizeof(extra));
+            writeUShort(zip64Header.h.extra_field_length, zip64Header.extra_field.length());
+            writeUShort(zip64Header.h.version_needed, ZIP64_VERSION);
+            writeUInt(zip64Header.h.offset_local_header, 0xffffffff);
+            d->device->write((const char *)&zip64Header.h, sizeof(CentralFileHeader));
+            d->device->write(zip64Header.file_name);
+            d->device->write(zip64Header.extra_field);
+            d->device->write(zip64Header.file_comment);
+            continue;
+        }
         d->device->write((const char *)&header.h, sizeof(CentralFileHeader));
         d->device->write(header.file_name);
         d->device->write(header.extra_field);
         d->device->write(header.file_comment);
     }
-    int dir_size = d->device->pos() - d->start_of_directory;
+    const qint64 dir_end = d->device->pos();
+    const qint64 dir_size = dir_end - d->start_of_directory;
+    const bool zip64 = d->fileHeaders.size() >= 0xffff || d->start_of_directory >= 0xffffffff
+            || dir_size >= 0xffffffff;
+    if (zip64) {
+        // write zip64 end of directory record and its locator
+        Zip64EndOfDirectory eod64;
+        memset(&eod64, 0, sizeof(Zip64EndOfDirectory));
+        writeUInt(eod64.signature, 0x06064b50);
+        writeULongLong(eod64.record_size, sizeof(Zip64EndOfDirectory) - 12);
+        writeUShort(eod64.version_made, (HostUnix << 8) | ZIP64_VERSION);
+        writeUShort(eod64.version_needed, ZIP64_VERSION);
+        writeULongLong(eod64.num_dir_entries_this_disk, d->fileHeaders.size());
+        writeULongLong(eod64.num_dir_entries, d->fileHeaders.size());
+        writeULongLong(eod64.directory_size, dir_size);
+        writeULongLong(eod64.dir_start_offset, d->start_of_directory);
+        d->device->write((const char *)&eod64, sizeof(Zip64EndOfDirectory));
+
+        Zip64EndOfDirectoryLocator locator;
+        memset(&locator, 0, sizeof(Zip64EndOfDirectoryLocator));
+        writeUInt(locator.signature, 0x07064b50);
+        writeULongLong(locator.eod_offset, dir_end);
+        writeUInt(locator.num_disks, 1);
+        d->device->write((const char *)&locator, sizeof(Zip64EndOfDirectoryLocator));
+    }
     // write end of directory
     EndOfDirectory eod;
     memset(&eod, 0, sizeof(EndOfDirectory));
     writeUInt(eod.signature, 0x06054b50);
     //uchar this_disk[2];
     //uchar start_of_directory_disk[2];
-    writeUShort(eod.num_dir_entries_this_disk, d->fileHeaders.size());
-    writeUShort(eod.num_dir_entries, d->fileHeaders.size());
-    writeUInt(eod.directory_size, dir_size);
-    writeUInt(eod.dir_start_offset, d->start_of_directory);
+    const ushort num_dir_entries = zip64 ? 0xffff : ushort(d->fileHeaders.size());
+    writeUShort(eod.num_dir_entries_this_disk, num_dir_entries);
+    writeUShort(eod.num_dir_entries, num_dir_entries);
+    writeUInt(eod.directory_size, zip64 ? 0xffffffff : uint(dir_size));
+    writeUInt(eod.dir_start_offset, zip64 ? 0xffffffff : uint(d->start_of_directory));
     writeUShort(eod.comment_length, d->comment.length());
 
     d->device->write((const char *)&eod, sizeof(EndOfDirectory));
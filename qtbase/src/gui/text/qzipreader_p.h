@@ -100,6 +100,7 @@ public:
 
     FileInfo entryInfoAt(int index) const;
     QByteArray fileData(const QString &fileName) const;
+    QIODevice *openEntry(const QString &fileName) const;
     bool extractAll(const QString &destinationDir) const;
 
     enum Status {
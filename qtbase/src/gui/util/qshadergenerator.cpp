@@ -41,6 +41,10 @@
 
 #include "qshaderlanguage_p.h"
 
+#include <QtCore/qcache.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qmutex.h>
+
 QT_BEGIN_NAMESPACE
 
 namespace
@@ -254,32 +258,111 @@ namespace
         Q_UNREACHABLE();
     }
 
+    QByteArray parameterValue(const QVariant &parameter, const QShaderFormat &format)
+    {
+        if (parameter.userType() == qMetaTypeId<QShaderLanguage::StorageQualifier>()) {
+            const auto qualifier = parameter.value<QShaderLanguage::StorageQualifier>();
+            return toGlsl(qualifier, format);
+        } else if (parameter.userType() == qMetaTypeId<QShaderLanguage::VariableType>()) {
+            const auto type = parameter.value<QShaderLanguage::VariableType>();
+            return toGlsl(type);
+        } else {
+            return parameter.toString().toUtf8();
+        }
+    }
+
     QByteArray replaceParameters(const QByteArray &original, const QShaderNode &node, const QShaderFormat &format)
     {
         auto result = original;
 
         for (const auto &parameterName : node.parameterNames()) {
             const auto placeholder = QByteArray(QByteArrayLiteral("$") + parameterName.toUtf8());
-            const auto parameter = node.parameter(parameterName);
-            if (parameter.userType() == qMetaTypeId<QShaderLanguage::StorageQualifier>()) {
-                const auto qualifier = parameter.value<QShaderLanguage::StorageQualifier>();
-                const auto value = toGlsl(qualifier, format);
-                result.replace(placeholder, value);
-            } else if (parameter.userType() == qMetaTypeId<QShaderLanguage::VariableType>()) {
-                const auto type = parameter.value<QShaderLanguage::VariableType>();
-                const auto value = toGlsl(type);
-                result.replace(placeholder, value);
-            } else {
-                const auto value = parameter.toString().toUtf8();
-                result.replace(placeholder, value);
-            }
+            const auto value = parameterValue(node.parameter(parameterName), format);
+            result.replace(placeholder, value);
         }
 
         return result;
     }
+
+    // Generated code only depends on the rules of the requested format and on
+    // the substituted parameter values, so that is all the key covers. Hashing
+    // is linear in the size of the graph, unlike resolving its statements.
+    QByteArray cacheKey(const QShaderGraph &graph, const QShaderFormat &format, const QStringList &enabledLayers)
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        const auto addData = [&hash] (const QByteArray &data) {
+            const auto size = data.size();
+            hash.addData(reinterpret_cast<const char *>(&size), sizeof(size));
+            hash.addData(data);
+        };
+        const auto addList = [&addData] (const QStringList &list) {
+            addData(QByteArray::number(list.size()));
+            for (const auto &item : list)
+                addData(item.toUtf8());
+        };
+
+        addData(QByteArray::number(format.isValid() ? int(format.api()) : -1));
+        addData(format.version().toString().toUtf8());
+        addList(format.extensions());
+        addData(format.vendor().toUtf8());
+
+        auto sortedLayers = enabledLayers;
+        sortedLayers.sort();
+        sortedLayers.removeDuplicates();
+        addList(sortedLayers);
+
+        const auto nodes = graph.nodes();
+        addData(QByteArray::number(nodes.size()));
+        for (const auto &node : nodes) {
+            addData(node.uuid().toRfc4122());
+            addList(node.layers());
+
+            const auto ports = node.ports();
+            addData(QByteArray::number(ports.size()));
+            for (const auto &port : ports) {
+                addData(QByteArray::number(int(port.direction)));
+                addData(port.name.toUtf8());
+            }
+
+            auto parameterNames = node.parameterNames();
+            parameterNames.sort();
+            addList(parameterNames);
+            for (const auto &parameterName : qAsConst(parameterNames))
+                addData(parameterValue(node.parameter(parameterName), format));
+
+            const auto rule = node.rule(format);
+            addData(rule.substitution);
+            addData(QByteArray::number(rule.headerSnippets.size()));
+            for (const auto &snippet : rule.headerSnippets)
+                addData(snippet);
+        }
+
+        const auto edges = graph.edges();
+        addData(QByteArray::number(edges.size()));
+        for (const auto &edge : edges) {
+            addList(edge.layers);
+            addData(edge.sourceNodeUuid.toRfc4122());
+            addData(edge.sourcePortName.toUtf8());
+            addData(edge.targetNodeUuid.toRfc4122());
+            addData(edge.targetPortName.toUtf8());
+        }
+
+        return hash.result();
+    }
+
+    struct ShaderCodeCache
+    {
+        // Cost is the code size in bytes
+        ShaderCodeCache() : cache(4 * 1024 * 1024) {}
+
+        QMutex mutex;
+        QCache<QByteArray, QByteArray> cache;
+    };
 }
 
-QByteArray QShaderGenerator::createShaderCode(const QStringList &enabledLayers) const
+Q_GLOBAL_STATIC(ShaderCodeCache, shaderCodeCache)
+
+static QByteArray generateShaderCode(const QShaderGraph &graph, const QShaderFormat &format, const QStringList &enabledLayers)
 {
     auto code = QByteArrayList();
 
@@ -348,4 +431,31 @@ QByteArray QShaderGenerator::createShaderCode(const QStringList &enabledLayers)
     return code.join('\n');
 }
 
+/*
+    Generated code is memoised on a digest of everything it depends on, so
+    requesting the same material variant again skips resolving the graph. As
+    the output is byte for byte identical, it also keeps hitting the program
+    binary cache of QOpenGLShaderProgram, which is keyed on the shader source.
+*/
+QByteArray QShaderGenerator::createShaderCode(const QStringList &enabledLayers) const
+{
+    const auto key = cacheKey(graph, format, enabledLayers);
+
+    auto *codeCache = shaderCodeCache();
+    if (codeCache) {
+        QMutexLocker locker(&codeCache->mutex);
+        if (const auto cached = codeCache->cache.object(key))
+            return *cached;
+    }
+
+    const auto code = generateShaderCode(graph, format, enabledLayers);
+
+    if (codeCache) {
+        QMutexLocker locker(&codeCache->mutex);
+        codeCache->cache.insert(key, new QByteArray(code), qMax(1, code.size()));
+    }
+
+    return code;
+}
+
 QT_END_NAMESPACE
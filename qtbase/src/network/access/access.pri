@@ -13,6 +13,8 @@ HEADERS += \
     access/qnetworkaccessmanager.h \
     access/qnetworkaccessmanager_p.h \
     access/qnetworkaccesscache_p.h \
+    access/qnetworkconnectionpool.h \
+    access/qnetworkconnectionpool_p.h \
     access/qnetworkaccessbackend_p.h \
     access/qnetworkaccessdebugpipebackend_p.h \
     access/qnetworkaccessfilebackend_p.h \
@@ -52,6 +54,7 @@ SOURCES += \
     access/qnetworkaccessauthenticationmanager.cpp \
     access/qnetworkaccessmanager.cpp \
     access/qnetworkaccesscache.cpp \
+    access/qnetworkconnectionpool.cpp \
     access/qnetworkaccessbackend.cpp \
     access/qnetworkaccessdebugpipebackend.cpp \
     access/qnetworkaccessfilebackend.cpp \
@@ -162,6 +162,14 @@ using namespace Http2;
 
 const std::deque<quint32>::size_type QHttp2ProtocolHandler::maxRecycledStreams = 10000;
 const quint32 QHttp2ProtocolHandler::maxAcceptableTableSize;
+const qint32 QHttp2ProtocolHandler::maxAutoReceiveWindowSize;
+
+namespace {
+
+// The payload of our own PING frames, used to measure the round-trip time:
+const uchar bdpPingPayload[8] = {'Q', 't', 'H', '2', 'B', 'D', 'P', '\0'};
+
+}
 
 QHttp2ProtocolHandler::QHttp2ProtocolHandler(QHttpNetworkConnectionChannel *channel)
     : QAbstractProtocolHandler(channel),
@@ -182,6 +190,7 @@ QHttp2ProtocolHandler::QHttp2ProtocolHandler(QHttpNetworkConnectionChannel *chan
         switch (param.key()) {
         case Settings::INITIAL_WINDOW_SIZE_ID:
             streamInitialReceiveWindowSize = param.value();
+            streamReceiveWindowSize = streamInitialReceiveWindowSize;
             break;
         case Settings::ENABLE_PUSH_ID:
             pushPromiseEnabled = param.value();
@@ -439,7 +448,10 @@ bool QHttp2ProtocolHandler::sendHEADERS(Stream &stream)
         stream.state = Stream::open;
     }
 
-    frameWriter.append(quint32()); // No stream dependency in Qt.
+    // The weight reflects QNetworkRequest::Priority among the streams sharing
+    // a parent; in addition, let the stream depend on the most recent stream
+    // of a higher priority, so that the peer serves that one first.
+    frameWriter.append(streamDependency(stream));
     frameWriter.append(stream.weight());
 
     bool useProxy = false;
@@ -523,6 +535,24 @@ bool QHttp2ProtocolHandler::sendWINDOW_UPDATE(quint32 streamID, quint32 delta)
     return frameWriter.write(*m_socket);
 }
 
+bool QHttp2ProtocolHandler::sendPING()
+{
+    Q_ASSERT(m_socket);
+
+    if (bdpPingInFlight)
+        return true;
+
+    frameWriter.start(FrameType::PING, FrameFlag::EMPTY, connectionStreamID);
+    frameWriter.append(bdpPingPayload, bdpPingPayload + sizeof bdpPingPayload);
+    if (!frameWriter.write(*m_socket))
+        return false;
+
+    bdpPingInFlight = true;
+    bdpBytesReceived = 0;
+    bdpTimer.start();
+    return true;
+}
+
 bool QHttp2ProtocolHandler::sendRST_STREAM(quint32 streamID, quint32 errorCode)
 {
     Q_ASSERT(m_socket);
@@ -558,6 +588,12 @@ void QHttp2ProtocolHandler::handleDATA()
 
     sessionReceiveWindowSize -= inboundFrame.payloadSize();
 
+    // Measure how much arrives within one round trip, our windows
+    // must be larger than that not to throttle the peer:
+    bdpBytesReceived += inboundFrame.payloadSize();
+    if (!bdpPingInFlight && maxSessionReceiveWindowSize < maxAutoReceiveWindowSize)
+        QMetaObject::invokeMethod(this, "sendPING", Qt::QueuedConnection);
+
     if (activeStreams.contains(streamID)) {
         auto &stream = activeStreams[streamID];
 
@@ -575,11 +611,11 @@ void QHttp2ProtocolHandler::handleDATA()
             if (inboundFrame.flags().testFlag(FrameFlag::END_STREAM)) {
                 finishStream(stream);
                 deleteActiveStream(stream.streamID);
-            } else if (stream.recvWindow < streamInitialReceiveWindowSize / 2) {
+            } else if (stream.recvWindow < streamReceiveWindowSize / 2) {
                 QMetaObject::invokeMethod(this, "sendWINDOW_UPDATE", Qt::QueuedConnection,
                                           Q_ARG(quint32, stream.streamID),
-                                          Q_ARG(quint32, streamInitialReceiveWindowSize - stream.recvWindow));
-                stream.recvWindow = streamInitialReceiveWindowSize;
+                                          Q_ARG(quint32, streamReceiveWindowSize - stream.recvWindow));
+                stream.recvWindow = streamReceiveWindowSize;
             }
         }
     }
@@ -777,16 +813,49 @@ void QHttp2ProtocolHandler::handlePING()
     if (inboundFrame.streamID() != connectionStreamID)
         return connectionError(PROTOCOL_ERROR, "PING on invalid stream");
 
-    if (inboundFrame.flags() & FrameFlag::ACK)
-        return connectionError(PROTOCOL_ERROR, "unexpected PING ACK");
-
     Q_ASSERT(inboundFrame.dataSize() == 8);
 
+    if (inboundFrame.flags() & FrameFlag::ACK) {
+        if (!bdpPingInFlight || !std::equal(bdpPingPayload, bdpPingPayload + 8,
+                                            inboundFrame.dataBegin())) {
+            return connectionError(PROTOCOL_ERROR, "unexpected PING ACK");
+        }
+        bdpPingInFlight = false;
+        growReceiveWindows(bdpBytesReceived);
+        return;
+    }
+
     frameWriter.start(FrameType::PING, FrameFlag::ACK, connectionStreamID);
     frameWriter.append(inboundFrame.dataBegin(), inboundFrame.dataBegin() + 8);
     frameWriter.write(*m_socket);
 }
 
+void QHttp2ProtocolHandler::growReceiveWindows(qint64 bytesPerRoundTrip)
+{
+    // Same heuristic as used by other HTTP/2 clients: once the data received
+    // during one round trip comes close to our window, the window is what
+    // limits the throughput, so double it (up to maxAutoReceiveWindowSize).
+    if (bytesPerRoundTrip < qint64(maxSessionReceiveWindowSize) * 2 / 3)
+        return;
+
+    const qint32 newSize = qint32(qMin(bytesPerRoundTrip * 2, qint64(maxAutoReceiveWindowSize)));
+    if (newSize <= maxSessionReceiveWindowSize)
+        return;
+
+    qCDebug(QT_HTTP2) << "growing receive windows to" << newSize << "bytes,"
+                      << bytesPerRoundTrip << "bytes received in" << bdpTimer.elapsed() << "ms";
+
+    const qint32 delta = newSize - maxSessionReceiveWindowSize;
+    maxSessionReceiveWindowSize = newSize;
+    sessionReceiveWindowSize += delta;
+    QMetaObject::invokeMethod(this, "sendWINDOW_UPDATE", Qt::QueuedConnection,
+                              Q_ARG(quint32, connectionStreamID),
+                              Q_ARG(quint32, delta));
+
+    // Active streams catch up with their next DATA frame:
+    streamReceiveWindowSize = qMax(streamReceiveWindowSize, newSize);
+}
+
 void QHttp2ProtocolHandler::handleGOAWAY()
 {
     // 6.8 GOAWAY
@@ -1275,6 +1344,25 @@ void QHttp2ProtocolHandler::markAsReset(quint32 streamID)
     recycledStreams.insert(it, streamID);
 }
 
+quint32 QHttp2ProtocolHandler::streamDependency(const Stream &stream) const
+{
+    // Streams of the same priority share the parent, their bandwidth is
+    // split according to their weight ...
+    quint32 parentID = connectionStreamID;
+    const auto priority = stream.priority();
+    for (auto it = activeStreams.cbegin(), end = activeStreams.cend(); it != end; ++it) {
+        // ... while those of higher priority (lower enum values) come first.
+        // Our streams have odd IDs, promised streams are not candidates.
+        const quint32 candidateID = it.key();
+        if (candidateID % 2 && candidateID < stream.streamID && candidateID > parentID
+            && it->priority() < priority) {
+            parentID = candidateID;
+        }
+    }
+
+    return parentID;
+}
+
 quint32 QHttp2ProtocolHandler::popStreamToResume()
 {
     quint32 streamID = connectionStreamID;
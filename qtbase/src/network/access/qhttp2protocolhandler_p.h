@@ -69,6 +69,7 @@
 #include <QtCore/qobject.h>
 #include <QtCore/qflags.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qelapsedtimer.h>
 
 #include <vector>
 #include <limits>
@@ -106,6 +107,7 @@ private:
     bool sendHEADERS(Stream &stream);
     bool sendDATA(Stream &stream);
     Q_INVOKABLE bool sendWINDOW_UPDATE(quint32 streamID, quint32 delta);
+    Q_INVOKABLE bool sendPING();
     bool sendRST_STREAM(quint32 streamID, quint32 errorCoder);
     bool sendGOAWAY(quint32 errorCode);
 
@@ -122,6 +124,9 @@ private:
 
     void handleContinuedHEADERS();
 
+    void growReceiveWindows(qint64 bytesPerRoundTrip);
+    quint32 streamDependency(const Stream &stream) const;
+
     bool acceptSetting(Http2::Settings identifier, quint32 newValue);
 
     void updateStream(Stream &stream, const HPack::HttpHeader &headers,
@@ -183,8 +188,11 @@ private:
     // sending requests and creating streams while maxConcurrentStreams allows).
 
     // This is the max value, we set it in a ctor from Http2::ProtocolParameters,
-    // it does not change after that.
+    // after that it only grows with the measured bandwidth-delay product
+    // (see growReceiveWindows()).
     qint32 maxSessionReceiveWindowSize = Http2::defaultSessionWindowSize;
+    // The receive windows are never grown automatically beyond 16 Mb.
+    static const qint32 maxAutoReceiveWindowSize = 16 * 1024 * 1024;
 
     // Our session receive window size, default is 64Kb. We'll update it from QNAM's
     // Http2::ProtocolParameters. Signed integer since it can become negative
@@ -193,6 +201,16 @@ private:
     // Our per-stream receive window size, default is 64 Kb, will be updated
     // from QNAM's Http2::ProtocolParameters. Again, signed - can become negative.
     qint32 streamInitialReceiveWindowSize = Http2::defaultSessionWindowSize;
+    // The window we restore our streams to with WINDOW_UPDATE frames; starts
+    // as streamInitialReceiveWindowSize (which cannot change without
+    // another SETTINGS frame) and grows with the session's window.
+    qint32 streamReceiveWindowSize = Http2::defaultSessionWindowSize;
+
+    // Bandwidth-delay product estimation: we PING our peer while DATA is
+    // arriving and count the bytes received until the ACK.
+    bool bdpPingInFlight = false;
+    qint64 bdpBytesReceived = 0;
+    QElapsedTimer bdpTimer;
 
     // These are our peer's receive window sizes, they will be updated by the
     // peer's SETTINGS and WINDOW_UPDATE frames.
@@ -43,6 +43,8 @@
 #include "QtCore/qmutex.h"
 #include "QtCore/qrandom.h"
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -486,20 +488,32 @@ bool QHttpMultiPartIODevice::reset()
 }
 qint64 QHttpMultiPartIODevice::readData(char *data, qint64 maxSize)
 {
-    qint64 bytesRead = 0, index = 0;
+    qint64 bytesRead = 0;
+
+    // size() calculates the part offsets. Use them instead of asking every
+    // part for its size, which goes down to the body device each time.
+    const qint64 totalSize = size();
+    const int partCount = multiPart->parts.count();
+    const QByteArray boundaryData = "--" + multiPart->boundary + "\r\n";
+    const qint64 boundaryCount = boundaryData.count();
+    // 2 == \r\n after the content of each part
+    auto partContentSize = [&](int i) {
+        const qint64 partEnd = i + 1 < partCount ? partOffsets.at(i + 1)
+                                                 : totalSize - boundaryCount - 2;
+        return partEnd - partOffsets.at(i) - boundaryCount - 2;
+    };
 
     // skip the parts we have already read
-    while (index < multiPart->parts.count() &&
-           readPointer >= partOffsets.at(index) + multiPart->parts.at(index).d->size()
-           + multiPart->boundary.count() + 6) // 6 == 2 boundary dashes, \r\n after boundary, \r\n after multipart
-        index++;
+    int index = int(std::upper_bound(partOffsets.constBegin(), partOffsets.constEnd(), readPointer)
+                    - partOffsets.constBegin()) - 1;
+    if (index < 0 || (index == partCount - 1 && readPointer >= totalSize - boundaryCount - 2))
+        index = partCount;
 
     // read the data
-    while (bytesRead < maxSize && index < multiPart->parts.count()) {
+    while (bytesRead < maxSize && index < partCount) {
+        const qint64 contentSize = partContentSize(index);
 
         // check whether we need to read the boundary of the current part
-        QByteArray boundaryData = "--" + multiPart->boundary + "\r\n";
-        qint64 boundaryCount = boundaryData.count();
         qint64 partIndex = readPointer - partOffsets.at(index);
         if (partIndex < boundaryCount) {
             qint64 boundaryBytesRead = qMin(boundaryCount - partIndex, maxSize - bytesRead);
@@ -510,7 +524,7 @@ qint64 QHttpMultiPartIODevice::readData(char *data, qint64 maxSize)
         }
 
         // check whether we need to read the data of the current part
-        if (bytesRead < maxSize && partIndex >= boundaryCount && partIndex < boundaryCount + multiPart->parts.at(index).d->size()) {
+        if (bytesRead < maxSize && partIndex >= boundaryCount && partIndex < boundaryCount + contentSize) {
             qint64 dataBytesRead = multiPart->parts[index].d->readData(data + bytesRead, maxSize - bytesRead);
             if (dataBytesRead == -1)
                 return -1;
@@ -520,7 +534,7 @@ qint64 QHttpMultiPartIODevice::readData(char *data, qint64 maxSize)
         }
 
         // check whether we need to read the ending CRLF of the current part
-        if (bytesRead < maxSize && partIndex >= boundaryCount + multiPart->parts.at(index).d->size()) {
+        if (bytesRead < maxSize && partIndex >= boundaryCount + contentSize) {
             if (bytesRead == maxSize - 1)
                 return bytesRead;
             memcpy(data + bytesRead, "\r\n", 2);
@@ -530,9 +544,9 @@ qint64 QHttpMultiPartIODevice::readData(char *data, qint64 maxSize)
         }
     }
     // check whether we need to return the final boundary
-    if (bytesRead < maxSize && index == multiPart->parts.count()) {
+    if (bytesRead < maxSize && index == partCount) {
         QByteArray finalBoundary = "--" + multiPart->boundary + "--\r\n";
-        qint64 boundaryIndex = readPointer + finalBoundary.count() - size();
+        qint64 boundaryIndex = readPointer + finalBoundary.count() - totalSize;
         qint64 lastBoundaryBytesRead = qMin(finalBoundary.count() - boundaryIndex, maxSize - bytesRead);
         memcpy(data + bytesRead, finalBoundary.constData() + boundaryIndex, lastBoundaryBytesRead);
         bytesRead += lastBoundaryBytesRead;
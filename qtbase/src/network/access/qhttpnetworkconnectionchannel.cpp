@@ -84,6 +84,9 @@ private:
 // We use 3 because we can get a _q_error 3 times depending on the timing:
 static const int reconnectAttemptsDefault = 3;
 
+// The connection attempt delay recommended by RFC 8305, section 5
+static const int connectionAttemptDelay = 250;
+
 QHttpNetworkConnectionChannel::QHttpNetworkConnectionChannel()
     : socket(0)
     , ssl(false)
@@ -132,6 +135,10 @@ void QHttpNetworkConnectionChannel::init()
     socket->setProxy(QNetworkProxy::NoProxy);
 #endif
 
+    // Race the connection attempts to hosts with several addresses instead of
+    // waiting for each of them to time out (RFC 8305)
+    socket->setSocketOption(QAbstractSocket::ConnectionAttemptDelayOption, connectionAttemptDelay);
+
     // After some back and forth in all the last years, this is now a DirectConnection because otherwise
     // the state inside the *Socket classes gets messed up, also in conjunction with the socket notifiers
     // which behave slightly differently on Windows vs Linux
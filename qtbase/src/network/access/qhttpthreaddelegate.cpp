@@ -197,6 +197,21 @@ public:
         setShareable(true);
     }
 
+#ifdef QT_NO_BEARERMANAGEMENT
+    QNetworkAccessCachedHttpConnection(quint16 channelCount, const QString &hostName, quint16 port,
+                                       bool encrypt)
+        : QHttpNetworkConnection(channelCount, hostName, port, encrypt)
+#else
+    QNetworkAccessCachedHttpConnection(quint16 channelCount, const QString &hostName, quint16 port,
+                                       bool encrypt, QSharedPointer<QNetworkSession> networkSession)
+        : QHttpNetworkConnection(channelCount, hostName, port, encrypt, /*parent=*/0,
+                                 qMove(networkSession))
+#endif
+    {
+        setExpires(true);
+        setShareable(true);
+    }
+
     virtual void dispose() Q_DECL_OVERRIDE
     {
 #if 0  // sample code; do this right with the API
@@ -233,6 +248,7 @@ QHttpThreadDelegate::QHttpThreadDelegate(QObject *parent) :
     , bytesEmitted(0)
     , pendingDownloadData()
     , pendingDownloadProgress()
+    , downloadSinkWritten(0)
     , synchronous(false)
     , incomingStatusCode(0)
     , isPipeliningUsed(false)
@@ -321,18 +337,39 @@ void QHttpThreadDelegate::startRequest()
         cacheKey = makeCacheKey(urlCopy, 0);
 
 
+    // a shared connection pool overrides the limits of the cache in this thread
+    int channelCount = 0;
+    if (connectionPool) {
+        QNetworkAccessCache *cache = connections.localData();
+        cache->setExpiryTimeout(connectionPool->idleTimeout());
+        cache->setMaximumLifetime(connectionPool->maximumLifetime());
+        if (connectionType == QHttpNetworkConnection::ConnectionTypeHTTP)
+            channelCount = connectionPool->maximumConnectionsPerHost();
+    }
+
     // the http object is actually a QHttpNetworkConnection
     httpConnection = static_cast<QNetworkAccessCachedHttpConnection *>(connections.localData()->requestEntryNow(cacheKey));
+    if (connectionPool)
+        connectionPool->recordLookup(httpConnection != 0);
     if (httpConnection == 0) {
         // no entry in cache; create an object
         // the http object is actually a QHttpNetworkConnection
 #ifdef QT_NO_BEARERMANAGEMENT
-        httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
-                                                                connectionType);
+        if (channelCount > 0)
+            httpConnection = new QNetworkAccessCachedHttpConnection(channelCount, urlCopy.host(),
+                                                                    urlCopy.port(), ssl);
+        else
+            httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
+                                                                    connectionType);
 #else
-        httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
-                                                                connectionType,
-                                                                networkSession);
+        if (channelCount > 0)
+            httpConnection = new QNetworkAccessCachedHttpConnection(channelCount, urlCopy.host(),
+                                                                    urlCopy.port(), ssl,
+                                                                    networkSession);
+        else
+            httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
+                                                                    connectionType,
+                                                                    networkSession);
 #endif // QT_NO_BEARERMANAGEMENT
         if (connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2
             && http2Parameters.validate()) {
@@ -367,6 +404,14 @@ void QHttpThreadDelegate::startRequest()
     httpReply = httpConnection->sendRequest(httpRequest);
     httpReply->setParent(this);
 
+    // Keep the body in the connection until the sink can take it, so that a
+    // slow sink stops us from reading the socket
+    if (downloadSink && !synchronous) {
+        httpReply->setDownstreamLimited(true);
+        connect(downloadSink.data(), SIGNAL(bytesWritten(qint64)), this, SLOT(readyReadSlot()),
+                Qt::QueuedConnection);
+    }
+
     // Connect the reply signals that we need to handle and then forward
     if (synchronous) {
         connect(httpReply,SIGNAL(headerChanged()), this, SLOT(synchronousHeaderChangedSlot()));
@@ -439,7 +484,7 @@ void QHttpThreadDelegate::readBufferSizeChanged(qint64 size)
     qDebug() << "QHttpThreadDelegate::readBufferSizeChanged() size " << size;
 #endif
     if (httpReply) {
-        httpReply->setDownstreamLimited(size > 0);
+        httpReply->setDownstreamLimited(size > 0 || downloadSink);
         httpReply->setReadBufferSize(size);
         readBufferMaxSize = size;
     }
@@ -447,7 +492,7 @@ void QHttpThreadDelegate::readBufferSizeChanged(qint64 size)
 
 void QHttpThreadDelegate::readBufferFreed(qint64 size)
 {
-    if (readBufferMaxSize) {
+    if (readBufferMaxSize && !downloadSink) {
         bytesEmitted -= size;
 
         QMetaObject::invokeMethod(this, "readyReadSlot", Qt::QueuedConnection);
@@ -463,6 +508,11 @@ void QHttpThreadDelegate::readyReadSlot()
     if (!downloadBuffer.isNull())
         return;
 
+    if (downloadSink) {
+        writeToDownloadSink(false);
+        return;
+    }
+
     if (readBufferMaxSize) {
         if (bytesEmitted < readBufferMaxSize) {
             qint64 sizeEmitted = 0;
@@ -491,6 +541,52 @@ void QHttpThreadDelegate::readyReadSlot()
     }
 }
 
+/*!
+    \internal
+
+    Hands the body received so far to the download sink. Unless \a flush is
+    set, this stops while the sink still has a full read buffer's worth of
+    data to write; the rest stays in the reply, which keeps the connection
+    from reading more from the socket. Returns \c false if writing failed, in
+    which case the request has been finished with an error.
+*/
+bool QHttpThreadDelegate::writeToDownloadSink(bool flush)
+{
+    const qint64 sinkBufferSize = readBufferMaxSize > 0 ? readBufferMaxSize : 64 * 1024;
+    if (!downloadSink) {
+        httpReply->abort();
+        finishedWithErrorSlot(QNetworkReply::OperationCanceledError,
+                              QLatin1String(QT_TRANSLATE_NOOP("QNetworkReply", "Download sink was destroyed")));
+        return false;
+    }
+
+    // The body of a redirect we are going to follow is of no interest
+    const bool discard = httpRequest.isFollowRedirects() && httpReply->isRedirecting();
+    qint64 written = 0;
+    while (httpReply->readAnyAvailable()
+           && (flush || downloadSink->bytesToWrite() < sinkBufferSize)) {
+        const QByteArray chunk = httpReply->readAny();
+        if (discard)
+            continue;
+        if (downloadSink->write(chunk) != chunk.size()) {
+            const QString msg = QLatin1String(QT_TRANSLATE_NOOP("QNetworkReply",
+                                                                "Error writing to the download sink: %1"));
+            httpReply->abort();
+            finishedWithErrorSlot(QNetworkReply::UnknownContentError,
+                                  msg.arg(downloadSink->errorString()));
+            return false;
+        }
+        written += chunk.size();
+    }
+
+    if (written > 0) {
+        downloadSinkWritten += written;
+        pendingDownloadProgress->fetchAndAddRelease(1);
+        emit downloadProgress(downloadSinkWritten, httpReply->contentLength());
+    }
+    return true;
+}
+
 void QHttpThreadDelegate::finishedSlot()
 {
     if (!httpReply)
@@ -501,6 +597,10 @@ void QHttpThreadDelegate::finishedSlot()
 #endif
 
     // If there is still some data left emit that now
+    if (downloadSink) {
+        if (!writeToDownloadSink(true))
+            return;
+    }
     while (httpReply->readAnyAvailable()) {
         pendingDownloadData->fetchAndAddRelease(1);
         emit downloadData(httpReply->readAny());
@@ -64,8 +64,10 @@
 #include "qhttpnetworkconnection_p.h"
 #include <QSharedPointer>
 #include <QScopedPointer>
+#include <QPointer>
 #include "private/qnoncontiguousbytedevice_p.h"
 #include "qnetworkaccessauthenticationmanager_p.h"
+#include "qnetworkconnectionpool_p.h"
 #include <QtNetwork/private/http2protocol_p.h>
 
 #ifndef QT_NO_HTTP
@@ -103,6 +105,10 @@ public:
     QNetworkProxy transparentProxy;
 #endif
     QSharedPointer<QNetworkAccessAuthenticationManager> authenticationManager;
+    QSharedPointer<QNetworkConnectionPoolSettings> connectionPool;
+    // Receives the body instead of the QNetworkReply, see QNetworkRequest::DownloadSinkAttribute
+    QPointer<QIODevice> downloadSink;
+    qint64 downloadSinkWritten;
     bool synchronous;
 
     // outgoing, Retrieved in the synchronous HTTP case
@@ -132,6 +138,8 @@ protected:
     // Used for implementing the synchronous HTTP, see startRequestSynchronously()
     QEventLoop *synchronousRequestLoop;
 
+    bool writeToDownloadSink(bool flush);
+
 signals:
     void authenticationRequired(const QHttpNetworkRequest &request, QAuthenticator *);
 #ifndef QT_NO_NETWORKPROXY
@@ -63,6 +63,7 @@ namespace {
 struct QNetworkAccessCache::Node
 {
     QDateTime timestamp;
+    QDateTime created;
     QQueue<Receiver> receiverQueue;
     QByteArray key;
 
@@ -102,7 +103,7 @@ void QNetworkAccessCache::CacheableObject::setShareable(bool enable)
 }
 
 QNetworkAccessCache::QNetworkAccessCache()
-    : oldest(0), newest(0)
+    : oldest(0), newest(0), expiryTimeout(ExpiryTime), maximumLifetime(0)
 {
 }
 
@@ -132,6 +133,24 @@ void QNetworkAccessCache::clear()
     oldest = newest = 0;
 }
 
+/*!
+    Sets the number of seconds an unused entry is kept to \a seconds.
+    Entries that are already unused keep their previous expiry time.
+ */
+void QNetworkAccessCache::setExpiryTimeout(int seconds)
+{
+    expiryTimeout = seconds;
+}
+
+/*!
+    Sets the number of seconds after which an entry is no longer handed out
+    once it becomes unused to \a seconds. 0 means entries never retire.
+ */
+void QNetworkAccessCache::setMaximumLifetime(int seconds)
+{
+    maximumLifetime = seconds;
+}
+
 /*!
     Appends the entry given by \a key to the end of the linked list.
     (i.e., makes it the newest entry)
@@ -157,7 +176,7 @@ void QNetworkAccessCache::linkEntry(const QByteArray &key)
         oldest = node;
     }
 
-    node->timestamp = QDateTime::currentDateTimeUtc().addSecs(ExpiryTime);
+    node->timestamp = QDateTime::currentDateTimeUtc().addSecs(expiryTimeout);
     newest = node;
 }
 
@@ -219,6 +238,12 @@ bool QNetworkAccessCache::emitEntryReady(Node *node, QObject *target, const char
     return true;
 }
 
+bool QNetworkAccessCache::isRetired(const Node *node) const
+{
+    return maximumLifetime > 0
+            && node->created.secsTo(QDateTime::currentDateTimeUtc()) >= maximumLifetime;
+}
+
 void QNetworkAccessCache::timerEvent(QTimerEvent *)
 {
     // expire old items
@@ -258,6 +283,7 @@ void QNetworkAccessCache::addEntry(const QByteArray &key, CacheableObject *entry
     node.object->key = key;
     node.key = key;
     node.useCount = 1;
+    node.created = QDateTime::currentDateTimeUtc();
 }
 
 bool QNetworkAccessCache::hasEntry(const QByteArray &key) const
@@ -309,6 +335,16 @@ QNetworkAccessCache::CacheableObject *QNetworkAccessCache::requestEntryNow(const
         return 0;
     }
 
+    if (isRetired(&it.value())) {
+        // too old to be handed out again
+        if (unlinkEntry(key))
+            updateTimer();
+        it->object->key.clear();
+        it->object->dispose();
+        hash.erase(it);
+        return 0;
+    }
+
     // entry not in use, let the caller have it
     bool wasOldest = unlinkEntry(key);
     ++it->useCount;
@@ -345,6 +381,13 @@ void QNetworkAccessCache::releaseEntry(const QByteArray &key)
     }
 
     if (!--node->useCount) {
+        if (isRetired(node)) {
+            node->object->key.clear();
+            node->object->dispose();
+            hash.erase(it);
+            return;
+        }
+
         // no objects waiting; add it back to the expiry list
         if (node->object->expires)
             linkEntry(key);
@@ -95,6 +95,9 @@ public:
 
     void clear();
 
+    void setExpiryTimeout(int seconds);
+    void setMaximumLifetime(int seconds);
+
     void addEntry(const QByteArray &key, CacheableObject *entry);
     bool hasEntry(const QByteArray &key) const;
     bool requestEntry(const QByteArray &key, QObject *target, const char *member);
@@ -115,11 +118,14 @@ private:
     Node *newest;
 
     QBasicTimer timer;
+    int expiryTimeout;
+    int maximumLifetime;
 
     void linkEntry(const QByteArray &key);
     bool unlinkEntry(const QByteArray &key);
     void updateTimer();
     bool emitEntryReady(Node *node, QObject *target, const char *member);
+    bool isRetired(const Node *node) const;
 };
 
 QT_END_NAMESPACE
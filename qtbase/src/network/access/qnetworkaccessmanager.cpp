@@ -39,6 +39,7 @@
 
 #include "qnetworkaccessmanager.h"
 #include "qnetworkaccessmanager_p.h"
+#include "qnetworkconnectionpool_p.h"
 #include "qnetworkrequest.h"
 #include "qnetworkreply.h"
 #include "qnetworkreply_p.h"
@@ -1238,6 +1239,41 @@ QNetworkRequest::RedirectPolicy QNetworkAccessManager::redirectPolicy() const
     return d->redirectPolicy;
 }
 
+/*!
+    \since 5.11
+
+    Returns the connection pool that this manager sends its HTTP and HTTPS
+    requests through, or \c nullptr if the manager keeps its own
+    connections.
+
+    \sa setConnectionPool()
+*/
+QNetworkConnectionPool *QNetworkAccessManager::connectionPool() const
+{
+    Q_D(const QNetworkAccessManager);
+    return d->connectionPool;
+}
+
+/*!
+    \since 5.11
+
+    Makes this manager send its HTTP and HTTPS requests over the connections
+    held in \a pool, which other managers can share. Pass \c nullptr to go
+    back to connections owned by this manager. Requests that are already
+    running are not affected.
+
+    The manager does not take ownership of \a pool. clearConnectionCache()
+    does not close the connections of the pool; use
+    QNetworkConnectionPool::clear() instead.
+
+    \sa connectionPool(), QNetworkConnectionPool
+*/
+void QNetworkAccessManager::setConnectionPool(QNetworkConnectionPool *pool)
+{
+    Q_D(QNetworkAccessManager);
+    d->connectionPool = pool;
+}
+
 /*!
     \since 4.7
 
@@ -1776,6 +1812,8 @@ QNetworkAccessManagerPrivate::~QNetworkAccessManagerPrivate()
 
 QThread * QNetworkAccessManagerPrivate::createThread()
 {
+    if (connectionPool)
+        return QNetworkConnectionPoolPrivate::get(connectionPool)->createThread();
     if (!thread) {
         thread = new QThread;
         thread->setObjectName(QStringLiteral("QNetworkAccessManager thread"));
@@ -62,6 +62,8 @@
 #include "QtNetwork/qnetworkproxy.h"
 #include "QtNetwork/qnetworksession.h"
 #include "qnetworkaccessauthenticationmanager_p.h"
+#include "qnetworkconnectionpool.h"
+#include "QtCore/qpointer.h"
 #ifndef QT_NO_BEARERMANAGEMENT
 #include "QtNetwork/qnetworkconfigmanager.h"
 #endif
@@ -172,6 +174,7 @@ public:
     QNetworkCookieJar *cookieJar;
 
     QThread *thread;
+    QPointer<QNetworkConnectionPool> connectionPool;
 
 
 #ifndef QT_NO_NETWORKPROXY
@@ -0,0 +1,319 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qnetworkconnectionpool.h"
+#include "qnetworkconnectionpool_p.h"
+
+#include "QtCore/qthread.h"
+
+QT_BEGIN_NAMESPACE
+
+// Same as QHttpNetworkConnectionPrivate::defaultHttpChannelCount
+static const int DefaultConnectionsPerHost = 6;
+// Same as the expiry time of QNetworkAccessCache
+static const int DefaultIdleTimeout = 120;
+
+/*!
+    \class QNetworkConnectionPool
+    \since 5.11
+    \inmodule QtNetwork
+
+    \brief The QNetworkConnectionPool class holds HTTP connections that
+    several QNetworkAccessManager objects can share.
+
+    \reentrant
+
+    By default, each QNetworkAccessManager keeps its own connections,
+    opens at most six of them to each host and closes them after two
+    minutes without use. Applications that send many requests to a few
+    hosts through more than one manager keep paying for new TCP and TLS
+    handshakes.
+
+    Managers that are given the same pool with
+    QNetworkAccessManager::setConnectionPool() send their HTTP and HTTPS
+    requests over one set of connections, run by a thread that the pool
+    owns. The pool allows configuring the number of connections per host,
+    how long idle connections are kept, and how long any connection is
+    reused at most.
+
+    Since the connections are shared, requests from all these managers to
+    a host also share its TLS session and its SSL configuration: the
+    connection uses the SSL configuration of the request that opened it.
+    Only share a pool between managers that use compatible settings.
+
+    To open connections before they are needed, call
+    QNetworkAccessManager::connectToHost() or
+    QNetworkAccessManager::connectToHostEncrypted() on any of the managers,
+    once for each connection to open.
+
+    hitCount() and missCount() tell how many requests could use an
+    existing connection to their host, and how many had to open a new one.
+
+    Synchronous requests do not use the pool. The pool must stay alive
+    for as long as a manager using it sends requests.
+
+    \sa QNetworkAccessManager::setConnectionPool()
+*/
+
+QNetworkConnectionPoolSettings::QNetworkConnectionPoolSettings()
+    : connectionsPerHost(DefaultConnectionsPerHost),
+      idleSeconds(DefaultIdleTimeout),
+      lifetimeSeconds(0),
+      hits(0),
+      misses(0)
+{
+}
+
+int QNetworkConnectionPoolSettings::maximumConnectionsPerHost() const
+{
+    QMutexLocker locker(&mutex);
+    return connectionsPerHost;
+}
+
+int QNetworkConnectionPoolSettings::idleTimeout() const
+{
+    QMutexLocker locker(&mutex);
+    return idleSeconds;
+}
+
+int QNetworkConnectionPoolSettings::maximumLifetime() const
+{
+    QMutexLocker locker(&mutex);
+    return lifetimeSeconds;
+}
+
+void QNetworkConnectionPoolSettings::recordLookup(bool hit)
+{
+    QMutexLocker locker(&mutex);
+    if (hit)
+        ++hits;
+    else
+        ++misses;
+}
+
+QNetworkConnectionPoolPrivate::QNetworkConnectionPoolPrivate()
+    : thread(0),
+      settings(QSharedPointer<QNetworkConnectionPoolSettings>::create())
+{
+}
+
+QNetworkConnectionPoolPrivate::~QNetworkConnectionPoolPrivate()
+{
+    destroyThread();
+}
+
+QThread *QNetworkConnectionPoolPrivate::createThread()
+{
+    if (!thread) {
+        thread = new QThread;
+        thread->setObjectName(QStringLiteral("QNetworkConnectionPool thread"));
+        thread->start();
+    }
+    return thread;
+}
+
+void QNetworkConnectionPoolPrivate::destroyThread()
+{
+    // the connections are owned by the thread and go away with it
+    if (thread) {
+        thread->quit();
+        thread->wait(5000);
+        if (thread->isFinished())
+            delete thread;
+        else
+            QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
+        thread = 0;
+    }
+}
+
+/*!
+    Creates an empty connection pool with the given \a parent.
+*/
+QNetworkConnectionPool::QNetworkConnectionPool(QObject *parent)
+    : QObject(*new QNetworkConnectionPoolPrivate, parent)
+{
+}
+
+/*!
+    Destroys the pool and closes all its connections.
+*/
+QNetworkConnectionPool::~QNetworkConnectionPool()
+{
+}
+
+/*!
+    Returns the maximum number of HTTP/1.1 connections that are opened in
+    parallel to one host. The default is 6.
+
+    \sa setMaximumConnectionsPerHost()
+*/
+int QNetworkConnectionPool::maximumConnectionsPerHost() const
+{
+    Q_D(const QNetworkConnectionPool);
+    return d->settings->maximumConnectionsPerHost();
+}
+
+/*!
+    Sets the maximum number of HTTP/1.1 connections opened in parallel to
+    one host to \a count, which must be between 1 and 255. Connections to
+    hosts that are already in the pool keep their previous limit until
+    they are closed.
+
+    HTTP/2 and SPDY connections multiplex all requests over a single
+    connection and are not affected.
+
+    \sa maximumConnectionsPerHost()
+*/
+void QNetworkConnectionPool::setMaximumConnectionsPerHost(int count)
+{
+    Q_D(QNetworkConnectionPool);
+    if (count < 1 || count > 255) {
+        qWarning("QNetworkConnectionPool::setMaximumConnectionsPerHost: invalid count %d", count);
+        return;
+    }
+    QMutexLocker locker(&d->settings->mutex);
+    d->settings->connectionsPerHost = count;
+}
+
+/*!
+    Returns the number of seconds an unused connection is kept open before
+    it is closed. The default is 120.
+
+    \sa setIdleTimeout()
+*/
+int QNetworkConnectionPool::idleTimeout() const
+{
+    Q_D(const QNetworkConnectionPool);
+    return d->settings->idleTimeout();
+}
+
+/*!
+    Sets the number of seconds an unused connection is kept open to
+    \a seconds.
+
+    \sa idleTimeout()
+*/
+void QNetworkConnectionPool::setIdleTimeout(int seconds)
+{
+    Q_D(QNetworkConnectionPool);
+    QMutexLocker locker(&d->settings->mutex);
+    d->settings->idleSeconds = qMax(seconds, 0);
+}
+
+/*!
+    Returns the number of seconds after which a connection is closed once
+    it has no more requests to run, instead of being kept for reuse. The
+    default is 0, which means connections are reused for as long as they
+    stay open.
+
+    \sa setMaximumLifetime()
+*/
+int QNetworkConnectionPool::maximumLifetime() const
+{
+    Q_D(const QNetworkConnectionPool);
+    return d->settings->maximumLifetime();
+}
+
+/*!
+    Sets the number of seconds after which a connection is retired to
+    \a seconds. A retired connection finishes the requests it is running
+    and is then closed; later requests to its host open a new connection.
+    This lets load balancers in front of the hosts distribute long-running
+    clients again.
+
+    \sa maximumLifetime()
+*/
+void QNetworkConnectionPool::setMaximumLifetime(int seconds)
+{
+    Q_D(QNetworkConnectionPool);
+    QMutexLocker locker(&d->settings->mutex);
+    d->settings->lifetimeSeconds = qMax(seconds, 0);
+}
+
+/*!
+    Returns the number of requests that found an open connection to their
+    host in the pool since it was created or resetStatistics() was called.
+
+    \sa missCount()
+*/
+qint64 QNetworkConnectionPool::hitCount() const
+{
+    Q_D(const QNetworkConnectionPool);
+    QMutexLocker locker(&d->settings->mutex);
+    return d->settings->hits;
+}
+
+/*!
+    Returns the number of requests that had to open a new connection to
+    their host since the pool was created or resetStatistics() was called.
+
+    \sa hitCount()
+*/
+qint64 QNetworkConnectionPool::missCount() const
+{
+    Q_D(const QNetworkConnectionPool);
+    QMutexLocker locker(&d->settings->mutex);
+    return d->settings->misses;
+}
+
+/*!
+    Sets hitCount() and missCount() back to zero.
+*/
+void QNetworkConnectionPool::resetStatistics()
+{
+    Q_D(QNetworkConnectionPool);
+    QMutexLocker locker(&d->settings->mutex);
+    d->settings->hits = 0;
+    d->settings->misses = 0;
+}
+
+/*!
+    Closes all connections in the pool. Requests sent after this open new
+    connections.
+
+    \sa QNetworkAccessManager::clearConnectionCache()
+*/
+void QNetworkConnectionPool::clear()
+{
+    Q_D(QNetworkConnectionPool);
+    d->destroyThread();
+}
+
+QT_END_NAMESPACE
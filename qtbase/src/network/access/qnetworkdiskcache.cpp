@@ -51,12 +51,15 @@
 #include <qdiriterator.h>
 #include <qurl.h>
 #include <qcryptographichash.h>
+#include <qrunnable.h>
+#include <qthreadpool.h>
 #include <qdebug.h>
 
 #define CACHE_POSTFIX QLatin1String(".d")
 #define PREPARED_SLASH QLatin1String("prepared/")
 #define CACHE_VERSION 8
 #define DATA_DIR QLatin1String("data")
+#define INDEX_FILE QLatin1String("index")
 
 #define MAX_COMPRESSION_SIZE (1024 * 1024 * 3)
 
@@ -77,6 +80,11 @@ QT_BEGIN_NAMESPACE
     Currently you cannot share the same cache files with more than
     one disk cache.
 
+    The size and last use of every cache file is kept in an in-memory index,
+    which is written to the cache directory when the cache is destroyed and
+    read back the next time the directory is used, so that the directory only
+    needs to be scanned when no valid index is present.
+
     QNetworkDiskCache by default limits the amount of space that the cache will
     use on the system to 50MB.
 
@@ -113,6 +121,8 @@ QNetworkDiskCache::~QNetworkDiskCache()
 {
     Q_D(QNetworkDiskCache);
     qDeleteAll(d->inserting);
+    d->finishEvictions();
+    d->saveIndex();
 }
 
 /*!
@@ -142,6 +152,11 @@ void QNetworkDiskCache::setCacheDirectory(const QString &cacheDir)
     Q_D(QNetworkDiskCache);
     if (cacheDir.isEmpty())
         return;
+    if (d->indexLoaded) {
+        d->finishEvictions();
+        d->saveIndex();
+        d->resetIndex();
+    }
     d->cacheDirectory = cacheDir;
     QDir dir(d->cacheDirectory);
     d->cacheDirectory = dir.absolutePath();
@@ -270,16 +285,22 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
     QString fileName = cacheFileName(cacheItem->metaData.url());
     Q_ASSERT(!fileName.isEmpty());
 
+    // an earlier expire() might still have this file queued for removal
+    cancelEviction(fileName);
     if (QFile::exists(fileName)) {
         if (!QFile::remove(fileName)) {
             qWarning() << "QNetworkDiskCache: couldn't remove the cache file " << fileName;
             return;
         }
+        removeFromIndex(fileName);
     }
 
     if (currentCacheSize > 0)
         currentCacheSize += 1024 + cacheItem->size();
+    // don't make the insertion wait for the files to be removed
+    evictInBackground = true;
     currentCacheSize = q->expire();
+    evictInBackground = false;
     if (!cacheItem->file) {
         QString templateName = tmpCacheFileName();
         cacheItem->file = new QTemporaryFile(templateName, &cacheItem->data);
@@ -294,10 +315,14 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
         && cacheItem->file->error() == QFile::NoError) {
         cacheItem->file->setAutoRemove(false);
         // ### use atomic rename rather then remove & rename
-        if (cacheItem->file->rename(fileName))
-            currentCacheSize += cacheItem->file->size();
-        else
+        if (cacheItem->file->rename(fileName)) {
+            const qint64 size = cacheItem->file->size();
+            currentCacheSize += size;
+            if (indexLoaded)
+                addToIndex(fileName, size, QDateTime::currentMSecsSinceEpoch());
+        } else {
             cacheItem->file->setAutoRemove(true);
+        }
     }
     if (cacheItem->metaData.url() == lastItem.metaData.url())
         lastItem.reset();
@@ -345,6 +370,7 @@ bool QNetworkDiskCachePrivate::removeFile(const QString &file)
     qint64 size = info.size();
     if (QFile::remove(file)) {
         currentCacheSize -= size;
+        removeFromIndex(file);
         return true;
     }
     return false;
@@ -361,7 +387,10 @@ QNetworkCacheMetaData QNetworkDiskCache::metaData(const QUrl &url)
     Q_D(QNetworkDiskCache);
     if (d->lastItem.metaData.url() == url)
         return d->lastItem.metaData;
-    return fileMetaData(d->cacheFileName(url));
+    const QString fileName = d->cacheFileName(url);
+    if (d->isEvicting(fileName))
+        return QNetworkCacheMetaData();
+    return fileMetaData(fileName);
 }
 
 /*!
@@ -402,7 +431,10 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
         buffer.reset(new QBuffer);
         buffer->setData(d->lastItem.data.data());
     } else {
-        QScopedPointer<QFile> file(new QFile(d->cacheFileName(url)));
+        const QString fileName = d->cacheFileName(url);
+        if (d->isEvicting(fileName))
+            return 0;
+        QScopedPointer<QFile> file(new QFile(fileName));
         if (!file->open(QFile::ReadOnly | QIODevice::Unbuffered))
             return 0;
 
@@ -411,6 +443,7 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
             remove(url);
             return 0;
         }
+        d->touch(fileName);
         if (d->lastItem.data.isOpen()) {
             // compressed
             buffer.reset(new QBuffer);
@@ -500,9 +533,16 @@ void QNetworkDiskCache::setMaximumCacheSize(qint64 size)
     Returns the current size of the cache.
 
     When the current size of the cache is greater than the maximumCacheSize()
-    older cache files are removed until the total size is less then 90% of
-    maximumCacheSize() starting with the oldest ones first using the file
-    creation date to determine how old a cache file is.
+    cache files are removed until the total size is less then 90% of
+    maximumCacheSize(), starting with the least recently used ones. A cache
+    file counts as used when it is inserted and whenever its data is read
+    with data(). The files are looked up in the cache's index; the cache
+    directory is only scanned when no index is available yet, in which case
+    the file creation date determines how old a cache file is.
+
+    When expire() is called because an item is being inserted, the files are
+    removed by a worker thread of the global QThreadPool, and they are no
+    longer reported by metaData() and data() from then on.
 
     Subclasses can reimplement this function to change the order that cache
     files are removed taking into account information in the application
@@ -526,57 +566,28 @@ qint64 QNetworkDiskCache::expire()
 
     // close file handle to prevent "in use" error when QFile::remove() is called
     d->lastItem.reset();
-
-    QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
-    QDirIterator it(cacheDirectory(), filters, QDirIterator::Subdirectories);
-
-    QMultiMap<QDateTime, QString> cacheItems;
-    qint64 totalSize = 0;
-    while (it.hasNext()) {
-        QString path = it.next();
-        QFileInfo info = it.fileInfo();
-        QString fileName = info.fileName();
-        if (fileName.endsWith(CACHE_POSTFIX)) {
-            const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
-            cacheItems.insert(birthTime.isValid() ? birthTime
-                              : info.fileTime(QFile::FileMetadataChangeTime), path);
-            totalSize += info.size();
-        }
-    }
-
-    int removedFiles = 0;
-    qint64 goal = (maximumCacheSize() * 9) / 10;
-    QMultiMap<QDateTime, QString>::const_iterator i = cacheItems.constBegin();
-    while (i != cacheItems.constEnd()) {
-        if (totalSize < goal)
-            break;
-        QString name = i.value();
-        QFile file(name);
-
-        if (name.contains(PREPARED_SLASH)) {
-            for (QCacheItem *item : qAsConst(d->inserting)) {
-                if (item && item->file && item->file->fileName() == name) {
-                    delete item->file;
-                    item->file = 0;
-                    break;
-                }
-            }
-        }
-
-        qint64 size = file.size();
-        file.remove();
-        totalSize -= size;
-        ++removedFiles;
-        ++i;
+    d->loadIndex();
+
+    QStringList removedFiles;
+    const qint64 goal = (maximumCacheSize() * 9) / 10;
+    auto it = d->leastRecentlyUsed.begin();
+    while (it != d->leastRecentlyUsed.end() && d->indexedSize >= goal) {
+        const auto entry = d->index.find(it.value());
+        Q_ASSERT(entry != d->index.end());
+        d->indexedSize -= entry->size;
+        d->index.erase(entry);
+        removedFiles.append(it.value());
+        it = d->leastRecentlyUsed.erase(it);
     }
+    d->evict(removedFiles);
 #if defined(QNETWORKDISKCACHE_DEBUG)
-    if (removedFiles > 0) {
+    if (!removedFiles.isEmpty()) {
         qDebug() << "QNetworkDiskCache::expire()"
-                << "Removed:" << removedFiles
-                << "Kept:" << cacheItems.count() - removedFiles;
+                << "Removed:" << removedFiles.count()
+                << "Kept:" << d->index.count();
     }
 #endif
-    return totalSize;
+    return d->indexedSize;
 }
 
 /*!
@@ -668,6 +679,7 @@ bool QCacheItem::canCompress() const
 enum
 {
     CacheMagic = 0xe8,
+    IndexMagic = 0xe9,
     CurrentCacheVersion = CACHE_VERSION
 };
 
@@ -736,4 +748,196 @@ bool QCacheItem::read(QFile *device, bool readData)
     return metaData.isValid();
 }
 
+class QNetworkDiskCacheEvictor : public QRunnable
+{
+public:
+    QNetworkDiskCacheEvictor(const QSharedPointer<QNetworkDiskCacheEvictions> &evictions,
+                             const QStringList &files)
+        : evictions(evictions), files(files)
+    {
+    }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        for (const QString &file : qAsConst(files)) {
+            QMutexLocker locker(&evictions->mutex);
+            // the file is no longer pending if it was stored again in the meantime
+            if (evictions->pending.remove(file))
+                QFile::remove(file);
+        }
+    }
+
+private:
+    QSharedPointer<QNetworkDiskCacheEvictions> evictions;
+    QStringList files;
+};
+
+QString QNetworkDiskCachePrivate::indexFileName() const
+{
+    return dataDirectory + INDEX_FILE;
+}
+
+/*!
+    Fills the index from the snapshot written by saveIndex() or, if there is
+    no usable snapshot, by scanning the cache directory.
+ */
+void QNetworkDiskCachePrivate::loadIndex()
+{
+    if (indexLoaded)
+        return;
+    indexLoaded = true;
+
+    QFile file(indexFileName());
+    if (file.open(QFile::ReadOnly)) {
+        QDataStream in(&file);
+        qint32 marker = 0;
+        qint32 version = 0;
+        qint32 count = 0;
+        in >> marker >> version >> count;
+        if (marker == IndexMagic && version == CurrentCacheVersion) {
+            for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+                QString name;
+                qint64 size;
+                qint64 lastUsed;
+                in >> name >> size >> lastUsed;
+                addToIndex(cacheDirectory + name, size, lastUsed);
+            }
+        }
+        const bool valid = marker == IndexMagic && version == CurrentCacheVersion
+                && in.status() == QDataStream::Ok;
+        file.close();
+        // the snapshot goes stale as soon as the cache changes, don't let a
+        // crash leave it behind
+        file.remove();
+        if (valid)
+            return;
+        resetIndex();
+        indexLoaded = true;
+    }
+
+    QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
+    QDirIterator it(cacheDirectory, filters, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QString path = it.next();
+        QFileInfo info = it.fileInfo();
+        if (!info.fileName().endsWith(CACHE_POSTFIX))
+            continue;
+        if (path.contains(PREPARED_SLASH)) {
+            bool inserted = false;
+            for (QCacheItem *item : qAsConst(inserting)) {
+                if (item && item->file && item->file->fileName() == path) {
+                    inserted = true;
+                    break;
+                }
+            }
+            if (inserted)
+                continue;
+        }
+        QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
+        if (!birthTime.isValid())
+            birthTime = info.fileTime(QFile::FileMetadataChangeTime);
+        addToIndex(path, info.size(), birthTime.toMSecsSinceEpoch());
+    }
+}
+
+void QNetworkDiskCachePrivate::saveIndex()
+{
+    if (!indexLoaded || cacheDirectory.isEmpty())
+        return;
+
+    QFile file(indexFileName());
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        qWarning() << "QNetworkDiskCache: couldn't write the cache index" << file.fileName();
+        return;
+    }
+    QDataStream out(&file);
+    out << qint32(IndexMagic) << qint32(CurrentCacheVersion) << qint32(index.size());
+    for (auto it = index.cbegin(), end = index.cend(); it != end; ++it)
+        out << it.key().mid(cacheDirectory.length()) << it->size << it->lastUsed;
+}
+
+void QNetworkDiskCachePrivate::resetIndex()
+{
+    index.clear();
+    leastRecentlyUsed.clear();
+    indexedSize = 0;
+    indexLoaded = false;
+}
+
+void QNetworkDiskCachePrivate::addToIndex(const QString &file, qint64 size, qint64 lastUsed)
+{
+    removeFromIndex(file);
+    IndexEntry entry;
+    entry.size = size;
+    entry.lastUsed = lastUsed;
+    index.insert(file, entry);
+    leastRecentlyUsed.insert(lastUsed, file);
+    indexedSize += size;
+}
+
+void QNetworkDiskCachePrivate::removeFromIndex(const QString &file)
+{
+    const auto it = index.find(file);
+    if (it == index.end())
+        return;
+    leastRecentlyUsed.erase(leastRecentlyUsed.find(it->lastUsed, file));
+    indexedSize -= it->size;
+    index.erase(it);
+}
+
+void QNetworkDiskCachePrivate::touch(const QString &file)
+{
+    const auto it = index.find(file);
+    if (it == index.end())
+        return;
+    leastRecentlyUsed.erase(leastRecentlyUsed.find(it->lastUsed, file));
+    it->lastUsed = QDateTime::currentMSecsSinceEpoch();
+    leastRecentlyUsed.insert(it->lastUsed, file);
+}
+
+/*!
+    Removes \a files, which have already been taken out of the index.
+ */
+void QNetworkDiskCachePrivate::evict(const QStringList &files)
+{
+    if (files.isEmpty())
+        return;
+    if (!evictInBackground) {
+        for (const QString &file : files)
+            QFile::remove(file);
+        return;
+    }
+
+    {
+        QMutexLocker locker(&evictions->mutex);
+        for (const QString &file : files)
+            evictions->pending.insert(file);
+    }
+    QThreadPool::globalInstance()->start(new QNetworkDiskCacheEvictor(evictions, files));
+}
+
+bool QNetworkDiskCachePrivate::isEvicting(const QString &file) const
+{
+    QMutexLocker locker(&evictions->mutex);
+    return evictions->pending.contains(file);
+}
+
+void QNetworkDiskCachePrivate::cancelEviction(const QString &file)
+{
+    QMutexLocker locker(&evictions->mutex);
+    evictions->pending.remove(file);
+}
+
+/*!
+    Removes the files still waiting for a worker thread, so that none are
+    left behind when the index is written.
+ */
+void QNetworkDiskCachePrivate::finishEvictions()
+{
+    QMutexLocker locker(&evictions->mutex);
+    for (const QString &file : qAsConst(evictions->pending))
+        QFile::remove(file);
+    evictions->pending.clear();
+}
+
 QT_END_NAMESPACE
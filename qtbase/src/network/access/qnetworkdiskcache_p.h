@@ -56,6 +56,10 @@
 
 #include <qbuffer.h>
 #include <qhash.h>
+#include <qmap.h>
+#include <qmutex.h>
+#include <qset.h>
+#include <qsharedpointer.h>
 #include <qtemporaryfile.h>
 
 QT_REQUIRE_CONFIG(networkdiskcache);
@@ -94,6 +98,13 @@ public:
     bool canCompress() const;
 };
 
+// Files picked by expire() that a worker thread still has to remove
+struct QNetworkDiskCacheEvictions
+{
+    QMutex mutex;
+    QSet<QString> pending;
+};
+
 class QNetworkDiskCachePrivate : public QAbstractNetworkCachePrivate
 {
 public:
@@ -101,8 +112,17 @@ public:
         : QAbstractNetworkCachePrivate()
         , maximumCacheSize(1024 * 1024 * 50)
         , currentCacheSize(-1)
+        , indexedSize(0)
+        , indexLoaded(false)
+        , evictInBackground(false)
+        , evictions(new QNetworkDiskCacheEvictions)
         {}
 
+    struct IndexEntry {
+        qint64 size;
+        qint64 lastUsed; // msecs since the epoch
+    };
+
     static QString uniqueFileName(const QUrl &url);
     QString cacheFileName(const QUrl &url) const;
     QString tmpCacheFileName() const;
@@ -111,6 +131,18 @@ public:
     void prepareLayout();
     static quint32 crc32(const char *data, uint len);
 
+    QString indexFileName() const;
+    void loadIndex();
+    void saveIndex();
+    void resetIndex();
+    void addToIndex(const QString &file, qint64 size, qint64 lastUsed);
+    void removeFromIndex(const QString &file);
+    void touch(const QString &file);
+    void evict(const QStringList &files);
+    bool isEvicting(const QString &file) const;
+    void cancelEviction(const QString &file);
+    void finishEvictions();
+
     mutable QCacheItem lastItem;
     QString cacheDirectory;
     QString dataDirectory;
@@ -118,6 +150,14 @@ public:
     qint64 currentCacheSize;
 
     QHash<QIODevice*, QCacheItem*> inserting;
+
+    // expire() works on this index instead of walking the cache directory
+    QHash<QString, IndexEntry> index;
+    QMultiMap<qint64, QString> leastRecentlyUsed;
+    qint64 indexedSize;
+    bool indexLoaded;
+    bool evictInBackground;
+    QSharedPointer<QNetworkDiskCacheEvictions> evictions;
     Q_DECLARE_PUBLIC(QNetworkDiskCache)
 };
 
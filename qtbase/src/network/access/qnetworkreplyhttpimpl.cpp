@@ -479,8 +479,19 @@ QNetworkReplyHttpImplPrivate::~QNetworkReplyHttpImplPrivate()
     2) If we have a cache entry for this url populate headers so the server can return 304
     3) Calculate if response_is_fresh and if so send the cache and set loadedFromCache to true
  */
+QIODevice *QNetworkReplyHttpImplPrivate::downloadSink() const
+{
+    if (synchronous)
+        return 0;
+    return qobject_cast<QIODevice *>(request.attribute(QNetworkRequest::DownloadSinkAttribute).value<QObject *>());
+}
+
 bool QNetworkReplyHttpImplPrivate::loadFromCacheIfAllowed(QHttpNetworkRequest &httpRequest)
 {
+    // A cached body would have to be copied into the sink on our side
+    if (downloadSink())
+        return false;
+
     QNetworkRequest::CacheLoadControl CacheLoadControlAttribute =
         (QNetworkRequest::CacheLoadControl)request.attribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork).toInt();
     if (CacheLoadControlAttribute == QNetworkRequest::AlwaysNetwork) {
@@ -816,6 +827,10 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     delegate->authenticationManager = managerPrivate->authenticationManager;
 
     if (!synchronous) {
+        // Requests running in the thread of a shared pool follow its limits
+        if (managerPrivate->connectionPool)
+            delegate->connectionPool = QNetworkConnectionPoolPrivate::get(managerPrivate->connectionPool)->settings;
+
         // Tell our zerocopy policy to the delegate
         QVariant downloadBufferMaximumSizeAttribute = newHttpRequest.attribute(QNetworkRequest::MaximumDownloadBufferSizeAttribute);
         if (downloadBufferMaximumSizeAttribute.isValid()) {
@@ -827,6 +842,12 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
             delegate->downloadBufferMaximumSize = 128*1024;
         }
 
+        // The body goes to the sink on the HTTP thread, never through us
+        if (QIODevice *sink = downloadSink()) {
+            delegate->downloadSink = sink;
+            delegate->downloadBufferMaximumSize = 0;
+        }
+
 
         // These atomic integers are used for signal compression
         delegate->pendingDownloadData = pendingDownloadDataEmissions;
@@ -1381,7 +1402,7 @@ void QNetworkReplyHttpImplPrivate::replyDownloadProgressSlot(qint64 bytesReceive
     if (!q->isOpen())
         return;
 
-    // we can be sure here that there is a download buffer
+    // this is either for the download buffer or for the download sink
 
     int pendingSignals = (int)pendingDownloadProgressEmissions->fetchAndAddAcquire(-1) - 1;
     if (pendingSignals > 0) {
@@ -1393,6 +1414,16 @@ void QNetworkReplyHttpImplPrivate::replyDownloadProgressSlot(qint64 bytesReceive
     if (!q->isOpen())
         return;
 
+    // Without a download buffer the data went to the download sink
+    if (!downloadZerocopyBuffer) {
+        bytesDownloaded = bytesReceived;
+        if (downloadProgressSignalChoke.elapsed() >= progressSignalInterval) {
+            downloadProgressSignalChoke.restart();
+            emit q->downloadProgress(bytesDownloaded, bytesTotal);
+        }
+        return;
+    }
+
     if (cacheEnabled && isCachingAllowed() && bytesReceived == bytesTotal) {
         // Write everything in one go if we use a download buffer. might be more performant.
         initCacheSaveDevice();
@@ -1520,8 +1551,11 @@ void QNetworkReplyHttpImplPrivate::wantUploadDataSlot(qint64 maxSize)
         uploadDeviceChoking = false;
     }
 
-    // Let's make a copy of this data
-    QByteArray dataArray(data, currentUploadDataLength);
+    // Let's make a copy of this data, unless the device guarantees it stays
+    // around until the HTTP thread is done with it (e.g. a mapped file)
+    QByteArray dataArray = uploadByteDevice->readPointerStaysValid()
+            ? QByteArray::fromRawData(data, currentUploadDataLength)
+            : QByteArray(data, currentUploadDataLength);
 
     // Communicate back to HTTP thread
     emit q->haveUploadData(uploadByteDevicePosition, dataArray, uploadByteDevice->atEnd(), uploadByteDevice->size());
@@ -2322,7 +2356,8 @@ void QNetworkReplyHttpImplPrivate::createCache()
 {
     // check if we can save and if we're allowed to
     if (!managerPrivate->networkCache
-        || !request.attribute(QNetworkRequest::CacheSaveControlAttribute, true).toBool())
+        || !request.attribute(QNetworkRequest::CacheSaveControlAttribute, true).toBool()
+        || downloadSink())
         return;
     cacheEnabled = true;
 }
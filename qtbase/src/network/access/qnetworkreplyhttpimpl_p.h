@@ -273,6 +273,7 @@ public:
     QNetworkRequest redirectRequest;
 
     bool loadFromCacheIfAllowed(QHttpNetworkRequest &httpRequest);
+    QIODevice *downloadSink() const;
     void invalidateCache();
     bool sendCacheContents(const QNetworkCacheMetaData &metaData);
     QNetworkCacheMetaData fetchCacheMetaData(const QNetworkCacheMetaData &metaData) const;
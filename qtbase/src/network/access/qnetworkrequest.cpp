@@ -298,6 +298,22 @@ QT_BEGIN_NAMESPACE
         This attribute obsoletes FollowRedirectsAttribute.
         (This value was introduced in 5.9.)
 
+    \value DownloadSinkAttribute
+        Requests only, type: QMetaType::QObjectStar (default: none)
+        A QIODevice that receives the body of an HTTP response as it arrives,
+        instead of the QNetworkReply. The reply then never becomes readable
+        and emits no readyRead() signals, but still reports downloadProgress()
+        and finished(). The device is written to from the thread
+        QNetworkAccessManager uses for HTTP, so it must not be accessed from
+        any other thread until the reply has finished. Data is only read from
+        the network while the device has less than the reply's
+        readBufferSize() (or 64 KB, if that is not set) waiting in
+        bytesToWrite(), so a slow device throttles the connection to the
+        server. Responses for such requests are neither loaded from nor
+        saved to the cache, and the attribute is ignored for synchronous
+        requests.
+        (This value was introduced in 5.11.)
+
     \value User
         Special type. Additional information can be passed in
         QVariants with types ranging from User to UserMax. The default
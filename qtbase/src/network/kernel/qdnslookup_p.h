@@ -124,6 +124,7 @@ signals:
     void finished(const QDnsLookupReply &reply);
 
 private:
+    friend class QHostInfoAgent;
     static void query(const int requestType, const QByteArray &requestName, const QHostAddress &nameserver, QDnsLookupReply *reply);
     QDnsLookup::Type requestType;
     QByteArray requestName;
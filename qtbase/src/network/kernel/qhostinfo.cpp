@@ -256,7 +256,10 @@ int QHostInfo::lookupHost(const QString &name, QObject *receiver,
         if (manager->cache.isEnabled()) {
             // check cache first
             bool valid = false;
-            QHostInfo info = manager->cache.get(name, &valid);
+            bool needsRefresh = false;
+            QHostInfo info = manager->cache.get(name, &valid, &needsRefresh);
+            if (needsRefresh)
+                manager->scheduleRefresh(name);
             if (valid) {
                 if (!receiver)
                     return -1;
@@ -389,9 +392,10 @@ QHostInfo QHostInfo::fromName(const QString &name)
     qDebug("QHostInfo::fromName(\"%s\")",name.toLatin1().constData());
 #endif
 
-    QHostInfo hostInfo = QHostInfoAgent::fromName(name);
+    int timeToLive;
+    QHostInfo hostInfo = QHostInfoAgent::fromName(name, &timeToLive);
     QAbstractHostInfoLookupManager* manager = theHostInfoLookupManager();
-    manager->cache.put(name, hostInfo);
+    manager->cache.put(name, hostInfo, timeToLive);
     return hostInfo;
 }
 
@@ -416,6 +420,21 @@ QHostInfo QHostInfoAgent::fromName(const QString &hostName, QSharedPointer<QNetw
 }
 #endif
 
+// Like fromName(), but also reports for how many seconds the result may be
+// cached in \a timeToLive, or -1 if the platform resolver does not tell.
+QHostInfo QHostInfoAgent::fromName(const QString &hostName, int *timeToLive)
+{
+#ifdef QT_HOSTINFO_DNS_RESOLVER
+    if (useDnsResolver()) {
+        QHostInfo results;
+        if (fromNameUsingDns(hostName, &results, timeToLive))
+            return results;
+    }
+#endif
+    *timeToLive = -1;
+    return fromName(hostName);
+}
+
 
 /*!
     \enum QHostInfo::HostInfoError
@@ -638,7 +657,10 @@ int QHostInfo::lookupHostImpl(const QString &name,
         if (manager->cache.isEnabled()) {
             // check cache first
             bool valid = false;
-            QHostInfo info = manager->cache.get(name, &valid);
+            bool needsRefresh = false;
+            QHostInfo info = manager->cache.get(name, &valid, &needsRefresh);
+            if (needsRefresh)
+                manager->scheduleRefresh(name);
             if (valid) {
                 info.setLookupId(id);
                 emit_results_ready(info, receiver, slotObj);
@@ -653,14 +675,15 @@ int QHostInfo::lookupHostImpl(const QString &name,
     return id;
 }
 
-QHostInfoRunnable::QHostInfoRunnable(const QString &hn, int i) : toBeLookedUp(hn), id(i)
+QHostInfoRunnable::QHostInfoRunnable(const QString &hn, int i)
+    : toBeLookedUp(hn), id(i), refreshCache(false)
 {
     setAutoDelete(true);
 }
 
 QHostInfoRunnable::QHostInfoRunnable(const QString &hn, int i, const QObject *receiver,
                                      QtPrivate::QSlotObjectBase *slotObj) :
-    toBeLookedUp(hn), id(i), resultEmitter(receiver, slotObj)
+    toBeLookedUp(hn), id(i), refreshCache(false), resultEmitter(receiver, slotObj)
 {
     setAutoDelete(true);
 }
@@ -680,14 +703,18 @@ void QHostInfoRunnable::run()
     // QHostInfo::lookupHost already checks the cache. However we need to check
     // it here too because it might have been cache saved by another QHostInfoRunnable
     // in the meanwhile while this QHostInfoRunnable was scheduled but not running
+    // A refresh is scheduled for an entry that is still valid, so it must
+    // not be answered from the cache.
     if (manager->cache.isEnabled()) {
         // check the cache first
         bool valid = false;
-        hostInfo = manager->cache.get(toBeLookedUp, &valid);
+        if (!refreshCache)
+            hostInfo = manager->cache.get(toBeLookedUp, &valid);
         if (!valid) {
             // not in cache, we need to do the lookup and store the result in the cache
-            hostInfo = QHostInfoAgent::fromName(toBeLookedUp);
-            manager->cache.put(toBeLookedUp, hostInfo);
+            int timeToLive;
+            hostInfo = QHostInfoAgent::fromName(toBeLookedUp, &timeToLive);
+            manager->cache.put(toBeLookedUp, hostInfo, timeToLive);
         }
     } else {
         // cache is not enabled, just do the lookup and continue
@@ -821,6 +848,18 @@ void QHostInfoLookupManager::scheduleLookup(QHostInfoRunnable *r)
     work();
 }
 
+// called by QHostInfo when a cached entry is about to expire; the lookup
+// nobody waits for replaces the entry, so that hot names never miss the cache
+void QHostInfoLookupManager::scheduleRefresh(const QString &name)
+{
+    if (wasDeleted)
+        return;
+
+    QHostInfoRunnable *runnable = new QHostInfoRunnable(name, nextId());
+    runnable->refreshCache = true;
+    scheduleLookup(runnable);
+}
+
 // called by QHostInfo
 void QHostInfoLookupManager::abortLookup(int id)
 {
@@ -878,9 +917,12 @@ QHostInfo qt_qhostinfo_lookup(const QString &name, QObject *receiver, const char
     *id = -1;
 
     // check cache
-    QAbstractHostInfoLookupManager* manager = theHostInfoLookupManager();
+    QHostInfoLookupManager* manager = theHostInfoLookupManager();
     if (manager && manager->cache.isEnabled()) {
-        QHostInfo info = manager->cache.get(name, valid);
+        bool needsRefresh = false;
+        QHostInfo info = manager->cache.get(name, valid, &needsRefresh);
+        if (needsRefresh)
+            manager->scheduleRefresh(name);
         if (*valid) {
             return info;
         }
@@ -922,7 +964,7 @@ void qt_qhostinfo_cache_inject(const QString &hostname, const QHostInfo &resolut
 
 // cache for 60 seconds
 // cache 128 items
-QHostInfoCache::QHostInfoCache() : max_age(60), enabled(true), cache(128)
+QHostInfoCache::QHostInfoCache() : max_age(60), max_ttl(3600), enabled(true), cache(128)
 {
 #ifdef QT_QHOSTINFO_CACHE_DISABLED_BY_DEFAULT
     enabled = false;
@@ -942,34 +984,48 @@ void QHostInfoCache::setEnabled(bool e)
 }
 
 
-QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
+// If \a needsRefresh is given, it is set to true once for a frequently used
+// entry that entered the last quarter of its lifetime; the caller is then
+// expected to schedule a lookup that replaces the entry before it expires.
+QHostInfo QHostInfoCache::get(const QString &name, bool *valid, bool *needsRefresh)
 {
     QMutexLocker locker(&this->mutex);
 
     *valid = false;
     if (QHostInfoCacheElement *element = cache.object(name)) {
-        if (element->age.elapsed() < max_age*1000)
+        const qint64 age = element->age.elapsed();
+        if (age < element->lifetime) {
             *valid = true;
+            ++element->hits;
+            if (needsRefresh && !element->refreshing && element->hits > 1
+                    && age >= element->lifetime / 4 * 3) {
+                element->refreshing = true;
+                *needsRefresh = true;
+            }
+        }
         return element->info;
-
-        // FIXME idea:
-        // if too old but not expired, trigger a new lookup
-        // to freshen our cache
     }
 
     return QHostInfo();
 }
 
-void QHostInfoCache::put(const QString &name, const QHostInfo &info)
+// \a timeToLive is the number of seconds the resolver allows the result to
+// be cached for, or -1 if it is unknown.
+void QHostInfoCache::put(const QString &name, const QHostInfo &info, int timeToLive)
 {
     // if the lookup failed, don't cache
     if (info.error() != QHostInfo::NoError)
         return;
+    if (timeToLive == 0)
+        return;
 
     QHostInfoCacheElement* element = new QHostInfoCacheElement();
     element->info = info;
     element->age = QElapsedTimer();
     element->age.start();
+    element->lifetime = qint64(timeToLive < 0 ? max_age : qMin(timeToLive, max_ttl)) * 1000;
+    element->hits = 0;
+    element->refreshing = false;
 
     QMutexLocker locker(&this->mutex);
     cache.insert(name, element); // cache will take ownership
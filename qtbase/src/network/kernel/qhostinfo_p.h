@@ -68,6 +68,12 @@
 #include <QElapsedTimer>
 #include <QCache>
 
+// Platforms on which QHostInfoAgent can resolve names through the
+// QDnsLookup resolver and learn the records' time to live
+#if defined(Q_OS_UNIX) && !defined(Q_OS_INTEGRITY) && !defined(Q_OS_ANDROID)
+#  define QT_HOSTINFO_DNS_RESOLVER
+#endif
+
 #include <QNetworkSession>
 #include <QSharedPointer>
 
@@ -131,9 +137,16 @@ class QHostInfoAgent : public QObject
     Q_OBJECT
 public:
     static QHostInfo fromName(const QString &hostName);
+    static QHostInfo fromName(const QString &hostName, int *timeToLive);
 #ifndef QT_NO_BEARERMANAGEMENT
     static QHostInfo fromName(const QString &hostName, QSharedPointer<QNetworkSession> networkSession);
 #endif
+
+private:
+#ifdef QT_HOSTINFO_DNS_RESOLVER
+    static bool useDnsResolver();
+    static bool fromNameUsingDns(const QString &hostName, QHostInfo *results, int *timeToLive);
+#endif
 };
 
 class QHostInfoPrivate
@@ -168,10 +181,11 @@ class QHostInfoCache
 {
 public:
     QHostInfoCache();
-    const int max_age; // seconds
+    const int max_age; // seconds, used when the resolver reports no TTL
+    const int max_ttl; // seconds, upper bound for TTLs reported by the resolver
 
-    QHostInfo get(const QString &name, bool *valid);
-    void put(const QString &name, const QHostInfo &info);
+    QHostInfo get(const QString &name, bool *valid, bool *needsRefresh = Q_NULLPTR);
+    void put(const QString &name, const QHostInfo &info, int timeToLive = -1);
     void clear();
 
     bool isEnabled();
@@ -181,6 +195,9 @@ private:
     struct QHostInfoCacheElement {
         QHostInfo info;
         QElapsedTimer age;
+        qint64 lifetime; // msecs
+        int hits;
+        bool refreshing;
     };
     QCache<QString,QHostInfoCacheElement> cache;
     QMutex mutex;
@@ -198,6 +215,7 @@ public:
 
     QString toBeLookedUp;
     int id;
+    bool refreshCache; // bypass the cache, the entry is about to expire
     QHostInfoResult resultEmitter;
 };
 
@@ -230,6 +248,7 @@ public:
 
     // called from QHostInfo
     void scheduleLookup(QHostInfoRunnable *r);
+    void scheduleRefresh(const QString &name);
     void abortLookup(int id);
 
     // called from QHostInfoRunnable
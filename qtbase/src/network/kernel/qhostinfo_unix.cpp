@@ -52,6 +52,15 @@
 #include <qurl.h>
 #include <qfile.h>
 #include <private/qnet_unix_p.h>
+#ifdef QT_HOSTINFO_DNS_RESOLVER
+#include <private/qdnslookup_p.h>
+#include <qsemaphore.h>
+#include <qsharedpointer.h>
+#include <qthreadpool.h>
+
+#include <functional>
+#include <limits>
+#endif
 
 #include <sys/types.h>
 #include <netdb.h>
@@ -272,6 +281,107 @@ QHostInfo QHostInfoAgent::fromName(const QString &hostName)
     return results;
 }
 
+#ifdef QT_HOSTINFO_DNS_RESOLVER
+namespace {
+class QHostInfoDnsQuery : public QRunnable
+{
+public:
+    explicit QHostInfoDnsQuery(const std::function<void()> &query) : query(query) {}
+    void run() Q_DECL_OVERRIDE { query(); }
+
+private:
+    std::function<void()> query;
+};
+
+// Shared between the lookup and the thread running the AAAA query, which
+// may still be running when the lookup has given up waiting for it
+struct QHostInfoDnsAnswer
+{
+    QDnsLookupReply reply;
+    QSemaphore done;
+};
+
+// How long to wait for the AAAA answer once the A answer has arrived (RFC 8305)
+enum { ResolutionDelay = 50 };
+}
+
+bool QHostInfoAgent::useDnsResolver()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QT_HOSTINFO_DNS_RESOLVER") > 0;
+    return enabled;
+}
+
+// Resolves a fully qualified host name by querying the DNS servers for its A
+// and AAAA records in parallel, which unlike getaddrinfo() tells us for how
+// long the answer stays valid. Returns false if the name should be resolved
+// by fromName() instead: for address literals, names without a domain that
+// need the search list, and names the DNS did not resolve, which may still
+// be known to the hosts file or other name services.
+bool QHostInfoAgent::fromNameUsingDns(const QString &hostName, QHostInfo *results,
+                                      int *timeToLive)
+{
+    QHostAddress address;
+    if (address.setAddress(hostName))
+        return false;
+
+    const QByteArray aceHostname = QUrl::toAce(hostName);
+    if (aceHostname.isEmpty() || !aceHostname.contains('.'))
+        return false;
+
+    QSharedPointer<QHostInfoDnsAnswer> aaaa = QSharedPointer<QHostInfoDnsAnswer>::create();
+    const std::function<void()> queryAaaa = [aaaa, aceHostname]() {
+        QDnsLookupRunnable::query(QDnsLookup::AAAA, aceHostname, QHostAddress(), &aaaa->reply);
+        aaaa->done.release();
+    };
+    QHostInfoDnsQuery *aaaaQuery = new QHostInfoDnsQuery(queryAaaa);
+    if (!QThreadPool::globalInstance()->tryStart(aaaaQuery)) {
+        delete aaaaQuery;
+        queryAaaa();
+    }
+
+    QDnsLookupReply a;
+    QDnsLookupRunnable::query(QDnsLookup::A, aceHostname, QHostAddress(), &a);
+
+    const bool haveA = a.error == QDnsLookup::NoError && !a.hostAddressRecords.isEmpty();
+    bool haveAaaa = true;
+    if (haveA)
+        haveAaaa = aaaa->done.tryAcquire(1, ResolutionDelay);
+    else
+        aaaa->done.acquire();
+    haveAaaa = haveAaaa && aaaa->reply.error == QDnsLookup::NoError;
+
+    // place all IPv4 addresses at the start and the IPv6 addresses at the end,
+    // like fromName() does
+    QList<QHostAddress> addresses;
+    quint32 ttl = std::numeric_limits<int>::max();
+    const auto collect = [&addresses, &ttl](const QDnsLookupReply &reply) {
+        for (const QDnsHostAddressRecord &record : reply.hostAddressRecords) {
+            if (!addresses.contains(record.value()))
+                addresses.append(record.value());
+            ttl = qMin(ttl, record.timeToLive());
+        }
+        for (const QDnsDomainNameRecord &record : reply.canonicalNameRecords)
+            ttl = qMin(ttl, record.timeToLive());
+    };
+    if (haveA)
+        collect(a);
+    if (haveAaaa)
+        collect(aaaa->reply);
+
+    if (addresses.isEmpty())
+        return false;
+
+#if defined(QHOSTINFO_DEBUG)
+    qDebug("QHostInfoAgent::fromNameUsingDns(): found %i entries for \"%s\", ttl %u",
+           addresses.count(), hostName.toLatin1().constData(), ttl);
+#endif
+    results->setHostName(hostName);
+    results->setAddresses(addresses);
+    *timeToLive = int(ttl);
+    return true;
+}
+#endif // QT_HOSTINFO_DNS_RESOLVER
+
 QString QHostInfo::localDomainName()
 {
 #if !defined(Q_OS_VXWORKS) && !defined(Q_OS_ANDROID)
@@ -387,6 +387,17 @@
     (see \l{QAbstractSocket::}{setReadBufferSize()}).
     This enum value has been introduced in Qt 5.3.
 
+    \value ConnectionAttemptDelayOption Sets the time in milliseconds
+    after which a TCP connection attempt to one of the addresses of the
+    host is raced by an attempt to the next address, alternating between
+    IPv4 and IPv6 ("Happy Eyeballs", RFC 8305). The first attempt to
+    succeed is used and the others are aborted. RFC 8305 recommends 250
+    milliseconds. The default, 0, tries the addresses one after another.
+    Racing is not done through proxies, or when the socket is used
+    without an event loop. This option must be set before
+    connectToHost() and does not map to an OS level socket option.
+    This enum value has been introduced in Qt 5.11.
+
     Possible values for \e{TypeOfServiceOption} are:
 
     \table
@@ -565,6 +576,8 @@ QAbstractSocketPrivate::QAbstractSocketPrivate()
       isBuffered(false),
       hasPendingData(false),
       connectTimer(0),
+      connectAttemptTimer(0),
+      connectionAttemptDelay(0),
       hostLookupId(-1),
       socketType(QAbstractSocket::UnknownSocketType),
       state(QAbstractSocket::UnconnectedState),
@@ -603,6 +616,7 @@ void QAbstractSocketPrivate::resetSocketLayer()
     }
     if (connectTimer)
         connectTimer->stop();
+    abortConnectAttempts();
 }
 
 /*! \internal
@@ -1027,8 +1041,26 @@ void QAbstractSocketPrivate::_q_startConnecting(const QHostInfo &hostInfo)
     qDebug("QAbstractSocketPrivate::_q_startConnecting(hostInfo == %s)", s.toLatin1().constData());
 #endif
 
-    // Try all addresses twice.
-    addresses += addresses;
+    if (canRaceConnectAttempts() && !addresses.isEmpty()) {
+        // Alternate between the address families, so that the attempt racing
+        // the first one uses the other family (RFC 8305, section 4). The
+        // addresses are not tried twice, the racing attempts keep running.
+        QList<QHostAddress> preferred;
+        QList<QHostAddress> others;
+        const QAbstractSocket::NetworkLayerProtocol family = addresses.constFirst().protocol();
+        for (const QHostAddress &address : qAsConst(addresses))
+            (address.protocol() == family ? preferred : others).append(address);
+        addresses.clear();
+        for (int i = 0; i < qMax(preferred.count(), others.count()); ++i) {
+            if (i < preferred.count())
+                addresses += preferred.at(i);
+            if (i < others.count())
+                addresses += others.at(i);
+        }
+    } else {
+        // Try all addresses twice.
+        addresses += addresses;
+    }
 
     // If there are no addresses in the host list, report this to the
     // user.
@@ -1133,31 +1165,200 @@ void QAbstractSocketPrivate::_q_connectToNextAddress()
         }
 
         // Start the connect timer.
-        if (threadData->hasEventDispatcher()) {
-            if (!connectTimer) {
-                connectTimer = new QTimer(q);
-                QObject::connect(connectTimer, SIGNAL(timeout()),
-                                 q, SLOT(_q_abortConnectionAttempt()),
-                                 Qt::DirectConnection);
-            }
-            int connectTimeout = QNetworkConfigurationPrivate::DefaultTimeout;
-#ifndef QT_NO_BEARERMANAGEMENT
-            QSharedPointer<QNetworkSession> networkSession = qvariant_cast< QSharedPointer<QNetworkSession> >(q->property("_q_networksession"));
-            if (networkSession) {
-                QNetworkConfiguration networkConfiguration = networkSession->configuration();
-                connectTimeout = networkConfiguration.connectTimeout();
-            }
-#endif
-            connectTimer->start(connectTimeout);
-        }
+        startConnectTimer();
 
         // Wait for a write notification that will eventually call
         // _q_testConnection().
         socketEngine->setWriteNotificationEnabled(true);
+
+        // If this attempt does not succeed within the connection attempt
+        // delay, race it with one to the next address.
+        if (canRaceConnectAttempts() && !addresses.isEmpty()) {
+            if (!connectAttemptTimer) {
+                connectAttemptTimer = new QTimer(q);
+                connectAttemptTimer->setSingleShot(true);
+                QObject::connect(connectAttemptTimer, SIGNAL(timeout()),
+                                 q, SLOT(_q_startConnectAttempt()),
+                                 Qt::DirectConnection);
+            }
+            connectAttemptTimer->start(connectionAttemptDelay);
+        }
         break;
     } while (state != QAbstractSocket::ConnectedState);
 }
 
+/*! \internal
+
+    Starts the connect timer that aborts the connection attempt of
+    socketEngine when it takes too long.
+*/
+void QAbstractSocketPrivate::startConnectTimer()
+{
+    Q_Q(QAbstractSocket);
+    if (!threadData->hasEventDispatcher())
+        return;
+
+    if (!connectTimer) {
+        connectTimer = new QTimer(q);
+        QObject::connect(connectTimer, SIGNAL(timeout()),
+                         q, SLOT(_q_abortConnectionAttempt()),
+                         Qt::DirectConnection);
+    }
+    int connectTimeout = QNetworkConfigurationPrivate::DefaultTimeout;
+#ifndef QT_NO_BEARERMANAGEMENT
+    QSharedPointer<QNetworkSession> networkSession = qvariant_cast< QSharedPointer<QNetworkSession> >(q->property("_q_networksession"));
+    if (networkSession) {
+        QNetworkConfiguration networkConfiguration = networkSession->configuration();
+        connectTimeout = networkConfiguration.connectTimeout();
+    }
+#endif
+    connectTimer->start(connectTimeout);
+}
+
+/*! \internal
+
+    Returns true if connection attempts to the addresses of the host may
+    run in parallel, staggered by connectionAttemptDelay. This is only done
+    for direct TCP connections made from a thread with an event loop.
+*/
+bool QAbstractSocketPrivate::canRaceConnectAttempts() const
+{
+    Q_Q(const QAbstractSocket);
+    if (connectionAttemptDelay <= 0 || q->socketType() != QAbstractSocket::TcpSocket
+        || !threadData->hasEventDispatcher()) {
+        return false;
+    }
+#ifndef QT_NO_NETWORKPROXY
+    if (proxyInUse.type() != QNetworkProxy::NoProxy)
+        return false;
+#endif
+    return true;
+}
+
+/*! \internal
+
+    Called by connectAttemptTimer when the current connection attempts
+    did not succeed within connectionAttemptDelay. Starts an attempt to
+    the next pending address without giving up the running ones.
+*/
+void QAbstractSocketPrivate::_q_startConnectAttempt()
+{
+    Q_Q(QAbstractSocket);
+#ifdef QT_NO_NETWORKPROXY
+    // this is here to avoid a duplication of the call to createSocketEngine below
+    static const QNetworkProxy &proxyInUse = *(QNetworkProxy *)0;
+#endif
+
+    while (state == QAbstractSocket::ConnectingState && !addresses.isEmpty()) {
+        const QHostAddress address = addresses.takeFirst();
+#if defined(QABSTRACTSOCKET_DEBUG)
+        qDebug("QAbstractSocketPrivate::_q_startConnectAttempt(), racing %s:%i, %d left to try",
+               address.toString().toLatin1().constData(), port, addresses.count());
+#endif
+        QAbstractSocketEngine *engine =
+                QAbstractSocketEngine::createSocketEngine(q->socketType(), proxyInUse, q);
+        if (!engine)
+            return;
+#ifndef QT_NO_BEARERMANAGEMENT
+        engine->setProperty("_q_networksession", q->property("_q_networksession"));
+#endif
+        if (!engine->initialize(q->socketType(), address.protocol())) {
+            delete engine;
+            continue;
+        }
+
+        QAbstractSocketConnectAttempt *attempt = new QAbstractSocketConnectAttempt(this, engine, address);
+        engine->setReceiver(attempt);
+        if (engine->connectToHost(address, port)) {
+            adoptConnectAttempt(attempt);
+            _q_testConnection();
+            return;
+        }
+        if (engine->state() != QAbstractSocket::ConnectingState) {
+            delete attempt;
+            continue;
+        }
+
+        engine->setWriteNotificationEnabled(true);
+        connectAttempts.append(attempt);
+        if (!addresses.isEmpty())
+            connectAttemptTimer->start(connectionAttemptDelay);
+        return;
+    }
+}
+
+/*! \internal
+
+    Called when the racing connection attempt \a attempt either
+    connected or failed.
+*/
+void QAbstractSocketPrivate::connectAttemptFinished(QAbstractSocketConnectAttempt *attempt)
+{
+    connectAttempts.removeOne(attempt);
+    if (state == QAbstractSocket::ConnectingState
+        && attempt->engine->state() == QAbstractSocket::ConnectedState) {
+#if defined(QABSTRACTSOCKET_DEBUG)
+        qDebug("QAbstractSocketPrivate::connectAttemptFinished(), %s won the race",
+               attempt->address.toString().toLatin1().constData());
+#endif
+        adoptConnectAttempt(attempt);
+        _q_testConnection();
+        return;
+    }
+
+    // the other attempts are still running
+    delete attempt;
+}
+
+/*! \internal
+
+    Replaces socketEngine by the engine of the racing connection attempt
+    \a attempt, which is deleted.
+*/
+void QAbstractSocketPrivate::adoptConnectAttempt(QAbstractSocketConnectAttempt *attempt)
+{
+    if (socketEngine) {
+        socketEngine->close();
+        socketEngine->disconnect();
+        delete socketEngine;
+    }
+    socketEngine = attempt->engine;
+    cachedSocketDescriptor = -1;
+    host = attempt->address;
+    attempt->engine = 0;
+    delete attempt;
+
+    configureCreatedSocket();
+    socketEngine->setReceiver(this);
+}
+
+/*! \internal
+
+    Gives up all racing connection attempts.
+*/
+void QAbstractSocketPrivate::abortConnectAttempts()
+{
+    if (connectAttemptTimer)
+        connectAttemptTimer->stop();
+    qDeleteAll(connectAttempts);
+    connectAttempts.clear();
+}
+
+QAbstractSocketConnectAttempt::~QAbstractSocketConnectAttempt()
+{
+    if (engine) {
+        engine->close();
+        engine->setReceiver(0);
+        // we may be called from one of the engine's notifications
+        engine->deleteLater();
+    }
+}
+
+void QAbstractSocketConnectAttempt::connectionNotification()
+{
+    d->connectAttemptFinished(this);
+}
+
 /*! \internal
 
     Tests if a connection has been established. If it has, connected()
@@ -1172,6 +1373,7 @@ void QAbstractSocketPrivate::_q_testConnection()
         if (socketEngine->state() == QAbstractSocket::ConnectedState) {
             // Fetch the parameters if our connection is completed;
             // otherwise, fall out and try the next address.
+            abortConnectAttempts();
             fetchConnectionParameters();
             if (pendingClose) {
                 q_func()->disconnectFromHost();
@@ -1189,6 +1391,12 @@ void QAbstractSocketPrivate::_q_testConnection()
     qDebug("QAbstractSocketPrivate::_q_testConnection() connection failed,"
            " checking for alternative addresses");
 #endif
+    if (!connectAttempts.isEmpty()) {
+        // continue with the oldest of the attempts racing this one
+        adoptConnectAttempt(connectAttempts.takeFirst());
+        startConnectTimer();
+        return;
+    }
     _q_connectToNextAddress();
 }
 
@@ -1210,7 +1418,11 @@ void QAbstractSocketPrivate::_q_abortConnectionAttempt()
 
     connectTimer->stop();
 
-    if (addresses.isEmpty()) {
+    if (!connectAttempts.isEmpty()) {
+        // continue with the oldest of the attempts racing this one
+        adoptConnectAttempt(connectAttempts.takeFirst());
+        startConnectTimer();
+    } else if (addresses.isEmpty()) {
         state = QAbstractSocket::UnconnectedState;
         setError(QAbstractSocket::SocketTimeoutError,
                  QAbstractSocket::tr("Connection timed out"));
@@ -1982,6 +2194,11 @@ bool QAbstractSocket::setSocketDescriptor(qintptr socketDescriptor, SocketState
 */
 void QAbstractSocket::setSocketOption(QAbstractSocket::SocketOption option, const QVariant &value)
 {
+    if (option == ConnectionAttemptDelayOption) {
+        d_func()->connectionAttemptDelay = qMax(0, value.toInt());
+        return;
+    }
+
     if (!d_func()->socketEngine)
         return;
 
@@ -2013,6 +2230,9 @@ void QAbstractSocket::setSocketOption(QAbstractSocket::SocketOption option, cons
         case ReceiveBufferSizeSocketOption:
             d_func()->socketEngine->setOption(QAbstractSocketEngine::ReceiveBufferSocketOption, value.toInt());
             break;
+
+        case ConnectionAttemptDelayOption:
+            break;
     }
 }
 
@@ -2024,6 +2244,9 @@ void QAbstractSocket::setSocketOption(QAbstractSocket::SocketOption option, cons
 */
 QVariant QAbstractSocket::socketOption(QAbstractSocket::SocketOption option)
 {
+    if (option == ConnectionAttemptDelayOption)
+        return QVariant(d_func()->connectionAttemptDelay);
+
     if (!d_func()->socketEngine)
         return QVariant();
 
@@ -2055,6 +2278,9 @@ QVariant QAbstractSocket::socketOption(QAbstractSocket::SocketOption option)
         case ReceiveBufferSizeSocketOption:
                 ret = d_func()->socketEngine->option(QAbstractSocketEngine::ReceiveBufferSocketOption);
                 break;
+
+        case ConnectionAttemptDelayOption:
+                break;
     }
     if (ret == -1)
         return QVariant();
@@ -120,7 +120,8 @@ public:
         MulticastLoopbackOption, // IP_MULTICAST_LOOPBACK
         TypeOfServiceOption, //IP_TOS
         SendBufferSizeSocketOption,    //SO_SNDBUF
-        ReceiveBufferSizeSocketOption  //SO_RCVBUF
+        ReceiveBufferSizeSocketOption, //SO_RCVBUF
+        ConnectionAttemptDelayOption   // RFC 8305 connection racing
     };
     Q_ENUM(SocketOption)
     enum BindFlag {
@@ -231,6 +232,7 @@ private:
     Q_PRIVATE_SLOT(d_func(), void _q_startConnecting(const QHostInfo &))
     Q_PRIVATE_SLOT(d_func(), void _q_abortConnectionAttempt())
     Q_PRIVATE_SLOT(d_func(), void _q_testConnection())
+    Q_PRIVATE_SLOT(d_func(), void _q_startConnectAttempt())
 };
 
 
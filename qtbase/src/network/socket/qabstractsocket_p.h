@@ -63,6 +63,33 @@
 QT_BEGIN_NAMESPACE
 
 class QHostInfo;
+class QAbstractSocketPrivate;
+
+// A connection attempt racing the one of QAbstractSocketPrivate::socketEngine,
+// see QAbstractSocket::ConnectionAttemptDelayOption
+class QAbstractSocketConnectAttempt : public QAbstractSocketEngineReceiver
+{
+public:
+    QAbstractSocketConnectAttempt(QAbstractSocketPrivate *d, QAbstractSocketEngine *engine,
+                                  const QHostAddress &address)
+        : d(d), engine(engine), address(address)
+    { }
+    ~QAbstractSocketConnectAttempt();
+
+    // from QAbstractSocketEngineReceiver
+    inline void readNotification() override {}
+    inline void writeNotification() override {}
+    inline void exceptionNotification() override {}
+    inline void closeNotification() override {}
+    void connectionNotification() override;
+#ifndef QT_NO_NETWORKPROXY
+    inline void proxyAuthenticationRequired(const QNetworkProxy &, QAuthenticator *) override {}
+#endif
+
+    QAbstractSocketPrivate *d;
+    QAbstractSocketEngine *engine;
+    QHostAddress address;
+};
 
 class QAbstractSocketPrivate : public QIODevicePrivate, public QAbstractSocketEngineReceiver
 {
@@ -95,6 +122,13 @@ public:
     void _q_startConnecting(const QHostInfo &hostInfo);
     void _q_testConnection();
     void _q_abortConnectionAttempt();
+    void _q_startConnectAttempt();
+
+    bool canRaceConnectAttempts() const;
+    void connectAttemptFinished(QAbstractSocketConnectAttempt *attempt);
+    void adoptConnectAttempt(QAbstractSocketConnectAttempt *attempt);
+    void abortConnectAttempts();
+    void startConnectTimer();
 
     bool emittedReadyRead;
     bool emittedBytesWritten;
@@ -148,6 +182,10 @@ public:
 
     QTimer *connectTimer;
 
+    QList<QAbstractSocketConnectAttempt *> connectAttempts;
+    QTimer *connectAttemptTimer;
+    int connectionAttemptDelay; // msecs, 0 if addresses are tried one after another
+
     int hostLookupId;
 
     QAbstractSocket::SocketType socketType;
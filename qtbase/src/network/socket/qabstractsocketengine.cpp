@@ -132,6 +132,54 @@ QAbstractSocketEngine *QAbstractSocketEngine::createSocketEngine(qintptr socketD
     return new QNativeSocketEngine(parent);
 }
 
+/*!
+    Reads up to \a count datagrams, the i-th into \a data[i] of \a maxlen bytes,
+    storing their sizes in \a lengths and their headers in \a headers. Returns
+    the number of datagrams read, or the result of the failing readDatagram()
+    if not a single one could be read.
+
+    This implementation calls readDatagram() for each datagram; engines that
+    can do better override it.
+*/
+int QAbstractSocketEngine::readDatagrams(int count, char *const *data, qint64 maxlen, qint64 *lengths,
+                                         QIpPacketHeader *headers, PacketHeaderOptions options)
+{
+    int received = 0;
+    for ( ; received < count; ++received) {
+#ifndef QT_NO_UDPSOCKET
+        if (received && !hasPendingDatagrams())
+            break;
+#endif
+        const qint64 result = readDatagram(data[received], maxlen,
+                                           headers ? &headers[received] : 0, options);
+        if (result < 0)
+            return received ? received : int(result);
+        lengths[received] = result;
+    }
+    return received;
+}
+
+/*!
+    Writes \a count datagrams of \a lengths bytes from \a data, each to the
+    destination in the corresponding entry of \a headers. Returns the number of
+    datagrams written, or the result of the failing writeDatagram() if not a
+    single one could be written.
+
+    This implementation calls writeDatagram() for each datagram; engines that
+    can do better override it.
+*/
+int QAbstractSocketEngine::writeDatagrams(int count, const char *const *data, const qint64 *lengths,
+                                          const QIpPacketHeader *headers)
+{
+    int sent = 0;
+    for ( ; sent < count; ++sent) {
+        const qint64 result = writeDatagram(data[sent], lengths[sent], headers[sent]);
+        if (result < 0)
+            return sent ? sent : int(result);
+    }
+    return sent;
+}
+
 QAbstractSocket::SocketError QAbstractSocketEngine::error() const
 {
     return d_func()->socketError;
@@ -105,7 +105,9 @@ public:
         TypeOfServiceOption,
         ReceivePacketInformation,
         ReceiveHopLimit,
-        MaxStreamsSocketOption
+        MaxStreamsSocketOption,
+        ReusePortOption,
+        PassDescriptorsOption
     };
 
     enum PacketHeaderOption {
@@ -157,6 +159,10 @@ public:
     virtual qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader *header = 0,
                                 PacketHeaderOptions = WantNone) = 0;
     virtual qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &header) = 0;
+    virtual int readDatagrams(int count, char *const *data, qint64 maxlen, qint64 *lengths,
+                              QIpPacketHeader *headers = 0, PacketHeaderOptions = WantNone);
+    virtual int writeDatagrams(int count, const char *const *data, const qint64 *lengths,
+                               const QIpPacketHeader *headers);
     virtual qint64 bytesToWrite() const = 0;
 
     virtual int option(SocketOption option) const = 0;
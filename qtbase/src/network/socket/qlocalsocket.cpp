@@ -206,6 +206,44 @@ QT_BEGIN_NAMESPACE
     \sa write(), waitForBytesWritten()
 */
 
+/*!
+    \fn bool QLocalSocket::writeWithDescriptors(const QByteArray &data, const QVector<qintptr> &descriptors)
+    \since 5.11
+
+    Writes \a data to the socket and passes \a descriptors, which are open
+    file descriptors of this process, to the peer process along with it.
+    The peer receives duplicates of the descriptors that refer to the same
+    open files, so it can for instance map a shared memory file created
+    with \c memfd_create() or \c shm_open() and read the data without it
+    being copied through the socket. The caller keeps ownership of \a
+    descriptors and may close them once this function returns.
+
+    The descriptors become available on the other end through
+    takeReceivedDescriptors() once the first byte of \a data has been
+    received, so \a data must not be empty; it typically describes what
+    the descriptors are for. Data written with write() before is sent
+    first. If that data cannot be written without blocking, nothing is
+    sent.
+
+    Returns \c true if the descriptors were sent; otherwise returns \c false.
+    Passing descriptors is only supported on Unix, using \c SCM_RIGHTS
+    messages; on other platforms this function always returns \c false.
+
+    \sa takeReceivedDescriptors()
+*/
+
+/*!
+    \fn QVector<qintptr> QLocalSocket::takeReceivedDescriptors()
+    \since 5.11
+
+    Returns the file descriptors the peer has passed with
+    writeWithDescriptors() and that have been received so far, in the order
+    they were sent. The caller becomes responsible for closing them.
+    Descriptors that are not taken are closed when the socket is closed.
+
+    \sa writeWithDescriptors()
+*/
+
 /*!
     \fn void QLocalSocket::disconnectFromServer()
 
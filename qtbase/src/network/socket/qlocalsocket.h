@@ -42,6 +42,7 @@
 
 #include <QtNetwork/qtnetworkglobal.h>
 #include <QtCore/qiodevice.h>
+#include <QtCore/qvector.h>
 #include <QtNetwork/qabstractsocket.h>
 
 QT_REQUIRE_CONFIG(localserver);
@@ -108,6 +109,9 @@ public:
                              OpenMode openMode = ReadWrite);
     qintptr socketDescriptor() const;
 
+    bool writeWithDescriptors(const QByteArray &data, const QVector<qintptr> &descriptors);
+    QVector<qintptr> takeReceivedDescriptors();
+
     LocalSocketState state() const;
     bool waitForBytesWritten(int msecs = 30000) Q_DECL_OVERRIDE;
     bool waitForConnected(int msecs = 30000);
@@ -68,6 +68,7 @@ QT_REQUIRE_CONFIG(localserver);
 #   include <qwineventnotifier.h>
 #else
 #   include "private/qabstractsocketengine_p.h"
+#   include "private/qnativesocketengine_p.h"
 #   include <qtcpsocket.h>
 #   include <qsocketnotifier.h>
 #   include <errno.h>
@@ -147,6 +148,8 @@ public:
     void _q_connectToSocket();
     void _q_abortConnectionAttempt();
     void cancelDelayedConnect();
+    QNativeSocketEngine *nativeSocketEngine() const;
+    void enableDescriptorPassing();
     QSocketNotifier *delayConnect;
     QTimer *connectTimer;
     int connectingSocket;
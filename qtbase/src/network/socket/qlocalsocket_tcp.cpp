@@ -436,4 +436,15 @@ bool QLocalSocket::waitForReadyRead(int msecs)
     return (d->tcpSocket->waitForReadyRead(msecs));
 }
 
+bool QLocalSocket::writeWithDescriptors(const QByteArray &, const QVector<qintptr> &)
+{
+    // descriptors can't be passed over TCP
+    return false;
+}
+
+QVector<qintptr> QLocalSocket::takeReceivedDescriptors()
+{
+    return QVector<qintptr>();
+}
+
 QT_END_NAMESPACE
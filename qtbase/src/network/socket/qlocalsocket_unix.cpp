@@ -40,6 +40,7 @@
 #include "qlocalsocket.h"
 #include "qlocalsocket_p.h"
 #include "qnet_unix_p.h"
+#include "private/qabstractsocket_p.h"
 
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -328,6 +329,7 @@ void QLocalSocketPrivate::_q_connectToSocket()
     fullServerName = connectingPathName;
     if (unixSocket.setSocketDescriptor(connectingSocket,
         QAbstractSocket::ConnectedState, connectingOpenMode)) {
+        enableDescriptorPassing();
         q->QIODevice::open(connectingOpenMode | QIODevice::Unbuffered);
         q->emit connected();
     } else {
@@ -360,8 +362,64 @@ bool QLocalSocket::setSocketDescriptor(qintptr socketDescriptor,
     }
     QIODevice::open(openMode);
     d->state = socketState;
-    return d->unixSocket.setSocketDescriptor(socketDescriptor,
-                                             newSocketState, openMode);
+    if (!d->unixSocket.setSocketDescriptor(socketDescriptor, newSocketState, openMode))
+        return false;
+    d->enableDescriptorPassing();
+    return true;
+}
+
+QNativeSocketEngine *QLocalSocketPrivate::nativeSocketEngine() const
+{
+    QLocalUnixSocket *socket = const_cast<QLocalUnixSocket *>(&unixSocket);
+    QAbstractSocketPrivate *socketPrivate =
+            static_cast<QAbstractSocketPrivate *>(QObjectPrivate::get(socket));
+    return qobject_cast<QNativeSocketEngine *>(socketPrivate->socketEngine);
+}
+
+void QLocalSocketPrivate::enableDescriptorPassing()
+{
+    // must be in place before the first read, or passed descriptors get lost
+    if (QNativeSocketEngine *engine = nativeSocketEngine())
+        engine->setOption(QAbstractSocketEngine::PassDescriptorsOption, 1);
+}
+
+bool QLocalSocket::writeWithDescriptors(const QByteArray &data, const QVector<qintptr> &descriptors)
+{
+    Q_D(QLocalSocket);
+    QNativeSocketEngine *engine = d->nativeSocketEngine();
+    if (!engine || state() != ConnectedState || data.isEmpty())
+        return false;
+
+    // data written before must not be overtaken
+    if (d->unixSocket.bytesToWrite() > 0) {
+        d->unixSocket.flush();
+        if (d->unixSocket.bytesToWrite() > 0)
+            return false;
+    }
+
+    QVector<int> fds;
+    fds.reserve(descriptors.size());
+    for (qintptr descriptor : descriptors)
+        fds.append(int(descriptor));
+    const qint64 written = engine->writeWithDescriptors(data.constData(), data.size(), fds);
+    if (written <= 0)
+        return false;
+    if (written < data.size())
+        d->unixSocket.write(data.constData() + written, data.size() - written);
+    return true;
+}
+
+QVector<qintptr> QLocalSocket::takeReceivedDescriptors()
+{
+    Q_D(QLocalSocket);
+    QVector<qintptr> descriptors;
+    if (QNativeSocketEngine *engine = d->nativeSocketEngine()) {
+        const QVector<int> fds = engine->takeReceivedDescriptors();
+        descriptors.reserve(fds.size());
+        for (int fd : fds)
+            descriptors.append(fd);
+    }
+    return descriptors;
 }
 
 void QLocalSocketPrivate::_q_abortConnectionAttempt()
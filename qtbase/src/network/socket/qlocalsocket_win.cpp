@@ -451,4 +451,15 @@ bool QLocalSocket::waitForBytesWritten(int msecs)
     return d->pipeWriter->waitForWrite(msecs);
 }
 
+bool QLocalSocket::writeWithDescriptors(const QByteArray &, const QVector<qintptr> &)
+{
+    // handles are duplicated into other processes with DuplicateHandle() instead
+    return false;
+}
+
+QVector<qintptr> QLocalSocket::takeReceivedDescriptors()
+{
+    return QVector<qintptr>();
+}
+
 QT_END_NAMESPACE
@@ -194,6 +194,9 @@ QNativeSocketEnginePrivate::QNativeSocketEnginePrivate() :
     readNotifier(0),
     writeNotifier(0),
     exceptNotifier(0)
+#ifndef Q_OS_WIN
+    , passDescriptors(false)
+#endif
 {
 #if defined(Q_OS_WIN) && !defined(Q_OS_WINRT)
     QSysInfo::machineHostName();        // this initializes ws2_32.dll
@@ -902,6 +905,64 @@ qint64 QNativeSocketEngine::writeDatagram(const char *data, qint64 size, const Q
     return d->nativeSendDatagram(data, size, header);
 }
 
+/*!
+    \since 5.11
+
+    Reads up to \a count datagrams from the socket, the i-th into \a data[i],
+    which must have room for \a maxSize bytes. The size of each datagram is
+    stored in \a lengths, and the address, port and other IP header fields in
+    \a headers according to the request in \a options.
+
+    Where the operating system supports it, all datagrams are read with a
+    single system call. Datagrams longer than \a maxSize are truncated.
+
+    Returns the number of datagrams read, which is less than \a count if no
+    more were pending, or -1 if an error occurred before any was read.
+
+    \sa readDatagram(), writeDatagrams()
+*/
+int QNativeSocketEngine::readDatagrams(int count, char *const *data, qint64 maxSize,
+                                       qint64 *lengths, QIpPacketHeader *headers,
+                                       PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+    if (count <= 0)
+        return 0;
+    return d->nativeReceiveDatagrams(count, data, maxSize, lengths, headers, options);
+}
+
+/*!
+    \since 5.11
+
+    Writes \a count datagrams to the socket, the i-th of size \a lengths[i]
+    from \a data[i] to the destination contained in \a headers[i].
+
+    Where the operating system supports it, all datagrams are passed to it
+    with a single system call.
+
+    Returns the number of datagrams written, which can be less than \a count
+    if the socket's send buffer is full, or -1 if an error occurred before any
+    was written.
+
+    \sa writeDatagram(), readDatagrams()
+*/
+int QNativeSocketEngine::writeDatagrams(int count, const char *const *data, const qint64 *lengths,
+                                        const QIpPacketHeader *headers)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+    if (count <= 0)
+        return 0;
+    return d->nativeSendDatagrams(count, data, lengths, headers);
+}
+
 /*!
     Writes a block of \a size bytes from \a data to the socket.
     Returns the number of bytes written, or -1 if an error occurred.
@@ -918,6 +979,37 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+#ifndef Q_OS_WIN
+/*!
+    Writes a block of \a size bytes from \a data to the socket, passing
+    \a descriptors along with it. The receiving socket needs to have
+    PassDescriptorsOption set. The descriptors are only sent if at least one
+    byte was written. Returns the number of bytes written, or -1 if an error
+    occurred.
+*/
+qint64 QNativeSocketEngine::writeWithDescriptors(const char *data, qint64 size,
+                                                 const QVector<int> &descriptors)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeWithDescriptors(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeWithDescriptors(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteWithDescriptors(data, size, descriptors);
+}
+
+/*!
+    Returns the descriptors received so far while PassDescriptorsOption was
+    set, in the order they arrived. The caller becomes responsible for
+    closing them; descriptors that are not taken are closed with the socket.
+*/
+QVector<int> QNativeSocketEngine::takeReceivedDescriptors()
+{
+    Q_D(QNativeSocketEngine);
+    QVector<int> descriptors;
+    descriptors.swap(d->receivedDescriptors);
+    return descriptors;
+}
+#endif
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
@@ -56,8 +56,11 @@
 #include "QtNetwork/qhostaddress.h"
 #include "QtNetwork/qnetworkinterface.h"
 #include "private/qabstractsocketengine_p.h"
+#include "QtCore/qvector.h"
 #ifndef Q_OS_WIN
 #  include "qplatformdefs.h"
+#  include <sys/socket.h>
+#  include <sys/uio.h>
 #  include <netinet/in.h>
 #else
 #  include <winsock2.h>
@@ -164,8 +167,18 @@ public:
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = 0,
                         PacketHeaderOptions = WantNone) Q_DECL_OVERRIDE;
     qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &) Q_DECL_OVERRIDE;
+    int readDatagrams(int count, char *const *data, qint64 maxlen, qint64 *lengths,
+                      QIpPacketHeader *headers = 0, PacketHeaderOptions = WantNone) Q_DECL_OVERRIDE;
+    int writeDatagrams(int count, const char *const *data, const qint64 *lengths,
+                       const QIpPacketHeader *headers) Q_DECL_OVERRIDE;
     qint64 bytesToWrite() const Q_DECL_OVERRIDE;
 
+#ifndef Q_OS_WIN
+    // SCM_RIGHTS passing on local sockets, see PassDescriptorsOption
+    qint64 writeWithDescriptors(const char *data, qint64 len, const QVector<int> &descriptors);
+    QVector<int> takeReceivedDescriptors();
+#endif
+
 #if 0   // currently unused
     qint64 receiveBufferSize() const;
     void setReceiveBufferSize(qint64 bufferSize);
@@ -277,8 +290,29 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+    int nativeReceiveDatagrams(int count, char *const *data, qint64 maxLength, qint64 *lengths,
+                               QIpPacketHeader *headers, QAbstractSocketEngine::PacketHeaderOptions options);
+    int nativeSendDatagrams(int count, const char *const *data, const qint64 *lengths,
+                            const QIpPacketHeader *headers);
+#ifndef Q_OS_WIN
+    // helpers shared by the single and the batched datagram functions
+    void parseDatagramHeader(msghdr *msg, const qt_sockaddr *aa, QIpPacketHeader *header) const;
+    void prepareSendMessage(msghdr *msg, iovec *vec, qt_sockaddr *aa, quintptr *cbuf,
+                            const char *data, qint64 len, const QIpPacketHeader &header);
+    qint64 receiveDatagramError();
+    qint64 sendDatagramError();
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#ifndef Q_OS_WIN
+    qint64 nativeReadWithDescriptors(char *data, qint64 maxLength);
+    qint64 nativeWriteWithDescriptors(const char *data, qint64 length, const QVector<int> &descriptors);
+    void closeReceivedDescriptors();
+
+    // descriptors received with the data, for the user to take
+    QVector<int> receivedDescriptors;
+    bool passDescriptors;
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
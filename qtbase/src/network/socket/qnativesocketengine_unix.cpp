@@ -150,8 +150,15 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
     case QNativeSocketEngine::NonBlockingSocketOption:  // fcntl, not setsockopt
     case QNativeSocketEngine::BindExclusively:          // not handled on Unix
     case QNativeSocketEngine::MaxStreamsSocketOption:
+    case QNativeSocketEngine::PassDescriptorsOption:    // not a socket option
         Q_UNREACHABLE();
 
+    case QNativeSocketEngine::ReusePortOption:
+#ifdef SO_REUSEPORT
+        n = SO_REUSEPORT;
+#endif
+        break;
+
     case QNativeSocketEngine::BroadcastSocketOption:
         n = SO_BROADCAST;
         break;
@@ -320,6 +327,12 @@ int QNativeSocketEnginePrivate::option(QNativeSocketEngine::SocketOption opt) co
     case QNativeSocketEngine::NonBlockingSocketOption:
     case QNativeSocketEngine::BroadcastSocketOption:
         return -1;
+    case QNativeSocketEngine::PassDescriptorsOption:
+        return passDescriptors ? 1 : 0;
+#ifndef SO_REUSEPORT
+    case QNativeSocketEngine::ReusePortOption:
+        return -1;
+#endif
     case QNativeSocketEngine::MaxStreamsSocketOption: {
 #ifndef QT_NO_SCTP
         sctp_initmsg sctpInitMsg;
@@ -390,6 +403,15 @@ bool QNativeSocketEnginePrivate::setOption(QNativeSocketEngine::SocketOption opt
     case QNativeSocketEngine::BindExclusively:
         return true;
 
+    case QNativeSocketEngine::PassDescriptorsOption:
+        passDescriptors = v != 0;
+        return true;
+
+#ifndef SO_REUSEPORT
+    case QNativeSocketEngine::ReusePortOption:
+        return false;
+#endif
+
     case QNativeSocketEngine::MaxStreamsSocketOption: {
 #ifndef QT_NO_SCTP
         sctp_initmsg sctpInitMsg;
@@ -905,11 +927,11 @@ qint64 QNativeSocketEnginePrivate::nativePendingDatagramSize() const
     return qint64(recvResult);
 }
 
-qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
-                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+namespace {
+// we use quintptr to force the alignment
+struct ReceiveControlBuffer
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+    quintptr data[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
 #if !defined(IP_PKTINFO) && defined(IP_RECVIF) && defined(Q_OS_BSD4)
                    + CMSG_SPACE(sizeof(sockaddr_dl))
 #endif
@@ -917,113 +939,161 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
                    + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
 #endif
                    + sizeof(quintptr) - 1) / sizeof(quintptr)];
+};
 
-    struct msghdr msg;
-    struct iovec vec;
-    qt_sockaddr aa;
-    char c;
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
+struct SendControlBuffer
+{
+    quintptr data[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+#ifndef QT_NO_SCTP
+                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
+#endif
+                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
+};
+
+const QAbstractSocketEngine::PacketHeaderOptions controlMessageOptions =
+        QAbstractSocketEngine::WantDatagramHopLimit | QAbstractSocketEngine::WantDatagramDestination
+        | QAbstractSocketEngine::WantStreamNumber;
+}
+
+/*! \internal
+    Prepares \a msg for receiving a datagram into \a data of \a maxSize bytes, with the
+    sender's address in \a aa and the ancillary data in \a cbuf as requested by \a options.
+    \a dummy is used when the caller is not interested in the contents.
+ */
+static void qt_prepareReceiveMessage(msghdr *msg, iovec *vec, qt_sockaddr *aa, ReceiveControlBuffer *cbuf,
+                                     char *data, qint64 maxSize, char *dummy,
+                                     QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    memset(msg, 0, sizeof(*msg));
+    memset(aa, 0, sizeof(*aa));
 
     // we need to receive at least one byte, even if our user isn't interested in it
-    vec.iov_base = maxSize ? data : &c;
-    vec.iov_len = maxSize ? maxSize : 1;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
+    vec->iov_base = maxSize ? data : dummy;
+    vec->iov_len = maxSize ? maxSize : 1;
+    msg->msg_iov = vec;
+    msg->msg_iovlen = 1;
     if (options & QAbstractSocketEngine::WantDatagramSender) {
-        msg.msg_name = &aa;
-        msg.msg_namelen = sizeof(aa);
+        msg->msg_name = aa;
+        msg->msg_namelen = sizeof(*aa);
     }
-    if (options & (QAbstractSocketEngine::WantDatagramHopLimit | QAbstractSocketEngine::WantDatagramDestination
-                   | QAbstractSocketEngine::WantStreamNumber)) {
-        msg.msg_control = cbuf;
-        msg.msg_controllen = sizeof(cbuf);
+    if (options & controlMessageOptions) {
+        msg->msg_control = cbuf->data;
+        msg->msg_controllen = sizeof(cbuf->data);
     }
+}
 
-    ssize_t recvResult = 0;
-    do {
-        recvResult = ::recvmsg(socketDescriptor, &msg, 0);
-    } while (recvResult == -1 && errno == EINTR);
-
-    if (recvResult == -1) {
-        switch (errno) {
-#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
-#endif
-        case EAGAIN:
-            // No datagram was available for reading
-            recvResult = -2;
-            break;
-        case ECONNREFUSED:
-            setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
+/*! \internal
+    Fills \a header from the sender's address in \a aa and the ancillary data of \a msg.
+ */
+void QNativeSocketEnginePrivate::parseDatagramHeader(msghdr *msg, const qt_sockaddr *aa,
+                                                     QIpPacketHeader *header) const
+{
+    qt_socket_getPortAndAddress(aa, &header->senderPort, &header->senderAddress);
+    header->destinationPort = localPort;
+    header->endOfRecord = (msg->msg_flags & MSG_EOR) != 0;
+
+    // parse the ancillary data
+    struct cmsghdr *cmsgptr;
+    for (cmsgptr = CMSG_FIRSTHDR(msg); cmsgptr != NULL;
+         cmsgptr = CMSG_NXTHDR(msg, cmsgptr)) {
+        if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
+            in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
+            header->ifindex = info->ipi6_ifindex;
+            if (header->ifindex)
+                header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
         }
-        if (header)
-            header->clear();
-    } else if (options != QAbstractSocketEngine::WantNone) {
-        Q_ASSERT(header);
-        qt_socket_getPortAndAddress(&aa, &header->senderPort, &header->senderAddress);
-        header->destinationPort = localPort;
-        header->endOfRecord = (msg.msg_flags & MSG_EOR) != 0;
-
-        // parse the ancillary data
-        struct cmsghdr *cmsgptr;
-        for (cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != NULL;
-             cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
-            if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
-                in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
-                header->ifindex = info->ipi6_ifindex;
-                if (header->ifindex)
-                    header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
-            }
 
 #ifdef IP_PKTINFO
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
-                in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
+            in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
 
-                header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
-                header->ifindex = info->ipi_ifindex;
-            }
+            header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
+            header->ifindex = info->ipi_ifindex;
+        }
 #else
 #  ifdef IP_RECVDSTADDR
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
-                in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
+            in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
 
-                header->destinationAddress.setAddress(ntohl(addr->s_addr));
-            }
+            header->destinationAddress.setAddress(ntohl(addr->s_addr));
+        }
 #  endif
 #  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
-                sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
-                header->ifindex = sdl->sdl_index;
-            }
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
+            sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
+            header->ifindex = sdl->sdl_index;
+        }
 #  endif
 #endif
 
-            if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
-                    && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
-                        || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
-                Q_STATIC_ASSERT(sizeof(header->hopLimit) == sizeof(int));
-                memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
-            }
+        if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
+                && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
+                    || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
+            Q_STATIC_ASSERT(sizeof(header->hopLimit) == sizeof(int));
+            memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
+        }
 
 #ifndef QT_NO_SCTP
-            if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
-                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
-                sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
+            && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
+            sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
 
-                header->streamNumber = int(rcvInfo->sinfo_stream);
-            }
-#endif
+            header->streamNumber = int(rcvInfo->sinfo_stream);
         }
+#endif
+    }
+}
+
+/*! \internal
+    Sets the error matching errno after receiving a datagram failed. Returns -2 if
+    there simply was no datagram to read, -1 otherwise.
+ */
+qint64 QNativeSocketEnginePrivate::receiveDatagramError()
+{
+    switch (errno) {
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+    case EAGAIN:
+        // No datagram was available for reading
+        return -2;
+    case ECONNREFUSED:
+        setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
+        break;
+    default:
+        setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
+    }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
+                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    ReceiveControlBuffer cbuf;
+    struct msghdr msg;
+    struct iovec vec;
+    qt_sockaddr aa;
+    char c;
+    qt_prepareReceiveMessage(&msg, &vec, &aa, &cbuf, data, maxSize, &c, options);
+
+    ssize_t recvResult = 0;
+    do {
+        recvResult = ::recvmsg(socketDescriptor, &msg, 0);
+    } while (recvResult == -1 && errno == EINTR);
+
+    if (recvResult == -1) {
+        recvResult = receiveDatagramError();
+        if (header)
+            header->clear();
+    } else if (options != QAbstractSocketEngine::WantNone) {
+        Q_ASSERT(header);
+        parseDatagramHeader(&msg, &aa, header);
     }
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
@@ -1038,37 +1108,82 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
     return qint64((maxSize || recvResult < 0) ? recvResult : Q_INT64_C(0));
 }
 
-qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+int QNativeSocketEnginePrivate::nativeReceiveDatagrams(int count, char *const *data, qint64 maxSize,
+                                                       qint64 *lengths, QIpPacketHeader *headers,
+                                                       QAbstractSocketEngine::PacketHeaderOptions options)
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
-#ifndef QT_NO_SCTP
-                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
+#ifdef QT_HAVE_MMSG
+    QVarLengthArray<mmsghdr, 32> msgs(count);
+    QVarLengthArray<iovec, 32> vecs(count);
+    QVarLengthArray<qt_sockaddr, 32> addresses(count);
+    QVarLengthArray<ReceiveControlBuffer, 32> cbufs((options & controlMessageOptions) ? count : 0);
+    char c;
+    for (int i = 0; i < count; ++i) {
+        qt_prepareReceiveMessage(&msgs[i].msg_hdr, &vecs[i], &addresses[i],
+                                 cbufs.isEmpty() ? 0 : &cbufs[i], data[i], maxSize, &c, options);
+        msgs[i].msg_len = 0;
+    }
+
+    const int received = qt_safe_recvmmsg(socketDescriptor, msgs.data(), count, 0);
+    if (received == -1)
+        return int(receiveDatagramError());
+
+    for (int i = 0; i < received; ++i) {
+        lengths[i] = maxSize ? qint64(msgs[i].msg_len) : Q_INT64_C(0);
+        if (options != QAbstractSocketEngine::WantNone) {
+            Q_ASSERT(headers);
+            parseDatagramHeader(&msgs[i].msg_hdr, &addresses[i], &headers[i]);
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeReceiveDatagrams(%i, %lli) == %i",
+           count, maxSize, received);
 #endif
-                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
 
+    return received;
+#else
+    int received = 0;
+    for ( ; received < count; ++received) {
+        if (received && !nativeHasPendingDatagrams())
+            break;
+        const qint64 result = nativeReceiveDatagram(data[received], maxSize,
+                                                    headers ? &headers[received] : 0, options);
+        if (result < 0)
+            return received ? received : int(result);
+        lengths[received] = result;
+    }
+    return received;
+#endif
+}
+
+/*! \internal
+    Prepares \a msg for sending \a len bytes from \a data with the destination and
+    other settings of \a header, using \a aa and \a cbuf for storage.
+ */
+void QNativeSocketEnginePrivate::prepareSendMessage(msghdr *msg, iovec *vec, qt_sockaddr *aa,
+                                                    quintptr *cbuf, const char *data,
+                                                    qint64 len, const QIpPacketHeader &header)
+{
     struct cmsghdr *cmsgptr = reinterpret_cast<struct cmsghdr *>(cbuf);
-    struct msghdr msg;
-    struct iovec vec;
-    qt_sockaddr aa;
 
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
-    vec.iov_base = const_cast<char *>(data);
-    vec.iov_len = len;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
-    msg.msg_control = &cbuf;
+    memset(msg, 0, sizeof(*msg));
+    memset(aa, 0, sizeof(*aa));
+    vec->iov_base = const_cast<char *>(data);
+    vec->iov_len = len;
+    msg->msg_iov = vec;
+    msg->msg_iovlen = 1;
+    msg->msg_control = cbuf;
 
     if (header.destinationPort != 0) {
-        msg.msg_name = &aa.a;
+        msg->msg_name = &aa->a;
         setPortAndAddress(header.destinationPort, header.destinationAddress,
-                          &aa, &msg.msg_namelen);
+                          aa, &msg->msg_namelen);
     }
 
-    if (msg.msg_namelen == sizeof(aa.a6)) {
+    if (msg->msg_namelen == sizeof(aa->a6)) {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_HOPLIMIT;
@@ -1078,7 +1193,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         if (header.ifindex != 0 || !header.senderAddress.isNull()) {
             struct in6_pktinfo *data = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
             memset(data, 0, sizeof(*data));
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_PKTINFO;
@@ -1090,7 +1205,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         }
     } else {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IP;
             cmsgptr->cmsg_type = IP_TTL;
@@ -1112,7 +1227,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
             data->s_addr = htonl(header.senderAddress.toIPv4Address());
 #  endif
             cmsgptr->cmsg_level = IPPROTO_IP;
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr = reinterpret_cast<cmsghdr *>(reinterpret_cast<char *>(cmsgptr) + CMSG_SPACE(sizeof(*data)));
         }
@@ -1123,7 +1238,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     if (header.streamNumber != -1) {
         struct sctp_sndrcvinfo *data = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
         memset(data, 0, sizeof(*data));
-        msg.msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
+        msg->msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_len = CMSG_LEN(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_level = IPPROTO_SCTP;
         cmsgptr->cmsg_type =  SCTP_SNDRCV;
@@ -1132,28 +1247,45 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     }
 #endif
 
-    if (msg.msg_controllen == 0)
-        msg.msg_control = 0;
-    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (msg->msg_controllen == 0)
+        msg->msg_control = 0;
+}
 
-    if (sentBytes < 0) {
-        switch (errno) {
+/*! \internal
+    Sets the error matching errno after sending a datagram failed. Returns -2 if
+    the operation would have blocked, -1 otherwise.
+ */
+qint64 QNativeSocketEnginePrivate::sendDatagramError()
+{
+    switch (errno) {
 #if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
+    case EWOULDBLOCK:
 #endif
-        case EAGAIN:
-            sentBytes = -2;
-            break;
-        case EMSGSIZE:
-            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
-            break;
-        case ECONNRESET:
-            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, SendDatagramErrorString);
-        }
+    case EAGAIN:
+        return -2;
+    case EMSGSIZE:
+        setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+        break;
+    case ECONNRESET:
+        setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+        break;
+    default:
+        setError(QAbstractSocket::NetworkError, SendDatagramErrorString);
     }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+{
+    SendControlBuffer cbuf;
+    struct msghdr msg;
+    struct iovec vec;
+    qt_sockaddr aa;
+    prepareSendMessage(&msg, &vec, &aa, cbuf.data, data, len, header);
+
+    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (sentBytes < 0)
+        sentBytes = sendDatagramError();
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
     qDebug("QNativeSocketEngine::sendDatagram(%p \"%s\", %lli, \"%s\", %i) == %lli", data,
@@ -1165,6 +1297,39 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     return qint64(sentBytes);
 }
 
+int QNativeSocketEnginePrivate::nativeSendDatagrams(int count, const char *const *data, const qint64 *lengths,
+                                                    const QIpPacketHeader *headers)
+{
+#ifdef QT_HAVE_MMSG
+    QVarLengthArray<mmsghdr, 32> msgs(count);
+    QVarLengthArray<iovec, 32> vecs(count);
+    QVarLengthArray<qt_sockaddr, 32> addresses(count);
+    QVarLengthArray<SendControlBuffer, 32> cbufs(count);
+    for (int i = 0; i < count; ++i) {
+        prepareSendMessage(&msgs[i].msg_hdr, &vecs[i], &addresses[i], cbufs[i].data,
+                           data[i], lengths[i], headers[i]);
+        msgs[i].msg_len = 0;
+    }
+
+    // sendmmsg() reports an error only if the first datagram could not be sent
+    const int sent = qt_safe_sendmmsg(socketDescriptor, msgs.data(), count, 0);
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEngine::sendDatagrams(%i) == %i", count, sent);
+#endif
+
+    return sent < 0 ? int(sendDatagramError()) : sent;
+#else
+    int sent = 0;
+    for ( ; sent < count; ++sent) {
+        const qint64 result = nativeSendDatagram(data[sent], lengths[sent], headers[sent]);
+        if (result < 0)
+            return sent ? sent : int(result);
+    }
+    return sent;
+#endif
+}
+
 bool QNativeSocketEnginePrivate::fetchConnectionParameters()
 {
     localPort = 0;
@@ -1294,6 +1459,7 @@ void QNativeSocketEnginePrivate::nativeClose()
 #endif
 
     qt_safe_close(socketDescriptor);
+    closeReceivedDescriptors();
 }
 
 qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
@@ -1341,7 +1507,10 @@ qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
     }
 
     ssize_t r = 0;
-    r = qt_safe_read(socketDescriptor, data, maxSize);
+    if (passDescriptors)
+        r = nativeReadWithDescriptors(data, maxSize);
+    else
+        r = qt_safe_read(socketDescriptor, data, maxSize);
 
     if (r < 0) {
         r = -1;
@@ -1378,6 +1547,120 @@ qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
     return qint64(r);
 }
 
+// the most descriptors taken from a single message, more are closed by the kernel
+static const int MaxPassedDescriptors = 64;
+
+/*
+    Like qt_safe_read(), but collects the descriptors passed with SCM_RIGHTS
+    into receivedDescriptors.
+*/
+qint64 QNativeSocketEnginePrivate::nativeReadWithDescriptors(char *data, qint64 maxSize)
+{
+    iovec vec;
+    vec.iov_base = data;
+    vec.iov_len = maxSize;
+
+    union {
+        cmsghdr align;
+        char buffer[CMSG_SPACE(sizeof(int) * MaxPassedDescriptors)];
+    } control;
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = sizeof(control.buffer);
+
+    int flags = 0;
+#ifdef MSG_CMSG_CLOEXEC
+    flags |= MSG_CMSG_CLOEXEC;
+#endif
+    const int r = qt_safe_recvmsg(socketDescriptor, &msg, flags);
+    if (r < 0)
+        return r;
+
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+            continue;
+        const int count = int((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+        const uchar *fds = CMSG_DATA(cmsg);
+        for (int i = 0; i < count; ++i) {
+            int fd;
+            memcpy(&fd, fds + i * sizeof(int), sizeof(int));
+#ifndef MSG_CMSG_CLOEXEC
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+#endif
+            receivedDescriptors.append(fd);
+        }
+    }
+    if (msg.msg_flags & MSG_CTRUNC)
+        qWarning("QNativeSocketEngine: more than %d descriptors were passed at once, "
+                 "the rest were discarded", MaxPassedDescriptors);
+    return r;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeWriteWithDescriptors(const char *data, qint64 len,
+                                                              const QVector<int> &descriptors)
+{
+    Q_Q(QNativeSocketEngine);
+
+    if (descriptors.size() > MaxPassedDescriptors) {
+        setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+        return -1;
+    }
+
+    iovec vec;
+    vec.iov_base = const_cast<char *>(data);
+    vec.iov_len = len;
+
+    union {
+        cmsghdr align;
+        char buffer[CMSG_SPACE(sizeof(int) * MaxPassedDescriptors)];
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+    if (!descriptors.isEmpty()) {
+        msg.msg_control = control.buffer;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * descriptors.size());
+        cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * descriptors.size());
+        memcpy(CMSG_DATA(cmsg), descriptors.constData(), sizeof(int) * descriptors.size());
+    }
+
+    qint64 writtenBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        default:
+            setError(QAbstractSocket::NetworkError, WriteErrorString);
+            break;
+        }
+    }
+    return writtenBytes;
+}
+
+void QNativeSocketEnginePrivate::closeReceivedDescriptors()
+{
+    for (int fd : qAsConst(receivedDescriptors))
+        qt_safe_close(fd);
+    receivedDescriptors.clear();
+}
+
 int QNativeSocketEnginePrivate::nativeSelect(int timeout, bool selectForRead) const
 {
     bool dummy;
@@ -216,6 +216,8 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
     case QNativeSocketEngine::NonBlockingSocketOption:      // WSAIoctl
     case QNativeSocketEngine::TypeOfServiceOption:          // not supported
     case QNativeSocketEngine::MaxStreamsSocketOption:
+    case QNativeSocketEngine::ReusePortOption:              // no kernel load balancing
+    case QNativeSocketEngine::PassDescriptorsOption:        // Unix only
         Q_UNREACHABLE();
 
     case QNativeSocketEngine::ReceiveBufferSocketOption:
@@ -457,6 +459,8 @@ int QNativeSocketEnginePrivate::option(QNativeSocketEngine::SocketOption opt) co
     }
     case QNativeSocketEngine::TypeOfServiceOption:
     case QNativeSocketEngine::MaxStreamsSocketOption:
+    case QNativeSocketEngine::ReusePortOption:
+    case QNativeSocketEngine::PassDescriptorsOption:
         return -1;
 
     default:
@@ -508,6 +512,8 @@ bool QNativeSocketEnginePrivate::setOption(QNativeSocketEngine::SocketOption opt
         }
     case QNativeSocketEngine::TypeOfServiceOption:
     case QNativeSocketEngine::MaxStreamsSocketOption:
+    case QNativeSocketEngine::ReusePortOption:
+    case QNativeSocketEngine::PassDescriptorsOption:
         return false;
 
     default:
@@ -1430,6 +1436,36 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     return ret;
 }
 
+int QNativeSocketEnginePrivate::nativeReceiveDatagrams(int count, char *const *data, qint64 maxSize,
+                                                       qint64 *lengths, QIpPacketHeader *headers,
+                                                       QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    // Windows has no call to receive several datagrams at once
+    int received = 0;
+    for ( ; received < count; ++received) {
+        if (received && !nativeHasPendingDatagrams())
+            break;
+        const qint64 result = nativeReceiveDatagram(data[received], maxSize,
+                                                    headers ? &headers[received] : 0, options);
+        if (result < 0)
+            return received ? received : int(result);
+        lengths[received] = result;
+    }
+    return received;
+}
+
+int QNativeSocketEnginePrivate::nativeSendDatagrams(int count, const char *const *data, const qint64 *lengths,
+                                                    const QIpPacketHeader *headers)
+{
+    int sent = 0;
+    for ( ; sent < count; ++sent) {
+        const qint64 result = nativeSendDatagram(data[sent], lengths[sent], headers[sent]);
+        if (result < 0)
+            return sent ? sent : int(result);
+    }
+    return sent;
+}
+
 
 qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 {
@@ -1514,6 +1514,8 @@ int QNativeSocketEnginePrivate::option(QAbstractSocketEngine::SocketOption opt)
     case QAbstractSocketEngine::MulticastLoopbackOption:
     case QAbstractSocketEngine::TypeOfServiceOption:
     case QAbstractSocketEngine::MaxStreamsSocketOption:
+    case QAbstractSocketEngine::ReusePortOption:
+    case QAbstractSocketEngine::PassDescriptorsOption:
     default:
         return -1;
     }
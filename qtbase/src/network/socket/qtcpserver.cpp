@@ -77,6 +77,14 @@
     use waitForNewConnection(), which blocks until either a
     connection is available or a timeout expires.
 
+    A server that has to accept a lot of connections can spread that work
+    over several threads with setListenerCount(). The server then opens
+    additional sockets on the same address and port with \c SO_REUSEPORT,
+    each owned by a thread of its own, and the operating system balances
+    incoming connections between them. Connections accepted by those
+    threads are passed to incomingListenerConnection() in the accepting
+    thread.
+
     \sa QTcpSocket, {Fortune Server Example}, {Threaded Fortune Server Example},
         {Loopback Example}, {Torrent Example}
 */
@@ -104,9 +112,11 @@
 #include "qhostaddress.h"
 #include "qlist.h"
 #include "qpointer.h"
+#include "qscopedpointer.h"
 #include "qabstractsocketengine_p.h"
 #include "qtcpsocket.h"
 #include "qnetworkproxy.h"
+#include "qthread.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -124,6 +134,7 @@ QTcpServerPrivate::QTcpServerPrivate()
  , socketEngine(0)
  , serverSocketError(QAbstractSocket::UnknownSocketError)
  , maxConnections(30)
+ , listenerCount(1)
 {
 }
 
@@ -227,6 +238,168 @@ void QTcpServerPrivate::readNotification()
     }
 }
 
+/*! \internal
+
+    Accepts connections on one of the additional listening sockets, in the
+    thread it was moved to.
+*/
+class QTcpServerListener : public QObject, public QAbstractSocketEngineReceiver
+{
+public:
+    explicit QTcpServerListener(QTcpServerPrivate *server)
+        : server(server), socketEngine(0), workerThread(0)
+    {
+    }
+
+    QTcpServerPrivate *server;
+    QAbstractSocketEngine *socketEngine;
+    QThread *workerThread;
+
+    // from QAbstractSocketEngineReceiver
+    void readNotification() Q_DECL_OVERRIDE
+    {
+        for (;;) {
+            int descriptor = socketEngine->accept();
+            if (descriptor == -1) {
+                if (socketEngine->error() != QAbstractSocket::TemporaryError) {
+                    socketEngine->setReadNotificationEnabled(false);
+                    server->listenerError(socketEngine->error(), socketEngine->errorString());
+                }
+                break;
+            }
+#if defined (QTCPSERVER_DEBUG)
+            qDebug("QTcpServerListener::readNotification() accepted socket %i", descriptor);
+#endif
+            server->listenerConnection(descriptor);
+        }
+    }
+    void closeNotification() Q_DECL_OVERRIDE { readNotification(); }
+    void writeNotification() Q_DECL_OVERRIDE {}
+    void exceptionNotification() Q_DECL_OVERRIDE {}
+    void connectionNotification() Q_DECL_OVERRIDE {}
+#ifndef QT_NO_NETWORKPROXY
+    void proxyAuthenticationRequired(const QNetworkProxy &, QAuthenticator *) Q_DECL_OVERRIDE {}
+#endif
+};
+
+/*! \internal
+
+    Opens the listenerCount - 1 additional sockets on the address and port
+    the server socket is bound to. Gives up, keeping the listeners already
+    started, if one of them cannot be set up.
+*/
+void QTcpServerPrivate::startListeners(const QNetworkProxy &proxy)
+{
+    Q_Q(QTcpServer);
+    for (int i = 1; i < listenerCount; ++i) {
+        QScopedPointer<QTcpServerListener> listener(new QTcpServerListener(this));
+        QAbstractSocketEngine *engine = QAbstractSocketEngine::createSocketEngine(socketType, proxy,
+                                                                                listener.data());
+        if (!engine)
+            break;
+#ifndef QT_NO_BEARERMANAGEMENT
+        engine->setProperty("_q_networksession", q->property("_q_networksession"));
+#endif
+        if (!engine->initialize(socketType, socketEngine->protocol())) {
+            qWarning("QTcpServer::listen() could only start %d of %d listeners: %s",
+                     i, listenerCount, qPrintable(engine->errorString()));
+            break;
+        }
+#if defined(Q_OS_UNIX)
+        // see configureCreatedSocket()
+        engine->setOption(QAbstractSocketEngine::AddressReusable, 1);
+#endif
+        if (!engine->setOption(QAbstractSocketEngine::ReusePortOption, 1)
+            || !engine->bind(address, port)
+            || !engine->listen()) {
+            qWarning("QTcpServer::listen() could only start %d of %d listeners: %s",
+                     i, listenerCount, qPrintable(engine->errorString()));
+            break;
+        }
+        engine->setReceiver(listener.data());
+        listener->socketEngine = engine;
+
+        QThread *thread = new QThread;
+        thread->setObjectName(QStringLiteral("QTcpServer listener"));
+        listener->workerThread = thread;
+        listener->moveToThread(thread);
+        // deleted in its own thread, where its socket notifier lives
+        QObject::connect(thread, &QThread::finished, listener.data(), &QObject::deleteLater);
+        listeners.append(listener.take());
+        thread->start();
+    }
+    setListenersAccepting(true);
+}
+
+/*! \internal
+*/
+void QTcpServerPrivate::stopListeners()
+{
+    for (QTcpServerListener *listener : qAsConst(listeners)) {
+        QThread *thread = listener->workerThread;
+        thread->quit();
+        thread->wait();
+        delete thread;
+    }
+    listeners.clear();
+}
+
+/*! \internal
+*/
+void QTcpServerPrivate::setListenersAccepting(bool accepting)
+{
+    for (QTcpServerListener *listener : qAsConst(listeners)) {
+        QMetaObject::invokeMethod(listener, [listener, accepting]() {
+            listener->socketEngine->setReadNotificationEnabled(accepting);
+        }, Qt::QueuedConnection);
+    }
+}
+
+/*! \internal
+
+    Called in a listener's thread for every connection it accepted.
+*/
+void QTcpServerPrivate::listenerConnection(qintptr socketDescriptor)
+{
+    Q_Q(QTcpServer);
+    q->incomingListenerConnection(socketDescriptor);
+}
+
+/*! \internal
+
+    Called in a listener's thread when accepting failed, reports the error in
+    the server's thread.
+*/
+void QTcpServerPrivate::listenerError(QAbstractSocket::SocketError error,
+                                      const QString &errorString)
+{
+    Q_Q(QTcpServer);
+    QMetaObject::invokeMethod(q, [this, error, errorString]() {
+        Q_Q(QTcpServer);
+        serverSocketError = error;
+        serverSocketErrorString = errorString;
+        emit q->acceptError(error);
+    }, Qt::QueuedConnection);
+}
+
+/*! \internal
+
+    Hands a connection accepted by a listener to incomingConnection(), as if
+    the server socket had accepted it.
+*/
+void QTcpServerPrivate::dispatchListenerConnection(qintptr socketDescriptor)
+{
+    Q_Q(QTcpServer);
+    if (!q->isListening()) {
+        // closed in the meantime, this closes the descriptor
+        QTcpSocket socket;
+        socket.setSocketDescriptor(socketDescriptor);
+        return;
+    }
+    q->incomingConnection(socketDescriptor);
+    emit q->newConnection();
+}
+
 /*!
     Constructs a QTcpServer object.
 
@@ -329,6 +502,12 @@ bool QTcpServer::listen(const QHostAddress &address, quint16 port)
 
     d->configureCreatedSocket();
 
+    // the additional listeners can only share the port if we do so as well
+    const bool startListeners = d->listenerCount > 1
+            && d->socketEngine->setOption(QAbstractSocketEngine::ReusePortOption, 1);
+    if (d->listenerCount > 1 && !startListeners)
+        qWarning("QTcpServer::listen() SO_REUSEPORT is not available, using a single listener");
+
     if (!d->socketEngine->bind(addr, port)) {
         d->serverSocketError = d->socketEngine->error();
         d->serverSocketErrorString = d->socketEngine->errorString();
@@ -348,6 +527,9 @@ bool QTcpServer::listen(const QHostAddress &address, quint16 port)
     d->address = d->socketEngine->localAddress();
     d->port = d->socketEngine->localPort();
 
+    if (startListeners)
+        d->startListeners(proxy);
+
 #if defined (QTCPSERVER_DEBUG)
     qDebug("QTcpServer::listen(%i, \"%s\") == true (listening on port %i)", port,
            address.toString().toLatin1().constData(), d->socketEngine->localPort());
@@ -378,6 +560,8 @@ void QTcpServer::close()
 {
     Q_D(QTcpServer);
 
+    d->stopListeners();
+
     qDeleteAll(d->pendingConnections);
     d->pendingConnections.clear();
 
@@ -610,6 +794,37 @@ void QTcpServer::incomingConnection(qintptr socketDescriptor)
     addPendingConnection(socket);
 }
 
+/*!
+    \since 5.11
+
+    This virtual function is called by QTcpServer when one of the
+    additional listeners started because of setListenerCount() has
+    accepted a connection. It is called in the listener's own thread, not
+    in the thread of the server. The \a socketDescriptor argument is the
+    native socket descriptor for the accepted connection.
+
+    The base implementation calls incomingConnection() with \a
+    socketDescriptor in the server's thread and emits newConnection()
+    afterwards, so servers that only reimplement incomingConnection() get
+    all connections there.
+
+    Reimplement this function to create the QTcpSocket for the connection
+    directly in the accepting thread, saving the round trip through the
+    server's event loop. Such sockets do not take part in the Pending
+    Connections mechanism, and maxPendingConnections() does not apply to
+    them. The reimplementation must be thread-safe, as all listeners call
+    it concurrently.
+
+    \sa setListenerCount(), incomingConnection()
+*/
+void QTcpServer::incomingListenerConnection(qintptr socketDescriptor)
+{
+    Q_D(QTcpServer);
+    QMetaObject::invokeMethod(this, [d, socketDescriptor]() {
+        d->dispatchListenerConnection(socketDescriptor);
+    }, Qt::QueuedConnection);
+}
+
 /*!
     This function is called by QTcpServer::incomingConnection()
     to add the \a socket to the list of pending incoming connections.
@@ -657,6 +872,41 @@ int QTcpServer::maxPendingConnections() const
     return d_func()->maxConnections;
 }
 
+/*!
+    \since 5.11
+
+    Sets the number of sockets that listen on the server's address and port
+    to \a count. With a \a count greater than 1, listen() binds the server
+    socket with \c SO_REUSEPORT and opens \a count - 1 additional sockets on
+    the same address and port, each accepting connections in a QThread of
+    its own; the operating system distributes incoming connections among
+    all of them. Connections accepted by the additional sockets are passed
+    to incomingListenerConnection().
+
+    The new count takes effect the next time listen() is called. If the
+    platform or the socket engine in use does not support \c SO_REUSEPORT,
+    the server listens on a single socket. The default is 1.
+
+    \sa listenerCount(), incomingListenerConnection()
+*/
+void QTcpServer::setListenerCount(int count)
+{
+    d_func()->listenerCount = qMax(1, count);
+}
+
+/*!
+    \since 5.11
+
+    Returns the number of sockets the server listens on when listen() is
+    called.
+
+    \sa setListenerCount()
+*/
+int QTcpServer::listenerCount() const
+{
+    return d_func()->listenerCount;
+}
+
 /*!
     Returns an error code for the last error that occurred.
 
@@ -688,6 +938,7 @@ QString QTcpServer::errorString() const
 void QTcpServer::pauseAccepting()
 {
     d_func()->socketEngine->setReadNotificationEnabled(false);
+    d_func()->setListenersAccepting(false);
 }
 
 /*!
@@ -700,6 +951,7 @@ void QTcpServer::pauseAccepting()
 void QTcpServer::resumeAccepting()
 {
     d_func()->socketEngine->setReadNotificationEnabled(true);
+    d_func()->setListenersAccepting(true);
 }
 
 #ifndef QT_NO_NETWORKPROXY
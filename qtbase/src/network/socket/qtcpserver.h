@@ -69,6 +69,9 @@ public:
     void setMaxPendingConnections(int numConnections);
     int maxPendingConnections() const;
 
+    void setListenerCount(int count);
+    int listenerCount() const;
+
     quint16 serverPort() const;
     QHostAddress serverAddress() const;
 
@@ -92,6 +95,7 @@ public:
 
 protected:
     virtual void incomingConnection(qintptr handle);
+    virtual void incomingListenerConnection(qintptr handle);
     void addPendingConnection(QTcpSocket* socket);
 
     QTcpServer(QAbstractSocket::SocketType socketType, QTcpServerPrivate &dd,
@@ -59,10 +59,13 @@
 #include "QtNetwork/qabstractsocket.h"
 #include "qnetworkproxy.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qvector.h"
 #include "qhostaddress.h"
 
 QT_BEGIN_NAMESPACE
 
+class QTcpServerListener;
+
 class Q_NETWORK_EXPORT QTcpServerPrivate : public QObjectPrivate,
                                            public QAbstractSocketEngineReceiver
 {
@@ -85,6 +88,10 @@ public:
 
     int maxConnections;
 
+    // Additional SO_REUSEPORT sockets, each accepting in its own thread
+    int listenerCount;
+    QVector<QTcpServerListener *> listeners;
+
 #ifndef QT_NO_NETWORKPROXY
     QNetworkProxy proxy;
     QNetworkProxy resolveProxy(const QHostAddress &address, quint16 port);
@@ -92,6 +99,13 @@ public:
 
     virtual void configureCreatedSocket();
 
+    void startListeners(const QNetworkProxy &proxy);
+    void stopListeners();
+    void setListenersAccepting(bool accepting);
+    void listenerConnection(qintptr socketDescriptor);
+    void listenerError(QAbstractSocket::SocketError error, const QString &errorString);
+    void dispatchListenerConnection(qintptr socketDescriptor);
+
     // from QAbstractSocketEngineReceiver
     void readNotification() Q_DECL_OVERRIDE;
     void closeNotification() Q_DECL_OVERRIDE { readNotification(); }
@@ -102,6 +102,7 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include "qvarlengtharray.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -125,6 +126,9 @@ public:
 
     inline bool ensureInitialized(const QHostAddress &remoteAddress)
     { return doEnsureInitialized(QHostAddress(), 0, remoteAddress); }
+
+    // receiveDatagrams() reads into this, kept around between calls
+    QByteArray datagramBuffer;
 };
 
 bool QUdpSocketPrivate::doEnsureInitialized(const QHostAddress &bindAddress, quint16 bindPort,
@@ -430,6 +434,66 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 5.11
+
+    Sends all \a datagrams, each to the host address and port numbers
+    contained in it, and using the network interface and hop count limits also
+    set there, like writeDatagram() does.
+
+    Where the operating system supports it (\c sendmmsg() on Linux), all
+    datagrams are handed over with a single system call. The socket is
+    initialized for the protocol of the first datagram's destination, so all
+    destinations should use the same protocol.
+
+    Returns the number of datagrams that were sent, which is less than the
+    number of \a datagrams if the operating system's send buffer filled up;
+    the remaining datagrams can be passed again later. Returns -1 if not a
+    single datagram could be sent. bytesWritten() is emitted once, with the
+    total size of the datagrams that were sent.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+int QUdpSocket::writeDatagrams(const QVector<QNetworkDatagram> &datagrams)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%d)", datagrams.size());
+#endif
+    if (datagrams.isEmpty())
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams.first().destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    const int count = datagrams.size();
+    QVarLengthArray<const char *, 32> data(count);
+    QVarLengthArray<qint64, 32> lengths(count);
+    QVarLengthArray<QIpPacketHeader, 32> headers(count);
+    for (int i = 0; i < count; ++i) {
+        const QNetworkDatagramPrivate *datagram = datagrams.at(i).d;
+        data[i] = datagram->data.constData();
+        lengths[i] = datagram->data.size();
+        headers[i] = datagram->header;
+    }
+
+    const int sent = d->socketEngine->writeDatagrams(count, data.constData(), lengths.constData(),
+                                                     headers.constData());
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sent >= 0) {
+        qint64 written = 0;
+        for (int i = 0; i < sent; ++i)
+            written += lengths[i];
+        if (sent)
+            emit bytesWritten(written);
+    } else {
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+    }
+    return sent;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and returns it in the
     QNetworkDatagram object, along with the sender's host address and port. If
@@ -473,6 +537,72 @@ QNetworkDatagram QUdpSocket::receiveDatagram(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 5.11
+
+    Receives up to \a maxCount datagrams no larger than \a maxSize bytes each
+    and returns them, along with their sender's host address and port and, if
+    possible, their destination address, port and hop count at reception time.
+    Datagrams larger than \a maxSize are truncated.
+
+    Unlike calling receiveDatagram() in a loop, this function reads all
+    datagrams with a single system call where the operating system supports
+    it (\c recvmmsg() on Linux), which reduces the overhead per datagram
+    considerably for sockets receiving at a high rate.
+
+    Returns fewer than \a maxCount datagrams if no more are pending, and an
+    empty list on failure.
+
+    \sa receiveDatagram(), writeDatagrams(), hasPendingDatagrams()
+*/
+QVector<QNetworkDatagram> QUdpSocket::receiveDatagrams(int maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%d, %lld)", maxCount, maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QVector<QNetworkDatagram>());
+
+    QVector<QNetworkDatagram> result;
+    if (maxCount <= 0 || maxSize < 0)
+        return result;
+
+    // one buffer for all datagrams; the data is copied into datagrams of the actual size
+    const qint64 bufferSize = qMax(maxSize, Q_INT64_C(1)) * maxCount;
+    if (bufferSize > INT_MAX) {
+        qWarning("QUdpSocket::receiveDatagrams: %d datagrams of %lld bytes do not fit into memory",
+                 maxCount, maxSize);
+        return result;
+    }
+    if (d->datagramBuffer.size() < bufferSize)
+        d->datagramBuffer.resize(int(bufferSize));
+
+    QVarLengthArray<char *, 32> data(maxCount);
+    QVarLengthArray<qint64, 32> lengths(maxCount);
+    QVarLengthArray<QIpPacketHeader, 32> headers(maxCount);
+    for (int i = 0; i < maxCount; ++i)
+        data[i] = d->datagramBuffer.data() + i * maxSize;
+
+    const int received = d->socketEngine->readDatagrams(maxCount, data.constData(), maxSize,
+                                                        lengths.data(), headers.data(),
+                                                        QAbstractSocketEngine::WantAll);
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    if (received < 0) {
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        return result;
+    }
+
+    result.reserve(received);
+    for (int i = 0; i < received; ++i) {
+        QNetworkDatagram datagram(QByteArray(data[i], int(lengths[i])));
+        datagram.d->header = headers[i];
+        result.append(datagram);
+    }
+    return result;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and stores
     it in \a data. The sender's host address and port is stored in
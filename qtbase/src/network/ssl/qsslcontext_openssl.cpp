@@ -47,6 +47,11 @@
 #include "private/qsslsocket_openssl_p.h"
 #include "private/qsslsocket_openssl_symbols_p.h"
 
+#include <QtCore/qcache.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qurl.h>
+
 QT_BEGIN_NAMESPACE
 
 QSslContext::QSslContext()
@@ -73,14 +78,20 @@ QSslContext::~QSslContext()
 QSslContext* QSslContext::fromConfiguration(QSslSocket::SslMode mode, const QSslConfiguration &configuration, bool allowRootCertOnDemandLoading)
 {
     QSslContext *sslContext = new QSslContext();
+    QElapsedTimer timer;
+    timer.start();
     initSslContext(sslContext, mode, configuration, allowRootCertOnDemandLoading);
+    qCDebug(lcSsl) << "created SSL context in" << timer.nsecsElapsed() / 1000 << "us";
     return sslContext;
 }
 
 QSharedPointer<QSslContext> QSslContext::sharedFromConfiguration(QSslSocket::SslMode mode, const QSslConfiguration &configuration, bool allowRootCertOnDemandLoading)
 {
     QSharedPointer<QSslContext> sslContext = QSharedPointer<QSslContext>::create();
+    QElapsedTimer timer;
+    timer.start();
     initSslContext(sslContext.data(), mode, configuration, allowRootCertOnDemandLoading);
+    qCDebug(lcSsl) << "created SSL context in" << timer.nsecsElapsed() / 1000 << "us";
     return sslContext;
 }
 
@@ -237,4 +248,118 @@ QString QSslContext::errorString() const
     return errorStr;
 }
 
+namespace {
+struct QSslCachedSession
+{
+    QByteArray asn1;
+    QElapsedTimer age;
+    qint64 lifetime; // msecs
+};
+
+struct QSslSessionCacheData
+{
+    QSslSessionCacheData() : sessions(maxSessions) {}
+
+    // the sessions of this many peers are kept
+    enum { maxSessions = 256 };
+    // used if the server does not say how long its tickets are valid,
+    // OpenSSL's default session timeout
+    enum { defaultLifetime = 300 };
+    // tickets are not kept longer than this, whatever the server says
+    enum { maxLifetime = 2 * 60 * 60 };
+
+    QMutex mutex;
+    QCache<QByteArray, QSslCachedSession> sessions;
+};
+}
+
+Q_GLOBAL_STATIC(QSslSessionCacheData, sslSessionCache)
+
+// A session may only be resumed by a connection that would also have accepted
+// the peer that established it, so the key covers everything that affects
+// the handshake and the verification of the peer.
+QByteArray QSslSessionCache::key(const QString &peerName, quint16 port, const QSslConfiguration &configuration)
+{
+    QByteArray key = QUrl::toAce(peerName);
+    if (key.isEmpty())
+        return key;
+
+    const QList<QSslCertificate> caCertificates = configuration.caCertificates();
+    const QList<QSslCertificate> localCertificates = configuration.localCertificateChain();
+    const QList<QSslCipher> ciphers = configuration.ciphers();
+    uint hash = qHash(int(configuration.protocol()));
+    hash ^= qHash(int(configuration.peerVerifyMode())) + (hash << 6);
+    hash ^= qHashRange(caCertificates.cbegin(), caCertificates.cend()) + (hash << 6);
+    hash ^= qHashRange(localCertificates.cbegin(), localCertificates.cend()) + (hash << 6);
+    for (const QSslCipher &cipher : ciphers)
+        hash ^= qHash(cipher.name()) + (hash << 6);
+
+    key += ':' + QByteArray::number(port) + '/' + QByteArray::number(hash, 16);
+    return key;
+}
+
+// Offers the cached session for \a key to the peer, returns false if there is
+// none or it expired.
+bool QSslSessionCache::resumeSession(const QByteArray &key, SSL *ssl)
+{
+    QByteArray asn1;
+    {
+        QSslSessionCacheData *cache = sslSessionCache();
+        QMutexLocker locker(&cache->mutex);
+        QSslCachedSession *cached = cache->sessions.object(key);
+        if (!cached)
+            return false;
+        if (cached->age.elapsed() >= cached->lifetime) {
+            cache->sessions.remove(key);
+            return false;
+        }
+        asn1 = cached->asn1;
+    }
+
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(asn1.constData());
+    SSL_SESSION *session = q_d2i_SSL_SESSION(0, &data, asn1.size());
+    if (!session)
+        return false;
+    // SSL_set_session() takes its own reference
+    const bool resumed = q_SSL_set_session(ssl, session);
+    q_SSL_SESSION_free(session);
+    return resumed;
+}
+
+// Stores the session \a ssl established, to be called when the handshake
+// completed.
+void QSslSessionCache::storeSession(const QByteArray &key, SSL *ssl)
+{
+    SSL_SESSION *session = q_SSL_get_session(ssl);
+    if (!session)
+        return;
+    const int sessionSize = q_i2d_SSL_SESSION(session, 0);
+    if (sessionSize <= 0)
+        return;
+
+    QSslCachedSession *cached = new QSslCachedSession;
+    cached->asn1.resize(sessionSize);
+    unsigned char *data = reinterpret_cast<unsigned char *>(cached->asn1.data());
+    if (!q_i2d_SSL_SESSION(session, &data)) {
+        delete cached;
+        return;
+    }
+    const long hint = q_SSL_SESSION_get_ticket_lifetime_hint(session);
+    cached->lifetime = qint64(hint > 0 ? qMin(hint, long(QSslSessionCacheData::maxLifetime))
+                                       : long(QSslSessionCacheData::defaultLifetime)) * 1000;
+    cached->age.start();
+
+    QSslSessionCacheData *cache = sslSessionCache();
+    QMutexLocker locker(&cache->mutex);
+    cache->sessions.insert(key, cached); // the cache takes ownership
+}
+
+// Forgets the session for \a key, e.g. because resuming it failed.
+void QSslSessionCache::removeSession(const QByteArray &key)
+{
+    QSslSessionCacheData *cache = sslSessionCache();
+    QMutexLocker locker(&cache->mutex);
+    cache->sessions.remove(key);
+}
+
 QT_END_NAMESPACE
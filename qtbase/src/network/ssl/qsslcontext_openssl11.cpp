@@ -51,6 +51,8 @@
 #include "private/qsslsocket_openssl_symbols_p.h"
 #include "private/qssldiffiehellmanparameters_p.h"
 
+#include <QtCore/qmutex.h>
+
 #include <vector>
 
 QT_BEGIN_NAMESPACE
@@ -64,6 +66,89 @@ static inline QString msgErrorSettingEllipticCurves(const QString &why)
     return QSslSocket::tr("Error when setting the elliptic curves (%1)").arg(why);
 }
 
+namespace {
+// Building an X509_STORE from the hundreds of system CA certificates is what
+// makes creating a context expensive. Most contexts use the CA certificates
+// of the default configuration, so the store built for them is shared.
+struct QSslSharedCertStore
+{
+    QSslSharedCertStore() : store(nullptr), loadsOnDemand(false) {}
+    ~QSslSharedCertStore()
+    {
+        if (store)
+            q_X509_STORE_free(store);
+    }
+
+    QMutex mutex;
+    X509_STORE *store;
+    QList<QSslCertificate> caCertificates;
+    bool loadsOnDemand;
+    QDateTime expiryDate; // of the first certificate in the store to expire
+};
+}
+
+Q_GLOBAL_STATIC(QSslSharedCertStore, sharedCertStore)
+
+// Returns a new reference to a store holding the unexpired certificates out
+// of \a caCertificates, that also looks up the system's root certificates in
+// their hashed directories if \a loadOnDemand is true.
+static X509_STORE *referenceCertStore(const QList<QSslCertificate> &caCertificates, bool loadOnDemand)
+{
+    QSslSharedCertStore *shared = sharedCertStore();
+    QMutexLocker locker(&shared->mutex);
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    if (shared->store && shared->loadsOnDemand == loadOnDemand && now < shared->expiryDate
+        && (shared->caCertificates.isSharedWith(caCertificates)
+            || shared->caCertificates == caCertificates)) {
+        q_X509_STORE_up_ref(shared->store);
+        return shared->store;
+    }
+
+    X509_STORE *store = q_X509_STORE_new();
+    if (!store)
+        return nullptr;
+
+    QDateTime expiryDate;
+    for (const QSslCertificate &caCertificate : caCertificates) {
+        // From https://www.openssl.org/docs/ssl/SSL_CTX_load_verify_locations.html:
+        //
+        // If several CA certificates matching the name, key identifier, and
+        // serial number condition are available, only the first one will be
+        // examined. This may lead to unexpected results if the same CA
+        // certificate is available with different expiration dates. If a
+        // ``certificate expired'' verification error occurs, no other
+        // certificate will be searched. Make sure to not have expired
+        // certificates mixed with valid ones.
+        //
+        // See also: QSslSocketBackendPrivate::verify()
+        const QDateTime caExpiryDate = caCertificate.expiryDate();
+        if (caExpiryDate >= now) {
+            q_X509_STORE_add_cert(store, (X509 *)caCertificate.handle());
+            if (!expiryDate.isValid() || caExpiryDate < expiryDate)
+                expiryDate = caExpiryDate;
+        }
+    }
+
+    if (loadOnDemand) {
+        // tell OpenSSL the directories where to look up the root certs on demand;
+        // as the store is shared, a certificate is only read once per process
+        const QList<QByteArray> unixDirs = QSslSocketPrivate::unixRootCertDirectories();
+        for (const QByteArray &unixDir : unixDirs)
+            q_X509_STORE_load_locations(store, nullptr, unixDir.constData());
+    }
+
+    if (shared->store)
+        q_X509_STORE_free(shared->store);
+    shared->store = store;
+    shared->caCertificates = caCertificates;
+    shared->loadsOnDemand = loadOnDemand;
+    shared->expiryDate = expiryDate.isValid() ? expiryDate : now.addDays(1);
+
+    q_X509_STORE_up_ref(store);
+    return store;
+}
+
 // static
 void QSslContext::initSslContext(QSslContext *sslContext, QSslSocket::SslMode mode, const QSslConfiguration &configuration, bool allowRootCertOnDemandLoading)
 {
@@ -128,33 +213,11 @@ init_context:
         return;
     }
 
-    const QDateTime now = QDateTime::currentDateTimeUtc();
-
-    // Add all our CAs to this store.
-    const auto caCertificates = sslContext->sslConfiguration.caCertificates();
-    for (const QSslCertificate &caCertificate : caCertificates) {
-        // From https://www.openssl.org/docs/ssl/SSL_CTX_load_verify_locations.html:
-        //
-        // If several CA certificates matching the name, key identifier, and
-        // serial number condition are available, only the first one will be
-        // examined. This may lead to unexpected results if the same CA
-        // certificate is available with different expiration dates. If a
-        // ``certificate expired'' verification error occurs, no other
-        // certificate will be searched. Make sure to not have expired
-        // certificates mixed with valid ones.
-        //
-        // See also: QSslSocketBackendPrivate::verify()
-        if (caCertificate.expiryDate() >= now) {
-            q_X509_STORE_add_cert(q_SSL_CTX_get_cert_store(sslContext->ctx), (X509 *)caCertificate.handle());
-        }
-    }
-
-    if (QSslSocketPrivate::s_loadRootCertsOnDemand && allowRootCertOnDemandLoading) {
-        // tell OpenSSL the directories where to look up the root certs on demand
-        const QList<QByteArray> unixDirs = QSslSocketPrivate::unixRootCertDirectories();
-        for (const QByteArray &unixDir : unixDirs)
-            q_SSL_CTX_load_verify_locations(sslContext->ctx, nullptr, unixDir.constData());
-    }
+    // Use a store with all our CAs, shared with the other contexts using them.
+    // The context takes over the reference we get.
+    const bool loadOnDemand = QSslSocketPrivate::s_loadRootCertsOnDemand && allowRootCertOnDemandLoading;
+    if (X509_STORE *store = referenceCertStore(sslContext->sslConfiguration.caCertificates(), loadOnDemand))
+        q_SSL_CTX_set_cert_store(sslContext->ctx, store);
 
     if (!sslContext->sslConfiguration.localCertificate().isNull()) {
         // Require a private key as well.
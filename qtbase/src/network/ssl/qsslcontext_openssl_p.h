@@ -123,6 +123,19 @@ private:
 #endif // OPENSSL_VERSION_NUMBER >= 0x1000100fL ...
 };
 
+// A process-wide, size-bounded cache of client sessions, that lets a new
+// connection resume the session of an earlier one to the same peer even
+// if it uses a different QSslContext.
+class QSslSessionCache
+{
+public:
+    static QByteArray key(const QString &peerName, quint16 port, const QSslConfiguration &configuration);
+
+    static bool resumeSession(const QByteArray &key, SSL *ssl);
+    static void storeSession(const QByteArray &key, SSL *ssl);
+    static void removeSession(const QByteArray &key);
+};
+
 #endif // QT_NO_SSL
 
 QT_END_NAMESPACE
@@ -528,6 +528,9 @@ bool QSslSocket::setSocketDescriptor(qintptr socketDescriptor, SocketState state
 void QSslSocket::setSocketOption(QAbstractSocket::SocketOption option, const QVariant &value)
 {
     Q_D(QSslSocket);
+    // the plain socket may not exist yet when connecting
+    if (option == ConnectionAttemptDelayOption)
+        d->connectionAttemptDelay = qMax(0, value.toInt());
     if (d->plainSocket)
         d->plainSocket->setSocketOption(option, value);
 }
@@ -543,6 +546,8 @@ QVariant QSslSocket::socketOption(QAbstractSocket::SocketOption option)
     Q_D(QSslSocket);
     if (d->plainSocket)
         return d->plainSocket->socketOption(option);
+    else if (option == ConnectionAttemptDelayOption)
+        return QVariant(d->connectionAttemptDelay);
     else
         return QVariant();
 }
@@ -2278,6 +2283,7 @@ void QSslSocketPrivate::createPlainSocket(QIODevice::OpenMode openMode)
     //copy network session down to the plain socket (if it has been set)
     plainSocket->setProperty("_q_networksession", q->property("_q_networksession"));
 #endif
+    plainSocket->setSocketOption(QAbstractSocket::ConnectionAttemptDelayOption, connectionAttemptDelay);
     q->connect(plainSocket, SIGNAL(connected()),
                q, SLOT(_q_connectedSlot()),
                Qt::DirectConnection);
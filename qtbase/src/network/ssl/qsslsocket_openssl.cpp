@@ -340,6 +340,19 @@ bool QSslSocketBackendPrivate::initSslContext()
         }
     }
 
+    // Offer the session of an earlier connection to the same peer, unless
+    // the QSslContext already provided one
+    sessionCacheKey.clear();
+    if (mode == QSslSocket::SslClientMode
+        && !(configuration.sslOptions & QSsl::SslOptionDisableSessionSharing)) {
+        QString peerName = verificationPeerName.isEmpty() ? q->peerName() : verificationPeerName;
+        if (peerName.isEmpty())
+            peerName = hostName;
+        sessionCacheKey = QSslSessionCache::key(peerName, q->peerPort(), q->sslConfiguration());
+        if (!sessionCacheKey.isEmpty() && !q_SSL_get_session(ssl))
+            QSslSessionCache::resumeSession(sessionCacheKey, ssl);
+    }
+
     // Clear the session.
     errorList.clear();
 
@@ -902,6 +915,9 @@ bool QSslSocketBackendPrivate::startHandshake()
 #ifdef QSSLSOCKET_DEBUG
             qCDebug(lcSsl) << "QSslSocketBackendPrivate::startHandshake: error!" << errorString;
 #endif
+            // don't offer the session to this peer again
+            if (!sessionCacheKey.isEmpty())
+                QSslSessionCache::removeSession(sessionCacheKey);
             setErrorAndEmit(QAbstractSocket::SslHandshakeFailedError, errorString);
             q->abort();
         }
@@ -106,6 +106,9 @@ long q_X509_get_version(X509 *a);
 EVP_PKEY *q_X509_get_pubkey(X509 *a);
 void q_X509_STORE_set_verify_cb(X509_STORE *ctx, X509_STORE_CTX_verify_cb verify_cb);
 STACK_OF(X509) *q_X509_STORE_CTX_get0_chain(X509_STORE_CTX *ctx);
+int q_X509_STORE_up_ref(X509_STORE *a);
+int q_X509_STORE_load_locations(X509_STORE *ctx, const char *file, const char *dir);
+void q_SSL_CTX_set_cert_store(SSL_CTX *ctx, X509_STORE *store);
 void q_DH_get0_pqg(const DH *dh, const BIGNUM **p, const BIGNUM **q, const BIGNUM **g);
 int q_DH_bits(DH *dh);
 
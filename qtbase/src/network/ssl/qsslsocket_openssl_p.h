@@ -126,6 +126,7 @@ public:
     BIO *readBio;
     BIO *writeBio;
     SSL_SESSION *session;
+    QByteArray sessionCacheKey; // for QSslSessionCache, empty if it is not used
     QVector<QSslErrorEntry> errorList;
 #if OPENSSL_VERSION_NUMBER >= 0x10001000L
     static int s_indexForSSLExtraData; // index used in SSL_get_ex_data to get the matching QSslSocketBackendPrivate
@@ -172,6 +172,9 @@ DEFINEFUNC(long, X509_get_version, X509 *a, a, return -1, return)
 DEFINEFUNC(EVP_PKEY *, X509_get_pubkey, X509 *a, a, return 0, return)
 DEFINEFUNC2(void, X509_STORE_set_verify_cb, X509_STORE *a, a, X509_STORE_CTX_verify_cb verify_cb, verify_cb, return, DUMMYARG)
 DEFINEFUNC(STACK_OF(X509) *, X509_STORE_CTX_get0_chain, X509_STORE_CTX *a, a, return 0, return)
+DEFINEFUNC(int, X509_STORE_up_ref, X509_STORE *a, a, return 0, return)
+DEFINEFUNC3(int, X509_STORE_load_locations, X509_STORE *ctx, ctx, const char *file, file, const char *dir, dir, return 0, return)
+DEFINEFUNC2(void, SSL_CTX_set_cert_store, SSL_CTX *ctx, ctx, X509_STORE *store, store, return, DUMMYARG)
 DEFINEFUNC3(void, CRYPTO_free, void *str, str, const char *file, file, int line, line, return, DUMMYARG)
 DEFINEFUNC(long, OpenSSL_version_num, void, DUMMYARG, return 0, return)
 DEFINEFUNC(const char *, OpenSSL_version, int a, a, return 0, return)
@@ -894,6 +897,9 @@ bool q_resolveOpenSslSymbols()
     RESOLVEFUNC(X509_get_version)
     RESOLVEFUNC(X509_get_pubkey)
     RESOLVEFUNC(X509_STORE_set_verify_cb)
+    RESOLVEFUNC(X509_STORE_up_ref)
+    RESOLVEFUNC(X509_STORE_load_locations)
+    RESOLVEFUNC(SSL_CTX_set_cert_store)
     RESOLVEFUNC(CRYPTO_free)
     RESOLVEFUNC(OpenSSL_version_num)
     RESOLVEFUNC(OpenSSL_version)
@@ -359,8 +359,11 @@ void QSslSocketBackendPrivate::continueHandshake()
     }
 #endif
 
-    // Cache this SSL session inside the QSslContext
+    // Cache this SSL session inside the QSslContext, and for other
+    // connections to the same peer
     if (!(configuration.sslOptions & QSsl::SslOptionDisableSessionSharing)) {
+        if (!sessionCacheKey.isEmpty())
+            QSslSessionCache::storeSession(sessionCacheKey, ssl);
         if (!sslContextPointer->cacheSession(ssl)) {
             sslContextPointer.clear(); // we could not cache the session
         } else {
@@ -496,7 +496,8 @@ QGLEngineShaderManager::QGLEngineShaderManager(QGLContext* context)
       maskType(NoMask),
       compositionMode(QPainter::CompositionMode_SourceOver),
       customSrcStage(0),
-      currentShaderProg(0)
+      currentShaderProg(0),
+      currentShaderProgBound(false)
 {
     sharedShaders = QGLEngineSharedShaders::shadersForContext(context);
 }
@@ -553,6 +554,7 @@ void QGLEngineShaderManager::optimiseForBrushTransform(QTransform::Transformatio
 void QGLEngineShaderManager::setDirty()
 {
     shaderProgNeedsChanging = true;
+    currentShaderProgBound = false;
 }
 
 void QGLEngineShaderManager::setSrcPixelType(Qt::BrushStyle style)
@@ -607,6 +609,7 @@ void QGLEngineShaderManager::setCustomStage(QGLCustomShaderStage* stage)
         removeCustomStage();
     customSrcStage = stage;
     shaderProgNeedsChanging = true;
+    currentShaderProgBound = false;
 }
 
 void QGLEngineShaderManager::removeCustomStage()
@@ -615,6 +618,7 @@ void QGLEngineShaderManager::removeCustomStage()
         customSrcStage->setInactive();
     customSrcStage = 0;
     shaderProgNeedsChanging = true;
+    currentShaderProgBound = false;
 }
 
 QGLShaderProgram* QGLEngineShaderManager::currentProgram()
@@ -633,6 +637,7 @@ void QGLEngineShaderManager::useSimpleProgram()
     ctx_d->setVertexAttribArrayEnabled(QT_TEXTURE_COORDS_ATTR, false);
     ctx_d->setVertexAttribArrayEnabled(QT_OPACITY_ATTR, false);
     shaderProgNeedsChanging = true;
+    currentShaderProgBound = false;
 }
 
 void QGLEngineShaderManager::useBlitProgram()
@@ -643,6 +648,7 @@ void QGLEngineShaderManager::useBlitProgram()
     ctx_d->setVertexAttribArrayEnabled(QT_TEXTURE_COORDS_ATTR, true);
     ctx_d->setVertexAttribArrayEnabled(QT_OPACITY_ATTR, false);
     shaderProgNeedsChanging = true;
+    currentShaderProgBound = false;
 }
 
 QGLShaderProgram* QGLEngineShaderManager::simpleProgram()
@@ -854,8 +860,17 @@ bool QGLEngineShaderManager::useCorrectShaderProg()
         complexGeometry = false;
     }
 
+    // Many state changes (e.g. switching between a solid and an image source and
+    // back) end up selecting the program that is still bound. Keep it and its
+    // uniforms then, instead of binding it again and reuploading everything.
+    if (currentShaderProgBound && !useCustomSrc && *currentShaderProg == requiredProgram) {
+        shaderProgNeedsChanging = false;
+        return false;
+    }
+
     // At this point, requiredProgram is fully populated so try to find the program in the cache
     currentShaderProg = sharedShaders->findProgramInCache(requiredProgram);
+    currentShaderProgBound = currentShaderProg != 0;
 
     if (currentShaderProg && useCustomSrc) {
         customSrcStage->setUniforms(currentShaderProg->program);
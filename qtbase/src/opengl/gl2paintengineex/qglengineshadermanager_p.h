@@ -501,6 +501,7 @@ private:
     QGLCustomShaderStage*       customSrcStage;
 
     QGLEngineShaderProg*    currentShaderProg;
+    bool                    currentShaderProgBound; // nobody bound another program since
 };
 
 QT_END_NAMESPACE
@@ -1390,6 +1390,13 @@ void QGL2PaintEngineEx::renderHintsChanged()
     Q_D(QGL2PaintEngineEx);
     state()->renderHintsChanged = true;
 
+    // QGraphicsView and friends set and restore the same hints around every
+    // item they paint. Don't drop the texture filter state if nothing changed.
+    if (!d->renderHintsDirty && state()->renderHints == d->appliedRenderHints)
+        return;
+    d->renderHintsDirty = false;
+    d->appliedRenderHints = state()->renderHints;
+
 #if !defined(QT_OPENGL_ES_2)
     if (!d->ctx->contextHandle()->isOpenGLES()) {
         if ((state()->renderHints & QPainter::Antialiasing)
@@ -2046,6 +2053,7 @@ bool QGL2PaintEngineEx::begin(QPaintDevice *pdev)
     d->compositionModeDirty = true;
     d->opacityUniformDirty = true;
     d->translateZUniformDirty = true;
+    d->renderHintsDirty = true;
     d->needsSync = true;
     d->useSystemClip = !systemClip().isEmpty();
     d->currentBrush = QBrush();
@@ -2442,6 +2450,9 @@ void QGL2PaintEngineEx::setState(QPainterState *new_state)
 
     // Setting the state as part of a restore().
 
+    if (old_state == s)
+        d->renderHintsDirty = true;
+
     if (old_state == s || old_state->renderHintsChanged)
         renderHintsChanged();
 
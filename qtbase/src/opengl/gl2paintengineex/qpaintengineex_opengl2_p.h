@@ -178,6 +178,7 @@ public:
             shaderManager(0),
             width(0), height(0),
             ctx(0),
+            renderHintsDirty(true),
             useSystemClip(true),
             elementIndicesVBOId(0),
             opacityArray(0),
@@ -268,6 +269,8 @@ public:
     bool opacityUniformDirty;
     bool matrixUniformDirty;
     bool translateZUniformDirty;
+    bool renderHintsDirty;
+    QPainter::RenderHints appliedRenderHints; // last hints renderHintsChanged() acted on
 
     bool stencilClean; // Has the stencil not been used for clipping so far?
     bool useSystemClip;
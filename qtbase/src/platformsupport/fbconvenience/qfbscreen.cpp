@@ -217,10 +217,29 @@ QRegion QFbScreen::doRedraw()
         if (rect.isEmpty())
             continue;
 
+        // Windows are drawn with CompositionMode_Source, so nothing below the
+        // topmost window that covers the whole rect can show through.
+        int bottomLayer = mWindowStack.size() - 1;
+        for (int layerIndex = 0; layerIndex < mWindowStack.size(); ++layerIndex) {
+            QFbWindow *fbWindow = mWindowStack[layerIndex];
+            QFbBackingStore *backingStore = fbWindow->backingStore();
+            if (!backingStore || !fbWindow->window()->isVisible())
+                continue;
+            const QRect windowRect = fbWindow->geometry().translated(-screenOffset);
+            backingStore->lock();
+            const QRect imageRect(windowRect.topLeft(), backingStore->image().size());
+            backingStore->unlock();
+            if (windowRect.intersected(imageRect).contains(rect)) {
+                bottomLayer = layerIndex;
+                break;
+            }
+        }
+
         mPainter->setCompositionMode(QPainter::CompositionMode_Source);
-        mPainter->fillRect(rect, mScreenImage.hasAlphaChannel() ? Qt::transparent : Qt::black);
+        if (bottomLayer == mWindowStack.size() - 1 || !mWindowStack[bottomLayer]->backingStore())
+            mPainter->fillRect(rect, mScreenImage.hasAlphaChannel() ? Qt::transparent : Qt::black);
 
-        for (int layerIndex = mWindowStack.size() - 1; layerIndex != -1; layerIndex--) {
+        for (int layerIndex = bottomLayer; layerIndex != -1; layerIndex--) {
             if (!mWindowStack[layerIndex]->window()->isVisible())
                 continue;
 
@@ -49,7 +49,11 @@
 
 #include <QtCore/qmath.h>
 #include <QtCore/QDebug>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
 #include <QtCore/QtEndian>
 #include <QtCore/QThreadStorage>
 #include <QtCore/private/qsystemlibrary_p.h>
@@ -1154,8 +1158,10 @@ void QWindowsFontDatabase::populateFamily(const QString &familyName)
     ReleaseDC(0, dummy);
 }
 
+typedef QVector<QPair<QString, QString> > FontFamilyList; // family, English alias
+
 static int QT_WIN_CALLBACK populateFontFamilies(const LOGFONT *logFont, const TEXTMETRIC *textmetric,
-                                                DWORD, LPARAM)
+                                                DWORD, LPARAM lParam)
 {
     // the "@family" fonts are just the same as "family". Ignore them.
     const ENUMLOGFONTEX *f = reinterpret_cast<const ENUMLOGFONTEX *>(logFont);
@@ -1165,25 +1171,113 @@ static int QT_WIN_CALLBACK populateFontFamilies(const LOGFONT *logFont, const TE
         QPlatformFontDatabase::registerFontFamily(faceName);
         // Register current font's english name as alias
         const bool ttf = (textmetric->tmPitchAndFamily & TMPF_TRUETYPE);
+        QString englishName;
         if (ttf && qt_localizedName(faceName)) {
-            const QString englishName = qt_getEnglishName(faceName);
+            englishName = qt_getEnglishName(faceName);
             if (!englishName.isEmpty())
                 QPlatformFontDatabase::registerAliasToFontFamily(faceName, englishName);
         }
+        if (FontFamilyList *families = reinterpret_cast<FontFamilyList *>(lParam))
+            families->append(qMakePair(faceName, englishName));
     }
     return 1; // continue
 }
 
+/*
+    Enumerating all families and looking up the English names of localized
+    ones takes a long time on systems with thousands of fonts, so when
+    QT_WINDOWS_FONT_FAMILY_CACHE is set, the result is cached on disk. The
+    cache is keyed on the last write time of the registry keys listing the
+    installed fonts and on the UI language, which determines the localized
+    family names that GDI reports.
+*/
+enum { FontFamilyCacheMagic = 0x51464643, FontFamilyCacheVersion = 1 };
+
+static quint64 registryKeyLastWriteTime(HKEY root, const wchar_t *path)
+{
+    HKEY key;
+    if (RegOpenKeyEx(root, path, 0, KEY_QUERY_VALUE, &key) != ERROR_SUCCESS)
+        return 0;
+    FILETIME lastWriteTime = { 0, 0 };
+    RegQueryInfoKey(key, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, &lastWriteTime);
+    RegCloseKey(key);
+    return quint64(lastWriteTime.dwHighDateTime) << 32 | lastWriteTime.dwLowDateTime;
+}
+
+static QVector<quint64> fontFamilyCacheKey()
+{
+    static const wchar_t fontsKey[] = L"Software\\Microsoft\\Windows NT\\CurrentVersion\\Fonts";
+    QVector<quint64> key;
+    key << registryKeyLastWriteTime(HKEY_LOCAL_MACHINE, fontsKey)
+        << registryKeyLastWriteTime(HKEY_CURRENT_USER, fontsKey) // per-user fonts
+        << GetUserDefaultUILanguage();
+    return key;
+}
+
+static QString fontFamilyCacheFileName()
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (dir.isEmpty())
+        return QString();
+    return dir + QLatin1String("/qtfontcache/windows-gdi-families");
+}
+
+static bool readFontFamilyCache(const QString &fileName, const QVector<quint64> &key, FontFamilyList *families)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream stream(&file);
+    quint32 magic, version;
+    QVector<quint64> storedKey;
+    stream >> magic >> version;
+    if (magic != FontFamilyCacheMagic || version != FontFamilyCacheVersion)
+        return false;
+    stream >> storedKey >> *families;
+    return stream.status() == QDataStream::Ok && storedKey == key && !families->isEmpty();
+}
+
+static void writeFontFamilyCache(const QString &fileName, const QVector<quint64> &key, const FontFamilyList &families)
+{
+    if (!QDir().mkpath(QFileInfo(fileName).absolutePath()))
+        return;
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream stream(&file);
+    stream << quint32(FontFamilyCacheMagic) << quint32(FontFamilyCacheVersion) << key << families;
+    file.commit();
+}
+
 void QWindowsFontDatabase::populateFontDatabase()
 {
     removeApplicationFonts();
-    HDC dummy = GetDC(0);
-    LOGFONT lf;
-    lf.lfCharSet = DEFAULT_CHARSET;
-    lf.lfFaceName[0] = 0;
-    lf.lfPitchAndFamily = 0;
-    EnumFontFamiliesEx(dummy, &lf, populateFontFamilies, 0, 0);
-    ReleaseDC(0, dummy);
+
+    const bool useCache = qEnvironmentVariableIsSet("QT_WINDOWS_FONT_FAMILY_CACHE");
+    const QString cacheFileName = useCache ? fontFamilyCacheFileName() : QString();
+    const QVector<quint64> cacheKey = useCache ? fontFamilyCacheKey() : QVector<quint64>();
+    FontFamilyList families;
+    if (!cacheFileName.isEmpty() && readFontFamilyCache(cacheFileName, cacheKey, &families)) {
+        qCDebug(lcQpaFonts) << "Using" << families.size() << "cached font families from" << cacheFileName;
+        for (const auto &family : qAsConst(families)) {
+            QPlatformFontDatabase::registerFontFamily(family.first);
+            if (!family.second.isEmpty())
+                QPlatformFontDatabase::registerAliasToFontFamily(family.first, family.second);
+        }
+    } else {
+        families.clear();
+        HDC dummy = GetDC(0);
+        LOGFONT lf;
+        lf.lfCharSet = DEFAULT_CHARSET;
+        lf.lfFaceName[0] = 0;
+        lf.lfPitchAndFamily = 0;
+        EnumFontFamiliesEx(dummy, &lf, populateFontFamilies,
+                           cacheFileName.isEmpty() ? 0 : reinterpret_cast<LPARAM>(&families), 0);
+        ReleaseDC(0, dummy);
+        if (!cacheFileName.isEmpty())
+            writeFontFamilyCache(cacheFileName, cacheKey, families);
+    }
+
     // Work around EnumFontFamiliesEx() not listing the system font.
     QString systemDefaultFamily = QWindowsFontDatabase::systemDefaultFont().family();
     if (QPlatformFontDatabase::resolveFontFamilyAlias(systemDefaultFamily) == systemDefaultFamily)
@@ -49,6 +49,7 @@
 #include <QtCore/private/qcore_unix_p.h>
 #include <QtGui/private/qhighdpiscaling_p.h>
 #include <QtGui/private/qguiapplication_p.h>
+#include <QtGui/private/qwindowsysteminterface_p.h>
 #ifdef Q_OS_FREEBSD
 #include <dev/evdev/input.h>
 #else
@@ -56,6 +57,11 @@
 #endif
 
 #include <math.h>
+#include <time.h>
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #if QT_CONFIG(mtdev)
 extern "C" {
@@ -125,6 +131,12 @@ public:
     double m_timeStamp;
     double m_lastTimeStamp;
 
+    // True when the kernel stamps events with CLOCK_MONOTONIC, which is the
+    // clock backing QWindowSystemInterfacePrivate::eventTime on Linux.
+    bool m_monotonicTime;
+
+    ulong eventTimestamp(double time) const;
+
     int findClosestContact(const QHash<int, Contact> &contacts, int x, int y, int *dist);
     void addTouchPoint(const Contact &contact, Qt::TouchPointStates *combinedStates);
     void reportPoints();
@@ -155,6 +167,9 @@ public:
     bool m_filtered;
     int m_prediction;
 
+    // SCHED_FIFO priority for the reader thread, 0 keeps the default policy.
+    int m_rtPriority;
+
     // When filtering is enabled, protect the access to current and last
     // timeStamp and touchPoints, as these are being read on the gui thread.
     QMutex m_mutex;
@@ -165,11 +180,12 @@ QEvdevTouchScreenData::QEvdevTouchScreenData(QEvdevTouchScreenHandler *q_ptr, co
       m_lastEventType(-1),
       m_currentSlot(0),
       m_timeStamp(0), m_lastTimeStamp(0),
+      m_monotonicTime(false),
       hw_range_x_min(0), hw_range_x_max(0),
       hw_range_y_min(0), hw_range_y_max(0),
       hw_pressure_min(0), hw_pressure_max(0),
       m_forceToActiveWindow(false), m_typeB(false), m_singleTouch(false),
-      m_filtered(false), m_prediction(0)
+      m_filtered(false), m_prediction(0), m_rtPriority(0)
 {
     for (const QString &arg : args) {
         if (arg == QStringLiteral("force_window"))
@@ -178,9 +194,31 @@ QEvdevTouchScreenData::QEvdevTouchScreenData(QEvdevTouchScreenHandler *q_ptr, co
             m_filtered = true;
         else if (arg.startsWith(QStringLiteral("prediction=")))
             m_prediction = arg.mid(11).toInt();
+        else if (arg.startsWith(QStringLiteral("rtprio=")))
+            m_rtPriority = arg.mid(7).toInt();
     }
 }
 
+/*
+    Maps an evdev timestamp (in seconds) to the millisecond timeline used by
+    QWindowSystemInterface, so that touch events carry the time the contact
+    was sampled rather than the time the event reached the GUI thread.
+    Falls back to the current event time when the clocks cannot be related.
+*/
+ulong QEvdevTouchScreenData::eventTimestamp(double time) const
+{
+    const QElapsedTimer &eventTime = QWindowSystemInterfacePrivate::eventTime;
+    if (!m_monotonicTime || !eventTime.isValid()
+            || QElapsedTimer::clockType() != QElapsedTimer::MonotonicClock) {
+        return eventTime.elapsed();
+    }
+
+    const qint64 now = eventTime.elapsed();
+    const qint64 sampled = qint64(time * 1000) - eventTime.msecsSinceReference();
+    // Never report a time in the future nor before the timeline started
+    return ulong(qBound(Q_INT64_C(0), sampled, now));
+}
+
 #define LONG_BITS (sizeof(long) << 3)
 #define NUM_LONGS(bits) (((bits) + LONG_BITS - 1) / LONG_BITS)
 
@@ -249,6 +287,11 @@ QEvdevTouchScreenHandler::QEvdevTouchScreenHandler(const QString &device, const
 
     d = new QEvdevTouchScreenData(this, args);
 
+#if defined(EVIOCSCLOCKID) && defined(CLOCK_MONOTONIC)
+    int clockId = CLOCK_MONOTONIC;
+    d->m_monotonicTime = ioctl(m_fd, EVIOCSCLOCKID, &clockId) == 0;
+#endif
+
 #if QT_CONFIG(mtdev)
     const char *mtdevStr = "(mtdev)";
     d->m_typeB = true;
@@ -781,7 +824,8 @@ void QEvdevTouchScreenData::reportPoints()
     if (m_filtered)
         emit q->touchPointsUpdated();
     else
-        QWindowSystemInterface::handleTouchEvent(Q_NULLPTR, q->touchDevice(), m_touchPoints);
+        QWindowSystemInterface::handleTouchEvent(Q_NULLPTR, eventTimestamp(m_timeStamp),
+                                                 q->touchDevice(), m_touchPoints);
 }
 
 QEvdevTouchScreenHandlerThread::QEvdevTouchScreenHandlerThread(const QString &device, const QString &spec, QObject *parent)
@@ -803,6 +847,23 @@ void QEvdevTouchScreenHandlerThread::run()
 {
     m_handler = new QEvdevTouchScreenHandler(m_device, m_spec);
 
+#ifdef Q_OS_LINUX
+    // Keep the reader ahead of the GUI thread under load, touch samples are
+    // only useful while they are fresh.
+    if (m_handler->d && m_handler->d->m_rtPriority > 0) {
+        sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = qBound(sched_get_priority_min(SCHED_FIFO),
+                                      m_handler->d->m_rtPriority,
+                                      sched_get_priority_max(SCHED_FIFO));
+        const int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err)
+            qErrnoWarning(err, "evdevtouch: Failed to set real-time priority %d", param.sched_priority);
+        else
+            qCDebug(qLcEvdevTouch, "evdevtouch: Reader thread running with SCHED_FIFO priority %d", param.sched_priority);
+    }
+#endif
+
     if (m_handler->isFiltered())
         connect(m_handler, &QEvdevTouchScreenHandler::touchPointsUpdated, this, &QEvdevTouchScreenHandlerThread::scheduleTouchPointUpdate);
 
@@ -954,6 +1015,7 @@ void QEvdevTouchScreenHandlerThread::filterAndSendTouchPoints()
     m_filteredPoints = filteredPoints;
 
     QWindowSystemInterface::handleTouchEvent(Q_NULLPTR,
+                                             m_handler->d->eventTimestamp(time),
                                              m_handler->touchDevice(),
                                              points);
 }
@@ -9,6 +9,7 @@ qtConfig(system-jpeg) {
     QMAKE_USE += libjpeg
 } else {
     include($$PWD/../../../3rdparty/libjpeg.pri)
+    DEFINES += QT_BUNDLED_LIBJPEG
 }
 
 OTHER_FILES += jpeg.json
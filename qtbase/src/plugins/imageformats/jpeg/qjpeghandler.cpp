@@ -44,6 +44,10 @@
 #include <qvector.h>
 #include <qbuffer.h>
 #include <qmath.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qthreadpool.h>
 #include <private/qsimd_p.h>
 #include <private/qimage_p.h>   // for qt_getImageText
 
@@ -74,6 +78,11 @@ extern "C" {
 #endif
 }
 
+// jpeg_crop_scanline() and jpeg_skip_scanlines() are libjpeg-turbo 1.5 extensions
+#if defined(QT_BUNDLED_LIBJPEG) || (defined(LIBJPEG_TURBO_VERSION_NUMBER) && LIBJPEG_TURBO_VERSION_NUMBER >= 1005000)
+#  define QT_JPEG_HAVE_SCANLINE_CROPPING
+#endif
+
 QT_BEGIN_NAMESPACE
 QT_WARNING_DISABLE_GCC("-Wclobbered")
 
@@ -246,6 +255,38 @@ static bool ensureValidImage(QImage *dest, struct jpeg_decompress_struct *info,
     return !dest->isNull();
 }
 
+// Convert one decoded scanline of width pixels, starting at in, into out.
+static void convert_jpeg_scanline(uchar *out, const uchar *in, int width,
+                                  j_decompress_ptr info, Rgb888ToRgb32Converter converter)
+{
+    if (info->output_components == 3) {
+        converter((QRgb*)out, in, width);
+    } else if (info->out_color_space == JCS_CMYK) {
+        // Convert CMYK->RGB.
+        QRgb *rgb = (QRgb*)out;
+        for (int i = 0; i < width; ++i) {
+            int k = in[3];
+            *rgb++ = qRgb(k * in[0] / 255, k * in[1] / 255,
+                          k * in[2] / 255);
+            in += 4;
+        }
+    } else if (info->output_components == 1) {
+        // Grayscale.
+        memcpy(out, in, width);
+    }
+}
+
+static void set_jpeg_density(QImage *outImage, j_decompress_ptr info)
+{
+    if (info->density_unit == 1) {
+        outImage->setDotsPerMeterX(int(100. * info->X_density / 2.54));
+        outImage->setDotsPerMeterY(int(100. * info->Y_density / 2.54));
+    } else if (info->density_unit == 2) {
+        outImage->setDotsPerMeterX(int(100. * info->X_density));
+        outImage->setDotsPerMeterY(int(100. * info->Y_density));
+    }
+}
+
 static bool read_jpeg_image(QImage *outImage,
                             QSize scaledSize, QRect scaledClipRect,
                             QRect clipRect, volatile int inQuality,
@@ -305,31 +346,24 @@ static bool read_jpeg_image(QImage *outImage,
                 info->scale_num   = qBound(1, qCeil(8/f), 8);
                 info->scale_denom = 8;
             } else {
-                info->scale_denom = qMin(clipRect.width() / scaledSize.width(),
-                                         clipRect.height() / scaledSize.height());
-
-                // Only scale by powers of two when clipping so we can
-                // keep the exact pixel boundaries
-                if (info->scale_denom < 2)
-                    info->scale_denom = 1;
-                else if (info->scale_denom < 4)
-                    info->scale_denom = 2;
-                else if (info->scale_denom < 8)
-                    info->scale_denom = 4;
-                else
-                    info->scale_denom = 8;
-                info->scale_num = 1;
+                // Use the smallest M/8 scale that still yields at least
+                // scaledSize pixels for the clip rectangle.
+                double f = qMax(double(scaledSize.width()) / clipRect.width(),
+                                double(scaledSize.height()) / clipRect.height());
+                int num = qBound(1, qCeil(8 * f), 8);
 
                 // Correct the scale factor so that we clip accurately.
                 // It is recommended that the clip rectangle be aligned
                 // on an 8-pixel boundary for best performance.
-                while (info->scale_denom > 1 &&
-                       ((clipRect.x() % info->scale_denom) != 0 ||
-                        (clipRect.y() % info->scale_denom) != 0 ||
-                        (clipRect.width() % info->scale_denom) != 0 ||
-                        (clipRect.height() % info->scale_denom) != 0)) {
-                    info->scale_denom /= 2;
+                while (num < 8 &&
+                       (((clipRect.x() * num) % 8) != 0 ||
+                        ((clipRect.y() * num) % 8) != 0 ||
+                        ((clipRect.width() * num) % 8) != 0 ||
+                        ((clipRect.height() * num) % 8) != 0)) {
+                    ++num;
                 }
+                info->scale_num = num;
+                info->scale_denom = 8;
             }
         }
 
@@ -351,10 +385,12 @@ static bool read_jpeg_image(QImage *outImage,
         } else {
             // The scale factor was corrected above to ensure that
             // we don't miss pixels when we scale the clip rectangle.
-            clip = QRect(clipRect.x() / int(info->scale_denom),
-                         clipRect.y() / int(info->scale_denom),
-                         clipRect.width() / int(info->scale_denom),
-                         clipRect.height() / int(info->scale_denom));
+            const int num = int(info->scale_num);
+            const int denom = int(info->scale_denom);
+            clip = QRect(clipRect.x() * num / denom,
+                         clipRect.y() * num / denom,
+                         clipRect.width() * num / denom,
+                         clipRect.height() * num / denom);
             clip = clip.intersected(imageRect);
         }
 
@@ -378,6 +414,22 @@ static bool read_jpeg_image(QImage *outImage,
 
             (void) jpeg_start_decompress(info);
 
+            // Offset of the clip region within the decoded scanlines.
+            int clipX = clip.x();
+#ifdef QT_JPEG_HAVE_SCANLINE_CROPPING
+            // Only decode the columns and rows of the clip region. The library
+            // widens the column range to iMCU boundaries, and skipped rows are
+            // only entropy decoded.
+            if (clip != imageRect) {
+                JDIMENSION xoffset = clip.x();
+                JDIMENSION width = clip.width();
+                jpeg_crop_scanline(info, &xoffset, &width);
+                clipX = clip.x() - int(xoffset);
+                if (clip.y() > 0)
+                    (void) jpeg_skip_scanlines(info, clip.y());
+            }
+#endif
+
             while (info->output_scanline < info->output_height) {
                 int y = int(info->output_scanline) - clip.y();
                 if (y >= clip.height())
@@ -388,25 +440,9 @@ static bool read_jpeg_image(QImage *outImage,
                 if (y < 0)
                     continue;   // Haven't reached the starting line yet.
 
-                if (info->output_components == 3) {
-                    uchar *in = rows[0] + clip.x() * 3;
-                    QRgb *out = (QRgb*)outImage->scanLine(y);
-                    converter(out, in, clip.width());
-                } else if (info->out_color_space == JCS_CMYK) {
-                    // Convert CMYK->RGB.
-                    uchar *in = rows[0] + clip.x() * 4;
-                    QRgb *out = (QRgb*)outImage->scanLine(y);
-                    for (int i = 0; i < clip.width(); ++i) {
-                        int k = in[3];
-                        *out++ = qRgb(k * in[0] / 255, k * in[1] / 255,
-                                      k * in[2] / 255);
-                        in += 4;
-                    }
-                } else if (info->output_components == 1) {
-                    // Grayscale.
-                    memcpy(outImage->scanLine(y),
-                           rows[0] + clip.x(), clip.width());
-                }
+                convert_jpeg_scanline(outImage->scanLine(y),
+                                      rows[0] + clipX * info->output_components,
+                                      clip.width(), info, converter);
             }
         } else {
             // Load unclipped grayscale data directly into the QImage.
@@ -420,13 +456,7 @@ static bool read_jpeg_image(QImage *outImage,
         if (info->output_scanline == info->output_height)
             (void) jpeg_finish_decompress(info);
 
-        if (info->density_unit == 1) {
-            outImage->setDotsPerMeterX(int(100. * info->X_density / 2.54));
-            outImage->setDotsPerMeterY(int(100. * info->Y_density / 2.54));
-        } else if (info->density_unit == 2) {
-            outImage->setDotsPerMeterX(int(100. * info->X_density));
-            outImage->setDotsPerMeterY(int(100. * info->Y_density));
-        }
+        set_jpeg_density(outImage, info);
 
         if (scaledSize.isValid() && scaledSize != clip.size()) {
             *outImage = outImage->scaled(scaledSize, Qt::IgnoreAspectRatio, quality >= HIGH_QUALITY_THRESHOLD ? Qt::SmoothTransformation : Qt::FastTransformation);
@@ -440,6 +470,264 @@ static bool read_jpeg_image(QImage *outImage,
         return false;
 }
 
+/*
+    Large baseline JPEGs whose restart intervals cover whole MCU rows are
+    decoded in bands on the global thread pool. Every band of restart
+    intervals is rewritten into a standalone JPEG stream, with the frame
+    height patched and the restart markers renumbered, and decoded by its own
+    decompressor directly into the rows of the output image. Bands are only
+    used when they decode to exactly the same pixels as a single pass, so not
+    for vertically subsampled chroma with fancy upsampling.
+*/
+enum { JpegMinimumThreadedPixels = 2048 * 2048 };
+
+struct JpegBand
+{
+    QByteArray data;
+    uchar *bits;
+    int y;
+    int height;
+    bool ok;
+};
+
+static bool decode_jpeg_band(JpegBand *band, int bytesPerLine, bool fast,
+                             Rgb888ToRgb32Converter converter)
+{
+    QBuffer buffer(&band->data);
+    buffer.open(QIODevice::ReadOnly);
+    my_jpeg_source_mgr source(&buffer);
+
+    struct jpeg_decompress_struct cinfo;
+    struct my_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jerr.error_exit = my_error_exit;
+    jerr.output_message = my_output_message;
+    jpeg_create_decompress(&cinfo);
+    cinfo.src = &source;
+
+    volatile bool ok = false;
+    if (!setjmp(jerr.setjmp_buffer)) {
+        (void) jpeg_read_header(&cinfo, TRUE);
+        if (fast) {
+            cinfo.dct_method = JDCT_IFAST;
+            cinfo.do_fancy_upsampling = FALSE;
+        }
+        (void) jpeg_start_decompress(&cinfo);
+        if (int(cinfo.output_height) == band->height) {
+            JSAMPARRAY rows = (cinfo.mem->alloc_sarray)
+                              ((j_common_ptr)&cinfo, JPOOL_IMAGE,
+                               cinfo.output_width * cinfo.output_components, 1);
+            while (cinfo.output_scanline < cinfo.output_height) {
+                uchar *out = band->bits + qsizetype(cinfo.output_scanline) * bytesPerLine;
+                (void) jpeg_read_scanlines(&cinfo, rows, 1);
+                convert_jpeg_scanline(out, rows[0], cinfo.output_width, &cinfo, converter);
+            }
+            (void) jpeg_finish_decompress(&cinfo);
+            ok = true;
+        }
+    }
+    jpeg_destroy_decompress(&cinfo);
+    return ok;
+}
+
+class JpegBandRunnable : public QRunnable
+{
+public:
+    JpegBandRunnable(JpegBand *band, int bytesPerLine, bool fast,
+                     Rgb888ToRgb32Converter converter, QSemaphore *semaphore)
+        : band(band), bytesPerLine(bytesPerLine), fast(fast), converter(converter), semaphore(semaphore)
+    {}
+
+    void run() override
+    {
+        band->ok = decode_jpeg_band(band, bytesPerLine, fast, converter);
+        semaphore->release();
+    }
+
+private:
+    JpegBand *band;
+    int bytesPerLine;
+    bool fast;
+    Rgb888ToRgb32Converter converter;
+    QSemaphore *semaphore;
+};
+
+// Splits the JPEG stream in data into at most maxBands standalone streams of
+// consecutive restart intervals. Returns the size of the JPEG stream, or 0 if
+// it cannot be split.
+static int split_jpeg_restart_intervals(const QByteArray &data, j_decompress_ptr info,
+                                        int maxBands, QVector<JpegBand> *bands)
+{
+    const uchar *p = reinterpret_cast<const uchar *>(data.constData());
+    const int size = data.size();
+    if (size < 4 || p[0] != 0xff || p[1] != 0xd8)
+        return 0;
+
+    // Find the frame header and the start of the entropy coded data.
+    int pos = 2;
+    int sofHeightOffset = -1;
+    int scanStart = -1;
+    while (pos + 4 <= size) {
+        if (p[pos] != 0xff)
+            return 0;
+        const uchar marker = p[pos + 1];
+        if (marker == 0xff) {   // fill byte
+            ++pos;
+            continue;
+        }
+        const int length = (p[pos + 2] << 8) | p[pos + 3];
+        if (length < 2 || pos + 2 + length > size)
+            return 0;
+        if (marker == 0xc0 || marker == 0xc1) // baseline or extended sequential, Huffman coded
+            sofHeightOffset = pos + 5;
+        else if (marker > 0xc1 && marker <= 0xcf && marker != 0xc4 && marker != 0xc8 && marker != 0xcc)
+            return 0;
+        if (marker == 0xda) {   // SOS
+            scanStart = pos + 2 + length;
+            break;
+        }
+        pos += 2 + length;
+    }
+    if (sofHeightOffset < 0 || scanStart < 0)
+        return 0;
+
+    // Collect the restart markers up to the end of the scan.
+    QVector<int> restartMarkers;
+    int eoi = -1;
+    for (int i = scanStart; i + 1 < size; ++i) {
+        const void *ff = memchr(p + i, 0xff, size - 1 - i);
+        if (!ff)
+            break;
+        i = int(static_cast<const uchar *>(ff) - p);
+        const uchar b = p[i + 1];
+        if (b == 0x00) {        // stuffed zero byte
+            ++i;
+        } else if (b >= JPEG_RST0 && b <= JPEG_RST0 + 7) {
+            restartMarkers.append(i);
+            ++i;
+        } else if (b != 0xff) { // anything but a fill byte ends the scan
+            if (b == JPEG_EOI)
+                eoi = i;
+            break;
+        }
+    }
+    if (eoi < 0)
+        return 0;
+
+    const bool interleaved = info->comps_in_scan > 1;
+    const int mcuWidth = interleaved ? DCTSIZE * info->max_h_samp_factor : DCTSIZE;
+    const int mcuHeight = interleaved ? DCTSIZE * info->max_v_samp_factor : DCTSIZE;
+    const int mcusPerRow = (int(info->image_width) + mcuWidth - 1) / mcuWidth;
+    const int mcuRows = (int(info->image_height) + mcuHeight - 1) / mcuHeight;
+    const int interval = int(info->restart_interval);
+    if (interval <= 0 || interval % mcusPerRow != 0)
+        return 0;
+    const int rowsPerInterval = interval / mcusPerRow;
+    const int intervals = (mcuRows + rowsPerInterval - 1) / rowsPerInterval;
+    if (restartMarkers.size() != intervals - 1)
+        return 0;
+
+    const int bandCount = qMin(maxBands, intervals);
+    if (bandCount < 2)
+        return 0;
+
+    bands->resize(bandCount);
+    int first = 0;
+    for (int b = 0; b < bandCount; ++b) {
+        const int count = (intervals - first) / (bandCount - b);
+        JpegBand &band = (*bands)[b];
+        band.y = first * rowsPerInterval * mcuHeight;
+        band.height = qMin((first + count) * rowsPerInterval * mcuHeight, int(info->image_height)) - band.y;
+        band.bits = 0;
+        band.ok = false;
+
+        QByteArray &out = band.data;
+        const int from = first == 0 ? scanStart : restartMarkers.at(first - 1) + 2;
+        const int to = first + count == intervals ? eoi : restartMarkers.at(first + count - 1);
+        out.reserve(scanStart + (to - from) + 2);
+        out.append(data.constData(), scanStart);
+        out[sofHeightOffset] = char(band.height >> 8);
+        out[sofHeightOffset + 1] = char(band.height & 0xff);
+        for (int k = 0; k < count; ++k) {
+            const int j = first + k;
+            const int segmentStart = j == 0 ? scanStart : restartMarkers.at(j - 1) + 2;
+            const int segmentEnd = j == intervals - 1 ? eoi : restartMarkers.at(j);
+            if (k > 0) {
+                out.append(char(0xff));
+                out.append(char(JPEG_RST0 + ((k - 1) & 7)));
+            }
+            out.append(data.constData() + segmentStart, segmentEnd - segmentStart);
+        }
+        out.append(char(0xff));
+        out.append(char(JPEG_EOI));
+        first += count;
+    }
+    return eoi + 2;
+}
+
+static bool read_jpeg_image_threaded(QImage *outImage, QIODevice *device, qint64 startPos,
+                                     int quality, Rgb888ToRgb32Converter converter,
+                                     j_decompress_ptr info)
+{
+    if (device->isSequential()
+            || qint64(info->image_width) * info->image_height < JpegMinimumThreadedPixels
+            || info->progressive_mode || info->arith_code || !info->restart_interval
+            || info->comps_in_scan != info->num_components) {
+        return false;
+    }
+    const bool fast = quality >= 0 && quality < HIGH_QUALITY_THRESHOLD;
+    if (info->max_v_samp_factor > 1 && !fast)
+        return false;
+    const int threads = QThread::idealThreadCount();
+    if (threads < 2)
+        return false;
+
+    const qint64 pos = device->pos();
+    if (!device->seek(startPos))
+        return false;
+    const QByteArray data = device->readAll();
+
+    QVector<JpegBand> bands;
+    const int end = split_jpeg_restart_intervals(data, info, threads, &bands);
+    if (!end || !ensureValidImage(outImage, info, QSize(info->image_width, info->image_height))) {
+        device->seek(pos);
+        return false;
+    }
+
+    uchar *bits = outImage->bits();
+    const int bytesPerLine = outImage->bytesPerLine();
+    for (JpegBand &band : bands)
+        band.bits = bits + qsizetype(band.y) * bytesPerLine;
+
+    // Bands no pool thread is free for, and the last one, are decoded here.
+    QSemaphore semaphore;
+    QThreadPool *pool = QThreadPool::globalInstance();
+    int started = 0;
+    for (int i = 0; i < bands.size() - 1; ++i) {
+        QRunnable *runnable = new JpegBandRunnable(&bands[i], bytesPerLine, fast, converter, &semaphore);
+        if (pool->tryStart(runnable)) {
+            ++started;
+        } else {
+            delete runnable;
+            bands[i].ok = decode_jpeg_band(&bands[i], bytesPerLine, fast, converter);
+        }
+    }
+    bands.last().ok = decode_jpeg_band(&bands.last(), bytesPerLine, fast, converter);
+    semaphore.acquire(started);
+
+    for (const JpegBand &band : qAsConst(bands)) {
+        if (!band.ok) {
+            // Let the sequential decoder deal with (and report) broken streams.
+            device->seek(pos);
+            return false;
+        }
+    }
+
+    set_jpeg_density(outImage, info);
+    device->seek(startPos + end);
+    return true;
+}
+
 struct my_jpeg_destination_mgr : public jpeg_destination_mgr {
     // Nothing dynamic - cannot rely on destruction over longjump
     QIODevice *device;
@@ -703,7 +991,7 @@ public:
     };
 
     QJpegHandlerPrivate(QJpegHandler *qq)
-        : quality(75), transformation(QImageIOHandler::TransformationNone), iod_src(0),
+        : quality(75), transformation(QImageIOHandler::TransformationNone), iod_src(0), startPos(0),
           rgb888ToRgb32ConverterPtr(qt_convert_rgb888_to_rgb32), state(Ready), optimize(false), progressive(false), q(qq)
     {}
 
@@ -732,6 +1020,7 @@ public:
 
     struct jpeg_decompress_struct info;
     struct my_jpeg_source_mgr * iod_src;
+    qint64 startPos;
     struct my_error_mgr err;
 
     Rgb888ToRgb32Converter rgb888ToRgb32ConverterPtr;
@@ -879,6 +1168,7 @@ bool QJpegHandlerPrivate::readJpegHeader(QIODevice *device)
     if(state == Ready)
     {
         state = Error;
+        startPos = device->pos();
         iod_src = new my_jpeg_source_mgr(device);
 
         info.err = jpeg_std_error(&err);
@@ -953,7 +1243,11 @@ bool QJpegHandlerPrivate::read(QImage *image)
 
     if(state == ReadHeader)
     {
-        bool success = read_jpeg_image(image, scaledSize, scaledClipRect, clipRect, quality, rgb888ToRgb32ConverterPtr, &info, &err);
+        bool success = false;
+        if (scaledSize.isEmpty() && scaledClipRect.isEmpty() && clipRect.isEmpty())
+            success = read_jpeg_image_threaded(image, q->device(), startPos, quality, rgb888ToRgb32ConverterPtr, &info);
+        if (!success)
+            success = read_jpeg_image(image, scaledSize, scaledClipRect, clipRect, quality, rgb888ToRgb32ConverterPtr, &info, &err);
         if (success) {
             for (int i = 0; i < readTexts.size()-1; i+=2)
                 image->setText(readTexts.at(i), readTexts.at(i+1));
@@ -57,10 +57,9 @@ void QEglFSKmsGbmDevice::pageFlipHandler(int fd, unsigned int sequence, unsigned
 {
     Q_UNUSED(fd);
     Q_UNUSED(sequence);
-    Q_UNUSED(tv_sec);
-    Q_UNUSED(tv_usec);
 
-    QEglFSKmsScreen *screen = static_cast<QEglFSKmsScreen *>(user_data);
+    QEglFSKmsGbmScreen *screen = static_cast<QEglFSKmsGbmScreen *>(user_data);
+    screen->updateFlipTime(qint64(tv_sec) * 1000000 + tv_usec);
     screen->flipFinished();
 }
 
@@ -68,6 +67,7 @@ QEglFSKmsGbmDevice::QEglFSKmsGbmDevice(QKmsScreenConfig *screenConfig, const QSt
     : QEglFSKmsDevice(screenConfig, path)
     , m_gbm_device(Q_NULLPTR)
     , m_globalCursor(Q_NULLPTR)
+    , m_has_atomic_support(false)
 {
 }
 
@@ -94,6 +94,14 @@ bool QEglFSKmsGbmDevice::open()
 
     setFd(fd);
 
+#ifdef DRM_CLIENT_CAP_ATOMIC
+    // Opt-in, as the atomic API also exposes all planes to the plane discovery
+    if (qEnvironmentVariableIntValue("QT_QPA_EGLFS_KMS_ATOMIC")) {
+        m_has_atomic_support = drmSetClientCap(fd, DRM_CLIENT_CAP_ATOMIC, 1) == 0;
+        qCDebug(qLcEglfsKmsDebug, "Atomic mode setting %s", m_has_atomic_support ? "enabled" : "not supported");
+    }
+#endif
+
     return true;
 }
 
@@ -67,6 +67,8 @@ public:
 
     void handleDrmEvent();
 
+    bool hasAtomicSupport() const { return m_has_atomic_support; }
+
     QPlatformScreen *createScreen(const QKmsOutput &output) override;
 
 private:
@@ -76,6 +78,8 @@ private:
 
     QEglFSKmsGbmCursor *m_globalCursor;
 
+    bool m_has_atomic_support;
+
     static void pageFlipHandler(int fd,
                                 unsigned int sequence,
                                 unsigned int tv_sec,
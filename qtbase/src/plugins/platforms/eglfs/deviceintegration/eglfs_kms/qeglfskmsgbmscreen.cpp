@@ -47,9 +47,11 @@
 #include <QtCore/QLoggingCategory>
 
 #include <QtGui/private/qguiapplication_p.h>
+#include <qpa/qwindowsysteminterface.h>
 #include <QtFbSupport/private/qfbvthandler_p.h>
 
 #include <errno.h>
+#include <string.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -100,6 +102,11 @@ QEglFSKmsGbmScreen::QEglFSKmsGbmScreen(QKmsDevice *device, const QKmsOutput &out
     , m_gbm_bo_current(Q_NULLPTR)
     , m_gbm_bo_next(Q_NULLPTR)
     , m_cursor(Q_NULLPTR)
+#ifdef DRM_CLIENT_CAP_ATOMIC
+    , m_atomicFailed(false)
+#endif
+    , m_lastFlipTime(0)
+    , m_flipInterval(0)
 {
 }
 
@@ -219,6 +226,15 @@ void QEglFSKmsGbmScreen::flip()
         }
     }
 
+#ifdef DRM_CLIENT_CAP_ATOMIC
+    if (static_cast<QEglFSKmsGbmDevice *>(device())->hasAtomicSupport() && !m_atomicFailed) {
+        if (atomicFlip(fb->fb))
+            return;
+        // don't try again, the legacy path is used from now on
+        m_atomicFailed = true;
+    }
+#endif
+
     int ret = drmModePageFlip(fd,
                               op.crtc_id,
                               fb->fb,
@@ -241,4 +257,134 @@ void QEglFSKmsGbmScreen::flipFinished()
     m_gbm_bo_next = Q_NULLPTR;
 }
 
+void QEglFSKmsGbmScreen::updateFlipTime(qint64 timestamp)
+{
+    if (m_lastFlipTime)
+        m_flipInterval = timestamp - m_lastFlipTime;
+    m_lastFlipTime = timestamp;
+
+    // Page flip events carry CLOCK_MONOTONIC timestamps in microseconds
+    QWindowSystemInterface::handleScreenVSync(screen(), timestamp / 1000);
+}
+
+#ifdef DRM_CLIENT_CAP_ATOMIC
+static uint32_t findPropertyId(int fd, uint32_t objectId, uint32_t objectType, const char *name, uint64_t *value = Q_NULLPTR)
+{
+    uint32_t id = 0;
+    drmModeObjectPropertiesPtr props = drmModeObjectGetProperties(fd, objectId, objectType);
+    if (!props)
+        return 0;
+    for (uint32_t i = 0; i < props->count_props && !id; ++i) {
+        drmModePropertyPtr prop = drmModeGetProperty(fd, props->props[i]);
+        if (!prop)
+            continue;
+        if (!strcmp(prop->name, name)) {
+            id = prop->prop_id;
+            if (value)
+                *value = props->prop_values[i];
+        }
+        drmModeFreeProperty(prop);
+    }
+    drmModeFreeObjectProperties(props);
+    return id;
+}
+
+bool QEglFSKmsGbmScreen::initializeAtomicPlane()
+{
+    const QKmsOutput &op(output());
+    const int fd = device()->fd();
+
+    uint32_t planeId = op.wants_plane ? op.plane_id : 0;
+    if (!planeId) {
+        // find the primary plane of our crtc
+        drmModeResPtr resources = drmModeGetResources(fd);
+        if (!resources)
+            return false;
+        int crtcIndex = -1;
+        for (int i = 0; i < resources->count_crtcs; ++i) {
+            if (resources->crtcs[i] == op.crtc_id)
+                crtcIndex = i;
+        }
+        drmModeFreeResources(resources);
+
+        drmModePlaneResPtr planes = drmModeGetPlaneResources(fd);
+        if (!planes || crtcIndex == -1) {
+            drmModeFreePlaneResources(planes);
+            return false;
+        }
+        for (uint32_t i = 0; i < planes->count_planes && !planeId; ++i) {
+            drmModePlanePtr plane = drmModeGetPlane(fd, planes->planes[i]);
+            if (!plane)
+                continue;
+            uint64_t type = 0;
+            if ((plane->possible_crtcs & (1 << crtcIndex))
+                && findPropertyId(fd, plane->plane_id, DRM_MODE_OBJECT_PLANE, "type", &type)
+                && type == DRM_PLANE_TYPE_PRIMARY) {
+                planeId = plane->plane_id;
+            }
+            drmModeFreePlane(plane);
+        }
+        drmModeFreePlaneResources(planes);
+    }
+    if (!planeId)
+        return false;
+
+    AtomicPlane &p(m_atomicPlane);
+    p.fbId = findPropertyId(fd, planeId, DRM_MODE_OBJECT_PLANE, "FB_ID");
+    p.crtcId = findPropertyId(fd, planeId, DRM_MODE_OBJECT_PLANE, "CRTC_ID");
+    p.srcX = findPropertyId(fd, planeId, DRM_MODE_OBJECT_PLANE, "SRC_X");
+    p.srcY = findPropertyId(fd, planeId, DRM_MODE_OBJECT_PLANE, "SRC_Y");
+    p.srcW = findPropertyId(fd, planeId, DRM_MODE_OBJECT_PLANE, "SRC_W");
+    p.srcH = findPropertyId(fd, planeId, DRM_MODE_OBJECT_PLANE, "SRC_H");
+    p.crtcX = findPropertyId(fd, planeId, DRM_MODE_OBJECT_PLANE, "CRTC_X");
+    p.crtcY = findPropertyId(fd, planeId, DRM_MODE_OBJECT_PLANE, "CRTC_Y");
+    p.crtcW = findPropertyId(fd, planeId, DRM_MODE_OBJECT_PLANE, "CRTC_W");
+    p.crtcH = findPropertyId(fd, planeId, DRM_MODE_OBJECT_PLANE, "CRTC_H");
+    if (!p.fbId || !p.crtcId || !p.srcX || !p.srcY || !p.srcW || !p.srcH
+        || !p.crtcX || !p.crtcY || !p.crtcW || !p.crtcH) {
+        return false;
+    }
+    p.id = planeId;
+    qCDebug(qLcEglfsKmsDebug, "Using plane %u for atomic page flips on %s", planeId, qPrintable(name()));
+    return true;
+}
+
+bool QEglFSKmsGbmScreen::atomicFlip(uint32_t fb)
+{
+    if (!m_atomicPlane.id && !initializeAtomicPlane()) {
+        qWarning("No usable plane for atomic mode setting, falling back to legacy page flips");
+        return false;
+    }
+
+    const QKmsOutput &op(output());
+    const uint32_t w = op.modes[op.mode].hdisplay;
+    const uint32_t h = op.modes[op.mode].vdisplay;
+    const AtomicPlane &p(m_atomicPlane);
+
+    drmModeAtomicReqPtr request = drmModeAtomicAlloc();
+    if (!request)
+        return false;
+    drmModeAtomicAddProperty(request, p.id, p.fbId, fb);
+    drmModeAtomicAddProperty(request, p.id, p.crtcId, op.crtc_id);
+    drmModeAtomicAddProperty(request, p.id, p.srcX, 0);
+    drmModeAtomicAddProperty(request, p.id, p.srcY, 0);
+    drmModeAtomicAddProperty(request, p.id, p.srcW, w << 16);
+    drmModeAtomicAddProperty(request, p.id, p.srcH, h << 16);
+    drmModeAtomicAddProperty(request, p.id, p.crtcX, 0);
+    drmModeAtomicAddProperty(request, p.id, p.crtcY, 0);
+    drmModeAtomicAddProperty(request, p.id, p.crtcW, w);
+    drmModeAtomicAddProperty(request, p.id, p.crtcH, h);
+
+    // completion is reported with the same page flip event as drmModePageFlip()
+    const int ret = drmModeAtomicCommit(device()->fd(), request,
+                                        DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT, this);
+    drmModeAtomicFree(request);
+    if (ret) {
+        qErrnoWarning(errno, "Atomic commit failed, falling back to legacy page flips");
+        return false;
+    }
+    return true;
+}
+#endif // DRM_CLIENT_CAP_ATOMIC
+
 QT_END_NAMESPACE
@@ -67,7 +67,29 @@ public:
     void flip() override;
     void flipFinished() override;
 
+    void updateFlipTime(qint64 timestamp);
+    // in microseconds, from the page flip events
+    qint64 lastFlipTime() const { return m_lastFlipTime; }
+    qint64 flipInterval() const { return m_flipInterval; }
+
 private:
+#ifdef DRM_CLIENT_CAP_ATOMIC
+    bool initializeAtomicPlane();
+    bool atomicFlip(uint32_t fb);
+
+    struct AtomicPlane {
+        AtomicPlane() : id(0), fbId(0), crtcId(0), srcX(0), srcY(0), srcW(0), srcH(0),
+                        crtcX(0), crtcY(0), crtcW(0), crtcH(0) {}
+        uint32_t id;
+        // property ids
+        uint32_t fbId, crtcId;
+        uint32_t srcX, srcY, srcW, srcH;
+        uint32_t crtcX, crtcY, crtcW, crtcH;
+    };
+    AtomicPlane m_atomicPlane;
+    bool m_atomicFailed;
+#endif
+
     gbm_surface *m_gbm_surface;
 
     gbm_bo *m_gbm_bo_current;
@@ -82,6 +104,9 @@ private:
     static void bufferDestroyedHandler(gbm_bo *bo, void *data);
     FrameBuffer *framebufferForBufferObject(gbm_bo *bo);
 
+    qint64 m_lastFlipTime;
+    qint64 m_flipInterval;
+
     static QMutex m_waitForFlipMutex;
 };
 
@@ -76,12 +76,13 @@ public:
     };
 
     struct Output {
-        Output() : backFb(0), flipped(false) { }
+        Output() : backFb(0), flipped(false), flipPending(false) { }
         QKmsOutput kmsOutput;
         Framebuffer fb[BUFFER_COUNT];
         QRegion dirty[BUFFER_COUNT];
         int backFb;
         bool flipped;
+        bool flipPending;
         QSize currentRes() const {
             const drmModeModeInfo &modeInfo(kmsOutput.modes[kmsOutput.mode]);
             return QSize(modeInfo.hdisplay, modeInfo.vdisplay);
@@ -98,6 +99,7 @@ public:
     void setMode();
 
     void swapBuffers(Output *output);
+    void waitForFlip(Output *output);
 
     int outputCount() const { return m_outputs.count(); }
     Output *output(int idx) { return &m_outputs[idx]; }
@@ -300,6 +302,7 @@ void QLinuxFbDevice::pageFlipHandler(int fd, unsigned int sequence,
 
     Output *output = static_cast<Output *>(user_data);
     output->backFb = (output->backFb + 1) % BUFFER_COUNT;
+    output->flipPending = false;
 }
 
 void QLinuxFbDevice::swapBuffers(Output *output)
@@ -310,8 +313,15 @@ void QLinuxFbDevice::swapBuffers(Output *output)
         return;
     }
 
-    const int fbIdx = output->backFb;
-    while (output->backFb == fbIdx) {
+    // Don't wait for the flip here. The next frame waits, if needed, before it
+    // starts drawing into the back buffer, which gives the application the
+    // rest of this vblank interval.
+    output->flipPending = true;
+}
+
+void QLinuxFbDevice::waitForFlip(Output *output)
+{
+    while (output->flipPending) {
         drmEventContext drmEvent;
         memset(&drmEvent, 0, sizeof(drmEvent));
         drmEvent.version = 2;
@@ -333,6 +343,8 @@ QLinuxFbDrmScreen::QLinuxFbDrmScreen(const QStringList &args)
 QLinuxFbDrmScreen::~QLinuxFbDrmScreen()
 {
     if (m_device) {
+        for (int i = 0; i < m_device->outputCount(); ++i)
+            m_device->waitForFlip(m_device->output(i));
         m_device->destroyFramebuffers();
         m_device->close();
         delete m_device;
@@ -380,6 +392,9 @@ QRegion QLinuxFbDrmScreen::doRedraw()
     for (int i = 0; i < BUFFER_COUNT; ++i)
         output->dirty[i] += dirty;
 
+    // the buffer we are about to draw into may still be on its way to the screen
+    m_device->waitForFlip(output);
+
     if (output->fb[output->backFb].wrapper.isNull())
         return dirty;
 
@@ -89,6 +89,9 @@ private:
     void flushPixmap(const QRegion &region);
     void setClip(const QRegion &region);
 
+    void insertShmFence();
+    bool shmFenceReached(bool wait);
+
     xcb_shm_segment_info_t m_shm_info;
 
     xcb_image_t *m_xcb_image;
@@ -102,6 +105,11 @@ private:
     // When using shared memory this is the region currently shared with the server
     QRegion m_dirtyShm;
 
+    // A request sent after the last xcb_shm_put_image(). Once the server has replied
+    // to it, it is done reading from the segment and m_dirtyShm can be painted again.
+    xcb_get_input_focus_cookie_t m_shmFence;
+    bool m_hasShmFence;
+
     // When not using shared memory, we maintain a server-side pixmap with the backing
     // store as well as repainted content not yet flushed to the pixmap. We only flush
     // the regions we need and only when these are marked dirty. This way we can just
@@ -148,6 +156,7 @@ QXcbShmImage::QXcbShmImage(QXcbScreen *screen, const QSize &size, uint depth, QI
     , m_graphics_buffer(Q_NULLPTR)
     , m_gc(0)
     , m_gc_drawable(0)
+    , m_hasShmFence(false)
     , m_xcb_pixmap(0)
 {
     const xcb_format_t *fmt = connection()->formatForDepth(depth);
@@ -247,6 +256,11 @@ bool QXcbShmImage::scroll(const QRegion &area, int dx, int dy)
 
 void QXcbShmImage::destroy()
 {
+    if (m_hasShmFence) {
+        xcb_discard_reply(xcb_connection(), m_shmFence.sequence);
+        m_hasShmFence = false;
+    }
+
     const int segmentSize = m_xcb_image ? (m_xcb_image->stride * m_xcb_image->height) : 0;
     if (segmentSize && m_shm_info.shmaddr)
         xcb_shm_detach(xcb_connection(), m_shm_info.shmseg);
@@ -467,6 +481,7 @@ void QXcbShmImage::put(xcb_drawable_t dst, const QRegion &region, const QPoint &
                           m_shm_info.shmseg,
                           m_xcb_image->data - m_shm_info.shmaddr);
         m_dirtyShm |= region.translated(offset);
+        insertShmFence();
     } else {
         flushPixmap(region);
         xcb_copy_area(xcb_connection(),
@@ -481,12 +496,45 @@ void QXcbShmImage::put(xcb_drawable_t dst, const QRegion &region, const QPoint &
     setClip(QRegion());
 }
 
+void QXcbShmImage::insertShmFence()
+{
+    // Only the latest fence matters, it implies that all earlier puts are done
+    if (m_hasShmFence)
+        xcb_discard_reply(xcb_connection(), m_shmFence.sequence);
+    m_shmFence = xcb_get_input_focus(xcb_connection());
+    m_hasShmFence = true;
+}
+
+bool QXcbShmImage::shmFenceReached(bool wait)
+{
+    if (!m_hasShmFence)
+        return true;
+
+    if (wait) {
+        free(xcb_get_input_focus_reply(xcb_connection(), m_shmFence, 0));
+    } else {
+        void *reply = 0;
+        xcb_generic_error_t *error = 0;
+        if (!xcb_poll_for_reply(xcb_connection(), m_shmFence.sequence, &reply, &error))
+            return false;
+        free(reply);
+        free(error);
+    }
+    m_hasShmFence = false;
+    return true;
+}
+
 void QXcbShmImage::preparePaint(const QRegion &region)
 {
     if (hasShm()) {
+        // The fence was sent right after the last put, so by the time we paint
+        // again the server has usually replied and we don't need to block.
+        if (shmFenceReached(false))
+            m_dirtyShm = QRegion();
+
         // to prevent X from reading from the image region while we're writing to it
         if (m_dirtyShm.intersects(region)) {
-            connection()->sync();
+            shmFenceReached(true);
             m_dirtyShm = QRegion();
         }
     } else {
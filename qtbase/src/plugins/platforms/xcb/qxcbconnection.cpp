@@ -1330,6 +1330,7 @@ QXcbEventReader::QXcbEventReader(QXcbConnection *connection)
     : m_connection(connection)
 {
     checkXcbPollForQueuedEvent();
+    m_timer.start();
 }
 
 void QXcbEventReader::start()
@@ -1369,11 +1370,16 @@ void QXcbEventReader::run()
     xcb_generic_event_t *event;
     while (m_connection && (event = xcb_wait_for_event(m_connection->xcb_connection()))) {
         m_mutex.lock();
+        // If the queue is not empty, the GUI thread has been notified already and
+        // will pick up these events in the same pass. Don't flood it with more
+        // queued calls, which is what made it lag behind with high-rate devices.
+        const bool notify = m_events.isEmpty();
         addEvent(event);
         while (m_connection && (event = local_xcb_poll_for_queued_event(m_connection->xcb_connection())))
             addEvent(event);
         m_mutex.unlock();
-        emit eventPending();
+        if (notify)
+            emit eventPending();
     }
 
     m_mutex.lock();
@@ -1388,15 +1394,25 @@ void QXcbEventReader::addEvent(xcb_generic_event_t *event)
     if ((event->response_type & ~0x80) == XCB_CLIENT_MESSAGE
         && (reinterpret_cast<xcb_client_message_event_t *>(event))->type == m_connection->atom(QXcbAtom::_QT_CLOSE_CONNECTION))
         m_connection = 0;
+    if (m_firstQueuedTime < 0)
+        m_firstQueuedTime = m_timer.nsecsElapsed();
     m_events << event;
 }
 
+qint64 QXcbEventReader::queuedTime() const
+{
+    return m_firstQueuedTime < 0 ? 0 : m_timer.nsecsElapsed() - m_firstQueuedTime;
+}
+
 QXcbEventArray *QXcbEventReader::lock()
 {
     m_mutex.lock();
     if (!local_xcb_poll_for_queued_event) {
-        while (xcb_generic_event_t *event = xcb_poll_for_event(m_connection->xcb_connection()))
+        while (xcb_generic_event_t *event = xcb_poll_for_event(m_connection->xcb_connection())) {
+            if (m_firstQueuedTime < 0)
+                m_firstQueuedTime = m_timer.nsecsElapsed();
             m_events << event;
+        }
     }
     return &m_events;
 }
@@ -1721,6 +1737,78 @@ bool QXcbConnection::compressEvent(xcb_generic_event_t *event, int currentIndex,
     return false;
 }
 
+/*
+    Does what compressEvent() does for all events in the queue at once. For
+    every event from \a from on that can be dropped, \a supersededBy holds the
+    index of the later event that replaces it, otherwise -1. This is a single
+    pass from the back of the queue, instead of a scan of the rest of the
+    queue for every event, which is quadratic with high-rate input devices.
+*/
+void QXcbConnection::findCompressibleEvents(QXcbEventArray *eventqueue, int from,
+                                            QVarLengthArray<int, 64> *supersededBy) const
+{
+    const int size = eventqueue->size();
+    supersededBy->resize(size);
+
+    int nextMotion = -1;
+#if QT_CONFIG(xinput2)
+    int nextXIMotion = -1;
+#ifdef XCB_USE_XINPUT22
+    QHash<uint32_t, int> nextTouchUpdate;
+#endif
+#endif
+    QHash<xcb_window_t, int> nextConfigure;
+
+    for (int i = size - 1; i >= from; --i) {
+        xcb_generic_event_t *event = eventqueue->at(i);
+        (*supersededBy)[i] = -1;
+        if (!isValid(event))
+            continue;
+
+        const uint responseType = event->response_type & ~0x80;
+        if (responseType == XCB_MOTION_NOTIFY) {
+            (*supersededBy)[i] = nextMotion;
+            if (event->response_type == XCB_MOTION_NOTIFY)
+                nextMotion = i;
+            continue;
+        }
+#if QT_CONFIG(xinput2)
+        if (responseType == XCB_GE_GENERIC) {
+            if (!hasXInput2())
+                continue;
+            if (isXIType(event, m_xiOpCode, XI_Motion)) {
+                bool compress = true;
+#if QT_CONFIG(tabletevent)
+                xXIDeviceEvent *xdev = reinterpret_cast<xXIDeviceEvent *>(event);
+                if (!QCoreApplication::testAttribute(Qt::AA_CompressTabletEvents) &&
+                        const_cast<QXcbConnection *>(this)->tabletDataForDevice(xdev->sourceid))
+                    compress = false;
+#endif // QT_CONFIG(tabletevent)
+                if (compress)
+                    (*supersededBy)[i] = nextXIMotion;
+                nextXIMotion = i;
+                continue;
+            }
+#ifdef XCB_USE_XINPUT22
+            if (isXIType(event, m_xiOpCode, XI_TouchUpdate)) {
+                xXIDeviceEvent *xiDeviceEvent = reinterpret_cast<xXIDeviceEvent *>(event);
+                const uint32_t id = xiDeviceEvent->detail % INT_MAX;
+                (*supersededBy)[i] = nextTouchUpdate.value(id, -1);
+                nextTouchUpdate.insert(id, i);
+            }
+#endif
+            continue;
+        }
+#endif
+        if (responseType == XCB_CONFIGURE_NOTIFY) {
+            const xcb_window_t window = reinterpret_cast<xcb_configure_notify_event_t *>(event)->event;
+            (*supersededBy)[i] = nextConfigure.value(window, -1);
+            if (event->response_type == XCB_CONFIGURE_NOTIFY)
+                nextConfigure.insert(window, i);
+        }
+    }
+}
+
 void QXcbConnection::processXcbEvents()
 {
     int connection_error = xcb_connection_has_error(xcb_connection());
@@ -1731,21 +1819,42 @@ void QXcbConnection::processXcbEvents()
 
     QXcbEventArray *eventqueue = m_reader->lock();
 
+    const qint64 latency = m_reader->queuedTime();
+    if (!eventqueue->isEmpty()) {
+        ++m_eventStatistics.batches;
+        m_eventStatistics.totalLatency += latency;
+        m_eventStatistics.maxLatency = qMax(m_eventStatistics.maxLatency, latency);
+    }
+
+    const bool compress = QCoreApplication::testAttribute(Qt::AA_CompressHighFrequencyEvents);
+    QVarLengthArray<int, 64> supersededBy;
+    int compressedQueueSize = -1;
+
     for (int i = 0; i < eventqueue->size(); ++i) {
         xcb_generic_event_t *event = eventqueue->at(i);
         if (!event)
             continue;
+        // events may have been added while the queue was unlocked
+        if (Q_LIKELY(compress) && compressedQueueSize != eventqueue->size()) {
+            findCompressibleEvents(eventqueue, i, &supersededBy);
+            compressedQueueSize = eventqueue->size();
+        }
         QScopedPointer<xcb_generic_event_t, QScopedPointerPodDeleter> eventGuard(event);
         (*eventqueue)[i] = 0;
+        ++m_eventStatistics.events;
 
         if (!(event->response_type & ~0x80)) {
             handleXcbError(reinterpret_cast<xcb_generic_error_t *>(event));
             continue;
         }
 
-        if (Q_LIKELY(QCoreApplication::testAttribute(Qt::AA_CompressHighFrequencyEvents)) &&
-                compressEvent(event, i, eventqueue))
-            continue;
+        if (Q_LIKELY(compress) && supersededBy.at(i) != -1) {
+            // the superseding event may have been taken by a peeker meanwhile
+            if (isValid(eventqueue->at(supersededBy.at(i))) || compressEvent(event, i, eventqueue)) {
+                ++m_eventStatistics.compressedEvents;
+                continue;
+            }
+        }
 
 #ifndef QT_NO_CLIPBOARD
         bool accepted = false;
@@ -1769,9 +1878,14 @@ void QXcbConnection::processXcbEvents()
     }
 
     eventqueue->clear();
+    m_reader->resetQueuedTime();
 
     m_reader->unlock();
 
+    if (latency > 0)
+        qCDebug(lcQpaEvents, "processed events queued %lld us ago; %llu of %llu events compressed so far",
+                latency / 1000, m_eventStatistics.compressedEvents, m_eventStatistics.events);
+
     m_peekerIndexCacheDirty = m_mainEventLoopFlushedQueue = true;
 
     // Indicate with a null event that the event the callbacks are waiting for
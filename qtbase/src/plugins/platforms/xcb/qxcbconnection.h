@@ -45,6 +45,7 @@
 
 #include <QtGui/private/qtguiglobal_p.h>
 #include "qxcbexport.h"
+#include <QElapsedTimer>
 #include <QHash>
 #include <QList>
 #include <QMutex>
@@ -327,6 +328,10 @@ public:
 
     void registerEventDispatcher(QAbstractEventDispatcher *dispatcher);
 
+    // must be called with the queue locked
+    qint64 queuedTime() const;
+    void resetQueuedTime() { m_firstQueuedTime = -1; }
+
 signals:
     void eventPending();
 
@@ -339,6 +344,10 @@ private:
     QMutex m_mutex;
     QXcbEventArray m_events;
     QXcbConnection *m_connection;
+
+    QElapsedTimer m_timer;
+    // when the oldest event in m_events was queued, in nanoseconds since m_timer started
+    qint64 m_firstQueuedTime = -1;
 };
 
 class QXcbWindowEventListener
@@ -519,6 +528,16 @@ public:
 #endif
     QXcbEventReader *eventReader() const { return m_reader; }
 
+    struct EventStatistics {
+        quint64 batches = 0;
+        quint64 events = 0;
+        quint64 compressedEvents = 0;
+        qint64 totalLatency = 0; // in nanoseconds
+        qint64 maxLatency = 0;
+    };
+    const EventStatistics &eventStatistics() const { return m_eventStatistics; }
+    void resetEventStatistics() { m_eventStatistics = EventStatistics(); }
+
     bool canGrab() const { return m_canGrabServer; }
 
     QXcbGlIntegration *glIntegration() const { return m_glIntegration; }
@@ -554,6 +573,7 @@ private:
     void destroyScreen(QXcbScreen *screen);
     void initializeScreens();
     bool compressEvent(xcb_generic_event_t *event, int currentIndex, QXcbEventArray *eventqueue) const;
+    void findCompressibleEvents(QXcbEventArray *eventqueue, int from, QVarLengthArray<int, 64> *supersededBy) const;
 
     bool m_xi2Enabled = false;
 #if QT_CONFIG(xinput2)
@@ -708,6 +728,7 @@ private:
     qint32 m_peekerIdSource = 0;
     bool m_peekerIndexCacheDirty = false;
     QHash<qint32, qint32> m_peekerToCachedIndex;
+    EventStatistics m_eventStatistics;
     friend class QXcbEventReader;
 };
 #if QT_CONFIG(xinput2)
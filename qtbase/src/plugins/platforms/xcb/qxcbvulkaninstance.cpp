@@ -41,6 +41,9 @@
 #include "qxcbwindow.h"
 #include "qxcbscreen.h"
 
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
+
 QT_BEGIN_NAMESPACE
 
 QXcbVulkanInstance::QXcbVulkanInstance(QVulkanInstance *instance)
@@ -149,7 +152,15 @@ void QXcbVulkanInstance::presentQueued(QWindow *window)
         return;
     }
 
-    if (w->needsSync())
+    if (!w->needsSync())
+        return;
+
+    // Acknowledge the window manager's sync request right away when
+    // presenting on the gui thread. Going through the event loop delays the
+    // next configure, and thus the frame after a resize, by a full iteration.
+    if (QThread::currentThread() == QCoreApplication::instance()->thread())
+        w->updateSyncRequestCounter();
+    else
         w->postSyncWindowRequest();
 }
 
@@ -50,6 +50,7 @@
 #include <QDebug>
 #include <QtSql/private/qsqldriver_p.h>
 #include <QtSql/private/qsqlresult_p.h>
+#include <QtSql/private/qsqlcolumnbatch_p.h>
 
 #if defined(Q_CC_BOR)
 // DB2's sqlsystm.h (included through sqlcli1.h) defines the SQL_BIGINT_TYPE
@@ -77,9 +78,11 @@ class QDB2DriverPrivate : public QSqlDriverPrivate
     Q_DECLARE_PUBLIC(QDB2Driver)
 
 public:
-    QDB2DriverPrivate() : QSqlDriverPrivate(), hEnv(0), hDbc(0) { dbmsType = QSqlDriver::DB2; }
+    QDB2DriverPrivate() : QSqlDriverPrivate(), hEnv(0), hDbc(0), batchSize(0) { dbmsType = QSqlDriver::DB2; }
     SQLHANDLE hEnv;
     SQLHANDLE hDbc;
+    // QDB2_BATCH_SIZE: rows per execution in execBatch(), 0 for all of them
+    int batchSize;
     QString user;
 };
 
@@ -110,6 +113,7 @@ protected:
     void virtual_hook(int id, void *data) Q_DECL_OVERRIDE;
     void detachFromResultSet() Q_DECL_OVERRIDE;
     bool nextResult() Q_DECL_OVERRIDE;
+    bool execBatch(bool arrayBind = false) Q_DECL_OVERRIDE;
 };
 
 class QDB2ResultPrivate: public QSqlResultPrivate
@@ -138,6 +142,9 @@ public:
         clearValueCache();
         valueCache.clear();
     }
+    int fetchBatch(QSqlColumnBatchPrivate *batch, int maxRows) Q_DECL_OVERRIDE;
+    bool execArray(const QVector<QVariantList> &columns, const QVector<QVariant::Type> &types,
+                   int first, int count);
 
     SQLHANDLE hStmt;
     QSqlRecord recInf;
@@ -891,6 +898,381 @@ bool QDB2Result::exec()
     return true;
 }
 
+// Binds one column-wise array per parameter, holding the rows first to
+// first + count, and executes them all with SQL_ATTR_PARAMSET_SIZE
+bool QDB2ResultPrivate::execArray(const QVector<QVariantList> &columns,
+                                  const QVector<QVariant::Type> &types, int first, int count)
+{
+    struct ParamArray
+    {
+        QByteArray data;
+        QVector<SQLLEN> ind;
+    };
+
+    Q_Q(QDB2Result);
+    QVector<ParamArray> arrays(columns.size());
+    SQLRETURN r = SQL_SUCCESS;
+    for (int i = 0; r == SQL_SUCCESS && i < columns.size(); ++i) {
+        const QVariantList &column = columns.at(i);
+        // a single value is used for every row
+        const int offset = column.size() == 1 ? 0 : first;
+        const int step = column.size() == 1 ? 0 : 1;
+        SQLSMALLINT cType;
+        SQLSMALLINT sqlType;
+        SQLULEN columnSize = 0;
+        SQLLEN elementSize;
+        switch (types.at(i)) {
+        case QVariant::Int:
+            cType = SQL_C_SLONG;
+            sqlType = SQL_INTEGER;
+            elementSize = sizeof(SQLINTEGER);
+            break;
+        case QVariant::UInt:
+        case QVariant::LongLong:
+        case QVariant::ULongLong:
+            cType = SQL_C_SBIGINT;
+            sqlType = SQL_BIGINT;
+            elementSize = sizeof(SQLBIGINT);
+            break;
+        case QVariant::Double:
+            cType = SQL_C_DOUBLE;
+            sqlType = SQL_DOUBLE;
+            elementSize = sizeof(SQLDOUBLE);
+            break;
+        case QVariant::Date:
+            cType = SQL_C_DATE;
+            sqlType = SQL_DATE;
+            elementSize = sizeof(DATE_STRUCT);
+            break;
+        case QVariant::Time:
+            cType = SQL_C_TIME;
+            sqlType = SQL_TIME;
+            elementSize = sizeof(TIME_STRUCT);
+            break;
+        case QVariant::DateTime:
+            cType = SQL_C_TIMESTAMP;
+            sqlType = SQL_TIMESTAMP;
+            elementSize = sizeof(TIMESTAMP_STRUCT);
+            break;
+        case QVariant::ByteArray:
+            cType = SQL_C_BINARY;
+            sqlType = SQL_LONGVARBINARY;
+            for (int row = 0; row < count; ++row)
+                columnSize = qMax<SQLULEN>(columnSize, column.at(offset + row * step).toByteArray().size());
+            elementSize = qMax<SQLLEN>(columnSize, 1);
+            break;
+        default:
+            cType = SQL_C_WCHAR;
+            sqlType = SQL_WVARCHAR;
+            for (int row = 0; row < count; ++row)
+                columnSize = qMax<SQLULEN>(columnSize, column.at(offset + row * step).toString().size());
+            elementSize = qMax<SQLLEN>(columnSize, 1) * sizeof(QChar);
+            break;
+        }
+
+        ParamArray &a = arrays[i];
+        a.data.fill(0, int(elementSize) * count);
+        a.ind.fill(elementSize, count);
+        for (int row = 0; row < count; ++row) {
+            const QVariant &val = column.at(offset + row * step);
+            if (val.isNull()) {
+                a.ind[row] = SQL_NULL_DATA;
+                continue;
+            }
+            char *ptr = a.data.data() + row * elementSize;
+            switch (cType) {
+            case SQL_C_SLONG: {
+                const SQLINTEGER v = val.toInt();
+                memcpy(ptr, &v, sizeof(v));
+                break;
+            }
+            case SQL_C_SBIGINT: {
+                const SQLBIGINT v = val.toLongLong();
+                memcpy(ptr, &v, sizeof(v));
+                break;
+            }
+            case SQL_C_DOUBLE: {
+                const SQLDOUBLE v = val.toDouble();
+                memcpy(ptr, &v, sizeof(v));
+                break;
+            }
+            case SQL_C_DATE: {
+                const QDate qdt = val.toDate();
+                DATE_STRUCT dt;
+                dt.year = qdt.year();
+                dt.month = qdt.month();
+                dt.day = qdt.day();
+                memcpy(ptr, &dt, sizeof(dt));
+                break;
+            }
+            case SQL_C_TIME: {
+                const QTime qdt = val.toTime();
+                TIME_STRUCT dt;
+                dt.hour = qdt.hour();
+                dt.minute = qdt.minute();
+                dt.second = qdt.second();
+                memcpy(ptr, &dt, sizeof(dt));
+                break;
+            }
+            case SQL_C_TIMESTAMP: {
+                const QDateTime qdt = val.toDateTime();
+                TIMESTAMP_STRUCT dt;
+                dt.year = qdt.date().year();
+                dt.month = qdt.date().month();
+                dt.day = qdt.date().day();
+                dt.hour = qdt.time().hour();
+                dt.minute = qdt.time().minute();
+                dt.second = qdt.time().second();
+                dt.fraction = qdt.time().msec() * 1000000;
+                memcpy(ptr, &dt, sizeof(dt));
+                break;
+            }
+            case SQL_C_BINARY: {
+                const QByteArray ba = val.toByteArray();
+                memcpy(ptr, ba.constData(), ba.size());
+                a.ind[row] = ba.size();
+                break;
+            }
+            default: {
+                const QString str = val.toString();
+                memcpy(ptr, str.utf16(), str.size() * sizeof(QChar));
+                a.ind[row] = str.size() * sizeof(QChar);
+                break;
+            }
+            }
+        }
+
+        r = SQLBindParameter(hStmt,
+                             i + 1,
+                             SQL_PARAM_INPUT,
+                             cType,
+                             sqlType,
+                             columnSize,
+                             0,
+                             a.data.data(),
+                             elementSize,
+                             a.ind.data());
+    }
+    if (r == SQL_SUCCESS)
+        r = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER) SQL_PARAM_BIND_BY_COLUMN, 0);
+    if (r == SQL_SUCCESS)
+        r = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER) (quintptr) count, 0);
+    if (r != SQL_SUCCESS) {
+        qWarning("QDB2Result::execBatch: unable to bind variable: %s",
+                 qDB2Warn(this).toLocal8Bit().constData());
+        q->setLastError(qMakeError(QCoreApplication::translate("QDB2Result",
+                        "Unable to bind variable"), QSqlError::StatementError, this));
+        return false;
+    }
+
+    r = SQLExecute(hStmt);
+    if (r != SQL_SUCCESS && r != SQL_SUCCESS_WITH_INFO && r != SQL_NO_DATA) {
+        qWarning("QDB2Result::execBatch: Unable to execute statement: %s",
+                 qDB2Warn(this).toLocal8Bit().constData());
+        q->setLastError(qMakeError(QCoreApplication::translate("QDB2Result",
+                        "Unable to execute statement"), QSqlError::StatementError, this));
+        return false;
+    }
+    return true;
+}
+
+bool QDB2Result::execBatch(bool arrayBind)
+{
+    Q_D(QDB2Result);
+    const QVector<QVariant> values = boundValues();
+    if (values.isEmpty())
+        return false;
+    // output parameters are only supported row by row
+    for (int i = 0; i < values.count(); ++i) {
+        if (bindValueType(i) & QSql::Out)
+            return QSqlResult::execBatch(arrayBind);
+    }
+
+    setActive(false);
+    setAt(QSql::BeforeFirstRow);
+    d->recInf.clear();
+    d->emptyValueCache();
+    if (!qMakeStatement(d, isForwardOnly(), false))
+        return false;
+
+    QVector<QVariantList> columns;
+    QVector<QVariant::Type> types;
+    columns.reserve(values.count());
+    types.reserve(values.count());
+    int rowCount = 1;
+    for (const QVariant &value : values) {
+        if (value.type() == QVariant::List) {
+            columns.append(value.toList());
+            if (columns.constLast().isEmpty())
+                return false;
+            rowCount = columns.constLast().size();
+        } else {
+            columns.append(QVariantList() << value);
+        }
+        types.append(columns.constLast().constFirst().type());
+    }
+
+    const int batchSize = d->drv_d_func()->batchSize > 0 ? d->drv_d_func()->batchSize : rowCount;
+    bool ok = true;
+    for (int first = 0; ok && first < rowCount; first += batchSize)
+        ok = d->execArray(columns, types, first, qMin(batchSize, rowCount - first));
+
+    SQLSetStmtAttr(d->hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER) 1, 0);
+    SQLFreeStmt(d->hStmt, SQL_RESET_PARAMS);
+    if (!ok)
+        return false;
+    setSelect(false);
+    setActive(true);
+    return true;
+}
+
+// Binds column-wise arrays and fetches up to maxRows rows as one rowset,
+// then goes back to the row by row fetching used by data()
+int QDB2ResultPrivate::fetchBatch(QSqlColumnBatchPrivate *batch, int maxRows)
+{
+    struct ArrayBinding
+    {
+        QByteArray buffer;
+        QVector<SQLLEN> ind;
+        SQLSMALLINT type;
+        SQLLEN size;
+    };
+
+    Q_Q(QDB2Result);
+    if (!q->isForwardOnly())
+        return QSqlResultPrivate::fetchBatch(batch, maxRows);
+
+    batch->init(recInf, q->numericalPrecisionPolicy(), maxRows);
+    QVector<ArrayBinding> arrays(recInf.count());
+    for (int i = 0; i < arrays.size(); ++i) {
+        const QSqlField field = recInf.field(i);
+        ArrayBinding &a = arrays[i];
+        switch (batch->columns.at(i).type) {
+        case QSqlColumnBatch::IntegerColumn:
+            a.type = SQL_C_SBIGINT;
+            a.size = sizeof(SQLBIGINT);
+            break;
+        case QSqlColumnBatch::DoubleColumn:
+            a.type = SQL_C_DOUBLE;
+            a.size = sizeof(SQLDOUBLE);
+            break;
+        case QSqlColumnBatch::StringColumn:
+            // long values are read in pieces by qGetStringData()
+            if (field.length() <= 0 || field.length() > 65536)
+                return QSqlResultPrivate::fetchBatch(batch, maxRows);
+            // room for the sign and comma of decimals and the 0 termination
+            a.type = SQL_C_WCHAR;
+            a.size = (field.length() + 3) * sizeof(SQLTCHAR);
+            break;
+        case QSqlColumnBatch::VariantColumn:
+            if (field.type() == QVariant::Date) {
+                a.type = SQL_C_DATE;
+                a.size = sizeof(DATE_STRUCT);
+            } else if (field.type() == QVariant::Time) {
+                a.type = SQL_C_TIME;
+                a.size = sizeof(TIME_STRUCT);
+            } else if (field.type() == QVariant::DateTime) {
+                a.type = SQL_C_TIMESTAMP;
+                a.size = sizeof(TIMESTAMP_STRUCT);
+            } else {
+                return QSqlResultPrivate::fetchBatch(batch, maxRows);
+            }
+            break;
+        }
+        a.buffer.fill(0, int(a.size) * maxRows);
+        a.ind.resize(maxRows);
+    }
+
+    clearValueCache();
+    SQLULEN fetched = 0;
+    SQLRETURN r = SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER) SQL_BIND_BY_COLUMN, 0);
+    if (r == SQL_SUCCESS)
+        r = SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) (quintptr) maxRows, 0);
+    if (r == SQL_SUCCESS)
+        r = SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0);
+    for (int i = 0; r == SQL_SUCCESS && i < arrays.size(); ++i) {
+        ArrayBinding &a = arrays[i];
+        r = SQLBindCol(hStmt, i + 1, a.type, a.buffer.data(), a.size, a.ind.data());
+    }
+
+    const bool bound = r == SQL_SUCCESS;
+    int rows = 0;
+    if (bound) {
+        r = SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0);
+        if (r == SQL_SUCCESS || r == SQL_SUCCESS_WITH_INFO) {
+            rows = int(fetched);
+        } else if (r != SQL_NO_DATA) {
+            q->setLastError(qMakeError(QCoreApplication::translate("QDB2Result",
+                            "Unable to fetch next"), QSqlError::StatementError, this));
+        }
+    }
+
+    SQLFreeStmt(hStmt, SQL_UNBIND);
+    SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, 0, 0);
+    SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) 1, 0);
+    // the rowset could not be set up, e.g. not supported by the cursor
+    if (!bound)
+        return QSqlResultPrivate::fetchBatch(batch, maxRows);
+
+    for (int row = 0; row < rows; ++row) {
+        for (int i = 0; i < arrays.size(); ++i) {
+            const ArrayBinding &a = arrays.at(i);
+            if (a.ind.at(row) == SQL_NULL_DATA) {
+                batch->appendNull(i);
+                continue;
+            }
+            const char *value = a.buffer.constData() + row * a.size;
+            switch (a.type) {
+            case SQL_C_SBIGINT: {
+                SQLBIGINT v;
+                memcpy(&v, value, sizeof(v));
+                batch->appendInteger(i, qint64(v));
+                break;
+            }
+            case SQL_C_DOUBLE: {
+                SQLDOUBLE v;
+                memcpy(&v, value, sizeof(v));
+                batch->appendDouble(i, double(v));
+                break;
+            }
+            case SQL_C_WCHAR: {
+                const QChar *str = reinterpret_cast<const QChar *>(value);
+                const int maxSize = int(a.size / sizeof(SQLTCHAR)) - 1;
+                int size = 0;
+                while (size < maxSize && !str[size].isNull())
+                    ++size;
+                batch->appendText(i, str, size);
+                break;
+            }
+            case SQL_C_DATE: {
+                DATE_STRUCT dbuf;
+                memcpy(&dbuf, value, sizeof(dbuf));
+                batch->appendVariant(i, QVariant(QDate(dbuf.year, dbuf.month, dbuf.day)));
+                break;
+            }
+            case SQL_C_TIME: {
+                TIME_STRUCT tbuf;
+                memcpy(&tbuf, value, sizeof(tbuf));
+                batch->appendVariant(i, QVariant(QTime(tbuf.hour, tbuf.minute, tbuf.second)));
+                break;
+            }
+            default: {
+                TIMESTAMP_STRUCT dtbuf;
+                memcpy(&dtbuf, value, sizeof(dtbuf));
+                batch->appendVariant(i, QVariant(QDateTime(QDate(dtbuf.year, dtbuf.month, dtbuf.day),
+                                                           QTime(dtbuf.hour, dtbuf.minute, dtbuf.second,
+                                                                 dtbuf.fraction / 1000000))));
+                break;
+            }
+            }
+        }
+    }
+    batch->rowCount = rows;
+    if (rows > 0)
+        q->setAt(q->at() == QSql::BeforeFirstRow ? rows - 1 : q->at() + rows);
+    return rows;
+}
+
 bool QDB2Result::fetch(int i)
 {
     Q_D(QDB2Result);
@@ -1264,6 +1646,14 @@ bool QDB2Driver::open(const QString& db, const QString& user, const QString& pas
         } else if (opt == QLatin1String("SQL_ATTR_LOGIN_TIMEOUT")) {
             v = val.toUInt();
             r = SQLSetConnectAttr(d->hDbc, SQL_ATTR_LOGIN_TIMEOUT, reinterpret_cast<SQLPOINTER>(v), 0);
+        } else if (opt == QLatin1String("QDB2_BATCH_SIZE")) {
+            bool ok;
+            d->batchSize = val.toInt(&ok);
+            if (!ok || d->batchSize < 0) {
+                qWarning("QDB2Driver::open: Illegal connect option value '%s'",
+                         tmp.toLocal8Bit().constData());
+                d->batchSize = 0;
+            }
         } else if (opt.compare(QLatin1String("PROTOCOL"), Qt::CaseInsensitive) == 0) {
                         protocol = tmp;
         }
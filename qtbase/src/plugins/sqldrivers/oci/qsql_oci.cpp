@@ -50,6 +50,7 @@
 #include <qsqlindex.h>
 #include <qsqlquery.h>
 #include <QtSql/private/qsqlcachedresult_p.h>
+#include <QtSql/private/qsqlcolumnbatch_p.h>
 #include <QtSql/private/qsqldriver_p.h>
 #include <qstringlist.h>
 #include <qvarlengtharray.h>
@@ -177,6 +178,7 @@ public:
     int serverVersion;
     int prefetchRows;
     int prefetchMem;
+    int batchSize;
     QString user;
 
     void allocErrorHandle();
@@ -225,8 +227,10 @@ public:
     bool transaction;
     int serverVersion;
     int prefetchRows, prefetchMem;
+    int batchSize;
 
     void setStatementAttributes();
+    int fetchBatch(QSqlColumnBatchPrivate *batch, int maxRows) Q_DECL_OVERRIDE;
     int bindValue(OCIStmt *sql, OCIBind **hbnd, OCIError *err, int pos,
                   const QVariant &val, dvoid *indPtr, ub2 *tmpSize, QList<QByteArray> &tmpStorage);
     int bindValues(QVector<QVariant> &values, IndicatorArray &indicators, SizeArray &tmpSizes,
@@ -514,7 +518,7 @@ void QOCIResultPrivate::outValues(QVector<QVariant> &values, IndicatorArray &ind
 
 QOCIDriverPrivate::QOCIDriverPrivate()
     : QSqlDriverPrivate(), env(0), svc(0), srvhp(0), authp(0), err(0), transaction(false),
-      serverVersion(-1), prefetchRows(-1), prefetchMem(QOCI_PREFETCH_MEM)
+      serverVersion(-1), prefetchRows(-1), prefetchMem(QOCI_PREFETCH_MEM), batchSize(0)
 {
     dbmsType = QSqlDriver::Oracle;
 }
@@ -819,6 +823,7 @@ public:
     int readLOBs(QVector<QVariant> &values, int index = 0);
     int fieldFromDefine(OCIDefine* d);
     void getValues(QVector<QVariant> &v, int index);
+    int fetchBatch(QSqlColumnBatchPrivate *batch, int maxRows, sword *status);
     inline int size() { return fieldInf.size(); }
     static bool execBatch(QOCIResultPrivate *d, QVector<QVariant> &boundValues, bool arrayBind);
 
@@ -827,12 +832,14 @@ public:
 private:
     char* create(int position, int size);
     OCILobLocator ** createLobLocator(int position, OCIEnv* env);
+    int defineBuffer(int position);
     OraFieldInfo qMakeOraField(const QOCIResultPrivate* p, OCIParam* param) const;
 
     class OraFieldInf
     {
     public:
-        OraFieldInf(): data(0), len(0), ind(0), typ(QVariant::Invalid), oraType(0), def(0), lob(0)
+        OraFieldInf(): data(0), len(0), ind(0), typ(QVariant::Invalid), oraType(0), def(0), lob(0),
+            defType(0), defSize(0)
         {}
         ~OraFieldInf();
         char *data;
@@ -842,6 +849,9 @@ private:
         ub4 oraType;
         OCIDefine *def;
         OCILobLocator *lob;
+        // type and size of a plain buffer define, 0 for LOBs and piecewise fetches
+        ub2 defType;
+        sb4 defSize;
     };
 
     QVector<OraFieldInf> fieldInf;
@@ -911,6 +921,8 @@ QOCICols::QOCICols(int size, QOCIResultPrivate* dp)
                                SQLT_DAT,
                                &(fieldInf[idx].ind),
                                0, 0, OCI_DEFAULT);
+            fieldInf[idx].defType = SQLT_DAT;
+            fieldInf[idx].defSize = dataSize+1;
             break;
         case QVariant::Double:
             r = OCIDefineByPos(d->sql,
@@ -922,6 +934,8 @@ QOCICols::QOCICols(int size, QOCIResultPrivate* dp)
                                SQLT_FLT,
                                &(fieldInf[idx].ind),
                                0, 0, OCI_DEFAULT);
+            fieldInf[idx].defType = SQLT_FLT;
+            fieldInf[idx].defSize = sizeof(double);
             break;
         case QVariant::Int:
             r = OCIDefineByPos(d->sql,
@@ -933,6 +947,8 @@ QOCICols::QOCICols(int size, QOCIResultPrivate* dp)
                                SQLT_INT,
                                &(fieldInf[idx].ind),
                                0, 0, OCI_DEFAULT);
+            fieldInf[idx].defType = SQLT_INT;
+            fieldInf[idx].defSize = sizeof(qint32);
             break;
         case QVariant::LongLong:
             r = OCIDefineByPos(d->sql,
@@ -944,6 +960,8 @@ QOCICols::QOCICols(int size, QOCIResultPrivate* dp)
                                SQLT_VNU,
                                &(fieldInf[idx].ind),
                                0, 0, OCI_DEFAULT);
+            fieldInf[idx].defType = SQLT_VNU;
+            fieldInf[idx].defSize = sizeof(OCINumber);
             break;
         case QVariant::ByteArray:
             // RAW and LONG RAW fields can't be bound to LOB locators
@@ -1017,6 +1035,8 @@ QOCICols::QOCICols(int size, QOCIResultPrivate* dp)
                         0, 0, OCI_DEFAULT);
                 if (r == 0)
                     d->setCharset(dfn, OCI_HTYPE_DEFINE);
+                fieldInf[idx].defType = SQLT_STR;
+                fieldInf[idx].defSize = dataSize;
             }
            break;
         default:
@@ -1032,6 +1052,8 @@ QOCICols::QOCICols(int size, QOCIResultPrivate* dp)
                                 SQLT_STR,
                                 &(fieldInf[idx].ind),
                                 0, 0, OCI_DEFAULT);
+            fieldInf[idx].defType = SQLT_STR;
+            fieldInf[idx].defSize = dataSize+1;
             break;
         }
         if (r != 0)
@@ -1561,10 +1583,23 @@ bool QOCICols::execBatch(QOCIResultPrivate *d, QVector<QVariant> &boundValues, b
     }
 
     //finaly we can execute
-    r = OCIStmtExecute(d->svc, d->sql, d->err,
-                       arrayBind ? 1 : columns[0].recordCount,
-                       0, NULL, NULL,
-                       d->transaction ? OCI_DEFAULT : OCI_COMMIT_ON_SUCCESS);
+    if (arrayBind) {
+        r = OCIStmtExecute(d->svc, d->sql, d->err, 1, 0, NULL, NULL,
+                           d->transaction ? OCI_DEFAULT : OCI_COMMIT_ON_SUCCESS);
+    } else {
+        // the whole array is bound at once, QOCI_BATCH_SIZE limits how many
+        // of its rows are sent to the server with each execution
+        const ub4 recordCount = columns[0].recordCount;
+        const ub4 batchSize = d->batchSize > 0 ? ub4(d->batchSize) : recordCount;
+        ub4 offset = 0;
+        do {
+            r = OCIStmtExecute(d->svc, d->sql, d->err,
+                               qMin(batchSize, recordCount - offset),
+                               offset, NULL, NULL,
+                               d->transaction ? OCI_DEFAULT : OCI_COMMIT_ON_SUCCESS);
+            offset += batchSize;
+        } while (offset < recordCount && (r == OCI_SUCCESS || r == OCI_SUCCESS_WITH_INFO));
+    }
 
     if (r != OCI_SUCCESS && r != OCI_SUCCESS_WITH_INFO) {
         qOraWarning("QOCIPrivate::execBatch: unable to execute batch statement:", d->err);
@@ -1798,6 +1833,148 @@ void QOCICols::getValues(QVector<QVariant> &v, int index)
     }
 }
 
+int QOCICols::defineBuffer(int position)
+{
+    OraFieldInf &fld = fieldInf[position];
+    int r = OCIDefineByPos(d->sql,
+                           &fld.def,
+                           d->err,
+                           position + 1,
+                           fld.data,
+                           fld.defSize,
+                           fld.defType,
+                           &fld.ind,
+                           0, 0, OCI_DEFAULT);
+    if (r == 0 && fld.typ == QVariant::String)
+        d->setCharset(fld.def, OCI_HTYPE_DEFINE);
+    return r;
+}
+
+// Fetches up to maxRows rows with one OCIStmtFetch() into arrays defined for
+// the occasion, then restores the single row defines used by gotoNext().
+// Returns -1 if a column can't be array fetched (LOBs, LONG, RAW, ...).
+int QOCICols::fetchBatch(QSqlColumnBatchPrivate *batch, int maxRows, sword *status)
+{
+    struct ArrayDefine
+    {
+        QByteArray buffer;
+        QVector<sb2> ind;
+        ub2 type;
+        sb4 size;
+    };
+
+    batch->init(rec, d->q_func()->numericalPrecisionPolicy(), maxRows);
+    QVector<ArrayDefine> arrays(fieldInf.size());
+    for (int i = 0; i < fieldInf.size(); ++i) {
+        const OraFieldInf &fld = fieldInf.at(i);
+        ArrayDefine &a = arrays[i];
+        if (!fld.defType)
+            return -1;
+        switch (batch->columns.at(i).type) {
+        case QSqlColumnBatch::IntegerColumn:
+            a.type = SQLT_INT;
+            a.size = sizeof(qint64);
+            break;
+        case QSqlColumnBatch::DoubleColumn:
+            a.type = SQLT_FLT;
+            a.size = sizeof(double);
+            break;
+        case QSqlColumnBatch::StringColumn:
+            if (fld.typ != QVariant::String)
+                return -1;
+            a.type = SQLT_STR;
+            a.size = fld.defSize;
+            break;
+        case QSqlColumnBatch::VariantColumn:
+            if (fld.typ != QVariant::DateTime)
+                return -1;
+            a.type = SQLT_DAT;
+            a.size = fld.defSize;
+            break;
+        }
+        a.buffer.fill(0, a.size * maxRows);
+        a.ind.resize(maxRows);
+    }
+
+    int r = OCI_SUCCESS;
+    for (int i = 0; r == OCI_SUCCESS && i < arrays.size(); ++i) {
+        ArrayDefine &a = arrays[i];
+        r = OCIDefineByPos(d->sql,
+                           &fieldInf[i].def,
+                           d->err,
+                           i + 1,
+                           a.buffer.data(),
+                           a.size,
+                           a.type,
+                           a.ind.data(),
+                           0, 0, OCI_DEFAULT);
+        if (r == OCI_SUCCESS && a.type == SQLT_STR)
+            d->setCharset(fieldInf[i].def, OCI_HTYPE_DEFINE);
+    }
+
+    int rows = 0;
+    if (r == OCI_SUCCESS) {
+        // the row count is the number of rows fetched so far
+        ub4 before = 0;
+        ub4 after = 0;
+        OCIAttrGet(d->sql, OCI_HTYPE_STMT, &before, 0, OCI_ATTR_ROW_COUNT, d->err);
+        r = OCIStmtFetch(d->sql, d->err, maxRows, OCI_FETCH_NEXT, OCI_DEFAULT);
+        if (r == OCI_SUCCESS_WITH_INFO || r == OCI_NO_DATA
+            || (r == OCI_ERROR && qOraErrorNumber(d->err) == 1406)) {
+            r = OCI_SUCCESS;
+        }
+        if (r == OCI_SUCCESS) {
+            OCIAttrGet(d->sql, OCI_HTYPE_STMT, &after, 0, OCI_ATTR_ROW_COUNT, d->err);
+            rows = int(after - before);
+        }
+    }
+    *status = r;
+
+    for (int row = 0; row < rows; ++row) {
+        for (int i = 0; i < arrays.size(); ++i) {
+            const ArrayDefine &a = arrays.at(i);
+            if (a.ind.at(row) == -1) {
+                batch->appendNull(i);
+                continue;
+            }
+            const char *value = a.buffer.constData() + row * a.size;
+            switch (a.type) {
+            case SQLT_INT: {
+                qint64 v;
+                memcpy(&v, value, sizeof(v));
+                batch->appendInteger(i, v);
+                break;
+            }
+            case SQLT_FLT: {
+                double v;
+                memcpy(&v, value, sizeof(v));
+                batch->appendDouble(i, v);
+                break;
+            }
+            case SQLT_STR: {
+                const QChar *str = reinterpret_cast<const QChar *>(value);
+                const int maxSize = a.size / int(sizeof(QChar));
+                int size = 0;
+                while (size < maxSize && !str[size].isNull())
+                    ++size;
+                batch->appendText(i, str, size);
+                break;
+            }
+            default:
+                batch->appendVariant(i, QVariant(qMakeDate(value)));
+                break;
+            }
+        }
+    }
+    batch->rowCount = rows;
+
+    for (int i = 0; i < fieldInf.size(); ++i) {
+        if (defineBuffer(i) != OCI_SUCCESS)
+            qOraWarning("QOCICols::fetchBatch: unable to restore define:", d->err);
+    }
+    return rows;
+}
+
 QOCIResultPrivate::QOCIResultPrivate(QOCIResult *q, const QOCIDriver *drv)
     : QSqlCachedResultPrivate(q, drv),
       cols(0),
@@ -1808,7 +1985,8 @@ QOCIResultPrivate::QOCIResultPrivate(QOCIResult *q, const QOCIDriver *drv)
       transaction(drv_d_func()->transaction),
       serverVersion(drv_d_func()->serverVersion),
       prefetchRows(drv_d_func()->prefetchRows),
-      prefetchMem(drv_d_func()->prefetchMem)
+      prefetchMem(drv_d_func()->prefetchMem),
+      batchSize(drv_d_func()->batchSize)
 {
     int r = OCIHandleAlloc(env,
                            reinterpret_cast<void **>(&err),
@@ -1828,6 +2006,34 @@ QOCIResultPrivate::~QOCIResultPrivate()
         qWarning("~QOCIResult: unable to free statement handle");
 }
 
+int QOCIResultPrivate::fetchBatch(QSqlColumnBatchPrivate *batch, int maxRows)
+{
+    Q_Q(QOCIResult);
+    // a scrollable result keeps every row in the cache, it can't skip rows
+    if (!q->isForwardOnly() || !cols || atEnd)
+        return QSqlCachedResultPrivate::fetchBatch(batch, maxRows);
+
+    sword status = OCI_SUCCESS;
+    const int rows = cols->fetchBatch(batch, maxRows, &status);
+    if (rows < 0)
+        return QSqlCachedResultPrivate::fetchBatch(batch, maxRows);
+
+    if (status != OCI_SUCCESS) {
+        qOraWarning("QOCIResult::fetchBatch: ", err);
+        q->setLastError(qMakeError(QCoreApplication::translate("QOCIResult",
+                                   "Unable to goto next"),
+                                   QSqlError::StatementError, err));
+    }
+    if (rows < maxRows)
+        atEnd = true;
+    if (rows > 0) {
+        // the cached row is not the current one anymore
+        cache.fill(QVariant());
+        q->setAt(q->at() == QSql::BeforeFirstRow ? rows - 1 : q->at() + rows);
+    }
+    return rows;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////
 
@@ -2212,6 +2418,10 @@ static void qParseOpts(const QString &options, QOCIDriverPrivate *d)
             d->prefetchMem = val.toInt(&ok);
             if (!ok)
                 d->prefetchMem = -1;
+        } else if (opt == QLatin1String("QOCI_BATCH_SIZE")) {
+            d->batchSize = val.toInt(&ok);
+            if (!ok || d->batchSize < 0)
+                d->batchSize = 0;
         } else {
             qWarning ("QOCIDriver::parseArgs: Invalid parameter: '%s'",
                       opt.toLocal8Bit().constData());
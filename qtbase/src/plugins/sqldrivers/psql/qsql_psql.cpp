@@ -51,6 +51,7 @@
 #include <qsocketnotifier.h>
 #include <qstringlist.h>
 #include <qlocale.h>
+#include <qendian.h>
 #include <QtSql/private/qsqlresult_p.h>
 #include <QtSql/private/qsqldriver_p.h>
 
@@ -59,6 +60,7 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include <limits>
 // below code taken from an example at http://www.gnu.org/software/hello/manual/autoconf/Function-Portability.html
 #ifndef isnan
     # define isnan(x) \
@@ -98,6 +100,10 @@
 #define QTIMESTAMPTZOID 1184
 #define QOIDOID 2278
 #define QBYTEAOID 17
+#define QNAMEOID 19
+#define QTEXTOID 25
+#define QBPCHAROID 1042
+#define QVARCHAROID 1043
 #define QREGPROCOID 24
 #define QXIDOID 28
 #define QCIDOID 29
@@ -107,6 +113,11 @@
 
 #define VARHDRSZ 4
 
+// PQsetSingleRowMode() was added in 9.2
+#if defined PG_VERSION_NUM && PG_VERSION_NUM-0 >= 90200
+#  define QT_PSQL_SINGLE_ROW_MODE
+#endif
+
 /* This is a compile time switch - if PQfreemem is declared, the compiler will use that one,
    otherwise it'll run in this template */
 template <typename T>
@@ -152,6 +163,17 @@ protected:
     QVariant lastInsertId() const Q_DECL_OVERRIDE;
     bool prepare(const QString &query) Q_DECL_OVERRIDE;
     bool exec() Q_DECL_OVERRIDE;
+    bool execBatch(bool arrayBind = false) Q_DECL_OVERRIDE;
+};
+
+// Parameters of a statement executed through PQexecPrepared() or
+// PQsendQueryPrepared(), in libpq's text format except for bytea
+struct QPSQLParams
+{
+    QVector<QByteArray> data;
+    QVector<const char *> values;
+    QVector<int> lengths;
+    QVector<int> formats;
 };
 
 class QPSQLDriverPrivate : public QSqlDriverPrivate
@@ -164,7 +186,12 @@ public:
         pro(QPSQLDriver::Version6),
         sn(0),
         pendingNotifyCheck(false),
-        hasBackslashEscape(false)
+        hasBackslashEscape(false),
+        integerDatetimes(false),
+        binaryProtocol(false),
+        pipelineSize(256),
+        singleRowMode(false),
+        streamingResult(0)
     { dbmsType = QSqlDriver::PostgreSQL; }
 
     PGconn *connection;
@@ -174,10 +201,23 @@ public:
     QStringList seid;
     mutable bool pendingNotifyCheck;
     bool hasBackslashEscape;
+    bool integerDatetimes;
+    // QPSQL_BINARY_PROTOCOL: run prepared queries through PQexecPrepared()
+    bool binaryProtocol;
+    int pipelineSize;
+    // QPSQL_SINGLE_ROW_MODE: stream forward-only queries one row at a time
+    bool singleRowMode;
+    // the result still receiving rows, libpq allows only one per connection
+    mutable QPSQLResultPrivate *streamingResult;
 
     void appendTables(QStringList &tl, QSqlQuery &t, QChar type);
     PGresult * exec(const char * stmt) const;
     PGresult * exec(const QString & stmt) const;
+    PGresult * execPrepared(const QByteArray &stmtId, const QPSQLParams &params, int resultFormat) const;
+    bool sendQuery(const QString &stmt) const;
+    bool sendQueryPrepared(const QByteArray &stmtId, const QPSQLParams &params, int resultFormat) const;
+    void checkPendingNotifications() const;
+    void finishStreaming() const;
     QPSQLDriver::Protocol getPSQLVersion();
     bool setEncodingUtf8();
     void setDatestyle();
@@ -210,14 +250,31 @@ void QPSQLDriverPrivate::appendTables(QStringList &tl, QSqlQuery &t, QChar type)
     }
 }
 
-PGresult * QPSQLDriverPrivate::exec(const char * stmt) const
+void QPSQLDriverPrivate::checkPendingNotifications() const
 {
     Q_Q(const QPSQLDriver);
-    PGresult *result = PQexec(connection, stmt);
     if (seid.size() && !pendingNotifyCheck) {
         pendingNotifyCheck = true;
         QMetaObject::invokeMethod(const_cast<QPSQLDriver*>(q), "_q_handleNotification", Qt::QueuedConnection, Q_ARG(int,0));
     }
+}
+
+PGresult * QPSQLDriverPrivate::exec(const char * stmt) const
+{
+    finishStreaming();
+    PGresult *result = PQexec(connection, stmt);
+    checkPendingNotifications();
+    return result;
+}
+
+PGresult * QPSQLDriverPrivate::execPrepared(const QByteArray &stmtId, const QPSQLParams &params,
+                                            int resultFormat) const
+{
+    finishStreaming();
+    PGresult *result = PQexecPrepared(connection, stmtId.constData(), params.values.size(),
+                                      params.values.constData(), params.lengths.constData(),
+                                      params.formats.constData(), resultFormat);
+    checkPendingNotifications();
     return result;
 }
 
@@ -226,6 +283,25 @@ PGresult * QPSQLDriverPrivate::exec(const QString & stmt) const
     return exec(isUtf8 ? stmt.toUtf8().constData() : stmt.toLocal8Bit().constData());
 }
 
+bool QPSQLDriverPrivate::sendQuery(const QString &stmt) const
+{
+    finishStreaming();
+    const bool ok = PQsendQuery(connection, isUtf8 ? stmt.toUtf8().constData() : stmt.toLocal8Bit().constData());
+    checkPendingNotifications();
+    return ok;
+}
+
+bool QPSQLDriverPrivate::sendQueryPrepared(const QByteArray &stmtId, const QPSQLParams &params,
+                                           int resultFormat) const
+{
+    finishStreaming();
+    const bool ok = PQsendQueryPrepared(connection, stmtId.constData(), params.values.size(),
+                                        params.values.constData(), params.lengths.constData(),
+                                        params.formats.constData(), resultFormat);
+    checkPendingNotifications();
+    return ok;
+}
+
 class QPSQLResultPrivate : public QSqlResultPrivate
 {
     Q_DECLARE_PUBLIC(QPSQLResult)
@@ -235,7 +311,10 @@ public:
       : QSqlResultPrivate(q, drv),
         result(0),
         currentSize(-1),
-        preparedQueriesEnabled(false)
+        preparedQueriesEnabled(false),
+        binaryResults(false),
+        singleRowMode(false),
+        streamPending(false)
     { }
 
     QString fieldSerial(int i) const Q_DECL_OVERRIDE { return QLatin1Char('$') + QString::number(i + 1); }
@@ -244,9 +323,25 @@ public:
     PGresult *result;
     int currentSize;
     bool preparedQueriesEnabled;
+    // all columns of the prepared statement can be fetched in binary format
+    bool binaryResults;
+    // the current result set is streamed, result holds only the current row
+    bool singleRowMode;
+    // more rows of the result set are waiting in the connection
+    bool streamPending;
     QString preparedStmtId;
 
     bool processResults();
+    bool describePreparedStmt();
+    int currentRow() const { return singleRowMode ? 0 : q_func()->at(); }
+    bool useSingleRowMode() const;
+    bool startStreaming();
+    bool fetchNextRow();
+    void finishStream();
+#ifdef LIBPQ_HAS_PIPELINING
+    bool execPipelined();
+    bool collectPipelineResults(int sent);
+#endif
 };
 
 static QSqlError qMakeError(const QString& err, QSqlError::ErrorType type,
@@ -285,6 +380,92 @@ bool QPSQLResultPrivate::processResults()
     return false;
 }
 
+bool QPSQLResultPrivate::useSingleRowMode() const
+{
+#ifdef QT_PSQL_SINGLE_ROW_MODE
+    return drv_d_func()->singleRowMode && q_func()->isForwardOnly();
+#else
+    return false;
+#endif
+}
+
+// Called right after a query was sent with PQsendQuery() or PQsendQueryPrepared().
+// Reads the first result, which tells whether the query returns rows at all.
+bool QPSQLResultPrivate::startStreaming()
+{
+#ifdef QT_PSQL_SINGLE_ROW_MODE
+    Q_Q(QPSQLResult);
+    QPSQLDriverPrivate *driver = drv_d_func();
+    if (!PQsetSingleRowMode(driver->connection)) {
+        // the whole result set arrives at once, there is only the trailing null result to drain
+        result = PQgetResult(driver->connection);
+        while (PGresult *next = PQgetResult(driver->connection))
+            PQclear(next);
+        return processResults();
+    }
+
+    singleRowMode = true;
+    streamPending = true;
+    driver->streamingResult = this;
+    result = PQgetResult(driver->connection);
+    if (result && PQresultStatus(result) == PGRES_SINGLE_TUPLE) {
+        q->setSelect(true);
+        q->setActive(true);
+        currentSize = -1;
+        return true;
+    }
+    // no rows, a command or an error: the result set is already complete
+    finishStream();
+    return processResults();
+#else
+    return false;
+#endif
+}
+
+// Replaces the current row by the next one. At the end of the result set the
+// last row is kept, so record() still has the field information.
+bool QPSQLResultPrivate::fetchNextRow()
+{
+#ifdef QT_PSQL_SINGLE_ROW_MODE
+    Q_Q(QPSQLResult);
+    if (!streamPending)
+        return false;
+    PGresult *next = PQgetResult(drv_d_func()->connection);
+    if (next && PQresultStatus(next) == PGRES_SINGLE_TUPLE) {
+        PQclear(result);
+        result = next;
+        return true;
+    }
+    if (next && PQresultStatus(next) != PGRES_TUPLES_OK) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Unable to fetch row"), QSqlError::StatementError, drv_d_func(), next));
+    }
+    PQclear(next);
+    finishStream();
+#endif
+    return false;
+}
+
+// Drains whatever is left of the streamed result set, so that the connection
+// can be used for the next query. The rows are read and thrown away.
+void QPSQLResultPrivate::finishStream()
+{
+    QPSQLDriverPrivate *driver = drv_d_func();
+    if (streamPending && driver && driver->connection) {
+        while (PGresult *next = PQgetResult(driver->connection))
+            PQclear(next);
+    }
+    streamPending = false;
+    if (driver && driver->streamingResult == this)
+        driver->streamingResult = 0;
+}
+
+void QPSQLDriverPrivate::finishStreaming() const
+{
+    if (streamingResult)
+        streamingResult->finishStream();
+}
+
 static QVariant::Type qDecodePSQLType(int t)
 {
     QVariant::Type type = QVariant::Invalid;
@@ -331,6 +512,107 @@ static QVariant::Type qDecodePSQLType(int t)
     return type;
 }
 
+// Types whose binary representation is decoded by qDecodePSQLBinaryValue().
+// Anything else (numeric, intervals, arrays, ...) keeps the text format.
+static bool qIsBinaryPSQLType(int t, bool integerDatetimes)
+{
+    switch (t) {
+    case QBOOLOID:
+    case QINT2OID:
+    case QINT4OID:
+    case QINT8OID:
+    case QFLOAT4OID:
+    case QFLOAT8OID:
+    case QBYTEAOID:
+    case QNAMEOID:
+    case QTEXTOID:
+    case QBPCHAROID:
+    case QVARCHAROID:
+        return true;
+#ifndef QT_NO_DATESTRING
+    case QDATEOID:
+        return true;
+    case QTIMEOID:
+    case QTIMESTAMPOID:
+    case QTIMESTAMPTZOID:
+        // servers built without integer datetimes send them as doubles
+        return integerDatetimes;
+#endif
+    default:
+        return false;
+    }
+}
+
+static const qint64 qPSQLUsecsPerDay = Q_INT64_C(86400000000);
+
+// date and timestamp values are relative to 2000-01-01 on the wire
+static QDate qPSQLEpoch()
+{
+    return QDate(2000, 1, 1);
+}
+
+static QDateTime qDecodePSQLBinaryTimestamp(qint64 usecs, Qt::TimeSpec spec)
+{
+    // +/-infinity
+    if (usecs == std::numeric_limits<qint64>::max() || usecs == std::numeric_limits<qint64>::min())
+        return QDateTime();
+    qint64 days = usecs / qPSQLUsecsPerDay;
+    qint64 rest = usecs % qPSQLUsecsPerDay;
+    if (rest < 0) {
+        rest += qPSQLUsecsPerDay;
+        --days;
+    }
+    return QDateTime(qPSQLEpoch().addDays(days), QTime::fromMSecsSinceStartOfDay(int(rest / 1000)), spec);
+}
+
+// Produces the same QVariant as the text decoding in QPSQLResult::data()
+static QVariant qDecodePSQLBinaryValue(int ptype, const char *val, int len, bool isUtf8)
+{
+    switch (ptype) {
+    case QBOOLOID:
+        return QVariant(bool(val[0] != 0));
+    case QINT2OID:
+        return int(qFromBigEndian<qint16>(val));
+    case QINT4OID:
+        return int(qFromBigEndian<qint32>(val));
+    case QINT8OID: {
+        const qint64 v = qFromBigEndian<qint64>(val);
+        if (v < 0)
+            return qlonglong(v);
+        return qulonglong(v);
+    }
+    case QFLOAT4OID: {
+        const quint32 bits = qFromBigEndian<quint32>(val);
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return double(f);
+    }
+    case QFLOAT8OID: {
+        const quint64 bits = qFromBigEndian<quint64>(val);
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
+    case QBYTEAOID:
+        return QByteArray(val, len);
+    case QDATEOID: {
+        const qint32 days = qFromBigEndian<qint32>(val);
+        if (days == std::numeric_limits<qint32>::max() || days == std::numeric_limits<qint32>::min())
+            return QVariant(QDate());
+        return QVariant(qPSQLEpoch().addDays(days));
+    }
+    case QTIMEOID:
+        return QVariant(QTime::fromMSecsSinceStartOfDay(int(qFromBigEndian<qint64>(val) / 1000)));
+    case QTIMESTAMPOID:
+        return QVariant(qDecodePSQLBinaryTimestamp(qFromBigEndian<qint64>(val), Qt::LocalTime));
+    case QTIMESTAMPTZOID:
+        return QVariant(qDecodePSQLBinaryTimestamp(qFromBigEndian<qint64>(val), Qt::UTC).toLocalTime());
+    default:
+        // text types are sent as is
+        return isUtf8 ? QString::fromUtf8(val, len) : QString::fromLatin1(val, len);
+    }
+}
+
 void QPSQLResultPrivate::deallocatePreparedStmt()
 {
     const QString stmt = QLatin1String("DEALLOCATE ") + preparedStmtId;
@@ -367,6 +649,8 @@ QVariant QPSQLResult::handle() const
 void QPSQLResult::cleanup()
 {
     Q_D(QPSQLResult);
+    d->finishStream();
+    d->singleRowMode = false;
     if (d->result)
         PQclear(d->result);
     d->result = 0;
@@ -377,11 +661,30 @@ void QPSQLResult::cleanup()
 
 bool QPSQLResult::fetch(int i)
 {
-    Q_D(const QPSQLResult);
+    Q_D(QPSQLResult);
     if (!isActive())
         return false;
     if (i < 0)
         return false;
+#ifdef QT_PSQL_SINGLE_ROW_MODE
+    if (d->singleRowMode) {
+        // rows arrive one by one and can only be read moving forward
+        if (at() == QSql::AfterLastRow || i < at())
+            return false;
+        // the first row was received by exec()
+        if (at() == QSql::BeforeFirstRow) {
+            if (PQresultStatus(d->result) != PGRES_SINGLE_TUPLE)
+                return false;
+            setAt(0);
+        }
+        while (at() < i) {
+            if (!d->fetchNextRow())
+                return false;
+            setAt(at() + 1);
+        }
+        return true;
+    }
+#endif
     if (i >= d->currentSize)
         return false;
     if (at() == i)
@@ -397,7 +700,18 @@ bool QPSQLResult::fetchFirst()
 
 bool QPSQLResult::fetchLast()
 {
-    Q_D(const QPSQLResult);
+    Q_D(QPSQLResult);
+    if (d->singleRowMode) {
+        if (at() == QSql::BeforeFirstRow && !fetch(0))
+            return false;
+        if (at() < 0)
+            return false;
+        int row = at();
+        while (d->fetchNextRow())
+            ++row;
+        setAt(row);
+        return true;
+    }
     return fetch(PQntuples(d->result) - 1);
 }
 
@@ -410,9 +724,12 @@ QVariant QPSQLResult::data(int i)
     }
     int ptype = PQftype(d->result, i);
     QVariant::Type type = qDecodePSQLType(ptype);
-    const char *val = PQgetvalue(d->result, at(), i);
-    if (PQgetisnull(d->result, at(), i))
+    const int row = d->currentRow();
+    const char *val = PQgetvalue(d->result, row, i);
+    if (PQgetisnull(d->result, row, i))
         return QVariant(type);
+    if (PQfformat(d->result, i) == 1)
+        return qDecodePSQLBinaryValue(ptype, val, PQgetlength(d->result, row, i), d->drv_d_func()->isUtf8);
     switch (type) {
     case QVariant::Bool:
         return QVariant((bool)(val[0] == 't'));
@@ -496,8 +813,9 @@ QVariant QPSQLResult::data(int i)
 bool QPSQLResult::isNull(int field)
 {
     Q_D(const QPSQLResult);
-    PQgetvalue(d->result, at(), field);
-    return PQgetisnull(d->result, at(), field);
+    const int row = d->currentRow();
+    PQgetvalue(d->result, row, field);
+    return PQgetisnull(d->result, row, field);
 }
 
 bool QPSQLResult::reset (const QString& query)
@@ -508,6 +826,14 @@ bool QPSQLResult::reset (const QString& query)
         return false;
     if (!driver()->isOpen() || driver()->isOpenError())
         return false;
+    if (d->useSingleRowMode()) {
+        if (!d->drv_d_func()->sendQuery(query)) {
+            setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                         "Unable to create query"), QSqlError::StatementError, d->drv_d_func()));
+            return false;
+        }
+        return d->startStreaming();
+    }
     d->result = d->drv_d_func()->exec(query);
     return d->processResults();
 }
@@ -556,7 +882,8 @@ QSqlRecord QPSQLResult::record() const
             f.setName(QString::fromLocal8Bit(PQfname(d->result, i)));
         const int tableOid = PQftable(d->result, i);
         auto &tableName = d->drv_d_func()->oidToTable[tableOid];
-        if (tableName.isEmpty()) {
+        // looking the name up would run a query and end the stream
+        if (tableName.isEmpty() && !d->streamPending) {
             QSqlQuery qry(driver()->createResult());
             if (qry.exec(QStringLiteral("SELECT relname FROM pg_class WHERE pg_class.oid = %1")
                          .arg(tableOid)) && qry.next()) {
@@ -630,6 +957,70 @@ static QString qCreateParamString(const QVector<QVariant> &boundValues, const QS
     return params;
 }
 
+static QByteArray qPSQLFloatParam(double value)
+{
+    if (isnan(value))
+        return QByteArrayLiteral("NaN");
+    if (isinf(value))
+        return value < 0 ? QByteArrayLiteral("-Infinity") : QByteArrayLiteral("Infinity");
+    return QByteArray::number(value, 'g', 17);
+}
+
+static void qCreateParams(const QVector<QVariant> &boundValues, bool isUtf8, QPSQLParams *params)
+{
+    const int count = boundValues.count();
+    params->data.resize(count);
+    params->values.fill(Q_NULLPTR, count);
+    params->lengths.fill(0, count);
+    params->formats.fill(0, count);
+
+    for (int i = 0; i < count; ++i) {
+        const QVariant &val = boundValues.at(i);
+        if (val.isNull())
+            continue;
+
+        QByteArray &data = params->data[i];
+        switch (int(val.type())) {
+        case QVariant::Bool:
+            data = val.toBool() ? QByteArrayLiteral("t") : QByteArrayLiteral("f");
+            break;
+        case QVariant::ByteArray:
+            data = val.toByteArray();
+            params->formats[i] = 1;
+            break;
+        case QMetaType::Float:
+        case QVariant::Double:
+            data = qPSQLFloatParam(val.toDouble());
+            break;
+#ifndef QT_NO_DATESTRING
+        case QVariant::Date:
+            if (!val.toDate().isValid())
+                continue;
+            data = val.toDate().toString(Qt::ISODate).toLatin1();
+            break;
+        case QVariant::Time:
+            if (!val.toTime().isValid())
+                continue;
+            data = val.toTime().toString(QLatin1String("hh:mm:ss.zzz")).toLatin1();
+            break;
+        case QVariant::DateTime: {
+            // keep the offset so that both timestamp and timestamptz columns get the right value
+            const QDateTime dt = val.toDateTime();
+            if (!dt.isValid())
+                continue;
+            data = dt.toOffsetFromUtc(dt.offsetFromUtc()).toString(Qt::ISODateWithMs).toLatin1();
+            break;
+        }
+#endif
+        default:
+            data = isUtf8 ? val.toString().toUtf8() : val.toString().toLocal8Bit();
+            break;
+        }
+        params->values[i] = data.constData();
+        params->lengths[i] = data.size();
+    }
+}
+
 QString qMakePreparedStmtId()
 {
     static QBasicAtomicInt qPreparedStmtCount = Q_BASIC_ATOMIC_INITIALIZER(0);
@@ -663,9 +1054,24 @@ bool QPSQLResult::prepare(const QString &query)
 
     PQclear(result);
     d->preparedStmtId = stmtId;
+    if (d->drv_d_func()->binaryProtocol)
+        d->binaryResults = d->describePreparedStmt();
     return true;
 }
 
+bool QPSQLResultPrivate::describePreparedStmt()
+{
+    // libpq can only ask for all columns in text or all of them in binary,
+    // so binary results are used only if every column type can be decoded
+    drv_d_func()->finishStreaming();
+    PGresult *result = PQdescribePrepared(drv_d_func()->connection, preparedStmtId.toLatin1().constData());
+    bool binary = PQresultStatus(result) == PGRES_COMMAND_OK;
+    for (int i = 0; binary && i < PQnfields(result); ++i)
+        binary = qIsBinaryPSQLType(PQftype(result, i), drv_d_func()->integerDatetimes);
+    PQclear(result);
+    return binary;
+}
+
 bool QPSQLResult::exec()
 {
     Q_D(QPSQLResult);
@@ -674,6 +1080,23 @@ bool QPSQLResult::exec()
 
     cleanup();
 
+    if (d->drv_d_func()->binaryProtocol) {
+        QPSQLParams params;
+        qCreateParams(boundValues(), d->drv_d_func()->isUtf8, &params);
+        if (d->useSingleRowMode()) {
+            if (!d->drv_d_func()->sendQueryPrepared(d->preparedStmtId.toLatin1(), params,
+                                                    d->binaryResults ? 1 : 0)) {
+                setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                             "Unable to create query"), QSqlError::StatementError, d->drv_d_func()));
+                return false;
+            }
+            return d->startStreaming();
+        }
+        d->result = d->drv_d_func()->execPrepared(d->preparedStmtId.toLatin1(), params,
+                                                  d->binaryResults ? 1 : 0);
+        return d->processResults();
+    }
+
     QString stmt;
     const QString params = qCreateParamString(boundValues(), driver());
     if (params.isEmpty())
@@ -681,11 +1104,140 @@ bool QPSQLResult::exec()
     else
         stmt = QString::fromLatin1("EXECUTE %1 (%2)").arg(d->preparedStmtId, params);
 
+    if (d->useSingleRowMode()) {
+        if (!d->drv_d_func()->sendQuery(stmt)) {
+            setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                         "Unable to create query"), QSqlError::StatementError, d->drv_d_func()));
+            return false;
+        }
+        return d->startStreaming();
+    }
+
     d->result = d->drv_d_func()->exec(stmt);
 
     return d->processResults();
 }
 
+bool QPSQLResult::execBatch(bool arrayBind)
+{
+#ifdef LIBPQ_HAS_PIPELINING
+    Q_D(QPSQLResult);
+    if (d->preparedQueriesEnabled && !d->preparedStmtId.isEmpty() && d->drv_d_func()->binaryProtocol
+        && d->drv_d_func()->pipelineSize > 0) {
+        return d->execPipelined();
+    }
+#endif
+    return QSqlResult::execBatch(arrayBind);
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+bool QPSQLResultPrivate::execPipelined()
+{
+    Q_Q(QPSQLResult);
+    const QVector<QVariant> values = q->boundValues();
+    if (values.isEmpty())
+        return false;
+
+    PGconn *connection = drv_d_func()->connection;
+    q->cleanup();
+    q->setLastError(QSqlError());
+    drv_d_func()->finishStreaming();
+    if (!PQenterPipelineMode(connection))
+        return q->QSqlResult::execBatch();
+
+    QVector<QVariantList> columns;
+    columns.reserve(values.count());
+    for (const QVariant &value : values)
+        columns.append(value.toList());
+
+    const QByteArray stmtId = preparedStmtId.toLatin1();
+    const int resultFormat = binaryResults ? 1 : 0;
+    const int count = columns.at(0).count();
+    const int batchSize = drv_d_func()->pipelineSize;
+    QVector<QVariant> row(columns.count());
+    bool ok = true;
+
+    // Queue up to pipelineSize executions before each sync point, so that
+    // libpq never blocks writing while the server waits for us to read
+    for (int first = 0; ok && first < count; first += batchSize) {
+        const int last = qMin(count, first + batchSize);
+        int sent = 0;
+        for (int i = first; i < last; ++i) {
+            for (int j = 0; j < columns.count(); ++j)
+                row[j] = columns.at(j).value(i);
+            QPSQLParams params;
+            qCreateParams(row, drv_d_func()->isUtf8, &params);
+            if (!PQsendQueryPrepared(connection, stmtId.constData(), params.values.size(),
+                                     params.values.constData(), params.lengths.constData(),
+                                     params.formats.constData(), resultFormat)) {
+                ok = false;
+                break;
+            }
+            ++sent;
+        }
+        if (!PQpipelineSync(connection)) {
+            q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                            "Unable to execute batch"), QSqlError::StatementError, drv_d_func()));
+            ok = false;
+            break;
+        }
+        if (!collectPipelineResults(sent))
+            ok = false;
+    }
+
+    PQexitPipelineMode(connection);
+    drv_d_func()->checkPendingNotifications();
+    if (!ok) {
+        if (!q->lastError().isValid()) {
+            q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                            "Unable to execute batch"), QSqlError::StatementError, drv_d_func()));
+        }
+        return false;
+    }
+    return processResults();
+}
+
+bool QPSQLResultPrivate::collectPipelineResults(int sent)
+{
+    Q_Q(QPSQLResult);
+    PGconn *connection = drv_d_func()->connection;
+    bool ok = true;
+    // each execution is terminated by a null result, the batch by the sync result
+    int pending = sent;
+    for (;;) {
+        PGresult *res = PQgetResult(connection);
+        if (!res) {
+            if (--pending < 0 || PQstatus(connection) == CONNECTION_BAD)
+                return false;
+            continue;
+        }
+        switch (PQresultStatus(res)) {
+        case PGRES_PIPELINE_SYNC:
+            PQclear(res);
+            return ok;
+        case PGRES_COMMAND_OK:
+        case PGRES_TUPLES_OK:
+            // keep the last one for numRowsAffected()
+            if (result)
+                PQclear(result);
+            result = res;
+            break;
+        case PGRES_PIPELINE_ABORTED:
+            PQclear(res);
+            break;
+        default:
+            if (ok) {
+                q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                "Unable to execute batch"), QSqlError::StatementError, drv_d_func(), res));
+            }
+            ok = false;
+            PQclear(res);
+            break;
+        }
+    }
+}
+#endif
+
 ///////////////////////////////////////////////////////////////////
 
 bool QPSQLDriverPrivate::setEncodingUtf8()
@@ -956,11 +1508,36 @@ bool QPSQLDriver::open(const QString & db,
     if (port != -1)
         connectString.append(QLatin1String(" port=")).append(qQuote(QString::number(port)));
 
-    // add any connect options - the server will handle error detection
+    // add any connect options - the server will handle error detection,
+    // except for the QPSQL_ ones which are handled by the driver
+    bool binaryProtocol = false;
+    bool singleRowMode = false;
+    int pipelineSize = 256;
     if (!connOpts.isEmpty()) {
-        QString opt = connOpts;
-        opt.replace(QLatin1Char(';'), QLatin1Char(' '), Qt::CaseInsensitive);
-        connectString.append(QLatin1Char(' ')).append(opt);
+        QStringList opts;
+        const QStringList raw = connOpts.split(QLatin1Char(';'), QString::SkipEmptyParts);
+        for (const QString &tmp : raw) {
+            const QString opt = tmp.trimmed();
+            if (opt == QLatin1String("QPSQL_BINARY_PROTOCOL")) {
+                binaryProtocol = true;
+            } else if (opt == QLatin1String("QPSQL_SINGLE_ROW_MODE")) {
+#ifdef QT_PSQL_SINGLE_ROW_MODE
+                singleRowMode = true;
+#else
+                qWarning("QPSQLDriver::open: QPSQL_SINGLE_ROW_MODE requires libpq 9.2 or later");
+#endif
+            } else if (opt.startsWith(QLatin1String("QPSQL_PIPELINE_SIZE="))) {
+                bool ok;
+                const int size = opt.midRef(20).toInt(&ok);
+                if (ok && size >= 0)
+                    pipelineSize = size;
+                else
+                    qWarning("QPSQLDriver::open: Illegal connect option value '%s'", opt.toLocal8Bit().constData());
+            } else {
+                opts.append(opt);
+            }
+        }
+        connectString.append(QLatin1Char(' ')).append(opts.join(QLatin1Char(' ')));
     }
 
     d->connection = PQconnectdb(std::move(connectString).toLocal8Bit().constData());
@@ -978,6 +1555,15 @@ bool QPSQLDriver::open(const QString & db,
     d->setDatestyle();
     d->setByteaOutput();
 
+    // the binary protocol needs the extended query protocol introduced in 7.4
+    d->binaryProtocol = binaryProtocol && d->pro >= QPSQLDriver::Version7_4;
+    if (binaryProtocol && !d->binaryProtocol)
+        qWarning("QPSQLDriver::open: QPSQL_BINARY_PROTOCOL requires PostgreSQL 7.4 or later");
+    d->pipelineSize = pipelineSize;
+    d->singleRowMode = singleRowMode;
+    const char *integerDatetimes = PQparameterStatus(d->connection, "integer_datetimes");
+    d->integerDatetimes = integerDatetimes && qstrcmp(integerDatetimes, "on") == 0;
+
     setOpen(true);
     setOpenError(false);
     return true;
@@ -995,6 +1581,12 @@ void QPSQLDriver::close()
             d->sn = 0;
         }
 
+        // the result set can't be drained anymore
+        if (d->streamingResult) {
+            d->streamingResult->streamPending = false;
+            d->streamingResult = 0;
+        }
+
         if (d->connection)
             PQfinish(d->connection);
         d->connection = 0;
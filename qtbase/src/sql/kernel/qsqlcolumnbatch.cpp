@@ -0,0 +1,369 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsqlcolumnbatch.h"
+#include "qsqlcolumnbatch_p.h"
+
+#include "qsqlfield.h"
+
+QT_BEGIN_NAMESPACE
+
+QSqlColumnBatch::ColumnType QSqlColumnBatchPrivate::columnType(QVariant::Type type,
+                                                               QSql::NumericalPrecisionPolicy policy)
+{
+    switch (type) {
+    case QVariant::Bool:
+    case QVariant::Int:
+    case QVariant::UInt:
+    case QVariant::LongLong:
+        return QSqlColumnBatch::IntegerColumn;
+    case QVariant::Double:
+        switch (policy) {
+        case QSql::LowPrecisionInt32:
+        case QSql::LowPrecisionInt64:
+            return QSqlColumnBatch::IntegerColumn;
+        case QSql::LowPrecisionDouble:
+            return QSqlColumnBatch::DoubleColumn;
+        case QSql::HighPrecision:
+        default:
+            return QSqlColumnBatch::StringColumn;
+        }
+    case QVariant::String:
+        return QSqlColumnBatch::StringColumn;
+    default:
+        return QSqlColumnBatch::VariantColumn;
+    }
+}
+
+void QSqlColumnBatchPrivate::init(const QSqlRecord &rec, QSql::NumericalPrecisionPolicy policy, int reserve)
+{
+    record = rec;
+    rowCount = 0;
+    columns.resize(rec.count());
+    for (int i = 0; i < columns.count(); ++i) {
+        Column &c = columns[i];
+        c = Column();
+        c.type = columnType(rec.field(i).type(), policy);
+        c.nulls.reserve(reserve);
+        switch (c.type) {
+        case QSqlColumnBatch::IntegerColumn:
+            c.integers.reserve(reserve);
+            break;
+        case QSqlColumnBatch::DoubleColumn:
+            c.doubles.reserve(reserve);
+            break;
+        case QSqlColumnBatch::StringColumn:
+            c.offsets.reserve(reserve + 1);
+            c.offsets.append(0);
+            break;
+        case QSqlColumnBatch::VariantColumn:
+            c.variants.reserve(reserve);
+            break;
+        }
+    }
+}
+
+void QSqlColumnBatchPrivate::appendNull(int column)
+{
+    Column &c = columns[column];
+    c.nulls.append(true);
+    switch (c.type) {
+    case QSqlColumnBatch::IntegerColumn:
+        c.integers.append(0);
+        break;
+    case QSqlColumnBatch::DoubleColumn:
+        c.doubles.append(0.0);
+        break;
+    case QSqlColumnBatch::StringColumn:
+        c.offsets.append(c.text.size());
+        break;
+    case QSqlColumnBatch::VariantColumn:
+        c.variants.append(QVariant(record.field(column).type()));
+        break;
+    }
+}
+
+void QSqlColumnBatchPrivate::appendVariant(int column, const QVariant &value)
+{
+    Column &c = columns[column];
+    c.nulls.append(value.isNull());
+    c.variants.append(value);
+}
+
+void QSqlColumnBatchPrivate::appendValue(int column, const QVariant &value)
+{
+    if (value.isNull()) {
+        appendNull(column);
+        return;
+    }
+    switch (columns.at(column).type) {
+    case QSqlColumnBatch::IntegerColumn:
+        appendInteger(column, value.toLongLong());
+        break;
+    case QSqlColumnBatch::DoubleColumn:
+        appendDouble(column, value.toDouble());
+        break;
+    case QSqlColumnBatch::StringColumn: {
+        const QString str = value.toString();
+        appendText(column, str.constData(), str.size());
+        break;
+    }
+    case QSqlColumnBatch::VariantColumn:
+        appendVariant(column, value);
+        break;
+    }
+}
+
+/*!
+    \class QSqlColumnBatch
+    \brief The QSqlColumnBatch class holds a block of rows fetched column by column.
+    \since 5.11
+
+    \ingroup database
+    \inmodule QtSql
+
+    QSqlQuery::fetchBatch() returns the next rows of a result set as a
+    QSqlColumnBatch. Instead of one QVariant per value, each column is
+    stored in one buffer of its natural type: integer columns as a
+    QVector<qint64>, floating point columns as a QVector<double> and
+    string columns as a single string all values are viewed from. This
+    avoids most of the per-value allocations of QSqlQuery::value().
+
+    The storage of a column is given by columnType(). It depends on the
+    type of the field in QSqlQuery::record() and, for floating point
+    fields, on the query's numerical precision policy. Values of other
+    types, such as dates or binary data, are kept as QVariants.
+
+    Null values are reported by isNull(). In the typed buffers they are
+    stored as 0 or as an empty string.
+
+    QSqlColumnBatch is implicitly shared.
+
+    \sa QSqlQuery::fetchBatch()
+*/
+
+/*!
+    \enum QSqlColumnBatch::ColumnType
+
+    This enum describes how the values of a column are stored.
+
+    \value VariantColumn The values are available from variants().
+    \value IntegerColumn Boolean and integer values, and numbers fetched
+           with QSql::LowPrecisionInt32 or QSql::LowPrecisionInt64.
+           The values are available from integers().
+    \value DoubleColumn Numbers fetched with QSql::LowPrecisionDouble.
+           The values are available from doubles().
+    \value StringColumn Strings, and numbers fetched with
+           QSql::HighPrecision. The values are available from text().
+*/
+
+/*!
+    Constructs an empty batch.
+*/
+QSqlColumnBatch::QSqlColumnBatch()
+    : d(new QSqlColumnBatchPrivate)
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QSqlColumnBatch::QSqlColumnBatch(const QSqlColumnBatch &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Assigns \a other to this batch.
+*/
+QSqlColumnBatch &QSqlColumnBatch::operator=(const QSqlColumnBatch &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QSqlColumnBatch &QSqlColumnBatch::operator=(QSqlColumnBatch &&other)
+
+    Move-assigns \a other to this batch.
+*/
+
+/*!
+    Destroys the batch.
+*/
+QSqlColumnBatch::~QSqlColumnBatch()
+{
+}
+
+/*!
+    \fn void QSqlColumnBatch::swap(QSqlColumnBatch &other)
+
+    Swaps this batch with \a other. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    Returns \c true if the batch contains no rows.
+*/
+bool QSqlColumnBatch::isEmpty() const
+{
+    return d->rowCount == 0;
+}
+
+/*!
+    Returns the number of rows in the batch.
+*/
+int QSqlColumnBatch::rowCount() const
+{
+    return d->rowCount;
+}
+
+/*!
+    Returns the number of columns in the batch.
+*/
+int QSqlColumnBatch::columnCount() const
+{
+    return d->columns.count();
+}
+
+/*!
+    Returns how the values of \a column are stored.
+*/
+QSqlColumnBatch::ColumnType QSqlColumnBatch::columnType(int column) const
+{
+    if (column < 0 || column >= d->columns.count())
+        return VariantColumn;
+    return d->columns.at(column).type;
+}
+
+/*!
+    Returns \c true if the value in \a row and \a column is null, or if
+    there is no such value.
+*/
+bool QSqlColumnBatch::isNull(int row, int column) const
+{
+    if (column < 0 || column >= d->columns.count() || row < 0 || row >= d->rowCount)
+        return true;
+    return d->columns.at(column).nulls.at(row);
+}
+
+/*!
+    Returns the values of \a column, which must be an
+    \l{IntegerColumn}. Returns an empty vector for other columns.
+*/
+QVector<qint64> QSqlColumnBatch::integers(int column) const
+{
+    if (column < 0 || column >= d->columns.count())
+        return QVector<qint64>();
+    return d->columns.at(column).integers;
+}
+
+/*!
+    Returns the values of \a column, which must be a
+    \l{DoubleColumn}. Returns an empty vector for other columns.
+*/
+QVector<double> QSqlColumnBatch::doubles(int column) const
+{
+    if (column < 0 || column >= d->columns.count())
+        return QVector<double>();
+    return d->columns.at(column).doubles;
+}
+
+/*!
+    Returns the value in \a row of \a column, which must be a
+    \l{StringColumn}. The view stays valid as long as the batch
+    is not modified or destroyed.
+*/
+QStringView QSqlColumnBatch::text(int row, int column) const
+{
+    if (column < 0 || column >= d->columns.count() || row < 0 || row >= d->rowCount)
+        return QStringView();
+    const QSqlColumnBatchPrivate::Column &c = d->columns.at(column);
+    if (c.type != StringColumn)
+        return QStringView();
+    const int begin = c.offsets.at(row);
+    return QStringView(c.text.constData() + begin, c.offsets.at(row + 1) - begin);
+}
+
+/*!
+    Returns the values of \a column, which must be a
+    \l{VariantColumn}. Returns an empty vector for other columns.
+*/
+QVector<QVariant> QSqlColumnBatch::variants(int column) const
+{
+    if (column < 0 || column >= d->columns.count())
+        return QVector<QVariant>();
+    return d->columns.at(column).variants;
+}
+
+/*!
+    Returns the value in \a row and \a column as a QVariant, whatever
+    the storage of the column is.
+
+    This is a convenience function, it allocates like QSqlQuery::value().
+*/
+QVariant QSqlColumnBatch::value(int row, int column) const
+{
+    if (column < 0 || column >= d->columns.count() || row < 0 || row >= d->rowCount)
+        return QVariant();
+    const QSqlColumnBatchPrivate::Column &c = d->columns.at(column);
+    if (c.nulls.at(row) && c.type != VariantColumn)
+        return QVariant(d->record.field(column).type());
+    switch (c.type) {
+    case IntegerColumn:
+        return c.integers.at(row);
+    case DoubleColumn:
+        return c.doubles.at(row);
+    case StringColumn:
+        return text(row, column).toString();
+    case VariantColumn:
+        break;
+    }
+    return c.variants.at(row);
+}
+
+/*!
+    Removes all rows and columns from the batch.
+*/
+void QSqlColumnBatch::clear()
+{
+    d = new QSqlColumnBatchPrivate;
+}
+
+QT_END_NAMESPACE
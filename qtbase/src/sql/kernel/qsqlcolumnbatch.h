@@ -0,0 +1,97 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSQLCOLUMNBATCH_H
+#define QSQLCOLUMNBATCH_H
+
+#include <QtSql/qtsqlglobal.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstringview.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+
+class QSqlColumnBatchPrivate;
+
+class Q_SQL_EXPORT QSqlColumnBatch
+{
+public:
+    enum ColumnType {
+        VariantColumn,
+        IntegerColumn,
+        DoubleColumn,
+        StringColumn
+    };
+
+    QSqlColumnBatch();
+    QSqlColumnBatch(const QSqlColumnBatch &other);
+    QSqlColumnBatch &operator=(const QSqlColumnBatch &other);
+#ifdef Q_COMPILER_RVALUE_REFS
+    QSqlColumnBatch &operator=(QSqlColumnBatch &&other) Q_DECL_NOTHROW { swap(other); return *this; }
+#endif
+    ~QSqlColumnBatch();
+
+    void swap(QSqlColumnBatch &other) Q_DECL_NOTHROW { qSwap(d, other.d); }
+
+    bool isEmpty() const;
+    int rowCount() const;
+    int columnCount() const;
+    ColumnType columnType(int column) const;
+
+    bool isNull(int row, int column) const;
+    QVector<qint64> integers(int column) const;
+    QVector<double> doubles(int column) const;
+    QStringView text(int row, int column) const;
+    QVector<QVariant> variants(int column) const;
+    QVariant value(int row, int column) const;
+
+    void clear();
+
+private:
+    friend class QSqlQuery;
+    QSharedDataPointer<QSqlColumnBatchPrivate> d;
+};
+
+Q_DECLARE_SHARED(QSqlColumnBatch)
+
+QT_END_NAMESPACE
+
+#endif // QSQLCOLUMNBATCH_H
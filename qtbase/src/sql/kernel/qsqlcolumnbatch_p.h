@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSQLCOLUMNBATCH_P_H
+#define QSQLCOLUMNBATCH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the QtSql module and the SQL drivers.  This header file may change
+// from version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtSql/private/qtsqlglobal_p.h>
+#include "QtSql/qsqlcolumnbatch.h"
+#include "QtSql/qsqlrecord.h"
+
+QT_BEGIN_NAMESPACE
+
+class Q_SQL_EXPORT QSqlColumnBatchPrivate : public QSharedData
+{
+public:
+    struct Column
+    {
+        QSqlColumnBatch::ColumnType type;
+        QVector<bool> nulls;
+        QVector<qint64> integers;
+        QVector<double> doubles;
+        // all strings of the column, offsets has one entry more than there are rows
+        QString text;
+        QVector<int> offsets;
+        QVector<QVariant> variants;
+    };
+
+    QSqlColumnBatchPrivate() : rowCount(0) { }
+
+    static QSqlColumnBatch::ColumnType columnType(QVariant::Type type, QSql::NumericalPrecisionPolicy policy);
+    void init(const QSqlRecord &record, QSql::NumericalPrecisionPolicy policy, int reserve);
+
+    // for the drivers filling the columns, one value per row and column
+    void appendNull(int column);
+    void appendInteger(int column, qint64 value)
+    {
+        Column &c = columns[column];
+        c.nulls.append(false);
+        c.integers.append(value);
+    }
+    void appendDouble(int column, double value)
+    {
+        Column &c = columns[column];
+        c.nulls.append(false);
+        c.doubles.append(value);
+    }
+    void appendText(int column, const QChar *unicode, int size)
+    {
+        Column &c = columns[column];
+        c.nulls.append(false);
+        c.text.append(unicode, size);
+        c.offsets.append(c.text.size());
+    }
+    void appendVariant(int column, const QVariant &value);
+    // converts to the column's type, or appends a null
+    void appendValue(int column, const QVariant &value);
+
+    QSqlRecord record;
+    QVector<Column> columns;
+    int rowCount;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSQLCOLUMNBATCH_P_H
@@ -0,0 +1,672 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsqlconnectionpool.h"
+
+#include "qsqldatabase.h"
+#include "qsqldriver.h"
+#include "qsqlerror.h"
+#include "qsqlquery.h"
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qvector.h>
+#include <QtCore/qwaitcondition.h>
+
+QT_BEGIN_NAMESPACE
+
+struct QSqlPooledConnection
+{
+    QSqlPooledConnection() : owner(Q_NULLPTR), checkouts(0) {}
+
+    QString name;
+    QSqlDatabase db;
+    QThread *owner;
+    int checkouts;
+    QElapsedTimer lastChecked;
+    QHash<QString, QSqlQuery> statements;
+    QStringList recentStatements;
+};
+
+class QSqlConnectionPoolPrivate
+{
+public:
+    QSqlConnectionPoolPrivate(const QSqlDatabase &db, int maximum)
+        : prototype(db), minimumSize(0), maximumSize(qMax(maximum, 1)),
+          healthCheckInterval(0), statementCacheSize(32), opening(0), serial(0),
+          acquireCount(0), timeoutCount(0), totalWaitTime(0), maximumWaitTime(0)
+    {}
+
+    QSqlPooledConnection *find(const QString &name) const;
+    QSqlPooledConnection *findIdle() const;
+    QSqlPooledConnection *open(QMutexLocker *locker);
+    bool attach(QSqlPooledConnection *c, const QString &query, int interval);
+    void destroy(QSqlPooledConnection *c);
+    void recordWait(qint64 msecs);
+
+    QSqlDatabase prototype;
+    int minimumSize;
+    int maximumSize;
+    QString healthCheckQuery;
+    int healthCheckInterval;
+    int statementCacheSize;
+
+    mutable QMutex mutex;
+    QWaitCondition released;
+    QVector<QSqlPooledConnection *> connections;
+    int opening;
+    int serial;
+
+    qint64 acquireCount;
+    qint64 timeoutCount;
+    qint64 totalWaitTime;
+    qint64 maximumWaitTime;
+};
+
+QSqlPooledConnection *QSqlConnectionPoolPrivate::find(const QString &name) const
+{
+    for (QSqlPooledConnection *c : connections) {
+        if (c->name == name)
+            return c;
+    }
+    return Q_NULLPTR;
+}
+
+QSqlPooledConnection *QSqlConnectionPoolPrivate::findIdle() const
+{
+    for (QSqlPooledConnection *c : connections) {
+        if (!c->owner)
+            return c;
+    }
+    return Q_NULLPTR;
+}
+
+// Opens a new connection for the calling thread; the mutex is released
+// while talking to the server
+QSqlPooledConnection *QSqlConnectionPoolPrivate::open(QMutexLocker *locker)
+{
+    const QString name = QString::fromLatin1("qt_sql_pool_%1_%2")
+                         .arg(quintptr(this), 0, 16).arg(++serial);
+    ++opening;
+    locker->unlock();
+
+    QSqlDatabase db = QSqlDatabase::cloneDatabase(prototype, name);
+    const bool ok = db.open();
+    if (!ok) {
+        qWarning("QSqlConnectionPool::acquire: unable to open connection: %s",
+                 db.lastError().text().toLocal8Bit().constData());
+        db = QSqlDatabase();
+        QSqlDatabase::removeDatabase(name);
+    }
+
+    locker->relock();
+    --opening;
+    if (!ok)
+        return Q_NULLPTR;
+
+    QSqlPooledConnection *c = new QSqlPooledConnection;
+    c->name = name;
+    c->db = db;
+    c->lastChecked.start();
+    connections.append(c);
+    return c;
+}
+
+// Moves a connection that was idle to the calling thread and makes sure it
+// still works, reopening it if not
+bool QSqlConnectionPoolPrivate::attach(QSqlPooledConnection *c, const QString &query, int interval)
+{
+    if (QSqlDriver *driver = c->db.driver())
+        driver->moveToThread(QThread::currentThread());
+
+    if (interval < 0 || (interval > 0 && !c->lastChecked.hasExpired(interval)))
+        return true;
+
+    bool healthy = c->db.isOpen() && !c->db.isOpenError();
+    if (healthy && !query.isEmpty()) {
+        QSqlQuery check(c->db);
+        healthy = check.exec(query);
+    }
+    if (!healthy) {
+        c->statements.clear();
+        c->recentStatements.clear();
+        c->db.close();
+        if (!c->db.open()) {
+            qWarning("QSqlConnectionPool::acquire: unable to reopen connection: %s",
+                     c->db.lastError().text().toLocal8Bit().constData());
+            return false;
+        }
+    }
+    c->lastChecked.start();
+    return true;
+}
+
+void QSqlConnectionPoolPrivate::destroy(QSqlPooledConnection *c)
+{
+    connections.removeOne(c);
+    // the driver may hold socket notifiers that have to be deleted in a thread
+    if (QSqlDriver *driver = c->db.driver()) {
+        if (!driver->thread())
+            driver->moveToThread(QThread::currentThread());
+    }
+    const QString name = c->name;
+    delete c;
+    QSqlDatabase::removeDatabase(name);
+}
+
+void QSqlConnectionPoolPrivate::recordWait(qint64 msecs)
+{
+    ++acquireCount;
+    totalWaitTime += msecs;
+    maximumWaitTime = qMax(maximumWaitTime, msecs);
+}
+
+/*!
+    \class QSqlConnectionPool
+    \brief The QSqlConnectionPool class shares a set of open database
+    connections between threads.
+
+    \ingroup database
+    \inmodule QtSql
+    \since 5.11
+    \threadsafe
+
+    A QSqlDatabase connection may only be used by one thread at a time,
+    and cloning it with QSqlDatabase::cloneDatabase() opens a new
+    connection to the server every time. QSqlConnectionPool keeps up to
+    maximumSize() clones of a prototype connection open and lends them to
+    threads, for example the workers of a QThreadPool.
+
+    Call acquire() to check out a connection for the calling thread and
+    release() once the thread is done with it. While a thread holds a
+    connection, further calls to acquire() from the same thread return
+    that same connection; it is handed back to the pool when every
+    acquire() has been matched by a release(). When all connections are
+    busy, acquire() blocks until one is released or the timeout expires.
+
+    Before an idle connection is handed out it is checked: it must still
+    be open and, if a healthCheckQuery() is set, the query must succeed.
+    Connections failing the check are reopened. Use
+    setHealthCheckInterval() to skip the check for connections that were
+    checked recently.
+
+    preparedQuery() returns queries that stay prepared on their connection
+    between checkouts, so that a statement is only sent to the server
+    for preparation once per connection.
+
+    acquireCount(), timeoutCount(), totalWaitTime() and maximumWaitTime()
+    tell how long threads had to wait for a connection, which helps tuning
+    maximumSize().
+
+    The pool must be destroyed after all connections have been released
+    and all queries on them have been destroyed.
+
+    \sa QSqlDatabase, {Threads and the SQL Module}
+*/
+
+/*!
+    Constructs a pool that lends out at most \a maximumSize clones of the
+    connection \a prototype. The prototype itself does not need to be
+    open and is never used by the pool.
+*/
+QSqlConnectionPool::QSqlConnectionPool(const QSqlDatabase &prototype, int maximumSize)
+    : d(new QSqlConnectionPoolPrivate(prototype, maximumSize))
+{
+}
+
+/*!
+    Closes all connections of the pool and removes them.
+*/
+QSqlConnectionPool::~QSqlConnectionPool()
+{
+    QMutexLocker locker(&d->mutex);
+    while (!d->connections.isEmpty()) {
+        QSqlPooledConnection *c = d->connections.constLast();
+        if (c->owner)
+            qWarning("QSqlConnectionPool: connection '%s' is destroyed while checked out",
+                     c->name.toLocal8Bit().constData());
+        d->destroy(c);
+    }
+    locker.unlock();
+    delete d;
+}
+
+/*!
+    Returns the connection the pooled connections are cloned from.
+*/
+QSqlDatabase QSqlConnectionPool::prototype() const
+{
+    return d->prototype;
+}
+
+/*!
+    Sets the number of connections the pool keeps open, even when no
+    thread uses them, to \a size. Missing connections are opened by the
+    next call to acquire().
+
+    The default is 0.
+
+    \sa minimumSize(), setMaximumSize()
+*/
+void QSqlConnectionPool::setMinimumSize(int size)
+{
+    QMutexLocker locker(&d->mutex);
+    d->minimumSize = qBound(0, size, d->maximumSize);
+}
+
+/*!
+    Returns the number of connections the pool keeps open.
+
+    \sa setMinimumSize()
+*/
+int QSqlConnectionPool::minimumSize() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->minimumSize;
+}
+
+/*!
+    Sets the maximum number of open connections to \a size. If more
+    connections are open, idle ones are closed and busy ones are closed
+    as they are released.
+
+    \sa maximumSize(), setMinimumSize()
+*/
+void QSqlConnectionPool::setMaximumSize(int size)
+{
+    QMutexLocker locker(&d->mutex);
+    d->maximumSize = qMax(size, 1);
+    d->minimumSize = qMin(d->minimumSize, d->maximumSize);
+    while (d->connections.size() > d->maximumSize) {
+        QSqlPooledConnection *c = d->findIdle();
+        if (!c)
+            break;
+        d->destroy(c);
+    }
+    // waiting threads may now open a connection of their own
+    d->released.wakeAll();
+}
+
+/*!
+    Returns the maximum number of open connections.
+
+    \sa setMaximumSize()
+*/
+int QSqlConnectionPool::maximumSize() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->maximumSize;
+}
+
+/*!
+    Sets the query executed to verify an idle connection before it is
+    handed out to \a query, for example \c{SELECT 1}. By default there is
+    no query and a connection is only checked for being open.
+
+    \sa healthCheckQuery(), setHealthCheckInterval()
+*/
+void QSqlConnectionPool::setHealthCheckQuery(const QString &query)
+{
+    QMutexLocker locker(&d->mutex);
+    d->healthCheckQuery = query;
+}
+
+/*!
+    Returns the query used to verify idle connections.
+
+    \sa setHealthCheckQuery()
+*/
+QString QSqlConnectionPool::healthCheckQuery() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->healthCheckQuery;
+}
+
+/*!
+    Sets the time in milliseconds a connection is trusted after it was
+    opened or checked to \a msecs. Within that time acquire() hands it out
+    without checking it again. 0, the default, checks a connection every
+    time it is acquired; a negative value disables the checks.
+
+    \sa healthCheckInterval(), setHealthCheckQuery()
+*/
+void QSqlConnectionPool::setHealthCheckInterval(int msecs)
+{
+    QMutexLocker locker(&d->mutex);
+    d->healthCheckInterval = msecs;
+}
+
+/*!
+    Returns the time in milliseconds a checked connection is trusted.
+
+    \sa setHealthCheckInterval()
+*/
+int QSqlConnectionPool::healthCheckInterval() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->healthCheckInterval;
+}
+
+/*!
+    Sets the number of prepared queries preparedQuery() keeps per
+    connection to \a size. When the cache is full, the query used least
+    recently is dropped. 0 disables the cache. The default is 32.
+
+    \sa statementCacheSize(), preparedQuery()
+*/
+void QSqlConnectionPool::setStatementCacheSize(int size)
+{
+    QMutexLocker locker(&d->mutex);
+    d->statementCacheSize = qMax(size, 0);
+}
+
+/*!
+    Returns the number of prepared queries kept per connection.
+
+    \sa setStatementCacheSize()
+*/
+int QSqlConnectionPool::statementCacheSize() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->statementCacheSize;
+}
+
+/*!
+    Checks out a connection for the calling thread and returns it. If the
+    thread already holds a connection of this pool, that connection is
+    returned again. Otherwise an idle connection is used, or a new one is
+    opened if less than maximumSize() are open.
+
+    If all connections are busy, the call blocks until one is released.
+    If \a timeout milliseconds pass first, an invalid QSqlDatabase is
+    returned. A negative \a timeout, the default, waits forever.
+
+    An invalid QSqlDatabase is also returned if a connection cannot be
+    opened. Every successful call must be matched by a call to release().
+
+    \sa release(), preparedQuery()
+*/
+QSqlDatabase QSqlConnectionPool::acquire(int timeout)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QThread *thread = QThread::currentThread();
+    QMutexLocker locker(&d->mutex);
+
+    for (QSqlPooledConnection *c : qAsConst(d->connections)) {
+        if (c->owner == thread) {
+            ++c->checkouts;
+            d->recordWait(0);
+            return c->db;
+        }
+    }
+
+    // open the connections that are to be kept around; they stay idle
+    while (d->connections.size() + d->opening < d->minimumSize) {
+        QSqlPooledConnection *c = d->open(&locker);
+        if (!c)
+            break;
+        if (QSqlDriver *driver = c->db.driver())
+            driver->moveToThread(Q_NULLPTR);
+        d->released.wakeOne();
+    }
+
+    for (;;) {
+        if (QSqlPooledConnection *c = d->findIdle()) {
+            c->owner = thread;
+            c->checkouts = 1;
+            const QString query = d->healthCheckQuery;
+            const int interval = d->healthCheckInterval;
+            locker.unlock();
+            const bool ok = d->attach(c, query, interval);
+            locker.relock();
+            if (!ok) {
+                d->destroy(c);
+                d->released.wakeOne();
+                d->recordWait(timer.elapsed());
+                return QSqlDatabase();
+            }
+            d->recordWait(timer.elapsed());
+            return c->db;
+        }
+
+        if (d->connections.size() + d->opening < d->maximumSize) {
+            QSqlPooledConnection *c = d->open(&locker);
+            d->recordWait(timer.elapsed());
+            if (!c)
+                return QSqlDatabase();
+            c->owner = thread;
+            c->checkouts = 1;
+            return c->db;
+        }
+
+        if (timeout < 0) {
+            d->released.wait(&d->mutex);
+        } else {
+            const qint64 remaining = timeout - timer.elapsed();
+            if (remaining <= 0 || !d->released.wait(&d->mutex, remaining)) {
+                ++d->timeoutCount;
+                d->recordWait(timer.elapsed());
+                return QSqlDatabase();
+            }
+        }
+    }
+}
+
+/*!
+    Hands the connection \a db back to the pool once the calling thread
+    has released it as often as it acquired it. Queries on \a db should
+    not be used by the thread any more afterwards.
+
+    \sa acquire()
+*/
+void QSqlConnectionPool::release(const QSqlDatabase &db)
+{
+    QMutexLocker locker(&d->mutex);
+    QSqlPooledConnection *c = d->find(db.connectionName());
+    if (!c || c->owner != QThread::currentThread()) {
+        qWarning("QSqlConnectionPool::release: connection '%s' is not checked out by this thread",
+                 db.connectionName().toLocal8Bit().constData());
+        return;
+    }
+    if (--c->checkouts > 0)
+        return;
+
+    for (QSqlQuery &query : c->statements)
+        query.finish();
+    c->owner = Q_NULLPTR;
+    if (d->connections.size() > d->maximumSize) {
+        d->destroy(c);
+        return;
+    }
+    // lets the next thread pull the driver to itself
+    if (QSqlDriver *driver = c->db.driver())
+        driver->moveToThread(Q_NULLPTR);
+    d->released.wakeOne();
+}
+
+/*!
+    Returns a query prepared with \a query on the connection \a db, which
+    the calling thread must have acquired. The query is kept prepared on
+    the connection and returned again when the same \a query is requested
+    on it, in this or a later checkout, without preparing it again.
+
+    Values have to be bound each time before exec() is called. If the
+    query cannot be prepared, the returned query's lastError() tells why.
+
+    \sa setStatementCacheSize(), QSqlQuery::prepare()
+*/
+QSqlQuery QSqlConnectionPool::preparedQuery(const QSqlDatabase &db, const QString &query)
+{
+    QMutexLocker locker(&d->mutex);
+    QSqlPooledConnection *c = d->find(db.connectionName());
+    if (!c || c->owner != QThread::currentThread()) {
+        qWarning("QSqlConnectionPool::preparedQuery: connection '%s' is not checked out by this thread",
+                 db.connectionName().toLocal8Bit().constData());
+        return QSqlQuery(db);
+    }
+
+    const auto it = c->statements.constFind(query);
+    if (it != c->statements.constEnd()) {
+        c->recentStatements.removeOne(query);
+        c->recentStatements.prepend(query);
+        return *it;
+    }
+
+    const int cacheSize = d->statementCacheSize;
+    locker.unlock();
+    QSqlQuery prepared(c->db);
+    if (!prepared.prepare(query) || cacheSize == 0)
+        return prepared;
+    locker.relock();
+
+    c->statements.insert(query, prepared);
+    c->recentStatements.prepend(query);
+    while (c->recentStatements.size() > cacheSize)
+        c->statements.remove(c->recentStatements.takeLast());
+    return prepared;
+}
+
+/*!
+    Returns the number of open connections, idle or busy.
+
+    \sa idleCount(), busyCount()
+*/
+int QSqlConnectionPool::size() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->connections.size();
+}
+
+/*!
+    Returns the number of open connections no thread has checked out.
+
+    \sa size(), busyCount()
+*/
+int QSqlConnectionPool::idleCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    int count = 0;
+    for (const QSqlPooledConnection *c : d->connections) {
+        if (!c->owner)
+            ++count;
+    }
+    return count;
+}
+
+/*!
+    Returns the number of connections checked out by threads.
+
+    \sa size(), idleCount()
+*/
+int QSqlConnectionPool::busyCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    int count = 0;
+    for (const QSqlPooledConnection *c : d->connections) {
+        if (c->owner)
+            ++count;
+    }
+    return count;
+}
+
+/*!
+    Returns the number of calls to acquire() since the pool was created
+    or resetStatistics() was called, including the ones that failed.
+
+    \sa totalWaitTime(), timeoutCount()
+*/
+qint64 QSqlConnectionPool::acquireCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->acquireCount;
+}
+
+/*!
+    Returns the number of calls to acquire() that timed out.
+
+    \sa acquireCount()
+*/
+qint64 QSqlConnectionPool::timeoutCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->timeoutCount;
+}
+
+/*!
+    Returns the time in milliseconds all calls to acquire() spent waiting
+    for a connection, including the time needed to open and check it.
+    Divided by acquireCount() this gives the average wait time.
+
+    \sa maximumWaitTime(), acquireCount()
+*/
+qint64 QSqlConnectionPool::totalWaitTime() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->totalWaitTime;
+}
+
+/*!
+    Returns the longest time in milliseconds a call to acquire() waited.
+
+    \sa totalWaitTime()
+*/
+qint64 QSqlConnectionPool::maximumWaitTime() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->maximumWaitTime;
+}
+
+/*!
+    Sets acquireCount(), timeoutCount(), totalWaitTime() and
+    maximumWaitTime() back to 0.
+*/
+void QSqlConnectionPool::resetStatistics()
+{
+    QMutexLocker locker(&d->mutex);
+    d->acquireCount = 0;
+    d->timeoutCount = 0;
+    d->totalWaitTime = 0;
+    d->maximumWaitTime = 0;
+}
+
+QT_END_NAMESPACE
@@ -1157,6 +1157,9 @@ QSqlRecord QSqlDatabase::record(const QString& tablename) const
     \li tty
     \li requiressl
     \li service
+    \li QPSQL_BINARY_PROTOCOL
+    \li QPSQL_PIPELINE_SIZE
+    \li QPSQL_SINGLE_ROW_MODE
     \endlist
 
     \header \li DB2 \li OCI \li TDS
@@ -1166,12 +1169,14 @@ QSqlRecord QSqlDatabase::record(const QString& tablename) const
     \list
     \li SQL_ATTR_ACCESS_MODE
     \li SQL_ATTR_LOGIN_TIMEOUT
+    \li QDB2_BATCH_SIZE
     \endlist
 
     \li
     \list
     \li OCI_ATTR_PREFETCH_ROWS
     \li OCI_ATTR_PREFETCH_MEMORY
+    \li QOCI_BATCH_SIZE
     \endlist
 
     \li
@@ -1359,6 +1364,8 @@ bool QSqlDatabase::isValid() const
 
     \note The new connection has not been opened. Before using the new
     connection, you must call open().
+
+    \sa QSqlConnectionPool
 */
 QSqlDatabase QSqlDatabase::cloneDatabase(const QSqlDatabase &other, const QString &connectionName)
 {
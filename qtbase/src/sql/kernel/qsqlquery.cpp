@@ -48,7 +48,10 @@
 #include "qsqlresult.h"
 #include "qsqldriver.h"
 #include "qsqldatabase.h"
+#include "qsqlcolumnbatch.h"
 #include "private/qsqlnulldriver_p.h"
+#include "private/qsqlresult_p.h"
+#include "private/qsqlcolumnbatch_p.h"
 #include "qvector.h"
 #include "qmap.h"
 
@@ -664,6 +667,41 @@ bool QSqlQuery::next()
     }
 }
 
+/*!
+    \since 5.11
+
+    Retrieves up to  maxRows records following the current one and
+    returns them column by column. The query is positioned on the last
+    record retrieved, or after the last record if the end of the result
+    set was reached. Fewer rows than  maxRows are only returned at the
+    end of the result set; an empty batch means there were no more
+    records.
+
+    Where the driver supports it, the rows are retrieved with the client
+    library's array fetch and stored straight into the typed buffers of
+    the batch, without creating a QVariant for every value. This is the
+    case for the OCI and DB2 drivers on \l{setForwardOnly()}{forward-only}
+    queries. Other drivers retrieve the records one by one as next() and
+    value() would. With a native array fetch, value() does not return
+    the values of the current record afterwards.
+
+    The result must be \l{isActive()}{active} and isSelect() must
+    return true.
+
+    \sa QSqlColumnBatch, next(), setForwardOnly()
+*/
+QSqlColumnBatch QSqlQuery::fetchBatch(int maxRows)
+{
+    QSqlColumnBatch batch;
+    if (!isSelect() || !isActive() || maxRows <= 0 || at() == QSql::AfterLastRow)
+        return batch;
+
+    const int rows = d->sqlResult->d_func()->fetchBatch(batch.d.data(), maxRows);
+    if (rows < maxRows)
+        d->sqlResult->setAt(QSql::AfterLastRow);
+    return batch;
+}
+
 /*!
 
   Retrieves the previous record in the result, if available, and
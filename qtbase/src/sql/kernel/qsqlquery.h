@@ -52,6 +52,7 @@ class QSqlDriver;
 class QSqlError;
 class QSqlResult;
 class QSqlRecord;
+class QSqlColumnBatch;
 template <class Key, class T> class QMap;
 class QSqlQueryPrivate;
 
@@ -93,6 +94,7 @@ public:
     bool previous();
     bool first();
     bool last();
+    QSqlColumnBatch fetchBatch(int maxRows);
 
     void clear();
 
@@ -49,6 +49,7 @@
 #include "qsqldriver.h"
 #include "qpointer.h"
 #include "qsqlresult_p.h"
+#include "qsqlcolumnbatch_p.h"
 #include "private/qsqldriver_p.h"
 #include <QDebug>
 
@@ -59,6 +60,27 @@ QString QSqlResultPrivate::holderAt(int index) const
     return holders.size() > index ? holders.at(index).holderName : fieldSerial(index);
 }
 
+// Fills batch with up to maxRows rows following the current one and leaves
+// the result on the last row read. Drivers with a native array fetch
+// reimplement this; here the values go through data() one by one.
+int QSqlResultPrivate::fetchBatch(QSqlColumnBatchPrivate *batch, int maxRows)
+{
+    Q_Q(QSqlResult);
+    batch->init(q->record(), precisionPolicy, maxRows);
+    const int columnCount = batch->columns.count();
+    int rows = 0;
+    while (rows < maxRows) {
+        const bool ok = q->at() == QSql::BeforeFirstRow ? q->fetchFirst() : q->fetchNext();
+        if (!ok)
+            break;
+        for (int i = 0; i < columnCount; ++i)
+            batch->appendValue(i, q->data(i));
+        ++rows;
+    }
+    batch->rowCount = rows;
+    return rows;
+}
+
 // return a unique id for bound names
 QString QSqlResultPrivate::fieldSerial(int i) const
 {
@@ -522,6 +522,17 @@ void QBenchmarkPerfEventsMeasurer::start()
         // group_fd == -1 -> this is the group leader
         // flags == 0 -> reserved, must be zero
         fd = perf_event_open(&attr, 0, -1, -1, 0);
+        if (fd == -1 && (errno == EACCES || errno == EPERM)
+                && !(attr.exclude_kernel && attr.exclude_hv)) {
+            // With the default perf_event_paranoid setting of many distributions,
+            // unprivileged processes may only count user space events. Do the
+            // same as perf stat and fall back to that instead of failing.
+            fprintf(stderr, "QBenchmarkPerfEventsMeasurer: no permission to count kernel events, "
+                            "measuring user space only\n");
+            attr.exclude_kernel = true;
+            attr.exclude_hv = true;
+            fd = perf_event_open(&attr, 0, -1, -1, 0);
+        }
         if (fd == -1) {
             perror("QBenchmarkPerfEventsMeasurer::start: perf_event_open");
             exit(1);
@@ -591,7 +602,7 @@ static quint64 rawReadValue(int fd)
     while (nread < sizeof results) {
         char *ptr = reinterpret_cast<char *>(&results);
         qint64 r = qt_safe_read(fd, ptr + nread, sizeof results - nread);
-        if (r == -1) {
+        if (r <= 0) {
             perror("QBenchmarkPerfEventsMeasurer::readValue: reading the results");
             exit(1);
         }
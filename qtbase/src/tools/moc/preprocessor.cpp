@@ -1036,10 +1036,21 @@ static QByteArray searchIncludePaths(const QList<Parser::IncludePath> &includepa
 QByteArray Preprocessor::resolveInclude(const QByteArray &include, const QByteArray &relativeTo)
 {
     if (!relativeTo.isEmpty()) {
-        QFileInfo fi;
-        fi.setFile(QFileInfo(QString::fromLocal8Bit(relativeTo)).dir(), QString::fromLocal8Bit(include));
-        if (fi.exists() && !fi.isDir())
-            return fi.canonicalFilePath().toLocal8Bit();
+        // Headers in the same directory tend to include the same local headers,
+        // so cache the resolution per directory rather than stat'ing and
+        // canonicalizing again for every including file.
+        const int slashPos = qMax(relativeTo.lastIndexOf('/'), relativeTo.lastIndexOf('\\'));
+        const QByteArray key = relativeTo.left(slashPos + 1) + include;
+        auto it = localIncludePathResolutionCache.find(key);
+        if (it == localIncludePathResolutionCache.end()) {
+            QFileInfo fi;
+            fi.setFile(QFileInfo(QString::fromLocal8Bit(relativeTo)).dir(), QString::fromLocal8Bit(include));
+            it = localIncludePathResolutionCache.insert(key, fi.exists() && !fi.isDir()
+                                                             ? fi.canonicalFilePath().toLocal8Bit()
+                                                             : QByteArray());
+        }
+        if (!it.value().isEmpty())
+            return it.value();
     }
 
     auto it = nonlocalIncludePathResolutionCache.find(include);
@@ -62,6 +62,7 @@ public:
     QList<QByteArray> frameworks;
     QSet<QByteArray> preprocessedIncludes;
     QHash<QByteArray, QByteArray> nonlocalIncludePathResolutionCache;
+    QHash<QByteArray, QByteArray> localIncludePathResolutionCache;
     Macros macros;
     QByteArray resolveInclude(const QByteArray &filename, const QByteArray &relativeTo);
     Symbols preprocessed(const QByteArray &filename, QFile *device);
@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qcommandlineparser.h>
+#include <qcoreapplication.h>
+#include <qdiriterator.h>
+#include <qstringlist.h>
+#include <private/qpluginmetadatacache_p.h>
+
+#include <stdio.h>
+
+QT_USE_NAMESPACE
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationVersion(QStringLiteral(QT_VERSION_STR));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+        "Writes the meta data cache for the plugins in each directory, so that\n"
+        "applications do not need to scan the plugins when they start.\n"
+        "Run it on the target, after installing or updating plugins."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption recursiveOption(QStringList() << QStringLiteral("r") << QStringLiteral("recursive"),
+                                       QStringLiteral("Also process all subdirectories, as for a plugins root."));
+    parser.addOption(recursiveOption);
+    parser.addPositionalArgument(QStringLiteral("directories"),
+                                 QStringLiteral("Plugin directories to process."),
+                                 QStringLiteral("directory..."));
+    parser.process(app);
+
+    const QStringList roots = parser.positionalArguments();
+    if (roots.isEmpty())
+        parser.showHelp(1);
+
+    QStringList directories;
+    for (const QString &root : roots) {
+        directories << root;
+        if (parser.isSet(recursiveOption)) {
+            QDirIterator it(root, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+            while (it.hasNext())
+                directories << it.next();
+        }
+    }
+
+    int exitCode = 0;
+    for (const QString &directory : qAsConst(directories)) {
+        QString errorString;
+        if (!QPluginMetaDataCache::generate(directory, &errorString)) {
+            fprintf(stderr, "qtplugincache: %s\n", qPrintable(errorString));
+            exitCode = 1;
+        }
+    }
+    return exitCode;
+}
@@ -0,0 +1,7 @@
+QT = core-private
+DEFINES += QT_NO_CAST_FROM_ASCII QT_NO_FOREACH
+
+SOURCES += qtplugincache.cpp
+
+QMAKE_TARGET_DESCRIPTION = "Qt Plugin Meta Data Cache Generator"
+load(qt_tool)
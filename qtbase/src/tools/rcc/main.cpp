@@ -165,13 +165,13 @@ int runRcc(int argc, char *argv[])
 
     QString errorMsg;
 
-    quint8 formatVersion = 2;
+    quint8 formatVersion = 3;
     if (parser.isSet(formatVersionOption)) {
         bool ok = false;
         formatVersion = parser.value(formatVersionOption).toUInt(&ok);
         if (!ok) {
             errorMsg = QLatin1String("Invalid format version specified");
-        } else if (formatVersion != 1 && formatVersion != 2) {
+        } else if (formatVersion < 1 || formatVersion > 3) {
             errorMsg = QLatin1String("Unsupported format version specified");
         }
     }
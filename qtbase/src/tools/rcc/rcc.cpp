@@ -232,6 +232,25 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
     }
     QByteArray data = file.readAll();
 
+    // Share the blob with an identical file written before. Only the data
+    // offset is stored per file, so this needs no support at run time.
+    const uint dataHash = qHash(data);
+    const auto range = lib.m_dataBlobs.equal_range(dataHash);
+    for (auto it = range.first; it != range.second; ++it) {
+        const RCCFileInfo *other = it.value();
+        if (other->m_compressLevel != m_compressLevel
+                || other->m_compressThreshold != m_compressThreshold) {
+            continue;
+        }
+        QFile otherFile(other->m_fileInfo.absoluteFilePath());
+        if (otherFile.open(QFile::ReadOnly) && otherFile.readAll() == data) {
+            m_dataOffset = other->m_dataOffset;
+            m_flags |= (other->m_flags & Compressed);
+            return offset;
+        }
+    }
+    lib.m_dataBlobs.insert(dataHash, this);
+
 #ifndef QT_NO_COMPRESS
     // Check if compression is useful for this file
     if (m_compressLevel != 0 && data.size() != 0) {
@@ -641,6 +660,7 @@ void RCCResourceLibrary::reset()
     }
     m_errorDevice = 0;
     m_failedResources.clear();
+    m_dataBlobs.clear();
 }
 
 
@@ -908,6 +928,7 @@ bool RCCResourceLibrary::writeDataBlobs()
     if (!m_root)
         return false;
 
+    m_dataBlobs.clear();
     QStack<RCCFileInfo*> pending;
     pending.push(m_root);
     qint64 offset = 0;
@@ -996,6 +1017,15 @@ bool RCCResourceLibrary::writeDataStructure()
         return false;
 
     //calculate the child offsets (flat)
+    QHash<const RCCFileInfo *, int> nodes; // only needed for the path index
+    QVector<int> parents;
+    QVector<QPair<uint, int> > pathIndex;
+    const bool writePathIndex = m_formatVersion >= 3;
+    if (writePathIndex) {
+        nodes.insert(m_root, 0);
+        parents.append(0);
+    }
+
     pending.push(m_root);
     int offset = 1;
     while (!pending.isEmpty()) {
@@ -1009,12 +1039,24 @@ bool RCCResourceLibrary::writeDataStructure()
         //write out the actual data now
         for (int i = 0; i < m_children.size(); ++i) {
             RCCFileInfo *child = m_children.at(i);
+            if (writePathIndex) {
+                nodes.insert(child, offset);
+                parents.append(nodes.value(file));
+                // the path below the root, without the leading ":/"
+                pathIndex.append(qMakePair(qt_hash(child->resourceName().mid(2)), offset));
+            }
             ++offset;
             if (child->m_flags & RCCFileInfo::Directory)
                 pending.push(child);
         }
     }
 
+    // The name of the root node is never looked at, so from version 3 on
+    // its name offset holds the number of nodes instead. The path index
+    // is written after the last node.
+    if (writePathIndex)
+        m_root->m_nameOffset = offset;
+
     //write out the structure (ie iterate again!)
     pending.push(m_root);
     m_root->writeDataInfo(*this);
@@ -1033,12 +1075,44 @@ bool RCCResourceLibrary::writeDataStructure()
                 pending.push(child);
         }
     }
+
+    if (writePathIndex)
+        writePathIndexTable(parents, pathIndex);
+
     if (m_format == C_Code || m_format == Pass1)
         writeString("\n};\n\n");
 
     return true;
 }
 
+void RCCResourceLibrary::writePathIndexTable(const QVector<int> &parents,
+                                             QVector<QPair<uint, int> > pathIndex)
+{
+    const bool text = m_format == C_Code || m_format == Pass1;
+
+    // the parent of every node, so that a lookup can verify a hash match
+    // by walking back up to the root
+    if (text)
+        writeString("  // parents\n  ");
+    for (int i = 0; i < parents.size(); ++i) {
+        writeNumber4(parents.at(i));
+        if (text && i % 4 == 3)
+            writeString("\n  ");
+    }
+
+    // (hash of the full path, node) for every node but the root, sorted
+    // by hash so that a lookup takes one binary search
+    std::sort(pathIndex.begin(), pathIndex.end());
+    if (text)
+        writeString("\n  // path index\n  ");
+    for (int i = 0; i < pathIndex.size(); ++i) {
+        writeNumber4(pathIndex.at(i).first);
+        writeNumber4(pathIndex.at(i).second);
+        if (text && i % 2 == 1)
+            writeString("\n  ");
+    }
+}
+
 void RCCResourceLibrary::writeMangleNamespaceFunction(const QByteArray &name)
 {
     if (m_useNameSpace) {
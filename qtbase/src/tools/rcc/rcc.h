@@ -33,7 +33,9 @@
 
 #include <qstringlist.h>
 #include <qhash.h>
+#include <qpair.h>
 #include <qstring.h>
+#include <qvector.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -114,6 +116,7 @@ private:
     bool writeDataBlobs();
     bool writeDataNames();
     bool writeDataStructure();
+    void writePathIndexTable(const QVector<int> &parents, QVector<QPair<uint, int> > pathIndex);
     bool writeInitializer();
     void writeMangleNamespaceFunction(const QByteArray &name);
     void writeAddNamespaceFunction(const QByteArray &name);
@@ -140,6 +143,7 @@ private:
     int m_dataOffset;
     bool m_useNameSpace;
     QStringList m_failedResources;
+    QMultiHash<uint, RCCFileInfo *> m_dataBlobs; // content hash -> file whose blob was written
     QIODevice *m_errorDevice;
     QIODevice *m_outDevice;
     QByteArray m_out;
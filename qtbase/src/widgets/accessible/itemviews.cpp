@@ -584,8 +584,9 @@ void QAccessibleTable::modelChange(QAccessibleTableModelChangeEvent *event)
                     cell->index += newColumns;
                 }
             }
-            if (indexOfChild(iface) >= 0) {
-                newCache.insert(indexOfChild(iface), id);
+            const int childIndex = indexOfChild(iface);
+            if (childIndex >= 0) {
+                newCache.insert(childIndex, id);
             } else {
                 // ### This should really not happen,
                 // but it might if the view has a root index set.
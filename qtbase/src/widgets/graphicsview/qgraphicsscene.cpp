@@ -559,9 +559,7 @@ void QGraphicsScenePrivate::_q_updateScenePosDescendants()
 /*!
     \internal
 
-    Schedules an item for removal. This function leaves some stale indexes
-    around in the BSP tree if called from the item's destructor; these will
-    be cleaned up the next time someone triggers purgeRemovedItems().
+    Schedules an item for removal.
 
     Note: This function might get called from QGraphicsItem's destructor. \a item is
     being destroyed, so we cannot call any pure virtual functions on it (such
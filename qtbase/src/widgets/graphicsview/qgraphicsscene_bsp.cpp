@@ -128,20 +128,6 @@ void QGraphicsSceneBspTree::removeItem(QGraphicsItem *item, const QRectF &rect)
     climbTree(removeVisitor, rect);
 }
 
-void QGraphicsSceneBspTree::removeItems(const QSet<QGraphicsItem *> &items)
-{
-    for (int i = 0; i < leaves.size(); ++i) {
-        QList<QGraphicsItem *> newItemList;
-        const QList<QGraphicsItem *> &oldItemList = leaves[i];
-        for (int j = 0; j < oldItemList.size(); ++j) {
-            QGraphicsItem *item = oldItemList.at(j);
-            if (!items.contains(item))
-                newItemList << item;
-        }
-        leaves[i] = newItemList;
-    }
-}
-
 QList<QGraphicsItem *> QGraphicsSceneBspTree::items(const QRectF &rect, bool onlyTopLevelItems) const
 {
     QList<QGraphicsItem *> tmp;
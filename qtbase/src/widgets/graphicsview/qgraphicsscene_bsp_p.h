@@ -89,7 +89,6 @@ public:
 
     void insertItem(QGraphicsItem *item, const QRectF &rect);
     void removeItem(QGraphicsItem *item, const QRectF &rect);
-    void removeItems(const QSet<QGraphicsItem *> &items);
 
     QList<QGraphicsItem *> items(const QRectF &rect, bool onlyTopLevelItems = false) const;
     int leafCount() const;
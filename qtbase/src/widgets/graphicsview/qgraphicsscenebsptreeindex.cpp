@@ -100,7 +100,6 @@ QGraphicsSceneBspTreeIndexPrivate::QGraphicsSceneBspTreeIndexPrivate(QGraphicsSc
     restartIndexTimer(false),
     regenerateIndex(true),
     lastItemCount(0),
-    purgePending(false),
     sortCacheEnabled(false),
     updatingSortCache(false)
 {
@@ -124,8 +123,6 @@ void QGraphicsSceneBspTreeIndexPrivate::_q_updateIndex()
     q->killTimer(indexTimerId);
     indexTimerId = 0;
 
-    purgeRemovedItems();
-
      // Add unindexedItems to indexedItems
     for (int i = 0; i < unindexedItems.size(); ++i) {
         if (QGraphicsItem *item = unindexedItems.at(i)) {
@@ -137,6 +134,7 @@ void QGraphicsSceneBspTreeIndexPrivate::_q_updateIndex()
             } else {
                 item->d_func()->index = indexedItems.size();
                 indexedItems << item;
+                indexedItemRects.append(BspRect());
             }
         }
     }
@@ -163,6 +161,8 @@ void QGraphicsSceneBspTreeIndexPrivate::_q_updateIndex()
     // Insert all unindexed items into the tree.
     for (int i = 0; i < unindexedItems.size(); ++i) {
         if (QGraphicsItem *item = unindexedItems.at(i)) {
+            BspRect &bspRect = indexedItemRects[item->d_ptr->index];
+            bspRect.inBsp = false;
             if (item->d_ptr->itemIsUntransformable()) {
                 untransformableItems << item;
                 continue;
@@ -171,35 +171,16 @@ void QGraphicsSceneBspTreeIndexPrivate::_q_updateIndex()
                 || item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorContainsChildren)
                 continue;
 
-            bsp.insertItem(item, item->d_ptr->sceneEffectiveBoundingRect());
+            // Remember the rect the item was inserted with, so that it can be
+            // taken out of the same leaves again without asking the item.
+            bspRect.rect = item->d_ptr->sceneEffectiveBoundingRect();
+            bspRect.inBsp = true;
+            bsp.insertItem(item, bspRect.rect);
         }
     }
     unindexedItems.clear();
 }
 
-
-/*!
-    \internal
-
-    Removes stale pointers from all data structures.
-*/
-void QGraphicsSceneBspTreeIndexPrivate::purgeRemovedItems()
-{
-    if (!purgePending && removedItems.isEmpty())
-        return;
-
-    // Remove stale items from the BSP tree.
-    bsp.removeItems(removedItems);
-    // Purge this list.
-    removedItems.clear();
-    freeItemIndexes.clear();
-    for (int i = 0; i < indexedItems.size(); ++i) {
-        if (!indexedItems.at(i))
-            freeItemIndexes << i;
-    }
-    purgePending = false;
-}
-
 /*!
     \internal
 
@@ -220,7 +201,6 @@ void QGraphicsSceneBspTreeIndexPrivate::startIndexTimer(int interval)
 */
 void QGraphicsSceneBspTreeIndexPrivate::resetIndex()
 {
-    purgeRemovedItems();
     for (int i = 0; i < indexedItems.size(); ++i) {
         if (QGraphicsItem *item = indexedItems.at(i)) {
             item->d_ptr->index = -1;
@@ -229,6 +209,7 @@ void QGraphicsSceneBspTreeIndexPrivate::resetIndex()
         }
     }
     indexedItems.clear();
+    indexedItemRects.clear();
     freeItemIndexes.clear();
     untransformableItems.clear();
     regenerateIndex = true;
@@ -304,9 +285,6 @@ void QGraphicsSceneBspTreeIndexPrivate::addItem(QGraphicsItem *item, bool recurs
     if (!item)
         return;
 
-    // Prevent reusing a recently deleted pointer: purge all removed item from our lists.
-    purgeRemovedItems();
-
     // Invalidate any sort caching; arrival of a new item means we need to resort.
     // Update the scene's sort cache settings.
     item->d_ptr->globalStackingOrder = -1;
@@ -340,20 +318,20 @@ void QGraphicsSceneBspTreeIndexPrivate::removeItem(QGraphicsItem *item, bool rec
         Q_ASSERT(item->d_ptr->index < indexedItems.size());
         Q_ASSERT(indexedItems.at(item->d_ptr->index) == item);
         Q_ASSERT(!item->d_ptr->itemDiscovered);
-        freeItemIndexes << item->d_ptr->index;
-        indexedItems[item->d_ptr->index] = 0;
+        const int index = item->d_ptr->index;
+        freeItemIndexes << index;
+        indexedItems[index] = 0;
         item->d_ptr->index = -1;
 
-        if (item->d_ptr->itemIsUntransformable()) {
+        // Use the rect the item was inserted with. This needs no virtual
+        // function calls, so it is also safe from the item's destructor, and
+        // it does not walk the parent chain to map the bounding rect again.
+        BspRect &bspRect = indexedItemRects[index];
+        if (item->d_ptr->itemIsUntransformable())
             untransformableItems.removeOne(item);
-        } else if (item->d_ptr->inDestructor) {
-            // Avoid virtual function calls from the destructor.
-            purgePending = true;
-            removedItems << item;
-        } else if (!(item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorClipsChildren
-                     || item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorContainsChildren)) {
-            bsp.removeItem(item, item->d_ptr->sceneEffectiveBoundingRect());
-        }
+        else if (bspRect.inBsp)
+            bsp.removeItem(item, bspRect.rect);
+        bspRect.inBsp = false;
     } else {
         unindexedItems.removeOne(item);
     }
@@ -380,7 +358,6 @@ QList<QGraphicsItem *> QGraphicsSceneBspTreeIndexPrivate::estimateItems(const QR
     if (onlyTopLevelItems && rect.isNull())
         return q->QGraphicsSceneIndex::estimateTopLevelItems(rect, order);
 
-    purgeRemovedItems();
     _q_updateSortCache();
     Q_ASSERT(unindexedItems.isEmpty());
 
@@ -477,6 +454,7 @@ void QGraphicsSceneBspTreeIndex::clear()
         }
     }
     d->indexedItems.clear();
+    d->indexedItemRects.clear();
     d->unindexedItems.clear();
     d->untransformableItems.clear();
     d->regenerateIndex = true;
@@ -549,7 +527,6 @@ QList<QGraphicsItem *> QGraphicsSceneBspTreeIndex::estimateTopLevelItems(const Q
 QList<QGraphicsItem *> QGraphicsSceneBspTreeIndex::items(Qt::SortOrder order) const
 {
     Q_D(const QGraphicsSceneBspTreeIndex);
-    const_cast<QGraphicsSceneBspTreeIndexPrivate*>(d)->purgeRemovedItems();
     QList<QGraphicsItem *> itemList;
     itemList.reserve(d->indexedItems.size() + d->unindexedItems.size());
 
@@ -125,10 +125,14 @@ public:
     QList<QGraphicsItem *> unindexedItems;
     QList<QGraphicsItem *> untransformableItems;
     QList<int> freeItemIndexes;
-
-    bool purgePending;
-    QSet<QGraphicsItem *> removedItems;
-    void purgeRemovedItems();
+    // Scene rects the indexed items were inserted into the BSP with, by item index.
+    struct BspRect
+    {
+        BspRect() : inBsp(false) { }
+        QRectF rect;
+        bool inBsp;
+    };
+    QVector<BspRect> indexedItemRects;
 
     void _q_updateIndex();
     void startIndexTimer(int interval = QGRAPHICSSCENE_INDEXTIMER_TIMEOUT);
@@ -4499,6 +4499,28 @@ QModelIndexList QAbstractItemViewPrivate::selectedDraggableIndexes() const
     return indexes;
 }
 
+/*
+    Returns the same index as selection.indexes().value(0), without building
+    the list of every index in the selection first.
+*/
+QModelIndex QAbstractItemViewPrivate::firstSelectedIndex(const QItemSelection &selection)
+{
+    for (const QItemSelectionRange &range : selection) {
+        if (!range.isValid() || !range.model())
+            continue;
+        const QModelIndex topLeft = range.topLeft();
+        for (int row = topLeft.row(); row <= range.bottom(); ++row) {
+            for (int column = topLeft.column(); column <= range.right(); ++column) {
+                const QModelIndex index = topLeft.sibling(row, column);
+                const Qt::ItemFlags flags = range.model()->flags(index);
+                if ((flags & Qt::ItemIsSelectable) && (flags & Qt::ItemIsEnabled))
+                    return index;
+            }
+        }
+    }
+    return QModelIndex();
+}
+
 
 QT_END_NAMESPACE
 
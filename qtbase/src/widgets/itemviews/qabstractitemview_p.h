@@ -351,6 +351,7 @@ public:
     }
 
     QModelIndexList selectedDraggableIndexes() const;
+    static QModelIndex firstSelectedIndex(const QItemSelection &selection);
 
     QStyleOptionViewItem viewOptionsV1() const;
 
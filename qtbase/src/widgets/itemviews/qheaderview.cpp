@@ -2078,6 +2078,7 @@ void QHeaderViewPrivate::_q_layoutAboutToBeChanged()
     if (stretchLastSection) {
         const int visual = visualIndex(lastSectionLogicalIdx);
         sectionItems[visual].size = lastSectionSize;
+        sectionStartposRecalc = true;
     }
     for (int i = 0; i < sectionItems.size(); ++i) {
         const auto &s = sectionItems.at(i);
@@ -3295,18 +3296,14 @@ bool QHeaderViewPrivate::isSectionSelected(int section) const
 
 bool QHeaderViewPrivate::isFirstVisibleSection(int section) const
 {
-    if (sectionStartposRecalc)
-        recalcSectionStartPos();
     const SectionItem &item = sectionItems.at(section);
-    return item.size > 0 && item.calculated_startpos == 0;
+    return item.size > 0 && sectionSizeTreePrefix(section) == 0;
 }
 
 bool QHeaderViewPrivate::isLastVisibleSection(int section) const
 {
-    if (sectionStartposRecalc)
-        recalcSectionStartPos();
     const SectionItem &item = sectionItems.at(section);
-    return item.size > 0 && item.calculatedEndPos() == length;
+    return item.size > 0 && sectionSizeTreePrefix(section) + int(item.size) == length;
 }
 
 /*!
@@ -3508,10 +3505,19 @@ void QHeaderViewPrivate::createSectionItems(int start, int end, int size, QHeade
         sectionItems.resize(end + 1);
         sectionStartposRecalc = true;
     }
+    // Resizing a few sections updates the positions in place, larger spans
+    // are cheaper to rebuild in one pass
+    const bool updateInPlace = !sectionStartposRecalc && end - start < 32;
     SectionItem *sectiondata = sectionItems.data();
     for (int i = start; i <= end; ++i) {
-        length += (sizePerSection - sectiondata[i].size);
-        sectionStartposRecalc |= (sectiondata[i].size != sizePerSection);
+        const int delta = sizePerSection - int(sectiondata[i].size);
+        length += delta;
+        if (delta) {
+            if (updateInPlace)
+                addToSectionSizeTree(i, delta);
+            else
+                sectionStartposRecalc = true;
+        }
         sectiondata[i].size = sizePerSection;
         sectiondata[i].resizeMode = mode;
     }
@@ -3712,14 +3718,39 @@ void QHeaderViewPrivate::updateDefaultSectionSizeFromStyle()
 
 void QHeaderViewPrivate::recalcSectionStartPos() const // linear (but fast)
 {
-    int pixelpos = 0;
-    for (QVector<SectionItem>::const_iterator i = sectionItems.constBegin(); i != sectionItems.constEnd(); ++i) {
-        i->calculated_startpos = pixelpos; // write into const mutable
-        pixelpos += i->size;
+    const int count = sectionItems.count();
+    sectionSizeTree.resize(count + 1);
+    int *tree = sectionSizeTree.data();
+    tree[0] = 0;
+    for (int i = 1; i <= count; ++i)
+        tree[i] = sectionItems.at(i - 1).size;
+    for (int i = 1; i <= count; ++i) {
+        const int parent = i + (i & -i);
+        if (parent <= count)
+            tree[parent] += tree[i];
     }
     sectionStartposRecalc = false;
 }
 
+void QHeaderViewPrivate::addToSectionSizeTree(int visual, int delta)
+{
+    const int count = qMin(sectionItems.count(), sectionSizeTree.count() - 1);
+    int *tree = sectionSizeTree.data();
+    for (int i = visual + 1; i <= count; i += i & -i)
+        tree[i] += delta;
+}
+
+// Returns the total size of the first \a count sections in visual order
+int QHeaderViewPrivate::sectionSizeTreePrefix(int count) const
+{
+    if (sectionStartposRecalc)
+        recalcSectionStartPos();
+    int sum = 0;
+    for (int i = count; i > 0; i -= i & -i)
+        sum += sectionSizeTree.at(i);
+    return sum;
+}
+
 void QHeaderViewPrivate::resizeSectionItem(int visualIndex, int oldSize, int newSize)
 {
     Q_Q(QHeaderView);
@@ -3738,31 +3769,34 @@ int QHeaderViewPrivate::headerSectionSize(int visual) const
 int QHeaderViewPrivate::headerSectionPosition(int visual) const
 {
     if (visual < sectionCount() && visual >= 0) {
-        if (sectionStartposRecalc)
-            recalcSectionStartPos();
-        return sectionItems.at(visual).calculated_startpos;
+        return sectionSizeTreePrefix(visual);
     }
     return -1;
 }
 
 int QHeaderViewPrivate::headerVisualIndexAt(int position) const
 {
+    if (position < 0)
+        return -1;
     if (sectionStartposRecalc)
         recalcSectionStartPos();
-    int startidx = 0;
-    int endidx = sectionItems.count() - 1;
-    while (startidx <= endidx) {
-        int middle = (endidx + startidx) / 2;
-        if (sectionItems.at(middle).calculated_startpos > position) {
-            endidx = middle - 1;
-        } else {
-            if (sectionItems.at(middle).calculatedEndPos() <= position)
-                startidx = middle + 1;
-            else // we found it.
-                return middle;
+
+    // Descend the tree for the number of sections that end at or before
+    // position; the next one is the section that covers it.
+    const int count = sectionItems.count();
+    int step = 1;
+    while (step * 2 <= count)
+        step *= 2;
+    int visual = 0;
+    int remaining = position;
+    for (; step > 0; step /= 2) {
+        const int next = visual + step;
+        if (next <= count && sectionSizeTree.at(next) <= remaining) {
+            visual = next;
+            remaining -= sectionSizeTree.at(next);
         }
     }
-    return -1;
+    return visual < count ? visual : -1;
 }
 
 void QHeaderViewPrivate::setHeaderSectionResizeMode(int visual, QHeaderView::ResizeMode mode)
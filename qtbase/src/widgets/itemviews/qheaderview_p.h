@@ -311,16 +311,14 @@ public:
         uint currentlyUnusedPadding : 6;
 
         union { // This union is made in order to save space and ensure good vector performance (on remove)
-            mutable int calculated_startpos; // <- this is the primary used member.
-            mutable int tmpLogIdx;         // When one of these 'tmp'-members has been used we call
-            int tmpDataStreamSectionCount; // recalcSectionStartPos() or set sectionStartposRecalc to true
-        };                                 // to ensure that calculated_startpos will be calculated afterwards.
+            mutable int tmpLogIdx;
+            int tmpDataStreamSectionCount;
+        };
 
         inline SectionItem() : size(0), isHidden(0), resizeMode(QHeaderView::Interactive) {}
         inline SectionItem(int length, QHeaderView::ResizeMode mode)
-            : size(length), isHidden(0), resizeMode(mode), calculated_startpos(-1) {}
+            : size(length), isHidden(0), resizeMode(mode), tmpLogIdx(-1) {}
         inline int sectionSize() const { return size; }
-        inline int calculatedEndPos() const { return calculated_startpos + size; }
 #ifndef QT_NO_DATASTREAM
         inline void write(QDataStream &out) const
         { out << static_cast<int>(size); out << 1; out << (int)resizeMode; }
@@ -330,6 +328,11 @@ public:
     };
 
     QVector<SectionItem> sectionItems;
+    // Fenwick tree over the section sizes, in visual order. Positions are
+    // prefix sums of it, so resizing a section and looking up a position are
+    // both O(log n). Rebuilt by recalcSectionStartPos() when sectionItems is
+    // reordered, inserted into or reset (sectionStartposRecalc).
+    mutable QVector<int> sectionSizeTree;
     struct LayoutChangeItem {
         QPersistentModelIndex index;
         SectionItem section;
@@ -342,6 +345,8 @@ public:
     void setDefaultSectionSize(int size);
     void updateDefaultSectionSizeFromStyle();
     void recalcSectionStartPos() const; // not really const
+    void addToSectionSizeTree(int visual, int delta);
+    int sectionSizeTreePrefix(int count) const;
 
     inline int headerLength() const { // for debugging
         int len = 0;
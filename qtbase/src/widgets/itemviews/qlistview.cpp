@@ -645,6 +645,13 @@ void QListViewPrivate::selectAll(QItemSelectionModel::SelectionFlags command)
   We have a QListView way of knowing what elements are on the viewport
   through the intersectingSet function
 */
+void QListViewPrivate::_q_layoutChanged()
+{
+    // Rows may have been reordered, so kept item sizes no longer match
+    commonListView->discardItemSizes();
+    QAbstractItemViewPrivate::_q_layoutChanged();
+}
+
 QItemViewPaintPairs QListViewPrivate::draggablePaintPairs(const QModelIndexList &indexes, QRect *r) const
 {
     Q_ASSERT(r);
@@ -671,6 +678,7 @@ QItemViewPaintPairs QListViewPrivate::draggablePaintPairs(const QModelIndexList
 void QListView::reset()
 {
     Q_D(QListView);
+    d->commonListView->discardItemSizes();
     d->clear();
     d->hiddenRows.clear();
     QAbstractItemView::reset();
@@ -685,6 +693,7 @@ void QListView::setRootIndex(const QModelIndex &index)
     d->column = qBound(0, d->column, d->model->columnCount(index) - 1);
     QAbstractItemView::setRootIndex(index);
     // sometimes we get an update before reset() is called
+    d->commonListView->discardItemSizes();
     d->clear();
     d->hiddenRows.clear();
 }
@@ -739,6 +748,8 @@ void QListView::rowsInserted(const QModelIndex &parent, int start, int end)
 {
     Q_D(QListView);
     // ### be smarter about inserted items
+    if (parent == d->root)
+        d->commonListView->rowsInserted(start, end);
     d->clear();
     d->doDelayedItemsLayout();
     QAbstractItemView::rowsInserted(parent, start, end);
@@ -762,6 +773,7 @@ void QListView::rowsAboutToBeRemoved(const QModelIndex &parent, int start, int e
                 ++it;
             }
         }
+        d->commonListView->rowsAboutToBeRemoved(start, end);
     }
     d->clear();
     d->doDelayedItemsLayout();
@@ -2873,6 +2885,9 @@ void QIconModeViewBase::scrollContentsBy(int dx, int dy, bool scrollElasticBand)
 void QIconModeViewBase::dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
 {
     if (column() >= topLeft.column() && column() <= bottomRight.column())  {
+        const int keptBottom = qMin(keptSizes.count(), bottomRight.row() + 1);
+        for (int row = topLeft.row(); row < keptBottom; ++row)
+            keptSizes[row] = QSize();
         const QStyleOptionViewItem option = viewOptions();
         const int bottom = qMin(items.count(), bottomRight.row() + 1);
         const bool useItemSize = !dd->grid.isValid();
@@ -2894,14 +2909,88 @@ bool QIconModeViewBase::doBatchedItemLayout(const QListViewLayoutInfo &info, int
     if (info.last >= items.count()) {
         //first we create the items
         QStyleOptionViewItem option = viewOptions();
+        if (!keptSizes.isEmpty() && !canReuseItemSizes(option))
+            discardItemSizes();
         for (int row = items.count(); row <= info.last; ++row) {
-            QSize size = itemSize(option, modelIndex(row));
+            QSize size = row < keptSizes.count() ? keptSizes.at(row) : QSize();
+            if (!size.isValid())
+                size = itemSize(option, modelIndex(row));
             QListViewItem item(QRect(0, 0, size.width(), size.height()), row); // default pos
             items.append(item);
         }
         doDynamicLayout(info);
     }
-    return (batchStartRow > max); // done
+    const bool done = (batchStartRow > max);
+    if (done)
+        discardItemSizes();
+    return done;
+}
+
+void QIconModeViewBase::rowsInserted(int start, int end)
+{
+    keepItemSizes();
+    if (start <= keptSizes.count())
+        keptSizes.insert(start, end - start + 1, QSize());
+    keptSizesRowCount = rowCount();
+}
+
+void QIconModeViewBase::rowsAboutToBeRemoved(int start, int end)
+{
+    keepItemSizes();
+    if (start < keptSizes.count())
+        keptSizes.remove(start, qMin(end + 1, keptSizes.count()) - start);
+    keptSizesRowCount = rowCount() - (end - start + 1);
+}
+
+void QIconModeViewBase::discardItemSizes()
+{
+    keptSizes.clear();
+    keptSizesModel = 0;
+    keptSizesDelegate = 0;
+    keptSizesStyle = 0;
+    keptSizesColumn = -1;
+    keptSizesRowCount = -1;
+}
+
+void QIconModeViewBase::keepItemSizes()
+{
+    // Sizes kept for an earlier change are still pending when several
+    // changes come in before the view is laid out again
+    if (keptSizesRowCount >= 0)
+        return;
+    keptSizes.clear();
+    keptSizes.reserve(items.count());
+    for (const QListViewItem &item : qAsConst(items))
+        keptSizes.append(item.isValid() ? QSize(item.width(), item.height()) : QSize());
+    keptSizesOption = viewOptions();
+    keptSizesModel = dd->model;
+    keptSizesDelegate = qq->itemDelegateForColumn(column());
+    if (!keptSizesDelegate)
+        keptSizesDelegate = qq->itemDelegate();
+    keptSizesStyle = qq->style();
+    keptSizesColumn = column();
+}
+
+/*
+    Kept sizes are only valid for the same model, column, delegates and view
+    options they were measured with.
+*/
+bool QIconModeViewBase::canReuseItemSizes(const QStyleOptionViewItem &option) const
+{
+    const QAbstractItemDelegate *columnDelegate = qq->itemDelegateForColumn(column());
+    return keptSizesModel == dd->model
+        && keptSizesRowCount == rowCount()
+        && keptSizesColumn == column()
+        && keptSizesDelegate == (columnDelegate ? columnDelegate : qq->itemDelegate())
+        && keptSizesStyle == qq->style()
+        && dd->rowDelegates.isEmpty()
+        && option.font == keptSizesOption.font
+        && option.decorationSize == keptSizesOption.decorationSize
+        && option.decorationPosition == keptSizesOption.decorationPosition
+        && option.decorationAlignment == keptSizesOption.decorationAlignment
+        && option.displayAlignment == keptSizesOption.displayAlignment
+        && option.textElideMode == keptSizesOption.textElideMode
+        && option.features == keptSizesOption.features;
 }
 
 QListViewItem QIconModeViewBase::indexToListViewItem(const QModelIndex &index) const
@@ -3266,14 +3355,14 @@ void QListView::selectionChanged(const QItemSelection &selected,
 #ifndef QT_NO_ACCESSIBILITY
     if (QAccessible::isActive()) {
         // ### does not work properly for selection ranges.
-        QModelIndex sel = selected.indexes().value(0);
+        QModelIndex sel = QAbstractItemViewPrivate::firstSelectedIndex(selected);
         if (sel.isValid()) {
             int entry = visualIndex(sel);
             QAccessibleEvent event(this, QAccessible::SelectionAdd);
             event.setChild(entry);
             QAccessible::updateAccessibility(&event);
         }
-        QModelIndex desel = deselected.indexes().value(0);
+        QModelIndex desel = QAbstractItemViewPrivate::firstSelectedIndex(deselected);
         if (desel.isValid()) {
             int entry = visualIndex(desel);
             QAccessibleEvent event(this, QAccessible::SelectionRemove);
@@ -142,6 +142,9 @@ public:
     virtual void appendHiddenRow(int row);
     virtual void removeHiddenRow(int row);
     virtual void setPositionForIndex(const QPoint &, const QModelIndex &) { }
+    virtual void rowsInserted(int, int) { }
+    virtual void rowsAboutToBeRemoved(int, int) { }
+    virtual void discardItemSizes() { }
 
 #ifndef QT_NO_DRAGANDDROP
     virtual void paintDragDrop(QPainter *painter);
@@ -248,7 +251,9 @@ private:
 class QIconModeViewBase : public QCommonListViewBase
 {
 public:
-    QIconModeViewBase(QListView *q, QListViewPrivate *d) : QCommonListViewBase(q, d), interSectingVector(0) {}
+    QIconModeViewBase(QListView *q, QListViewPrivate *d)
+        : QCommonListViewBase(q, d), interSectingVector(0),
+          keptSizesModel(0), keptSizesDelegate(0), keptSizesStyle(0), keptSizesColumn(-1), keptSizesRowCount(-1) {}
 
     QBspTree tree;
     QVector<QListViewItem> items;
@@ -260,6 +265,16 @@ public:
     // used when laying out in batches
     QVector<QModelIndex> *interSectingVector; //used from within intersectingSet
 
+    // Item sizes kept over the relayout that follows inserting or removing
+    // rows, so that only the new items have to ask the delegate for a size
+    QVector<QSize> keptSizes;
+    QStyleOptionViewItem keptSizesOption;
+    const QAbstractItemModel *keptSizesModel;
+    const QAbstractItemDelegate *keptSizesDelegate;
+    const QStyle *keptSizesStyle;
+    int keptSizesColumn;
+    int keptSizesRowCount;
+
     //reimplementations
     int itemIndex(const QListViewItem &item) const override;
     QListViewItem indexToListViewItem(const QModelIndex &index) const override;
@@ -273,6 +288,9 @@ public:
     void appendHiddenRow(int row) override;
     void removeHiddenRow(int row) override;
     void setPositionForIndex(const QPoint &position, const QModelIndex &index) override;
+    void rowsInserted(int start, int end) override;
+    void rowsAboutToBeRemoved(int start, int end) override;
+    void discardItemSizes() override;
 
 #ifndef QT_NO_DRAGANDDROP
     bool filterDragMoveEvent(QDragMoveEvent *) override;
@@ -294,6 +312,8 @@ private:
     QPoint draggedItemsDelta() const;
     void drawItems(QPainter *painter, const QVector<QModelIndex> &indexes) const;
     void moveItem(int index, const QPoint &dest);
+    void keepItemSizes();
+    bool canReuseItemSizes(const QStyleOptionViewItem &option) const;
 
 };
 
@@ -384,6 +404,7 @@ public:
     void scrollElasticBandBy(int dx, int dy);
 
     QItemViewPaintPairs draggablePaintPairs(const QModelIndexList &indexes, QRect *r) const override;
+    void _q_layoutChanged() override;
 
     void emitIndexesMoved(const QModelIndexList &indexes) { emit q_func()->indexesMoved(indexes); }
 
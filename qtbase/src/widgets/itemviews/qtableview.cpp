@@ -3325,14 +3325,14 @@ void QTableView::selectionChanged(const QItemSelection &selected,
 #ifndef QT_NO_ACCESSIBILITY
     if (QAccessible::isActive()) {
         // ### does not work properly for selection ranges.
-        QModelIndex sel = selected.indexes().value(0);
+        QModelIndex sel = QAbstractItemViewPrivate::firstSelectedIndex(selected);
         if (sel.isValid()) {
             int entry = d->accessibleTable2Index(sel);
             QAccessibleEvent event(this, QAccessible::SelectionAdd);
             event.setChild(entry);
             QAccessible::updateAccessibility(&event);
         }
-        QModelIndex desel = deselected.indexes().value(0);
+        QModelIndex desel = QAbstractItemViewPrivate::firstSelectedIndex(deselected);
         if (desel.isValid()) {
             int entry = d->accessibleTable2Index(desel);
             QAccessibleEvent event(this, QAccessible::SelectionRemove);
@@ -3559,7 +3559,37 @@ int QTreeViewPrivate::viewIndex(const QModelIndex &_index) const
     const int row = index.row();
     const quintptr internalId = index.internalId();
 
-    // We start nearest to the lastViewedItem
+    // Lookups tend to be close to each other, so first try a few items
+    // around the lastViewedItem
+    const int nearCount = qMin(8, totalCount);
+    const int nearStart = qBound(0, lastViewedItem - nearCount / 2, totalCount - nearCount);
+    for (int j = nearStart; j < nearStart + nearCount; ++j) {
+        const QModelIndex &idx = viewItems.at(j).index;
+        if (idx.row() == row && idx.internalId() == internalId) {
+            lastViewedItem = j;
+            return j;
+        }
+    }
+
+    // Then locate the item through its parent: siblings are laid out in
+    // model row order, so the parent's range of view items can be bisected
+    const QModelIndex parent = index.parent();
+    int parentItem = -1;
+    if (parent != root) {
+        parentItem = viewIndex(parent);
+        // A parent that is collapsed or not in the view has no visible children
+        if (parentItem < 0 || !viewItems.at(parentItem).expanded)
+            return -1;
+    }
+    const int item = bisectChildItem(parentItem, row, internalId);
+    if (item >= 0) {
+        lastViewedItem = item;
+        return item;
+    }
+
+    // Hidden rows, or items not laid out in row order yet (e.g. while the
+    // model is being changed): fall back to searching all items, nearest
+    // to the lastViewedItem first
     int localCount = qMin(lastViewedItem - 1, totalCount - lastViewedItem);
     for (int i = 0; i < localCount; ++i) {
         const QModelIndex &idx1 = viewItems.at(lastViewedItem + i).index;
@@ -3593,6 +3623,37 @@ int QTreeViewPrivate::viewIndex(const QModelIndex &_index) const
     return -1;
 }
 
+/*
+    Returns the view item of the child of \a parentItem (-1 for the root)
+    at \a row, or -1 if it is not laid out. Finding the sibling that covers
+    a view item only takes walking up its parents, so this is
+    O(log(n) * depth) rather than linear in the number of view items.
+*/
+int QTreeViewPrivate::bisectChildItem(int parentItem, int row, quintptr internalId) const
+{
+    int lo = parentItem + 1;
+    int hi = parentItem < 0 ? viewItems.count() : lo + viewItems.at(parentItem).total;
+    hi = qMin(hi, viewItems.count());
+
+    while (lo < hi) {
+        int sibling = lo + (hi - lo) / 2;
+        while (sibling >= lo && viewItems.at(sibling).parentItem != parentItem)
+            sibling = viewItems.at(sibling).parentItem;
+        if (sibling < lo)
+            return -1; // inconsistent parent links, let the caller search
+
+        const QTreeViewItem &vi = viewItems.at(sibling);
+        const int siblingRow = vi.index.row();
+        if (siblingRow == row)
+            return vi.index.internalId() == internalId ? sibling : -1;
+        if (siblingRow < row)
+            lo = sibling + vi.total + 1;
+        else
+            hi = sibling;
+    }
+    return -1;
+}
+
 QModelIndex QTreeViewPrivate::modelIndex(int i, int column) const
 {
     if (i < 0 || i >= viewItems.count())
@@ -3979,7 +4040,7 @@ void QTreeView::selectionChanged(const QItemSelection &selected,
         Q_D(QTreeView);
 
         // ### does not work properly for selection ranges.
-        QModelIndex sel = selected.indexes().value(0);
+        QModelIndex sel = QAbstractItemViewPrivate::firstSelectedIndex(selected);
         if (sel.isValid()) {
             int entry = d->accessibleTree2Index(sel);
             Q_ASSERT(entry >= 0);
@@ -3987,7 +4048,7 @@ void QTreeView::selectionChanged(const QItemSelection &selected,
             event.setChild(entry);
             QAccessible::updateAccessibility(&event);
         }
-        QModelIndex desel = deselected.indexes().value(0);
+        QModelIndex desel = QAbstractItemViewPrivate::firstSelectedIndex(deselected);
         if (desel.isValid()) {
             int entry = d->accessibleTree2Index(desel);
             Q_ASSERT(entry >= 0);
@@ -145,6 +145,7 @@ public:
     int itemAtCoordinate(int coordinate) const;
 
     int viewIndex(const QModelIndex &index) const;
+    int bisectChildItem(int parentItem, int row, quintptr internalId) const;
     QModelIndex modelIndex(int i, int column = 0) const;
 
     void insertViewItems(int pos, int count, const QTreeViewItem &viewItem);
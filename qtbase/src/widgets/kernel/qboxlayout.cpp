@@ -93,11 +93,13 @@ class QBoxLayoutPrivate : public QLayoutPrivate
 {
     Q_DECLARE_PUBLIC(QBoxLayout)
 public:
-    QBoxLayoutPrivate() : hfwWidth(-1), dirty(true), spacing(-1) { }
+    QBoxLayoutPrivate() : hfwWidth(-1), dirty(true), spacing(-1), distributionSpace(-1) { }
     ~QBoxLayoutPrivate();
 
     void setDirty() {
         geomArray.clear();
+        distribution.clear();
+        distributionSpace = -1;
         hfwWidth = -1;
         hfwHeight = -1;
         dirty = true;
@@ -118,6 +120,12 @@ public:
     QBoxLayout::Direction dir;
     int spacing;
 
+    // geomArray as last distributed by qGeomCalc() over distributionSpace
+    // starting at distributionPos. Not used with height-for-width items.
+    QVector<QLayoutStruct> distribution;
+    int distributionPos;
+    int distributionSpace;
+
     inline void deleteAll() { while (!list.isEmpty()) delete list.takeFirst(); }
 
     void setupGeom();
@@ -770,20 +778,30 @@ void QBoxLayout::setGeometry(const QRect &r)
                 cr.width() - (left + right),
                 cr.height() - (top + bottom));
 
-        QVector<QLayoutStruct> a = d->geomArray;
         int pos = horz(d->dir) ? s.x() : s.y();
         int space = horz(d->dir) ? s.width() : s.height();
-        int n = a.count();
+        int n = d->geomArray.count();
+        QVector<QLayoutStruct> hfwArray;
         if (d->hasHfw && !horz(d->dir)) {
+            hfwArray = d->geomArray;
             for (int i = 0; i < n; i++) {
                 QBoxLayoutItem *box = d->list.at(i);
                 if (box->item->hasHeightForWidth()) {
                     int width = qBound(box->item->minimumSize().width(), s.width(), box->item->maximumSize().width());
-                    a[i].sizeHint = a[i].minimumSize =
+                    hfwArray[i].sizeHint = hfwArray[i].minimumSize =
                                     box->item->heightForWidth(width);
                 }
             }
+            qGeomCalc(hfwArray, 0, n, pos, space);
+        } else if (d->distributionSpace != space || d->distributionPos != pos) {
+            // A resize that only changes the other dimension gives the same
+            // distribution along the layout's direction; reuse it then.
+            d->distribution = d->geomArray;
+            qGeomCalc(d->distribution, 0, n, pos, space);
+            d->distributionPos = pos;
+            d->distributionSpace = space;
         }
+        const QVector<QLayoutStruct> &a = hfwArray.isEmpty() ? d->distribution : hfwArray;
 
         Direction visualDir = d->dir;
         QWidget *parent = parentWidget();
@@ -794,8 +812,6 @@ void QBoxLayout::setGeometry(const QRect &r)
                 visualDir = LeftToRight;
         }
 
-        qGeomCalc(a, 0, n, pos, space);
-
         bool reverse = (horz(visualDir)
                         ? ((r.right() > oldRect.right()) != (visualDir == RightToLeft))
                         : r.bottom() > oldRect.bottom());
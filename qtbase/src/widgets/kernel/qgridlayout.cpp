@@ -138,7 +138,7 @@ public:
     inline void setReversed(bool r, bool c) { hReversed = c; vReversed = r; }
     inline bool horReversed() const { return hReversed; }
     inline bool verReversed() const { return vReversed; }
-    inline void setDirty() { needRecalc = true; hfw_width = -1; }
+    inline void setDirty() { needRecalc = true; hfw_width = -1; colCalcSpace = rowCalcSpace = -1; }
     inline bool isDirty() const { return needRecalc; }
     bool hasHeightForWidth(int hSpacing, int vSpacing);
     int heightForWidth(int width, int hSpacing, int vSpacing);
@@ -224,6 +224,13 @@ private:
     int hfw_width;
     int hfw_height;
     int hfw_minheight;
+
+    // The position and space colData/rowData were last distributed over
+    // by qGeomCalc(); a space of -1 means they have to be distributed again.
+    int colCalcPos;
+    int colCalcSpace;
+    int rowCalcPos;
+    int rowCalcSpace;
     int nextR;
     int nextC;
 
@@ -418,6 +425,8 @@ int QGridLayoutPrivate::heightForWidth(int w, int hSpacing, int vSpacing)
     int hMargins = left + right;
     if (w - hMargins != hfw_width) {
         qGeomCalc(colData, 0, cc, 0, w - hMargins);
+        colCalcPos = 0;
+        colCalcSpace = w - hMargins;
         recalcHFW(w - hMargins);
     }
     return hfw_height + top + bottom;
@@ -943,14 +952,24 @@ void QGridLayoutPrivate::distribute(QRect r, int hSpacing, int vSpacing)
     effectiveMargins(&left, &top, &right, &bottom);
     r.adjust(+left, +top, -right, -bottom);
 
-    qGeomCalc(colData, 0, cc, r.x(), r.width());
+    // Resizing a window usually changes only one dimension of most
+    // layouts in it, so don't distribute the other one again.
+    if (r.x() != colCalcPos || r.width() != colCalcSpace) {
+        qGeomCalc(colData, 0, cc, r.x(), r.width());
+        colCalcPos = r.x();
+        colCalcSpace = r.width();
+    }
     QVector<QLayoutStruct> *rDataPtr;
     if (has_hfw) {
         recalcHFW(r.width());
         qGeomCalc(*hfwData, 0, rr, r.y(), r.height());
         rDataPtr = hfwData;
     } else {
-        qGeomCalc(rowData, 0, rr, r.y(), r.height());
+        if (r.y() != rowCalcPos || r.height() != rowCalcSpace) {
+            qGeomCalc(rowData, 0, rr, r.y(), r.height());
+            rowCalcPos = r.y();
+            rowCalcSpace = r.height();
+        }
         rDataPtr = &rowData;
     }
     QVector<QLayoutStruct> &rData = *rDataPtr;
@@ -960,22 +960,27 @@ static void findTextureWidgetsRecursively(QWidget *tlw, QWidget *widget, QPlatfo
     }
 }
 
-static void findAllTextureWidgetsRecursively(QWidget *tlw, QWidget *widget)
+static void findAllTextureWidgetsRecursively(QWidget *tlw, QWidget *widget, QVector<QPlatformTextureList *> *spareLists)
 {
     // textureChildSeen does not take native child widgets into account and that's good.
     if (QWidgetPrivate::get(widget)->textureChildSeen) {
         QVector<QWidget *> nativeChildren;
-        QScopedPointer<QPlatformTextureList> tl(new QPlatformTextureList);
+        // Refill a list from the previous sync, if there is one, instead of
+        // allocating a new QObject for every frame.
+        QPlatformTextureList *tl = spareLists->isEmpty() ? new QPlatformTextureList : spareLists->takeLast();
+        tl->clear();
         // Look for texture widgets (incl. widget itself) from 'widget' down,
         // but skip subtrees with a parent of a native child widget.
-        findTextureWidgetsRecursively(tlw, widget, tl.data(), &nativeChildren);
+        findTextureWidgetsRecursively(tlw, widget, tl, &nativeChildren);
         // tl may be empty regardless of textureChildSeen if we have native or hidden children.
         if (!tl->isEmpty())
-            QWidgetPrivate::get(tlw)->topData()->widgetTextures.append(tl.take());
+            QWidgetPrivate::get(tlw)->topData()->widgetTextures.append(tl);
+        else
+            spareLists->append(tl);
         // Native child widgets, if there was any, get their own separate QPlatformTextureList.
         foreach (QWidget *ncw, nativeChildren) {
             if (QWidgetPrivate::get(ncw)->textureChildSeen)
-                findAllTextureWidgetsRecursively(tlw, ncw);
+                findAllTextureWidgetsRecursively(tlw, ncw, spareLists);
         }
     }
 }
@@ -1255,10 +1260,13 @@ void QWidgetBackingStore::doSync()
     // Find all render-to-texture child widgets (including self).
     // The search is cut at native widget boundaries, meaning that each native child widget
     // has its own list for the subtree below it.
+    // The lists built by the previous sync are not locked at this point (see
+    // syncAllowed()), so they are recycled rather than reallocated.
     QTLWExtra *tlwExtra = tlw->d_func()->topData();
-    qDeleteAll(tlwExtra->widgetTextures);
-    tlwExtra->widgetTextures.clear();
-    findAllTextureWidgetsRecursively(tlw, tlw);
+    QVector<QPlatformTextureList *> spareLists;
+    spareLists.swap(tlwExtra->widgetTextures);
+    findAllTextureWidgetsRecursively(tlw, tlw, &spareLists);
+    qDeleteAll(spareLists);
     qt_window_private(tlw->windowHandle())->compositing = false; // will get updated in qt_flush()
 #endif
 
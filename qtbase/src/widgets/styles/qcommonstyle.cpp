@@ -855,6 +855,29 @@ static QSizeF viewItemTextLayout(QTextLayout &textLayout, int lineWidth)
     return QSizeF(widthUsed, height);
 }
 
+// Text that cannot wrap, break or fall back to other fonts lays out as a
+// single line, whose size the font metrics give without setting up a layout.
+static bool isSingleLineLatin1(const QString &text)
+{
+    if (text.isEmpty())
+        return false;
+    for (const QChar c : text) {
+        if (c.unicode() > 0xff || c == QLatin1Char('\t') || c == QLatin1Char('\n') || c == QLatin1Char('\r'))
+            return false;
+    }
+    return true;
+}
+
+static QSizeF singleLineTextSize(const QString &text, const QFont &font)
+{
+    // Like QTextLine::naturalTextWidth(), don't count trailing spaces
+    int length = text.size();
+    while (length > 0 && text.at(length - 1) == QLatin1Char(' '))
+        --length;
+    const QFontMetricsF fm(font);
+    return QSizeF(fm.width(text.left(length)), fm.height());
+}
+
 QSize QCommonStylePrivate::viewItemSize(const QStyleOptionViewItem *option, int role) const
 {
     const QWidget *widget = option->widget;
@@ -866,10 +889,6 @@ QSize QCommonStylePrivate::viewItemSize(const QStyleOptionViewItem *option, int
         break;
     case Qt::DisplayRole:
         if (option->features & QStyleOptionViewItem::HasDisplay) {
-            QTextOption textOption;
-            textOption.setWrapMode(QTextOption::WordWrap);
-            QTextLayout textLayout(option->text, option->font);
-            textLayout.setTextOption(textOption);
             const bool wrapText = option->features & QStyleOptionViewItem::WrapText;
             const int textMargin = proxyStyle->pixelMetric(QStyle::PM_FocusFrameHMargin, option, widget) + 1;
             QRect bounds = option->rect;
@@ -890,7 +909,16 @@ QSize QCommonStylePrivate::viewItemSize(const QStyleOptionViewItem *option, int
             }
 
             const int lineWidth = bounds.width();
-            const QSizeF size = viewItemTextLayout(textLayout, lineWidth);
+            QSizeF size;
+            if (lineWidth == QFIXED_MAX && isSingleLineLatin1(option->text)) {
+                size = singleLineTextSize(option->text, option->font);
+            } else {
+                QTextOption textOption;
+                textOption.setWrapMode(QTextOption::WordWrap);
+                QTextLayout textLayout(option->text, option->font);
+                textLayout.setTextOption(textOption);
+                size = viewItemTextLayout(textLayout, lineWidth);
+            }
             return QSize(qCeil(size.width()) + 2 * textMargin, qCeil(size.height()));
         }
         break;
@@ -49,6 +49,7 @@
 #include <qiodevice.h>
 #include <qlist.h>
 #include <qregexp.h>
+#include <qset.h>
 #include <qtextcodec.h>
 #include <qtextstream.h>
 #include <qxml.h>
@@ -608,8 +609,11 @@ public:
     int errorColumn;
 
 private:
+    QString intern(const QString &str);
+
     QDomDocumentPrivate *doc;
     QDomNodePrivate *node;
+    QSet<QString> names;
     QString entityName;
     bool cdata;
     bool nsProcessing;
@@ -7391,14 +7395,35 @@ bool QDomHandler::startDTD(const QString& name, const QString& publicId, const Q
     return true;
 }
 
+/*
+    Element and attribute names, prefixes and namespace URIs repeat
+    throughout a document, so share a single copy of each between all
+    the nodes instead of giving every node its own.
+*/
+QString QDomHandler::intern(const QString &str)
+{
+    // null and empty compare equal, but the DOM tells them apart
+    if (str.isEmpty())
+        return str;
+    QSet<QString>::const_iterator it = names.constFind(str);
+    if (it != names.constEnd())
+        return *it;
+    names.insert(str);
+    return str;
+}
+
 bool QDomHandler::startElement(const QString& nsURI, const QString&, const QString& qName, const QXmlAttributes& atts)
 {
     // tag name
     QDomNodePrivate* n;
     if (nsProcessing) {
-        n = doc->createElementNS(nsURI, qName);
+        n = doc->createElementNS(intern(nsURI), intern(qName));
+        if (n && !n->prefix.isEmpty()) {
+            n->prefix = intern(n->prefix);
+            n->name = intern(n->name);
+        }
     } else {
-        n = doc->createElement(qName);
+        n = doc->createElement(intern(qName));
     }
 
     if (!n)
@@ -7413,9 +7438,9 @@ bool QDomHandler::startElement(const QString& nsURI, const QString&, const QStri
     for (int i=0; i<atts.length(); i++)
     {
         if (nsProcessing) {
-            ((QDomElementPrivate*)node)->setAttributeNS(atts.uri(i), atts.qName(i), atts.value(i));
+            ((QDomElementPrivate*)node)->setAttributeNS(intern(atts.uri(i)), intern(atts.qName(i)), atts.value(i));
         } else {
-            ((QDomElementPrivate*)node)->setAttribute(atts.qName(i), atts.value(i));
+            ((QDomElementPrivate*)node)->setAttribute(intern(atts.qName(i)), atts.value(i));
         }
     }
 
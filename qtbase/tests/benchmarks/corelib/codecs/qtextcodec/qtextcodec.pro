@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qtextcodec
+QT = core testlib
+SOURCES += tst_qtextcodec.cpp
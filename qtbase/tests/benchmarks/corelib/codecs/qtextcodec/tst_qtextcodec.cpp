@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QtCore>
+#include <QtTest/QtTest>
+
+class tst_QTextCodec : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void toUnicode_data();
+    void toUnicode();
+    void fromUnicode_data();
+    void fromUnicode();
+};
+
+// about 1 MB of text: markup and digits around runs of native script,
+// as found in real documents
+static QString corpus(const QString &sample)
+{
+    const QString line = QStringLiteral("<p class=\"body\">%1 2018-01-01 12:00</p>\n").arg(sample);
+    QString text;
+    text.reserve(1024 * 1024);
+    while (text.size() < 512 * 1024)
+        text += line;
+    return text;
+}
+
+static void addCodecRows()
+{
+    QTest::addColumn<QByteArray>("codecName");
+    QTest::addColumn<QString>("text");
+
+    const QString chinese = QString::fromUtf8("中华人民共和国是一个位于东亚的国家，首都为北京。");
+    const QString traditional = QString::fromUtf8("中華民國是位於東亞的國家，首都為臺北。");
+    const QString japanese = QString::fromUtf8("日本語の文章を変換する速度を測定します。カタカナも含む。");
+    const QString korean = QString::fromUtf8("대한민국은 동아시아에 있는 나라이며 수도는 서울이다.");
+
+    QTest::newRow("GB18030") << QByteArray("GB18030") << corpus(chinese);
+    QTest::newRow("GBK") << QByteArray("GBK") << corpus(chinese);
+    QTest::newRow("GB2312") << QByteArray("GB2312") << corpus(chinese);
+    QTest::newRow("Big5") << QByteArray("Big5") << corpus(traditional);
+    QTest::newRow("Big5-HKSCS") << QByteArray("Big5-HKSCS") << corpus(traditional);
+    QTest::newRow("Shift_JIS") << QByteArray("Shift_JIS") << corpus(japanese);
+    QTest::newRow("EUC-JP") << QByteArray("EUC-JP") << corpus(japanese);
+    QTest::newRow("ISO-2022-JP") << QByteArray("ISO-2022-JP") << corpus(japanese);
+    QTest::newRow("EUC-KR") << QByteArray("EUC-KR") << corpus(korean);
+    QTest::newRow("cp949") << QByteArray("cp949") << corpus(korean);
+}
+
+void tst_QTextCodec::toUnicode_data()
+{
+    addCodecRows();
+}
+
+void tst_QTextCodec::toUnicode()
+{
+    QFETCH(QByteArray, codecName);
+    QFETCH(QString, text);
+
+    QTextCodec *codec = QTextCodec::codecForName(codecName);
+    if (!codec)
+        QSKIP("Codec not available");
+    const QByteArray encoded = codec->fromUnicode(text);
+    QBENCHMARK {
+        QString result = codec->toUnicode(encoded);
+        Q_UNUSED(result);
+    }
+}
+
+void tst_QTextCodec::fromUnicode_data()
+{
+    addCodecRows();
+}
+
+void tst_QTextCodec::fromUnicode()
+{
+    QFETCH(QByteArray, codecName);
+    QFETCH(QString, text);
+
+    QTextCodec *codec = QTextCodec::codecForName(codecName);
+    if (!codec)
+        QSKIP("Codec not available");
+    QBENCHMARK {
+        QByteArray result = codec->fromUnicode(text);
+        Q_UNUSED(result);
+    }
+}
+
+QTEST_MAIN(tst_QTextCodec)
+
+#include "tst_qtextcodec.moc"
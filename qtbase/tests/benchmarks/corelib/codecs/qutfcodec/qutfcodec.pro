@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qutfcodec
+QT = core testlib
+SOURCES += tst_qutfcodec.cpp
@@ -0,0 +1,144 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QtCore>
+#include <QtTest/QtTest>
+
+class tst_QUtfCodec : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fromUtf8_data();
+    void fromUtf8();
+    void toUtf8_data();
+    void toUtf8();
+    void fromUtf16_data();
+    void fromUtf16();
+    void toUtf16_data();
+    void toUtf16();
+
+private:
+    void addCorpora();
+};
+
+// roughly 1 MB of text of each kind, built from repeated sample sentences
+static QString corpus(const QString &sample)
+{
+    QString text;
+    text.reserve(1024 * 1024);
+    while (text.size() < 512 * 1024)
+        text += sample;
+    return text;
+}
+
+void tst_QUtfCodec::addCorpora()
+{
+    QTest::addColumn<QString>("text");
+
+    QTest::newRow("ascii")
+        << corpus(QStringLiteral("The quick brown fox jumps over the lazy dog. 0123456789\n"));
+    QTest::newRow("latin1")
+        << corpus(QString::fromUtf8("Voix ambiguë d'un cœur qui, au zéphyr, préfère les jattes de kiwis.\n"));
+    QTest::newRow("cyrillic")
+        << corpus(QString::fromUtf8("Съешь же ещё этих мягких французских булок, да выпей чаю.\n"));
+    QTest::newRow("cjk")
+        << corpus(QString::fromUtf8("いろはにほへと ちりぬるを わかよたれそ つねならむ 色は匂へど\n"));
+    QTest::newRow("mixed")
+        << corpus(QString::fromUtf8("<a href=\"/wiki/Zürich\">Zürich</a> 東京 Москва 🙂\n"));
+}
+
+void tst_QUtfCodec::fromUtf8_data()
+{
+    addCorpora();
+}
+
+void tst_QUtfCodec::fromUtf8()
+{
+    QFETCH(QString, text);
+    const QByteArray data = text.toUtf8();
+    QBENCHMARK {
+        QString result = QString::fromUtf8(data);
+        Q_UNUSED(result);
+    }
+}
+
+void tst_QUtfCodec::toUtf8_data()
+{
+    addCorpora();
+}
+
+void tst_QUtfCodec::toUtf8()
+{
+    QFETCH(QString, text);
+    QBENCHMARK {
+        QByteArray result = text.toUtf8();
+        Q_UNUSED(result);
+    }
+}
+
+void tst_QUtfCodec::fromUtf16_data()
+{
+    addCorpora();
+}
+
+void tst_QUtfCodec::fromUtf16()
+{
+    QFETCH(QString, text);
+    // the byte order that is not the host's, so that every character is swapped
+    QTextCodec *codec = QTextCodec::codecForName(QSysInfo::ByteOrder == QSysInfo::BigEndian
+                                                 ? "UTF-16LE" : "UTF-16BE");
+    QVERIFY(codec);
+    const QByteArray data = codec->fromUnicode(text);
+    QBENCHMARK {
+        QString result = codec->toUnicode(data);
+        Q_UNUSED(result);
+    }
+}
+
+void tst_QUtfCodec::toUtf16_data()
+{
+    addCorpora();
+}
+
+void tst_QUtfCodec::toUtf16()
+{
+    QFETCH(QString, text);
+    QTextCodec *codec = QTextCodec::codecForName(QSysInfo::ByteOrder == QSysInfo::BigEndian
+                                                 ? "UTF-16LE" : "UTF-16BE");
+    QVERIFY(codec);
+    QBENCHMARK {
+        QByteArray result = codec->fromUnicode(text);
+        Q_UNUSED(result);
+    }
+}
+
+QTEST_MAIN(tst_QUtfCodec)
+
+#include "tst_qutfcodec.moc"
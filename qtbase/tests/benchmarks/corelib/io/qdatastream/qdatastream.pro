@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qdatastream
+QT = core testlib
+SOURCES += tst_qdatastream.cpp
@@ -0,0 +1,127 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QDataStream>
+#include <QtCore/QVariant>
+#include <QtTest/QtTest>
+
+class tst_QDataStream : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writeInts();
+    void readInts();
+    void writeStrings();
+    void readStrings();
+    void roundTripVariantMap();
+};
+
+static const int itemCount = 10000;
+
+void tst_QDataStream::writeInts()
+{
+    QBENCHMARK {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        for (int i = 0; i < itemCount; ++i)
+            stream << qint32(i) << double(i);
+    }
+}
+
+void tst_QDataStream::readInts()
+{
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        for (int i = 0; i < itemCount; ++i)
+            stream << qint32(i) << double(i);
+    }
+
+    QBENCHMARK {
+        QDataStream stream(data);
+        qint32 n;
+        double d;
+        for (int i = 0; i < itemCount; ++i)
+            stream >> n >> d;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+}
+
+void tst_QDataStream::writeStrings()
+{
+    const QString string = QStringLiteral("The quick brown fox jumps over the lazy dog");
+    QBENCHMARK {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        for (int i = 0; i < itemCount; ++i)
+            stream << string;
+    }
+}
+
+void tst_QDataStream::readStrings()
+{
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        for (int i = 0; i < itemCount; ++i)
+            stream << QStringLiteral("The quick brown fox jumps over the lazy dog");
+    }
+
+    QBENCHMARK {
+        QDataStream stream(data);
+        QString string;
+        for (int i = 0; i < itemCount; ++i)
+            stream >> string;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+}
+
+void tst_QDataStream::roundTripVariantMap()
+{
+    QVariantMap map;
+    for (int i = 0; i < 100; ++i) {
+        map.insert(QString::number(i), i);
+        map.insert(QLatin1String("s") + QString::number(i), QString::number(i * 3));
+    }
+
+    QBENCHMARK {
+        QByteArray data;
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out << map;
+        QDataStream in(data);
+        QVariantMap result;
+        in >> result;
+        QCOMPARE(result.size(), map.size());
+    }
+}
+
+QTEST_MAIN(tst_QDataStream)
+
+#include "tst_qdatastream.moc"
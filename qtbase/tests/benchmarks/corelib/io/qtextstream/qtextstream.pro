@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qtextstream
+QT = core testlib
+SOURCES += tst_qtextstream.cpp
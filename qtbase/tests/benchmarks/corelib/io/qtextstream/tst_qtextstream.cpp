@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QBuffer>
+#include <QtCore/QTextStream>
+#include <QtTest/QtTest>
+
+class tst_QTextStream : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writeNumbers();
+    void writeStrings();
+    void readLines();
+    void readNumbers();
+};
+
+static const int lineCount = 10000;
+
+void tst_QTextStream::writeNumbers()
+{
+    QBENCHMARK {
+        QByteArray data;
+        QTextStream stream(&data, QIODevice::WriteOnly);
+        for (int i = 0; i < lineCount; ++i)
+            stream << i << ' ' << i * 0.5 << '\n';
+        stream.flush();
+    }
+}
+
+void tst_QTextStream::writeStrings()
+{
+    const QString line = QStringLiteral("The quick brown fox jumps over the lazy dog");
+    QBENCHMARK {
+        QByteArray data;
+        QTextStream stream(&data, QIODevice::WriteOnly);
+        for (int i = 0; i < lineCount; ++i)
+            stream << line << '\n';
+        stream.flush();
+    }
+}
+
+void tst_QTextStream::readLines()
+{
+    QByteArray data;
+    {
+        QTextStream stream(&data, QIODevice::WriteOnly);
+        for (int i = 0; i < lineCount; ++i)
+            stream << "line number " << i << " with some trailing text\n";
+    }
+
+    QBENCHMARK {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+        QTextStream stream(&buffer);
+        QString line;
+        int lines = 0;
+        while (stream.readLineInto(&line))
+            ++lines;
+        QCOMPARE(lines, lineCount);
+    }
+}
+
+void tst_QTextStream::readNumbers()
+{
+    QByteArray data;
+    {
+        QTextStream stream(&data, QIODevice::WriteOnly);
+        for (int i = 0; i < lineCount; ++i)
+            stream << i << ' ' << -i << '\n';
+    }
+
+    QBENCHMARK {
+        QTextStream stream(data, QIODevice::ReadOnly);
+        qint64 sum = 0;
+        int a = 0, b = 0;
+        for (int i = 0; i < lineCount; ++i) {
+            stream >> a >> b;
+            sum += a + b;
+        }
+        QCOMPARE(sum, qint64(0));
+    }
+}
+
+QTEST_MAIN(tst_QTextStream)
+
+#include "tst_qtextstream.moc"
@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qurl
+QT = core testlib
+SOURCES += tst_qurl.cpp
@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QUrl>
+#include <QtTest/QtTest>
+
+class tst_QUrl : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parse_data();
+    void parse();
+    void toString_data();
+    void toString();
+    void resolved();
+    void fromLocalFile();
+};
+
+static void addUrls()
+{
+    QTest::addColumn<QString>("input");
+    QTest::newRow("simple") << QStringLiteral("http://www.qt.io/");
+    QTest::newRow("path-query") << QStringLiteral("https://user@example.com:8080/a/b/c/index.html?x=1&y=2#frag");
+    QTest::newRow("percent-encoded") << QStringLiteral("http://example.com/%E6%97%A5%E6%9C%AC/a%20b?q=%2F%3F");
+    QTest::newRow("idn") << QString::fromUtf8("http://\xc3\xa4\xc3\xb6\xc3\xbc.example/stra\xc3\x9f""e");
+    QTest::newRow("file") << QStringLiteral("file:///home/user/Documents/report.txt");
+}
+
+void tst_QUrl::parse_data()
+{
+    addUrls();
+}
+
+void tst_QUrl::parse()
+{
+    QFETCH(QString, input);
+    QBENCHMARK {
+        QUrl url(input);
+        Q_UNUSED(url.isValid());
+    }
+}
+
+void tst_QUrl::toString_data()
+{
+    addUrls();
+}
+
+void tst_QUrl::toString()
+{
+    QFETCH(QString, input);
+    const QUrl url(input);
+    QBENCHMARK {
+        const QString s = url.toString(QUrl::FullyEncoded);
+        Q_UNUSED(s);
+    }
+}
+
+void tst_QUrl::resolved()
+{
+    const QUrl base(QStringLiteral("http://example.com/a/b/c/d;p?q"));
+    const QUrl relative(QStringLiteral("../../g/./h?y#s"));
+    QBENCHMARK {
+        const QUrl url = base.resolved(relative);
+        Q_UNUSED(url);
+    }
+}
+
+void tst_QUrl::fromLocalFile()
+{
+    const QString path = QStringLiteral("/home/user/Projects/qt/qtbase/src/corelib/io/qurl.cpp");
+    QBENCHMARK {
+        const QUrl url = QUrl::fromLocalFile(path);
+        Q_UNUSED(url);
+    }
+}
+
+QTEST_MAIN(tst_QUrl)
+
+#include "tst_qurl.moc"
@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qjsondocument
+QT = core testlib
+SOURCES += tst_qjsondocument.cpp
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtTest/QtTest>
+
+class tst_QJsonDocument : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_QJsonDocument();
+
+private slots:
+    void fromJson();
+    void toJsonIndented();
+    void toJsonCompact();
+    void buildObject();
+    void lookupKeys();
+
+private:
+    QByteArray m_json;
+};
+
+static QJsonObject makeRecord(int i)
+{
+    QJsonObject record;
+    record.insert(QStringLiteral("id"), i);
+    record.insert(QStringLiteral("name"), QStringLiteral("item %1").arg(i));
+    record.insert(QStringLiteral("price"), i * 1.25);
+    record.insert(QStringLiteral("available"), i % 2 == 0);
+    record.insert(QStringLiteral("tags"), QJsonArray{ QStringLiteral("a"), QStringLiteral("b"), i });
+    return record;
+}
+
+tst_QJsonDocument::tst_QJsonDocument()
+{
+    QJsonArray array;
+    for (int i = 0; i < 1000; ++i)
+        array.append(makeRecord(i));
+    m_json = QJsonDocument(array).toJson(QJsonDocument::Compact);
+}
+
+void tst_QJsonDocument::fromJson()
+{
+    QBENCHMARK {
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(m_json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+    }
+}
+
+void tst_QJsonDocument::toJsonIndented()
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(m_json);
+    QBENCHMARK {
+        const QByteArray json = doc.toJson(QJsonDocument::Indented);
+        Q_UNUSED(json);
+    }
+}
+
+void tst_QJsonDocument::toJsonCompact()
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(m_json);
+    QBENCHMARK {
+        const QByteArray json = doc.toJson(QJsonDocument::Compact);
+        Q_UNUSED(json);
+    }
+}
+
+void tst_QJsonDocument::buildObject()
+{
+    QBENCHMARK {
+        QJsonArray array;
+        for (int i = 0; i < 100; ++i)
+            array.append(makeRecord(i));
+    }
+}
+
+void tst_QJsonDocument::lookupKeys()
+{
+    const QJsonArray array = QJsonDocument::fromJson(m_json).array();
+    QBENCHMARK {
+        double sum = 0;
+        for (const QJsonValue &value : array)
+            sum += value.toObject().value(QLatin1String("price")).toDouble();
+        QVERIFY(sum > 0);
+    }
+}
+
+QTEST_MAIN(tst_QJsonDocument)
+
+#include "tst_qjsondocument.moc"
@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qobject
+QT = core testlib
+SOURCES += tst_qobject.cpp
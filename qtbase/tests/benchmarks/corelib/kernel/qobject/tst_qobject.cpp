@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QtCore>
+#include <QtTest/QtTest>
+
+class Sender : public QObject
+{
+    Q_OBJECT
+public:
+    void emitSignal(int value) { emit signal(value); }
+
+signals:
+    void signal(int);
+};
+
+class Receiver : public QObject
+{
+    Q_OBJECT
+public:
+    Receiver() : count(0) {}
+
+    int count;
+
+public slots:
+    void slot(int value) { count += value; }
+};
+
+class tst_QObject : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void emitUnconnected();
+    void emitDirect_data();
+    void emitDirect();
+    void emitFunctor_data();
+    void emitFunctor();
+    void emitStringBased();
+};
+
+void tst_QObject::emitUnconnected()
+{
+    Sender sender;
+    QBENCHMARK {
+        sender.emitSignal(1);
+    }
+}
+
+void tst_QObject::emitDirect_data()
+{
+    QTest::addColumn<int>("receiverCount");
+
+    QTest::newRow("1 receiver") << 1;
+    QTest::newRow("2 receivers") << 2;
+    QTest::newRow("10 receivers") << 10;
+}
+
+void tst_QObject::emitDirect()
+{
+    QFETCH(int, receiverCount);
+
+    Sender sender;
+    QVector<Receiver *> receivers;
+    for (int i = 0; i < receiverCount; ++i) {
+        Receiver *receiver = new Receiver;
+        QObject::connect(&sender, &Sender::signal, receiver, &Receiver::slot);
+        receivers.append(receiver);
+    }
+
+    QBENCHMARK {
+        sender.emitSignal(1);
+    }
+
+    QVERIFY(receivers.first()->count > 0);
+    qDeleteAll(receivers);
+}
+
+void tst_QObject::emitFunctor_data()
+{
+    emitDirect_data();
+}
+
+void tst_QObject::emitFunctor()
+{
+    QFETCH(int, receiverCount);
+
+    Sender sender;
+    int count = 0;
+    for (int i = 0; i < receiverCount; ++i)
+        QObject::connect(&sender, &Sender::signal, [&count](int value) { count += value; });
+
+    QBENCHMARK {
+        sender.emitSignal(1);
+    }
+
+    QVERIFY(count > 0);
+}
+
+void tst_QObject::emitStringBased()
+{
+    // the old-style string based connection goes through the
+    // QMetaObject::metacall() path instead of the static call function
+    Sender sender;
+    Receiver receiver;
+    QObject::connect(&sender, SIGNAL(signal(int)), &receiver, SLOT(slot(int)));
+
+    QBENCHMARK {
+        sender.emitSignal(1);
+    }
+
+    QVERIFY(receiver.count > 0);
+}
+
+QTEST_MAIN(tst_QObject)
+
+#include "tst_qobject.moc"
@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qvariant
+QT = core testlib
+SOURCES += tst_qvariant.cpp
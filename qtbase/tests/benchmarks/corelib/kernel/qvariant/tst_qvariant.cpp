@@ -0,0 +1,91 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+
+#include <QtCore/QVariant>
+#include <QtTest/QtTest>
+
+// Too large to be stored inside QVariant itself
+struct LargeCustomType
+{
+    double values[4];
+    int id;
+};
+Q_DECLARE_METATYPE(LargeCustomType)
+
+class tst_QVariant : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void createLargeCustomType();
+    void copyAndDetachLargeCustomType();
+    void valueLargeCustomType();
+};
+
+static const int itemCount = 10000;
+
+void tst_QVariant::createLargeCustomType()
+{
+    const LargeCustomType value = { { 1, 2, 3, 4 }, 42 };
+    QBENCHMARK {
+        for (int i = 0; i < itemCount; ++i) {
+            QVariant v = QVariant::fromValue(value);
+            Q_UNUSED(v);
+        }
+    }
+}
+
+void tst_QVariant::copyAndDetachLargeCustomType()
+{
+    const LargeCustomType value = { { 1, 2, 3, 4 }, 42 };
+    const QVariant original = QVariant::fromValue(value);
+    QBENCHMARK {
+        for (int i = 0; i < itemCount; ++i) {
+            QVariant v = original;
+            v.data(); // detaches
+        }
+    }
+}
+
+void tst_QVariant::valueLargeCustomType()
+{
+    const LargeCustomType value = { { 1, 2, 3, 4 }, 42 };
+    const QVariant v = QVariant::fromValue(value);
+    int sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < itemCount; ++i)
+            sum += v.value<LargeCustomType>().id;
+    }
+    QVERIFY(sum > 0);
+}
+
+QTEST_MAIN(tst_QVariant)
+
+#include "tst_qvariant.moc"
@@ -0,0 +1,91 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QThreadPool>
+#include <QtCore/QRunnable>
+#include <QtCore/QAtomicInt>
+#include <QtTest/QtTest>
+
+class tst_QThreadPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void startRunnables_data();
+    void startRunnables();
+    void startAndWaitSingle();
+};
+
+class CountingRunnable : public QRunnable
+{
+public:
+    explicit CountingRunnable(QAtomicInt *counter) : m_counter(counter) {}
+    void run() override { m_counter->ref(); }
+
+private:
+    QAtomicInt *m_counter;
+};
+
+void tst_QThreadPool::startRunnables_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::newRow("100") << 100;
+    QTest::newRow("10000") << 10000;
+}
+
+void tst_QThreadPool::startRunnables()
+{
+    QFETCH(int, count);
+    QThreadPool pool;
+    QAtomicInt counter;
+
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            pool.start(new CountingRunnable(&counter));
+        pool.waitForDone();
+    }
+    QVERIFY(counter.load() > 0);
+}
+
+void tst_QThreadPool::startAndWaitSingle()
+{
+    // round trip latency of handing a single task to an idle worker
+    QThreadPool pool;
+    QAtomicInt counter;
+
+    QBENCHMARK {
+        pool.start(new CountingRunnable(&counter));
+        pool.waitForDone();
+    }
+    QVERIFY(counter.load() > 0);
+}
+
+QTEST_MAIN(tst_QThreadPool)
+
+#include "tst_qthreadpool.moc"
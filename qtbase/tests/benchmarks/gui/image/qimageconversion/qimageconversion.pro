@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qimageconversion
+QT = core gui testlib
+SOURCES += tst_qimageconversion.cpp
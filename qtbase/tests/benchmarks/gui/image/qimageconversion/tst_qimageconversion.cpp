@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtGui/QImage>
+
+Q_DECLARE_METATYPE(QImage::Format)
+
+class tst_QImageConversion : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void convertToFormat_data();
+    void convertToFormat();
+    void convertToFormatInplace_data();
+    void convertToFormatInplace();
+
+private:
+    void addConversions(bool withIdentity = false);
+};
+
+static const int imageWidth = 1920;
+static const int imageHeight = 1080;
+
+// A half transparent gradient so that premultiplication and graying have real work to do.
+static QImage sourceImage(QImage::Format format)
+{
+    QImage image(imageWidth, imageHeight, QImage::Format_ARGB32);
+    for (int y = 0; y < imageHeight; ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < imageWidth; ++x)
+            line[x] = qRgba(x & 0xff, y & 0xff, (x + y) & 0xff, 0x80 + ((x ^ y) & 0x7f));
+    }
+    return image.convertToFormat(format);
+}
+
+void tst_QImageConversion::addConversions(bool withIdentity)
+{
+    QTest::addColumn<QImage::Format>("from");
+    QTest::addColumn<QImage::Format>("to");
+
+    static const struct {
+        QImage::Format format;
+        const char *name;
+    } formats[] = {
+        { QImage::Format_RGB32, "RGB32" },
+        { QImage::Format_ARGB32, "ARGB32" },
+        { QImage::Format_ARGB32_Premultiplied, "ARGB32_PM" },
+        { QImage::Format_RGB16, "RGB16" },
+        { QImage::Format_RGB888, "RGB888" },
+        { QImage::Format_RGBX8888, "RGBX8888" },
+        { QImage::Format_RGBA8888, "RGBA8888" },
+        { QImage::Format_RGBA8888_Premultiplied, "RGBA8888_PM" },
+        { QImage::Format_RGB30, "RGB30" },
+        { QImage::Format_A2RGB30_Premultiplied, "A2RGB30_PM" },
+        { QImage::Format_Grayscale8, "Grayscale8" },
+        { QImage::Format_Indexed8, "Indexed8" },
+    };
+    const int count = int(sizeof(formats) / sizeof(formats[0]));
+
+    for (int i = 0; i < count; ++i) {
+        for (int j = 0; j < count; ++j) {
+            if (i == j && !withIdentity)
+                continue;
+            const QByteArray name = QByteArray(formats[i].name) + " -> " + formats[j].name;
+            QTest::newRow(name.constData()) << formats[i].format << formats[j].format;
+        }
+    }
+}
+
+void tst_QImageConversion::convertToFormat_data()
+{
+    addConversions();
+}
+
+void tst_QImageConversion::convertToFormat()
+{
+    QFETCH(QImage::Format, from);
+    QFETCH(QImage::Format, to);
+
+    const QImage source = sourceImage(from);
+    QBENCHMARK {
+        QImage result = source.convertToFormat(to);
+        Q_UNUSED(result);
+    }
+}
+
+void tst_QImageConversion::convertToFormatInplace_data()
+{
+    addConversions(true);
+}
+
+void tst_QImageConversion::convertToFormatInplace()
+{
+    QFETCH(QImage::Format, from);
+    QFETCH(QImage::Format, to);
+
+    // Each iteration needs an unshared image to convert, so the copy is part of the measurement;
+    // the rows converting to the same format measure the copy alone.
+    const QImage source = sourceImage(from);
+    QBENCHMARK {
+        QImage image = source.copy();
+        image = std::move(image).convertToFormat(to);
+        Q_UNUSED(image);
+    }
+}
+
+QTEST_MAIN(tst_QImageConversion)
+
+#include "tst_qimageconversion.moc"
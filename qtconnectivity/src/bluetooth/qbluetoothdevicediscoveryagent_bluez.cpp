@@ -426,6 +426,7 @@ void QBluetoothDeviceDiscoveryAgentPrivate::deviceFoundBluez5(const QString& dev
                      q, SLOT(_q_PropertiesChanged(QString,QVariantMap,QStringList)));
     // remember what we have to cleanup
     propertyMonitors.append(prop);
+    monitoredDeviceAddresses.insert(devicePath, btAddress);
 
     // read information
     QBluetoothDeviceInfo deviceInfo(btAddress, btName, btClass);
@@ -564,6 +565,7 @@ void QBluetoothDeviceDiscoveryAgentPrivate::_q_discoveryFinished()
 
     qDeleteAll(propertyMonitors);
     propertyMonitors.clear();
+    monitoredDeviceAddresses.clear();
 
     delete adapterBluez5;
     adapterBluez5 = 0;
@@ -619,11 +621,15 @@ void QBluetoothDeviceDiscoveryAgentPrivate::_q_PropertiesChanged(const QString &
         if (!props)
             return;
 
-        OrgBluezDevice1Interface device(QStringLiteral("org.bluez"), props->path(),
-                                            QDBusConnection::systemBus());
+        // RSSI changes arrive continuously while scanning. Use the address that was read
+        // when the device was found instead of asking BlueZ for it on every change.
+        const QBluetoothAddress address = monitoredDeviceAddresses.value(props->path());
+        if (address.isNull())
+            return;
+
         for (int i = 0; i < discoveredDevices.size(); i++) {
-            if (discoveredDevices[i].address().toString() == device.address()) {
-                qCDebug(QT_BT_BLUEZ) << "Updating RSSI for" << device.address()
+            if (discoveredDevices[i].address() == address) {
+                qCDebug(QT_BT_BLUEZ) << "Updating RSSI for" << address.toString()
                          << changed_properties.value(QStringLiteral("RSSI"));
                 discoveredDevices[i].setRssi(
                             changed_properties.value(QStringLiteral("RSSI")).toInt());
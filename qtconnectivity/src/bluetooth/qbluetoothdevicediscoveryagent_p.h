@@ -58,6 +58,7 @@
 #include <QtCore/QTimer>
 #endif
 
+#include <QtCore/QHash>
 #include <QtCore/QVariantMap>
 
 #include <QtBluetooth/QBluetoothAddress>
@@ -156,6 +157,7 @@ private:
     OrgBluezAdapter1Interface *adapterBluez5;
     QTimer *discoveryTimer;
     QList<OrgFreedesktopDBusPropertiesInterface *> propertyMonitors;
+    QHash<QString, QBluetoothAddress> monitoredDeviceAddresses; // D-Bus path -> address
 
     void deviceFoundBluez5(const QString& devicePath);
     void startBluez5(QBluetoothDeviceDiscoveryAgent::DiscoveryMethods methods);
@@ -51,6 +51,7 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QSettings>
+#include <QtCore/QSocketNotifier>
 #include <QtCore/QTimer>
 #include <QtBluetooth/QBluetoothLocalDevice>
 #include <QtBluetooth/QBluetoothSocket>
@@ -794,6 +795,13 @@ void QLowEnergyControllerPrivate::resetController()
 {
     openRequests.clear();
     openPrepareWriteRequests.clear();
+    pendingWriteCommands.clear();
+    if (writeCommandNotifier) {
+        // may be called from within the notifier's activation
+        writeCommandNotifier->setEnabled(false);
+        writeCommandNotifier->deleteLater();
+        writeCommandNotifier = nullptr;
+    }
     scheduledIndications.clear();
     indicationInFlight = false;
     requestPending = false;
@@ -982,6 +990,58 @@ void QLowEnergyControllerPrivate::sendPacket(const QByteArray &packet)
 
 }
 
+/*!
+ * Sends a write command (write without response or signed write).
+ *
+ * Such commands do not occupy the request queue and may be issued back to back.
+ * If the kernel's socket buffer is full, the command is held back and sent once
+ * the socket becomes writable again, rather than being dropped like other
+ * packets in sendPacket().
+ */
+void QLowEnergyControllerPrivate::sendWriteCommand(const QByteArray &packet)
+{
+    pendingWriteCommands.enqueue(packet);
+    if (pendingWriteCommands.size() == 1)
+        sendPendingWriteCommands();
+}
+
+void QLowEnergyControllerPrivate::sendPendingWriteCommands()
+{
+    if (writeCommandNotifier)
+        writeCommandNotifier->setEnabled(false);
+
+    while (!pendingWriteCommands.isEmpty()) {
+        const QByteArray packet = pendingWriteCommands.head();
+        const qint64 result = l2cpSocket->write(packet.constData(), packet.size());
+        if (result == 0) {
+            // socket buffer full, continue once the kernel accepts more data
+            if (!writeCommandNotifier) {
+                writeCommandNotifier = new QSocketNotifier(l2cpSocket->socketDescriptor(),
+                                                           QSocketNotifier::Write, this);
+                connect(writeCommandNotifier, &QSocketNotifier::activated,
+                        this, &QLowEnergyControllerPrivate::sendPendingWriteCommands);
+            }
+            writeCommandNotifier->setEnabled(true);
+            return;
+        }
+
+        if (result == -1) {
+            qCDebug(QT_BT_BLUEZ) << "Cannot write L2CP packet:" << hex
+                                 << packet.toHex()
+                                 << l2cpSocket->errorString();
+            pendingWriteCommands.clear();
+            setError(QLowEnergyController::NetworkError);
+            return;
+        }
+
+        if (result < packet.size()) {
+            qCWarning(QT_BT_BLUEZ) << "L2CP write request incomplete:"
+                                   << result << "of" << packet.size();
+        }
+        pendingWriteCommands.dequeue();
+    }
+}
+
 void QLowEnergyControllerPrivate::sendNextPendingRequest()
 {
     if (openRequests.isEmpty() || requestPending || encryptionChangePending)
@@ -2711,7 +2771,7 @@ void QLowEnergyControllerPrivate::writeCharacteristicForCentral(const QSharedPoi
     // It can be sent at any time and does not produce responses.
     // Therefore we will not put them into the openRequest queue at all.
     if (!writeWithResponse) {
-        sendPacket(packet);
+        sendWriteCommand(packet);
         return;
     }
 
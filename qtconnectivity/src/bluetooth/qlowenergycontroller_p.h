@@ -235,6 +235,11 @@ private:
     };
     QVector<WriteRequest> openPrepareWriteRequests;
 
+    // Write commands the kernel could not take yet (EAGAIN), sent in order
+    // once the socket becomes writable again.
+    QQueue<QByteArray> pendingWriteCommands;
+    QSocketNotifier *writeCommandNotifier = nullptr;
+
     // Invariant: !scheduledIndications.isEmpty => indicationInFlight == true
     QVector<QLowEnergyHandle> scheduledIndications;
     bool indicationInFlight = false;
@@ -316,6 +321,8 @@ private:
     QString keySettingsFilePath() const;
 
     void sendPacket(const QByteArray &packet);
+    void sendWriteCommand(const QByteArray &packet);
+    void sendPendingWriteCommands();
     void sendNextPendingRequest();
     void processReply(const Request &request, const QByteArray &reply);
 
@@ -81,7 +81,7 @@ QT_BEGIN_NAMESPACE
 
 QQuickTurbulenceAffector::QQuickTurbulenceAffector(QQuickItem *parent) :
     QQuickParticleAffector(parent),
-    m_strength(10), m_lastT(0), m_gridSize(0), m_field(0), m_vectorField(0), m_inited(false)
+    m_strength(10), m_lastT(0), m_gridSize(0), m_inited(false)
 {
 }
 
@@ -92,16 +92,6 @@ void QQuickTurbulenceAffector::geometryChanged(const QRectF &, const QRectF &)
 
 QQuickTurbulenceAffector::~QQuickTurbulenceAffector()
 {
-    if (m_field) {
-        for (int i=0; i<m_gridSize; i++)
-            free(m_field[i]);
-        free(m_field);
-    }
-    if (m_vectorField) {
-        for (int i=0; i<m_gridSize; i++)
-            free(m_vectorField[i]);
-        free(m_vectorField);
-    }
 }
 
 void QQuickTurbulenceAffector::initializeGrid()
@@ -109,41 +99,30 @@ void QQuickTurbulenceAffector::initializeGrid()
     if (!m_inited)
         return;
 
-    int arg = qMax(width(), height());
-    if (m_gridSize != arg) {
-        if (m_field){ //deallocate and then reallocate grid
-            for (int i=0; i<m_gridSize; i++)
-                free(m_field[i]);
-            free(m_field);
-        }
-        if (m_vectorField) {
-            for (int i=0; i<m_gridSize; i++)
-                free(m_vectorField[i]);
-            free(m_vectorField);
-        }
-        m_gridSize = arg;
-    }
-
-    m_field = (qreal**)malloc(m_gridSize * sizeof(qreal*));
-    for (int i=0; i<m_gridSize; i++)
-        m_field[i] = (qreal*)malloc(m_gridSize * sizeof(qreal));
-    m_vectorField = (QPointF**)malloc(m_gridSize * sizeof(QPointF*));
-    for (int i=0; i<m_gridSize; i++)
-        m_vectorField[i] = (QPointF*)malloc(m_gridSize * sizeof(QPointF));
+    m_gridSize = qMax(width(), height());
+    const int cells = m_gridSize * m_gridSize;
+    m_field.resize(cells);
+    m_vectorField.resize(cells);
+    if (!cells)
+        return;
 
     QImage image;
     if (!m_noiseSource.isEmpty())
         image = QImage(QQmlFile::urlToLocalFileOrQrc(m_noiseSource)).scaled(QSize(m_gridSize, m_gridSize));
     if (image.isNull())
         image = QImage(QStringLiteral(":particleresources/noise.png")).scaled(QSize(m_gridSize, m_gridSize));
+    image = image.convertToFormat(QImage::Format_RGB32);
 
-    for (int i=0; i<m_gridSize; i++)
-        for (int j=0; j<m_gridSize; j++)
-            m_field[i][j] = qGray(image.pixel(QPoint(i,j)));
+    for (int j=0; j<m_gridSize; j++) {
+        const QRgb *line = reinterpret_cast<const QRgb *>(image.constScanLine(j));
+        for (int i=0; i<m_gridSize; i++)
+            m_field[i * m_gridSize + j] = qGray(line[i]);
+    }
     for (int i=0; i<m_gridSize; i++){
         for (int j=0; j<m_gridSize; j++){
-            m_vectorField[i][j].setX(boundsRespectingField(i-1,j) - boundsRespectingField(i,j));
-            m_vectorField[i][j].setY(boundsRespectingField(i,j) - boundsRespectingField(i,j-1));
+            QPointF &v = m_vectorField[i * m_gridSize + j];
+            v.setX(boundsRespectingField(i-1,j) - boundsRespectingField(i,j));
+            v.setY(boundsRespectingField(i,j) - boundsRespectingField(i,j-1));
         }
     }
 }
@@ -158,7 +137,7 @@ qreal QQuickTurbulenceAffector::boundsRespectingField(int x, int y)
         y = 0;
     if (y >= m_gridSize)
         y = m_gridSize - 1;
-    return m_field[x][y];
+    return m_field.at(x * m_gridSize + y);
 }
 
 void QQuickTurbulenceAffector::ensureInit()
@@ -180,6 +159,7 @@ void QQuickTurbulenceAffector::affectSystem(qreal dt)
     updateOffsets();//### Needed if an ancestor is transformed.
 
     QRect boundsRect(0,0,m_gridSize,m_gridSize);
+    const QPointF *field = m_vectorField.constData();
     foreach (QQuickParticleGroupData *gd, m_system->groupData){
         if (!activeGroup(gd->index))
             continue;
@@ -189,10 +169,9 @@ void QQuickTurbulenceAffector::affectSystem(qreal dt)
             QPoint pos = (QPointF(d->curX(m_system), d->curY(m_system)) - m_offset).toPoint();
             if (!boundsRect.contains(pos,true))//Need to redo bounds checking due to quantization.
                 continue;
-            qreal fx = 0.0;
-            qreal fy = 0.0;
-            fx += m_vectorField[pos.x()][pos.y()].x() * m_strength;
-            fy += m_vectorField[pos.x()][pos.y()].y() * m_strength;
+            const QPointF &v = field[pos.x() * m_gridSize + pos.y()];
+            qreal fx = v.x() * m_strength;
+            qreal fy = v.y() * m_strength;
             if (fx || fy){
                 d->setInstantaneousVX(d->curVX(m_system)+ fx * dt, m_system);
                 d->setInstantaneousVY(d->curVY(m_system)+ fy * dt, m_system);
@@ -52,6 +52,7 @@
 //
 #include "qquickparticleaffector_p.h"
 #include <QQmlListProperty>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -112,8 +113,8 @@ private:
     qreal m_strength;
     qreal m_lastT;
     int m_gridSize;
-    qreal** m_field;
-    QPointF** m_vectorField;
+    QVector<qreal> m_field;         // m_gridSize * m_gridSize, indexed x * m_gridSize + y
+    QVector<QPointF> m_vectorField; // same layout as m_field
     bool m_inited;
     QUrl m_noiseSource;
 };
@@ -349,6 +349,11 @@ bool CompilationUnit::verifyChecksum(const DependentTypesHasher &dependencyHashe
                   sizeof(data->dependencyMD5Checksum)) == 0;
 }
 
+bool CompilationUnit::cacheFileExists(const QUrl &url)
+{
+    return QQmlFile::isLocalFile(url) && QFile::exists(cacheFilePath(url));
+}
+
 bool CompilationUnit::loadFromDisk(const QUrl &url, const QDateTime &sourceTimeStamp, EvalISelFactory *iselFactory, QString *errorString)
 {
     if (!QQmlFile::isLocalFile(url)) {
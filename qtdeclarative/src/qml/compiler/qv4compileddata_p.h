@@ -978,6 +978,7 @@ struct Q_QML_PRIVATE_EXPORT CompilationUnit : public CompilationUnitBase, public
     void destroy() Q_DECL_OVERRIDE;
 
     bool loadFromDisk(const QUrl &url, const QDateTime &sourceTimeStamp, EvalISelFactory *iselFactory, QString *errorString);
+    static bool cacheFileExists(const QUrl &url);
 
 protected:
     virtual void linkBackendToEngine(QV4::ExecutionEngine *engine) = 0;
@@ -51,6 +51,7 @@
 #endif
 
 #include <iostream>
+#include <limits>
 #include <QBuffer>
 #include <QCoreApplication>
 
@@ -89,11 +90,25 @@ bool CompilationUnit::memoryMapCode(QString *errorString)
 
     const char *basePtr = reinterpret_cast<const char *>(data);
 
+    // The code of all functions is stored back to back after the unit data (see
+    // prepareCodeOffsetsForDiskStorage), so make it executable in one go instead
+    // of changing the protection of the same pages once per function.
+    quint64 codeStart = std::numeric_limits<quint64>::max();
+    quint64 codeEnd = 0;
+    for (uint i = 0; i < data->functionTableSize; ++i) {
+        const CompiledData::Function *compiledFunction = data->functionAt(i);
+        if (!compiledFunction->codeSize)
+            continue;
+        codeStart = qMin(codeStart, quint64(compiledFunction->codeOffset));
+        codeEnd = qMax(codeEnd, quint64(compiledFunction->codeOffset) + compiledFunction->codeSize);
+    }
+    if (codeEnd > codeStart)
+        JSC::ExecutableAllocator::makeExecutable(const_cast<char *>(basePtr + codeStart), codeEnd - codeStart);
+
     for (uint i = 0; i < data->functionTableSize; ++i) {
         const CompiledData::Function *compiledFunction = data->functionAt(i);
         void *codePtr = const_cast<void *>(reinterpret_cast<const void *>(basePtr + compiledFunction->codeOffset));
         JSC::MacroAssemblerCodeRef codeRef = JSC::MacroAssemblerCodeRef::createSelfManagedCodeRef(JSC::MacroAssemblerCodePtr(codePtr));
-        JSC::ExecutableAllocator::makeExecutable(codePtr, compiledFunction->codeSize);
         codeRefs[i] = codeRef;
 
         static const bool showCode = qEnvironmentVariableIsSet("QV4_SHOW_ASM");
@@ -119,6 +119,25 @@ void ArrayPrototype::init(ExecutionEngine *engine, Object *ctor)
     defineDefaultProperty(QStringLiteral("reduceRight"), method_reduceRight, 1);
 }
 
+// Reads an element for the iterating builtins below. Elements of simple
+// array data without accessors are read directly, everything else (holes,
+// accessors, sparse or custom arrays) goes through getIndexed(). This is
+// decided per element, as the callbacks may change the array.
+static inline ReturnedValue getArrayElement(const Object *o, uint index, bool *exists)
+{
+    const Heap::ArrayData *ad = o->d()->arrayData;
+    if (ad && ad->type == Heap::ArrayData::Simple && !ad->attrs
+            && o->vtable()->getIndexed == Object::static_vtbl.getIndexed
+            && index < ad->values.size) {
+        const Value &v = static_cast<const Heap::SimpleArrayData *>(ad)->data(index);
+        if (!v.isEmpty()) {
+            *exists = true;
+            return v.asReturnedValue();
+        }
+    }
+    return o->getIndexed(index, exists);
+}
+
 void ArrayPrototype::method_isArray(const BuiltinFunction *, Scope &scope, CallData *callData)
 {
     bool isArray = callData->argc && callData->args[0].as<ArrayObject>();
@@ -775,13 +794,14 @@ void ArrayPrototype::method_every(const BuiltinFunction *, Scope &scope, CallDat
     bool ok = true;
     for (uint k = 0; ok && k < len; ++k) {
         bool exists;
-        v = instance->getIndexed(k, &exists);
+        v = getArrayElement(instance, k, &exists);
         if (!exists)
             continue;
 
         cData->args[0] = v;
         cData->args[1] = Primitive::fromDouble(k);
         callback->call(scope, cData);
+        CHECK_EXCEPTION();
         ok = scope.result.toBoolean();
     }
     scope.result = Encode(ok);
@@ -806,13 +826,14 @@ void ArrayPrototype::method_some(const BuiltinFunction *, Scope &scope, CallData
 
     for (uint k = 0; k < len; ++k) {
         bool exists;
-        v = instance->getIndexed(k, &exists);
+        v = getArrayElement(instance, k, &exists);
         if (!exists)
             continue;
 
         cData->args[0] = v;
         cData->args[1] = Primitive::fromDouble(k);
         callback->call(scope, cData);
+        CHECK_EXCEPTION();
         if (scope.result.toBoolean()) {
             scope.result = Encode(true);
             return;
@@ -840,13 +861,14 @@ void ArrayPrototype::method_forEach(const BuiltinFunction *, Scope &scope, CallD
     ScopedValue v(scope);
     for (uint k = 0; k < len; ++k) {
         bool exists;
-        v = instance->getIndexed(k, &exists);
+        v = getArrayElement(instance, k, &exists);
         if (!exists)
             continue;
 
         cData->args[0] = v;
         cData->args[1] = Primitive::fromDouble(k);
         callback->call(scope, cData);
+        CHECK_EXCEPTION();
     }
     RETURN_UNDEFINED();
 }
@@ -874,13 +896,14 @@ void ArrayPrototype::method_map(const BuiltinFunction *, Scope &scope, CallData
     ScopedValue v(scope);
     for (uint k = 0; k < len; ++k) {
         bool exists;
-        v = instance->getIndexed(k, &exists);
+        v = getArrayElement(instance, k, &exists);
         if (!exists)
             continue;
 
         cData->args[0] = v;
         cData->args[1] = Primitive::fromDouble(k);
         callback->call(scope, cData);
+        CHECK_EXCEPTION();
         a->arraySet(k, scope.result);
     }
     scope.result = a.asReturnedValue();
@@ -910,13 +933,14 @@ void ArrayPrototype::method_filter(const BuiltinFunction *, Scope &scope, CallDa
     uint to = 0;
     for (uint k = 0; k < len; ++k) {
         bool exists;
-        v = instance->getIndexed(k, &exists);
+        v = getArrayElement(instance, k, &exists);
         if (!exists)
             continue;
 
         cData->args[0] = v;
         cData->args[1] = Primitive::fromDouble(k);
         callback->call(scope, cData);
+        CHECK_EXCEPTION();
         if (scope.result.toBoolean()) {
             a->arraySet(to, v);
             ++to;
@@ -945,7 +969,7 @@ void ArrayPrototype::method_reduce(const BuiltinFunction *, Scope &scope, CallDa
     } else {
         bool kPresent = false;
         while (k < len && !kPresent) {
-            v = instance->getIndexed(k, &kPresent);
+            v = getArrayElement(instance, k, &kPresent);
             if (kPresent)
                 scope.result = v;
             ++k;
@@ -961,12 +985,13 @@ void ArrayPrototype::method_reduce(const BuiltinFunction *, Scope &scope, CallDa
 
     while (k < len) {
         bool kPresent;
-        v = instance->getIndexed(k, &kPresent);
+        v = getArrayElement(instance, k, &kPresent);
         if (kPresent) {
             cData->args[0] = scope.result;
             cData->args[1] = v;
             cData->args[2] = Primitive::fromDouble(k);
             callback->call(scope, cData);
+            CHECK_EXCEPTION();
         }
         ++k;
     }
@@ -998,7 +1023,7 @@ void ArrayPrototype::method_reduceRight(const BuiltinFunction *, Scope &scope, C
     } else {
         bool kPresent = false;
         while (k > 0 && !kPresent) {
-            v = instance->getIndexed(k - 1, &kPresent);
+            v = getArrayElement(instance, k - 1, &kPresent);
             if (kPresent)
                 scope.result = v;
             --k;
@@ -1013,12 +1038,13 @@ void ArrayPrototype::method_reduceRight(const BuiltinFunction *, Scope &scope, C
 
     while (k > 0) {
         bool kPresent;
-        v = instance->getIndexed(k - 1, &kPresent);
+        v = getArrayElement(instance, k - 1, &kPresent);
         if (kPresent) {
             cData->args[0] = scope.result;
             cData->args[1] = v;
             cData->args[2] = Primitive::fromDouble(k - 1);
             callback->call(scope, cData);
+            CHECK_EXCEPTION();
         }
         --k;
     }
@@ -144,6 +144,7 @@ ExecutionEngine::ExecutionEngine(EvalISelFactory *factory)
     , m_multiplyWrappedQObjects(0)
 {
     memoryManager = new QV4::MemoryManager(this);
+    memset(megamorphicLookupCache, 0, sizeof(megamorphicLookupCache));
 
     if (maxCallDepth == -1) {
         bool ok = false;
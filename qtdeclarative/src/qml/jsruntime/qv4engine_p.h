@@ -88,6 +88,7 @@ struct CompilationUnit;
 
 struct InternalClass;
 struct InternalClassPool;
+struct Identifier;
 
 struct Q_QML_EXPORT ExecutionEngine : public EngineBase
 {
@@ -323,6 +324,23 @@ public:
 
     RegExpCache *regExpCache;
 
+    // Lookups that have seen too many different object layouts fall back to
+    // this cache, which is shared by all of them. It maps an internal class and
+    // a name to the index of an own data property with that name.
+    struct MegamorphicLookupCacheEntry {
+        InternalClass *internalClass;
+        const Identifier *identifier;
+        uint index;
+        PropertyAttributes attrs;
+    };
+    enum { MegamorphicLookupCacheSize = 512 };
+    MegamorphicLookupCacheEntry megamorphicLookupCache[MegamorphicLookupCacheSize];
+    MegamorphicLookupCacheEntry *megamorphicLookupCacheEntry(const InternalClass *ic, const Identifier *id)
+    {
+        const quintptr hash = (quintptr(ic) >> 3) ^ (quintptr(id) >> 4);
+        return megamorphicLookupCache + (hash & (MegamorphicLookupCacheSize - 1));
+    }
+
     // Scarce resources are "exceptionally high cost" QVariant types where allowing the
     // normal JavaScript GC to clean them up is likely to lead to out-of-memory or other
     // out-of-resource situations.  When such a resource is passed into JavaScript we
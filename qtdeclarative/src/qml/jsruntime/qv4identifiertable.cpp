@@ -61,6 +61,7 @@ IdentifierTable::IdentifierTable(ExecutionEngine *engine)
     alloc = primeForNumBits(numBits);
     entries = (Heap::String **)malloc(alloc*sizeof(Heap::String *));
     memset(entries, 0, alloc*sizeof(Heap::String *));
+    hashes = (uint *)malloc(alloc*sizeof(uint));
 }
 
 IdentifierTable::~IdentifierTable()
@@ -69,6 +70,7 @@ IdentifierTable::~IdentifierTable()
         if (entries[i])
             delete entries[i]->identifier;
     free(entries);
+    free(hashes);
 }
 
 void IdentifierTable::addEntry(Heap::String *str)
@@ -89,19 +91,23 @@ void IdentifierTable::addEntry(Heap::String *str)
         int newAlloc = primeForNumBits(numBits);
         Heap::String **newEntries = (Heap::String **)malloc(newAlloc*sizeof(Heap::String *));
         memset(newEntries, 0, newAlloc*sizeof(Heap::String *));
+        uint *newHashes = (uint *)malloc(newAlloc*sizeof(uint));
         for (int i = 0; i < alloc; ++i) {
             Heap::String *e = entries[i];
             if (!e)
                 continue;
-            uint idx = e->stringHash % newAlloc;
+            uint idx = hashes[i] % newAlloc;
             while (newEntries[idx]) {
                 ++idx;
                 idx %= newAlloc;
             }
             newEntries[idx] = e;
+            newHashes[idx] = hashes[i];
         }
         free(entries);
+        free(hashes);
         entries = newEntries;
+        hashes = newHashes;
         alloc = newAlloc;
     }
 
@@ -111,6 +117,7 @@ void IdentifierTable::addEntry(Heap::String *str)
         idx %= alloc;
     }
     entries[idx] = str;
+    hashes[idx] = hash;
     ++size;
 }
 
@@ -122,7 +129,7 @@ Heap::String *IdentifierTable::insertString(const QString &s)
     uint hash = String::createHashValue(s.constData(), s.length(), &subtype);
     uint idx = hash % alloc;
     while (Heap::String *e = entries[idx]) {
-        if (e->stringHash == hash && e->toQString() == s)
+        if (hashes[idx] == hash && e->toQString() == s)
             return e;
         ++idx;
         idx %= alloc;
@@ -146,7 +153,7 @@ Identifier *IdentifierTable::identifierImpl(const Heap::String *str)
 
     uint idx = hash % alloc;
     while (Heap::String *e = entries[idx]) {
-        if (e->stringHash == hash && e->isEqualTo(str)) {
+        if (hashes[idx] == hash && e->isEqualTo(str)) {
             str->identifier = e->identifier;
             return e->identifier;
         }
@@ -163,11 +170,12 @@ Heap::String *IdentifierTable::stringFromIdentifier(Identifier *i)
     if (!i)
         return 0;
 
-    uint idx = i->hashValue % alloc;
+    const uint hash = i->hashValue;
+    uint idx = hash % alloc;
     while (1) {
         Heap::String *e = entries[idx];
         Q_ASSERT(e);
-        if (e->identifier == i)
+        if (hashes[idx] == hash && e->identifier == i)
             return e;
         ++idx;
         idx %= alloc;
@@ -189,7 +197,7 @@ Identifier *IdentifierTable::identifier(const char *s, int len)
     QLatin1String latin(s, len);
     uint idx = hash % alloc;
     while (Heap::String *e = entries[idx]) {
-        if (e->stringHash == hash && e->toQString() == latin)
+        if (hashes[idx] == hash && e->toQString() == latin)
             return e->identifier;
         ++idx;
         idx %= alloc;
@@ -67,6 +67,9 @@ struct IdentifierTable
     int size;
     int numBits;
     Heap::String **entries;
+    // The hash of each entry, so that probing does not need to touch the
+    // strings themselves. Only valid where entries is not null.
+    uint *hashes;
 
     void addEntry(Heap::String *str);
 
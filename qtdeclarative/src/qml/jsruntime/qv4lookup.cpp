@@ -363,8 +363,41 @@ ReturnedValue Lookup::getterTwoClasses(Lookup *l, ExecutionEngine *engine, const
     return getterFallback(l, engine, object);
 }
 
+// Finds the own data property named by the lookup \a l on the ordinary object
+// \a o and returns its index, or UINT_MAX if there is none. Internal classes
+// never change, so a cache entry stays valid for as long as the engine lives.
+static uint megamorphicLookup(Lookup *l, ExecutionEngine *engine, const Object *o, PropertyAttributes *attrs)
+{
+    const Identifier *id = engine->current->compilationUnit->runtimeStrings[l->nameIndex]->identifier;
+    if (!id)
+        return UINT_MAX;
+
+    InternalClass *ic = o->internalClass();
+    ExecutionEngine::MegamorphicLookupCacheEntry *entry = engine->megamorphicLookupCacheEntry(ic, id);
+    if (entry->internalClass != ic || entry->identifier != id) {
+        const uint index = ic->find(id);
+        if (index == UINT_MAX || !ic->propertyData.at(index).isData())
+            return UINT_MAX;
+        entry->internalClass = ic;
+        entry->identifier = id;
+        entry->index = index;
+        entry->attrs = ic->propertyData.at(index);
+    }
+    *attrs = entry->attrs;
+    return entry->index;
+}
+
 ReturnedValue Lookup::getterFallback(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
+    if (const Object *obj = object.objectValue()) {
+        if (obj->vtable()->get == Object::static_vtbl.get) {
+            PropertyAttributes attrs;
+            const uint index = megamorphicLookup(l, engine, obj, &attrs);
+            if (index != UINT_MAX)
+                return obj->propertyData(index)->asReturnedValue();
+        }
+    }
+
     QV4::Scope scope(engine);
     QV4::ScopedObject o(scope, object.toObject(scope.engine));
     if (!o)
@@ -868,6 +901,18 @@ void Lookup::setterTwoClasses(Lookup *l, ExecutionEngine *engine, Value &object,
 
 void Lookup::setterFallback(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
 {
+    if (const Object *obj = object.objectValue()) {
+        // Writing the length of an array resizes it, so arrays take the slow path
+        if (obj->vtable()->put == Object::static_vtbl.put && !obj->isArrayObject()) {
+            PropertyAttributes attrs;
+            const uint index = megamorphicLookup(l, engine, obj, &attrs);
+            if (index != UINT_MAX && attrs.isWritable()) {
+                obj->setProperty(engine, index, value);
+                return;
+            }
+        }
+    }
+
     QV4::Scope scope(engine);
     QV4::ScopedObject o(scope, object.toObject(scope.engine));
     if (o) {
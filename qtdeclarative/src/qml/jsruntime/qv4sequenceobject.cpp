@@ -44,6 +44,7 @@
 #include <private/qv4functionobject_p.h>
 #include <private/qv4arrayobject_p.h>
 #include <private/qqmlengine_p.h>
+#include <private/qqmlnotifier_p.h>
 #include <private/qv4scopedvalue_p.h>
 #include "qv4runtime_p.h"
 #include "qv4objectiterator_p.h"
@@ -217,6 +218,47 @@ template <> bool convertValueToElement(const Value &value)
     return value.toBoolean();
 }
 
+// Tracks whether the container of a sequence that references a property still
+// holds the property's value. It is connected to the property's notify signal,
+// so the property only needs to be read again once it has changed.
+class QQmlSequenceReferenceEndpoint : public QQmlNotifierEndpoint
+{
+public:
+    QQmlSequenceReferenceEndpoint()
+        : QQmlNotifierEndpoint(QQmlNotifierEndpoint::QQmlSequenceReference)
+        , loaded(false)
+        , constant(false)
+    {}
+
+    bool loaded;
+    bool constant;
+};
+
+void QQmlSequenceReference_callback(QQmlNotifierEndpoint *e, void **)
+{
+    static_cast<QQmlSequenceReferenceEndpoint *>(e)->loaded = false;
+}
+
+static QQmlSequenceReferenceEndpoint *createReferenceEndpoint(ExecutionEngine *v4, QObject *object, int propertyIndex)
+{
+    QQmlEngine *engine = v4->qmlEngine();
+    if (!engine || object->thread() != engine->thread())
+        return 0;
+
+    const QMetaProperty property = object->metaObject()->property(propertyIndex);
+    if (property.isConstant()) {
+        QQmlSequenceReferenceEndpoint *endpoint = new QQmlSequenceReferenceEndpoint;
+        endpoint->constant = true;
+        return endpoint;
+    }
+    if (!property.hasNotifySignal())
+        return 0;
+
+    QQmlSequenceReferenceEndpoint *endpoint = new QQmlSequenceReferenceEndpoint;
+    endpoint->connect(object, QMetaObjectPrivate::signalIndex(property.notifySignal()), engine);
+    return endpoint;
+}
+
 namespace QV4 {
 
 template <typename Container> struct QQmlSequence;
@@ -229,11 +271,13 @@ struct QQmlSequence : Object {
     void init(QObject *object, int propertyIndex);
     void destroy() {
         delete container;
+        delete endpoint;
         object.destroy();
         Object::destroy();
     }
 
     mutable Container *container;
+    QQmlSequenceReferenceEndpoint *endpoint;
     QQmlQPointer<QObject> object;
     int propertyIndex;
     bool isReference;
@@ -531,8 +575,13 @@ public:
     {
         Q_ASSERT(d()->object);
         Q_ASSERT(d()->isReference);
+        QQmlSequenceReferenceEndpoint *endpoint = d()->endpoint;
+        if (endpoint && endpoint->loaded)
+            return;
         void *a[] = { d()->container, 0 };
         QMetaObject::metacall(d()->object, QMetaObject::ReadProperty, d()->propertyIndex, a);
+        if (endpoint && (endpoint->constant || endpoint->isConnected()))
+            endpoint->loaded = true;
     }
 
     void storeReference()
@@ -543,6 +592,9 @@ public:
         QQmlPropertyData::WriteFlags flags = QQmlPropertyData::DontRemoveBinding;
         void *a[] = { d()->container, 0, &status, &flags };
         QMetaObject::metacall(d()->object, QMetaObject::WriteProperty, d()->propertyIndex, a);
+        // The setter may not take the value as it is, read it again next time.
+        if (d()->endpoint)
+            d()->endpoint->loaded = false;
     }
 
     static QV4::ReturnedValue getIndexed(const QV4::Managed *that, uint index, bool *hasProperty)
@@ -566,6 +618,7 @@ void Heap::QQmlSequence<Container>::init(const Container &container)
 {
     Object::init();
     this->container = new Container(container);
+    endpoint = 0;
     propertyIndex = -1;
     isReference = false;
     object.init();
@@ -584,6 +637,7 @@ void Heap::QQmlSequence<Container>::init(QObject *object, int propertyIndex)
     this->propertyIndex = propertyIndex;
     isReference = true;
     this->object.init(object);
+    endpoint = createReferenceEndpoint(internalClass->engine, object, propertyIndex);
     QV4::Scope scope(internalClass->engine);
     QV4::Scoped<QV4::QQmlSequence<Container> > o(scope, this);
     o->setArrayType(Heap::ArrayData::Custom);
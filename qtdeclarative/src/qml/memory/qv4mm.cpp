@@ -407,6 +407,7 @@ bool Chunk::sweep(ExecutionEngine *engine)
         objectBitmap[i] = blackBitmap[i];
         grayBitmap[i] = 0;
         hasUsedSlots |= (blackBitmap[i] != 0);
+        blackBitmap[i] = 0;
         extendsBitmap[i] = e;
         lastSlotFree = !((objectBitmap[i]|extendsBitmap[i]) >> (sizeof(quintptr)*8 - 1));
         SDUMP() << "        new extends =" << binary(e);
@@ -459,11 +460,6 @@ void Chunk::freeAll(ExecutionEngine *engine)
     //    DEBUG << "swept chunk" << this << "freed" << slotsFreed << "slots.";
 }
 
-void Chunk::resetBlackBits()
-{
-    memset(blackBitmap, 0, sizeof(blackBitmap));
-}
-
 #ifdef MM_STATS
 static uint nGrayItems = 0;
 #endif
@@ -744,12 +740,6 @@ void BlockAllocator::freeAll()
     }
 }
 
-void BlockAllocator::resetBlackBits()
-{
-    for (auto c : chunks)
-        c->resetBlackBits();
-}
-
 void BlockAllocator::collectGrayItems(MarkStack *markStack)
 {
     for (auto c : chunks)
@@ -796,12 +786,6 @@ void HugeItemAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
     chunks.erase(newEnd, chunks.end());
 }
 
-void HugeItemAllocator::resetBlackBits()
-{
-    for (auto c : chunks)
-        Chunk::clearBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase());
-}
-
 void HugeItemAllocator::collectGrayItems(MarkStack *markStack)
 {
     for (auto c : chunks)
@@ -840,6 +824,7 @@ MemoryManager::MemoryManager(ExecutionEngine *engine)
     VALGRIND_CREATE_MEMPOOL(this, 0, true);
 #endif
     memset(statistics.allocations, 0, sizeof(statistics.allocations));
+    memset(statistics.pauses, 0, sizeof(statistics.pauses));
     if (gcStats)
         blockAllocator.allocationStats = statistics.allocations;
 }
@@ -1138,7 +1123,9 @@ void MemoryManager::runGC()
     QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
 //    qDebug() << "runGC";
 
+    QElapsedTimer pauseTimer;
     if (gcStats) {
+        pauseTimer.start();
         statistics.maxReservedMem = qMax(statistics.maxReservedMem, getAllocatedMem());
         statistics.maxAllocatedMem = qMax(statistics.maxAllocatedMem, getUsedMem() + getLargeItemsMem());
     }
@@ -1234,9 +1221,21 @@ void MemoryManager::runGC()
 
     usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep;
 
-    // reset all black bits
-    blockAllocator.resetBlackBits();
-    hugeItemAllocator.resetBlackBits();
+    // The sweep has already cleared all black bits, so we're ready for the next run.
+    if (gcStats)
+        recordPause(pauseTimer.nsecsElapsed() / 1000);
+}
+
+void MemoryManager::recordPause(qint64 usecs)
+{
+    ++statistics.gcRuns;
+    statistics.totalPause += usecs;
+    statistics.maxPause = qMax(statistics.maxPause, usecs);
+    // bin i counts pauses shorter than 2^i ms, the last one everything longer
+    int bin = 0;
+    while (bin < PauseBins - 1 && usecs >= (qint64(1000) << bin))
+        ++bin;
+    ++statistics.pauses[bin];
 }
 
 size_t MemoryManager::getUsedMem() const
@@ -1283,6 +1282,16 @@ void MemoryManager::dumpStats() const
     qDebug(stats) << "Total memory allocated:" << statistics.maxReservedMem;
     qDebug(stats) << "Max memory used before a GC run:" << statistics.maxAllocatedMem;
     qDebug(stats) << "Max memory used after a GC run:" << statistics.maxUsedMem;
+    qDebug(stats) << "GC runs:" << statistics.gcRuns;
+    if (statistics.gcRuns) {
+        qDebug(stats) << "Total GC pause time:" << statistics.totalPause << "us";
+        qDebug(stats) << "Average GC pause:" << statistics.totalPause / statistics.gcRuns << "us";
+        qDebug(stats) << "Longest GC pause:" << statistics.maxPause << "us";
+        qDebug(stats) << "GC pause durations:";
+        for (int i = 0; i < PauseBins - 1; ++i)
+            qDebug(stats) << "     <" << (1 << i) << "ms: " << statistics.pauses[i];
+        qDebug(stats) << "     >=" << (1 << (PauseBins - 2)) << "ms: " << statistics.pauses[PauseBins - 1];
+    }
     qDebug(stats) << "Requests for different item sizes:";
     for (int i = 1; i < BlockAllocator::NumBins - 1; ++i)
         qDebug(stats) << "     <" << (i << Chunk::SlotSizeShift) << " bytes: " << statistics.allocations[i];
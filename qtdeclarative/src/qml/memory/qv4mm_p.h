@@ -146,7 +146,6 @@ struct BlockAllocator {
 
     void sweep();
     void freeAll();
-    void resetBlackBits();
     void collectGrayItems(MarkStack *markStack);
 
     // bump allocations
@@ -168,7 +167,6 @@ struct HugeItemAllocator {
     HeapItem *allocate(size_t size);
     void sweep(ClassDestroyStatsCallback classCountPtr);
     void freeAll();
-    void resetBlackBits();
     void collectGrayItems(MarkStack *markStack);
 
     size_t usedMem() const {
@@ -448,6 +446,7 @@ private:
     void sweep(bool lastSweep = false, ClassDestroyStatsCallback classCountPtr = nullptr);
     bool shouldRunGC() const;
     void collectRoots(MarkStack *markStack);
+    void recordPause(qint64 usecs);
 
 public:
     QV4::ExecutionEngine *engine;
@@ -468,11 +467,16 @@ public:
     bool gcStats = false;
     bool gcCollectorStats = false;
 
+    enum { PauseBins = 8 };
     struct {
         size_t maxReservedMem = 0;
         size_t maxAllocatedMem = 0;
         size_t maxUsedMem = 0;
         uint allocations[BlockAllocator::NumBins];
+        uint gcRuns = 0;
+        qint64 totalPause = 0;
+        qint64 maxPause = 0;
+        uint pauses[PauseBins];
     } statistics;
 };
 
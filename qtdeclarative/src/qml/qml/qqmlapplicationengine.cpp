@@ -39,6 +39,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QTranslator>
+#include <QtCore/private/qstartuptrace_p.h>
 #include <QQmlComponent>
 #include "qqmlapplicationengine.h"
 #include "qqmlapplicationengine_p.h"
@@ -106,6 +107,7 @@ void QQmlApplicationEnginePrivate::startLoad(const QUrl &url, const QByteArray &
 {
     Q_Q(QQmlApplicationEngine);
 
+    QStartupTrace::begin("QQmlApplicationEngine::load");
     loadTranslations(url); //Translations must be loaded before the QML file is
     QQmlComponent *c = new QQmlComponent(q, q);
 
@@ -131,6 +133,7 @@ void QQmlApplicationEnginePrivate::finishLoad(QQmlComponent *c)
         q->objectCreated(0, c->url());
         break;
     case QQmlComponent::Ready: {
+        QStartupTraceScope trace("QQmlComponent::create");
         auto newObj = c->create();
         objects << newObj;
         QObject::connect(newObj, &QObject::destroyed, q, [&](QObject *obj) { objects.removeAll(obj); });
@@ -142,6 +145,7 @@ void QQmlApplicationEnginePrivate::finishLoad(QQmlComponent *c)
         return; //These cases just wait for the next status update
     }
 
+    QStartupTrace::end("QQmlApplicationEngine::load");
     c->deleteLater();
 }
 
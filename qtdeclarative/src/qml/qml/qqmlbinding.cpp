@@ -43,6 +43,7 @@
 #include "qqmlcontext.h"
 #include "qqmlinfo.h"
 #include "qqmldata_p.h"
+#include <private/qqmlglobal_p.h>
 #include <private/qqmlprofiler_p.h>
 #include <private/qqmlexpression_p.h>
 #include <private/qqmlscriptstring_p.h>
@@ -58,6 +59,8 @@
 
 QT_BEGIN_NAMESPACE
 
+DEFINE_BOOL_CONFIG_OPTION(deferBindingUpdates, QML_DEFERRED_BINDING_UPDATES);
+
 QQmlBinding *QQmlBinding::create(const QQmlPropertyData *property, const QQmlScriptString &script, QObject *obj, QQmlContext *ctxt)
 {
     QQmlBinding *b = newBinding(QQmlEnginePrivate::get(ctxt), property);
@@ -481,6 +484,14 @@ QString QQmlBinding::expressionIdentifier() const
 
 void QQmlBinding::expressionChanged()
 {
+    if (deferBindingUpdates()) {
+        if (QQmlContextData *ctxt = context()) {
+            if (ctxt->engine) {
+                QQmlEnginePrivate::get(ctxt->engine)->scheduleBindingUpdate(this);
+                return;
+            }
+        }
+    }
     update();
 }
 
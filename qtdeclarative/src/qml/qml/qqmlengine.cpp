@@ -57,6 +57,7 @@
 #include "qqmllist_p.h"
 #include "qqmltypenamecache_p.h"
 #include "qqmlnotifier_p.h"
+#include "qqmlbinding_p.h"
 #include "qqmlincubator.h"
 #include "qqmlabstracturlinterceptor.h"
 #include <private/qqmlboundsignal_p.h>
@@ -674,7 +675,7 @@ QQmlEnginePrivate::QQmlEnginePrivate(QQmlEngine *e)
   profiler(0),
 #endif
   outputWarningsToMsgLog(true),
-  cleanup(0), erroredBindings(0), inProgressCreations(0),
+  cleanup(0), erroredBindings(0), inProgressCreations(0), bindingUpdateScheduled(false),
   workerScriptEngine(0),
   activeObjectCreator(0),
 #if QT_CONFIG(qml_network)
@@ -1041,6 +1042,9 @@ QQmlEngine::~QQmlEngine()
     // may be required to handle the destruction signal.
     QQmlContextData::get(rootContext())->emitDestruction();
 
+    d->pendingBindingUpdates.clear();
+    d->pendingBindingSet.clear();
+
     // clean up all singleton type instances which we own.
     // we do this here and not in the private dtor since otherwise a crash can
     // occur (if we are the QObject parent of the QObject singleton instance)
@@ -1495,6 +1499,52 @@ bool QQmlEngine::event(QEvent *e)
     return QJSEngine::event(e);
 }
 
+/*!
+  \internal
+
+  Queues \a binding to be updated once control returns to the event loop,
+  unless it is queued already. Used when bindings are updated in batches (see
+  QML_DEFERRED_BINDING_UPDATES), so that a binding depending on several
+  properties that change together is evaluated once, with all of them updated.
+*/
+void QQmlEnginePrivate::scheduleBindingUpdate(QQmlBinding *binding)
+{
+    if (pendingBindingSet.contains(binding))
+        return;
+    pendingBindingSet.insert(binding);
+    pendingBindingUpdates.append(QQmlAbstractBinding::Ptr(binding));
+
+    if (!bindingUpdateScheduled) {
+        bindingUpdateScheduled = true;
+        Q_Q(QQmlEngine);
+        QMetaObject::invokeMethod(q, [this]() { updatePendingBindings(); }, Qt::QueuedConnection);
+    }
+}
+
+void QQmlEnginePrivate::updatePendingBindings()
+{
+    // Bindings are updated in rounds: the ones that become dirty while a round
+    // is evaluated depend on the ones in it and go into the next round. This
+    // evaluates a binding after everything it depends on, and only once per
+    // round. A binding loop keeps producing rounds, so after a bounded number
+    // of them the rest is left for the next pass through the event loop.
+    static const int maximumRounds = 64;
+    for (int round = 0; round < maximumRounds && !pendingBindingUpdates.isEmpty(); ++round) {
+        QVector<QQmlAbstractBinding::Ptr> bindings;
+        bindings.swap(pendingBindingUpdates);
+        pendingBindingSet.clear();
+        for (const QQmlAbstractBinding::Ptr &binding : qAsConst(bindings))
+            static_cast<QQmlBinding *>(binding.data())->update();
+    }
+
+    bindingUpdateScheduled = false;
+    if (!pendingBindingUpdates.isEmpty()) {
+        bindingUpdateScheduled = true;
+        Q_Q(QQmlEngine);
+        QMetaObject::invokeMethod(q, [this]() { updatePendingBindings(); }, Qt::QueuedConnection);
+    }
+}
+
 void QQmlEnginePrivate::doDeleteInEngineThread()
 {
     QFieldList<Deletable, &Deletable::next> list;
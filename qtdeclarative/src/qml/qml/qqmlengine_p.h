@@ -65,12 +65,14 @@
 #include "qqmlpropertycache_p.h"
 #include "qqmlmetatype_p.h"
 #include "qqmldirparser_p.h"
+#include "qqmlabstractbinding_p.h"
 #include <private/qintrusivelist_p.h>
 #include <private/qrecyclepool_p.h>
 #include <private/qfieldlist_p.h>
 
 #include <QtCore/qlist.h>
 #include <QtCore/qpair.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qstring.h>
@@ -93,6 +95,7 @@ class QNetworkAccessManager;
 class QQmlNetworkAccessManagerFactory;
 class QQmlTypeNameCache;
 class QQmlComponentAttached;
+class QQmlBinding;
 class QQmlCleanup;
 class QQmlDelayedError;
 class QQuickWorkerScriptEngine;
@@ -150,6 +153,13 @@ public:
     QQmlDelayedError *erroredBindings;
     int inProgressCreations;
 
+    // Bindings whose dependencies changed while updates are deferred
+    void scheduleBindingUpdate(QQmlBinding *binding);
+    void updatePendingBindings();
+    QVector<QQmlAbstractBinding::Ptr> pendingBindingUpdates;
+    QSet<QQmlAbstractBinding *> pendingBindingSet;
+    bool bindingUpdateScheduled;
+
     QV8Engine *v8engine() const { return q_func()->handle(); }
     QV4::ExecutionEngine *v4engine() const { return QV8Engine::getV4(q_func()->handle()); }
 
@@ -90,7 +90,8 @@ public:
         None = 0,
         QQmlBoundSignal = 1,
         QQmlJavaScriptExpressionGuard = 2,
-        QQmlVMEMetaObjectEndpoint = 3
+        QQmlVMEMetaObjectEndpoint = 3,
+        QQmlSequenceReference = 4
     };
 
     inline QQmlNotifierEndpoint(Callback callback);
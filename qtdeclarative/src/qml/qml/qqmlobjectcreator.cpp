@@ -722,7 +722,6 @@ void QQmlObjectCreator::setupBindings(bool applyDeferredBindings)
         }
     }
 
-    // ### this is best done through type-compile-time binding skip lists.
     if (_valueTypeProperty) {
         QQmlAbstractBinding *binding = QQmlPropertyPrivate::binding(_bindingTarget, QQmlPropertyIndex(_valueTypeProperty->coreIndex()));
 
@@ -732,14 +731,12 @@ void QQmlObjectCreator::setupBindings(bool applyDeferredBindings)
             QQmlValueTypeProxyBinding *proxy = static_cast<QQmlValueTypeProxyBinding *>(binding);
 
             if (qmlTypeForObject(_bindingTarget).isValid()) {
+                // The properties the bindings are assigned to were resolved at type
+                // compile time, so there is no need to look them up by name again
+                // for every instance.
                 quint32 bindingSkipList = 0;
-
-                QQmlPropertyData *defaultProperty = _compiledObject->indexOfDefaultPropertyOrAlias != -1 ? _propertyCache->parent()->defaultProperty() : _propertyCache->defaultProperty();
-
-                const QV4::CompiledData::Binding *binding = _compiledObject->bindingTable();
-                for (quint32 i = 0; i < _compiledObject->nBindings; ++i, ++binding) {
-                    QQmlPropertyData *property = binding->propertyNameIndex != 0 ? _propertyCache->property(stringAt(binding->propertyNameIndex), _qobject, context) : defaultProperty;
-                    if (property)
+                for (quint32 i = 0; i < _compiledObject->nBindings; ++i) {
+                    if (const QQmlPropertyData *property = propertyData.at(i))
                         bindingSkipList |= (1 << property->coreIndex());
                 }
 
@@ -58,6 +58,8 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qsemaphore.h>
 #include <QtQml/qqmlfile.h>
 #include <QtCore/qdiriterator.h>
 #include <QtQml/qqmlcomponent.h>
@@ -102,6 +104,7 @@
 DEFINE_BOOL_CONFIG_OPTION(dumpErrors, QML_DUMP_ERRORS);
 DEFINE_BOOL_CONFIG_OPTION(disableDiskCache, QML_DISABLE_DISK_CACHE);
 DEFINE_BOOL_CONFIG_OPTION(forceDiskCache, QML_FORCE_DISK_CACHE);
+DEFINE_BOOL_CONFIG_OPTION(disableParallelParsing, QML_DISABLE_PARALLEL_PARSING);
 
 Q_DECLARE_LOGGING_CATEGORY(DBG_DISK_CACHE)
 Q_LOGGING_CATEGORY(DBG_DISK_CACHE, "qt.qml.diskcache")
@@ -119,6 +122,57 @@ namespace {
     };
 }
 
+// Reads and parses a local QML file ahead of the loader thread. The loader
+// thread only ever works on one blob at a time, so the files a component
+// depends on are handed to a pool of these jobs when the component's types
+// are resolved, and parsed concurrently while the loader thread works through
+// them in order. Everything that touches the engine or the type registry
+// still happens on the loader thread.
+class QQmlTypeLoaderPrefetchJob : public QRunnable
+{
+public:
+    QQmlTypeLoaderPrefetchJob(const QUrl &url, const QSet<QString> &illegalNames, bool debugging)
+        : url(url), illegalNames(illegalNames), debugging(debugging)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        parse();
+        finished.release();
+    }
+
+    void parse()
+    {
+        // A compilation unit cached on disk is cheaper to load than any parse
+        if ((!disableDiskCache() || forceDiskCache()) && !debugging
+                && QV4::CompiledData::CompilationUnit::cacheFileExists(url)) {
+            return;
+        }
+
+        const QString fileName = QQmlFile::urlToLocalFileOrQrc(url);
+        QFile f(fileName);
+        if (!f.open(QIODevice::ReadOnly))
+            return;
+        sourceTimeStamp = QFileInfo(f).lastModified();
+        const QString source = QString::fromUtf8(f.readAll());
+
+        QScopedPointer<QmlIR::Document> doc(new QmlIR::Document(debugging));
+        QmlIR::IRBuilder compiler(illegalNames);
+        // Errors are left for the loader thread to report when it parses the file itself
+        if (compiler.generateFromQml(source, url.toString(), doc.data()))
+            document.reset(doc.take());
+    }
+
+    const QUrl url;
+    const QSet<QString> illegalNames;
+    const bool debugging;
+    QDateTime sourceTimeStamp;
+    QScopedPointer<QmlIR::Document> document;
+    QSemaphore finished;
+};
+
 #if QT_CONFIG(qml_network)
 // This is a lame object that we need to ensure that slots connected to
 // QNetworkReply get called in the correct thread (the loader thread).
@@ -1319,6 +1373,76 @@ void QQmlTypeLoader::setCachedUnit(QQmlDataBlob *blob, const QQmlPrivate::Cached
     blob->tryDone();
 }
 
+/*!
+Starts parsing the local QML files at \a urls on worker threads, unless they are
+already loaded or being parsed.
+
+The loader must not be locked.
+*/
+void QQmlTypeLoader::prefetchSources(const QVector<QUrl> &urls, bool debugging)
+{
+    if (disableParallelParsing() || QThread::idealThreadCount() < 2 || m_engine->urlInterceptor())
+        return;
+
+    LockHolder<QQmlTypeLoader> holder(this);
+
+    for (const QUrl &url : urls) {
+        if (!QQmlFile::isSynchronous(url) || m_typeCache.contains(url) || m_prefetchJobs.contains(url))
+            continue;
+        if (QQmlMetaType::findCachedCompilationUnit(url))
+            continue;
+
+        if (!m_prefetchPool) {
+            m_prefetchPool = new QThreadPool;
+            m_prefetchPool->setMaxThreadCount(QThread::idealThreadCount() - 1);
+        }
+
+        QQmlTypeLoaderPrefetchJob *job = new QQmlTypeLoaderPrefetchJob(url, QV8Engine::get(m_engine)->illegalNames(), debugging);
+        m_prefetchJobs.insert(url, job);
+        m_prefetchPool->start(job);
+    }
+}
+
+/*!
+Returns the document parsed ahead of time for \a url, or null if there is none or
+the file has been modified since. The caller takes ownership of the document.
+
+The loader must not be locked.
+*/
+QmlIR::Document *QQmlTypeLoader::takePrefetchedDocument(const QUrl &url, const QDateTime &sourceTimeStamp)
+{
+    QQmlTypeLoaderPrefetchJob *job = nullptr;
+    {
+        LockHolder<QQmlTypeLoader> holder(this);
+        job = m_prefetchJobs.take(url);
+    }
+    if (!job)
+        return nullptr;
+
+    // Rather than waiting for a job that has not started yet, parse right here
+    if (m_prefetchPool->tryTake(job))
+        job->parse();
+    else
+        job->finished.acquire();
+
+    QmlIR::Document *document = nullptr;
+    // Files without a modification time (resources) can't change while we're running
+    if (!job->sourceTimeStamp.isValid() || job->sourceTimeStamp == sourceTimeStamp)
+        document = job->document.take();
+    delete job;
+    return document;
+}
+
+void QQmlTypeLoader::clearPrefetchedSources()
+{
+    for (QQmlTypeLoaderPrefetchJob *job : qAsConst(m_prefetchJobs)) {
+        if (!m_prefetchPool->tryTake(job))
+            job->finished.acquire();
+        delete job;
+    }
+    m_prefetchJobs.clear();
+}
+
 void QQmlTypeLoader::shutdownThread()
 {
     if (m_thread && !m_thread->isShutdown())
@@ -1632,7 +1756,8 @@ Constructs a new type loader that uses the given \a engine.
 */
 QQmlTypeLoader::QQmlTypeLoader(QQmlEngine *engine)
     : m_engine(engine), m_thread(new QQmlTypeLoaderThread(this)),
-      m_typeCacheTrimThreshold(TYPELOADER_MINIMUM_TRIM_THRESHOLD)
+      m_typeCacheTrimThreshold(TYPELOADER_MINIMUM_TRIM_THRESHOLD),
+      m_prefetchPool(nullptr)
 {
 }
 
@@ -1646,6 +1771,8 @@ QQmlTypeLoader::~QQmlTypeLoader()
     shutdownThread();
 
     clearCache();
+    clearPrefetchedSources();
+    delete m_prefetchPool;
 
     invalidate();
 }
@@ -2452,6 +2579,12 @@ void QQmlTypeData::initializeFromCachedUnit(const QQmlPrivate::CachedQmlUnit *un
 
 bool QQmlTypeData::loadFromSource()
 {
+    if (QmlIR::Document *prefetched = typeLoader()->takePrefetchedDocument(url(), m_backupSourceCode.sourceTimeStamp())) {
+        m_document.reset(prefetched);
+        m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
+        return true;
+    }
+
     m_document.reset(new QmlIR::Document(isDebugging()));
     m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
     QQmlEngine *qmlEngine = typeLoader()->engine();
@@ -2675,6 +2808,12 @@ void QQmlTypeData::resolveTypes()
         return lhs.qualifiedName() < rhs.qualifiedName();
     });
 
+    // Resolve all type names first, so that the composite types among them
+    // can be parsed in parallel before we load them one by one.
+    QVector<QPair<int, TypeReference> > resolvedRefs;
+    resolvedRefs.reserve(m_typeReferences.size());
+    QVector<QUrl> compositeUrls;
+
     for (QV4::CompiledData::TypeReferenceMap::ConstIterator unresolvedRef = m_typeReferences.constBegin(), end = m_typeReferences.constEnd();
          unresolvedRef != end; ++unresolvedRef) {
 
@@ -2692,10 +2831,8 @@ void QQmlTypeData::resolveTypes()
                          QQmlType::AnyRegistrationType) && reportErrors)
             return;
 
-        if (ref.type.isComposite()) {
-            ref.typeData = typeLoader()->getType(ref.type.sourceUrl());
-            addDependency(ref.typeData);
-        }
+        if (ref.type.isComposite())
+            compositeUrls.append(ref.type.sourceUrl());
         ref.majorVersion = majorVersion;
         ref.minorVersion = minorVersion;
 
@@ -2704,7 +2841,19 @@ void QQmlTypeData::resolveTypes()
 
         ref.needsCreation = unresolvedRef->needsCreation;
 
-        m_resolvedTypes.insert(unresolvedRef.key(), ref);
+        resolvedRefs.append(qMakePair(unresolvedRef.key(), ref));
+    }
+
+    if (compositeUrls.size() > 1)
+        typeLoader()->prefetchSources(compositeUrls, isDebugging());
+
+    for (QPair<int, TypeReference> &resolvedRef : resolvedRefs) {
+        TypeReference &ref = resolvedRef.second;
+        if (ref.type.isComposite()) {
+            ref.typeData = typeLoader()->getType(ref.type.sourceUrl());
+            addDependency(ref.typeData);
+        }
+        m_resolvedTypes.insert(resolvedRef.first, ref);
     }
 
     // ### this allows enums to work without explicit import or instantiation of the type
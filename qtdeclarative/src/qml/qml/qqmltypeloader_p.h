@@ -78,6 +78,8 @@ QT_BEGIN_NAMESPACE
 
 class QQmlScriptData;
 class QQmlScriptBlob;
+class QQmlTypeLoaderPrefetchJob;
+class QThreadPool;
 class QQmlQmldirData;
 class QQmlTypeLoader;
 class QQmlComponentPrivate;
@@ -357,6 +359,10 @@ private:
     void setData(QQmlDataBlob *, const QQmlDataBlob::SourceCodeData &);
     void setCachedUnit(QQmlDataBlob *blob, const QQmlPrivate::CachedQmlUnit *unit);
 
+    void prefetchSources(const QVector<QUrl> &urls, bool debugging);
+    QmlIR::Document *takePrefetchedDocument(const QUrl &url, const QDateTime &sourceTimeStamp);
+    void clearPrefetchedSources();
+
     template<typename T>
     struct TypedCallback
     {
@@ -396,6 +402,9 @@ private:
     ImportDirCache m_importDirCache;
     ImportQmlDirCache m_importQmlDirCache;
 
+    QThreadPool *m_prefetchPool;
+    QHash<QUrl, QQmlTypeLoaderPrefetchJob *> m_prefetchJobs;
+
     template<typename Loader>
     void doLoad(const Loader &loader, QQmlDataBlob *blob, Mode mode);
     void updateTypeCacheTrimThreshold();
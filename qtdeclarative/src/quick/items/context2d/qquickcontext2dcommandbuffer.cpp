@@ -184,6 +184,21 @@ static void strokeShadowPath(QPainter* p, const QPainterPath& path, qreal offset
     shadowMaker.paintShapeAndShadow(p, offsetX, offsetY, blur, color);
 }
 
+// Returns whether \a rect, in the painter's user coordinates, can touch \a deviceRect.
+// The test is conservative; an empty device rect disables culling.
+static inline bool isVisible(const QPainter *p, const QRectF &deviceRect, const QRectF &rect)
+{
+    if (deviceRect.isEmpty())
+        return true;
+    return p->worldTransform().mapRect(rect).adjusted(-1, -1, 1, 1).intersects(deviceRect);
+}
+
+static inline QRectF strokeBoundingRect(const QPainterPath &path, const QPen &pen)
+{
+    const qreal margin = pen.widthF() * qMax<qreal>(1, pen.miterLimit()) / 2;
+    return path.controlPointRect().adjusted(-margin, -margin, margin, margin);
+}
+
 QPen QQuickContext2DCommandBuffer::makePen(const QQuickContext2D::State& state)
 {
     QPen pen;
@@ -272,6 +287,11 @@ void QQuickContext2DCommandBuffer::replay(QPainter* p, QQuickContext2D::State& s
     QPen pen = makePen(state);
     setPainterState(p, state, pen);
 
+    // Commands that fall entirely outside the target, which is common when replaying
+    // the whole buffer into each tile, are consumed without being painted.
+    QPaintDevice *device = p->device();
+    const QRectF deviceRect = device ? QRectF(0, 0, device->width(), device->height()) : QRectF();
+
     while (hasNext()) {
         QQuickContext2D::PaintCommand cmd = takeNextCommand();
         switch (cmd) {
@@ -294,7 +314,7 @@ void QQuickContext2DCommandBuffer::replay(QPainter* p, QQuickContext2D::State& s
             QRectF r = takeRect();
             if (HAS_SHADOW(state.shadowOffsetX, state.shadowOffsetY, state.shadowBlur, state.shadowColor))
                 fillRectShadow(p, r, state.shadowOffsetX, state.shadowOffsetY, state.shadowBlur, state.shadowColor);
-            else
+            else if (isVisible(p, deviceRect, r))
                 p->fillRect(r, p->brush());
             break;
         }
@@ -378,16 +398,17 @@ void QQuickContext2DCommandBuffer::replay(QPainter* p, QQuickContext2D::State& s
             path.closeSubpath();
             if (HAS_SHADOW(state.shadowOffsetX, state.shadowOffsetY, state.shadowBlur, state.shadowColor))
                 fillShadowPath(p,path, state.shadowOffsetX, state.shadowOffsetY, state.shadowBlur, state.shadowColor);
-            else
+            else if (isVisible(p, deviceRect, path.controlPointRect()))
                 p->fillPath(path, p->brush());
             break;
         }
         case QQuickContext2D::Stroke:
         {
+            QPainterPath path = takePath();
             if (HAS_SHADOW(state.shadowOffsetX, state.shadowOffsetY, state.shadowBlur, state.shadowColor))
-                strokeShadowPath(p,takePath(), state.shadowOffsetX, state.shadowOffsetY, state.shadowBlur, state.shadowColor);
-            else
-                p->strokePath(takePath(), p->pen());
+                strokeShadowPath(p,path, state.shadowOffsetX, state.shadowOffsetY, state.shadowBlur, state.shadowColor);
+            else if (isVisible(p, deviceRect, strokeBoundingRect(path, p->pen())))
+                p->strokePath(path, p->pen());
             break;
         }
         case QQuickContext2D::Clip:
@@ -415,7 +436,10 @@ void QQuickContext2DCommandBuffer::replay(QPainter* p, QQuickContext2D::State& s
         {
             QRectF sr = takeRect();
             QRectF dr = takeRect();
-            qt_drawImage(p, state, takeImage(), sr, dr, HAS_SHADOW(state.shadowOffsetX, state.shadowOffsetY, state.shadowBlur, state.shadowColor));
+            QImage image = takeImage();
+            const bool hasShadow = HAS_SHADOW(state.shadowOffsetX, state.shadowOffsetY, state.shadowBlur, state.shadowColor);
+            if (hasShadow || isVisible(p, deviceRect, dr))
+                qt_drawImage(p, state, image, sr, dr, hasShadow);
             break;
         }
         case QQuickContext2D::DrawPixmap:
@@ -428,7 +452,8 @@ void QQuickContext2DCommandBuffer::replay(QPainter* p, QQuickContext2D::State& s
 
             const bool hasShadow = HAS_SHADOW(state.shadowOffsetX, state.shadowOffsetY, state.shadowBlur, state.shadowColor);
             //TODO: generate shadow blur with shaders
-            qt_drawImage(p, state, pix->image(), sr, dr, hasShadow);
+            if (hasShadow || isVisible(p, deviceRect, dr))
+                qt_drawImage(p, state, pix->image(), sr, dr, hasShadow);
             break;
         }
         case QQuickContext2D::GetImageData:
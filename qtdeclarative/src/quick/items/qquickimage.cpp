@@ -617,6 +617,16 @@ QSGNode *QQuickImage::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
 {
     Q_D(QQuickImage);
 
+    // Defer creating the texture for a new image when this frame's upload
+    // budget is used up. The old node is dropped, as its texture may belong to
+    // the previous pixmap.
+    if (d->pixmapChanged && d->pix.isReady()
+            && !QQuickWindowPrivate::get(window())->consumeImageUploadBudget(qint64(d->pix.width()) * d->pix.height() * 4)) {
+        delete oldNode;
+        update();
+        return 0;
+    }
+
     QSGTexture *texture = d->sceneGraphRenderContext()->textureForFactory(d->pix.textureFactory(), window());
 
     // Copy over the current texture state into the texture provider...
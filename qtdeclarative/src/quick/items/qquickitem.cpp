@@ -5993,6 +5993,31 @@ void QQuickItemPrivate::setTransparentForPositioner(bool transparent)
     extra.value().transparentForPositioner = transparent;
 }
 
+bool QQuickItemPrivate::isStaticSubtreeHint() const
+{
+    return extra.isAllocated() && extra.value().staticSubtreeHint;
+}
+
+/*!
+    \internal
+
+    Hints the renderer that the item's subtree rarely changes. The item's
+    transform node is then made a batch root up front, so its batches are
+    kept apart from the rest of the scene. Changes elsewhere do not cause
+    them to be rebuilt, and moving the item only updates the root's matrix.
+*/
+void QQuickItemPrivate::setStaticSubtreeHint(bool hint)
+{
+    if (isStaticSubtreeHint() == hint)
+        return;
+    extra.value().staticSubtreeHint = hint;
+    if (itemNodeInstance) {
+        itemNodeInstance->setFlag(QSGNode::IsStaticSubtreeHint, hint);
+        // Let the renderer see the node again; it promotes it on a matrix change.
+        dirty(Transform);
+    }
+}
+
 
 QString QQuickItemPrivate::dirtyToString() const
 {
@@ -8561,7 +8586,7 @@ QQuickItemPrivate::ExtraData::ExtraData()
   recursiveEffectRefCount(0),
   opacityNode(0), clipNode(0), rootNode(0),
   acceptedMouseButtons(0), origin(QQuickItem::Center),
-  transparentForPositioner(false)
+  transparentForPositioner(false), staticSubtreeHint(false)
 {
 }
 
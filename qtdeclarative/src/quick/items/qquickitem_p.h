@@ -380,8 +380,9 @@ public:
 
         QQuickItem::TransformOrigin origin:5;
         uint transparentForPositioner : 1;
+        uint staticSubtreeHint : 1;
 
-        // 26 bits padding
+        // 25 bits padding
     };
     QLazilyAllocated<ExtraData> extra;
 
@@ -581,6 +582,9 @@ public:
     bool isTransparentForPositioner() const;
     void setTransparentForPositioner(bool trans);
 
+    bool isStaticSubtreeHint() const;
+    void setStaticSubtreeHint(bool hint);
+
     bool calcEffectiveVisible() const;
     bool setEffectiveVisibleRecur(bool);
     bool calcEffectiveEnable() const;
@@ -927,6 +931,8 @@ QSGTransformNode *QQuickItemPrivate::itemNode()
     if (!itemNodeInstance) {
         itemNodeInstance = createTransformNode();
         itemNodeInstance->setFlag(QSGNode::OwnedByParent, false);
+        if (isStaticSubtreeHint())
+            itemNodeInstance->setFlag(QSGNode::IsStaticSubtreeHint);
 #ifdef QSG_RUNTIME_DESCRIPTION
         Q_Q(QQuickItem);
         qsgnode_set_description(itemNodeInstance, QString::fromLatin1("QQuickItem(%1:%2)").arg(QString::fromLatin1(q->metaObject()->className())).arg(q->objectName()));
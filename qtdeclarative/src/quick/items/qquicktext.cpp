@@ -2300,7 +2300,10 @@ void QQuickText::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeo
     if ((effectiveHAlign() != QQuickText::AlignLeft && widthChanged) || verticalPositionChanged) {
         // If the width has changed and we're not left aligned do an update so the text is
         // repositioned even if a full layout isn't required. And the same for vertical.
-        d->updateType = QQuickTextPrivate::UpdatePaintNode;
+        // The existing glyph nodes are only translated unless something else has
+        // requested a full rebuild.
+        if (d->updateType != QQuickTextPrivate::UpdatePaintNode)
+            d->updateType = QQuickTextPrivate::UpdatePosition;
         update();
     }
 
@@ -2366,6 +2369,21 @@ QSGNode *QQuickText::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data
         return 0;
     }
 
+    const qreal dy = QQuickTextUtil::alignedY(d->layedOutTextRect.height() + d->lineHeightOffset(), d->availableHeight(), d->vAlign) + topPadding();
+
+    if (d->updateType == QQuickTextPrivate::UpdatePosition && oldNode != 0) {
+        // The layout is unchanged, only its alignment within the item moved. Keep the
+        // glyph nodes and translate them instead of regenerating the whole subtree.
+        d->updateType = QQuickTextPrivate::UpdateNone;
+        const qreal dx = d->richText
+                ? QQuickTextUtil::alignedX(d->layedOutTextRect.width(), d->availableWidth(), effectiveHAlign()) + leftPadding()
+                : QQuickTextUtil::alignedX(d->lineWidth, d->availableWidth(), effectiveHAlign()) + leftPadding();
+        QMatrix4x4 matrix;
+        matrix.translate(dx - d->nodeOffset.x(), dy - d->nodeOffset.y());
+        static_cast<QQuickTextNode *>(oldNode)->setMatrix(matrix);
+        return oldNode;
+    }
+
     if (d->updateType != QQuickTextPrivate::UpdatePaintNode && oldNode != 0) {
         // Update done in preprocess() in the nodes
         d->updateType = QQuickTextPrivate::UpdateNone;
@@ -2374,8 +2392,6 @@ QSGNode *QQuickText::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data
 
     d->updateType = QQuickTextPrivate::UpdateNone;
 
-    const qreal dy = QQuickTextUtil::alignedY(d->layedOutTextRect.height() + d->lineHeightOffset(), d->availableHeight(), d->vAlign) + topPadding();
-
     QQuickTextNode *node = 0;
     if (!oldNode)
         node = new QQuickTextNode(this);
@@ -2393,9 +2409,11 @@ QSGNode *QQuickText::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data
     if (d->richText) {
         const qreal dx = QQuickTextUtil::alignedX(d->layedOutTextRect.width(), d->availableWidth(), effectiveHAlign()) + leftPadding();
         d->ensureDoc();
+        d->nodeOffset = QPointF(dx, dy);
         node->addTextDocument(QPointF(dx, dy), d->extra->doc, color, d->style, styleColor, linkColor);
     } else if (d->layedOutTextRect.width() > 0) {
         const qreal dx = QQuickTextUtil::alignedX(d->lineWidth, d->availableWidth(), effectiveHAlign()) + leftPadding();
+        d->nodeOffset = QPointF(dx, dy);
         int unelidedLineCount = d->lineCount;
         if (d->elideLayout)
             unelidedLineCount -= 1;
@@ -91,6 +91,7 @@ public:
 
     QRectF layedOutTextRect;
     QSizeF advance;
+    QPointF nodeOffset;
 
     struct ExtraData {
         ExtraData();
@@ -142,6 +143,7 @@ public:
     enum UpdateType {
         UpdateNone,
         UpdatePreprocess,
+        UpdatePosition,
         UpdatePaintNode
     };
 
@@ -67,6 +67,7 @@
 #include <QtCore/qabstractanimation.h>
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QRunnable>
+#include <QtCore/qelapsedtimer.h>
 #include <QtQml/qqmlincubator.h>
 
 #include <QtQuick/private/qquickpixmapcache_p.h>
@@ -123,15 +124,16 @@ class QQuickWindowIncubationController : public QObject, public QQmlIncubationCo
 
 public:
     QQuickWindowIncubationController(QSGRenderLoop *loop)
-        : m_renderLoop(loop), m_timer(0)
+        : m_renderLoop(loop), m_timer(0), m_incubatedLastFrame(false)
     {
+        m_frame_time = qMax(1, int(1000 / QGuiApplication::primaryScreen()->refreshRate()));
         // Allow incubation for 1/3 of a frame.
-        m_incubation_time = qMax(1, int(1000 / QGuiApplication::primaryScreen()->refreshRate()) / 3);
+        m_incubation_time = qMax(1, m_frame_time / 3);
 
         QAnimationDriver *animationDriver = m_renderLoop->animationDriver();
         if (animationDriver) {
             connect(animationDriver, SIGNAL(stopped()), this, SLOT(animationStopped()));
-            connect(m_renderLoop, SIGNAL(timeToIncubate()), this, SLOT(incubate()));
+            connect(m_renderLoop, SIGNAL(timeToIncubate()), this, SLOT(incubateForFrame()));
         }
     }
 
@@ -164,6 +166,13 @@ public slots:
         }
     }
 
+    void incubateForFrame() {
+        if (m_renderLoop->interleaveIncubation())
+            adjustIncubationTime();
+        incubate();
+        m_incubatedLastFrame = incubatingObjectCount() > 0;
+    }
+
     void animationStopped() { incubate(); }
 
 protected:
@@ -174,9 +183,29 @@ protected:
     }
 
 private:
+    // When incubating in between frames, adapt the time slice to the frame
+    // rate that is actually achieved: if the previous frame incubated and the
+    // next one came late, give incubation less time, otherwise slowly give it
+    // more, up to half a frame.
+    void adjustIncubationTime() {
+        const qint64 elapsed = m_frameTimer.isValid() ? m_frameTimer.restart() : -1;
+        if (!m_frameTimer.isValid())
+            m_frameTimer.start();
+        if (elapsed < 0 || !m_incubatedLastFrame || elapsed > 4 * m_frame_time)
+            return;
+
+        if (2 * elapsed > 3 * m_frame_time)
+            m_incubation_time = qMax(1, m_incubation_time / 2);
+        else if (m_incubation_time < m_frame_time / 2)
+            ++m_incubation_time;
+    }
+
     QSGRenderLoop *m_renderLoop;
+    QElapsedTimer m_frameTimer;
+    int m_frame_time;
     int m_incubation_time;
     int m_timer;
+    bool m_incubatedLastFrame;
 };
 
 #include "qquickwindow.moc"
@@ -428,6 +457,7 @@ void QQuickWindowPrivate::syncSceneGraph()
         renderer->setRootNode(rootNode);
     }
 
+    imageUploadBudget = imageUploadBudgetPerFrame;
     updateDirtyNodes();
 
     animationController->afterNodeSync();
@@ -445,6 +475,24 @@ void QQuickWindowPrivate::syncSceneGraph()
     runAndClearJobs(&afterSynchronizingJobs);
 }
 
+/*!
+    \internal
+
+    Returns whether an item may create a texture of \a bytes in the current
+    sync, and if so, takes it from this frame's budget. The first texture of a
+    frame is always allowed, so that large images are not held back forever.
+    Items that are refused should schedule an update and try again.
+*/
+bool QQuickWindowPrivate::consumeImageUploadBudget(qint64 bytes)
+{
+    if (imageUploadBudgetPerFrame <= 0)
+        return true;
+    if (imageUploadBudget <= 0)
+        return false;
+    imageUploadBudget -= bytes;
+    return true;
+}
+
 void QQuickWindowPrivate::renderSceneGraph(const QSize &size)
 {
     QML_MEMORY_SCOPE_STRING("SceneGraph");
@@ -500,6 +548,8 @@ QQuickWindowPrivate::QQuickWindowPrivate()
     , devicePixelRatio(0)
     , context(0)
     , renderer(0)
+    , imageUploadBudgetPerFrame(0)
+    , imageUploadBudget(0)
     , windowManager(0)
     , renderControl(0)
     , pointerEventRecursionGuard(0)
@@ -546,6 +596,7 @@ void QQuickWindowPrivate::init(QQuickWindow *c, QQuickRenderControl *control)
     contentItem->setSize(q->size());
 
     customRenderMode = qgetenv("QSG_VISUALIZE");
+    imageUploadBudgetPerFrame = qint64(qEnvironmentVariableIntValue("QSG_IMAGE_UPLOAD_BUDGET")) * 1024;
     renderControl = control;
     if (renderControl)
         QQuickRenderControlPrivate::get(renderControl)->window = q;
@@ -251,6 +251,12 @@ public:
     QSGRenderer *renderer;
     QByteArray customRenderMode; // Default renderer supports "clip", "overdraw", "changes", "batches" and blank.
 
+    // Limits the bytes of new image textures created per sync (QSG_IMAGE_UPLOAD_BUDGET,
+    // in kilobytes), so that loading many images is spread over several frames.
+    bool consumeImageUploadBudget(qint64 bytes);
+    qint64 imageUploadBudgetPerFrame;
+    qint64 imageUploadBudget;
+
     QSGRenderLoop *windowManager;
     QQuickRenderControl *renderControl;
     QQuickAnimatorController *animationController;
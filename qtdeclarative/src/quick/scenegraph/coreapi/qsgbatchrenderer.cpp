@@ -909,7 +909,17 @@ void Renderer::unmap(Buffer *buffer, bool isIndexBuf)
         glGenBuffers(1, &buffer->id);
     GLenum target = isIndexBuf ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
     glBindBuffer(target, buffer->id);
-    glBufferData(target, buffer->size, buffer->data, m_bufferStrategy);
+    // With the dynamic and stream strategies the contents are expected to
+    // change often, so reuse the existing storage when the data still fits
+    // instead of allocating new storage for every upload. Reallocate when the
+    // data shrinks a lot, to not hold on to large buffers.
+    if (m_bufferStrategy != GL_STATIC_DRAW && buffer->size <= buffer->allocatedSize
+            && buffer->size * 2 > buffer->allocatedSize) {
+        glBufferSubData(target, 0, buffer->size, buffer->data);
+    } else {
+        glBufferData(target, buffer->size, buffer->data, m_bufferStrategy);
+        buffer->allocatedSize = buffer->size;
+    }
 
     if (!m_context->hasBrokenIndexBufferObjects() && m_visualizeMode == VisualizeNothing) {
         buffer->data = 0;
@@ -1024,6 +1034,11 @@ void Renderer::nodeWasAdded(QSGNode *node, Node *shadowParent)
     if (shadowParent)
         shadowParent->append(snode);
 
+    if (node->type() == QSGNode::TransformNodeType && shadowParent
+            && (node->flags() & QSGNode::IsStaticSubtreeHint)) {
+        turnNodeIntoBatchRoot(snode);
+    }
+
     if (node->type() == QSGNode::GeometryNodeType) {
         snode->data = m_elementAllocator.allocate();
         snode->element()->setNode(static_cast<QSGGeometryNode *>(node));
@@ -1200,7 +1215,8 @@ void Renderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
 
     if (state & QSGNode::DirtyMatrix && !shadowNode->isBatchRoot) {
         Q_ASSERT(node->type() == QSGNode::TransformNodeType);
-        if (node->m_subtreeRenderableCount > m_batchNodeThreshold) {
+        if (node->m_subtreeRenderableCount > m_batchNodeThreshold
+                || (node->flags() & QSGNode::IsStaticSubtreeHint)) {
             turnNodeIntoBatchRoot(shadowNode);
         } else {
             int vertices = 0;
@@ -2431,20 +2447,36 @@ void Renderer::renderUnmergedBatch(const Batch *batch)
 #endif
 
     QMatrix4x4 rootMatrix = batch->root ? qsg_matrixForRoot(batch->root) : QMatrix4x4();
+    const QMatrix4x4 projection = projectionMatrix();
+    char const *const *attrNames = program->attributeNames();
 
+    bool first = true;
     while (e) {
         gn = e->node;
 
-        m_current_model_view_matrix = rootMatrix * *gn->matrix();
-        m_current_determinant = m_current_model_view_matrix.determinant();
+        // Nodes often share their transform, for instance the children of a
+        // rotated item. Only push the matrices when they differ from those of
+        // the previous node.
+        const QMatrix4x4 modelViewMatrix = rootMatrix * *gn->matrix();
+        if (first || modelViewMatrix != m_current_model_view_matrix) {
+            m_current_model_view_matrix = modelViewMatrix;
+            m_current_determinant = m_current_model_view_matrix.determinant();
+            dirty |= QSGMaterialShader::RenderState::DirtyMatrix;
+        }
 
-        m_current_projection_matrix = projectionMatrix();
         if (m_useDepthBuffer) {
+            m_current_projection_matrix = projection;
             m_current_projection_matrix(2, 2) = m_zRange;
             m_current_projection_matrix(2, 3) = 1.0f - e->order * m_zRange;
+            dirty |= QSGMaterialShader::RenderState::DirtyMatrix;
+        } else if (first) {
+            m_current_projection_matrix = projection;
         }
 
-        program->updateState(state(dirty), material, m_currentMaterial);
+        // All nodes share the material of the first one, so with nothing dirty
+        // the shader state from the previous node still applies.
+        if (dirty)
+            program->updateState(state(dirty), material, m_currentMaterial);
 
 #ifndef QT_NO_DEBUG
     if (qsg_test_and_clear_material_failure()) {
@@ -2461,7 +2493,6 @@ void Renderer::renderUnmergedBatch(const Batch *batch)
         m_currentMaterial = material;
 
         QSGGeometry* g = gn->geometry();
-        char const *const *attrNames = program->attributeNames();
         int offset = 0;
         for (int j = 0; attrNames[j]; ++j) {
             if (!*attrNames[j])
@@ -2481,8 +2512,10 @@ void Renderer::renderUnmergedBatch(const Batch *batch)
         vOffset += g->sizeOfVertex() * g->vertexCount();
         iOffset += g->indexCount() * g->sizeOfIndex();
 
-        // We only need to push this on the very first iteration...
-        dirty &= ~QSGMaterialShader::RenderState::DirtyOpacity;
+        // Opacity only needs to be pushed on the very first iteration, the
+        // matrices whenever they change.
+        dirty = 0;
+        first = false;
 
         e = e->nextInBatch;
     }
@@ -2615,6 +2648,7 @@ void Renderer::render()
         QSGNodeDumper::dump(rootNode());
     }
 
+    const bool profileFrames = debug_render() || QSG_LOG_TIME_RENDERER().isDebugEnabled();
     QElapsedTimer timer;
     quint64 timeRenderLists = 0;
     quint64 timePrepareOpaque = 0;
@@ -2639,9 +2673,11 @@ void Renderer::render()
         }
 
         qDebug() << "Renderer::render()" << this << type;
-        timer.start();
     }
 
+    if (Q_UNLIKELY(profileFrames))
+        timer.start();
+
     if (m_vao)
         m_vao->bind();
 
@@ -2666,7 +2702,7 @@ void Renderer::render()
             }
         }
     }
-    if (Q_UNLIKELY(debug_render())) timeRenderLists = timer.restart();
+    if (Q_UNLIKELY(profileFrames)) timeRenderLists = timer.restart();
 
     for (int i=0; i<m_opaqueBatches.size(); ++i)
         m_opaqueBatches.at(i)->cleanupRemovedElements();
@@ -2679,9 +2715,9 @@ void Renderer::render()
 
     if (m_rebuild & BuildBatches) {
         prepareOpaqueBatches();
-        if (Q_UNLIKELY(debug_render())) timePrepareOpaque = timer.restart();
+        if (Q_UNLIKELY(profileFrames)) timePrepareOpaque = timer.restart();
         prepareAlphaBatches();
-        if (Q_UNLIKELY(debug_render())) timePrepareAlpha = timer.restart();
+        if (Q_UNLIKELY(profileFrames)) timePrepareAlpha = timer.restart();
 
         if (Q_UNLIKELY(debug_build())) {
             qDebug() << "Opaque Batches:";
@@ -2702,7 +2738,7 @@ void Renderer::render()
             }
         }
     } else {
-        if (Q_UNLIKELY(debug_render())) timePrepareOpaque = timePrepareAlpha = timer.restart();
+        if (Q_UNLIKELY(profileFrames)) timePrepareOpaque = timePrepareAlpha = timer.restart();
     }
 
 
@@ -2723,7 +2759,7 @@ void Renderer::render()
                  : 0;
     }
 
-    if (Q_UNLIKELY(debug_render())) timeSorting = timer.restart();
+    if (Q_UNLIKELY(profileFrames)) timeSorting = timer.restart();
 
     int largestVBO = 0;
 #ifdef QSG_SEPARATE_INDEX_BUFFER
@@ -2739,7 +2775,7 @@ void Renderer::render()
 #endif
         uploadBatch(b);
     }
-    if (Q_UNLIKELY(debug_render())) timeUploadOpaque = timer.restart();
+    if (Q_UNLIKELY(profileFrames)) timeUploadOpaque = timer.restart();
 
 
     if (Q_UNLIKELY(debug_upload())) qDebug() << "Uploading Alpha Batches:";
@@ -2751,7 +2787,7 @@ void Renderer::render()
         largestIBO = qMax(b->ibo.size, largestIBO);
 #endif
     }
-    if (Q_UNLIKELY(debug_render())) timeUploadAlpha = timer.restart();
+    if (Q_UNLIKELY(profileFrames)) timeUploadAlpha = timer.restart();
 
     if (largestVBO * 2 < m_vertexUploadPool.size())
         m_vertexUploadPool.resize(largestVBO * 2);
@@ -2769,6 +2805,15 @@ void Renderer::render()
                (int) timeSorting,
                (int) timeUploadOpaque, (int) timeUploadAlpha,
                (int) timer.elapsed());
+    } else if (Q_UNLIKELY(profileFrames)) {
+        qCDebug(QSG_LOG_TIME_RENDERER,
+                "batch renderer: build=%d, prepare(opaque/alpha)=%d/%d, sorting=%d, upload(opaque/alpha)=%d/%d, render=%d, batches(opaque/alpha)=%d/%d",
+                int(timeRenderLists),
+                int(timePrepareOpaque), int(timePrepareAlpha),
+                int(timeSorting),
+                int(timeUploadOpaque), int(timeUploadAlpha),
+                int(timer.elapsed()),
+                m_opaqueBatches.size(), m_alphaBatches.size());
     }
 
     m_rebuild = 0;
@@ -2919,6 +2964,27 @@ void Renderer::releaseCachedResources()
     m_shaderManager->invalidated();
 }
 
+/*!
+    \internal
+
+    Compiles and links the shaders of \a materials up front, so that the first
+    frame using them does not have to, for instance while a splash screen is
+    shown. Must be called with the render context's OpenGL context current.
+
+    The variant used for merged batches is prepared, unless the material
+    cannot be merged. Like shaders compiled on demand, the programs go
+    through the OpenGL program binary disk cache.
+*/
+void Renderer::prepareMaterials(const QVector<QSGMaterial *> &materials)
+{
+    for (QSGMaterial *material : materials) {
+        if (material->flags() & (QSGMaterial::CustomCompileStep | QSGMaterial_FullMatrix))
+            m_shaderManager->prepareMaterialNoRewrite(material);
+        else
+            m_shaderManager->prepareMaterial(material);
+    }
+}
+
 class VisualizeShader : public QOpenGLShaderProgram
 {
 public:
@@ -2961,7 +3027,9 @@ void Renderer::visualizeBatch(Batch *b)
 
     shader->setUniformValue(shader->pattern, float(b->merged ? 0 : 1));
 
-    QColor color = QColor::fromHsvF((rand() & 1023) / 1023.0, 1.0, 1.0);
+    // Batches below a root hinted as static are drawn in pastel colors.
+    const bool staticRoot = b->root && (b->root->sgNode->flags() & QSGNode::IsStaticSubtreeHint);
+    QColor color = QColor::fromHsvF((rand() & 1023) / 1023.0, staticRoot ? 0.3 : 1.0, 1.0);
     float cr = color.redF();
     float cg = color.greenF();
     float cb = color.blueF();
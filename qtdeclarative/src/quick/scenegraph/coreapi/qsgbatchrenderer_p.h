@@ -298,6 +298,8 @@ inline QDebug operator << (QDebug d, const Rect &r) {
 struct Buffer {
     GLuint id;
     int size;
+    // The size of the buffer object's storage, which can be larger than size.
+    int allocatedSize;
     // Data is only valid while preparing the upload. Exception is if we are using the
     // broken IBO workaround or we are using a visualization mode.
     char *data;
@@ -626,6 +628,8 @@ public:
         VisualizeOverdraw
     };
 
+    void prepareMaterials(const QVector<QSGMaterial *> &materials);
+
 protected:
     void nodeChanged(QSGNode *node, QSGNode::DirtyState state) Q_DECL_OVERRIDE;
     void render() Q_DECL_OVERRIDE;
@@ -97,7 +97,8 @@ public:
 
         // Uppermost 8 bits are reserved for internal use.
 #ifndef qdoc
-        IsVisitableNode             = 0x01000000
+        IsVisitableNode             = 0x01000000,
+        IsStaticSubtreeHint         = 0x02000000
 #else
         InternalReserved            = 0x01000000
 #endif
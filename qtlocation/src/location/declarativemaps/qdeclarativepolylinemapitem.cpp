@@ -42,6 +42,7 @@
 #include <QtLocation/private/qgeomap_p.h>
 
 #include <QtCore/QScopedValueRollback>
+#include <QtCore/qmath.h>
 #include <QtQml/QQmlInfo>
 #include <QtQml/private/qqmlengine_p.h>
 #include <QPainter>
@@ -361,10 +362,9 @@ void QGeoMapPolylineGeometry::updateScreenPoints(const QGeoMap &map,
     viewport.translate(-1 * origin);
 
     // The geometry has already been clipped against the visible region projection in wrapped mercator space.
-    QVector<qreal> points = srcPoints_;
-    QVector<QPainterPath::ElementType> types = srcPointTypes_;
-
-    QVectorPath vp(points.data(), types.size(), types.data());
+    // QVectorPath only reads the data, so pass the source arrays directly instead of
+    // detaching copies of them.
+    QVectorPath vp(srcPoints_.constData(), srcPointTypes_.size(), srcPointTypes_.constData());
     QTriangulatingStroker ts;
     // viewport is not used in the call below.
     ts.process(vp, QPen(QBrush(Qt::black), strokeWidth), viewport, QPainter::Qt4CompatiblePainting);
@@ -755,6 +755,7 @@ void QDeclarativePolylineMapItem::regenerateCache()
     geopathProjected_.reserve(geopath_.path().size());
     for (const QGeoCoordinate &c : geopath_.path())
         geopathProjected_ << map()->geoProjection().geoToMapProjection(c);
+    simplifiedPaths_.clear();
 }
 
 /*!
@@ -764,7 +765,89 @@ void QDeclarativePolylineMapItem::updateCache()
 {
     if (!map())
         return;
-    geopathProjected_ << map()->geoProjection().geoToMapProjection(geopath_.path().last());
+    const QDoubleVector2D projected = map()->geoProjection().geoToMapProjection(geopath_.path().last());
+    geopathProjected_ << projected;
+    // Appending the new point keeps every cached simplification within its tolerance
+    for (QList<QDoubleVector2D> &simplified : simplifiedPaths_)
+        simplified << projected;
+}
+
+/*!
+    \internal
+    Douglas-Peucker simplification of \a path, keeping every point that is further
+    than \a tolerance away from the simplified line. The end points are always kept.
+*/
+static QList<QDoubleVector2D> simplifyPath(const QList<QDoubleVector2D> &path, double tolerance)
+{
+    const int count = path.size();
+    if (count < 3)
+        return path;
+
+    QVector<bool> keep(count, false);
+    keep[0] = keep[count - 1] = true;
+
+    QVector<QPair<int, int> > ranges;
+    ranges << qMakePair(0, count - 1);
+    const double toleranceSquared = tolerance * tolerance;
+    while (!ranges.isEmpty()) {
+        const QPair<int, int> range = ranges.takeLast();
+        const QDoubleVector2D &a = path.at(range.first);
+        const QDoubleVector2D ab = path.at(range.second) - a;
+        const double abLengthSquared = QDoubleVector2D::dotProduct(ab, ab);
+
+        double maxDistanceSquared = 0.0;
+        int maxIndex = -1;
+        for (int i = range.first + 1; i < range.second; ++i) {
+            const QDoubleVector2D ap = path.at(i) - a;
+            double distanceSquared;
+            if (abLengthSquared == 0.0) {
+                distanceSquared = QDoubleVector2D::dotProduct(ap, ap);
+            } else {
+                const double t = qBound(0.0, QDoubleVector2D::dotProduct(ap, ab) / abLengthSquared, 1.0);
+                const QDoubleVector2D d = ap - ab * t;
+                distanceSquared = QDoubleVector2D::dotProduct(d, d);
+            }
+            if (distanceSquared > maxDistanceSquared) {
+                maxDistanceSquared = distanceSquared;
+                maxIndex = i;
+            }
+        }
+
+        if (maxIndex != -1 && maxDistanceSquared > toleranceSquared) {
+            keep[maxIndex] = true;
+            ranges << qMakePair(range.first, maxIndex) << qMakePair(maxIndex, range.second);
+        }
+    }
+
+    QList<QDoubleVector2D> simplified;
+    for (int i = 0; i < count; ++i) {
+        if (keep.at(i))
+            simplified << path.at(i);
+    }
+    return simplified;
+}
+
+/*!
+    \internal
+    Returns the projected path simplified to half a pixel at the next integer
+    zoom level. The simplification is computed once per level and cached.
+    Tilted maps do not have a uniform scale, so they use the full path.
+*/
+const QList<QDoubleVector2D> &QDeclarativePolylineMapItem::simplifiedProjectedPath()
+{
+    static const int minimumPointsToSimplify = 64;
+    const QGeoCameraData cameraData = map()->cameraData();
+    if (geopathProjected_.size() < minimumPointsToSimplify || cameraData.tilt() != 0.0)
+        return geopathProjected_;
+
+    const int level = qCeil(cameraData.zoomLevel());
+    QMap<int, QList<QDoubleVector2D> >::iterator it = simplifiedPaths_.find(level);
+    if (it == simplifiedPaths_.end()) {
+        // The projection is normalized to [0, 1], assume 256 pixel tiles
+        const double tolerance = 0.5 / (256.0 * qPow(2.0, level));
+        it = simplifiedPaths_.insert(level, simplifyPath(geopathProjected_, tolerance));
+    }
+    return it.value();
 }
 
 /*!
@@ -778,7 +861,7 @@ void QDeclarativePolylineMapItem::updatePolish()
     QScopedValueRollback<bool> rollback(updatingGeometry_);
     updatingGeometry_ = true;
 
-    geometry_.updateSourcePoints(*map(), geopathProjected_, geopath_.boundingGeoRectangle().topLeft());
+    geometry_.updateSourcePoints(*map(), simplifiedProjectedPath(), geopath_.boundingGeoRectangle().topLeft());
     geometry_.updateScreenPoints(*map(), line_.width());
 
     setWidth(geometry_.sourceBoundingBox().width());
@@ -55,6 +55,7 @@
 #include <QtPositioning/private/qdoublevector2d_p.h>
 #include <QSGGeometryNode>
 #include <QSGFlatColorMaterial>
+#include <QtCore/QMap>
 
 QT_BEGIN_NAMESPACE
 
@@ -165,9 +166,11 @@ protected Q_SLOTS:
 private:
     void regenerateCache();
     void updateCache();
+    const QList<QDoubleVector2D> &simplifiedProjectedPath();
 
     QGeoPath geopath_;
     QList<QDoubleVector2D> geopathProjected_;
+    QMap<int, QList<QDoubleVector2D> > simplifiedPaths_; // keyed by integer zoom level
     QDeclarativeMapLineProperties line_;
     QColor color_;
     bool dirtyMaterial_;
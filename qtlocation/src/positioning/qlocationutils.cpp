@@ -61,8 +61,7 @@ static double qlocationutils_nmeaDegreesToDecimal(double nmeaDegrees)
 static void qlocationutils_readGga(const char *data, int size, QGeoPositionInfo *info, double uere,
                                    bool *hasFix)
 {
-    QByteArray sentence(data, size);
-    QList<QByteArray> parts = sentence.split(',');
+    QList<QByteArray> parts = QByteArray::fromRawData(data, size).split(',');
     QGeoCoordinate coord;
 
     if (hasFix && parts.count() > 6 && parts[6].count() > 0)
@@ -126,8 +125,7 @@ static void qlocationutils_readGsa(const char *data, int size, QGeoPositionInfo
 
 static void qlocationutils_readGll(const char *data, int size, QGeoPositionInfo *info, bool *hasFix)
 {
-    QByteArray sentence(data, size);
-    QList<QByteArray> parts = sentence.split(',');
+    QList<QByteArray> parts = QByteArray::fromRawData(data, size).split(',');
     QGeoCoordinate coord;
 
     if (hasFix && parts.count() > 6 && parts[6].count() > 0)
@@ -154,8 +152,7 @@ static void qlocationutils_readGll(const char *data, int size, QGeoPositionInfo
 
 static void qlocationutils_readRmc(const char *data, int size, QGeoPositionInfo *info, bool *hasFix)
 {
-    QByteArray sentence(data, size);
-    QList<QByteArray> parts = sentence.split(',');
+    QList<QByteArray> parts = QByteArray::fromRawData(data, size).split(',');
     QGeoCoordinate coord;
     QDate date;
     QTime time;
@@ -216,8 +213,7 @@ static void qlocationutils_readVtg(const char *data, int size, QGeoPositionInfo
     if (hasFix)
         *hasFix = false;
 
-    QByteArray sentence(data, size);
-    QList<QByteArray> parts = sentence.split(',');
+    QList<QByteArray> parts = QByteArray::fromRawData(data, size).split(',');
 
     bool parsed = false;
     double value = 0.0;
@@ -238,8 +234,7 @@ static void qlocationutils_readZda(const char *data, int size, QGeoPositionInfo
     if (hasFix)
         *hasFix = false;
 
-    QByteArray sentence(data, size);
-    QList<QByteArray> parts = sentence.split(',');
+    QList<QByteArray> parts = QByteArray::fromRawData(data, size).split(',');
     QDate date;
     QTime time;
 
@@ -340,35 +335,61 @@ bool QLocationUtils::hasValidNmeaChecksum(const char *data, int size)
         return ::strncmp(calc, &data[asteriskIndex+1], 2) == 0;
         */
 
-    QByteArray checkSumBytes(&data[asteriskIndex + 1], 2);
-    bool ok = false;
-    int checksum = checkSumBytes.toInt(&ok,16);
-    return ok && checksum == result;
+    int checksum = 0;
+    for (int i = asteriskIndex + 1; i <= asteriskIndex + CSUM_LEN; ++i) {
+        const char c = data[i];
+        int digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else
+            return false;
+        checksum = checksum * 16 + digit;
+    }
+    return checksum == result;
+}
+
+// Parses \a count decimal digits starting at \a data, returns -1 if any of them is not a digit.
+static int qlocationutils_parseDigits(const char *data, int count)
+{
+    int value = 0;
+    for (int i = 0; i < count; ++i) {
+        if (data[i] < '0' || data[i] > '9')
+            return -1;
+        value = value * 10 + (data[i] - '0');
+    }
+    return value;
 }
 
 bool QLocationUtils::getNmeaTime(const QByteArray &bytes, QTime *time)
 {
-    int dotIndex = bytes.indexOf('.');
-    QTime tempTime;
-
-    if (dotIndex < 0) {
-        tempTime = QTime::fromString(QString::fromLatin1(bytes.constData()),
-                                     QStringLiteral("hhmmss"));
-    } else {
-        tempTime = QTime::fromString(QString::fromLatin1(bytes.mid(0, dotIndex)),
-                                     QStringLiteral("hhmmss"));
-        bool hasMsecs = false;
-        int midLen = qMin(3, bytes.size() - dotIndex - 1);
-        int msecs = bytes.mid(dotIndex + 1, midLen).toUInt(&hasMsecs);
-        if (hasMsecs)
+    // "hhmmss" optionally followed by "." and fractional seconds. Parse the digits
+    // directly, this is called for nearly every sentence.
+    const int dotIndex = bytes.indexOf('.');
+    const int timeLength = dotIndex < 0 ? bytes.size() : dotIndex;
+    if (timeLength != 6)
+        return false;
+
+    const char *data = bytes.constData();
+    const int hours = qlocationutils_parseDigits(data, 2);
+    const int minutes = qlocationutils_parseDigits(data + 2, 2);
+    const int seconds = qlocationutils_parseDigits(data + 4, 2);
+    if (hours < 0 || minutes < 0 || seconds < 0 || !QTime::isValid(hours, minutes, seconds))
+        return false;
+
+    QTime tempTime(hours, minutes, seconds);
+    if (dotIndex >= 0) {
+        const int midLen = qMin(3, bytes.size() - dotIndex - 1);
+        const int msecs = midLen > 0 ? qlocationutils_parseDigits(data + dotIndex + 1, midLen) : -1;
+        if (msecs >= 0)
             tempTime = tempTime.addMSecs(msecs*(midLen == 3 ? 1 : midLen == 2 ? 10 : 100));
     }
 
-    if (tempTime.isValid()) {
-        *time = tempTime;
-        return true;
-    }
-    return false;
+    *time = tempTime;
+    return true;
 }
 
 bool QLocationUtils::getNmeaLatLong(const QByteArray &latString, char latDirection, const QByteArray &lngString, char lngDirection, double *lat, double *lng)
@@ -47,6 +47,7 @@
 #include <gst/base/gstbasesrc.h>
 
 #include <QtCore/qdatetime.h>
+#include <QtCore/qmetaobject.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qsize.h>
 #include <QtCore/qtimer.h>
@@ -55,7 +56,7 @@
 #include <QtCore/qstandardpaths.h>
 #include <QtCore/qurl.h>
 
-#define MAX_BUFFERS_IN_QUEUE 4
+#define MAX_BUFFERS_IN_QUEUE 16
 
 QT_BEGIN_NAMESPACE
 
@@ -523,9 +524,15 @@ GstFlowReturn QGstreamerAudioDecoderSession::new_sample(GstAppSink *, gpointer u
         Q_ASSERT(session->m_buffersAvailable <= MAX_BUFFERS_IN_QUEUE);
     }
 
+    // Called for every decoded buffer, avoid looking the signals up by name each time
+    static const QMetaMethod bufferAvailableChangedSignal =
+            QMetaMethod::fromSignal(&QGstreamerAudioDecoderSession::bufferAvailableChanged);
+    static const QMetaMethod bufferReadySignal =
+            QMetaMethod::fromSignal(&QGstreamerAudioDecoderSession::bufferReady);
+
     if (!buffersAvailable)
-        QMetaObject::invokeMethod(session, "bufferAvailableChanged", Qt::QueuedConnection, Q_ARG(bool, true));
-    QMetaObject::invokeMethod(session, "bufferReady", Qt::QueuedConnection);
+        bufferAvailableChangedSignal.invoke(session, Qt::QueuedConnection, Q_ARG(bool, true));
+    bufferReadySignal.invoke(session, Qt::QueuedConnection);
     return GST_FLOW_OK;
 }
 
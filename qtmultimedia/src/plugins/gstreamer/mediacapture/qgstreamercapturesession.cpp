@@ -179,6 +179,10 @@ GstElement *QGstreamerCaptureSession::buildEncodeBin()
         GstElement *videoscale = gst_element_factory_make("videoscale","videoscale-encoder");
         gst_bin_add_many(GST_BIN(encodeBin), videoQueue, colorspace, videoscale, NULL);
 
+        // The default byte limit holds less than one raw HD frame, which stalls the
+        // source while the encoder catches up. Only limit the queue by time.
+        g_object_set(G_OBJECT(videoQueue), "max-size-buffers", 0u, "max-size-bytes", 0u, NULL);
+
         GstElement *videoEncoder = m_videoEncodeControl->createEncoder();
         if (!videoEncoder) {
             gst_object_unref(encodeBin);
@@ -606,6 +610,14 @@ bool QGstreamerCaptureSession::rebuildGraph(QGstreamerCaptureSession::PipelineMo
                 ok &= m_videoSrc && m_videoPreview && m_videoTee && m_videoPreviewQueue;
 
                 if (ok) {
+                    // Drop viewfinder frames rather than blocking the tee, a slow
+                    // preview must not make the recording lose frames.
+                    g_object_set(G_OBJECT(m_videoPreviewQueue),
+                                 "leaky", 2 /* downstream */,
+                                 "max-size-buffers", 1u,
+                                 "max-size-bytes", 0u,
+                                 "max-size-time", G_GUINT64_CONSTANT(0),
+                                 NULL);
                     gst_bin_add_many(GST_BIN(m_pipeline), m_videoSrc, m_videoTee,
                                  m_videoPreviewQueue, m_videoPreview, NULL);
                     ok &= gst_element_link(m_videoSrc, m_videoTee);
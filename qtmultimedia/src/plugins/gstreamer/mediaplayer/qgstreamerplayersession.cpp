@@ -186,6 +186,14 @@ QGstreamerPlayerSession::QGstreamerPlayerSession(QObject *parent)
             g_object_set(G_OBJECT(m_playbin), "audio-sink", m_audioSink, NULL);
             addAudioBufferProbe();
         }
+
+        // Let several players run from the same clock instead of each audio sink's own
+        // clock, so that their playback does not drift apart (e.g. tiles of a video wall).
+        if (qgetenv("QT_GSTREAMER_PLAYBIN_CLOCK") == "system") {
+            GstClock *clock = gst_system_clock_obtain();
+            gst_pipeline_use_clock(GST_PIPELINE(m_playbin), clock);
+            gst_object_unref(GST_OBJECT(clock));
+        }
     }
 
 #if GST_CHECK_VERSION(1,0,0)
@@ -367,13 +367,27 @@ void QQuickTreeModelAdaptor1::showModelChildItems(const TreeItem &parentItem, in
     int rowDepth = rowIdx == 0 ? 0 : parentItem.depth + 1;
     if (doInsertRows)
         beginInsertRows(QModelIndex(), startIdx, startIdx + insertCount - 1);
-    m_items.reserve(m_items.count() + insertCount);
+    const int tailIdx = m_items.count();
+    m_items.reserve(tailIdx + insertCount);
     for (int i = 0; i < insertCount; i++) {
         const QModelIndex &cmi = m_model->index(start + i, 0, parentIndex);
         bool expanded = m_expandedItems.contains(cmi);
-        m_items.insert(startIdx + i, TreeItem(cmi, rowDepth, expanded));
+        m_items.append(TreeItem(cmi, rowDepth, expanded));
         if (expanded)
-            m_itemsToExpand.append(&m_items[startIdx + i]);
+            m_itemsToExpand.append(&m_items.last());
+    }
+    if (startIdx < tailIdx) {
+        // Inserting the rows one by one in the middle moves the whole tail for
+        // each of them. Append them instead and rotate them into place with
+        // three reversals. QList::swap() only exchanges the node pointers, so
+        // the items queued in m_itemsToExpand stay valid.
+        const auto reverse = [this](int first, int last) {
+            for (; first < last; ++first, --last)
+                m_items.swap(first, last);
+        };
+        reverse(startIdx, tailIdx - 1);
+        reverse(tailIdx, tailIdx + insertCount - 1);
+        reverse(startIdx, tailIdx + insertCount - 1);
     }
     if (doInsertRows)
         endInsertRows();
@@ -115,6 +115,8 @@ void TcpClientIo::onStateChanged(QAbstractSocket::SocketState state)
         emit shouldReconnect(this);
     }
     if (state == QAbstractSocket::ConnectedState) {
+        // Packets are small and latency sensitive, don't let Nagle hold them back
+        m_socket.setSocketOption(QAbstractSocket::LowDelayOption, 1);
         m_dataStream.setDevice(connection());
         m_dataStream.resetStatus();
     }
@@ -125,6 +127,7 @@ TcpServerIo::TcpServerIo(QTcpSocket *conn, QObject *parent)
     : ServerIoDevice(parent), m_connection(conn)
 {
     m_connection->setParent(this);
+    m_connection->setSocketOption(QAbstractSocket::LowDelayOption, 1);
     connect(conn, &QIODevice::readyRead, this, &ServerIoDevice::readyRead);
     connect(conn, &QAbstractSocket::disconnected, this, &ServerIoDevice::disconnected);
 }
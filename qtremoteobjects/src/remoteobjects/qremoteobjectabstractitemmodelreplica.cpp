@@ -48,7 +48,8 @@
 
 QT_BEGIN_NAMESPACE
 enum {
-    DefaultRootCacheSize = 1000
+    DefaultRootCacheSize = 1000,
+    DefaultPrefetchRows = 20
 };
 
 inline QDebug operator<<(QDebug stream, const RequestedData &data)
@@ -802,9 +803,21 @@ QVariant QAbstractItemModelReplica::data(const QModelIndex & index, int role) co
     Q_ASSERT(parentItem);
     Q_ASSERT(index.row() < parentItem->rowCount);
     const int row = index.row();
+
+    // Views ask for one row at a time while scrolling. Fetch a few rows ahead in the
+    // direction of the scroll, so the next rows are cached by the time they are shown.
+    const int prefetchRows = std::min(int(DefaultPrefetchRows), int(parentItem->children.cacheSize / 4));
+    int firstRow = row;
+    int lastRow = row;
+    if (row >= d->m_lastRequested)
+        lastRow = std::min(row + prefetchRows, parentItem->rowCount - 1);
+    else
+        firstRow = std::max(row - prefetchRows, 0);
+    d->m_lastRequested = row;
+
     IndexList parentList = toModelIndexList(index.parent(), this);
-    IndexList start = IndexList() << parentList << ModelIndex(row, 0);
-    IndexList end = IndexList() << parentList << ModelIndex(row, std::max(0, parentItem->columnCount - 1));
+    IndexList start = IndexList() << parentList << ModelIndex(firstRow, 0);
+    IndexList end = IndexList() << parentList << ModelIndex(lastRow, std::max(0, parentItem->columnCount - 1));
     Q_ASSERT(toQModelIndex(start, this).isValid());
 
     RequestedData data;
@@ -813,9 +826,12 @@ QVariant QAbstractItemModelReplica::data(const QModelIndex & index, int role) co
     data.start = start;
     data.end = end;
     data.roles = roles;
+    // All requests made before the queued call runs are merged, one call is enough
+    const bool fetchPending = !d->m_requestedData.isEmpty();
     d->m_requestedData.push_back(data);
     qCDebug(QT_REMOTEOBJECT_MODELS) << "FETCH PENDING DATA" << start << end << roles;
-    QMetaObject::invokeMethod(d.data(), "fetchPendingData", Qt::QueuedConnection);
+    if (!fetchPending)
+        QMetaObject::invokeMethod(d.data(), "fetchPendingData", Qt::QueuedConnection);
     return QVariant{};
 }
 QModelIndex QAbstractItemModelReplica::parent(const QModelIndex &index) const
@@ -189,8 +189,15 @@ void QRemoteObjectSource::handleMetaCall(int index, QMetaObject::Call call, void
         const int rawIndex = m_api->propertyRawIndexFromSignal(index);
         const auto target = m_api->isAdapterProperty(index) ? m_adapter : m_object;
         const QMetaProperty mp = target->metaObject()->property(propertyIndex);
+        const QVariant value = serializedProperty(mp, target);
+        // Sources often emit the notify signal without an actual change, every
+        // listener already has this value so don't send it again.
+        const auto sent = m_sentProperties.constFind(rawIndex);
+        if (sent != m_sentProperties.cend() && *sent == value)
+            return;
+        m_sentProperties.insert(rawIndex, value);
         qCDebug(QT_REMOTEOBJECT) << "Sending Invoke Property" << (m_api->isAdapterSignal(index) ? "via adapter" : "") << rawIndex << propertyIndex << mp.name() << mp.read(target);
-        serializePropertyChangePacket(m_packet, m_api->name(), rawIndex, serializedProperty(mp, target));
+        serializePropertyChangePacket(m_packet, m_api->name(), rawIndex, value);
         m_packet.baseAddress = m_packet.size;
         propertyIndex = rawIndex;
     }
@@ -208,6 +215,8 @@ void QRemoteObjectSource::handleMetaCall(int index, QMetaObject::Call call, void
 void QRemoteObjectSource::addListener(ServerIoDevice *io, bool dynamic)
 {
     listeners.append(io);
+    // Changes made while nobody was listening were not recorded
+    m_sentProperties.clear();
 
     if (dynamic) {
         serializeInitDynamicPacket(m_packet, this);
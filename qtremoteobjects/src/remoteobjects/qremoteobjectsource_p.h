@@ -55,6 +55,7 @@
 #include <QMetaObject>
 #include <QMetaProperty>
 #include <QVector>
+#include <QHash>
 #include "qremoteobjectsource.h"
 #include "qremoteobjectpacket_p.h"
 
@@ -78,6 +79,7 @@ public:
     QRemoteObjectSourceIo *m_sourceIo;
     QRemoteObjectPackets::DataStreamPacket m_packet;
     QVariantList m_marshalledArgs;
+    QHash<int, QVariant> m_sentProperties; // last value sent per property raw index
     bool hasAdapter() const { return m_adapter; }
 
     QVariantList* marshalArgs(int index, void **a);
@@ -83,7 +83,6 @@ LinuxSysAccelerometer::LinuxSysAccelerometer(QSensor *sensor)
     , m_timerid(0)
     , path(QString())
     , divisor(0)
-    , delimiter(QString())
 {
     setReading<QAccelerometerReading>(&m_reading);
     addDataRate(1, 100); // 100Hz
@@ -96,7 +95,7 @@ LinuxSysAccelerometer::LinuxSysAccelerometer(QSensor *sensor)
     if (divisor == 0 || !ok) {
         divisor = 1;
     }
-    delimiter = QString::fromLatin1(qgetenv("QT_ACCEL_DELIMITER"));
+    delimiter = qgetenv("QT_ACCEL_DELIMITER");
     file.setFileName(path);
 }
 
@@ -122,8 +121,9 @@ void LinuxSysAccelerometer::start()
 
     int interval = 1000 / dataRate;
 
+    // a coarse timer may fire up to 5% late, which adds up at high data rates
     if (interval)
-        m_timerid = startTimer(interval);
+        m_timerid = startTimer(interval, Qt::PreciseTimer);
 }
 
 void LinuxSysAccelerometer::stop()
@@ -135,32 +135,80 @@ void LinuxSysAccelerometer::stop()
     closeFile();
 }
 
+static inline bool isNumberStart(char c)
+{
+    return (c >= '0' && c <= '9') || c == '-';
+}
+
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Parses the next delimiter separated value of \a line starting at \a pos,
+// without allocating. Returns false if there is no value left.
+static bool nextValue(const QByteArray &line, const QByteArray &delimiter, int &pos, float &value)
+{
+    if (pos < 0 || pos >= line.size())
+        return false;
+    int end = delimiter.isEmpty() ? -1 : line.indexOf(delimiter, pos);
+    const int next = end < 0 ? -1 : end + delimiter.size();
+    if (end < 0)
+        end = line.size();
+
+    int begin = pos;
+    while (begin < end && isSpace(line.at(begin)))
+        ++begin;
+    while (end > begin && isSpace(line.at(end - 1)))
+        --end;
+
+    bool ok = false;
+    value = QByteArray::fromRawData(line.constData() + begin, end - begin).toFloat(&ok);
+    pos = next;
+    return ok;
+}
+
 void LinuxSysAccelerometer::poll()
 {
     if (!file.isOpen())
         return;
 
+    // Called at the sensor's data rate, so read into a fixed buffer and parse
+    // in place rather than going through QString and QStringList each tick.
+    char buffer[128];
     file.seek(0);
-    QString str = file.readLine();
-    if (str.isEmpty()) {
+    const qint64 size = file.readLine(buffer, sizeof(buffer));
+    if (size <= 0)
         return;
-    }
-    str = str.simplified();
 
-    if (!str.at(0).isNumber() && str.at(0) != '-') {
-        str.remove(0,1);
-    }
+    int begin = 0;
+    int end = int(size);
+    while (begin < end && isSpace(buffer[begin]))
+        ++begin;
+    while (end > begin && isSpace(buffer[end - 1]))
+        --end;
+    if (begin == end)
+        return;
 
-    if (!str.at(str.size()-1).isNumber()) {
-        str.chop(1);
+    // strip surrounding brackets, e.g. (x,y,z)
+    if (!isNumberStart(buffer[begin]))
+        ++begin;
+    if (end > begin && !(buffer[end - 1] >= '0' && buffer[end - 1] <= '9'))
+        --end;
+
+    const QByteArray line = QByteArray::fromRawData(buffer + begin, end - begin);
+    float x, y, z;
+    int pos = 0;
+    if (!nextValue(line, delimiter, pos, x)
+            || !nextValue(line, delimiter, pos, y)
+            || !nextValue(line, delimiter, pos, z)) {
+        return;
     }
 
-    QStringList accelDataList = str.split(delimiter);
-
     m_reading.setTimestamp(produceTimestamp());
-    m_reading.setX(-accelDataList.at(0).toFloat() / divisor);
-    m_reading.setY(-accelDataList.at(1).toFloat() / divisor);
-    m_reading.setZ(-accelDataList.at(2).toFloat() / divisor);
+    m_reading.setX(-x / divisor);
+    m_reading.setY(-y / divisor);
+    m_reading.setZ(-z / divisor);
 
     newReadingAvailable();
 }
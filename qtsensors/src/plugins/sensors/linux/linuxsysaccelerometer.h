@@ -67,7 +67,7 @@ private:
     QString path;
     QFile file;
     float divisor;
-    QString delimiter;
+    QByteArray delimiter;
 };
 
 #endif // LINUXSYSACCELEROMETER_H
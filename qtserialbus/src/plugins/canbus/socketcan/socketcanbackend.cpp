@@ -355,6 +355,11 @@ bool SocketCanBackend::connectSocket()
         return false;
     }
 
+    // Deliver the receive time with each frame instead of querying it separately
+    const int timestampOn = 1;
+    socketTimestampEnabled = setsockopt(canSocket, SOL_SOCKET, SO_TIMESTAMP,
+                                        &timestampOn, sizeof(timestampOn)) == 0;
+
     m_iov.iov_base = &m_frame;
     m_msg.msg_name = &m_address;
     m_msg.msg_iov = &m_iov;
@@ -669,7 +674,17 @@ void SocketCanBackend::readSocket()
         }
 
         struct timeval timeStamp;
-        if (Q_UNLIKELY(ioctl(canSocket, SIOCGSTAMP, &timeStamp) < 0)) {
+        bool hasTimeStamp = false;
+        if (socketTimestampEnabled) {
+            for (cmsghdr *cmsg = CMSG_FIRSTHDR(&m_msg); cmsg; cmsg = CMSG_NXTHDR(&m_msg, cmsg)) {
+                if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMP) {
+                    ::memcpy(&timeStamp, CMSG_DATA(cmsg), sizeof(timeStamp));
+                    hasTimeStamp = true;
+                    break;
+                }
+            }
+        }
+        if (!hasTimeStamp && Q_UNLIKELY(ioctl(canSocket, SIOCGSTAMP, &timeStamp) < 0)) {
             setError(qt_error_string(errno),
                      QCanBusDevice::CanBusError::ReadError);
             ::memset(&timeStamp, 0, sizeof(timeStamp));
@@ -91,6 +91,7 @@ private:
     QSocketNotifier *notifier = nullptr;
     QString canSocketName;
     bool canFdOptionEnabled = false;
+    bool socketTimestampEnabled = false;
 };
 
 QT_END_NAMESPACE
@@ -881,6 +881,21 @@ inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
     if (!setBaudRate())
         return false;
 
+#if defined(Q_OS_LINUX)
+    // Ask the driver to push received bytes to the tty layer immediately instead of
+    // batching them, which trades CPU time for a lower and steadier read latency.
+    static const bool lowLatency = qEnvironmentVariableIntValue("QT_SERIALPORT_LOW_LATENCY") > 0;
+    if (lowLatency) {
+        struct serial_struct serial;
+        ::memset(&serial, 0, sizeof(serial));
+        if (::ioctl(descriptor, TIOCGSERIAL, &serial) != -1 && !(serial.flags & ASYNC_LOW_LATENCY)) {
+            serial.flags |= ASYNC_LOW_LATENCY;
+            // we don't check on errors because a driver can has not this feature
+            ::ioctl(descriptor, TIOCSSERIAL, &serial);
+        }
+    }
+#endif
+
     if (mode & QIODevice::ReadOnly)
         setReadNotificationEnabled(true);
 
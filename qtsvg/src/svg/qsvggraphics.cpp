@@ -56,10 +56,12 @@ QT_BEGIN_NAMESPACE
     qreal oldOpacity = p->opacity();                        \
     QBrush oldBrush = p->brush();                           \
     QPen oldPen = p->pen();                                 \
-    p->setPen(Qt::NoPen);                                   \
-    p->setOpacity(oldOpacity * states.fillOpacity);         \
-    command;                                                \
-    p->setPen(oldPen);                                      \
+    if (oldBrush.style() != Qt::NoBrush) {                  \
+        p->setPen(Qt::NoPen);                               \
+        p->setOpacity(oldOpacity * states.fillOpacity);     \
+        command;                                            \
+        p->setPen(oldPen);                                  \
+    }                                                       \
     if (oldPen != Qt::NoPen && oldPen.brush() != Qt::NoBrush && oldPen.widthF() != 0) { \
         p->setOpacity(oldOpacity * states.strokeOpacity);   \
         p->setBrush(Qt::NoBrush);                           \
@@ -637,8 +637,10 @@ static qreal toDouble(const QChar *&str)
     temp[pos] = '\0';
 
     qreal val;
-    if (!exponent && pos < 10) {
-        int ival = 0;
+    // Up to 18 digits fit in a 64-bit integer, which covers the coordinates written
+    // by most exporters without going through the much slower generic conversion.
+    if (!exponent && pos < 19) {
+        qint64 ival = 0;
         const char *t = temp;
         bool neg = false;
         if(*t == '-') {
@@ -652,7 +654,7 @@ static qreal toDouble(const QChar *&str)
         }
         if(*t == '.') {
             ++t;
-            int div = 1;
+            qint64 div = 1;
             while(*t) {
                 ival *= 10;
                 ival += (*t) - '0';
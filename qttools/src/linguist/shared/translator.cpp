@@ -53,7 +53,8 @@ QT_BEGIN_NAMESPACE
 
 Translator::Translator() :
     m_locationsType(AbsoluteLocations),
-    m_indexOk(true)
+    m_indexOk(true),
+    m_refIndexOk(false)
 {
 }
 
@@ -77,6 +78,7 @@ QList<Translator::FileFormat> &Translator::registeredFileFormats()
 
 void Translator::addIndex(int idx, const TranslatorMessage &msg) const
 {
+    m_refIndexOk = false;
     if (msg.sourceText().isEmpty() && msg.id().isEmpty()) {
         m_ctxCmtIdx[msg.context()] = idx;
     } else {
@@ -88,6 +90,7 @@ void Translator::addIndex(int idx, const TranslatorMessage &msg) const
 
 void Translator::delIndex(int idx) const
 {
+    m_refIndexOk = false;
     const TranslatorMessage &msg = m_messages.at(idx);
     if (msg.sourceText().isEmpty() && msg.id().isEmpty()) {
         m_ctxCmtIdx.remove(msg.context());
@@ -110,6 +113,22 @@ void Translator::ensureIndexed() const
     }
 }
 
+void Translator::ensureRefIndexed() const
+{
+    ensureIndexed();
+    if (!m_refIndexOk) {
+        m_refIndexOk = true;
+        m_refIdx.clear();
+        for (int i = 0; i < m_messages.count(); i++) {
+            foreach (const TranslatorMessage::Reference &ref, m_messages.at(i).allReferences()) {
+                QVector<int> &idxs = m_refIdx[qMakePair(ref.fileName(), ref.lineNumber())];
+                if (idxs.isEmpty() || idxs.last() != i)
+                    idxs.append(i);
+            }
+        }
+    }
+}
+
 void Translator::replaceSorted(const TranslatorMessage &msg)
 {
     int index = find(msg);
@@ -382,16 +401,27 @@ int Translator::find(const TranslatorMessage &msg) const
 int Translator::find(const QString &context,
     const QString &comment, const TranslatorMessage::References &refs) const
 {
+    // lupdate calls this for every message that vanished from the sources,
+    // so look the references up instead of scanning all messages each time.
+    int found = -1;
     if (!refs.isEmpty()) {
-        for (TMM::ConstIterator it = m_messages.constBegin(); it != m_messages.constEnd(); ++it) {
-            if (it->context() == context && it->comment() == comment)
-                foreach (const TranslatorMessage::Reference &itref, it->allReferences())
-                    foreach (const TranslatorMessage::Reference &ref, refs)
-                        if (itref == ref)
-                            return it - m_messages.constBegin();
+        ensureRefIndexed();
+        foreach (const TranslatorMessage::Reference &ref, refs) {
+            const auto it = m_refIdx.constFind(qMakePair(ref.fileName(), ref.lineNumber()));
+            if (it == m_refIdx.constEnd())
+                continue;
+            for (int idx : *it) {
+                if (found >= 0 && idx >= found)
+                    break;
+                const TranslatorMessage &msg = m_messages.at(idx);
+                if (msg.context() == context && msg.comment() == comment) {
+                    found = idx;
+                    break;
+                }
+            }
         }
     }
-    return -1;
+    return found;
 }
 
 int Translator::find(const QString &context) const
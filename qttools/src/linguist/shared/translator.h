@@ -36,8 +36,10 @@
 #include <QList>
 #include <QLocale>
 #include <QMultiHash>
+#include <QPair>
 #include <QString>
 #include <QSet>
+#include <QVector>
 
 
 QT_BEGIN_NAMESPACE
@@ -204,6 +206,7 @@ private:
     void addIndex(int idx, const TranslatorMessage &msg) const;
     void delIndex(int idx) const;
     void ensureIndexed() const;
+    void ensureRefIndexed() const;
 
     typedef QList<TranslatorMessage> TMM;       // int stores the sequence position.
 
@@ -228,6 +231,9 @@ private:
     mutable QHash<QString, int> m_ctxCmtIdx;
     mutable QHash<QString, int> m_idMsgIdx;
     mutable QHash<TMMKey, int> m_msgIdx;
+    // (file name, line number) -> ascending message indexes, built on demand
+    mutable bool m_refIndexOk;
+    mutable QHash<QPair<QString, int>, QVector<int> > m_refIdx;
 };
 
 bool getNumerusInfo(QLocale::Language language, QLocale::Country country,
@@ -117,7 +117,13 @@ void QDocIndexFiles::readIndexFile(const QString& path)
         return;
     }
 
-    QXmlStreamReader reader(&file);
+    // Index files of large modules are several megabytes. Parse them from
+    // memory in one go instead of having the reader pull them from the
+    // device in small blocks.
+    const qint64 size = file.size();
+    const uchar *data = file.map(0, size);
+    QXmlStreamReader reader(data ? QByteArray::fromRawData(reinterpret_cast<const char *>(data), size)
+                                 : file.readAll());
     reader.setNamespaceProcessing(false);
 
     if (!reader.readNextStartElement())
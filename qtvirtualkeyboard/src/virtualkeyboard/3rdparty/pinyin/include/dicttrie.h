@@ -83,6 +83,11 @@ class DictTrie : AtomDictBase {
   uint32 total_lma_num_;    // Total number of lemmas in this dictionary.
   uint32 top_lmas_num_;     // Number of lemma with highest scores.
 
+  // If not NULL, root_, nodes_ge1_ and lma_idx_buf_ point into this read-only
+  // mapping of the dictionary file instead of heap buffers.
+  void *map_base_;
+  size_t map_len_;
+
   // Parsing mark list used to mark the detailed extended statuses.
   ParsingMark *parsing_marks_;
   // The position for next available mark.
@@ -107,6 +112,10 @@ class DictTrie : AtomDictBase {
 
   bool load_dict(FILE *fp);
 
+  // Maps root_, nodes_ge1_ and lma_idx_buf_ from the current position of fp,
+  // and moves fp past them. Returns false if they have to be read instead.
+  bool map_dict(FILE *fp);
+
   // Given a LmaNodeLE0 node, extract the lemmas specified by it, and fill
   // them into the lpi_items buffer.
   // This function is called by the search engine.
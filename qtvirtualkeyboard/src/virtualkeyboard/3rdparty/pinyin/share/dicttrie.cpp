@@ -17,6 +17,11 @@
 #include <assert.h>
 #include <stdio.h>
 #include <string.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #include "../include/dicttrie.h"
 #include "../include/dictbuilder.h"
 #include "../include/lpicache.h"
@@ -38,6 +43,8 @@ DictTrie::DictTrie() {
   total_lma_num_ = 0;
   top_lmas_num_ = 0;
   dict_list_ = NULL;
+  map_base_ = NULL;
+  map_len_ = 0;
 
   parsing_marks_ = NULL;
   mile_stones_ = NULL;
@@ -49,6 +56,18 @@ DictTrie::~DictTrie() {
 }
 
 void DictTrie::free_resource(bool free_dict_list) {
+#ifndef _WIN32
+  if (NULL != map_base_) {
+    // root_, nodes_ge1_ and lma_idx_buf_ point into the mapping.
+    munmap(map_base_, map_len_);
+    map_base_ = NULL;
+    map_len_ = 0;
+    root_ = NULL;
+    nodes_ge1_ = NULL;
+    lma_idx_buf_ = NULL;
+  }
+#endif
+
   if (NULL != root_)
     free(root_);
   root_ = NULL;
@@ -165,6 +184,49 @@ bool DictTrie::save_dict(const char *filename) {
 }
 #endif  // ___BUILD_MODEL___
 
+bool DictTrie::map_dict(FILE *fp) {
+#ifndef _WIN32
+  const size_t root_size = lma_node_num_le0_ * sizeof(LmaNodeLE0);
+  const size_t ge1_size = lma_node_num_ge1_ * sizeof(LmaNodeGE1);
+  const size_t data_size = root_size + ge1_size + lma_idx_buf_len_;
+
+  const int fd = fileno(fp);
+  const long data_pos = ftell(fp);
+  struct stat st;
+  if (fd < 0 || data_pos < 0 || fstat(fd, &st) != 0 ||
+      static_cast<size_t>(st.st_size) < data_pos + data_size)
+    return false;
+
+  const long page_size = sysconf(_SC_PAGESIZE);
+  if (page_size <= 0)
+    return false;
+  const size_t delta = data_pos % page_size;
+  const size_t map_len = delta + data_size;
+  void *base = mmap(NULL, map_len, PROT_READ, MAP_PRIVATE, fd, data_pos - delta);
+  if (MAP_FAILED == base)
+    return false;
+
+  // The trie is stored right after variable sized tables, use the mapping
+  // only if the node arrays happen to be suitably aligned.
+  unsigned char *data = static_cast<unsigned char*>(base) + delta;
+  if (reinterpret_cast<size_t>(data) % sizeof(uint32) != 0 ||
+      fseek(fp, data_pos + data_size, SEEK_SET) != 0) {
+    munmap(base, map_len);
+    return false;
+  }
+
+  map_base_ = base;
+  map_len_ = map_len;
+  root_ = reinterpret_cast<LmaNodeLE0*>(data);
+  nodes_ge1_ = reinterpret_cast<LmaNodeGE1*>(data + root_size);
+  lma_idx_buf_ = data + root_size + ge1_size;
+  return true;
+#else
+  (void)fp;
+  return false;
+#endif
+}
+
 bool DictTrie::load_dict(FILE *fp) {
   if (NULL == fp)
     return false;
@@ -183,11 +245,17 @@ bool DictTrie::load_dict(FILE *fp) {
 
   free_resource(false);
 
-  root_ = static_cast<LmaNodeLE0*>
-          (malloc(lma_node_num_le0_ * sizeof(LmaNodeLE0)));
-  nodes_ge1_ = static_cast<LmaNodeGE1*>
-               (malloc(lma_node_num_ge1_ * sizeof(LmaNodeGE1)));
-  lma_idx_buf_ = (unsigned char*)malloc(lma_idx_buf_len_);
+  // Map the trie read-only from the file if possible, so that its pages are
+  // shared and can be dropped under memory pressure instead of living on the
+  // heap.
+  const bool mapped = map_dict(fp);
+  if (!mapped) {
+    root_ = static_cast<LmaNodeLE0*>
+            (malloc(lma_node_num_le0_ * sizeof(LmaNodeLE0)));
+    nodes_ge1_ = static_cast<LmaNodeGE1*>
+                 (malloc(lma_node_num_ge1_ * sizeof(LmaNodeGE1)));
+    lma_idx_buf_ = (unsigned char*)malloc(lma_idx_buf_len_);
+  }
   total_lma_num_ = lma_idx_buf_len_ / kLemmaIdSize;
 
   size_t buf_size = SpellingTrie::get_instance().get_spelling_num() + 1;
@@ -206,17 +274,19 @@ bool DictTrie::load_dict(FILE *fp) {
     return false;
   }
 
-  if (fread(root_, sizeof(LmaNodeLE0), lma_node_num_le0_, fp)
-      != lma_node_num_le0_)
-    return false;
+  if (!mapped) {
+    if (fread(root_, sizeof(LmaNodeLE0), lma_node_num_le0_, fp)
+        != lma_node_num_le0_)
+      return false;
 
-  if (fread(nodes_ge1_, sizeof(LmaNodeGE1), lma_node_num_ge1_, fp)
-      != lma_node_num_ge1_)
-    return false;
+    if (fread(nodes_ge1_, sizeof(LmaNodeGE1), lma_node_num_ge1_, fp)
+        != lma_node_num_ge1_)
+      return false;
 
-  if (fread(lma_idx_buf_, sizeof(unsigned char), lma_idx_buf_len_, fp) !=
-      lma_idx_buf_len_)
-    return false;
+    if (fread(lma_idx_buf_, sizeof(unsigned char), lma_idx_buf_len_, fp) !=
+        lma_idx_buf_len_)
+      return false;
+  }
 
   // The quick index for the first level sons
   uint16 last_splid = kFullSplIdStart;
@@ -115,6 +115,7 @@ QWaylandShmBuffer::QWaylandShmBuffer(QWaylandDisplay *display,
     wl_shm_format wl_format = shm->formatFrom(format);
     mImage = QImage(data, size.width(), size.height(), stride, format);
     mImage.setDevicePixelRatio(qreal(scale));
+    mDirtyRegion = QRect(QPoint(), size);
 
     mShmPool = wl_shm_create_pool(shm->object(), fd, alloc);
     init(wl_shm_pool_create_buffer(mShmPool,0, size.width(), size.height(),
@@ -198,6 +199,19 @@ void QWaylandShmBackingStore::beginPaint(const QRegion &region)
         for (const QRect &rect : region)
             p.fillRect(rect, blank);
     }
+
+    const QMargins margins = windowDecorationMargins();
+    const int scale = waylandWindow()->scale();
+    addDirtyRegion(QTransform::fromScale(scale, scale).map(region.translated(margins.left(), margins.top())));
+}
+
+void QWaylandShmBackingStore::addDirtyRegion(const QRegion &region)
+{
+    // The back buffer gets the new content, the other buffers are now outdated there
+    for (QWaylandShmBuffer *b : qAsConst(mBuffers)) {
+        if (b != mBackBuffer)
+            b->dirtyRegion() += region;
+    }
 }
 
 void QWaylandShmBackingStore::endPaint()
@@ -225,8 +239,12 @@ void QWaylandShmBackingStore::flush(QWindow *window, const QRegion &region, cons
     Q_UNUSED(window);
     Q_UNUSED(offset);
 
-    if (windowDecoration() && windowDecoration()->isDirty())
+    if (windowDecoration() && windowDecoration()->isDirty()) {
         updateDecorations();
+        const QRect bufferRect(QPoint(), mBackBuffer->size());
+        const QMargins deviceMargins = windowDecorationMargins() * waylandWindow()->scale();
+        addDirtyRegion(QRegion(bufferRect) - bufferRect.marginsRemoved(deviceMargins));
+    }
 
     mFrontBuffer = mBackBuffer;
 
@@ -272,10 +290,10 @@ void QWaylandShmBackingStore::resize(const QSize &size)
     QSize sizeWithMargins = (size + QSize(margins.left()+margins.right(),margins.top()+margins.bottom())) * scale;
 
     // We look for a free buffer to draw into. If the buffer is not the last buffer we used,
-    // that is mBackBuffer, and the size is the same we memcpy the old content into the new
-    // buffer so that QPainter is happy to find the stuff it had drawn before. If the new
-    // buffer has a different size it needs to be redrawn completely anyway, and if the buffer
-    // is the same the stuff is there already.
+    // that is mBackBuffer, and the size is the same we copy the parts of the old content
+    // that changed since the buffer was last used, so that QPainter is happy to find the
+    // stuff it had drawn before. If the new buffer has a different size it needs to be
+    // redrawn completely anyway, and if the buffer is the same the stuff is there already.
     // You can exercise the different codepaths with weston, switching between the gl and the
     // pixman renderer. With the gl renderer release events are sent early so we can effectively
     // run single buffered, while with the pixman renderer we have to use two.
@@ -287,11 +305,18 @@ void QWaylandShmBackingStore::resize(const QSize &size)
         buffer = getBuffer(sizeWithMargins);
     }
 
-    int oldSize = mBackBuffer ? mBackBuffer->image()->byteCount() : 0;
     // mBackBuffer may have been deleted here but if so it means its size was different so we wouldn't copy it anyway
-    if (mBackBuffer != buffer && oldSize == buffer->image()->byteCount()) {
-        memcpy(buffer->image()->bits(), mBackBuffer->image()->constBits(), buffer->image()->byteCount());
+    if (mBackBuffer && mBackBuffer != buffer && mBackBuffer->size() == buffer->size()) {
+        const QImage *source = mBackBuffer->image();
+        QImage *target = buffer->image();
+        const QRegion dirty = buffer->dirtyRegion() & QRect(QPoint(), target->size());
+        for (const QRect &rect : dirty) {
+            const int bytes = rect.width() * 4;
+            for (int y = rect.top(); y <= rect.bottom(); ++y)
+                memcpy(target->scanLine(y) + rect.left() * 4, source->constScanLine(y) + rect.left() * 4, bytes);
+        }
     }
+    buffer->dirtyRegion() = QRegion();
     mBackBuffer = buffer;
     // ensure the new buffer is at the beginning of the list so next time getBuffer() will pick
     // it if possible
@@ -77,8 +77,12 @@ public:
     QImage *image() { return &mImage; }
 
     QImage *imageInsideMargins(const QMargins &margins);
+
+    // Area, in device pixels, that is outdated compared to the current back buffer
+    QRegion &dirtyRegion() { return mDirtyRegion; }
 private:
     QImage mImage;
+    QRegion mDirtyRegion;
     struct wl_shm_pool *mShmPool;
     QMargins mMargins;
     QImage *mMarginsImage;
@@ -113,6 +117,7 @@ public:
 
 private:
     void updateDecorations();
+    void addDirtyRegion(const QRegion &region);
     QWaylandShmBuffer *getBuffer(const QSize &size);
 
     QWaylandDisplay *mDisplay;
@@ -261,6 +261,8 @@ void QWaylandWindow::reset(bool sendDestroyEvent)
         wl_callback_destroy(mFrameCallback);
         mFrameCallback = nullptr;
     }
+    // The destroyed callback will never fire
+    mWaitingForFrameSync = false;
 
     mMask = QRegion();
 }
@@ -384,6 +386,12 @@ void QWaylandWindow::setVisible(bool visible)
         // Don't flush the events here, or else the newly visible window may start drawing, but since
         // there was no frame before it will be stuck at the waitForFrameSync() in
         // QWaylandShmBackingStore::beginPaint().
+
+        // Deliver the update request that was held back while the window was hidden
+        if (mUpdateRequested && !mWaitingForFrameSync) {
+            mUpdateRequested = false;
+            QPlatformWindow::requestUpdate();
+        }
     } else {
         sendExposeEvent(QRect());
         // when flushing the event queue, it could contain a close event, in which
@@ -1031,7 +1039,9 @@ QVariant QWaylandWindow::property(const QString &name, const QVariant &defaultVa
 
 void QWaylandWindow::requestUpdate()
 {
-    if (!mWaitingForFrameSync)
+    // A hidden window gets no frame callbacks. Keep the request until it is shown
+    // again instead of letting it render on a timer in the background.
+    if (!mWaitingForFrameSync && window()->isVisible())
         QPlatformWindow::requestUpdate();
     else
         mUpdateRequested = true;
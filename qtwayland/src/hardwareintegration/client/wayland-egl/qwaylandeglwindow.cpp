@@ -59,6 +59,7 @@ QWaylandEglWindow::QWaylandEglWindow(QWindow *window)
     , m_clientBufferIntegration(static_cast<QWaylandEglClientBufferIntegration *>(mDisplay->clientBufferIntegration()))
     , m_waylandEglWindow(0)
     , m_eglSurface(0)
+    , m_swapInterval(-1)
     , m_contentFBO(0)
     , m_resize(false)
 {
@@ -139,6 +140,7 @@ void QWaylandEglWindow::updateSurface(bool create)
         if (!m_eglSurface && create) {
             EGLNativeWindowType eglw = (EGLNativeWindowType) m_waylandEglWindow;
             m_eglSurface = eglCreateWindowSurface(m_clientBufferIntegration->eglDisplay(), m_eglConfig, eglw, 0);
+            m_swapInterval = -1;
         }
     }
 }
@@ -185,6 +187,16 @@ EGLSurface QWaylandEglWindow::eglSurface() const
     return m_eglSurface;
 }
 
+// Must be called with this window's surface current. Setting the interval on every
+// swap is a round trip into the EGL implementation, only do it when it changes.
+void QWaylandEglWindow::setSwapInterval(int interval)
+{
+    if (interval == m_swapInterval)
+        return;
+    eglSwapInterval(m_clientBufferIntegration->eglDisplay(), interval);
+    m_swapInterval = interval;
+}
+
 GLuint QWaylandEglWindow::contentFBO() const
 {
     if (!decoration())
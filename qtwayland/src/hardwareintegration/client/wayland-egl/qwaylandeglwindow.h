@@ -65,6 +65,7 @@ public:
     QRect contentsRect() const;
 
     EGLSurface eglSurface() const;
+    void setSwapInterval(int interval);
     GLuint contentFBO() const;
     GLuint contentTexture() const;
     bool needToUpdateContentFBO() const { return decoration() && (m_resize || !m_contentFBO); }
@@ -86,6 +87,7 @@ private:
     const QWaylandWindow *m_parentWindow;
 
     EGLSurface m_eglSurface;
+    int m_swapInterval; // last interval set on m_eglSurface, -1 if not set yet
     EGLConfig m_eglConfig;
     mutable QOpenGLFramebufferObject *m_contentFBO;
     mutable bool m_resize;
@@ -548,10 +548,10 @@ void QWaylandGLContext::swapBuffers(QPlatformSurface *surface)
 
         int si = (sub->isSync() && mSupportNonBlockingSwap) ? 0 : m_format.swapInterval();
 
-        eglSwapInterval(m_eglDisplay, si);
+        window->setSwapInterval(si);
         eglSwapBuffers(m_eglDisplay, eglSurface);
     } else {
-        eglSwapInterval(m_eglDisplay, m_format.swapInterval());
+        window->setSwapInterval(m_format.swapInterval());
         eglSwapBuffers(m_eglDisplay, eglSurface);
     }
 